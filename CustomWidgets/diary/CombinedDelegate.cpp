@@ -2,10 +2,10 @@
 #include <QAbstractItemView>
 #include <QApplication>
 #include <QKeyEvent>
-#include <QListWidget>
 #include <QPainter>
 #include <QTextDocument>
 #include "qtextedit_DiaryTextInput.h"
+#include "DiaryDisplayModel.h"
 #include "inputvalidation.h"
 #include "operations_files.h"
 #include "CryptoUtils.h"
@@ -16,6 +16,7 @@ CombinedDelegate::CombinedDelegate(QObject *parent)
     , m_colorLength(5)
     , m_taskManagerLength(12)
     , m_textColor(QColor(255, 0, 0))
+    , m_layoutCache(LAYOUT_CACHE_SIZE)
 {
     qDebug() << "CombinedDelegate: Constructor called";
     // Connect our custom signal to our non-const slot
@@ -30,11 +31,50 @@ void CombinedDelegate::setColorLength(int length) {
 void CombinedDelegate::setTextColor(const QColor &color) {
     qDebug() << "CombinedDelegate: setTextColor called";
     m_textColor = color;
+    m_layoutCache.clear(); // The color is baked into the cached documents
+}
+
+void CombinedDelegate::setImageCache(DiaryImageCache *imageCache) {
+    m_imageCache = imageCache;
+}
+
+void CombinedDelegate::invalidateLayoutCache() {
+    m_layoutCache.clear();
+}
+
+CombinedDelegate::CachedLayout* CombinedDelegate::cachedLayout(const QString &text, int colorLength, const QFont &font, int width) const {
+    const LayoutKey key{text, colorLength, width, font};
+    CachedLayout* layout = m_layoutCache.object(key);
+    if (!layout) {
+        layout = new CachedLayout;
+        if (!m_layoutCache.insert(key, layout)) {
+            return nullptr; // QCache already deleted it
+        }
+    }
+    return layout;
+}
+
+int CombinedDelegate::coloredTextHeight(const QString &text, bool isTaskManager, const QFont &font, int width) const {
+    const int colorLength = isTaskManager ? m_taskManagerLength : m_colorLength;
+    CachedLayout* layout = cachedLayout(text, colorLength, font, width);
+    if (layout && layout->height >= 0) {
+        return layout->height;
+    }
+
+    QTextDocument doc;
+    doc.setDefaultFont(font);
+    doc.setPlainText(text);
+    doc.setTextWidth(width);
+    const int height = doc.size().height();
+    if (layout) {
+        layout->height = height;
+    }
+    return height;
 }
 
 QWidget *CombinedDelegate::createEditor(QWidget *parent, const QStyleOptionViewItem &option, const QModelIndex &index) const {
     qDebug() << "CombinedDelegate: createEditor called for index:" << index.row();
-    if (index.data(Qt::UserRole).toBool()) {
+    if (index.data(DiaryDisplayModel::HideTextRole).toBool()) {
         return nullptr; // Don't create an editor if UserRole is true
     } else {
         qtextedit_DiaryTextInput *editor = new qtextedit_DiaryTextInput(parent);
@@ -111,12 +151,12 @@ QSize CombinedDelegate::sizeHint(const QStyleOptionViewItem &option, const QMode
     }
 
     // Check if this is an image item - handle it specially
-    bool isImageItem = index.data(Qt::UserRole+3).toBool();
+    bool isImageItem = index.data(DiaryDisplayModel::ImageRole).toBool();
     if (isImageItem) {
         qDebug() << "CombinedDelegate: sizeHint called for image item";
 
         // Single image only now - calculate size based on actual image dimensions
-        QString imagePath = index.data(Qt::UserRole+4).toString();
+        QString imagePath = index.data(DiaryDisplayModel::ImagePathRole).toString();
 
         // Try to get the actual display size for this image
         QSize imageSize = getActualImageDisplaySize(imagePath);
@@ -130,7 +170,7 @@ QSize CombinedDelegate::sizeHint(const QStyleOptionViewItem &option, const QMode
     }
 
     // Check if this is a colored text item
-    bool shouldColorText = index.data(Qt::UserRole+1).toBool();
+    bool shouldColorText = index.data(DiaryDisplayModel::ColoredTextRole).toBool();
 
     if (!shouldColorText) {
         // For normal items, use default size
@@ -143,21 +183,16 @@ QSize CombinedDelegate::sizeHint(const QStyleOptionViewItem &option, const QMode
     // Get the text
     QString text = index.data(Qt::DisplayRole).toString();
     if (!text.isEmpty()) {
-        // Create a temporary document to calculate required height
-        QTextDocument doc;
-        doc.setDefaultFont(option.font);
-        doc.setPlainText(text);
-
         // Set text width to the available width in the view
         int textWidth = option.rect.width();
         if (textWidth <= 0) {
             // If the rect width is not valid, use the current size hint width
             textWidth = size.width();
         }
-        doc.setTextWidth(textWidth);
 
         // Ensure minimum height for the text plus some padding
-        int textHeight = doc.size().height();
+        bool isTaskManager = index.data(DiaryDisplayModel::TaskManagerRole).toBool();
+        int textHeight = coloredTextHeight(text, isTaskManager, option.font, textWidth);
         size.setHeight(textHeight + 0);  // Add some padding
     }
 
@@ -262,13 +297,13 @@ QSize CombinedDelegate::getActualImageDisplaySize(const QString& imagePath) cons
 }
 
 void CombinedDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const {
-    if (index.data(Qt::UserRole).toBool()) {
+    if (index.data(DiaryDisplayModel::HideTextRole).toBool()) {
         // Do not paint the text if the UserRole data is true
         return;
     }
 
     // Check if this is an image item
-    bool isImageItem = index.data(Qt::UserRole+3).toBool();
+    bool isImageItem = index.data(DiaryDisplayModel::ImageRole).toBool();
 
     if (isImageItem) {
         // Custom painting for image items
@@ -280,7 +315,7 @@ void CombinedDelegate::paint(QPainter *painter, const QStyleOptionViewItem &opti
     initStyleOption(&opt, index);
 
     // Check if this item should have colored text
-    bool shouldColorText = index.data(Qt::UserRole+1).toBool();
+    bool shouldColorText = index.data(DiaryDisplayModel::ColoredTextRole).toBool();
 
     if (!shouldColorText) {
         // For normal items, use the default painting
@@ -304,10 +339,10 @@ void CombinedDelegate::paint(QPainter *painter, const QStyleOptionViewItem &opti
     QRect textRect = opt.rect.adjusted(0, 0, -1, -1);
 
     // Check if this is a task manager entry
-    bool isTaskManager = index.data(Qt::UserRole+2).toBool();
+    bool isTaskManager = index.data(DiaryDisplayModel::TaskManagerRole).toBool();
 
     // Use different color length based on whether it's a Task Manager entry
-    int colorLength = isTaskManager ? 12 : m_colorLength;  // "Task Manager" is 12 characters
+    int colorLength = isTaskManager ? m_taskManagerLength : m_colorLength;  // "Task Manager" is 12 characters
 
     if (text.isEmpty()) {
         // Nothing to draw
@@ -317,22 +352,32 @@ void CombinedDelegate::paint(QPainter *painter, const QStyleOptionViewItem &opti
         painter->setFont(opt.font); // Respect the item's font
         painter->drawText(textRect, Qt::AlignLeft | Qt::AlignVCenter | Qt::TextWordWrap, text);
     } else {
-        // Create a text document for more control over text layout
-        QTextDocument doc;
-        doc.setDefaultFont(opt.font);
-        doc.setTextWidth(textRect.width());
-
-        // Create the formatted text with different colors
-        QString htmlText = QString("<span style=\"font-weight: bold; font-family: Helvetica \"><span style=\"color: %1;\">%2</span>%3</span>")
-                               .arg(m_textColor.name())
-                               .arg(text.left(colorLength).toHtmlEscaped())
-                               .arg(text.mid(colorLength).toHtmlEscaped());
-
-        doc.setHtml(htmlText);
+        // Reuse the formatted document if this row was already laid out at this width
+        CachedLayout* layout = cachedLayout(text, colorLength, opt.font, textRect.width());
+        std::unique_ptr<QTextDocument> uncachedDoc;
+        QTextDocument* doc = layout ? layout->document.get() : nullptr;
+        if (!doc) {
+            // Create a text document for more control over text layout
+            uncachedDoc = std::make_unique<QTextDocument>();
+            uncachedDoc->setDefaultFont(opt.font);
+            uncachedDoc->setTextWidth(textRect.width());
+
+            // Create the formatted text with different colors
+            QString htmlText = QString("<span style=\"font-weight: bold; font-family: Helvetica \"><span style=\"color: %1;\">%2</span>%3</span>")
+                                   .arg(m_textColor.name())
+                                   .arg(text.left(colorLength).toHtmlEscaped())
+                                   .arg(text.mid(colorLength).toHtmlEscaped());
+
+            uncachedDoc->setHtml(htmlText);
+            doc = uncachedDoc.get();
+            if (layout) {
+                layout->document = std::move(uncachedDoc);
+            }
+        }
 
         // Draw the document
         painter->translate(textRect.topLeft());
-        doc.drawContents(painter);
+        doc->drawContents(painter);
     }
 
     // Restore painter state
@@ -347,12 +392,16 @@ void CombinedDelegate::paintImageItem(QPainter *painter, const QStyleOptionViewI
     }
 
     // Single image handling only
-    QString imagePath = index.data(Qt::UserRole+4).toString();
+    QString imagePath = index.data(DiaryDisplayModel::ImagePathRole).toString();
     qDebug() << "CombinedDelegate: Single image path:" << imagePath;
 
     if (!imagePath.isEmpty()) {
         qDebug() << "CombinedDelegate: Calling paintSingleImage";
         paintSingleImage(painter, option, index, imagePath);
+    } else if (index.data(DiaryDisplayModel::PendingImageRole).toBool()) {
+        // Image that is still being encrypted, its file doesn't exist yet
+        const int MARGIN = 10;
+        paintImagePlaceholder(painter, option.rect.adjusted(MARGIN, MARGIN, -MARGIN, -MARGIN), option);
     } else {
         qDebug() << "CombinedDelegate: No image path found for single image";
     }
@@ -366,8 +415,32 @@ void CombinedDelegate::paintSingleImage(QPainter *painter, const QStyleOptionVie
         return;
     }
 
+    const int MARGIN = 10;
+
+    // Left-align the image instead of centering
+    int x = option.rect.x() + MARGIN; // Left alignment
+    int y = option.rect.y() + MARGIN; // Top alignment with margin
+
+    // Calculate available space for the image
+    int availableWidth = option.rect.width() - (2 * MARGIN);
+    int availableHeight = option.rect.height() - (2 * MARGIN);
+
+    if (m_imageCache) {
+        // Decoding happens in the background, the cache hands out pixmaps already scaled to fit
+        QPixmap scaledPixmap = m_imageCache->pixmap(imagePath, QSize(availableWidth, availableHeight));
+        if (!scaledPixmap.isNull()) {
+            painter->drawPixmap(x, y, scaledPixmap);
+            return;
+        }
+        if (!m_imageCache->hasFailed(imagePath)) {
+            paintImagePlaceholder(painter, QRect(x, y, availableWidth, availableHeight), option);
+            return;
+        }
+        // Fall through to the error text
+    }
+
     // Load and decrypt the image
-    QPixmap imagePixmap = loadImageForDisplay(imagePath);
+    QPixmap imagePixmap = m_imageCache ? QPixmap() : loadImageForDisplay(imagePath);
     if (imagePixmap.isNull()) {
         qDebug() << "CombinedDelegate: Image pixmap is null, drawing error text";
         painter->save();
@@ -378,16 +451,6 @@ void CombinedDelegate::paintSingleImage(QPainter *painter, const QStyleOptionVie
         return;
     }
 
-    const int MARGIN = 10;
-
-    // Left-align the image instead of centering
-    int x = option.rect.x() + MARGIN; // Left alignment
-    int y = option.rect.y() + MARGIN; // Top alignment with margin
-
-    // Calculate available space for the image
-    int availableWidth = option.rect.width() - (2 * MARGIN);
-    int availableHeight = option.rect.height() - (2 * MARGIN);
-
     // Scale the image to fit the available space while preserving aspect ratio
     QPixmap scaledPixmap = imagePixmap.scaled(
         QSize(availableWidth, availableHeight),
@@ -401,6 +464,17 @@ void CombinedDelegate::paintSingleImage(QPainter *painter, const QStyleOptionVie
     qDebug() << "CombinedDelegate: Painted left-aligned image at" << QPoint(x, y) << "size" << scaledPixmap.size();
 }
 
+void CombinedDelegate::paintImagePlaceholder(QPainter *painter, const QRect &imageRect, const QStyleOptionViewItem &option) const {
+    painter->save();
+    painter->setPen(QPen(option.palette.mid().color(), 1, Qt::DashLine));
+    painter->setBrush(Qt::NoBrush);
+    painter->drawRect(imageRect.adjusted(0, 0, -1, -1));
+    painter->setPen(option.palette.mid().color());
+    painter->setFont(option.font);
+    painter->drawText(imageRect, Qt::AlignCenter, "Loading image...");
+    painter->restore();
+}
+
 QPixmap CombinedDelegate::loadImageForDisplay(const QString& imagePath) const
 {
     qDebug() << "CombinedDelegate: loadImageForDisplay called for:" << imagePath;
@@ -553,11 +627,11 @@ void CombinedDelegate::adjustEditorSize(QTextEdit *editor) const {
 }
 
 void CombinedDelegate::adjustListWidgetScroll(QTextEdit *editor) const {
-    QListWidget *listWidget = qobject_cast<QListWidget *>(editor->parentWidget()->parentWidget());
-    if (!listWidget) return;
+    QAbstractItemView *view = qobject_cast<QAbstractItemView *>(editor->parentWidget()->parentWidget());
+    if (!view) return;
 
-    QModelIndex index = listWidget->currentIndex();
+    QModelIndex index = view->currentIndex();
     if (!index.isValid()) return;
 
-    listWidget->scrollToItem(listWidget->item(index.row()), QAbstractItemView::EnsureVisible);
+    view->scrollTo(index, QAbstractItemView::EnsureVisible);
 }
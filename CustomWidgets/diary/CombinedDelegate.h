@@ -5,6 +5,12 @@
 #include <QColor>
 #include <QSize>
 #include <QTextEdit>
+#include <QTextDocument>
+#include <QCache>
+#include <QFont>
+#include <memory>
+#include <QPointer>
+#include "diary_imagecache.h"
 
 // Forward Declarations
 class qtextedit_DiaryTextInput;
@@ -16,7 +22,6 @@ class QModelIndex;
 class QAbstractItemModel;
 class QEvent;
 class QObject;
-class QListWidget;
 
 class CombinedDelegate : public QStyledItemDelegate {
     Q_OBJECT
@@ -27,6 +32,14 @@ public:
     void setColorLength(int length);
     void setTextColor(const QColor &color);
 
+    // Image rows are painted from this cache, with a placeholder until the image is decoded
+    void setImageCache(DiaryImageCache *imageCache);
+
+    // Drops every cached text layout. Called by the display when its width or font size changes
+    void invalidateLayoutCache();
+    // Height of a colored (timestamp) row laid out at the given width, cached
+    int coloredTextHeight(const QString &text, bool isTaskManager, const QFont &font, int width) const;
+
     QWidget *createEditor(QWidget *parent, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
     void setEditorData(QWidget *editor, const QModelIndex &index) const override;
     void setModelData(QWidget *editor, QAbstractItemModel *model, const QModelIndex &index) const override;
@@ -44,6 +57,33 @@ private:
     int m_colorLength;     // Number of characters to color
     int m_taskManagerLength;  // Length of "Task Manager" text
     QColor m_textColor;    // Color for text characters
+    QPointer<DiaryImageCache> m_imageCache;
+
+    // Layout cache for colored rows.
+    // sizeHint and paint used to build a QTextDocument for every colored row on every call,
+    // which Qt makes many times per resize and scroll. The documents are now laid out once per
+    // (text, font, width) and reused; the display drops the cache when its font size or width changes.
+    struct LayoutKey {
+        QString text;
+        int colorLength;
+        int width;
+        QFont font;
+        bool operator==(const LayoutKey &other) const {
+            return width == other.width && colorLength == other.colorLength
+                   && text == other.text && font == other.font;
+        }
+    };
+    friend size_t qHash(const LayoutKey &key, size_t seed) {
+        return qHashMulti(seed, key.text, key.colorLength, key.width, key.font);
+    }
+    struct CachedLayout {
+        int height = -1;                         // Plain text height used for the row size
+        std::unique_ptr<QTextDocument> document; // Formatted document drawn by paint, built on first paint
+    };
+    static const int LAYOUT_CACHE_SIZE = 1000;  // Layouts, least recently used are evicted first
+    mutable QCache<LayoutKey, CachedLayout> m_layoutCache;
+
+    CachedLayout* cachedLayout(const QString &text, int colorLength, const QFont &font, int width) const;
 
     // private functions
     void adjustEditorSize(QTextEdit *editor) const;
@@ -54,6 +94,7 @@ private:
 
     // Image painting helper methods (simplified for single images only)
     void paintSingleImage(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index, const QString& imagePath) const;
+    void paintImagePlaceholder(QPainter *painter, const QRect &imageRect, const QStyleOptionViewItem &option) const;
     // REMOVED: paintMultipleImages - no longer needed
 
     QSize getActualImageDisplaySize(const QString& imagePath) const;
@@ -0,0 +1,344 @@
+#include "DiaryDisplayModel.h"
+#include "../../constants.h"
+#include <QDebug>
+#include <algorithm>
+
+DiaryDisplayModel::DiaryDisplayModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+}
+
+// ============================================================================
+// Row factories
+// ============================================================================
+
+DiaryDisplayModel::Entry DiaryDisplayModel::textEntry(const QString& text, bool editable)
+{
+    Entry entry;
+    entry.text = text;
+    if (editable) {
+        entry.itemFlags |= Qt::ItemIsEditable;
+    }
+    return entry;
+}
+
+DiaryDisplayModel::Entry DiaryDisplayModel::markerEntry(const QString& marker)
+{
+    Entry entry;
+    entry.text = marker;
+    entry.flags = Hidden;
+    return entry;
+}
+
+DiaryDisplayModel::Entry DiaryDisplayModel::spacerEntry(bool hidden)
+{
+    Entry entry;
+    entry.text = Constants::Diary_Spacer;
+    entry.itemFlags &= ~Qt::ItemIsEnabled;
+    entry.flags = HideText;
+    if (hidden) {
+        entry.flags |= Hidden;
+    }
+    return entry;
+}
+
+DiaryDisplayModel::Entry DiaryDisplayModel::timeStampEntry(const QString& text, bool taskManager)
+{
+    Entry entry;
+    entry.text = text;
+    entry.itemFlags &= ~Qt::ItemIsEnabled;
+    entry.flags = ColoredText;
+    if (taskManager) {
+        entry.flags |= TaskManager;
+    }
+    return entry;
+}
+
+DiaryDisplayModel::Entry DiaryDisplayModel::imageEntry(const QString& imagePath, const QSize& sizeHint)
+{
+    Entry entry;
+    entry.imagePath = imagePath;
+    entry.sizeHint = sizeHint;
+    entry.flags = Image;
+    return entry;
+}
+
+DiaryDisplayModel::Entry DiaryDisplayModel::pendingImageEntry(const QString& token, const QSize& sizeHint)
+{
+    Entry entry;
+    entry.text = token;   // Image rows don't show their text
+    entry.sizeHint = sizeHint;
+    entry.itemFlags &= ~(Qt::ItemIsEnabled | Qt::ItemIsSelectable);
+    entry.flags = Image | PendingImage;
+    return entry;
+}
+
+// ============================================================================
+// QAbstractListModel
+// ============================================================================
+
+int DiaryDisplayModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_entries.size();
+}
+
+QVariant DiaryDisplayModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_entries.size()) {
+        return QVariant();
+    }
+
+    const Entry& entry = m_entries.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::EditRole:
+        return entry.text;
+    case Qt::FontRole:
+        return m_font;
+    case Qt::SizeHintRole:
+        return entry.sizeHint.isValid() ? QVariant(entry.sizeHint) : QVariant();
+    case Qt::TextAlignmentRole:
+        return entry.flags.testFlag(Centered) ? QVariant(int(Qt::AlignCenter)) : QVariant();
+    case HideTextRole:
+        return entry.flags.testFlag(HideText);
+    case ColoredTextRole:
+        return entry.flags.testFlag(ColoredText);
+    case TaskManagerRole:
+        return entry.flags.testFlag(TaskManager);
+    case ImageRole:
+        return entry.flags.testFlag(Image);
+    case ImagePathRole:
+        return entry.imagePath;
+    case HiddenRole:
+        return entry.flags.testFlag(Hidden);
+    case PendingImageRole:
+        return entry.flags.testFlag(PendingImage);
+    default:
+        return QVariant();
+    }
+}
+
+bool DiaryDisplayModel::setData(const QModelIndex& index, const QVariant& value, int role)
+{
+    if (!index.isValid() || index.row() >= m_entries.size() || (role != Qt::EditRole && role != Qt::DisplayRole)) {
+        return false;
+    }
+    setText(index.row(), value.toString());
+    return true;
+}
+
+Qt::ItemFlags DiaryDisplayModel::flags(const QModelIndex& index) const
+{
+    if (!index.isValid() || index.row() >= m_entries.size()) {
+        return Qt::NoItemFlags;
+    }
+    return m_entries.at(index.row()).itemFlags;
+}
+
+// ============================================================================
+// Accessors
+// ============================================================================
+
+QString DiaryDisplayModel::text(int row) const
+{
+    return (row >= 0 && row < m_entries.size()) ? m_entries.at(row).text : QString();
+}
+
+bool DiaryDisplayModel::isImage(int row) const
+{
+    return row >= 0 && row < m_entries.size() && m_entries.at(row).flags.testFlag(Image);
+}
+
+bool DiaryDisplayModel::isHidden(int row) const
+{
+    return row >= 0 && row < m_entries.size() && m_entries.at(row).flags.testFlag(Hidden);
+}
+
+QString DiaryDisplayModel::imagePath(int row) const
+{
+    return (row >= 0 && row < m_entries.size()) ? m_entries.at(row).imagePath : QString();
+}
+
+Qt::ItemFlags DiaryDisplayModel::itemFlags(int row) const
+{
+    return (row >= 0 && row < m_entries.size()) ? m_entries.at(row).itemFlags : Qt::ItemFlags();
+}
+
+QStringList DiaryDisplayModel::texts(int first, int last) const
+{
+    QStringList result;
+    first = qMax(0, first);
+    last = qMin(last, m_entries.size() - 1);
+    for (int row = first; row <= last; ++row) {
+        result.append(m_entries.at(row).text);
+    }
+    return result;
+}
+
+QVector<int> DiaryDisplayModel::findRows(const QString& prefix) const
+{
+    QVector<int> rows;
+    for (int row = 0; row < m_entries.size(); ++row) {
+        if (m_entries.at(row).text.startsWith(prefix)) {
+            rows.append(row);
+        }
+    }
+    return rows;
+}
+
+QVector<int> DiaryDisplayModel::findImageRows(const QString& imagePath) const
+{
+    QVector<int> rows;
+    for (int row = 0; row < m_entries.size(); ++row) {
+        const Entry& entry = m_entries.at(row);
+        if (entry.flags.testFlag(Image) && entry.imagePath == imagePath) {
+            rows.append(row);
+        }
+    }
+    return rows;
+}
+
+int DiaryDisplayModel::findPendingImageRow(const QString& token) const
+{
+    // Placeholders are added at the end of the display, search from there
+    for (int row = m_entries.size() - 1; row >= 0; --row) {
+        const Entry& entry = m_entries.at(row);
+        if (entry.flags.testFlag(PendingImage) && entry.text == token) {
+            return row;
+        }
+    }
+    return -1;
+}
+
+// ============================================================================
+// Mutators
+// ============================================================================
+
+void DiaryDisplayModel::setText(int row, const QString& text)
+{
+    if (row < 0 || row >= m_entries.size() || m_entries.at(row).text == text) {
+        return;
+    }
+    m_entries[row].text = text;
+    // The old size no longer fits, the view measures the row again
+    m_entries[row].sizeHint = QSize();
+    const QModelIndex changed = index(row);
+    emit dataChanged(changed, changed, {Qt::DisplayRole, Qt::EditRole, Qt::SizeHintRole});
+}
+
+void DiaryDisplayModel::setItemFlags(int row, Qt::ItemFlags itemFlags)
+{
+    if (row < 0 || row >= m_entries.size() || m_entries.at(row).itemFlags == itemFlags) {
+        return;
+    }
+    m_entries[row].itemFlags = itemFlags;
+    const QModelIndex changed = index(row);
+    emit dataChanged(changed, changed, {});
+}
+
+void DiaryDisplayModel::setEntryFlag(int row, EntryFlag flag, bool on)
+{
+    if (row < 0 || row >= m_entries.size() || m_entries.at(row).flags.testFlag(flag) == on) {
+        return;
+    }
+    m_entries[row].flags.setFlag(flag, on);
+
+    int role = HiddenRole;
+    switch (flag) {
+    case HideText: role = HideTextRole; break;
+    case ColoredText: role = ColoredTextRole; break;
+    case TaskManager: role = TaskManagerRole; break;
+    case Image: role = ImageRole; break;
+    case Centered: role = Qt::TextAlignmentRole; break;
+    case PendingImage: role = PendingImageRole; break;
+    default: break;
+    }
+    const QModelIndex changed = index(row);
+    emit dataChanged(changed, changed, {role});
+}
+
+void DiaryDisplayModel::setImagePath(int row, const QString& imagePath)
+{
+    if (row < 0 || row >= m_entries.size() || m_entries.at(row).imagePath == imagePath) {
+        return;
+    }
+    m_entries[row].imagePath = imagePath;
+    const QModelIndex changed = index(row);
+    emit dataChanged(changed, changed, {ImagePathRole});
+}
+
+void DiaryDisplayModel::setSizeHint(int row, const QSize& size)
+{
+    setSizeHints(row, QVector<QSize>{size});
+}
+
+void DiaryDisplayModel::setSizeHints(int first, const QVector<QSize>& sizes)
+{
+    if (first < 0 || sizes.isEmpty() || first + sizes.size() > m_entries.size()) {
+        return;
+    }
+    for (int i = 0; i < sizes.size(); ++i) {
+        m_entries[first + i].sizeHint = sizes.at(i);
+    }
+    emit dataChanged(index(first), index(first + sizes.size() - 1), {Qt::SizeHintRole});
+}
+
+void DiaryDisplayModel::setFont(const QFont& font)
+{
+    if (font == m_font) {
+        return;
+    }
+    m_font = font;
+    if (!m_entries.isEmpty()) {
+        emit dataChanged(index(0), index(m_entries.size() - 1), {Qt::FontRole});
+    }
+}
+
+void DiaryDisplayModel::setEntries(const QVector<Entry>& entries)
+{
+    beginResetModel();
+    m_entries = entries;
+    endResetModel();
+}
+
+void DiaryDisplayModel::appendEntry(const Entry& entry)
+{
+    appendEntries(QVector<Entry>{entry});
+}
+
+void DiaryDisplayModel::appendEntries(const QVector<Entry>& entries)
+{
+    insertEntries(m_entries.size(), entries);
+}
+
+void DiaryDisplayModel::insertEntries(int row, const QVector<Entry>& entries)
+{
+    if (entries.isEmpty() || row < 0 || row > m_entries.size()) {
+        return;
+    }
+    beginInsertRows(QModelIndex(), row, row + entries.size() - 1);
+    m_entries.insert(row, entries.size(), Entry());
+    std::copy(entries.cbegin(), entries.cend(), m_entries.begin() + row);
+    endInsertRows();
+}
+
+void DiaryDisplayModel::removeEntries(int row, int count)
+{
+    if (row < 0 || count <= 0 || row >= m_entries.size()) {
+        return;
+    }
+    count = qMin(count, m_entries.size() - row);
+    beginRemoveRows(QModelIndex(), row, row + count - 1);
+    m_entries.remove(row, count);
+    endRemoveRows();
+}
+
+void DiaryDisplayModel::clear()
+{
+    if (m_entries.isEmpty()) {
+        return;
+    }
+    beginResetModel();
+    m_entries.clear();
+    endResetModel();
+}
@@ -0,0 +1,108 @@
+#ifndef DIARYDISPLAYMODEL_H
+#define DIARYDISPLAYMODEL_H
+
+#include <QAbstractListModel>
+#include <QVector>
+#include <QString>
+#include <QStringList>
+#include <QSize>
+#include <QFont>
+
+// Rows of the diary display (qlist_DiaryTextDisplay).
+// The display used to be a QListWidget, which allocates a QListWidgetItem per row and stores
+// every role in a QVariant map. Diary rows only ever carry a line of text, an optional image
+// path, a cached size and a handful of flags, so they are kept here in one compact vector.
+// Rows can be added in batches (a whole day in one insert, or a full reset when a diary is
+// loaded), and the row heights measured by the view are cached in the rows themselves.
+//
+// The roles match what CombinedDelegate reads, so the delegate works on this model unchanged.
+class DiaryDisplayModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    enum Roles {
+        HideTextRole = Qt::UserRole,         // Spacer rows, not painted and not editable
+        ColoredTextRole = Qt::UserRole + 1,  // Timestamps, the name part is painted in color
+        TaskManagerRole = Qt::UserRole + 2,  // Task manager log timestamps
+        ImageRole = Qt::UserRole + 3,
+        ImagePathRole = Qt::UserRole + 4,
+        HiddenRole = Qt::UserRole + 6,       // Marker rows, kept for saving but never shown
+        PendingImageRole = Qt::UserRole + 7  // Image still being added, never saved
+    };
+
+    enum EntryFlag {
+        NoEntryFlags = 0x00,
+        Hidden = 0x01,
+        HideText = 0x02,
+        ColoredText = 0x04,
+        TaskManager = 0x08,
+        Image = 0x10,
+        Centered = 0x20,
+        PendingImage = 0x40
+    };
+    Q_DECLARE_FLAGS(EntryFlags, EntryFlag)
+
+    struct Entry {
+        QString text;
+        QString imagePath;                   // Full path of the encrypted image for image rows
+        QSize sizeHint;                      // Invalid until the view has measured the row
+        Qt::ItemFlags itemFlags = Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+        EntryFlags flags;
+    };
+
+    // Row factories for the kinds of rows the diary uses
+    static Entry textEntry(const QString& text, bool editable);
+    static Entry markerEntry(const QString& marker);            // Hidden file markers (timestamp, text block...)
+    static Entry spacerEntry(bool hidden = false);
+    static Entry timeStampEntry(const QString& text, bool taskManager);
+    static Entry imageEntry(const QString& imagePath, const QSize& sizeHint);
+    // Placeholder for an image that is still being encrypted, found again by its token
+    static Entry pendingImageEntry(const QString& token, const QSize& sizeHint);
+
+    explicit DiaryDisplayModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+    int count() const { return m_entries.size(); }
+    const Entry& entry(int row) const { return m_entries.at(row); }
+    QString text(int row) const;
+    bool isImage(int row) const;
+    bool isHidden(int row) const;
+    QString imagePath(int row) const;
+    Qt::ItemFlags itemFlags(int row) const;
+    QStringList texts(int first, int last) const;
+    // Rows whose text starts with prefix, ascending
+    QVector<int> findRows(const QString& prefix) const;
+    // Image rows showing the given image file, ascending
+    QVector<int> findImageRows(const QString& imagePath) const;
+    // Placeholder row with the given token, -1 if it isn't displayed
+    int findPendingImageRow(const QString& token) const;
+
+    void setText(int row, const QString& text);
+    void setItemFlags(int row, Qt::ItemFlags itemFlags);
+    void setEntryFlag(int row, EntryFlag flag, bool on = true);
+    void setImagePath(int row, const QString& imagePath);
+    void setSizeHint(int row, const QSize& size);
+    // Stores measured row sizes starting at first, emits a single dataChanged
+    void setSizeHints(int first, const QVector<QSize>& sizes);
+    void setFont(const QFont& font);
+    QFont font() const { return m_font; }
+
+    void setEntries(const QVector<Entry>& entries);
+    void appendEntry(const Entry& entry);
+    void appendEntries(const QVector<Entry>& entries);
+    void insertEntries(int row, const QVector<Entry>& entries);
+    void removeEntries(int row, int count = 1);
+    void clear();
+
+private:
+    QVector<Entry> m_entries;
+    QFont m_font;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(DiaryDisplayModel::EntryFlags)
+
+#endif // DIARYDISPLAYMODEL_H
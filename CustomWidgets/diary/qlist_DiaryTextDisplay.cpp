@@ -1,5 +1,6 @@
 #include "qlist_DiaryTextDisplay.h"
 #include "qtextedit_DiaryTextInput.h"
+#include "CombinedDelegate.h"
 #include "../../constants.h"
 #include "../../Operations-Global/SafeTimer.h"
 #include <QKeyEvent>
@@ -7,12 +8,12 @@
 #include <QFont>
 #include <QFontMetrics>
 #include <QTextDocument>
-#include <QListWidgetItem>
+#include <QScrollBar>
 #include <QDebug>
 #include "../../Operations-Global/inputvalidation.h" // Add this include
 
 qlist_DiaryTextDisplay::qlist_DiaryTextDisplay(QWidget *parent)
-    : QListWidget(parent)
+    : QListView(parent)
     , m_inSizeUpdate(false)
     , m_inMouseEvent(false)
     , m_resizeTimer(nullptr)
@@ -22,6 +23,17 @@ qlist_DiaryTextDisplay::qlist_DiaryTextDisplay(QWidget *parent)
     this->show();
     this->setContextMenuPolicy(Qt::CustomContextMenu);
 
+    m_model = new DiaryDisplayModel(this);
+    QFont font = this->font();
+    font.setPointSize(m_fontSize);
+    m_model->setFont(font);
+    setModel(m_model);
+
+    // Connected after setModel() so the view has processed the change before we measure
+    connect(m_model, &QAbstractItemModel::rowsInserted, this, &qlist_DiaryTextDisplay::onRowsInserted);
+    connect(m_model, &QAbstractItemModel::modelReset, this, &qlist_DiaryTextDisplay::onModelReset);
+    connect(m_model, &QAbstractItemModel::dataChanged, this, &qlist_DiaryTextDisplay::onDataChanged);
+
     // Enable drag & drop
     setAcceptDrops(true);
 
@@ -76,26 +88,97 @@ void qlist_DiaryTextDisplay::leaveEvent(QEvent *event)
         clearSelection();
         m_inMouseEvent = false;
     }
-    QListWidget::leaveEvent(event);
+    QListView::leaveEvent(event);
 }
 
 void qlist_DiaryTextDisplay::enterEvent(QEnterEvent *event)
 {
     // Handle enter event if needed in the future
-    QListWidget::enterEvent(event);
+    QListView::enterEvent(event);
+}
+
+int qlist_DiaryTextDisplay::currentRow() const
+{
+    QModelIndex index = currentIndex();
+    return index.isValid() ? index.row() : -1;
+}
+
+void qlist_DiaryTextDisplay::setCurrentRow(int row)
+{
+    setCurrentIndex(m_model->index(row));
+}
+
+int qlist_DiaryTextDisplay::selectedRow() const
+{
+    if (!selectionModel()) {
+        return -1;
+    }
+    const QModelIndexList selected = selectionModel()->selectedIndexes();
+    return selected.isEmpty() ? -1 : selected.first().row();
+}
+
+void qlist_DiaryTextDisplay::clear()
+{
+    m_model->clear();
 }
 
 void qlist_DiaryTextDisplay::selectLastItem()
 {
     qDebug() << "qlist_DiaryTextDisplay: selectLastItem() called";
     if (count() > 0) {
-        QListWidgetItem* lastItem = item(count() - 1);
-        if (lastItem && (lastItem->flags() & Qt::ItemIsEnabled)) {
-            setCurrentItem(lastItem);
+        int lastRow = count() - 1;
+        if (m_model->itemFlags(lastRow) & Qt::ItemIsEnabled) {
+            setCurrentRow(lastRow);
         }
     }
 }
 
+QModelIndex qlist_DiaryTextDisplay::topAnchor(int& anchorTop) const
+{
+    const QModelIndex anchor = indexAt(QPoint(0, 0));
+    anchorTop = anchor.isValid() ? visualRect(anchor).top() : 0;
+    return anchor;
+}
+
+void qlist_DiaryTextDisplay::restoreTopAnchor(int anchorRow, int anchorTop)
+{
+    if (anchorRow < 0 || anchorRow >= count()) {
+        return;
+    }
+    // The new rows have to be laid out before their height is known
+    doItemsLayout();
+    const QRect anchorRect = visualRect(m_model->index(anchorRow));
+    verticalScrollBar()->setValue(verticalScrollBar()->value() + anchorRect.top() - anchorTop);
+}
+
+void qlist_DiaryTextDisplay::prependEntries(const QVector<DiaryDisplayModel::Entry>& entries)
+{
+    if (entries.isEmpty()) {
+        return;
+    }
+    int anchorTop = 0;
+    const QModelIndex anchor = topAnchor(anchorTop);
+    m_model->insertEntries(0, entries);
+    if (anchor.isValid()) {
+        restoreTopAnchor(anchor.row() + entries.size(), anchorTop);
+    }
+}
+
+void qlist_DiaryTextDisplay::removeTopEntries(int count)
+{
+    count = qMin(count, this->count());
+    if (count <= 0) {
+        return;
+    }
+    int anchorTop = 0;
+    const QModelIndex anchor = topAnchor(anchorTop);
+    m_model->removeEntries(0, count);
+    // Only rows above the anchor are removed, so it moved up by exactly count rows
+    if (anchor.isValid() && anchor.row() >= count) {
+        restoreTopAnchor(anchor.row() - count, anchorTop);
+    }
+}
+
 void qlist_DiaryTextDisplay::wheelEvent(QWheelEvent *event)
 {
     if (!event) {
@@ -131,13 +214,8 @@ void qlist_DiaryTextDisplay::wheelEvent(QWheelEvent *event)
         QFont font = this->font();
         font.setPointSize(m_fontSize);
 
-        // Update font for all items directly
-        for (int i = 0; i < count(); ++i) {
-            QListWidgetItem *item = this->item(i);
-            if (item) {  // Null check
-                item->setFont(font);
-            }
-        }
+        // All rows share the model font
+        m_model->setFont(font);
 
         // Update sizes directly
         updateItemSizes();
@@ -148,7 +226,11 @@ void qlist_DiaryTextDisplay::wheelEvent(QWheelEvent *event)
 
         event->accept();
     } else {
-        QListWidget::wheelEvent(event); // Pass normal wheel events
+        // Scrolling up at the top does not move the scroll bar, tell the diary so it can load older days
+        if (event->angleDelta().y() > 0 && verticalScrollBar()->value() == verticalScrollBar()->minimum()) {
+            emit scrolledPastTop();
+        }
+        QListView::wheelEvent(event); // Pass normal wheel events
     }
 }
 
@@ -157,7 +239,7 @@ void qlist_DiaryTextDisplay::resizeEvent(QResizeEvent *event)
     qDebug() << "qlist_DiaryTextDisplay: resizeEvent called";
     
     // Let the base class handle the resize immediately
-    QListWidget::resizeEvent(event);
+    QListView::resizeEvent(event);
     
     // Defer the size update to coalesce rapid resize events
     // This prevents crashes from multiple rapid resizes
@@ -220,7 +302,7 @@ void qlist_DiaryTextDisplay::mousePressEvent(QMouseEvent *event)
     }
 
     // Call base class implementation
-    QListWidget::mousePressEvent(event);
+    QListView::mousePressEvent(event);
 }
 
 void qlist_DiaryTextDisplay::UpdateFontSize_Slot(int size, bool resize)
@@ -242,11 +324,7 @@ void qlist_DiaryTextDisplay::UpdateFontSize_Slot(int size, bool resize)
     // Update the font size for all items
     QFont font = this->font();
     font.setPointSize(m_fontSize);
-
-    for (int i = 0; i < count(); ++i) {
-        QListWidgetItem *item = this->item(i);
-        item->setFont(font);
-    }
+    m_model->setFont(font);
 
     // If an editor is currently open, update its font size too
     if (QWidget* editor = this->findChild<qtextedit_DiaryTextInput*>()) {
@@ -288,10 +366,10 @@ void qlist_DiaryTextDisplay::TextWasEdited(QString text, int itemIndex)
     }
 
     // Rest of the existing logic...
-    if(count > 0 && this->item(itemIndex - 1)->text() != Constants::Diary_TextBlockStart) {
+    if(count > 0 && m_model->text(itemIndex - 1) != Constants::Diary_TextBlockStart) {
         // Code for adding text block markers
     }
-    else if(count == 0 && this->item(itemIndex - 1)->text() == Constants::Diary_TextBlockStart) {
+    else if(count == 0 && m_model->text(itemIndex - 1) == Constants::Diary_TextBlockStart) {
         // Code for removing text block markers
     }
 
@@ -319,52 +397,130 @@ void qlist_DiaryTextDisplay::updateItemSizes()
         qWarning() << "qlist_DiaryTextDisplay: No viewport available in updateItemSizes";
         return;
     }
-    
-    QFont font = this->font();
-    font.setPointSize(m_fontSize);
 
-    for (int i = 0; i < count(); ++i) {
-        QListWidgetItem *item = this->item(i);
-        if (!item) continue; // Skip null items
+    // Rows are measured when they are added or edited, a full pass is only needed
+    // when something that affects every row changed
+    int viewportWidth = this->viewport()->width();
+    if (viewportWidth == m_measuredWidth && m_fontSize == m_measuredFontSize) {
+        return;
+    }
+    m_measuredWidth = viewportWidth;
+    m_measuredFontSize = m_fontSize;
 
-        // Check if this is an image item - if so, don't override its size hint
-        bool isImageItem = item->data(Qt::UserRole+3).toBool();
-        if (isImageItem) {
-            // For image items, preserve the existing size hint
-            // No font changes needed since there are no captions
-            continue; // Skip size calculation for image items
-        }
+    // Layouts made for the old width or font size will never be drawn again
+    if (CombinedDelegate* delegate = qobject_cast<CombinedDelegate*>(this->itemDelegate())) {
+        delegate->invalidateLayoutCache();
+    }
 
-        // Get the item text
-        QString text = item->text();
-        // For items with colored text, we need special handling
-        bool hasColoredText = item->data(Qt::UserRole+1).toBool();
+    measureRows(0, count() - 1);
 
-        // Get viewport width with safety check
-        int viewportWidth = this->viewport() ? this->viewport()->width() : 400;
-        
-        // Adjust item size hint based on current viewport width
-        if (hasColoredText) {
+    // Force layout update only if widget is visible
+    if (this->isVisible()) {
+        this->doItemsLayout();
+    }
+}
+
+void qlist_DiaryTextDisplay::measureRows(int first, int last)
+{
+    if (first > last || first < 0 || last >= count()) {
+        return;
+    }
+
+    QFont font = this->font();
+    font.setPointSize(m_fontSize);
+    QFontMetrics fm(font);
+    int viewportWidth = this->viewport() ? this->viewport()->width() : 400;
+    CombinedDelegate* delegate = qobject_cast<CombinedDelegate*>(this->itemDelegate());
+
+    QVector<QSize> sizes;
+    sizes.reserve(last - first + 1);
+    for (int row = first; row <= last; ++row) {
+        const DiaryDisplayModel::Entry& entry = m_model->entry(row);
+
+        // Image rows keep the size computed from the image, hidden rows are never laid out
+        if (entry.flags & (DiaryDisplayModel::Image | DiaryDisplayModel::Hidden)) {
+            sizes.append(entry.sizeHint);
+            continue;
+        }
+
+        if ((entry.flags & DiaryDisplayModel::ColoredText) && delegate) {
+            // Measured through the delegate, which caches the height with the row layout
+            int height = delegate->coloredTextHeight(entry.text, entry.flags.testFlag(DiaryDisplayModel::TaskManager),
+                                                     font, viewportWidth);
+            sizes.append(QSize(viewportWidth, height));
+        } else if (entry.flags & DiaryDisplayModel::ColoredText) {
             // For colored text items, create a text document to measure
             QTextDocument doc;
             doc.setDefaultFont(font);
-            doc.setPlainText(text);
-            // Calculate width of list widget viewport
+            doc.setPlainText(entry.text);
             doc.setTextWidth(viewportWidth);
-            QSize docSize = doc.size().toSize();
-            item->setSizeHint(QSize(docSize.width(), docSize.height() + 0)); // Add padding
+            sizes.append(doc.size().toSize());
         } else {
             // For regular items, use font metrics
-            QFontMetrics fm(font);
             QRect textRect = fm.boundingRect(0, 0, viewportWidth, 0,
-                                             Qt::AlignLeft | Qt::TextWordWrap, text);
-            item->setSizeHint(QSize(textRect.width() + 10, textRect.height() + 0)); // Add padding
+                                             Qt::AlignLeft | Qt::TextWordWrap, entry.text);
+            sizes.append(QSize(textRect.width() + 10, textRect.height())); // Add padding
         }
     }
 
-    // Force layout update only if widget is visible
-    if (this->isVisible()) {
-        this->doItemsLayout();
+    m_model->setSizeHints(first, sizes);
+}
+
+void qlist_DiaryTextDisplay::syncHiddenRows(int first, int last)
+{
+    for (int row = first; row <= last && row < count(); ++row) {
+        bool hidden = m_model->isHidden(row);
+        if (isRowHidden(row) != hidden) {
+            setRowHidden(row, hidden);
+        }
+    }
+}
+
+void qlist_DiaryTextDisplay::onRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+    syncHiddenRows(first, last);
+    // Only the new rows need measuring, the view lays them out once it gets back to the event loop
+    measureRows(first, last);
+}
+
+void qlist_DiaryTextDisplay::onModelReset()
+{
+    // QListView::reset() already dropped the hidden rows of the previous content
+    for (int row = 0; row < count(); ++row) {
+        if (m_model->isHidden(row)) {
+            setRowHidden(row, true);
+        }
+    }
+    measureRows(0, count() - 1);
+    m_measuredWidth = this->viewport() ? this->viewport()->width() : -1;
+    m_measuredFontSize = m_fontSize;
+}
+
+void qlist_DiaryTextDisplay::onDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QList<int> &roles)
+{
+    const int first = topLeft.row();
+    const int last = bottomRight.row();
+
+    if (roles.isEmpty() || roles.contains(DiaryDisplayModel::HiddenRole)) {
+        syncHiddenRows(first, last);
+    }
+
+    if (roles.contains(Qt::DisplayRole)) {
+        measureRows(first, last);
+        scheduleDelayedItemsLayout();
+        for (int row = first; row <= last; ++row) {
+            emit itemChanged(row);
+        }
+    } else if (roles.contains(DiaryDisplayModel::HiddenRole)) {
+        // Rows that were hidden when they were added have never been measured
+        measureRows(first, last);
+        scheduleDelayedItemsLayout();
+    } else if (roles.contains(Qt::SizeHintRole) && first == last && m_model->isImage(first)) {
+        // Image rows get their real size once the image cache has decoded the image
+        scheduleDelayedItemsLayout();
     }
 }
 
@@ -372,11 +528,7 @@ void qlist_DiaryTextDisplay::updateItemFonts()
 {
     QFont font = this->font();
     font.setPointSize(m_fontSize);
-
-    for (int i = 0; i < count(); ++i) {
-        QListWidgetItem *item = this->item(i);
-        item->setFont(font);
-    }
+    m_model->setFont(font);
 
     // If an editor is currently open, update its font size too
     if (QWidget* editor = this->findChild<qtextedit_DiaryTextInput*>()) {
@@ -409,7 +561,7 @@ void qlist_DiaryTextDisplay::dragEnterEvent(QDragEnterEvent *event)
         }
     }
 
-    QListWidget::dragEnterEvent(event);
+    QListView::dragEnterEvent(event);
 }
 
 void qlist_DiaryTextDisplay::dragMoveEvent(QDragMoveEvent *event)
@@ -417,7 +569,7 @@ void qlist_DiaryTextDisplay::dragMoveEvent(QDragMoveEvent *event)
     if (event->mimeData()->hasUrls()) {
         event->acceptProposedAction();
     } else {
-        QListWidget::dragMoveEvent(event);
+        QListView::dragMoveEvent(event);
     }
 }
 
@@ -440,7 +592,7 @@ void qlist_DiaryTextDisplay::dropEvent(QDropEvent *event)
         }
     }
 
-    QListWidget::dropEvent(event);
+    QListView::dropEvent(event);
 }
 
 bool qlist_DiaryTextDisplay::isImageFile(const QString& filePath)
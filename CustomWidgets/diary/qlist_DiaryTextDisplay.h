@@ -1,7 +1,7 @@
 #ifndef QLIST_DIARYTEXTDISPLAY_H
 #define QLIST_DIARYTEXTDISPLAY_H
 
-#include <QListWidget>
+#include <QListView>
 #include <QWheelEvent>
 #include <QResizeEvent>
 #include <QEvent>
@@ -13,23 +13,42 @@
 #include <QUrl>
 #include <QFileInfo>
 
+#include "DiaryDisplayModel.h"
+
 class SafeTimer;
 
 class qtextedit_DiaryTextInput;
 
-class qlist_DiaryTextDisplay : public QListWidget
+// The diary display is a plain list view over a DiaryDisplayModel that it owns.
+// Row heights are measured here once per row (and again when the font size or the width
+// changes) and cached in the model, so layouting and scrolling never re-measure text.
+class qlist_DiaryTextDisplay : public QListView
 {
     Q_OBJECT
 public:
     qlist_DiaryTextDisplay(QWidget *parent = nullptr);
     ~qlist_DiaryTextDisplay();
 
+    DiaryDisplayModel* diaryModel() const { return m_model; }
+
+    // Row based helpers, mirroring the QListWidget API the diary code grew up with
+    int count() const { return m_model->count(); }
+    int currentRow() const;
+    void setCurrentRow(int row);
+    int selectedRow() const;   // First selected row, -1 if nothing is selected
+    void clear();
+
     // Add a method to get the current font size
     int currentFontSize() const { return m_fontSize; }
 
     // Add method to select the last item
     void selectLastItem();
 
+    // Adds rows above / removes rows from the top without moving what is on screen.
+    // Used by the diary timeline when it loads or evicts older days.
+    void prependEntries(const QVector<DiaryDisplayModel::Entry>& entries);
+    void removeTopEntries(int count);
+
     QPoint getLastClickPos() const { return m_lastClickPos; }
 
 protected:
@@ -59,6 +78,19 @@ private:
     // Methods for updating items
     void updateItemSizes();
     void updateItemFonts();
+    void measureRows(int first, int last);
+    void syncHiddenRows(int first, int last);
+    // Keeps the row at the top of the viewport in place while rows above it change
+    QModelIndex topAnchor(int& anchorTop) const;
+    void restoreTopAnchor(int anchorRow, int anchorTop);
+
+    void onRowsInserted(const QModelIndex &parent, int first, int last);
+    void onModelReset();
+    void onDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QList<int> &roles);
+
+    DiaryDisplayModel* m_model = nullptr;
+    int m_measuredWidth = -1;      // Viewport width and font size the cached row sizes were measured for
+    int m_measuredFontSize = -1;
     int m_fontSize = 10;
     bool m_inSizeUpdate = false;
     bool m_inMouseEvent = false; // New flag to prevent recursive events
@@ -77,6 +109,12 @@ signals:
     void sizeUpdateStarted();
     void sizeUpdateFinished();
 
+    // The user scrolled up while already at the top, e.g. when everything fits without a scroll bar
+    void scrolledPastTop();
+
+    // Emitted when the text of a row changed, e.g. after it was edited in place
+    void itemChanged(int row);
+
     // Add signal for image dropping
     void imagesDropped(const QStringList& imagePaths);
 };
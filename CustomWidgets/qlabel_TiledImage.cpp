@@ -0,0 +1,214 @@
+#include "qlabel_TiledImage.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QtConcurrent/QtConcurrent>
+#include <QDebug>
+#include <cmath>
+
+qlabel_TiledImage::qlabel_TiledImage(QWidget *parent)
+    : QLabel(parent)
+    , m_zoomFactor(1.0)
+    , m_previewMode(false)
+    , m_generation(0)
+    , m_buildGeneration(0)
+    , m_refineTimer(new QTimer(this))
+    , m_pyramidWatcher(new QFutureWatcher<QVector<QImage>>(this))
+    , m_tileCache(TILE_CACHE_KB)
+{
+    m_refineTimer->setSingleShot(true);
+    m_refineTimer->setInterval(REFINE_DELAY_MS);
+    connect(m_refineTimer, &QTimer::timeout, this, &qlabel_TiledImage::refineVisibleTiles);
+    connect(m_pyramidWatcher, &QFutureWatcher<QVector<QImage>>::finished, this, &qlabel_TiledImage::onPyramidBuilt);
+}
+
+qlabel_TiledImage::~qlabel_TiledImage()
+{
+    // A pyramid build still running in the thread pool only holds its own copy of the image,
+    // its result is simply dropped
+    clearTiledImage();
+}
+
+void qlabel_TiledImage::setTiledImage(const QImage& image)
+{
+    clearTiledImage();
+    if (image.isNull()) {
+        return;
+    }
+
+    // Make sure no pixmap/movie from a previous image is drawn underneath
+    QLabel::clear();
+
+    m_levels.append(image);
+    m_zoomFactor = 1.0;
+    m_buildGeneration = m_generation;
+    resize(image.size());
+
+    qDebug() << "qlabel_TiledImage: Building image pyramid in background for" << image.size();
+    m_pyramidWatcher->setFuture(QtConcurrent::run(&qlabel_TiledImage::buildPyramid, image));
+}
+
+void qlabel_TiledImage::clearTiledImage()
+{
+    m_generation++;
+    m_levels.clear();
+    m_tileCache.clear();
+    m_refineTimer->stop();
+    m_previewMode = false;
+}
+
+bool qlabel_TiledImage::hasTiledImage() const
+{
+    return !m_levels.isEmpty();
+}
+
+QSize qlabel_TiledImage::tiledImageSize() const
+{
+    return m_levels.isEmpty() ? QSize() : m_levels.first().size();
+}
+
+void qlabel_TiledImage::setZoomFactor(double zoomFactor)
+{
+    if (m_levels.isEmpty()) {
+        return;
+    }
+
+    m_zoomFactor = zoomFactor;
+    QSize originalSize = m_levels.first().size();
+    QSize zoomedSize(qMax(1, static_cast<int>(std::round(originalSize.width() * zoomFactor))),
+                     qMax(1, static_cast<int>(std::round(originalSize.height() * zoomFactor))));
+
+    // Tiles are rendered for one zoom level only, anything cached is now the wrong size
+    m_tileCache.clear();
+    m_previewMode = true;
+    resize(zoomedSize);
+    update();
+    m_refineTimer->start();
+}
+
+void qlabel_TiledImage::refineVisibleTiles()
+{
+    m_previewMode = false;
+    update();
+}
+
+void qlabel_TiledImage::onPyramidBuilt()
+{
+    if (m_buildGeneration != m_generation || m_levels.isEmpty()) {
+        return; // Image changed while the pyramid was being built
+    }
+    if (m_pyramidWatcher->future().resultCount() == 0) {
+        qWarning() << "qlabel_TiledImage: Pyramid build produced no result";
+        return;
+    }
+
+    QVector<QImage> levels = m_pyramidWatcher->result();
+    m_levels.resize(1);
+    m_levels += levels;
+    qDebug() << "qlabel_TiledImage: Image pyramid ready with" << m_levels.size() << "levels";
+
+    m_tileCache.clear();
+    update();
+}
+
+QVector<QImage> qlabel_TiledImage::buildPyramid(QImage source)
+{
+    QVector<QImage> levels;
+    QImage current = source;
+    while (qMax(current.width(), current.height()) >= MIN_LEVEL_DIMENSION * 2) {
+        current = current.scaled(qMax(1, current.width() / 2), qMax(1, current.height() / 2),
+                                 Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        if (current.isNull()) {
+            break;
+        }
+        levels.append(current);
+    }
+    return levels;
+}
+
+int qlabel_TiledImage::levelForZoom(double zoomFactor) const
+{
+    // Smallest level that still has at least one source pixel per screen pixel
+    int level = 0;
+    const double originalWidth = m_levels.first().width();
+    for (int i = 1; i < m_levels.size(); ++i) {
+        double levelScale = m_levels[i].width() / originalWidth;
+        if (levelScale < zoomFactor) {
+            break;
+        }
+        level = i;
+    }
+    return level;
+}
+
+QPixmap qlabel_TiledImage::renderTile(int level, int tileX, int tileY)
+{
+    QString key = QString("%1:%2:%3").arg(level).arg(tileX).arg(tileY);
+    if (QPixmap* cached = m_tileCache.object(key)) {
+        return *cached;
+    }
+
+    QRect tileRect = QRect(tileX * TILE_SIZE, tileY * TILE_SIZE, TILE_SIZE, TILE_SIZE) & rect();
+    if (tileRect.isEmpty()) {
+        return QPixmap();
+    }
+
+    const QImage& source = m_levels[level];
+    double scaleX = static_cast<double>(source.width()) / width();
+    double scaleY = static_cast<double>(source.height()) / height();
+    QRectF sourceRect(tileRect.x() * scaleX, tileRect.y() * scaleY,
+                      tileRect.width() * scaleX, tileRect.height() * scaleY);
+
+    QImage tile(tileRect.size(), QImage::Format_ARGB32_Premultiplied);
+    tile.fill(Qt::transparent);
+    QPainter tilePainter(&tile);
+    tilePainter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+    tilePainter.drawImage(QRectF(QPointF(0, 0), QSizeF(tileRect.size())), source, sourceRect);
+    tilePainter.end();
+
+    QPixmap pixmap = QPixmap::fromImage(tile);
+    int costKB = qMax(1, tileRect.width() * tileRect.height() * 4 / 1024);
+    m_tileCache.insert(key, new QPixmap(pixmap), costKB);
+    return pixmap;
+}
+
+void qlabel_TiledImage::paintEvent(QPaintEvent *event)
+{
+    if (m_levels.isEmpty()) {
+        QLabel::paintEvent(event);
+        return;
+    }
+
+    // The scroll area only asks us to repaint what is actually visible
+    QRect exposed = event->rect() & rect();
+    if (exposed.isEmpty()) {
+        return;
+    }
+
+    QPainter painter(this);
+    int level = levelForZoom(m_zoomFactor);
+
+    if (m_previewMode) {
+        // Fast preview while zooming, nearest-neighbour straight from the closest level
+        const QImage& source = m_levels[level];
+        double scaleX = static_cast<double>(source.width()) / width();
+        double scaleY = static_cast<double>(source.height()) / height();
+        QRectF sourceRect(exposed.x() * scaleX, exposed.y() * scaleY,
+                          exposed.width() * scaleX, exposed.height() * scaleY);
+        painter.drawImage(QRectF(exposed), source, sourceRect);
+        return;
+    }
+
+    int firstTileX = exposed.left() / TILE_SIZE;
+    int lastTileX = exposed.right() / TILE_SIZE;
+    int firstTileY = exposed.top() / TILE_SIZE;
+    int lastTileY = exposed.bottom() / TILE_SIZE;
+
+    for (int tileY = firstTileY; tileY <= lastTileY; ++tileY) {
+        for (int tileX = firstTileX; tileX <= lastTileX; ++tileX) {
+            QPixmap tile = renderTile(level, tileX, tileY);
+            if (!tile.isNull()) {
+                painter.drawPixmap(tileX * TILE_SIZE, tileY * TILE_SIZE, tile);
+            }
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef QLABEL_TILEDIMAGE_H
+#define QLABEL_TILEDIMAGE_H
+
+#include <QLabel>
+#include <QImage>
+#include <QPixmap>
+#include <QVector>
+#include <QCache>
+#include <QTimer>
+#include <QFutureWatcher>
+
+// Image label used by ImageViewer for very large static images.
+// Instead of rescaling the whole image on every zoom change, it keeps a pyramid of
+// half-size levels (built once in the background) and only paints the tiles that are
+// visible, sampled from the nearest level. Zoom changes paint a fast nearest-neighbour
+// preview first, then the visible tiles are re-rendered smoothly once zooming settles.
+// When no tiled image is set it behaves exactly like a plain QLabel.
+class qlabel_TiledImage : public QLabel
+{
+    Q_OBJECT
+
+public:
+    explicit qlabel_TiledImage(QWidget *parent = nullptr);
+    ~qlabel_TiledImage();
+
+    void setTiledImage(const QImage& image);
+    void clearTiledImage();
+    bool hasTiledImage() const;
+    QSize tiledImageSize() const;
+
+    // Resizes the label to the zoomed size and schedules a high quality refine
+    void setZoomFactor(double zoomFactor);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private slots:
+    void onPyramidBuilt();
+    void refineVisibleTiles();
+
+private:
+    static QVector<QImage> buildPyramid(QImage source);
+    int levelForZoom(double zoomFactor) const;
+    QPixmap renderTile(int level, int tileX, int tileY);
+
+    QVector<QImage> m_levels;   // m_levels[0] is the original image
+    double m_zoomFactor;
+    bool m_previewMode;
+    quint64 m_generation;       // Bumped for every new image so stale pyramid builds are ignored
+    quint64 m_buildGeneration;
+
+    QTimer* m_refineTimer;
+    QFutureWatcher<QVector<QImage>>* m_pyramidWatcher;
+    QCache<QString, QPixmap> m_tileCache;   // Cost is in KB
+
+    static const int TILE_SIZE = 256;
+    static const int REFINE_DELAY_MS = 150;
+    static const int MIN_LEVEL_DIMENSION = 512;
+    static const int TILE_CACHE_KB = 64 * 1024;
+};
+
+#endif // QLABEL_TILEDIMAGE_H
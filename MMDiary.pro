@@ -343,8 +343,10 @@ win32:RC_FILE = app.rc
 SOURCES += \
     CustomWidgets/diary/CombinedDelegate.cpp \
     CustomWidgets/diary/qlist_DiaryTextDisplay.cpp \
+    CustomWidgets/diary/DiaryDisplayModel.cpp \
     CustomWidgets/diary/qtextedit_DiaryTextInput.cpp \
     CustomWidgets/qcheckbox_PWValidation.cpp \
+    CustomWidgets/qlabel_TiledImage.cpp \
     CustomWidgets/qtab_Main.cpp \
     CustomWidgets/encrypteddata/encryptedfileitemwidget.cpp \
     CustomWidgets/encrypteddata/qlist_DataENC_Tags.cpp \
@@ -352,12 +354,27 @@ SOURCES += \
     CustomWidgets/tasklists/qtree_Tasklists_list.cpp \
     CustomWidgets/videoplayer/qlist_VP_ShowsList.cpp \
     Operations-Features/diary/operations_diary.cpp \
+    Operations-Features/diary/diary_searchindex.cpp \
+    Operations-Features/diary/diary_dateindex.cpp \
+    Operations-Features/diary/diary_imagecache.cpp \
+    Operations-Features/diary/diary_dayprefetcher.cpp \
+    Operations-Features/diary/diary_savequeue.cpp \
+    Operations-Features/diary/diary_imageingestor.cpp \
+    Operations-Features/diary/diary_exporter.cpp \
     Operations-Features/encrypteddata/operations_encrypteddata.cpp \
     Operations-Features/encrypteddata/encrypteddata_encryptionworkers.cpp \
+    Operations-Features/encrypteddata/encrypteddata_chunkcompression.cpp \
+    Operations-Features/encrypteddata/encrypteddata_imageprefetcher.cpp \
+    Operations-Features/encrypteddata/encrypteddata_mappedfilereader.cpp \
     Operations-Features/encrypteddata/encrypteddata_progressdialogs.cpp \
     Operations-Features/passwordmanager/operations_passwordmanager.cpp \
+    Operations-Features/passwordmanager/passwordmanager_vault.cpp \
     Operations-Features/settings/operations_settings.cpp \
     Operations-Features/tasklists/operations_tasklists.cpp \
+    Operations-Features/tasklists/tasklist_nameindex.cpp \
+    Operations-Features/tasklists/tasklist_orderkeys.cpp \
+    Operations-Features/tasklists/tasklist_searchindex.cpp \
+    Operations-Features/tasklists/tasklist_summarycache.cpp \
     Operations-Features/videoplayer/BaseVideoPlayer.cpp \
     Operations-Features/videoplayer/showsplayer/vp_shows_newepisode_checker.cpp \
     Operations-Features/videoplayer/vrplayer/vr_openvr_manager.cpp \
@@ -390,6 +407,11 @@ SOURCES += \
     Operations-Features/settings/settings_changepassword.cpp \
     Operations-Global/imageviewer.cpp \
     Operations-Global/inputvalidation.cpp \
+    Operations-Global/jobjournal.cpp \
+    Operations-Global/diaryrecordlog.cpp \
+    Operations-Global/tasklistrecordlog.cpp \
+    Operations-Global/recordlogfile.cpp \
+    Operations-Global/securedeletionqueue.cpp \
     Operations-Global/operations.cpp \
     Operations-Global/operations_files.cpp \
     Operations-Global/passwordvalidation.cpp \
@@ -413,8 +435,10 @@ SOURCES += \
 HEADERS += \
     CustomWidgets/diary/CombinedDelegate.h \
     CustomWidgets/diary/qlist_DiaryTextDisplay.h \
+    CustomWidgets/diary/DiaryDisplayModel.h \
     CustomWidgets/diary/qtextedit_DiaryTextInput.h \
     CustomWidgets/qcheckbox_PWValidation.h \
+    CustomWidgets/qlabel_TiledImage.h \
     CustomWidgets/qtab_Main.h \
     CustomWidgets/encrypteddata/encryptedfileitemwidget.h \
     CustomWidgets/encrypteddata/qlist_DataENC_Tags.h \
@@ -422,12 +446,27 @@ HEADERS += \
     CustomWidgets/tasklists/qtree_Tasklists_list.h \
     CustomWidgets/videoplayer/qlist_VP_ShowsList.h \
     Operations-Features/diary/operations_diary.h \
+    Operations-Features/diary/diary_searchindex.h \
+    Operations-Features/diary/diary_dateindex.h \
+    Operations-Features/diary/diary_imagecache.h \
+    Operations-Features/diary/diary_dayprefetcher.h \
+    Operations-Features/diary/diary_savequeue.h \
+    Operations-Features/diary/diary_imageingestor.h \
+    Operations-Features/diary/diary_exporter.h \
     Operations-Features/encrypteddata/operations_encrypteddata.h \
     Operations-Features/encrypteddata/encrypteddata_encryptionworkers.h \
+    Operations-Features/encrypteddata/encrypteddata_chunkcompression.h \
+    Operations-Features/encrypteddata/encrypteddata_imageprefetcher.h \
+    Operations-Features/encrypteddata/encrypteddata_mappedfilereader.h \
     Operations-Features/encrypteddata/encrypteddata_progressdialogs.h \
     Operations-Features/passwordmanager/operations_passwordmanager.h \
+    Operations-Features/passwordmanager/passwordmanager_vault.h \
     Operations-Features/settings/operations_settings.h \
     Operations-Features/tasklists/operations_tasklists.h \
+    Operations-Features/tasklists/tasklist_nameindex.h \
+    Operations-Features/tasklists/tasklist_orderkeys.h \
+    Operations-Features/tasklists/tasklist_searchindex.h \
+    Operations-Features/tasklists/tasklist_summarycache.h \
     Operations-Features/videoplayer/BaseVideoPlayer.h \
     Operations-Features/videoplayer/showsplayer/vp_shows_newepisode_checker.h \
     Operations-Features/videoplayer/vrplayer/vr_openvr_manager.h \
@@ -459,6 +498,11 @@ HEADERS += \
     Operations-Features/settings/settings_changepassword.h \
     Operations-Global/imageviewer.h \
     Operations-Global/inputvalidation.h \
+    Operations-Global/jobjournal.h \
+    Operations-Global/diaryrecordlog.h \
+    Operations-Global/tasklistrecordlog.h \
+    Operations-Global/recordlogfile.h \
+    Operations-Global/securedeletionqueue.h \
     Operations-Global/operations.h \
     Operations-Global/operations_files.h \
     Operations-Global/passwordvalidation.h \
@@ -0,0 +1,378 @@
+#include "diary_dateindex.h"
+#include "operations_files.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QDataStream>
+#include <QRegularExpression>
+#include <QDateTime>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>  // For std::memset
+
+const quint32 DiaryDateIndex::MANIFEST_MAGIC = 0x4D4D4444; // "MMDD"
+const quint32 DiaryDateIndex::MANIFEST_VERSION = 2; // 2 adds the month folder stamps
+
+DiaryDateIndex::DiaryDateIndex(const QByteArray& encryptionKey, const QString& diariesPath)
+    : m_encryptionKey(encryptionKey)
+    , m_diariesPath(diariesPath)
+{
+}
+
+DiaryDateIndex::~DiaryDateIndex()
+{
+    // SECURITY: Clear sensitive data
+    if (!m_encryptionKey.isEmpty()) {
+        volatile char* keyData = const_cast<volatile char*>(m_encryptionKey.data());
+        std::memset(const_cast<char*>(keyData), 0, m_encryptionKey.size());
+        m_encryptionKey.clear();
+    }
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+void DiaryDateIndex::load()
+{
+    if (!loadManifest()) {
+        rebuild();
+        return;
+    }
+
+    // A day added or removed behind our back (sync, backup restore, a crash before the manifest
+    // was saved) changes the modification time of its month folder. Only those months are rescanned.
+    const QHash<quint32, qint64> currentStamps = monthFolderStamps();
+    int changedMonths = 0;
+    for (auto it = currentStamps.constBegin(); it != currentStamps.constEnd(); ++it) {
+        if (m_monthStamps.value(it.key(), -1) != it.value()) {
+            scanMonth(it.key());
+            ++changedMonths;
+        }
+    }
+    for (auto it = m_monthStamps.constBegin(); it != m_monthStamps.constEnd(); ++it) {
+        if (!currentStamps.contains(it.key())) {
+            removeMonth(it.key());
+            ++changedMonths;
+        }
+    }
+    m_monthStamps = currentStamps;
+
+    qDebug() << "DiaryDateIndex: Loaded" << m_days.size() << "diary dates from manifest,"
+             << changedMonths << "changed months rescanned";
+    if (changedMonths > 0) {
+        saveManifest();
+    }
+}
+
+void DiaryDateIndex::rebuild()
+{
+    scanDirectories();
+    qDebug() << "DiaryDateIndex: Scanned" << m_days.size() << "diary dates";
+    saveManifest();
+}
+
+void DiaryDateIndex::insert(const QDate& date)
+{
+    if (!date.isValid()) {
+        return;
+    }
+    const quint32 day = toDay(date);
+    auto it = std::lower_bound(m_days.begin(), m_days.end(), day);
+    if (it != m_days.end() && *it == day) {
+        return;
+    }
+    m_days.insert(it, day);
+    stampMonth(date.year(), date.month());
+    saveManifest();
+}
+
+void DiaryDateIndex::remove(const QDate& date)
+{
+    const quint32 day = toDay(date);
+    auto it = std::lower_bound(m_days.begin(), m_days.end(), day);
+    if (it == m_days.end() || *it != day) {
+        return;
+    }
+    m_days.erase(it);
+    stampMonth(date.year(), date.month());
+    saveManifest();
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+bool DiaryDateIndex::contains(const QDate& date) const
+{
+    return std::binary_search(m_days.begin(), m_days.end(), toDay(date));
+}
+
+bool DiaryDateIndex::hasYear(int year) const
+{
+    auto it = std::lower_bound(m_days.begin(), m_days.end(), static_cast<quint32>(year) * 10000);
+    return it != m_days.end() && *it / 10000 == static_cast<quint32>(year);
+}
+
+QDate DiaryDateIndex::latest() const
+{
+    return m_days.isEmpty() ? QDate() : fromDay(m_days.last());
+}
+
+QDate DiaryDateIndex::latestBefore(const QDate& date) const
+{
+    auto it = std::lower_bound(m_days.begin(), m_days.end(), toDay(date));
+    if (it == m_days.begin()) {
+        return QDate();
+    }
+    return fromDay(*(it - 1));
+}
+
+QDate DiaryDateIndex::earliestAfter(const QDate& date) const
+{
+    auto it = std::upper_bound(m_days.begin(), m_days.end(), toDay(date));
+    if (it == m_days.end()) {
+        return QDate();
+    }
+    return fromDay(*it);
+}
+
+QStringList DiaryDateIndex::years() const
+{
+    QStringList result;
+    int lastYear = -1;
+    for (quint32 day : m_days) {
+        int year = static_cast<int>(day / 10000);
+        if (year != lastYear) {
+            result.append(QString::number(year));
+            lastYear = year;
+        }
+    }
+    return result;
+}
+
+QStringList DiaryDateIndex::months(int year) const
+{
+    QStringList result;
+    auto it = std::lower_bound(m_days.begin(), m_days.end(), static_cast<quint32>(year) * 10000);
+    auto end = std::lower_bound(it, m_days.end(), static_cast<quint32>(year + 1) * 10000);
+    int lastMonth = -1;
+    for (; it != end; ++it) {
+        int month = static_cast<int>((*it / 100) % 100);
+        if (month != lastMonth) {
+            result.append(QString("%1").arg(month, 2, 10, QChar('0')));
+            lastMonth = month;
+        }
+    }
+    return result;
+}
+
+QStringList DiaryDateIndex::days(int year, int month) const
+{
+    QStringList result;
+    const quint32 monthStart = static_cast<quint32>(year) * 10000 + static_cast<quint32>(month) * 100;
+    auto it = std::lower_bound(m_days.begin(), m_days.end(), monthStart);
+    auto end = std::lower_bound(it, m_days.end(), monthStart + 100);
+    for (; it != end; ++it) {
+        result.append(QString("%1").arg(*it % 100, 2, 10, QChar('0')));
+    }
+    return result;
+}
+
+QStringList DiaryDateIndex::datesInYear(int year) const
+{
+    QStringList result;
+    auto it = std::lower_bound(m_days.begin(), m_days.end(), static_cast<quint32>(year) * 10000);
+    auto end = std::lower_bound(it, m_days.end(), static_cast<quint32>(year + 1) * 10000);
+    for (; it != end; ++it) {
+        result.append(fromDay(*it).toString("yyyy.MM.dd"));
+    }
+    return result;
+}
+
+QStringList DiaryDateIndex::filePaths() const
+{
+    QStringList result;
+    result.reserve(m_days.size());
+    QDir baseDir(m_diariesPath);
+    for (quint32 day : m_days) {
+        result.append(baseDir.filePath(fromDay(day).toString("yyyy/MM/dd/yyyy.MM.dd") + ".txt"));
+    }
+    return result;
+}
+
+QDate DiaryDateIndex::dateFromPath(const QString& diaryFilePath)
+{
+    static const QRegularExpression dayPattern("^(\\d{4})\\.(\\d{2})\\.(\\d{2})\\.txt$");
+    QRegularExpressionMatch match = dayPattern.match(QFileInfo(diaryFilePath).fileName());
+    if (!match.hasMatch()) {
+        return QDate();
+    }
+    return QDate(match.captured(1).toInt(), match.captured(2).toInt(), match.captured(3).toInt());
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+quint32 DiaryDateIndex::toDay(const QDate& date)
+{
+    return static_cast<quint32>(date.year() * 10000 + date.month() * 100 + date.day());
+}
+
+QDate DiaryDateIndex::fromDay(quint32 day)
+{
+    return QDate(static_cast<int>(day / 10000), static_cast<int>((day / 100) % 100), static_cast<int>(day % 100));
+}
+
+void DiaryDateIndex::scanDirectories()
+{
+    m_days.clear();
+    m_monthStamps = monthFolderStamps();
+    for (auto it = m_monthStamps.constBegin(); it != m_monthStamps.constEnd(); ++it) {
+        appendMonthDays(it.key());
+    }
+    std::sort(m_days.begin(), m_days.end());
+}
+
+void DiaryDateIndex::scanMonth(quint32 month)
+{
+    removeMonth(month);
+    appendMonthDays(month);
+    std::sort(m_days.begin(), m_days.end());
+}
+
+void DiaryDateIndex::appendMonthDays(quint32 month)
+{
+    static const QRegularExpression twoDigitPattern("^\\d{2}$");
+
+    const int year = static_cast<int>(month / 100);
+    const int monthOfYear = static_cast<int>(month % 100);
+    QDir monthDir(monthFolderPath(year, monthOfYear));
+    const QStringList dayFolders = monthDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString& dayFolder : dayFolders) {
+        if (!twoDigitPattern.match(dayFolder).hasMatch()) {
+            continue;
+        }
+        QDate date(year, monthOfYear, dayFolder.toInt());
+        // A day folder can outlive its diary (e.g. leftover images), only the day file counts
+        if (date.isValid() &&
+            QFileInfo::exists(monthDir.filePath(dayFolder + "/" + date.toString("yyyy.MM.dd") + ".txt"))) {
+            m_days.append(toDay(date));
+        }
+    }
+}
+
+void DiaryDateIndex::removeMonth(quint32 month)
+{
+    auto begin = std::lower_bound(m_days.begin(), m_days.end(), month * 100);
+    auto end = std::lower_bound(begin, m_days.end(), (month + 1) * 100);
+    m_days.erase(begin, end);
+}
+
+void DiaryDateIndex::stampMonth(int year, int month)
+{
+    QFileInfo info(monthFolderPath(year, month));
+    if (info.exists()) {
+        m_monthStamps.insert(static_cast<quint32>(year * 100 + month), info.lastModified().toMSecsSinceEpoch());
+    }
+}
+
+QHash<quint32, qint64> DiaryDateIndex::monthFolderStamps() const
+{
+    static const QRegularExpression yearPattern("^\\d{4}$");
+    static const QRegularExpression twoDigitPattern("^\\d{2}$");
+
+    QHash<quint32, qint64> stamps;
+    QDir baseDir(m_diariesPath);
+    const QStringList yearFolders = baseDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString& yearFolder : yearFolders) {
+        if (!yearPattern.match(yearFolder).hasMatch()) {
+            continue;
+        }
+        QDir yearDir(baseDir.filePath(yearFolder));
+        const QFileInfoList monthFolders = yearDir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+        for (const QFileInfo& monthFolder : monthFolders) {
+            const int month = monthFolder.fileName().toInt();
+            if (!twoDigitPattern.match(monthFolder.fileName()).hasMatch() || month < 1 || month > 12) {
+                continue;
+            }
+            stamps.insert(static_cast<quint32>(yearFolder.toInt() * 100 + month),
+                          monthFolder.lastModified().toMSecsSinceEpoch());
+        }
+    }
+    return stamps;
+}
+
+QString DiaryDateIndex::monthFolderPath(int year, int month) const
+{
+    return QDir(m_diariesPath).filePath(QString("%1/%2").arg(year, 4, 10, QChar('0')).arg(month, 2, 10, QChar('0')));
+}
+
+QString DiaryDateIndex::manifestPath() const
+{
+    return QDir(m_diariesPath).absoluteFilePath("diary_dates.mmidx");
+}
+
+bool DiaryDateIndex::loadManifest()
+{
+    m_days.clear();
+    m_monthStamps.clear();
+
+    if (!QFileInfo::exists(manifestPath())) {
+        return false;
+    }
+    QByteArray data;
+    if (!OperationsFiles::readEncryptedBlob(manifestPath(), m_encryptionKey, data)) {
+        qWarning() << "DiaryDateIndex: Failed to read manifest, rescanning diaries";
+        return false;
+    }
+
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_15);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic == MANIFEST_MAGIC && version < MANIFEST_VERSION) {
+        qDebug() << "DiaryDateIndex: Manifest from an older version, rescanning diaries";
+        return false;
+    }
+    QVector<quint32> days;
+    QHash<quint32, qint64> monthStamps;
+    stream >> days >> monthStamps;
+    if (stream.status() != QDataStream::Ok || magic != MANIFEST_MAGIC || version != MANIFEST_VERSION) {
+        qWarning() << "DiaryDateIndex: Invalid manifest, rescanning diaries";
+        return false;
+    }
+
+    for (quint32 day : days) {
+        if (!fromDay(day).isValid()) {
+            qWarning() << "DiaryDateIndex: Invalid date in manifest, rescanning diaries";
+            return false;
+        }
+    }
+    std::sort(days.begin(), days.end());
+    days.erase(std::unique(days.begin(), days.end()), days.end());
+    m_days = days;
+    m_monthStamps = monthStamps;
+    return true;
+}
+
+bool DiaryDateIndex::saveManifest() const
+{
+    if (m_encryptionKey.isEmpty() || !QDir(m_diariesPath).exists()) {
+        return false;
+    }
+
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_5_15);
+        stream << MANIFEST_MAGIC << MANIFEST_VERSION << m_days << m_monthStamps;
+    }
+
+    if (!OperationsFiles::writeEncryptedBlob(manifestPath(), m_encryptionKey, data)) {
+        qWarning() << "DiaryDateIndex: Failed to write manifest:" << manifestPath();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,74 @@
+#ifndef DIARY_DATEINDEX_H
+#define DIARY_DATEINDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QDate>
+#include <QVector>
+#include <QHash>
+
+// Sorted in-memory list of the days that have a diary.
+// The year/month/day lists and the "latest/previous diary" lookups used to walk
+// Diaries/<year>/<month>/<day> with nested entryList() calls every time. The dates are now
+// kept in one sorted vector, loaded at login from an encrypted manifest (or built with a single
+// directory walk if there is none) and updated when diaries are created or deleted.
+// The manifest also keeps the modification time of every month folder. Months whose folder
+// changed since the manifest was written are rescanned on load.
+// Lookups are binary searches, listings are the matching range of the vector.
+class DiaryDateIndex
+{
+public:
+    DiaryDateIndex(const QByteArray& encryptionKey, const QString& diariesPath);
+    ~DiaryDateIndex();
+
+    // Loads the manifest, falls back to scanning the Diaries directory
+    void load();
+    // Discards the manifest and rebuilds the index from the directories
+    void rebuild();
+
+    void insert(const QDate& date);
+    void remove(const QDate& date);
+
+    bool isEmpty() const { return m_days.isEmpty(); }
+    bool contains(const QDate& date) const;
+    bool hasYear(int year) const;
+
+    QDate latest() const;
+    QDate latestBefore(const QDate& date) const;   // Invalid if there is none
+    QDate earliestAfter(const QDate& date) const;  // Invalid if there is none
+
+    QStringList years() const;                     // "yyyy", ascending
+    QStringList months(int year) const;            // "MM", ascending
+    QStringList days(int year, int month) const;   // "dd", ascending
+    QStringList datesInYear(int year) const;       // "yyyy.MM.dd", ascending
+    QStringList filePaths() const;                 // Day file of every diary, ascending
+
+    // Diary date from a Diaries/yyyy/MM/dd/yyyy.MM.dd.txt path, invalid if it isn't one
+    static QDate dateFromPath(const QString& diaryFilePath);
+
+private:
+    static quint32 toDay(const QDate& date);
+    static QDate fromDay(quint32 day);
+
+    bool loadManifest();
+    bool saveManifest() const;
+    void scanDirectories();
+    void scanMonth(quint32 month);          // month: yyyyMM
+    void appendMonthDays(quint32 month);
+    void removeMonth(quint32 month);
+    void stampMonth(int year, int month);
+    QHash<quint32, qint64> monthFolderStamps() const;
+    QString monthFolderPath(int year, int month) const;
+    QString manifestPath() const;
+
+    static const quint32 MANIFEST_MAGIC;
+    static const quint32 MANIFEST_VERSION;
+
+    QByteArray m_encryptionKey;
+    QString m_diariesPath;
+    QVector<quint32> m_days;   // yyyyMMdd, sorted ascending
+    QHash<quint32, qint64> m_monthStamps;   // yyyyMM -> month folder modification time (ms)
+};
+
+#endif // DIARY_DATEINDEX_H
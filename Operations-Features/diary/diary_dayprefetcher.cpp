@@ -0,0 +1,121 @@
+#include "diary_dayprefetcher.h"
+#include "diaryrecordlog.h"
+#include <QtConcurrent/QtConcurrent>
+#include <QDebug>
+#include <cstring>  // For std::memset
+
+DiaryDayPrefetcher::DiaryDayPrefetcher(const QByteArray& encryptionKey, QObject* parent)
+    : QObject(parent)
+    , m_encryptionKey(encryptionKey)
+{
+    m_threadPool.setMaxThreadCount(MAX_PARALLEL_READS);
+}
+
+DiaryDayPrefetcher::~DiaryDayPrefetcher()
+{
+    clear();
+    // A read cannot be interrupted, wait so it doesn't outlive the key
+    m_threadPool.waitForDone();
+
+    // SECURITY: Clear sensitive data
+    if (!m_encryptionKey.isEmpty()) {
+        volatile char* keyData = const_cast<volatile char*>(m_encryptionKey.data());
+        std::memset(const_cast<char*>(keyData), 0, m_encryptionKey.size());
+        m_encryptionKey.clear();
+    }
+}
+
+void DiaryDayPrefetcher::prefetch(const QString& diaryFilePath, bool warmRecordCache)
+{
+    if (diaryFilePath.isEmpty() || m_ready.contains(diaryFilePath) || m_pending.contains(diaryFilePath)) {
+        return;
+    }
+
+    QFutureWatcher<DayLines>* watcher = new QFutureWatcher<DayLines>(this);
+    connect(watcher, &QFutureWatcher<DayLines>::finished, this, [this, diaryFilePath]() {
+        onReadFinished(diaryFilePath);
+    });
+    watcher->setFuture(QtConcurrent::run(&m_threadPool, &DiaryDayPrefetcher::readDay,
+                                         diaryFilePath, m_encryptionKey, warmRecordCache));
+    m_pending.insert(diaryFilePath, watcher);
+}
+
+bool DiaryDayPrefetcher::isReady(const QString& diaryFilePath) const
+{
+    return m_ready.contains(diaryFilePath);
+}
+
+bool DiaryDayPrefetcher::isPending(const QString& diaryFilePath) const
+{
+    return m_pending.contains(diaryFilePath);
+}
+
+bool DiaryDayPrefetcher::take(const QString& diaryFilePath, QStringList& outLines)
+{
+    auto it = m_ready.find(diaryFilePath);
+    if (it == m_ready.end()) {
+        return false;
+    }
+    outLines = it.value();
+    m_ready.erase(it);
+    m_readyOrder.removeAll(diaryFilePath);
+    return true;
+}
+
+void DiaryDayPrefetcher::drop(const QString& diaryFilePath)
+{
+    if (QFutureWatcher<DayLines>* watcher = m_pending.take(diaryFilePath)) {
+        // The read finishes in the background, its result is ignored
+        disconnect(watcher, nullptr, this, nullptr);
+        connect(watcher, &QFutureWatcher<DayLines>::finished, watcher, &QObject::deleteLater);
+        if (watcher->isFinished()) {
+            watcher->deleteLater();
+        }
+    }
+    m_ready.remove(diaryFilePath);
+    m_readyOrder.removeAll(diaryFilePath);
+}
+
+void DiaryDayPrefetcher::clear()
+{
+    const QStringList pendingPaths = m_pending.keys();
+    for (const QString& path : pendingPaths) {
+        drop(path);
+    }
+    m_ready.clear();
+    m_readyOrder.clear();
+}
+
+void DiaryDayPrefetcher::onReadFinished(const QString& diaryFilePath)
+{
+    QFutureWatcher<DayLines>* watcher = m_pending.take(diaryFilePath);
+    if (!watcher) {
+        return;
+    }
+    watcher->deleteLater();
+
+    DayLines result;
+    if (watcher->future().resultCount() > 0) {
+        result = watcher->result();
+    }
+    if (!result.success) {
+        qWarning() << "DiaryDayPrefetcher: Failed to read diary file:" << diaryFilePath;
+        emit dayFailed(diaryFilePath);
+        return;
+    }
+
+    m_ready.insert(diaryFilePath, result.lines);
+    m_readyOrder.append(diaryFilePath);
+    while (m_readyOrder.size() > MAX_READY_DAYS) {
+        m_ready.remove(m_readyOrder.takeFirst());
+    }
+    emit dayReady(diaryFilePath);
+}
+
+DiaryDayPrefetcher::DayLines DiaryDayPrefetcher::readDay(QString diaryFilePath, QByteArray encryptionKey,
+                                                         bool warmRecordCache)
+{
+    DayLines result;
+    result.success = DiaryRecordLog::readLines(diaryFilePath, encryptionKey, result.lines, warmRecordCache);
+    return result;
+}
@@ -0,0 +1,61 @@
+#ifndef DIARY_DAYPREFETCHER_H
+#define DIARY_DAYPREFETCHER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QHash>
+#include <QThreadPool>
+#include <QFutureWatcher>
+
+// Reads diary day files in the background, ahead of the moment they are shown.
+// Used by the diary timeline, which adds older days above the display as the user scrolls up,
+// and to warm the record log cache with the days next to the one being viewed so switching
+// to them does not wait on decryption. Read days are kept until taken, dropped or evicted
+// (only a handful are kept at a time).
+class DiaryDayPrefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DiaryDayPrefetcher(const QByteArray& encryptionKey, QObject* parent = nullptr);
+    ~DiaryDayPrefetcher();
+
+    // Starts reading the day file unless it is already read or being read.
+    // warmRecordCache keeps the decrypted log in DiaryRecordLog's cache as well, for days that
+    // are likely to be opened rather than only displayed.
+    void prefetch(const QString& diaryFilePath, bool warmRecordCache = false);
+    bool isReady(const QString& diaryFilePath) const;
+    bool isPending(const QString& diaryFilePath) const;
+
+    // Hands over the lines of a read day and forgets them
+    bool take(const QString& diaryFilePath, QStringList& outLines);
+    // Forgets a day, e.g. because it was written to since it was read
+    void drop(const QString& diaryFilePath);
+    void clear();
+
+signals:
+    void dayReady(const QString& diaryFilePath);
+    void dayFailed(const QString& diaryFilePath);
+
+private:
+    struct DayLines {
+        QStringList lines;
+        bool success = false;
+    };
+
+    static DayLines readDay(QString diaryFilePath, QByteArray encryptionKey, bool warmRecordCache);
+    void onReadFinished(const QString& diaryFilePath);
+
+    QByteArray m_encryptionKey;
+    QThreadPool m_threadPool;
+    QHash<QString, QFutureWatcher<DayLines>*> m_pending;
+    QHash<QString, QStringList> m_ready;
+    QStringList m_readyOrder;   // Oldest read first
+
+    static const int MAX_PARALLEL_READS = 2;
+    static const int MAX_READY_DAYS = 4;
+};
+
+#endif // DIARY_DAYPREFETCHER_H
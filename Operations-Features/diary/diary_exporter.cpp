@@ -0,0 +1,385 @@
+#include "diary_exporter.h"
+#include "diary_dateindex.h"
+#include "diaryrecordlog.h"
+#include "CryptoUtils.h"
+#include "constants.h"
+#include <QtConcurrent/QtConcurrent>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QLocale>
+#include <QSaveFile>
+#include <QThread>
+#include <QDebug>
+#include <cstring>  // For std::memset
+
+static const char* const PAGE_STYLE =
+    "body{font-family:sans-serif;max-width:50em;margin:2em auto;padding:0 1em;line-height:1.4}"
+    "h1{text-align:center;font-size:1.4em}"
+    ".stamp{color:#2a6ebb;font-weight:bold;margin-top:1.5em}"
+    ".taskmanager{color:#7a7a7a}"
+    ".entry{white-space:pre-wrap;margin:.3em 0}"
+    "img{max-width:100%;margin:.5em 0;display:block}"
+    ".missing{color:#b00}";
+
+DiaryExporter::DiaryExporter(const QByteArray& encryptionKey, QObject* parent)
+    : QObject(parent)
+    , m_encryptionKey(encryptionKey)
+{
+    m_threadPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+}
+
+DiaryExporter::~DiaryExporter()
+{
+    if (m_watcher) {
+        cancel();
+        m_watcher->waitForFinished();
+    }
+    m_threadPool.waitForDone();
+
+    // SECURITY: Clear sensitive data
+    if (!m_encryptionKey.isEmpty()) {
+        volatile char* keyData = const_cast<volatile char*>(m_encryptionKey.data());
+        std::memset(const_cast<char*>(keyData), 0, m_encryptionKey.size());
+        m_encryptionKey.clear();
+    }
+}
+
+bool DiaryExporter::start(const QStringList& diaryFilePaths, const QString& outputPath, Format format)
+{
+    if (m_watcher) {
+        qWarning() << "DiaryExporter: An export is already running";
+        return false;
+    }
+
+    QDir outputDir(outputPath);
+    if (outputDir.exists() && !outputDir.isEmpty()) {
+        qWarning() << "DiaryExporter: Output folder is not empty:" << outputPath;
+        return false;
+    }
+    if (!outputDir.mkpath(".")) {
+        qWarning() << "DiaryExporter: Failed to create output folder:" << outputPath;
+        return false;
+    }
+
+    m_outputPath = outputDir.absolutePath();
+    m_dayCount = diaryFilePaths.size();
+    m_daysDone = 0;
+    m_bytesWritten = 0;
+    m_results.clear();
+    m_results.resize(diaryFilePaths.size());
+    m_cancelled = std::make_shared<QAtomicInt>(0);
+    m_timer.start();
+
+    // One task per day, the pool keeps every core busy and the days finish in any order
+    const QString output = m_outputPath;
+    const QByteArray encryptionKey = m_encryptionKey;
+    const std::shared_ptr<QAtomicInt> cancelled = m_cancelled;
+    auto exportOne = [output, format, encryptionKey, cancelled](const QString& diaryFilePath) {
+        return exportDay(diaryFilePath, output, format, encryptionKey, cancelled);
+    };
+
+    m_watcher = new QFutureWatcher<DayResult>(this);
+    connect(m_watcher, &QFutureWatcher<DayResult>::resultReadyAt, this, &DiaryExporter::onDayExported);
+    connect(m_watcher, &QFutureWatcher<DayResult>::finished, this, &DiaryExporter::onFinished);
+    m_watcher->setFuture(QtConcurrent::mapped(&m_threadPool, diaryFilePaths, exportOne));
+    return true;
+}
+
+void DiaryExporter::cancel()
+{
+    if (!m_watcher) {
+        return;
+    }
+    // Days not started yet are skipped, the ones being written check the flag between images
+    m_cancelled->fetchAndStoreOrdered(1);
+    m_watcher->cancel();
+}
+
+QString DiaryExporter::describeThroughput(const Summary& summary)
+{
+    const double seconds = qMax<qint64>(1, summary.elapsedMs) / 1000.0;
+    return QString("%1 days in %2 s (%3 days/s, %4 MB/s)")
+        .arg(summary.exportedDays)
+        .arg(seconds, 0, 'f', 1)
+        .arg(summary.exportedDays / seconds, 0, 'f', 0)
+        .arg(summary.bytesWritten / (1024.0 * 1024.0) / seconds, 0, 'f', 1);
+}
+
+// ============================================================================
+// Progress
+// ============================================================================
+
+void DiaryExporter::onDayExported(int index)
+{
+    if (!m_watcher || index < 0 || index >= m_results.size()) {
+        return;
+    }
+    const DayResult result = m_watcher->resultAt(index);
+    m_results[index] = result;
+    m_bytesWritten += result.bytesWritten;
+    ++m_daysDone;
+    emit progress(m_daysDone, m_dayCount, m_bytesWritten);
+}
+
+void DiaryExporter::onFinished()
+{
+    Summary summary;
+    summary.outputPath = m_outputPath;
+    summary.dayCount = m_dayCount;
+    summary.cancelled = m_cancelled->loadAcquire() != 0;
+    for (const DayResult& result : m_results) {
+        if (result.success) {
+            ++summary.exportedDays;
+        } else if (!summary.cancelled) {
+            ++summary.failedDays;
+        }
+        summary.exportedImages += result.exportedImages;
+        summary.failedImages += result.failedImages;
+    }
+    summary.bytesWritten = m_bytesWritten;
+    summary.elapsedMs = m_timer.elapsed();
+
+    // The index is written even for a cancelled export so whatever was exported can be browsed
+    if (!writeIndex(summary)) {
+        qWarning() << "DiaryExporter: Failed to write the export index";
+    }
+    qDebug() << "DiaryExporter: Export finished," << describeThroughput(summary);
+
+    m_watcher->deleteLater();
+    m_watcher = nullptr;
+    m_results.clear();
+    emit finished(summary);
+}
+
+bool DiaryExporter::writeIndex(const Summary& summary)
+{
+    QString html;
+    html += "<!DOCTYPE html>\n<html><head><meta charset=\"utf-8\"><title>Diary export</title>";
+    html += QString("<style>%1</style></head><body>\n").arg(PAGE_STYLE);
+    html += "<h1>Diary export</h1>\n";
+
+    int currentYear = 0;
+    int currentMonth = 0;
+    for (const DayResult& result : m_results) {
+        if (!result.success) {
+            continue;
+        }
+        if (result.date.year() != currentYear) {
+            if (currentMonth != 0) {
+                html += "</ul>\n";
+            }
+            currentYear = result.date.year();
+            currentMonth = 0;
+            html += QString("<h2>%1</h2>\n").arg(currentYear);
+        }
+        if (result.date.month() != currentMonth) {
+            if (currentMonth != 0) {
+                html += "</ul>\n";
+            }
+            currentMonth = result.date.month();
+            html += QString("<h3>%1</h3>\n<ul>\n").arg(QLocale::c().standaloneMonthName(currentMonth));
+        }
+        html += QString("<li><a href=\"%1\">%2</a> (%3 entries)</li>\n")
+                    .arg(result.relativePath.toHtmlEscaped(), result.header.toHtmlEscaped())
+                    .arg(result.entryCount);
+    }
+    if (currentMonth != 0) {
+        html += "</ul>\n";
+    }
+
+    html += "<hr><p>" + describeThroughput(summary).toHtmlEscaped();
+    if (summary.failedDays > 0 || summary.failedImages > 0) {
+        html += QString(", %1 days and %2 images could not be exported").arg(summary.failedDays).arg(summary.failedImages);
+    }
+    if (summary.cancelled) {
+        html += ", cancelled";
+    }
+    html += ".</p>\n</body></html>\n";
+
+    return writeFile(QDir(m_outputPath).filePath("index.html"), html.toUtf8());
+}
+
+// ============================================================================
+// Workers
+// ============================================================================
+
+bool DiaryExporter::writeFile(const QString& filePath, const QByteArray& data)
+{
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    if (file.write(data) != data.size()) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+DiaryExporter::DayResult DiaryExporter::exportDay(const QString& diaryFilePath, const QString& outputPath,
+                                                  Format format, const QByteArray& encryptionKey,
+                                                  const std::shared_ptr<QAtomicInt>& cancelled)
+{
+    DayResult result;
+    result.date = DiaryDateIndex::dateFromPath(diaryFilePath);
+    if (!result.date.isValid() || cancelled->loadAcquire() != 0) {
+        return result;
+    }
+
+    QStringList lines;
+    // Bulk read, don't push the days being edited out of the record log cache
+    if (!DiaryRecordLog::readLines(diaryFilePath, encryptionKey, lines, false) || lines.isEmpty()) {
+        qWarning() << "DiaryExporter: Failed to read diary:" << diaryFilePath;
+        return result;
+    }
+
+    const QString monthFolder = result.date.toString("yyyy/MM");
+    const QString fileName = result.date.toString("yyyy.MM.dd") + (format == Format::Html ? ".html" : ".txt");
+    result.relativePath = monthFolder + "/" + fileName;
+    result.header = lines.first();
+
+    QDir monthDir(QDir(outputPath).filePath(monthFolder));
+    if (!monthDir.mkpath(".")) {
+        qWarning() << "DiaryExporter: Failed to create folder:" << monthDir.path();
+        return result;
+    }
+
+    // Diary images are thumbnails (name.thumb) next to the encrypted original (name.ext)
+    const QDir diaryDir = QFileInfo(diaryFilePath).dir();
+    QHash<QString, QString> originals;   // Base name -> original file name
+    const QStringList dayFiles = diaryDir.entryList(QDir::Files);
+    for (const QString& name : dayFiles) {
+        if (!name.endsWith(".thumb") && name != QFileInfo(diaryFilePath).fileName()) {
+            originals.insert(QFileInfo(name).completeBaseName(), name);
+        }
+    }
+
+    auto exportImage = [&](const QString& imageName) -> QString {
+        // SECURITY FIX: The name comes from the diary line, it must not reach outside the day folder
+        // or, as the export name, outside the export folder
+        if (imageName.isEmpty() || imageName.contains('/') || imageName.contains('\\') ||
+            imageName.contains("..") || QFileInfo(imageName).fileName() != imageName) {
+            qWarning() << "DiaryExporter: Skipping image with invalid name:" << imageName;
+            return QString();
+        }
+        QString originalName = imageName;
+        if (imageName.endsWith(".thumb")) {
+            originalName = originals.value(QFileInfo(imageName).completeBaseName(), imageName);
+        }
+        // Thumbnails without an original are exported as the PNG they are
+        const QString exportName = originalName.endsWith(".thumb")
+                                       ? QFileInfo(originalName).completeBaseName() + ".png"
+                                       : QFileInfo(originalName).fileName();
+
+        QFile encryptedFile(diaryDir.filePath(originalName));
+        if (!encryptedFile.open(QIODevice::ReadOnly)) {
+            return QString();
+        }
+        const QByteArray encryptedData = encryptedFile.readAll();
+        encryptedFile.close();
+
+        QByteArray imageData = CryptoUtils::Encryption_DecryptBArray(encryptionKey, encryptedData);
+        bool written = !imageData.isEmpty() && monthDir.mkpath("images") && writeFile(monthDir.filePath("images/" + exportName), imageData);
+        if (written) {
+            result.bytesWritten += imageData.size();
+        }
+        // SECURITY: Don't leave the decrypted bytes lying around in freed memory
+        imageData.fill('\0');
+        return written ? "images/" + exportName : QString();
+    };
+
+    QString page;
+    if (format == Format::Html) {
+        page += "<!DOCTYPE html>\n<html><head><meta charset=\"utf-8\">";
+        page += "<title>" + result.header.toHtmlEscaped() + "</title>";
+        page += QString("<style>%1</style></head><body>\n").arg(PAGE_STYLE);
+        page += "<p><a href=\"../../index.html\">Index</a></p>\n";
+        page += "<h1>" + result.header.toHtmlEscaped() + "</h1>\n";
+    } else {
+        page += result.header + "\n";
+    }
+
+    // Same markers buildDisplayEntries() reads, written out instead of shown
+    bool nextLine_isTimeStamp = false;
+    bool nextLine_isTaskManager = false;
+    bool inTextBlock = false;
+    bool inImage = false;
+    QStringList textBlock;
+
+    auto appendEntry = [&](const QString& text) {
+        ++result.entryCount;
+        if (format == Format::Html) {
+            page += "<div class=\"entry\">" + text.toHtmlEscaped() + "</div>\n";
+        } else {
+            page += text + "\n";
+        }
+    };
+
+    for (int i = 1; i < lines.size(); ++i) {
+        const QString& line = lines.at(i);
+
+        if (line == Constants::Diary_TextBlockStart) {
+            inTextBlock = true;
+        } else if (line == Constants::Diary_TextBlockEnd) {
+            inTextBlock = false;
+            appendEntry(textBlock.join("\n"));
+            textBlock.clear();
+        } else if (inTextBlock) {
+            textBlock.append(line);
+        } else if (line == Constants::Diary_Spacer) {
+            if (format == Format::PlainText) {
+                page += "\n";
+            }
+        } else if (line == Constants::Diary_TimeStampStart) {
+            nextLine_isTimeStamp = true;
+        } else if (line == Constants::Diary_TaskManagerStart) {
+            nextLine_isTaskManager = true;
+        } else if (line == Constants::Diary_ImageStart) {
+            inImage = true;
+        } else if (line == Constants::Diary_ImageEnd) {
+            inImage = false;
+        } else if (inImage) {
+            if (cancelled->loadAcquire() != 0) {
+                return result;
+            }
+            const QString exportedPath = exportImage(line);
+            if (exportedPath.isEmpty()) {
+                ++result.failedImages;
+                page += format == Format::Html
+                            ? "<div class=\"missing\">[Image could not be exported: " + line.toHtmlEscaped() + "]</div>\n"
+                            : "[Image could not be exported: " + line + "]\n";
+            } else {
+                ++result.exportedImages;
+                page += format == Format::Html
+                            ? "<img src=\"" + exportedPath.toHtmlEscaped() + "\" alt=\"\">\n"
+                            : "[Image: " + exportedPath + "]\n";
+            }
+        } else if (nextLine_isTimeStamp || nextLine_isTaskManager) {
+            if (format == Format::Html) {
+                page += QString("<div class=\"stamp%1\">").arg(nextLine_isTaskManager ? " taskmanager" : "")
+                        + line.toHtmlEscaped() + "</div>\n";
+            } else {
+                page += line + "\n";
+            }
+            nextLine_isTimeStamp = false;
+            nextLine_isTaskManager = false;
+        } else {
+            appendEntry(line);
+        }
+    }
+
+    if (format == Format::Html) {
+        page += "</body></html>\n";
+    }
+
+    const QByteArray pageData = page.toUtf8();
+    if (!writeFile(monthDir.filePath(fileName), pageData)) {
+        qWarning() << "DiaryExporter: Failed to write day:" << result.relativePath;
+        return result;
+    }
+    result.bytesWritten += pageData.size();
+    result.success = true;
+    return result;
+}
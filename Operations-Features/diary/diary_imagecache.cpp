@@ -0,0 +1,237 @@
+#include "diary_imagecache.h"
+#include "CryptoUtils.h"
+#include <QBuffer>
+#include <QImageReader>
+#include <QFile>
+#include <QtConcurrent/QtConcurrent>
+#include <QDebug>
+#include <cstring>  // For std::memset
+
+// Same limits ImageViewer enforces, diary images are thumbnails or small pictures anyway
+static const int MAX_DECODE_DIMENSION = 10000;
+static const qint64 MAX_DECODE_PIXELS = 100000000;
+
+DiaryImageCache::DiaryImageCache(const QByteArray& encryptionKey, QObject* parent)
+    : QObject(parent)
+    , m_encryptionKey(encryptionKey)
+    , m_pixmaps(DEFAULT_MEMORY_LIMIT / 1024)
+{
+    m_threadPool.setMaxThreadCount(MAX_PARALLEL_JOBS);
+}
+
+DiaryImageCache::~DiaryImageCache()
+{
+    clear();
+    // Running jobs check the cancel flag between steps, wait so they don't outlive the key
+    m_threadPool.waitForDone();
+
+    // SECURITY: Clear sensitive data
+    if (!m_encryptionKey.isEmpty()) {
+        volatile char* keyData = const_cast<volatile char*>(m_encryptionKey.data());
+        std::memset(const_cast<char*>(keyData), 0, m_encryptionKey.size());
+        m_encryptionKey.clear();
+    }
+}
+
+void DiaryImageCache::setMemoryLimit(qint64 bytes)
+{
+    m_pixmaps.setMaxCost(qMax<qint64>(1, bytes / 1024));
+}
+
+// ============================================================================
+// Lookups
+// ============================================================================
+
+QPixmap DiaryImageCache::pixmap(const QString& encryptedPath, const QSize& targetSize)
+{
+    if (encryptedPath.isEmpty() || m_failed.contains(encryptedPath)) {
+        return QPixmap();
+    }
+
+    const ImageKey key{encryptedPath, targetSize.isValid() ? targetSize : QSize()};
+    if (QPixmap* cached = m_pixmaps.object(key)) {
+        return *cached;
+    }
+
+    // Scaling an already decoded image is cheap, only the crypto and decoding are worth a worker
+    QPixmap* source = m_pixmaps.object(ImageKey{encryptedPath, QSize()});
+    if (!source) {
+        request(encryptedPath);
+        return QPixmap();
+    }
+    if (!targetSize.isValid() || source->size().scaled(targetSize, Qt::KeepAspectRatio) == source->size()) {
+        return *source;
+    }
+
+    QPixmap scaled = source->scaled(targetSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    insertPixmap(key, scaled);
+    return scaled;
+}
+
+void DiaryImageCache::request(const QString& encryptedPath)
+{
+    if (encryptedPath.isEmpty() || m_failed.contains(encryptedPath) || m_pending.contains(encryptedPath)
+        || m_pixmaps.contains(ImageKey{encryptedPath, QSize()})) {
+        return;
+    }
+
+    PendingJob job;
+    job.cancelled = std::make_shared<QAtomicInt>(0);
+    job.watcher = new QFutureWatcher<DecodedImage>(this);
+    connect(job.watcher, &QFutureWatcher<DecodedImage>::finished, this, [this, encryptedPath]() {
+        onJobFinished(encryptedPath);
+    });
+    job.watcher->setFuture(QtConcurrent::run(&m_threadPool, &DiaryImageCache::decryptAndDecode,
+                                             encryptedPath, m_encryptionKey, job.cancelled));
+    m_pending.insert(encryptedPath, job);
+}
+
+QSize DiaryImageCache::imageSize(const QString& encryptedPath) const
+{
+    return m_imageSizes.value(encryptedPath);
+}
+
+bool DiaryImageCache::hasFailed(const QString& encryptedPath) const
+{
+    return m_failed.contains(encryptedPath);
+}
+
+bool DiaryImageCache::isPending(const QString& encryptedPath) const
+{
+    return m_pending.contains(encryptedPath);
+}
+
+// ============================================================================
+// Invalidation
+// ============================================================================
+
+void DiaryImageCache::remove(const QString& encryptedPath)
+{
+    cancelJob(encryptedPath);
+    m_imageSizes.remove(encryptedPath);
+    m_failed.remove(encryptedPath);
+
+    const QList<ImageKey> keys = m_pixmaps.keys();
+    for (const ImageKey& key : keys) {
+        if (key.path == encryptedPath) {
+            m_pixmaps.remove(key);
+        }
+    }
+}
+
+void DiaryImageCache::clear()
+{
+    const QStringList pendingPaths = m_pending.keys();
+    for (const QString& path : pendingPaths) {
+        cancelJob(path);
+    }
+    m_pixmaps.clear();
+    m_imageSizes.clear();
+    m_failed.clear();
+}
+
+void DiaryImageCache::cancelJob(const QString& encryptedPath)
+{
+    PendingJob job = m_pending.take(encryptedPath);
+    if (job.cancelled) {
+        job.cancelled->fetchAndStoreOrdered(1);
+    }
+    if (job.watcher) {
+        disconnect(job.watcher, nullptr, this, nullptr);
+        job.watcher->deleteLater();
+    }
+}
+
+// ============================================================================
+// Workers
+// ============================================================================
+
+qint64 DiaryImageCache::costOf(const QPixmap& pixmap)
+{
+    const qint64 bytes = static_cast<qint64>(pixmap.width()) * pixmap.height() * qMax(1, pixmap.depth() / 8);
+    return qMax<qint64>(1, bytes / 1024);
+}
+
+void DiaryImageCache::insertPixmap(const ImageKey& key, const QPixmap& pixmap)
+{
+    // QCache drops (and deletes) anything bigger than the whole budget, the caller still has its copy
+    m_pixmaps.insert(key, new QPixmap(pixmap), costOf(pixmap));
+}
+
+void DiaryImageCache::onJobFinished(const QString& encryptedPath)
+{
+    PendingJob job = m_pending.take(encryptedPath);
+    if (!job.watcher) {
+        return;
+    }
+    job.watcher->deleteLater();
+
+    DecodedImage result;
+    if (job.watcher->future().resultCount() > 0) {
+        result = job.watcher->result();
+    } else {
+        result.errorMessage = "Decoding produced no result";
+    }
+
+    if (result.image.isNull()) {
+        qWarning() << "DiaryImageCache: Failed to load image:" << encryptedPath << result.errorMessage;
+        m_failed.insert(encryptedPath);
+        emit imageFailed(encryptedPath);
+        return;
+    }
+
+    // QPixmap can only be created on the GUI thread, the workers hand over a QImage
+    const QPixmap decoded = QPixmap::fromImage(result.image);
+    m_imageSizes.insert(encryptedPath, decoded.size());
+    insertPixmap(ImageKey{encryptedPath, QSize()}, decoded);
+    emit imageReady(encryptedPath);
+}
+
+DiaryImageCache::DecodedImage DiaryImageCache::decryptAndDecode(QString encryptedPath, QByteArray encryptionKey,
+                                                                std::shared_ptr<QAtomicInt> cancelled)
+{
+    DecodedImage result;
+
+    QFile encryptedFile(encryptedPath);
+    if (!encryptedFile.open(QIODevice::ReadOnly)) {
+        result.errorMessage = "Failed to open encrypted image file";
+        return result;
+    }
+    const QByteArray encryptedData = encryptedFile.readAll();
+    encryptedFile.close();
+
+    if (cancelled->loadAcquire() != 0) {
+        result.errorMessage = "Cancelled";
+        return result;
+    }
+
+    QByteArray data = CryptoUtils::Encryption_DecryptBArray(encryptionKey, encryptedData);
+    if (data.isEmpty()) {
+        result.errorMessage = "Decryption failed";
+        return result;
+    }
+
+    {
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::ReadOnly);
+        QImageReader reader(&buffer);
+        QSize imageSize = reader.size();
+        qint64 pixelCount = static_cast<qint64>(imageSize.width()) * static_cast<qint64>(imageSize.height());
+
+        if (!imageSize.isValid()) {
+            result.errorMessage = "Unreadable image data";
+        } else if (imageSize.width() > MAX_DECODE_DIMENSION || imageSize.height() > MAX_DECODE_DIMENSION ||
+                   pixelCount > MAX_DECODE_PIXELS) {
+            result.errorMessage = "Image dimensions exceed the decode limits";
+        } else if (cancelled->loadAcquire() == 0) {
+            result.image = reader.read();
+            if (result.image.isNull()) {
+                result.errorMessage = reader.errorString();
+            }
+        }
+    }
+
+    // SECURITY: The decoded image is all we need, scrub the decrypted bytes
+    data.fill('\0');
+    return result;
+}
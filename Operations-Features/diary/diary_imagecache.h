@@ -0,0 +1,93 @@
+#ifndef DIARY_IMAGECACHE_H
+#define DIARY_IMAGECACHE_H
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QImage>
+#include <QPixmap>
+#include <QSize>
+#include <QHash>
+#include <QSet>
+#include <QCache>
+#include <QAtomicInt>
+#include <QThreadPool>
+#include <QFutureWatcher>
+#include <memory>
+
+// Decoded diary images.
+// Every paint of an image row used to read, decrypt and decode the image file again, and
+// loading a day decrypted each of its images once more just to size the rows. Images are now
+// decrypted and decoded on a small private thread pool, and the results are kept in an LRU of
+// pixmaps keyed by (file, target size) under a memory budget. Callers get a null pixmap while
+// an image is still being decoded and are told through imageReady() when to repaint.
+class DiaryImageCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DiaryImageCache(const QByteArray& encryptionKey, QObject* parent = nullptr);
+    ~DiaryImageCache();
+
+    // Pixmap scaled to fit targetSize (aspect ratio kept), or the decoded image itself if targetSize
+    // is invalid. Returns a null pixmap and queues the image for decoding if it isn't cached yet.
+    QPixmap pixmap(const QString& encryptedPath, const QSize& targetSize = QSize());
+    // Queues the image for decoding without asking for a pixmap
+    void request(const QString& encryptedPath);
+
+    // Pixel size of the decoded image, invalid until it has been decoded once
+    QSize imageSize(const QString& encryptedPath) const;
+    bool hasFailed(const QString& encryptedPath) const;
+    bool isPending(const QString& encryptedPath) const;
+
+    // Forgets everything about an image, e.g. after it was replaced or deleted
+    void remove(const QString& encryptedPath);
+    void clear();
+
+    void setMemoryLimit(qint64 bytes);
+
+signals:
+    void imageReady(const QString& encryptedPath);
+    void imageFailed(const QString& encryptedPath);
+
+private:
+    struct ImageKey {
+        QString path;
+        QSize size;   // Invalid for the unscaled decoded image
+        bool operator==(const ImageKey& other) const {
+            return size == other.size && path == other.path;
+        }
+    };
+    friend size_t qHash(const ImageKey& key, size_t seed) {
+        return qHashMulti(seed, key.path, key.size.width(), key.size.height());
+    }
+
+    struct DecodedImage {
+        QImage image;
+        QString errorMessage;
+    };
+
+    struct PendingJob {
+        QFutureWatcher<DecodedImage>* watcher = nullptr;
+        std::shared_ptr<QAtomicInt> cancelled;
+    };
+
+    static DecodedImage decryptAndDecode(QString encryptedPath, QByteArray encryptionKey,
+                                         std::shared_ptr<QAtomicInt> cancelled);
+    void onJobFinished(const QString& encryptedPath);
+    void cancelJob(const QString& encryptedPath);
+    void insertPixmap(const ImageKey& key, const QPixmap& pixmap);
+    static qint64 costOf(const QPixmap& pixmap);
+
+    QByteArray m_encryptionKey;
+    QThreadPool m_threadPool;
+    QCache<ImageKey, QPixmap> m_pixmaps;         // Cost is in KiB so large budgets fit
+    QHash<QString, QSize> m_imageSizes;          // Decoded size of every image seen, tiny
+    QSet<QString> m_failed;
+    QHash<QString, PendingJob> m_pending;
+
+    static const int MAX_PARALLEL_JOBS = 2;
+    static const qint64 DEFAULT_MEMORY_LIMIT = 64 * 1024 * 1024;
+};
+
+#endif // DIARY_IMAGECACHE_H
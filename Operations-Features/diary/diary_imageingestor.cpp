@@ -0,0 +1,227 @@
+#include "diary_imageingestor.h"
+#include "CryptoUtils.h"
+#include <QBuffer>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QImageReader>
+#include <QPainter>
+#include <QSaveFile>
+#include <QThread>
+#include <QtConcurrent/QtConcurrent>
+#include <QDebug>
+#include <cstring>  // For std::memset
+
+DiaryImageIngestor::DiaryImageIngestor(const QByteArray& encryptionKey, const QString& username,
+                                       const ThumbnailSizer& targetSizeFor, int squareCanvasSize, QObject* parent)
+    : QObject(parent)
+    , m_encryptionKey(encryptionKey)
+    , m_username(username)
+    , m_targetSizeFor(targetSizeFor)
+    , m_squareCanvasSize(squareCanvasSize)
+    , m_cancelled(std::make_shared<QAtomicInt>(0))
+{
+    m_threadPool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), MAX_PARALLEL_IMAGES));
+}
+
+DiaryImageIngestor::~DiaryImageIngestor()
+{
+    // Images that haven't started are skipped, running ones check the flag between steps
+    m_cancelled->fetchAndStoreOrdered(1);
+    m_threadPool.waitForDone();
+
+    // Nothing of an unfinished batch was added to a diary, its encrypted files would stay unreferenced
+    for (const Batch& batch : m_batches) {
+        for (const Job& job : batch.jobs) {
+            for (const QString& path : {job.encryptedPath, job.thumbnailPath}) {
+                if (QFile::exists(path) && !QFile::remove(path)) {
+                    qWarning() << "DiaryImageIngestor: Failed to remove image of cancelled batch:" << path;
+                }
+            }
+        }
+    }
+    m_batches.clear();
+
+    // SECURITY: Clear sensitive data
+    if (!m_encryptionKey.isEmpty()) {
+        volatile char* keyData = const_cast<volatile char*>(m_encryptionKey.data());
+        std::memset(const_cast<char*>(keyData), 0, m_encryptionKey.size());
+        m_encryptionKey.clear();
+    }
+}
+
+int DiaryImageIngestor::ingest(const QVector<Job>& jobs, qint64 maxFileSize)
+{
+    const int batchId = m_nextBatchId++;
+    if (jobs.isEmpty()) {
+        return batchId;
+    }
+
+    Batch batch;
+    batch.jobs = jobs;
+    batch.results.resize(jobs.size());
+    batch.remaining = jobs.size();
+    m_batches.insert(batchId, batch);
+
+    for (int index = 0; index < jobs.size(); ++index) {
+        QFutureWatcher<Result>* watcher = new QFutureWatcher<Result>(this);
+        connect(watcher, &QFutureWatcher<Result>::finished, this, [this, batchId, index, watcher]() {
+            onImageFinished(batchId, index, watcher);
+        });
+        watcher->setFuture(QtConcurrent::run(&m_threadPool, &DiaryImageIngestor::ingestImage,
+                                             jobs.at(index), m_encryptionKey, m_username, m_targetSizeFor,
+                                             m_squareCanvasSize, maxFileSize, m_cancelled));
+    }
+    return batchId;
+}
+
+void DiaryImageIngestor::onImageFinished(int batchId, int index, QFutureWatcher<Result>* watcher)
+{
+    watcher->deleteLater();
+
+    auto it = m_batches.find(batchId);
+    if (it == m_batches.end()) {
+        return;
+    }
+
+    Result result;
+    if (watcher->future().resultCount() > 0) {
+        result = watcher->result();
+    } else {
+        result.errorMessage = "processing produced no result";
+    }
+    it->results[index] = result;
+    if (result.success) {
+        emit imageIngested(batchId, index, result.displayPath);
+    }
+
+    if (--it->remaining == 0) {
+        const QVector<Result> results = it->results;
+        m_batches.erase(it);
+        emit batchFinished(batchId, results);
+    }
+}
+
+// ============================================================================
+// Workers
+// ============================================================================
+
+bool DiaryImageIngestor::encryptToFile(const QByteArray& encryptionKey, const QString& username,
+                                       const QByteArray& plainData, const QString& targetPath)
+{
+    QByteArray encryptedData = CryptoUtils::Encryption_EncryptBArray(encryptionKey, plainData, username);
+    if (encryptedData.isEmpty()) {
+        return false;
+    }
+
+    // QSaveFile so a half written image never ends up referenced by the diary
+    QSaveFile targetFile(targetPath);
+    if (!targetFile.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    if (targetFile.write(encryptedData) != encryptedData.size()) {
+        targetFile.cancelWriting();
+        return false;
+    }
+    return targetFile.commit();
+}
+
+DiaryImageIngestor::Result DiaryImageIngestor::ingestImage(Job job, QByteArray encryptionKey, QString username,
+                                                           ThumbnailSizer targetSizeFor, int squareCanvasSize,
+                                                           qint64 maxFileSize, std::shared_ptr<QAtomicInt> cancelled)
+{
+    Result result;
+    result.sourcePath = job.sourcePath;
+
+    if (cancelled->loadAcquire() != 0) {
+        result.errorMessage = "cancelled";
+        return result;
+    }
+
+    QFileInfo sourceInfo(job.sourcePath);
+    if (!sourceInfo.exists()) {
+        result.errorMessage = "file not found";
+        return result;
+    }
+    if (sourceInfo.size() > maxFileSize) {
+        result.errorMessage = "file too large for the available memory";
+        return result;
+    }
+
+    // Sizing only reads the image header
+    QImageReader sizeReader(job.sourcePath);
+    const QSize imageSize = sizeReader.size();
+    if (imageSize.isEmpty()) {
+        result.errorMessage = "invalid image";
+        return result;
+    }
+
+    // Encrypt and save the original image
+    {
+        QFile sourceFile(job.sourcePath);
+        if (!sourceFile.open(QIODevice::ReadOnly)) {
+            result.errorMessage = "cannot open file";
+            return result;
+        }
+        const QByteArray imageData = sourceFile.readAll();
+        sourceFile.close();
+
+        if (!encryptToFile(encryptionKey, username, imageData, job.encryptedPath)) {
+            result.errorMessage = "encryption failed";
+            return result;
+        }
+    }
+    result.success = true;
+    result.displayPath = job.encryptedPath;
+
+    if (cancelled->loadAcquire() != 0) {
+        return result; // The original is saved, the thumbnail can't be waited for anymore
+    }
+
+    // Thumbnail. The reader decodes straight to the scaled size where the format supports it
+    // (JPEG does), so full size photos aren't held in memory just to be shrunk.
+    const QSize targetSize = targetSizeFor(imageSize);
+    QImageReader thumbnailReader(job.sourcePath);
+    thumbnailReader.setScaledSize(imageSize.scaled(targetSize, Qt::KeepAspectRatio));
+    QImage thumbnail = thumbnailReader.read();
+    if (thumbnail.isNull()) {
+        qWarning() << "DiaryImageIngestor: Failed to generate thumbnail for" << job.sourcePath
+                   << thumbnailReader.errorString();
+        return result;
+    }
+    thumbnail = thumbnail.scaled(targetSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+    // Grouped image sized thumbnails are centered on a square canvas
+    if (targetSize.width() == targetSize.height() && targetSize.width() == squareCanvasSize) {
+        QImage squareThumbnail(targetSize, QImage::Format_ARGB32_Premultiplied);
+        squareThumbnail.fill(Qt::transparent);
+
+        QPainter painter(&squareThumbnail);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.drawImage((targetSize.width() - thumbnail.width()) / 2,
+                          (targetSize.height() - thumbnail.height()) / 2, thumbnail);
+        painter.end();
+        thumbnail = squareThumbnail;
+    }
+
+    // Encoded in memory, the unencrypted thumbnail never touches the disk
+    QByteArray pngData;
+    {
+        QBuffer buffer(&pngData);
+        buffer.open(QIODevice::WriteOnly);
+        if (!thumbnail.save(&buffer, "PNG")) {
+            qWarning() << "DiaryImageIngestor: Failed to encode thumbnail for" << job.sourcePath;
+            return result;
+        }
+    }
+
+    if (encryptToFile(encryptionKey, username, pngData, job.thumbnailPath)) {
+        result.displayPath = job.thumbnailPath;
+    } else {
+        qWarning() << "DiaryImageIngestor: Failed to save thumbnail for" << job.sourcePath;
+    }
+
+    // SECURITY: Scrub the unencrypted thumbnail bytes
+    pngData.fill('\0');
+    return result;
+}
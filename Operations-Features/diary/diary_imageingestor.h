@@ -0,0 +1,85 @@
+#ifndef DIARY_IMAGEINGESTOR_H
+#define DIARY_IMAGEINGESTOR_H
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QSize>
+#include <QHash>
+#include <QVector>
+#include <QAtomicInt>
+#include <QThreadPool>
+#include <QFutureWatcher>
+#include <functional>
+#include <memory>
+
+// Adds pasted or dropped images to a diary in the background.
+// Every image used to be sized, read, encrypted and thumbnailed one after the other on the GUI
+// thread, so dropping a few dozen photos froze the window until the last one was written.
+// A batch of images is now handed over with the file names already reserved, each image is
+// processed on a private thread pool and imageIngested() reports it as soon as its files are
+// written so its placeholder can show it. batchFinished() delivers all results in the order the
+// images were given, which is the order they are added to the diary in.
+class DiaryImageIngestor : public QObject
+{
+    Q_OBJECT
+
+public:
+    // One image of a batch, the target paths are chosen by the caller
+    struct Job {
+        QString sourcePath;
+        QString encryptedPath;      // Encrypted copy of the original
+        QString thumbnailPath;      // Encrypted thumbnail, shown in the diary
+    };
+
+    struct Result {
+        QString sourcePath;
+        QString displayPath;        // Thumbnail, or the original if no thumbnail could be written
+        QString errorMessage;       // Empty on success
+        bool success = false;
+    };
+
+    // targetSizeFor turns the size of an image into the size of its thumbnail. Thumbnails that
+    // come out as squareCanvasSize squares are centered on a transparent square canvas.
+    using ThumbnailSizer = std::function<QSize(const QSize&)>;
+
+    DiaryImageIngestor(const QByteArray& encryptionKey, const QString& username,
+                       const ThumbnailSizer& targetSizeFor, int squareCanvasSize, QObject* parent = nullptr);
+    ~DiaryImageIngestor();
+
+    // Starts a batch and returns its id. Source files bigger than maxFileSize are rejected.
+    // Batches still running when the ingestor is destroyed never report batchFinished(), the
+    // files they already wrote are removed instead.
+    int ingest(const QVector<Job>& jobs, qint64 maxFileSize);
+    bool isBusy() const { return !m_batches.isEmpty(); }
+
+signals:
+    void imageIngested(int batchId, int index, const QString& displayPath);
+    void batchFinished(int batchId, const QVector<DiaryImageIngestor::Result>& results);
+
+private:
+    struct Batch {
+        QVector<Job> jobs;
+        QVector<Result> results;
+        int remaining = 0;
+    };
+
+    static Result ingestImage(Job job, QByteArray encryptionKey, QString username, ThumbnailSizer targetSizeFor,
+                              int squareCanvasSize, qint64 maxFileSize, std::shared_ptr<QAtomicInt> cancelled);
+    static bool encryptToFile(const QByteArray& encryptionKey, const QString& username,
+                              const QByteArray& plainData, const QString& targetPath);
+    void onImageFinished(int batchId, int index, QFutureWatcher<Result>* watcher);
+
+    QByteArray m_encryptionKey;
+    QString m_username;
+    ThumbnailSizer m_targetSizeFor;
+    int m_squareCanvasSize;
+    QThreadPool m_threadPool;
+    std::shared_ptr<QAtomicInt> m_cancelled;
+    QHash<int, Batch> m_batches;
+    int m_nextBatchId = 1;
+
+    static const int MAX_PARALLEL_IMAGES = 4;   // Full size photos are decoded in parallel, keep memory in check
+};
+
+#endif // DIARY_IMAGEINGESTOR_H
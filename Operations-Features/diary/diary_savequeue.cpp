@@ -0,0 +1,193 @@
+#include "diary_savequeue.h"
+#include "diaryrecordlog.h"
+#include <QtConcurrent/QtConcurrent>
+#include <QFileInfo>
+#include <QDebug>
+#include <cstring>  // For std::memset
+
+DiarySaveQueue::DiarySaveQueue(const QByteArray& encryptionKey, QObject* parent)
+    : QObject(parent)
+    , m_encryptionKey(encryptionKey)
+{
+    m_threadPool.setMaxThreadCount(MAX_PARALLEL_WRITES);
+
+    m_idleTimer.setSingleShot(true);
+    m_idleTimer.setInterval(IDLE_DELAY_MS);
+    connect(&m_idleTimer, &QTimer::timeout, this, &DiarySaveQueue::startWrites);
+}
+
+DiarySaveQueue::~DiarySaveQueue()
+{
+    // Nothing the user typed may be lost, whatever is still dirty is written now
+    if (!flush()) {
+        qWarning() << "DiarySaveQueue: Some diary days could not be saved before shutdown";
+    }
+
+    // SECURITY: Clear sensitive data
+    m_dirty.clear();
+    if (!m_encryptionKey.isEmpty()) {
+        volatile char* keyData = const_cast<volatile char*>(m_encryptionKey.data());
+        std::memset(const_cast<char*>(keyData), 0, m_encryptionKey.size());
+        m_encryptionKey.clear();
+    }
+}
+
+void DiarySaveQueue::schedule(const QString& diaryFilePath, const QStringList& lines)
+{
+    if (diaryFilePath.isEmpty()) {
+        return;
+    }
+    // A newer snapshot replaces the older one, only the last state of a burst is written
+    m_dirty.insert(diaryFilePath, lines);
+    m_idleTimer.start();
+}
+
+bool DiarySaveQueue::isDirty(const QString& diaryFilePath) const
+{
+    return m_dirty.contains(diaryFilePath) || m_writing.contains(diaryFilePath);
+}
+
+bool DiarySaveQueue::pendingLines(const QString& diaryFilePath, QStringList& outLines) const
+{
+    auto dirty = m_dirty.constFind(diaryFilePath);
+    if (dirty != m_dirty.constEnd()) {
+        outLines = dirty.value();
+        return true;
+    }
+    auto writing = m_writingLines.constFind(diaryFilePath);
+    if (writing != m_writingLines.constEnd()) {
+        outLines = writing.value();
+        return true;
+    }
+    return false;
+}
+
+// ============================================================================
+// Flushing
+// ============================================================================
+
+bool DiarySaveQueue::flush()
+{
+    m_idleTimer.stop();
+
+    const QStringList writingPaths = m_writing.keys();
+    for (const QString& path : writingPaths) {
+        waitForWrite(path);
+    }
+
+    bool allWritten = true;
+    const QStringList dirtyPaths = m_dirty.keys();
+    for (const QString& path : dirtyPaths) {
+        if (!flush(path)) {
+            allWritten = false;
+        }
+    }
+    return allWritten;
+}
+
+bool DiarySaveQueue::flush(const QString& diaryFilePath)
+{
+    waitForWrite(diaryFilePath);
+
+    auto it = m_dirty.find(diaryFilePath);
+    if (it == m_dirty.end()) {
+        return true;
+    }
+    const QStringList lines = it.value();
+    m_dirty.erase(it);
+
+    const WriteResult result = writeDay(diaryFilePath, m_encryptionKey, lines);
+    finishWrite(diaryFilePath, result);
+    return result.success;
+}
+
+void DiarySaveQueue::discard(const QString& diaryFilePath)
+{
+    // A write that already started can't be taken back, let it land before the caller
+    // deletes or replaces the file
+    waitForWrite(diaryFilePath);
+    m_dirty.remove(diaryFilePath);
+}
+
+// ============================================================================
+// Workers
+// ============================================================================
+
+void DiarySaveQueue::startWrites()
+{
+    const QStringList dirtyPaths = m_dirty.keys();
+    for (const QString& path : dirtyPaths) {
+        if (m_writing.contains(path)) {
+            continue; // Written again once the current write is done
+        }
+        const QStringList lines = m_dirty.take(path);
+
+        QFutureWatcher<WriteResult>* watcher = new QFutureWatcher<WriteResult>(this);
+        connect(watcher, &QFutureWatcher<WriteResult>::finished, this, [this, path, watcher]() {
+            onWriteFinished(path, watcher);
+        });
+        m_writing.insert(path, watcher);
+        m_writingLines.insert(path, lines);
+        watcher->setFuture(QtConcurrent::run(&m_threadPool, &DiarySaveQueue::writeDay,
+                                             path, m_encryptionKey, lines));
+    }
+}
+
+void DiarySaveQueue::waitForWrite(const QString& diaryFilePath)
+{
+    QFutureWatcher<WriteResult>* watcher = m_writing.value(diaryFilePath, nullptr);
+    if (watcher) {
+        watcher->waitForFinished();
+        onWriteFinished(diaryFilePath, watcher);
+    }
+}
+
+void DiarySaveQueue::onWriteFinished(const QString& diaryFilePath, QFutureWatcher<WriteResult>* watcher)
+{
+    // The finished signal of a write that was already waited for can still arrive later
+    if (m_writing.value(diaryFilePath, nullptr) != watcher) {
+        return;
+    }
+    m_writing.remove(diaryFilePath);
+    const QStringList writtenLines = m_writingLines.take(diaryFilePath);
+    disconnect(watcher, nullptr, this, nullptr);
+    watcher->deleteLater();
+
+    WriteResult result;
+    if (watcher->future().resultCount() > 0) {
+        result = watcher->result();
+    } else {
+        result.lines = writtenLines;
+    }
+    finishWrite(diaryFilePath, result);
+
+    // Changed again while it was being written
+    if (m_dirty.contains(diaryFilePath) && !m_idleTimer.isActive()) {
+        m_idleTimer.start();
+    }
+}
+
+void DiarySaveQueue::finishWrite(const QString& diaryFilePath, const WriteResult& result)
+{
+    if (!result.success) {
+        qWarning() << "DiarySaveQueue: Failed to save diary file:" << diaryFilePath;
+        // Keep the content unless a newer snapshot came in meanwhile. It isn't retried on its
+        // own so a persistent failure doesn't spin, the next change or flush tries again.
+        if (!m_dirty.contains(diaryFilePath)) {
+            m_dirty.insert(diaryFilePath, result.lines);
+        }
+        emit dayWriteFailed(diaryFilePath);
+        return;
+    }
+    emit dayWritten(diaryFilePath, result.lines, result.created);
+}
+
+DiarySaveQueue::WriteResult DiarySaveQueue::writeDay(QString diaryFilePath, QByteArray encryptionKey,
+                                                     QStringList lines)
+{
+    WriteResult result;
+    result.created = !QFileInfo::exists(diaryFilePath);
+    result.success = DiaryRecordLog::writeLines(diaryFilePath, encryptionKey, lines);
+    result.lines = lines;
+    return result;
+}
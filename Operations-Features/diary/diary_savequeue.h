@@ -0,0 +1,74 @@
+#ifndef DIARY_SAVEQUEUE_H
+#define DIARY_SAVEQUEUE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QHash>
+#include <QTimer>
+#include <QThreadPool>
+#include <QFutureWatcher>
+
+// Write-behind saving of diary days.
+// Adding an entry, editing one, removing empty timestamps and pasting images each saved the day
+// synchronously on the GUI thread, so a burst of changes encrypted and wrote the file once per
+// action. A save now only marks the day dirty with a snapshot of its lines. Once no change came
+// in for IDLE_DELAY_MS the newest snapshot of every dirty day is written on a worker thread.
+// Writes of the same day never overlap, a day changed while it is being written is written again
+// afterwards. flush() writes everything right away on the calling thread, it is called on tab
+// switches, logout and shutdown and by anything that is about to touch a day file directly.
+class DiarySaveQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DiarySaveQueue(const QByteArray& encryptionKey, QObject* parent = nullptr);
+    ~DiarySaveQueue();
+
+    // Marks the day dirty, lines is the full content it should end up with
+    void schedule(const QString& diaryFilePath, const QStringList& lines);
+
+    // Whether the day has content that hasn't reached the disk yet
+    bool isDirty(const QString& diaryFilePath) const;
+    // Newest content of a dirty day, false if the disk is up to date
+    bool pendingLines(const QString& diaryFilePath, QStringList& outLines) const;
+
+    // Writes all dirty days (or just one) before returning. False if a write failed, the
+    // content is kept and written again by the next flush or idle period.
+    bool flush();
+    bool flush(const QString& diaryFilePath);
+
+    // Forgets unsaved content of a day, e.g. because the day is being deleted
+    void discard(const QString& diaryFilePath);
+
+signals:
+    // Emitted on the GUI thread after a day was written. created is true if the file was new.
+    void dayWritten(const QString& diaryFilePath, const QStringList& lines, bool created);
+    void dayWriteFailed(const QString& diaryFilePath);
+
+private:
+    struct WriteResult {
+        QStringList lines;
+        bool success = false;
+        bool created = false;
+    };
+
+    static WriteResult writeDay(QString diaryFilePath, QByteArray encryptionKey, QStringList lines);
+    void startWrites();
+    void waitForWrite(const QString& diaryFilePath);
+    void onWriteFinished(const QString& diaryFilePath, QFutureWatcher<WriteResult>* watcher);
+    void finishWrite(const QString& diaryFilePath, const WriteResult& result);
+
+    QByteArray m_encryptionKey;
+    QThreadPool m_threadPool;
+    QTimer m_idleTimer;
+    QHash<QString, QStringList> m_dirty;                           // Not written yet
+    QHash<QString, QFutureWatcher<WriteResult>*> m_writing;        // Being written
+    QHash<QString, QStringList> m_writingLines;                    // Snapshot being written
+
+    static const int IDLE_DELAY_MS = 800;
+    static const int MAX_PARALLEL_WRITES = 2;
+};
+
+#endif // DIARY_SAVEQUEUE_H
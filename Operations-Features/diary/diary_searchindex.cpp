@@ -0,0 +1,652 @@
+#include "diary_searchindex.h"
+#include "diaryrecordlog.h"
+#include "operations_files.h"
+#include "constants.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QDataStream>
+#include <QDateTime>
+#include <QRegularExpression>
+#include <QtConcurrent/QtConcurrent>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>  // For std::memset
+
+const quint32 DiarySearchIndex::INDEX_MAGIC = 0x4D4D5349; // "MMSI"
+const quint32 DiarySearchIndex::INDEX_VERSION = 1;
+
+DiarySearchIndex::DiarySearchIndex(const QByteArray& encryptionKey, const QString& diariesPath, QObject* parent)
+    : QObject(parent)
+    , m_encryptionKey(encryptionKey)
+    , m_diariesPath(diariesPath)
+    , m_indexTotal(0)
+    , m_dirty(false)
+{
+    m_threadPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+
+    connect(&m_indexWatcher, &QFutureWatcher<DayTokens>::resultReadyAt, this, &DiarySearchIndex::onDayIndexed);
+    connect(&m_indexWatcher, &QFutureWatcher<DayTokens>::finished, this, &DiarySearchIndex::onIndexingFinished);
+
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(SAVE_DELAY_MS);
+    connect(&m_saveTimer, &QTimer::timeout, this, [this]() { save(); });
+}
+
+DiarySearchIndex::~DiarySearchIndex()
+{
+    cancelIndexing();
+    if (m_dirty) {
+        save();
+    }
+
+    // SECURITY: Clear sensitive data
+    m_postings.clear();
+    m_dayTerms.clear();
+    if (!m_encryptionKey.isEmpty()) {
+        volatile char* keyData = const_cast<volatile char*>(m_encryptionKey.data());
+        std::memset(const_cast<char*>(keyData), 0, m_encryptionKey.size());
+        m_encryptionKey.clear();
+    }
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+void DiarySearchIndex::open(const QStringList& diaryFilePaths)
+{
+    if (!load()) {
+        m_postings.clear();
+        m_dayTerms.clear();
+        m_days.clear();
+    }
+
+    // Catch up with whatever changed while the index wasn't watching
+    const QHash<quint32, DayState> onDisk = statDiaryFiles(diaryFilePaths);
+    const QList<quint32> indexedDays = m_days.keys();
+    for (quint32 day : indexedDays) {
+        if (!onDisk.contains(day)) {
+            removeDayPostings(day);
+            m_days.remove(day);
+            m_dirty = true;
+        }
+    }
+
+    QStringList staleFiles;
+    for (auto it = onDisk.constBegin(); it != onDisk.constEnd(); ++it) {
+        auto indexed = m_days.constFind(it.key());
+        if (indexed == m_days.constEnd() || indexed->fileSize != it->fileSize || indexed->modified != it->modified) {
+            staleFiles.append(it->filePath);
+        }
+    }
+
+    qDebug() << "DiarySearchIndex: Opened with" << m_days.size() << "indexed days," << staleFiles.size() << "to reindex";
+    if (!staleFiles.isEmpty()) {
+        startIndexing(staleFiles);
+    } else if (m_dirty) {
+        scheduleSave();
+    }
+}
+
+void DiarySearchIndex::rebuild(const QStringList& diaryFilePaths)
+{
+    cancelIndexing();
+    m_postings.clear();
+    m_dayTerms.clear();
+    m_days.clear();
+    m_dirty = true;
+
+    QStringList allFiles;
+    const QHash<quint32, DayState> onDisk = statDiaryFiles(diaryFilePaths);
+    for (const DayState& state : onDisk) {
+        allFiles.append(state.filePath);
+    }
+    qDebug() << "DiarySearchIndex: Rebuilding index for" << allFiles.size() << "days";
+    startIndexing(allFiles);
+}
+
+bool DiarySearchIndex::isIndexing() const
+{
+    return m_indexWatcher.isRunning();
+}
+
+// ============================================================================
+// Incremental updates
+// ============================================================================
+
+void DiarySearchIndex::updateDay(const QString& diaryFilePath, const QStringList& diaryLines)
+{
+    const quint32 day = dayFromPath(diaryFilePath);
+    if (day == 0) {
+        qWarning() << "DiarySearchIndex: Not a diary day file:" << diaryFilePath;
+        return;
+    }
+
+    if (isIndexing()) {
+        m_changedWhileIndexing.insert(day);
+    }
+
+    removeDayPostings(day);
+    const QHash<QString, QVector<Posting>> postings = buildPostings(day, extractEntries(diaryLines));
+    for (auto it = postings.constBegin(); it != postings.constEnd(); ++it) {
+        m_postings[it.key()].append(it.value());
+    }
+    m_dayTerms.insert(day, postings.keys());
+
+    DayState state;
+    state.filePath = diaryFilePath;
+    statFile(diaryFilePath, state);
+    m_days.insert(day, state);
+
+    scheduleSave();
+}
+
+void DiarySearchIndex::removeDay(const QString& diaryFilePath)
+{
+    const quint32 day = dayFromPath(diaryFilePath);
+    if (day == 0) {
+        return;
+    }
+    if (isIndexing()) {
+        m_changedWhileIndexing.insert(day);
+    }
+    removeDayPostings(day);
+    m_days.remove(day);
+    scheduleSave();
+}
+
+void DiarySearchIndex::removeDayPostings(quint32 day)
+{
+    const QStringList terms = m_dayTerms.take(day);
+    for (const QString& term : terms) {
+        auto it = m_postings.find(term);
+        if (it == m_postings.end()) {
+            continue;
+        }
+        QVector<Posting>& postings = it.value();
+        postings.erase(std::remove_if(postings.begin(), postings.end(),
+                                      [day](const Posting& posting) { return posting.day == day; }),
+                       postings.end());
+        if (postings.isEmpty()) {
+            m_postings.erase(it);
+        }
+    }
+}
+
+// ============================================================================
+// Background indexing
+// ============================================================================
+
+void DiarySearchIndex::startIndexing(const QStringList& diaryFilePaths)
+{
+    cancelIndexing();
+    m_changedWhileIndexing.clear();
+    m_indexTotal = diaryFilePaths.size();
+
+    const QByteArray encryptionKey = m_encryptionKey;
+    m_indexWatcher.setFuture(QtConcurrent::mapped(&m_threadPool, diaryFilePaths,
+                                                  [encryptionKey](const QString& diaryFilePath) {
+                                                      return indexDayFile(diaryFilePath, encryptionKey);
+                                                  }));
+}
+
+void DiarySearchIndex::cancelIndexing()
+{
+    if (m_indexWatcher.isRunning()) {
+        m_indexWatcher.cancel();
+        m_indexWatcher.waitForFinished();
+    }
+}
+
+void DiarySearchIndex::onDayIndexed(int resultIndex)
+{
+    const DayTokens tokens = m_indexWatcher.resultAt(resultIndex);
+    if (tokens.valid && !m_changedWhileIndexing.contains(tokens.day)) {
+        mergeDay(tokens);
+    }
+    emit indexingProgress(m_indexWatcher.progressValue(), m_indexTotal);
+}
+
+void DiarySearchIndex::onIndexingFinished()
+{
+    // A cancelled run was replaced by a new one (or the index is going away)
+    if (m_indexWatcher.isCanceled() || m_indexWatcher.isRunning()) {
+        return;
+    }
+    m_changedWhileIndexing.clear();
+    qDebug() << "DiarySearchIndex: Indexing finished," << m_days.size() << "days," << m_postings.size() << "terms";
+    save();
+    emit indexingFinished();
+}
+
+void DiarySearchIndex::mergeDay(const DayTokens& tokens)
+{
+    removeDayPostings(tokens.day);
+    for (auto it = tokens.postings.constBegin(); it != tokens.postings.constEnd(); ++it) {
+        m_postings[it.key()].append(it.value());
+    }
+    m_dayTerms.insert(tokens.day, tokens.postings.keys());
+    m_days.insert(tokens.day, tokens.state);
+    m_dirty = true;
+}
+
+DiarySearchIndex::DayTokens DiarySearchIndex::indexDayFile(const QString& diaryFilePath, const QByteArray& encryptionKey)
+{
+    DayTokens tokens;
+    tokens.day = dayFromPath(diaryFilePath);
+    if (tokens.day == 0) {
+        return tokens;
+    }
+
+    // Stat before reading, a write that lands in between then just shows up as stale next time
+    tokens.state.filePath = diaryFilePath;
+    statFile(diaryFilePath, tokens.state);
+
+    QStringList diaryLines;
+    if (!DiaryRecordLog::readLines(diaryFilePath, encryptionKey, diaryLines, false)) {
+        qWarning() << "DiarySearchIndex: Failed to read diary file for indexing:" << diaryFilePath;
+        return tokens;
+    }
+
+    tokens.postings = buildPostings(tokens.day, extractEntries(diaryLines));
+    tokens.valid = true;
+    return tokens;
+}
+
+// ============================================================================
+// Tokenizing
+// ============================================================================
+
+QStringList DiarySearchIndex::extractEntries(const QStringList& diaryLines)
+{
+    QStringList entries;
+    QString textBlock;
+    bool inTextBlock = false;
+    bool inImage = false;
+    bool skipNextLine = false;
+
+    // The first line is the date header
+    for (int i = 1; i < diaryLines.size(); ++i) {
+        const QString& line = diaryLines[i];
+
+        if (inTextBlock) {
+            if (line == Constants::Diary_TextBlockEnd) {
+                inTextBlock = false;
+                textBlock.chop(1); // Trailing newline
+                entries.append(textBlock);
+                textBlock.clear();
+            } else {
+                textBlock += line + "\n";
+            }
+            continue;
+        }
+        if (inImage) {
+            inImage = (line != Constants::Diary_ImageEnd);
+            continue;
+        }
+        if (skipNextLine) {
+            skipNextLine = false; // Timestamp or Task Manager header
+            continue;
+        }
+
+        if (line == Constants::Diary_TextBlockStart) {
+            inTextBlock = true;
+        } else if (line == Constants::Diary_ImageStart) {
+            inImage = true;
+        } else if (line == Constants::Diary_TimeStampStart || line == Constants::Diary_TaskManagerStart) {
+            skipNextLine = true;
+        } else if (line != Constants::Diary_Spacer && line != Constants::Diary_TextBlockEnd &&
+                   line != Constants::Diary_ImageEnd) {
+            entries.append(line);
+        }
+    }
+
+    // A text block cut off by a torn write still counts
+    if (inTextBlock && !textBlock.isEmpty()) {
+        textBlock.chop(1);
+        entries.append(textBlock);
+    }
+    return entries;
+}
+
+QStringList DiarySearchIndex::tokenize(const QString& text)
+{
+    QStringList tokens;
+    QString current;
+    for (const QChar& c : text) {
+        if (c.isLetterOrNumber()) {
+            if (current.size() < MAX_TERM_LENGTH) {
+                current.append(c.toLower());
+            }
+        } else if (!current.isEmpty()) {
+            tokens.append(current);
+            current.clear();
+        }
+    }
+    if (!current.isEmpty()) {
+        tokens.append(current);
+    }
+    return tokens;
+}
+
+QHash<QString, QVector<DiarySearchIndex::Posting>> DiarySearchIndex::buildPostings(quint32 day, const QStringList& entries)
+{
+    QHash<QString, QVector<Posting>> postings;
+    const int entryCount = qMin(entries.size(), 0xFFFF + 1);
+    for (int entry = 0; entry < entryCount; ++entry) {
+        const QStringList tokens = tokenize(entries[entry]);
+        const int tokenCount = qMin(tokens.size(), 0xFFFF + 1);
+        for (int position = 0; position < tokenCount; ++position) {
+            Posting posting;
+            posting.day = day;
+            posting.entry = static_cast<quint16>(entry);
+            posting.position = static_cast<quint16>(position);
+            postings[tokens[position]].append(posting);
+        }
+    }
+    return postings;
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+DiarySearchIndex::Query DiarySearchIndex::parseQuery(const QString& text)
+{
+    Query query;
+
+    // Dates accept yyyy.MM.dd, yyyy.MM or yyyy, ranges are inclusive
+    auto parseDate = [](const QString& value, bool rangeEnd) {
+        QDate date = QDate::fromString(value, "yyyy.MM.dd");
+        if (date.isValid()) {
+            return date;
+        }
+        date = QDate::fromString(value, "yyyy.MM");
+        if (date.isValid()) {
+            return rangeEnd ? date.addMonths(1).addDays(-1) : date;
+        }
+        date = QDate::fromString(value, "yyyy");
+        if (date.isValid()) {
+            return rangeEnd ? QDate(date.year(), 12, 31) : date;
+        }
+        return QDate();
+    };
+
+    static const QRegularExpression partPattern("\"([^\"]*)\"?|(\\S+)");
+    QRegularExpressionMatchIterator it = partPattern.globalMatch(text);
+    while (it.hasNext()) {
+        QRegularExpressionMatch match = it.next();
+        QString word = match.captured(2);
+
+        if (word.startsWith("from:", Qt::CaseInsensitive)) {
+            query.from = parseDate(word.mid(5), false);
+            continue;
+        }
+        if (word.startsWith("to:", Qt::CaseInsensitive)) {
+            query.to = parseDate(word.mid(3), true);
+            continue;
+        }
+
+        const QStringList terms = tokenize(match.captured(1) + word);
+        if (!terms.isEmpty()) {
+            query.phrases.append(terms);
+        }
+    }
+    return query;
+}
+
+QList<DiarySearchIndex::Hit> DiarySearchIndex::search(const Query& query, int maxResults) const
+{
+    QList<Hit> hits;
+    if (query.isEmpty()) {
+        return hits;
+    }
+
+    const quint32 fromDay = query.from.isValid()
+        ? static_cast<quint32>(query.from.year() * 10000 + query.from.month() * 100 + query.from.day()) : 0;
+    const quint32 toDay = query.to.isValid()
+        ? static_cast<quint32>(query.to.year() * 10000 + query.to.month() * 100 + query.to.day()) : 0xFFFFFFFF;
+    auto entryKey = [](const Posting& posting) {
+        return (static_cast<quint64>(posting.day) << 16) | posting.entry;
+    };
+
+    // Every phrase narrows the set of matching entries
+    QSet<quint64> matchingEntries;
+    bool firstPhrase = true;
+    for (const QStringList& phrase : query.phrases) {
+        QVector<const QVector<Posting>*> termPostings;
+        for (const QString& term : phrase) {
+            auto it = m_postings.constFind(term);
+            if (it == m_postings.constEnd()) {
+                return hits; // A term that appears nowhere can't match
+            }
+            termPostings.append(&it.value());
+        }
+
+        // Positions of the following terms, to check that they come right after the first one
+        QVector<QSet<quint64>> followingPositions;
+        for (int i = 1; i < termPostings.size(); ++i) {
+            QSet<quint64> positions;
+            for (const Posting& posting : *termPostings[i]) {
+                if (posting.day >= fromDay && posting.day <= toDay) {
+                    positions.insert((entryKey(posting) << 16) | posting.position);
+                }
+            }
+            followingPositions.append(positions);
+        }
+
+        QSet<quint64> phraseEntries;
+        for (const Posting& posting : *termPostings[0]) {
+            if (posting.day < fromDay || posting.day > toDay) {
+                continue;
+            }
+            const quint64 key = entryKey(posting);
+            if (!firstPhrase && !matchingEntries.contains(key)) {
+                continue;
+            }
+            bool matches = true;
+            for (int i = 0; i < followingPositions.size() && matches; ++i) {
+                matches = followingPositions[i].contains((key << 16) | static_cast<quint64>(posting.position + i + 1));
+            }
+            if (matches) {
+                phraseEntries.insert(key);
+            }
+        }
+
+        matchingEntries = phraseEntries;
+        firstPhrase = false;
+        if (matchingEntries.isEmpty()) {
+            return hits;
+        }
+    }
+
+    QList<quint64> keys(matchingEntries.begin(), matchingEntries.end());
+    // Newest day first, entries of a day in the order they were written
+    std::sort(keys.begin(), keys.end(), [](quint64 a, quint64 b) {
+        const quint64 dayA = a >> 16;
+        const quint64 dayB = b >> 16;
+        return dayA != dayB ? dayA > dayB : a < b;
+    });
+
+    for (quint64 key : keys) {
+        if (hits.size() >= maxResults) {
+            break;
+        }
+        const quint32 day = static_cast<quint32>(key >> 16);
+        Hit hit;
+        hit.date = dateFromDay(day);
+        hit.entry = static_cast<int>(key & 0xFFFF);
+        hit.filePath = m_days.value(day).filePath;
+        hits.append(hit);
+    }
+    return hits;
+}
+
+// ============================================================================
+// Persistence
+// ============================================================================
+
+QString DiarySearchIndex::indexFilePath() const
+{
+    return QDir(m_diariesPath).absoluteFilePath("diary_search.mmidx");
+}
+
+void DiarySearchIndex::scheduleSave()
+{
+    m_dirty = true;
+    // While indexing, the index is saved once all days are in
+    if (!isIndexing()) {
+        m_saveTimer.start();
+    }
+}
+
+bool DiarySearchIndex::save()
+{
+    m_saveTimer.stop();
+    if (m_encryptionKey.isEmpty() || !QDir(m_diariesPath).exists()) {
+        return false;
+    }
+
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_5_15);
+        stream << INDEX_MAGIC << INDEX_VERSION;
+
+        stream << static_cast<quint32>(m_days.size());
+        for (auto it = m_days.constBegin(); it != m_days.constEnd(); ++it) {
+            stream << it.key() << it->fileSize << it->modified;
+        }
+
+        stream << static_cast<quint32>(m_postings.size());
+        for (auto it = m_postings.constBegin(); it != m_postings.constEnd(); ++it) {
+            stream << it.key() << static_cast<quint32>(it->size());
+            for (const Posting& posting : it.value()) {
+                stream << posting.day << posting.entry << posting.position;
+            }
+        }
+    }
+
+    const bool written = OperationsFiles::writeEncryptedBlob(indexFilePath(), m_encryptionKey, data);
+    data.fill('\0'); // SECURITY: The serialized index contains the diary vocabulary
+    if (!written) {
+        qWarning() << "DiarySearchIndex: Failed to write search index:" << indexFilePath();
+        return false;
+    }
+
+    m_dirty = false;
+    qDebug() << "DiarySearchIndex: Saved index," << m_days.size() << "days," << m_postings.size() << "terms";
+    return true;
+}
+
+bool DiarySearchIndex::load()
+{
+    m_postings.clear();
+    m_dayTerms.clear();
+    m_days.clear();
+
+    if (!QFileInfo::exists(indexFilePath())) {
+        return false;
+    }
+    QByteArray data;
+    if (!OperationsFiles::readEncryptedBlob(indexFilePath(), m_encryptionKey, data)) {
+        qWarning() << "DiarySearchIndex: Failed to read search index, it will be rebuilt";
+        return false;
+    }
+
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_15);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != INDEX_MAGIC || version != INDEX_VERSION) {
+        qWarning() << "DiarySearchIndex: Unknown search index format, it will be rebuilt";
+        data.fill('\0');
+        return false;
+    }
+
+    quint32 dayCount = 0;
+    stream >> dayCount;
+    for (quint32 i = 0; i < dayCount && stream.status() == QDataStream::Ok; ++i) {
+        quint32 day = 0;
+        DayState state;
+        stream >> day >> state.fileSize >> state.modified;
+        const QDate date = dateFromDay(day);
+        state.filePath = QDir(m_diariesPath).filePath(date.toString("yyyy/MM/dd/yyyy.MM.dd") + ".txt");
+        m_days.insert(day, state);
+    }
+
+    quint32 termCount = 0;
+    stream >> termCount;
+    for (quint32 i = 0; i < termCount && stream.status() == QDataStream::Ok; ++i) {
+        QString term;
+        quint32 postingCount = 0;
+        stream >> term >> postingCount;
+        QVector<Posting> postings;
+        postings.reserve(static_cast<int>(qMin<quint32>(postingCount, 1000000)));
+        for (quint32 j = 0; j < postingCount && stream.status() == QDataStream::Ok; ++j) {
+            Posting posting;
+            stream >> posting.day >> posting.entry >> posting.position;
+            postings.append(posting);
+            QStringList& dayTerms = m_dayTerms[posting.day];
+            if (dayTerms.isEmpty() || dayTerms.last() != term) {
+                dayTerms.append(term);
+            }
+        }
+        m_postings.insert(term, postings);
+    }
+    data.fill('\0');
+
+    if (stream.status() != QDataStream::Ok) {
+        qWarning() << "DiarySearchIndex: Search index is corrupted, it will be rebuilt";
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+QHash<quint32, DiarySearchIndex::DayState> DiarySearchIndex::statDiaryFiles(const QStringList& diaryFilePaths)
+{
+    QHash<quint32, DayState> days;
+    for (const QString& filePath : diaryFilePaths) {
+        const quint32 day = dayFromPath(filePath);
+        if (day == 0 || !QFileInfo::exists(filePath)) {
+            continue;
+        }
+        DayState state;
+        state.filePath = filePath;
+        statFile(filePath, state);
+        days.insert(day, state);
+    }
+    return days;
+}
+
+quint32 DiarySearchIndex::dayFromPath(const QString& diaryFilePath)
+{
+    // Day files are named yyyy.MM.dd.txt
+    static const QRegularExpression dayPattern("^(\\d{4})\\.(\\d{2})\\.(\\d{2})\\.txt$");
+    QRegularExpressionMatch match = dayPattern.match(QFileInfo(diaryFilePath).fileName());
+    if (!match.hasMatch()) {
+        return 0;
+    }
+    QDate date(match.captured(1).toInt(), match.captured(2).toInt(), match.captured(3).toInt());
+    if (!date.isValid()) {
+        return 0;
+    }
+    return static_cast<quint32>(date.year() * 10000 + date.month() * 100 + date.day());
+}
+
+QDate DiarySearchIndex::dateFromDay(quint32 day)
+{
+    return QDate(static_cast<int>(day / 10000), static_cast<int>((day / 100) % 100), static_cast<int>(day % 100));
+}
+
+void DiarySearchIndex::statFile(const QString& diaryFilePath, DayState& state)
+{
+    QFileInfo info(diaryFilePath);
+    state.fileSize = info.size();
+    state.modified = info.lastModified().toMSecsSinceEpoch();
+}
@@ -0,0 +1,135 @@
+#ifndef DIARY_SEARCHINDEX_H
+#define DIARY_SEARCHINDEX_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QDate>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+#include <QList>
+#include <QTimer>
+#include <QThreadPool>
+#include <QFutureWatcher>
+
+// Full-text search over all diary days.
+// Searching used to mean decrypting every day file. This keeps an inverted index
+// (term -> day/entry/position postings) in memory and persists it encrypted under the
+// user's Diaries directory. Operations_Diary updates it incrementally whenever a day is
+// written or deleted, and days that changed while the index wasn't watching (e.g. the app
+// was killed before the index was saved) are detected by size/mtime and reindexed on open.
+// Reindexing decrypts and tokenizes day files in parallel on a worker pool.
+//
+// Query syntax: words must all appear in the same entry, "quoted words" must appear as a
+// phrase, from:yyyy.MM.dd / to:yyyy.MM.dd limit the date range (yyyy.MM and yyyy work too).
+class DiarySearchIndex : public QObject
+{
+    Q_OBJECT
+public:
+    struct Query {
+        QList<QStringList> phrases;  // A single word is a one-term phrase
+        QDate from;
+        QDate to;
+        bool isEmpty() const { return phrases.isEmpty(); }
+    };
+
+    struct Hit {
+        QDate date;
+        QString filePath;
+        int entry = 0;               // Ordinal of the entry within the day, see extractEntries()
+    };
+
+    DiarySearchIndex(const QByteArray& encryptionKey, const QString& diariesPath, QObject* parent = nullptr);
+    ~DiarySearchIndex();
+
+    // Loads the saved index and reindexes the days that changed since it was saved.
+    // diaryFilePaths are all day files that currently exist (see DiaryDateIndex).
+    void open(const QStringList& diaryFilePaths);
+    // Drops the index and reindexes every day
+    void rebuild(const QStringList& diaryFilePaths);
+    bool isIndexing() const;
+
+    // Incremental updates, called after a day file was written or deleted
+    void updateDay(const QString& diaryFilePath, const QStringList& diaryLines);
+    void removeDay(const QString& diaryFilePath);
+
+    bool save();
+
+    static Query parseQuery(const QString& text);
+    // Hits are ordered newest day first
+    QList<Hit> search(const Query& query, int maxResults = DEFAULT_MAX_RESULTS) const;
+
+    // The searchable entries of a day: text blocks and plain lines, without markers,
+    // timestamps, the date header and image references
+    static QStringList extractEntries(const QStringList& diaryLines);
+    static QStringList tokenize(const QString& text);
+
+    static const int DEFAULT_MAX_RESULTS = 200;
+
+signals:
+    void indexingProgress(int done, int total);
+    void indexingFinished();
+
+private slots:
+    void onDayIndexed(int resultIndex);
+    void onIndexingFinished();
+
+private:
+    struct Posting {
+        quint32 day = 0;       // yyyyMMdd
+        quint16 entry = 0;
+        quint16 position = 0;
+    };
+
+    struct DayState {
+        QString filePath;
+        qint64 fileSize = 0;
+        qint64 modified = 0;   // msecs since epoch
+    };
+
+    struct DayTokens {
+        bool valid = false;
+        quint32 day = 0;
+        DayState state;
+        QHash<QString, QVector<Posting>> postings;
+    };
+
+    static DayTokens indexDayFile(const QString& diaryFilePath, const QByteArray& encryptionKey);
+    static QHash<QString, QVector<Posting>> buildPostings(quint32 day, const QStringList& entries);
+    static quint32 dayFromPath(const QString& diaryFilePath);
+    static QDate dateFromDay(quint32 day);
+    static void statFile(const QString& diaryFilePath, DayState& state);
+
+    bool load();
+    static QHash<quint32, DayState> statDiaryFiles(const QStringList& diaryFilePaths);
+    void startIndexing(const QStringList& diaryFilePaths);
+    void cancelIndexing();
+    void mergeDay(const DayTokens& tokens);
+    void removeDayPostings(quint32 day);
+    void scheduleSave();
+    QString indexFilePath() const;
+
+    static const quint32 INDEX_MAGIC;
+    static const quint32 INDEX_VERSION;
+    static const int MAX_TERM_LENGTH = 64;
+    static const int SAVE_DELAY_MS = 3000;
+
+    QByteArray m_encryptionKey;
+    QString m_diariesPath;
+
+    QHash<QString, QVector<Posting>> m_postings;
+    QHash<quint32, QStringList> m_dayTerms;   // Terms of each day, so a day can be removed without scanning every term
+    QHash<quint32, DayState> m_days;
+
+    QThreadPool m_threadPool;
+    QFutureWatcher<DayTokens> m_indexWatcher;
+    QSet<quint32> m_changedWhileIndexing;     // Results for these days are stale by the time they arrive
+    int m_indexTotal;
+
+    QTimer m_saveTimer;
+    bool m_dirty;
+};
+
+#endif // DIARY_SEARCHINDEX_H
@@ -2,6 +2,12 @@
 #include "CombinedDelegate.h"
 #include "CryptoUtils.h"
 #include "operations_files.h"
+#include "diaryrecordlog.h"
+#include "diary_searchindex.h"
+#include "diary_dateindex.h"
+#include "diary_imagecache.h"
+#include "diary_dayprefetcher.h"
+#include "diary_savequeue.h"
 #include "imageviewer.h"
 #include "qimagereader.h"
 #include "ui_mainwindow.h"
@@ -25,6 +31,8 @@
 #include <QRegularExpression>
 #include <QImage>
 #include <QUuid>
+#include <QScrollBar>
+#include <QProgressDialog>
 
 #ifdef Q_OS_WIN
 #include <windows.h>
@@ -44,6 +52,15 @@ static qint64 getAvailableSystemMemory()
     return 2LL * 1024 * 1024 * 1024; // 2GB default
 }
 
+// Largest image file that is read into memory for encryption
+static qint64 imageFileSizeLimit()
+{
+    // Calculate memory limit: 50% of available RAM, min 1GB, max 10GB
+    const qint64 MIN_LIMIT = 1LL * 1024 * 1024 * 1024;  // 1GB minimum
+    const qint64 MAX_LIMIT = 10LL * 1024 * 1024 * 1024; // 10GB maximum
+    return qBound(MIN_LIMIT, getAvailableSystemMemory() / 2, MAX_LIMIT);
+}
+
 Operations_Diary::Operations_Diary(MainWindow* mainWindow)
     : m_mainWindow(mainWindow)
 {
@@ -77,6 +94,54 @@ Operations_Diary::Operations_Diary(MainWindow* mainWindow)
                 processAndAddImages(imagePaths, imagePaths.size() > 1);
             });
 
+    // Full-text search over all diaries, the index catches up with changed days in the background
+    m_mainWindow->ui->listWidget_DiarySearchResults->setVisible(false);
+    connect(m_mainWindow->ui->lineEdit_DiarySearch, &QLineEdit::returnPressed,
+            this, &Operations_Diary::onDiarySearchRequested);
+    connect(m_mainWindow->ui->lineEdit_DiarySearch, &QLineEdit::textChanged,
+            this, [this](const QString& text) {
+                if (text.trimmed().isEmpty()) {
+                    setDiarySearchMode(false);
+                }
+            });
+    connect(m_mainWindow->ui->listWidget_DiarySearchResults, &QListWidget::itemClicked,
+            this, &Operations_Diary::openDiarySearchResult);
+
+    m_dateIndex = new DiaryDateIndex(m_mainWindow->user_Key, DiariesFilePath);
+    m_dateIndex->load();
+
+    m_searchIndex = new DiarySearchIndex(m_mainWindow->user_Key, DiariesFilePath, this);
+    m_searchIndex->open(m_dateIndex->filePaths());
+
+    m_saveQueue = new DiarySaveQueue(m_mainWindow->user_Key, this);
+    connect(m_saveQueue, &DiarySaveQueue::dayWritten, this, &Operations_Diary::onDiaryDayWritten);
+
+    m_imageIngestor = new DiaryImageIngestor(
+        m_mainWindow->user_Key, m_mainWindow->user_Username,
+        [](const QSize& imageSize) {
+            return calculateOptimalDisplaySize(imageSize, QSize(MAX_IMAGE_WIDTH, MAX_IMAGE_HEIGHT), MIN_THUMBNAIL_SIZE);
+        },
+        MIN_THUMBNAIL_SIZE, this);
+    connect(m_imageIngestor, &DiaryImageIngestor::imageIngested, this, &Operations_Diary::onImageIngested);
+    connect(m_imageIngestor, &DiaryImageIngestor::batchFinished, this, &Operations_Diary::onImageBatchFinished);
+
+    m_imageCache = new DiaryImageCache(m_mainWindow->user_Key, this);
+    connect(m_imageCache, &DiaryImageCache::imageReady, this, &Operations_Diary::onDiaryImageReady);
+    connect(m_imageCache, &DiaryImageCache::imageFailed, this, &Operations_Diary::onDiaryImageFailed);
+
+    // Timeline of older days above the display
+    m_dayPrefetcher = new DiaryDayPrefetcher(m_mainWindow->user_Key, this);
+    connect(m_dayPrefetcher, &DiaryDayPrefetcher::dayReady, this, &Operations_Diary::onDayPrefetched);
+    connect(m_dayPrefetcher, &DiaryDayPrefetcher::dayFailed, this, [this](const QString& diaryFilePath) {
+        if (diaryFilePath == m_timelineWantedDay) {
+            m_timelineWantedDay.clear(); // Tried again on the next scroll
+        }
+    });
+    connect(m_mainWindow->ui->DiaryTextDisplay->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &Operations_Diary::onTimelineScrolled);
+    connect(m_mainWindow->ui->DiaryTextDisplay, &qlist_DiaryTextDisplay::scrolledPastTop,
+            this, &Operations_Diary::extendTimeline);
+
     QApplication::instance()->installEventFilter(this);
 }
 
@@ -86,37 +151,44 @@ Operations_Diary::~Operations_Diary()
 
     // Clean up any open image viewers
     cleanupOpenImageViewers();
+
+    // Queued saves still need the indexes, write them before anything is torn down
+    flushPendingSaves();
+
+    // Unfinished image batches are cancelled, the ingestor removes what they wrote.
+    // Their clipboard temp files would otherwise wait for the next temp cleanup.
+    delete m_imageIngestor;
+    m_imageIngestor = nullptr;
+    for (const PendingImageBatch& batch : m_imageBatches) {
+        cleanupImageTempFiles(batch.sourcePaths);
+    }
+    m_imageBatches.clear();
+
+    // SECURITY: Drop the cached plaintext of the diary files
+    DiaryRecordLog::clearCache();
+
+    delete m_dateIndex;
+    m_dateIndex = nullptr;
 }
 
 // Operational Functions
 
-QList<QListWidgetItem*> Operations_Diary::getTextDisplayItems()
+DiaryDisplayModel* Operations_Diary::displayModel() const
 {
-    QList<QListWidgetItem*> items;
-    
-    // Safety check for m_mainWindow
-    if (!m_mainWindow || !m_mainWindow->ui || !m_mainWindow->ui->DiaryTextDisplay) {
-        qWarning() << "Operations_Diary: getTextDisplayItems called with invalid m_mainWindow or UI";
-        return items; // Return empty list
-    }
-    
-    int count = m_mainWindow->ui->DiaryTextDisplay->count();
-    
-    // SECURITY FIX: Limit list size to prevent memory exhaustion
-    const int MAX_ITEMS = 10000; // Maximum 10K items
-    if (count > MAX_ITEMS) {
-        qWarning() << "Operations_Diary: DiaryTextDisplay has too many items:" << count;
-        count = MAX_ITEMS;
-    }
-    
-    for(int i=0;i<count;i++)
-    {
-        QListWidgetItem* item = m_mainWindow->ui->DiaryTextDisplay->item(i);
-        if (item) {  // Only add non-null items
-            items.append(item);
-        }
+    return m_mainWindow->ui->DiaryTextDisplay->diaryModel();
+}
+
+void Operations_Diary::appendDeselectSpacer(bool hidden)
+{
+    displayModel()->appendEntry(DiaryDisplayModel::spacerEntry(hidden));
+}
+
+void Operations_Diary::removeDeselectSpacer()
+{
+    DiaryDisplayModel* model = displayModel();
+    if (model->count() > 0) {
+        model->removeEntries(model->count() - 1);
     }
-    return items;
 }
 
 QString Operations_Diary::GetDiaryDateStamp(QString date_time)
@@ -293,15 +365,15 @@ QString Operations_Diary::FormatDateTime(const QDateTime& dateTime)
 
 QString Operations_Diary::FindLastTimeStampType(int index)
 {
-    QList<QListWidgetItem*> items = getTextDisplayItems();
+    DiaryDisplayModel* model = displayModel();
     int start_index;
     if (index == 0)
     {
-        start_index = items.size() - 1;
+        start_index = model->count() - 1;
     }
     else
     {
-        if (index < 0 || index >= items.size())
+        if (index < 0 || index >= model->count())
         {
             qDebug() << "Operations_Diary: Invalid index:" << index;
             return "";
@@ -310,17 +382,7 @@ QString Operations_Diary::FindLastTimeStampType(int index)
     }
     for (int i = start_index; i >= 0; i--)
     {
-        // THREAD SAFETY: Use bounds checking for array access
-        if (i < 0 || i >= items.size()) {
-            qWarning() << "Operations_Diary: Index out of bounds in FindLastTimeStampType:" << i;
-            break;
-        }
-        QListWidgetItem* item = items.at(i);
-        if (!item) {
-            qWarning() << "Operations_Diary: Null item at index" << i;
-            continue;
-        }
-        QString itemText = item->text();
+        const QString& itemText = model->entry(i).text;
         if (itemText == Constants::Diary_TimeStampStart)
         {
             return Constants::Diary_TimeStampStart;
@@ -373,6 +435,11 @@ bool Operations_Diary::eventFilter(QObject* watched, QEvent* event)
 
 bool Operations_Diary::isYesterdaysDiaryEntry()
 {
+    // Older days of the timeline are never yesterday's, the previous diary would be
+    if (isTimelineRow(m_mainWindow->ui->DiaryTextDisplay->currentRow())) {
+        return false;
+    }
+
     // Check if we're viewing a previous diary entry (loaded together with current diary)
     if (m_mainWindow->ui->DiaryTextDisplay->currentRow() < previousDiaryLineCounter && previous_DiaryFileName != "") {
         // Get today's date
@@ -404,6 +471,11 @@ bool Operations_Diary::isYesterdaysDiaryEntry()
 
 bool Operations_Diary::isOldDiaryEntry()
 {
+    // Days loaded by the timeline are always older than the previous diary
+    if (isTimelineRow(m_mainWindow->ui->DiaryTextDisplay->currentRow())) {
+        return true;
+    }
+
     // Check if we're viewing a previous diary entry (loaded together with current diary)
     if (m_mainWindow->ui->DiaryTextDisplay->currentRow() < previousDiaryLineCounter && previous_DiaryFileName != "") {
         // Get today's date
@@ -460,31 +532,15 @@ void Operations_Diary::AddNewEntryToDisplay()
     //if the text has newlines, add markers so that when we load this later we can recreate the text block as a single item
     if(diaryText.contains("\n")) // if the text we input contains more than one line.
     {
-        m_mainWindow->ui->DiaryTextDisplay->addItem(Constants::Diary_TextBlockStart); // add text block start marker
-        QList<QListWidgetItem*> items = getTextDisplayItems();
-        // THREAD SAFETY: Check if items list is valid before accessing
-        if (!items.isEmpty()) {
-            m_mainWindow->ui->DiaryTextDisplay->item(items.length() - 1)->setHidden(true); // hide text block start marker
-        }
-        m_mainWindow->ui->DiaryTextDisplay->addItem(diaryText); // add text
-        items = getTextDisplayItems();
-        if (!items.isEmpty()) {
-            m_mainWindow->ui->DiaryTextDisplay->item(items.length() - 1)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(items.length() - 1)->flags() | Qt::ItemIsEditable); // make our new entry editable
-        }
-        m_mainWindow->ui->DiaryTextDisplay->addItem(Constants::Diary_TextBlockEnd); // add text block end marker
-        items = getTextDisplayItems();
-        if (!items.isEmpty()) {
-            m_mainWindow->ui->DiaryTextDisplay->item(items.length() - 1)->setHidden(true); // hide text block end marker
-        }
+        displayModel()->appendEntries({
+            DiaryDisplayModel::markerEntry(Constants::Diary_TextBlockStart),
+            DiaryDisplayModel::textEntry(diaryText, true),
+            DiaryDisplayModel::markerEntry(Constants::Diary_TextBlockEnd)
+        });
     }
     else
     {
-        m_mainWindow->ui->DiaryTextDisplay->addItem(diaryText); // add text
-        QList<QListWidgetItem*> items = getTextDisplayItems();
-        // THREAD SAFETY: Check if items list is valid before accessing
-        if (!items.isEmpty()) {
-            m_mainWindow->ui->DiaryTextDisplay->item(items.length() - 1)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(items.length() - 1)->flags() | Qt::ItemIsEditable); // make our new entry editable
-        }
+        displayModel()->appendEntry(DiaryDisplayModel::textEntry(diaryText, true)); // add our new, editable entry
     }
 }
 
@@ -520,11 +576,7 @@ void Operations_Diary::InputNewEntry(QString DiaryFileName)
 
     prevent_onDiaryTextDisplay_itemChanged = true; // variable used to prevent on_DiaryTextDisplay_itemChanged() from executing. this function is only for editing text
     // REMOVES THE SPACER WIDGET USED IN DESELECTING THE LAST ENTRY. WE DONT WANT TO SAVE IT IN THE DIARY FILE
-    QList<QListWidgetItem*> items = getTextDisplayItems();
-    // THREAD SAFETY: Check if items list is valid before accessing
-    if (!items.isEmpty()) {
-        m_mainWindow->ui->DiaryTextDisplay->takeItem(items.length() - 1);
-    }
+    removeDeselectSpacer();
     //----------------------//
     QDateTime date = QDateTime::currentDateTime(); // Get date and time
     QString formattedTime = date.toString("hh:mm"); // Format approprietly
@@ -564,16 +616,11 @@ void Operations_Diary::InputNewEntry(QString DiaryFileName)
     else // if enough time has passed since the last timestamp or we have reached the limit of entries without a spacer or the diary file is empty
     {
         QString timestamp = m_mainWindow->user_Displayname + " at " + formattedTime;
-        m_mainWindow->ui->DiaryTextDisplay->addItem(Constants::Diary_Spacer); //Add spacer
-        m_mainWindow->ui->DiaryTextDisplay->item(getTextDisplayItems().length() - 1)->setData(Qt::UserRole, true);// uses hidetext delegate to hide the spacer
-        m_mainWindow->ui->DiaryTextDisplay->item(getTextDisplayItems().length() - 1)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(getTextDisplayItems().length() - 1)->flags() & ~Qt::ItemIsEnabled); // disable the spacer
-        m_mainWindow->ui->DiaryTextDisplay->addItem(Constants::Diary_TimeStampStart); //Add timestamp start marker
-        m_mainWindow->ui->DiaryTextDisplay->item(getTextDisplayItems().length() - 1)->setHidden(true); // hide the timestamp marker
-        m_mainWindow->ui->DiaryTextDisplay->addItem(timestamp); //Add timestamp
-        m_mainWindow->ui->DiaryTextDisplay->item(getTextDisplayItems().length() - 1)->setData(Qt::UserRole+1, true);
-        font_TimeStamp.setFamily(timestamp); // define the value of the text that is going to have it's font changed.
-        m_mainWindow->ui->DiaryTextDisplay->item(getTextDisplayItems().length() - 1)->setFont(font_TimeStamp); // change the font of the last item in our list, which is our timestamp.
-        m_mainWindow->ui->DiaryTextDisplay->item(getTextDisplayItems().length() - 1)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(getTextDisplayItems().length() - 1)->flags() & ~Qt::ItemIsEnabled); // disable the timestamp
+        displayModel()->appendEntries({
+            DiaryDisplayModel::spacerEntry(),                                    // spacer, hidden by the hidetext delegate
+            DiaryDisplayModel::markerEntry(Constants::Diary_TimeStampStart),     // hidden timestamp start marker
+            DiaryDisplayModel::timeStampEntry(timestamp, false)                  // disabled, colored timestamp
+        });
         AddNewEntryToDisplay(); // Use the local function
         lastTimeStamp_Hours = formattedTime.section(":",0,0).toInt(); // update the hours value of our lastTimeStamp variable
         lastTimeStamp_Minutes = formattedTime.section(":",1,1).toInt(); // update the minutes value of our lastTimeStamp variable
@@ -602,18 +649,15 @@ void Operations_Diary::InputNewEntry(QString DiaryFileName)
 
     SaveDiary(DiaryFileName, false); // save todays diary
     //Add a spacer that is used only for one reason, being able to deselect the last entry of the display. IT IS NOT SAVED INTO OUR DIARY FILE
-    m_mainWindow->ui->DiaryTextDisplay->addItem(Constants::Diary_Spacer); //Add spacer
-    m_mainWindow->ui->DiaryTextDisplay->item(getTextDisplayItems().length() - 1)->setData(Qt::UserRole, true); // uses hidetext delegate to hide the spacer
-    m_mainWindow->ui->DiaryTextDisplay->item(getTextDisplayItems().length() - 1)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(getTextDisplayItems().length() - 1)->flags() & ~Qt::ItemIsEnabled); // disable the spacer
-    m_mainWindow->ui->DiaryTextDisplay->item(getTextDisplayItems().length() - 1)->setHidden(true);
+    appendDeselectSpacer(true);
     //------------------------------//
     prevent_onDiaryTextDisplay_itemChanged = false; // variable used to prevent on_DiaryTextDisplay_itemChanged() from executing. this function is only for editing text
 
     // Now select the newly added entry
     // Get the previous-to-last item (the actual entry, not the spacer)
 
-    if (Operations::GetListItems(m_mainWindow->ui->DiaryTextDisplay).length() > 1) {
-        m_mainWindow->ui->DiaryTextDisplay->setCurrentItem(m_mainWindow->ui->DiaryTextDisplay->item(Operations::GetListItems(m_mainWindow->ui->DiaryTextDisplay).length() - 2));
+    if (m_mainWindow->ui->DiaryTextDisplay->count() > 1) {
+        m_mainWindow->ui->DiaryTextDisplay->setCurrentRow(m_mainWindow->ui->DiaryTextDisplay->count() - 2);
     }
 
     UpdateDelegate();
@@ -647,43 +691,41 @@ void Operations_Diary::SaveDiary(QString DiaryFileName, bool previousDiary)
     pathComponents = relativePath.split("/", Qt::SkipEmptyParts);
     OperationsFiles::createHierarchicalDirectory(pathComponents, DiariesFilePath);
 
-    QList<QListWidgetItem *> items = getTextDisplayItems(); // get a list of all of our textdisplay items
-
+    DiaryDisplayModel* model = displayModel();
+    int firstRow, lastRow;
     if(previousDiary) // if we are saving the previous diary, example: we just edited an entry in the previous diary display
     {
-        foreach(QListWidgetItem *item, items) // for each line of text
-        {
-            if(items.indexOf(item) >= previousDiaryLineCounter) // if it's index is bigger or equal to the length of our previous diary display
-            {
-                items.removeAt(items.indexOf(item)); //remove the item from our list of text to save, so that we dont add todays diary content to our previous diary
-            }
-        }
+        // only the rows of the previous diary, so that we dont add todays diary content to our previous diary
+        // (nor the older days the timeline shows above it)
+        firstRow = m_timelineRowCount;
+        lastRow = qMin(previousDiaryLineCounter, model->count()) - 1;
     }
     else // otherwise we are saving todays diary
     {
-        items.remove(0, previousDiaryLineCounter); // remove the previous diary text. Prevents addition of previous diary content to new one.
+        // skip the previous diary rows. Prevents addition of previous diary content to new one.
+        firstRow = previousDiaryLineCounter;
+        lastRow = model->count() - 1;
     }
 
     // Construct the text content
     QStringList diaryContent;
-    foreach(QListWidgetItem *item, items)
+    diaryContent.reserve(lastRow - firstRow + 1);
+    for (int row = firstRow; row <= lastRow; ++row)
     {
-        bool isImageItem = item->data(Qt::UserRole+3).toBool();
+        const DiaryDisplayModel::Entry& entry = model->entry(row);
 
-        if (isImageItem) {
+        if (entry.flags & DiaryDisplayModel::PendingImage) {
+            continue; // Added to the file once its batch is done
+        }
+        if (entry.flags & DiaryDisplayModel::Image) {
             // Reconstruct image markers for single image items only
             diaryContent.append(Constants::Diary_ImageStart);
-
-            // Single image handling only
-            QString imagePath = item->data(Qt::UserRole+4).toString();
-            diaryContent.append(QFileInfo(imagePath).fileName());
-
+            diaryContent.append(QFileInfo(entry.imagePath).fileName());
             diaryContent.append(Constants::Diary_ImageEnd);
         } else {
             // Regular text item - validate before saving
-            QString itemText = item->text();
             InputValidation::ValidationResult contentResult =
-                InputValidation::validateInput(itemText, InputValidation::InputType::DiaryContent, 100000);
+                InputValidation::validateInput(entry.text, InputValidation::InputType::DiaryContent, 100000);
 
             if (!contentResult.isValid) {
                 qWarning() << "Invalid content in diary entry: " << contentResult.errorMessage;
@@ -692,17 +734,161 @@ void Operations_Diary::SaveDiary(QString DiaryFileName, bool previousDiary)
                 // For now, we'll continue but log the issue
             }
 
-            diaryContent.append(itemText);
+            diaryContent.append(entry.text);
         }
     }
 
-    // Use the centralized file operation to write and encrypt the file
-    bool success = OperationsFiles::writeEncryptedFileLines(DiaryFileName, m_mainWindow->user_Key, diaryContent);
-    if (!success) {
-        qDebug() << "Failed to save diary file: " << DiaryFileName;
+    // Written once the burst of changes is over, only the lines that changed since the last
+    // write are appended to the record log then
+    m_saveQueue->schedule(DiaryFileName, diaryContent);
+    if (m_dayPrefetcher) {
+        m_dayPrefetcher->drop(DiaryFileName);
     }
 }
 
+QVector<DiaryDisplayModel::Entry> Operations_Diary::buildDisplayEntries(const QStringList& diaryLines, const QString& diaryDir)
+{
+    QVector<DiaryDisplayModel::Entry> entries;
+    entries.reserve(diaryLines.size());
+
+    // SECURITY FIX: Add maximum text block size to prevent unbounded accumulation
+    const int MAX_TEXTBLOCK_SIZE = 100000; // 100K chars max per text block
+
+    const bool hideTaskManagerLogs = !m_mainWindow->setting_Diary_ShowTManLogs;
+    bool nextLine_isTimeStamp = false;
+    bool nextLine_isTextBlock = false;
+    bool nextLine_isImage = false;
+    bool nextLine_isTaskManager = false;
+    bool inTaskManagerSection = false; // Flag to track if we're in a Task Manager section
+    QString textblock;
+
+    // A text block is shown as one editable row between its hidden start and end markers
+    auto appendTextBlock = [&]() {
+        textblock.chop(1); // remove the last unecessary \n
+        DiaryDisplayModel::Entry text = DiaryDisplayModel::textEntry(textblock, true);
+        if (inTaskManagerSection) {
+            text.flags |= DiaryDisplayModel::Hidden;
+        }
+        entries.append(DiaryDisplayModel::markerEntry(Constants::Diary_TextBlockStart));
+        entries.append(text);
+        entries.append(DiaryDisplayModel::markerEntry(Constants::Diary_TextBlockEnd));
+        textblock.clear();
+    };
+
+    for (int i = 0; i < diaryLines.size(); ++i) {
+        const QString& line = diaryLines.at(i);
+
+        // Validate each line of content
+        InputValidation::ValidationResult contentResult =
+            InputValidation::validateInput(line, InputValidation::InputType::DiaryContent, 100000);
+        if (!contentResult.isValid) {
+            qWarning() << "Invalid content in diary entry during load: " << contentResult.errorMessage;
+            // Continue loading but log the issue
+        }
+
+        if (i == 0) // the first line of the diary contains the diary file date.
+        {
+            DiaryDisplayModel::Entry header = DiaryDisplayModel::textEntry(line, false);
+            header.itemFlags &= ~Qt::ItemIsEnabled;
+            header.flags |= DiaryDisplayModel::Centered;
+            entries.append(header);
+            continue;
+        }
+
+        if (line == Constants::Diary_TextBlockStart)
+        {
+            nextLine_isTextBlock = true; // this will remain true until we find a text block end marker
+        }
+        else if (line == Constants::Diary_TextBlockEnd)
+        {
+            nextLine_isTextBlock = false; // the text block has been loaded completely, we will now add it to display
+            appendTextBlock();
+        }
+        else if (nextLine_isTextBlock)
+        {
+            // SECURITY FIX: Prevent unbounded text block accumulation
+            if (textblock.length() + line.length() + 1 > MAX_TEXTBLOCK_SIZE) {
+                qWarning() << "Operations_Diary: Text block exceeds maximum size, splitting it";
+                appendTextBlock();
+            }
+            textblock += line + "\n";
+        }
+        else if (line == Constants::Diary_Spacer)
+        {
+            entries.append(DiaryDisplayModel::spacerEntry());
+            inTaskManagerSection = false; // If we're in a Task Manager section, hiding ends at the spacer
+        }
+        else if (line == Constants::Diary_TimeStampStart)
+        {
+            entries.append(DiaryDisplayModel::markerEntry(line));
+            nextLine_isTimeStamp = true;
+        }
+        else if (line == Constants::Diary_TaskManagerStart)
+        {
+            entries.append(DiaryDisplayModel::markerEntry(line));
+            nextLine_isTaskManager = true;
+            inTaskManagerSection = hideTaskManagerLogs; // Start hiding Task Manager content if setting is false
+        }
+        else if (line == Constants::Diary_ImageStart)
+        {
+            nextLine_isImage = true;
+        }
+        else if (line == Constants::Diary_ImageEnd)
+        {
+            nextLine_isImage = false;
+        }
+        else if (nextLine_isImage)
+        {
+            // Process the image filename - single image only now
+            QString imagePath = QDir::cleanPath(diaryDir + "/" + line);
+
+            // Images are decoded in the background by the image cache. Rows of images it has seen
+            // before get their real size right away, the others a placeholder size until the
+            // image is ready (see onDiaryImageReady). Broken images are reported through onDiaryImageFailed.
+            if (m_imageCache->hasFailed(imagePath) || !QFileInfo::exists(imagePath)) {
+                qWarning() << "Failed to load image (will be cleaned up later):" << imagePath;
+                markDiaryForCleanup = true;
+            } else {
+                QSize imageSize = m_imageCache->imageSize(imagePath);
+                if (!imageSize.isValid()) {
+                    m_imageCache->request(imagePath);
+                    imageSize = QSize(MAX_IMAGE_WIDTH, MAX_IMAGE_HEIGHT);
+                }
+                DiaryDisplayModel::Entry image = DiaryDisplayModel::imageEntry(imagePath, imageItemSize(imageSize));
+                if (inTaskManagerSection) {
+                    image.flags |= DiaryDisplayModel::Hidden;
+                }
+                entries.append(image);
+            }
+            // Note: nextLine_isImage remains true until we hit IMAGE_END
+        }
+        else if (nextLine_isTimeStamp)
+        {
+            entries.append(DiaryDisplayModel::timeStampEntry(line, false));
+            nextLine_isTimeStamp = false;
+        }
+        else if (nextLine_isTaskManager)
+        {
+            DiaryDisplayModel::Entry timestamp = DiaryDisplayModel::timeStampEntry(line, true);
+            if (hideTaskManagerLogs) {
+                timestamp.flags |= DiaryDisplayModel::Hidden;
+            }
+            entries.append(timestamp);
+            nextLine_isTaskManager = false;
+        }
+        else // if line is a diary entry
+        {
+            DiaryDisplayModel::Entry entry = DiaryDisplayModel::textEntry(line, true);
+            if (inTaskManagerSection) {
+                entry.flags |= DiaryDisplayModel::Hidden;
+            }
+            entries.append(entry);
+        }
+    }
+
+    return entries;
+}
+
 void Operations_Diary::LoadDiary(QString DiaryFileName)
 {
     // SECURITY FIX: Enhanced mutex protection for thread safety
@@ -760,6 +946,7 @@ void Operations_Diary::LoadDiary(QString DiaryFileName)
         return;
     }
 
+    resetTimeline(DiaryFileName); // Before clearing, the scroll bar jumping to the top must not pull in older days
     m_mainWindow->ui->DiaryTextDisplay->clear(); // Clear the Diary Display Before Loading the New Diary File
     QDateTime date = QDateTime::currentDateTime(); // Get date and time
     QString formattedTime = date.toString("yyyy.MM.dd"); // Format appropriately
@@ -770,22 +957,9 @@ void Operations_Diary::LoadDiary(QString DiaryFileName)
         return;
     }
 
-    QList<QListWidgetItem *> items; // create our listwidgetitem list variable
+    // The rows of both days are built here and handed to the display in a single reset
+    QVector<DiaryDisplayModel::Entry> entries;
     previousDiaryLineCounter = 0; // reset the previous diary line counter
-    bool nextLine_isTimeStamp = false;
-    bool nextLine_isTextBlock = false;
-    bool nextLine_isImage = false;
-    bool nextLine_isTaskManager = false;
-    bool inTaskManagerSection = false; // Flag to track if we're in a Task Manager section
-
-    QString textblock;
-    textblock.clear();
-    
-    // SECURITY FIX: Add maximum text block size to prevent unbounded accumulation
-    const int MAX_TEXTBLOCK_SIZE = 100000; // 100K chars max per text block
-
-    // Variable to track which diary directory we're currently processing
-    QString currentProcessingDiaryDir = currentDiaryDir;
 
     if(DiaryFileName == todayDiaryPath) // if we are opening today's diary
     {
@@ -805,59 +979,11 @@ void Operations_Diary::LoadDiary(QString DiaryFileName)
             dateString.section('.', 2, 2).toInt()
             );
 
-        // Calculate yesterday's date
-        QDate yesterdayDate = todayDate.addDays(-1);
-
-        // Format yesterday's date as YYYY.MM.DD
-        QString yesterdayString = QString("%1.%2.%3")
-                                      .arg(yesterdayDate.year())
-                                      .arg(yesterdayDate.month(), 2, 10, QChar('0'))
-                                      .arg(yesterdayDate.day(), 2, 10, QChar('0'));
-
-        // Check if yesterday's diary exists
-        prevDiaryPath = getDiaryFilePath(yesterdayString);
-        if (QFileInfo::exists(prevDiaryPath)) {
-            foundPrevDiary = true;
-        }
-        else {
-            // If yesterday's diary doesn't exist, find the most recent diary before today
-            QList<QString> allDiaries;
-
-            // Scan year folders
-            QDir baseDir(DiariesFilePath);
-            QStringList yearFolders = baseDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-            std::sort(yearFolders.begin(), yearFolders.end());
-
-            foreach(const QString &yearFolder, yearFolders) {
-                QDir yearDir(DiariesFilePath + yearFolder);
-                QStringList monthFolders = yearDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-                std::sort(monthFolders.begin(), monthFolders.end());
-
-                foreach(const QString &monthFolder, monthFolders) {
-                    QDir monthDir(DiariesFilePath + yearFolder + "/" + monthFolder);
-                    QStringList dayFolders = monthDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-                    std::sort(dayFolders.begin(), dayFolders.end());
-
-                    foreach(const QString &dayFolder, dayFolders) {
-                        QString diaryDateString = yearFolder + "." + monthFolder + "." + dayFolder;
-                        QString diaryPath = getDiaryFilePath(diaryDateString);
-
-                        // Add to our list if it's not today's diary
-                        if(diaryPath != todayDiaryPath) {
-                            allDiaries.append(diaryPath);
-                        }
-                    }
-                }
-            }
-
-            // Sort all diaries by date (since the path contains the date)
-            std::sort(allDiaries.begin(), allDiaries.end());
-
-            if(!allDiaries.isEmpty()) {
-                // Get the most recent diary (last one in the sorted list)
-                prevDiaryPath = allDiaries.last();
-                foundPrevDiary = true;
-            }
+        // The most recent diary before today, usually yesterday's
+        QDate previousDate = m_dateIndex->latestBefore(todayDate);
+        if (previousDate.isValid()) {
+            prevDiaryPath = getDiaryFilePath(previousDate.toString("yyyy.MM.dd"));
+            foundPrevDiary = !prevDiaryPath.isEmpty() && QFileInfo::exists(prevDiaryPath);
         }
 
         if(foundPrevDiary) {
@@ -867,234 +993,30 @@ void Operations_Diary::LoadDiary(QString DiaryFileName)
             QFileInfo prevDiaryFileInfo(previous_DiaryFileName);
             QString previousDiaryDir = prevDiaryFileInfo.dir().path();
 
-            // Set the processing directory to previous diary directory
-            currentProcessingDiaryDir = previousDiaryDir;
-
-            bool firstLineSetup = false;
             QStringList prevDiaryLines;
 
             // Read the previous diary file
-            bool readSuccess = OperationsFiles::readEncryptedFileLines(
-                previous_DiaryFileName, m_mainWindow->user_Key, prevDiaryLines);
+            bool readSuccess = readDiaryLines(previous_DiaryFileName, prevDiaryLines);
 
             if (!readSuccess) {
                 qDebug() << "Failed to read previous diary file: " << previous_DiaryFileName;
                 return;
             }
 
-            foreach(const QString& line, prevDiaryLines) {
-                // Validate each line of content
-                InputValidation::ValidationResult contentResult =
-                    InputValidation::validateInput(line, InputValidation::InputType::DiaryContent, 100000);
-
-                if (!contentResult.isValid) {
-                    qWarning() << "Invalid content in previous diary entry during load: " << contentResult.errorMessage;
-                    // Continue loading but log the issue
-                }
-
-                m_mainWindow->ui->DiaryTextDisplay->addItem(line); //add it to the text display
-                previousDiaryLineCounter++; // counts how many lines of text are part of the previous diary view
-
-                items = getTextDisplayItems(); // Update the list of all the text in the listview diary text display.
-                int lastindex = items.length() - 1; // use that list to get the last index of our listview diary text display
-                if(!items.isEmpty()) //if items is not empty, otherwise the software would crash by returning an invalid index
-                {
-                    if(firstLineSetup == false) // setup the first line of the diary. It contains the diary file date.
-                    {
-                        m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setTextAlignment(Qt::AlignCenter);
-                        m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->flags() & ~Qt::ItemIsEnabled);
-                        firstLineSetup = true;
-                    }
-                    if(line == Constants::Diary_TextBlockStart)
-                    {
-                        m_mainWindow->ui->DiaryTextDisplay->takeItem(lastindex); //remove text block start marker
-                        previousDiaryLineCounter--;
-                        nextLine_isTextBlock = true; // this will remain true until we find a text block end marker
-                    }
-                    else if(line == Constants::Diary_TextBlockEnd)
-                    {
-                        m_mainWindow->ui->DiaryTextDisplay->takeItem(lastindex); //remove text block end marker
-                        previousDiaryLineCounter--; // remove 1 to previousdiarylinecounter because we removed a line
-                        nextLine_isTextBlock = false; // the text block has been loaded completely, we will now add it to display
-                        m_mainWindow->ui->DiaryTextDisplay->addItem(Constants::Diary_TextBlockStart); // add text block start marker
-                        m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setHidden(true); // hide text block start marker
-                        textblock = textblock.left(textblock.length() - 1); // remove the last characters in text block, that is the last unecessary \n
-                        m_mainWindow->ui->DiaryTextDisplay->addItem(textblock); // add text block
-                        m_mainWindow->ui->DiaryTextDisplay->item(lastindex+1)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(lastindex+1)->flags() | Qt::ItemIsEditable); // make our new entry editable // +1 because we added 1 item since last calculating the last index
-                        m_mainWindow->ui->DiaryTextDisplay->addItem(Constants::Diary_TextBlockEnd); // add text block end marker
-                        m_mainWindow->ui->DiaryTextDisplay->item(lastindex+2)->setHidden(true); // hide text block end marker // +2 because we added 2 items since last calculating the last index
-                        textblock.clear(); // clear the textblock
-                        previousDiaryLineCounter = previousDiaryLineCounter + 3; // add 3 to previous... because we added 3 items
-
-                        // Hide text block if it's part of a Task Manager section and setting is false
-                        if (inTaskManagerSection && !m_mainWindow->setting_Diary_ShowTManLogs) {
-                            m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setHidden(true);
-                            m_mainWindow->ui->DiaryTextDisplay->item(lastindex+1)->setHidden(true);
-                            m_mainWindow->ui->DiaryTextDisplay->item(lastindex+2)->setHidden(true);
-                        }
-                    }
-                    else if(nextLine_isTextBlock == true)
-                    {
-                        // SECURITY FIX: Prevent unbounded text block accumulation
-                        if (textblock.length() + line.length() + 1 > MAX_TEXTBLOCK_SIZE) {
-                            qWarning() << "Operations_Diary: Text block exceeds maximum size, truncating";
-                            // Force end the text block
-                            nextLine_isTextBlock = false;
-                            m_mainWindow->ui->DiaryTextDisplay->addItem(Constants::Diary_TextBlockStart);
-                            m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setHidden(true);
-                            m_mainWindow->ui->DiaryTextDisplay->addItem(textblock);
-                            m_mainWindow->ui->DiaryTextDisplay->item(lastindex+1)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(lastindex+1)->flags() | Qt::ItemIsEditable);
-                            m_mainWindow->ui->DiaryTextDisplay->addItem(Constants::Diary_TextBlockEnd);
-                            m_mainWindow->ui->DiaryTextDisplay->item(lastindex+2)->setHidden(true);
-                            textblock.clear();
-                            previousDiaryLineCounter = previousDiaryLineCounter + 3;
-                            // Start a new text block with current line
-                            textblock = line + "\n";
-                            nextLine_isTextBlock = true;
-                        } else {
-                            textblock = textblock + line + "\n";
-                            m_mainWindow->ui->DiaryTextDisplay->takeItem(lastindex); //remove the line from the display
-                            previousDiaryLineCounter--; // remove 1 to previousdiarylinecounter because we removed a line
-                        }
-                    }
-                    else if(line == Constants::Diary_Spacer)
-                    {
-                        m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setData(Qt::UserRole, true);// uses hidetext delegate to hide the spacer
-                        m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->flags() & ~Qt::ItemIsEnabled); //disable the spacers
-
-                        // If we're in a Task Manager section, hiding ends at the spacer
-                        if (inTaskManagerSection) {
-                            inTaskManagerSection = false;
-                        }
-                    }
-                    else if(line == Constants::Diary_TimeStampStart)
-                    {
-                        m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setHidden(true);
-                        nextLine_isTimeStamp = true;
-                    }
-                    else if(nextLine_isTimeStamp == true)
-                    {
-                        font_TimeStamp.setFamily(m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->text()); // get the value of the text that will have it's font changed
-                        m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setFont(font_TimeStamp); // change the font of said text
-                        m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->flags() & ~Qt::ItemIsEnabled); //disable the timestamps
-                        nextLine_isTimeStamp = false;
-                    }
-                    else if(line == Constants::Diary_TaskManagerStart)
-                    {
-                        m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setHidden(true);
-                        nextLine_isTaskManager = true;
-
-                        // Start hiding Task Manager content if setting is false
-                        if (!m_mainWindow->setting_Diary_ShowTManLogs) {
-                            inTaskManagerSection = true;
-                        }
-                    }
-                    else if(nextLine_isTaskManager == true)
-                    {
-                        font_TimeStamp.setFamily(m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->text());
-                        m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setFont(font_TimeStamp);
-                        m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->flags() & ~Qt::ItemIsEnabled);
-                        m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setData(Qt::UserRole+1, true); // For coloring
-                        m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setData(Qt::UserRole+2, true); // Mark as Task Manager entry
-                        nextLine_isTaskManager = false;
-
-                        // Hide Task Manager timestamp if setting is false
-                        if (!m_mainWindow->setting_Diary_ShowTManLogs) {
-                            m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setHidden(true);
-                        }
-                    }
-                    else if(line == Constants::Diary_ImageStart)
-                    {
-                        m_mainWindow->ui->DiaryTextDisplay->takeItem(lastindex); // Remove the image start marker
-                        previousDiaryLineCounter--; // Decrement counter since we removed a line
-                        nextLine_isImage = true;
-                    }
-                    else if(line == Constants::Diary_ImageEnd)
-                    {
-                        m_mainWindow->ui->DiaryTextDisplay->takeItem(lastindex); // Remove the image end marker
-                        previousDiaryLineCounter--; // Decrement counter since we removed a line
-                        nextLine_isImage = false;
-                    }
-                    else if(nextLine_isImage == true)
-                    {
-                        // Process the image filename - single image only now
-                        QString imageFilename = line;
-
-                        // Simple validation - check if image is loadable
-                        QString imagePath = QDir::cleanPath(currentProcessingDiaryDir + "/" + imageFilename);
-
-                        // Try to load the image to verify it exists and is valid
-                        try {
-                            QPixmap testPixmap = loadEncryptedImage(imagePath);
-                            if (!testPixmap.isNull()) {
-                                // Set up the item for image display
-                                setupImageItem(m_mainWindow->ui->DiaryTextDisplay->item(lastindex), imagePath, "");
-
-                                // Calculate dynamic size based on actual image content
-                                QSize itemSize = calculateItemSizeForImage(imagePath, false, QStringList());
-
-                                m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setSizeHint(itemSize);
-
-                                qDebug() << "Operations_Diary: Set size hint:" << itemSize << "for image:" << imageFilename;
-
-                                // Hide if part of Task Manager section and setting is false
-                                if (inTaskManagerSection && !m_mainWindow->setting_Diary_ShowTManLogs) {
-                                    m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setHidden(true);
-                                }
-                            } else {
-                                qWarning() << "Failed to load image (will be cleaned up later):" << imagePath;
-                                markDiaryForCleanup = true;
-                                // Remove the line and mark for cleanup
-                                m_mainWindow->ui->DiaryTextDisplay->takeItem(lastindex);
-                            }
-                        } catch (...) {
-                            qWarning() << "Exception loading image (will be cleaned up later):" << imagePath;
-                            markDiaryForCleanup = true;
-                            // Remove the line and mark for cleanup
-                            m_mainWindow->ui->DiaryTextDisplay->takeItem(lastindex);
-                        }
-
-                        // Note: nextLine_isImage remains true until we hit IMAGE_END
-                    }
-                    else // if line is a diary entry
-                    {
-                        m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->flags() | Qt::ItemIsEditable); //Make line editable.
-
-                        // Hide entry if it's part of a Task Manager section and setting is false
-                        if (inTaskManagerSection && !m_mainWindow->setting_Diary_ShowTManLogs) {
-                            m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setHidden(true);
-                        }
-                    }
-                }
-            }
-
-            // Extract previous diary date from file path
-            QFileInfo prevFileInfo(previous_DiaryFileName);
-            QString prevFileName = prevFileInfo.fileName();
-            QString prevDateString = prevFileName.left(prevFileName.lastIndexOf('.'));
+            entries = buildDisplayEntries(prevDiaryLines, previousDiaryDir);
+            previousDiaryLineCounter = entries.size(); // counts how many lines of text are part of the previous diary view
 
             // Parse dates to check if previous diary is yesterday's
-            QDate prevDate(
-                prevDateString.section('.', 0, 0).toInt(),
-                prevDateString.section('.', 1, 1).toInt(),
-                prevDateString.section('.', 2, 2).toInt()
-                );
+            QDate prevDate = DiaryDateIndex::dateFromPath(previous_DiaryFileName);
 
             // IF PREVIOUS DIARY IS NOT YESTERDAYS, DISABLE TEXT EDITING
-            if (prevDate.addDays(1) == todayDate) {
-                // Previous diary is yesterday's, keep editable for both text and images
-                // No changes needed - items remain editable by default
-            } else {
+            if (prevDate.addDays(1) != todayDate) {
                 // Previous diary is older than yesterday - disable text items but keep images selectable
-                for (int i = 0; i < previousDiaryLineCounter && i < items.size(); i++) {
-                    QListWidgetItem* item = items[i];
-                    bool isImageItem = item->data(Qt::UserRole+3).toBool();
-                    if (isImageItem) {
-                        // Keep images selectable but not editable
-                        item->setFlags((item->flags() | Qt::ItemIsSelectable) & ~Qt::ItemIsEditable);
+                for (DiaryDisplayModel::Entry& entry : entries) {
+                    if (entry.flags & DiaryDisplayModel::Image) {
+                        entry.itemFlags = (entry.itemFlags | Qt::ItemIsSelectable) & ~Qt::ItemIsEditable;
                     } else {
-                        // Disable text items completely
-                        item->setFlags(item->flags() & ~Qt::ItemIsEnabled);
+                        entry.itemFlags &= ~Qt::ItemIsEnabled;
                     }
                 }
             }
@@ -1107,234 +1029,54 @@ void Operations_Diary::LoadDiary(QString DiaryFileName)
         previous_DiaryFileName = ""; // Not loading today's diary
     }
 
-    // RESET: Set processing directory back to current diary directory for current diary content
-    currentProcessingDiaryDir = currentDiaryDir;
-
     // Read the current diary file
     QStringList diaryLines;
-    bool readSuccess = OperationsFiles::readEncryptedFileLines(
-        DiaryFileName, m_mainWindow->user_Key, diaryLines);
+    bool readSuccess = readDiaryLines(DiaryFileName, diaryLines);
 
     if (!readSuccess) {
         qDebug() << "Failed to read diary file: " << DiaryFileName;
         return;
     }
 
-    // RESET ALL STATE VARIABLES before processing current diary content
-    // NOTE: Don't reset cur_entriesNoSpacer here as it may have been set by CreateNewDiary()
-    bool firstLineSetup = false; // Reset first line setup for current diary
-    inTaskManagerSection = false; // Reset the Task Manager section flag
-    nextLine_isTimeStamp = false; // Reset timestamp processing state
-    nextLine_isTextBlock = false; // Reset text block processing state
-    nextLine_isImage = false; // Reset image processing state
-    nextLine_isTaskManager = false; // Reset task manager processing state
-    textblock.clear(); // Clear any remaining text block content
-
-    // Special handling for newly created diaries: if the diary only contains one line (the date stamp),
-    // set cur_entriesNoSpacer to a high value to ensure a timestamp is added on the first entry
-    if (diaryLines.size() == 1) {
-        cur_entriesNoSpacer = 100000; // Ensure timestamp will be added
-        qDebug() << "Detected newly created diary with only date stamp - setting cur_entriesNoSpacer to 100000";
+    const bool isTodaysDiary = (DiaryFileName == todayDiaryPath);
+    if (isTodaysDiary && !diaryLines.isEmpty()) // if we are loading todays diary, save its datestamp to a variable and setfocus to text-input
+    {
+        currentdiary_DateStamp = GetDiaryDateStamp(formattedTime);
+        m_mainWindow->ui->DiaryTextInput->setFocus();
     }
 
-    foreach(const QString& line, diaryLines) {
-        // Validate each line of content
-        InputValidation::ValidationResult contentResult =
-            InputValidation::validateInput(line, InputValidation::InputType::DiaryContent, 100000);
-
-        if (!contentResult.isValid) {
-            qWarning() << "Invalid content in diary entry during load: " << contentResult.errorMessage;
-            // Continue loading but log the issue
-        }
-
-        m_mainWindow->ui->DiaryTextDisplay->addItem(line); //add it to the text display
-        items = getTextDisplayItems(); // Update the list of all the text in the listview diary text display.
-        int lastindex = items.length() - 1; // use that list to get the last index of our listview diary text display
-        if(!items.isEmpty()) //if items is not empty, otherwise the software would crash by returning an invalid index
-        {
-            if(firstLineSetup == false) // setup the first line of the diary. It contains the diary file date.
-            {
-                m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setTextAlignment(Qt::AlignCenter);
-                m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->flags() & ~Qt::ItemIsEnabled);
-                if(DiaryFileName == todayDiaryPath) // if we are loading todays diary, save its datestamp to a variable and setfocus to text-input
-                {
-                    currentdiary_DateStamp = GetDiaryDateStamp(formattedTime);;
-                    m_mainWindow->ui->DiaryTextInput->setFocus();
-                }
-                firstLineSetup = true;
-            }
-
-            if(line == Constants::Diary_TextBlockStart)
-            {
-                m_mainWindow->ui->DiaryTextDisplay->takeItem(lastindex); //remove text block start marker
-                nextLine_isTextBlock = true; // this will remain true until we find a text block end marker
-            }
-            else if(line == Constants::Diary_TextBlockEnd)
-            {
-                m_mainWindow->ui->DiaryTextDisplay->takeItem(lastindex); //remove text block end marker
-                nextLine_isTextBlock = false; // the text block has been loaded completely, we will now add it to display
-                m_mainWindow->ui->DiaryTextDisplay->addItem(Constants::Diary_TextBlockStart); // add text block start marker
-                m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setHidden(true); // hide text block start marker
-                textblock = textblock.left(textblock.length() - 1); // remove the last characters in text block, that is the last unecessary \n
-                m_mainWindow->ui->DiaryTextDisplay->addItem(textblock); // add text block
-                m_mainWindow->ui->DiaryTextDisplay->item(lastindex+1)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(lastindex+1)->flags() | Qt::ItemIsEditable); // make our new entry editable // +1 because we added 1 item since last calculating the last index
-                m_mainWindow->ui->DiaryTextDisplay->addItem(Constants::Diary_TextBlockEnd); // add text block end marker
-                m_mainWindow->ui->DiaryTextDisplay->item(lastindex+2)->setHidden(true); // hide text block end marker // +2 because we added 2 items since last calculating the last index
-                textblock.clear(); // clear the textblock
-
-                // Hide text block if it's part of a Task Manager section and setting is false
-                if (inTaskManagerSection && !m_mainWindow->setting_Diary_ShowTManLogs) {
-                    m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setHidden(true);
-                    m_mainWindow->ui->DiaryTextDisplay->item(lastindex+1)->setHidden(true);
-                    m_mainWindow->ui->DiaryTextDisplay->item(lastindex+2)->setHidden(true);
-                }
-            }
-            else if(nextLine_isTextBlock == true)
-            {
-                // SECURITY FIX: Prevent unbounded text block accumulation in current diary
-                if (textblock.length() + line.length() + 1 > MAX_TEXTBLOCK_SIZE) {
-                    qWarning() << "Operations_Diary: Text block exceeds maximum size in current diary, truncating";
-                    // Force end the text block
-                    nextLine_isTextBlock = false;
-                    m_mainWindow->ui->DiaryTextDisplay->addItem(Constants::Diary_TextBlockStart);
-                    m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setHidden(true);
-                    m_mainWindow->ui->DiaryTextDisplay->addItem(textblock);
-                    m_mainWindow->ui->DiaryTextDisplay->item(lastindex+1)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(lastindex+1)->flags() | Qt::ItemIsEditable);
-                    m_mainWindow->ui->DiaryTextDisplay->addItem(Constants::Diary_TextBlockEnd);
-                    m_mainWindow->ui->DiaryTextDisplay->item(lastindex+2)->setHidden(true);
-                    textblock.clear();
-                    // Start a new text block with current line
-                    textblock = line + "\n";
-                    nextLine_isTextBlock = true;
-                } else {
-                    textblock = textblock + line + "\n";
-                    m_mainWindow->ui->DiaryTextDisplay->takeItem(lastindex); //remove the line from the display
-                }
-            }
-            else if (line == Constants::Diary_Spacer)
-            {
-                m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setData(Qt::UserRole, true);// uses hidetext delegate to hide the spacer
-                cur_entriesNoSpacer = 0; // Reset the entries without spacer counter
-                m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->flags() & ~Qt::ItemIsEnabled); //disable current line, preventing users from interacting with it
-
-                // If we're in a Task Manager section, hiding ends at the spacer
-                if (inTaskManagerSection) {
-                    inTaskManagerSection = false;
-                }
-            }
-            else if(line == Constants::Diary_TimeStampStart)
-            {
-                m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setHidden(true);
-                nextLine_isTimeStamp = true;
-            }
-            else if(line == Constants::Diary_TaskManagerStart)
-            {
-                m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setHidden(true);
-                nextLine_isTaskManager = true;
-
-                // Start hiding Task Manager content if setting is false
-                if (!m_mainWindow->setting_Diary_ShowTManLogs) {
-                    inTaskManagerSection = true;
-                }
-            }
-            else if(line == Constants::Diary_ImageStart)
-            {
-                m_mainWindow->ui->DiaryTextDisplay->takeItem(lastindex); // Remove the image start marker
-                nextLine_isImage = true;
-            }
-            else if(line == Constants::Diary_ImageEnd)
-            {
-                m_mainWindow->ui->DiaryTextDisplay->takeItem(lastindex); // Remove the image end marker
-                nextLine_isImage = false;
-            }
-            else if(nextLine_isImage == true)
-            {
-                // Process the image filename - single image only now
-                QString imageFilename = line;
-
-                // Simple validation - check if image is loadable
-                QString imagePath = QDir::cleanPath(currentProcessingDiaryDir + "/" + imageFilename);
-
-                // Try to load the image to verify it exists and is valid
-                try {
-                    QPixmap testPixmap = loadEncryptedImage(imagePath);
-                    if (!testPixmap.isNull()) {
-                        // Set up the item for image display
-                        setupImageItem(m_mainWindow->ui->DiaryTextDisplay->item(lastindex), imagePath, "");
-
-                        // Calculate dynamic size based on actual image content
-                        QSize itemSize = calculateItemSizeForImage(imagePath, false, QStringList());
-
-                        m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setSizeHint(itemSize);
-
-                        qDebug() << "Operations_Diary: Set size hint:" << itemSize << "for image:" << imageFilename;
-
-                        // Hide if part of Task Manager section and setting is false
-                        if (inTaskManagerSection && !m_mainWindow->setting_Diary_ShowTManLogs) {
-                            m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setHidden(true);
-                        }
-                    } else {
-                        qWarning() << "Failed to load image (will be cleaned up later):" << imagePath;
-                        markDiaryForCleanup = true;
-                        // Remove the line and mark for cleanup
-                        m_mainWindow->ui->DiaryTextDisplay->takeItem(lastindex);
-                    }
-                } catch (...) {
-                    qWarning() << "Exception loading image (will be cleaned up later):" << imagePath;
-                    markDiaryForCleanup = true;
-                    // Remove the line and mark for cleanup
-                    m_mainWindow->ui->DiaryTextDisplay->takeItem(lastindex);
-                }
-
-                // Note: nextLine_isImage remains true until we hit IMAGE_END
-            }
-            else if(nextLine_isTimeStamp == false && nextLine_isTaskManager == false && nextLine_isImage == false) // NEXT LINE IS REGULAR DIARY
-            {
-                cur_entriesNoSpacer++; // add to the entries without spacer counter
-                m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->flags() | Qt::ItemIsEditable);
-
-                // Hide entry if it's part of a Task Manager section and setting is false
-                if (inTaskManagerSection && !m_mainWindow->setting_Diary_ShowTManLogs) {
-                    m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setHidden(true);
-                }
-            }
-            else if(nextLine_isTimeStamp == true)
-            {
-                font_TimeStamp.setFamily(m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->text()); // get the value of the text that will have it's font changed
-                m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setFont(font_TimeStamp); // change the font of said text
-                nextLine_isTimeStamp = false;
-            }
-            else if(nextLine_isTaskManager == true)
-            {
-                font_TimeStamp.setFamily(m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->text());
-                m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setFont(font_TimeStamp);
-                m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->flags() & ~Qt::ItemIsEnabled);
-                m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setData(Qt::UserRole+1, true); // For coloring
-                m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setData(Qt::UserRole+2, true); // Mark as Task Manager entry
-                nextLine_isTaskManager = false;
-
-                // Hide Task Manager timestamp if setting is false
-                if (!m_mainWindow->setting_Diary_ShowTManLogs) {
-                    m_mainWindow->ui->DiaryTextDisplay->item(lastindex)->setHidden(true);
-                }
+    QVector<DiaryDisplayModel::Entry> currentEntries = buildDisplayEntries(diaryLines, currentDiaryDir);
+    if (!isTodaysDiary) // if we are not loading todays diary, will disable all lines
+    {
+        for (DiaryDisplayModel::Entry& entry : currentEntries) {
+            if (entry.flags & DiaryDisplayModel::Image) {
+                // Keep images selectable but not editable
+                entry.itemFlags = (entry.itemFlags | Qt::ItemIsSelectable) & ~Qt::ItemIsEditable;
+            } else {
+                // Disable text items completely
+                entry.itemFlags &= ~Qt::ItemIsEnabled;
             }
         }
     }
+    entries += currentEntries;
 
-    QList<QListWidgetItem*> templist = m_mainWindow->ui->DiaryTextDisplay->findItems(Constants::Diary_TimeStampStart, Qt::MatchStartsWith); // get a list of all timestamp locations
-    if(!templist.isEmpty()) //if templist is not empty, otherwise the software would crash by returning an invalid index
-    {
-        // THREAD SAFETY: Use bounds checking when accessing last element
-        QListWidgetItem* lastTimestampMarker = nullptr;
-        if (!templist.isEmpty()) {
-            lastTimestampMarker = templist.last();
+    // Find the last timestamp (either regular or task manager) of the display
+    int lastTimeStampMarker = -1;
+    int lastAnyTimestampMarker = -1;
+    for (int i = entries.size() - 1; i >= 0 && lastTimeStampMarker < 0; i--) {
+        const QString& text = entries.at(i).text;
+        if (text.startsWith(Constants::Diary_TimeStampStart)) {
+            lastTimeStampMarker = i;
         }
-        if (!lastTimestampMarker) {
-            qWarning() << "Operations_Diary: No valid timestamp marker found";
-            return;
+        if (lastAnyTimestampMarker < 0 &&
+            (text == Constants::Diary_TimeStampStart || text == Constants::Diary_TaskManagerStart)) {
+            lastAnyTimestampMarker = i;
         }
-        int markerRow = m_mainWindow->ui->DiaryTextDisplay->row(lastTimestampMarker);
-        QString temptext = m_mainWindow->ui->DiaryTextDisplay->item(markerRow + 1)->text();
+    }
+
+    if (lastTimeStampMarker >= 0 && lastTimeStampMarker + 1 < entries.size())
+    {
+        QString temptext = entries.at(lastTimeStampMarker + 1).text;
         QString temptime = temptext.section(" at ",1,1); // remove the username from the text and keep only the time
 
         // Validate time format
@@ -1370,178 +1112,71 @@ void Operations_Diary::LoadDiary(QString DiaryFileName)
             lastTimeStamp_Hours = 0;
             lastTimeStamp_Minutes = 0;
         }
-
-        foreach(QListWidgetItem *item, templist) // for each timestamp
-        {
-            m_mainWindow->ui->DiaryTextDisplay->item(m_mainWindow->ui->DiaryTextDisplay->row(item)+1)->setFlags(item->flags() & ~Qt::ItemIsEnabled); // get the row of the timestamp marker, add 1 because the actual timestamp is next entry, make unselectable.
-            m_mainWindow->ui->DiaryTextDisplay->item(m_mainWindow->ui->DiaryTextDisplay->row(item)+1)->setData(Qt::UserRole+1, true);
-        }
-
-        // Extract the date from the diary file path
-        QFileInfo fileInfo(DiaryFileName);
-        QString fileName = fileInfo.fileName();
-        QString datePart = fileName.left(fileName.lastIndexOf('.'));
-
-        // Validate date format
-        InputValidation::ValidationResult dateResult =
-            InputValidation::validateInput(datePart, InputValidation::InputType::PlainText);
-        if (!dateResult.isValid) {
-            qWarning() << "Invalid date format in diary file path: " << dateResult.errorMessage;
-        }
-
-        if(datePart != formattedTime) // if we are not loading todays diary, will disable all lines
-        {
-            foreach(QListWidgetItem *item, getTextDisplayItems())
-            {
-                bool isImageItem = item->data(Qt::UserRole+3).toBool();
-                if (isImageItem) {
-                    // Keep images selectable but not editable
-                    item->setFlags((item->flags() | Qt::ItemIsSelectable) & ~Qt::ItemIsEditable);
-                } else {
-                    // Disable text items completely
-                    item->setFlags(item->flags() & ~Qt::ItemIsEnabled);
-                }
-            }
-        }
     }
 
-    items = getTextDisplayItems(); // Update the list of all the text in the listview diary text display.
-
     // Check if this is today's diary and calculate proper cur_entriesNoSpacer
-    fileInfo.setFile(DiaryFileName);
-    fileName.clear();
-    fileName = fileInfo.fileName();
-    QString datePart = fileName.left(fileName.lastIndexOf('.'));
-
-    if (datePart == formattedTime) { // If we loaded today's diary
-        // Find the last timestamp in the display and calculate entries since then
-        QList<QListWidgetItem*> allItems = getTextDisplayItems();
-
+    if (isTodaysDiary) {
         // Check if diary is empty (only contains date stamp)
-        // THREAD SAFETY: Use bounds checking when accessing last element
-        bool isDiaryEmpty = false;
-            if (allItems.length() <= 1) {
-                isDiaryEmpty = true;
-            } else if (!allItems.isEmpty()) {
-                QListWidgetItem* lastItem = allItems.last();
-                if (lastItem && lastItem->text().contains(GetDiaryDateStamp(formattedTime))) {
-                    isDiaryEmpty = true;
-                }
-            }
-            if (isDiaryEmpty) {
+        bool isDiaryEmpty = entries.size() <= 1 ||
+                            entries.last().text.contains(GetDiaryDateStamp(formattedTime));
+        if (isDiaryEmpty) {
             // Empty diary, guarantee a timestamp on next entry
             cur_entriesNoSpacer = 100000;
-        } else {
-            // Find the last timestamp marker (either regular or task manager)
-            int lastTimestampIndex = -1;
-
-            for (int i = allItems.size() - 1; i >= 0; i--) {
-                QListWidgetItem* item = allItems[i];
-                if (item->text() == Constants::Diary_TimeStampStart ||
-                    item->text() == Constants::Diary_TaskManagerStart) {
-                    lastTimestampIndex = i;
-                    break;
+        } else if (lastAnyTimestampMarker >= 0) {
+            // Count entries after the last timestamp
+            int entriesCount = 0;
+
+            // Skip the timestamp marker itself and the actual timestamp text
+            for (int i = lastAnyTimestampMarker + 2; i < entries.size(); i++) {
+                const DiaryDisplayModel::Entry& entry = entries.at(i);
+
+                // Skip spacers, hidden items, markers, and disabled items
+                if (entry.text == Constants::Diary_Spacer ||
+                    entry.text == Constants::Diary_TextBlockStart ||
+                    entry.text == Constants::Diary_TextBlockEnd ||
+                    entry.text == Constants::Diary_TimeStampStart ||
+                    entry.text == Constants::Diary_TaskManagerStart ||
+                    (entry.flags & DiaryDisplayModel::Hidden) ||
+                    !(entry.itemFlags & Qt::ItemIsEnabled)) {
+                    continue;
                 }
-            }
-
-            if (lastTimestampIndex >= 0) {
-                // Count entries after the last timestamp
-                int entriesCount = 0;
-
-                // Start counting from after the timestamp marker
-                // Skip the timestamp marker itself and the actual timestamp text
-                int startIndex = lastTimestampIndex + 2; // +1 for marker, +1 for timestamp text
-
-                for (int i = startIndex; i < allItems.size(); i++) {
-                    QListWidgetItem* item = allItems[i];
-
-                    // Skip spacers, hidden items, markers, and disabled items
-                    if (item->text() == Constants::Diary_Spacer ||
-                        item->text() == Constants::Diary_TextBlockStart ||
-                        item->text() == Constants::Diary_TextBlockEnd ||
-                        item->text() == Constants::Diary_TimeStampStart ||
-                        item->text() == Constants::Diary_TaskManagerStart ||
-                        item->isHidden() ||
-                        !(item->flags() & Qt::ItemIsEnabled)) {
-                        continue;
-                    }
 
-                    // Check if this is an image item
-                    bool isImageItem = item->data(Qt::UserRole+3).toBool();
-
-                    if (isImageItem) {
-                        // For image groups, set to TStampCounter - 1 and continue counting from there
-                        //entriesCount = qMax(0, m_mainWindow->setting_Diary_TStampCounter - 1); //disabled for now
-                        entriesCount = 0; // used to set to entrycountlimit -1 , now we just reset the limit because a timestamp is always added when an image is added and the last entry is text
-                        // Continue counting any entries that come after this image
-                        // (this handles the case where there are multiple entries after an image)
-
-                    } else if (item->text().contains("\n")) {
-                        // Text block - count 1 + number of newlines
-                        int newlineCount = 0;
-                        for (QChar c : item->text()) {
-                            if (c == '\n') {
-                                newlineCount++;
-                            }
-                        }
-                        entriesCount += (1 + newlineCount);
-
-                    } else {
-                        // Regular text entry
-                        entriesCount += 1;
-                    }
+                if (entry.flags & DiaryDisplayModel::Image) {
+                    entriesCount = 0; // used to set to entrycountlimit -1 , now we just reset the limit because a timestamp is always added when an image is added and the last entry is text
+                } else {
+                    // Text block - count 1 + number of newlines, regular entries count 1
+                    entriesCount += 1 + entry.text.count('\n');
                 }
-
-                // Ensure the count doesn't go below 0
-                cur_entriesNoSpacer = qMax(0, entriesCount);
-
-                qDebug() << "Calculated cur_entriesNoSpacer for today's diary:" << cur_entriesNoSpacer;
-
-            } else {
-                // No timestamp found, set to high value to ensure timestamp on next entry
-                cur_entriesNoSpacer = 100000;
-                qDebug() << "No timestamp found in today's diary, setting cur_entriesNoSpacer to 100000";
             }
+
+            cur_entriesNoSpacer = qMax(0, entriesCount);
+            qDebug() << "Calculated cur_entriesNoSpacer for today's diary:" << cur_entriesNoSpacer;
+        } else {
+            // No timestamp found, set to high value to ensure timestamp on next entry
+            cur_entriesNoSpacer = 100000;
+            qDebug() << "No timestamp found in today's diary, setting cur_entriesNoSpacer to 100000";
         }
     } else {
-        // Not today's diary, set to high value
+        // Not today's diary, set absurd value to make sure that we will add a timestamp on our first entry
         cur_entriesNoSpacer = 100000;
         qDebug() << "Not today's diary, setting cur_entriesNoSpacer to 100000";
     }
 
-    //add a spacer that is used only for one reason, being able to deselect the last entry of the display. IT IS NOT SAVED INTO OUR DIARY FILE
-    m_mainWindow->ui->DiaryTextDisplay->addItem(Constants::Diary_Spacer); //Add spacer
-    items = getTextDisplayItems(); // Update the list of all the text in the listview diary text display. //Make a Widget List of all the text in the listview diary text display.
-    // THREAD SAFETY: Check if items list is valid before accessing
-    if (!items.isEmpty()) {
-        m_mainWindow->ui->DiaryTextDisplay->item(items.length() - 1)->setData(Qt::UserRole, true);// uses hidetext delegate to hide the spacer
-        m_mainWindow->ui->DiaryTextDisplay->item(items.length() - 1)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(items.length() - 1)->flags() & ~Qt::ItemIsEnabled); // disable the spacer
+    // Images of this day still being ingested keep their placeholders across the reload
+    for (auto it = m_imageBatches.constBegin(); it != m_imageBatches.constEnd(); ++it) {
+        if (it->diaryPath == DiaryFileName) {
+            entries += pendingImagePlaceholders(it.key());
+            for (const QString& displayPath : it->ingestedPaths) {
+                m_imageCache->request(displayPath);
+            }
+        }
     }
-    //------------------------------//
 
-    // Extract the date from the diary file path
-    fileInfo.setFile(DiaryFileName);
-    fileName.clear();
-    fileName = fileInfo.fileName();
-    datePart = fileName.left(fileName.lastIndexOf('.'));
+    //add a spacer that is used only for one reason, being able to deselect the last entry of the display. IT IS NOT SAVED INTO OUR DIARY FILE
+    entries.append(DiaryDisplayModel::spacerEntry());
 
-    if(datePart != formattedTime) // if we are not loading todays diary
-    {
-        cur_entriesNoSpacer = 100000; // set absurd value to make sure that we will add a timestamp on our first entry, say, when a new journal is created.
-    }
-    qDebug() << "DIARY-DEBUG6: === LoadDiary completed, checking all items ===";
-    for (int i = 0; i < m_mainWindow->ui->DiaryTextDisplay->count(); i++) {
-        QListWidgetItem* item = m_mainWindow->ui->DiaryTextDisplay->item(i);
-        bool isImage = item->data(Qt::UserRole+3).toBool();
-        if (isImage) {
-            qDebug() << "DIARY-DEBUG6: Image item at row" << i;
-            qDebug() << "DIARY-DEBUG6:  - Size hint:" << item->sizeHint();
-            qDebug() << "DIARY-DEBUG6:  - Hidden:" << item->isHidden();
-            qDebug() << "DIARY-DEBUG6:  - UserRole+4 (path):" << item->data(Qt::UserRole+4);
-            qDebug() << "DIARY-DEBUG6:  - Item flags:" << item->flags();
-            qDebug() << "DIARY-DEBUG6:  - Visual rect:" << m_mainWindow->ui->DiaryTextDisplay->visualItemRect(item);
-        }
-    }
+    displayModel()->setEntries(entries);
+    qDebug() << "Operations_Diary: LoadDiary displayed" << entries.size() << "rows";
 
     // Defer these calls to avoid UI inconsistency issues
     SafeTimer::singleShot(0, this, [this]() {
@@ -1554,8 +1189,11 @@ void Operations_Diary::LoadDiary(QString DiaryFileName)
 
     SafeTimer::singleShot(30, this, [this]() {
         ScrollBottom();
+        // Only now, otherwise the scroll bar sitting at the top while loading would pull in older days
+        m_timelineActive = true;
     }, "Operations_Diary::ScrollBottom");
 
+    prefetchAdjacentDays();
 
     // If we found broken image references, clean them up AFTER the diary is fully loaded
     if (markDiaryForCleanup) {
@@ -1568,6 +1206,187 @@ void Operations_Diary::LoadDiary(QString DiaryFileName)
     }
 }
 
+// ------  Timeline ---------- //
+
+QString Operations_Diary::diaryFileForRow(int row) const
+{
+    int dayEnd = 0;
+    for (const TimelineDay& day : m_timelineDays) {
+        dayEnd += day.rowCount;
+        if (row < dayEnd) {
+            return day.filePath;
+        }
+    }
+    if (row < previousDiaryLineCounter && previous_DiaryFileName != "") {
+        return previous_DiaryFileName;
+    }
+    return current_DiaryFileName;
+}
+
+QDate Operations_Diary::oldestDisplayedDate() const
+{
+    if (!m_timelineDays.isEmpty()) {
+        return DiaryDateIndex::dateFromPath(m_timelineDays.first().filePath);
+    }
+    if (!previous_DiaryFileName.isEmpty()) {
+        return DiaryDateIndex::dateFromPath(previous_DiaryFileName);
+    }
+    return DiaryDateIndex::dateFromPath(m_timelineBaseFile);
+}
+
+void Operations_Diary::resetTimeline(const QString& baseDiaryFile)
+{
+    m_timelineDays.clear();
+    m_timelineRowCount = 0;
+    m_timelineActive = false;
+    m_timelineWantedDay.clear();
+    m_timelineBaseFile = baseDiaryFile;
+}
+
+void Operations_Diary::prefetchAdjacentDays()
+{
+    if (!m_dateIndex || !m_dayPrefetcher) {
+        return;
+    }
+
+    // When looking at an older day, the days around it are the likely next clicks in the day list
+    const QDate baseDate = DiaryDateIndex::dateFromPath(m_timelineBaseFile);
+    if (baseDate.isValid() && baseDate != QDate::currentDate()) {
+        const QDate adjacentDates[] = { m_dateIndex->latestBefore(baseDate), m_dateIndex->earliestAfter(baseDate) };
+        for (const QDate& adjacentDate : adjacentDates) {
+            if (adjacentDate.isValid() && adjacentDate != QDate::currentDate()) {
+                m_dayPrefetcher->prefetch(getDiaryFilePath(adjacentDate.toString("yyyy.MM.dd")), true);
+            }
+        }
+    }
+
+    // The day the timeline would add next
+    const QDate olderDate = m_dateIndex->latestBefore(oldestDisplayedDate());
+    if (olderDate.isValid()) {
+        m_dayPrefetcher->prefetch(getDiaryFilePath(olderDate.toString("yyyy.MM.dd")));
+    }
+}
+
+void Operations_Diary::extendTimeline()
+{
+    if (!m_timelineActive || m_timelineUpdating || !m_dateIndex || !m_timelineWantedDay.isEmpty()) {
+        return;
+    }
+
+    const QDate olderDate = m_dateIndex->latestBefore(oldestDisplayedDate());
+    if (!olderDate.isValid()) {
+        return; // Reached the first diary
+    }
+    const QString diaryFilePath = getDiaryFilePath(olderDate.toString("yyyy.MM.dd"));
+    if (diaryFilePath.isEmpty()) {
+        return;
+    }
+
+    QStringList diaryLines;
+    if (m_dayPrefetcher->take(diaryFilePath, diaryLines)) {
+        prependTimelineDay(diaryFilePath, diaryLines);
+        return;
+    }
+
+    // Not read yet, it is added by onDayPrefetched
+    m_timelineWantedDay = diaryFilePath;
+    m_dayPrefetcher->prefetch(diaryFilePath);
+}
+
+void Operations_Diary::onDayPrefetched(const QString& diaryFilePath)
+{
+    if (diaryFilePath != m_timelineWantedDay) {
+        return;
+    }
+    m_timelineWantedDay.clear();
+
+    QStringList diaryLines;
+    if (m_timelineActive && m_dayPrefetcher->take(diaryFilePath, diaryLines)) {
+        prependTimelineDay(diaryFilePath, diaryLines);
+    }
+}
+
+void Operations_Diary::prependTimelineDay(const QString& diaryFilePath, const QStringList& diaryLines)
+{
+    // Broken images of an older day are cleaned up when that day is opened, not while scrolling past it
+    const bool cleanupPending = markDiaryForCleanup;
+    QVector<DiaryDisplayModel::Entry> entries = buildDisplayEntries(diaryLines, QFileInfo(diaryFilePath).dir().path());
+    markDiaryForCleanup = cleanupPending;
+    if (entries.isEmpty()) {
+        return;
+    }
+
+    // Read only, like any diary older than yesterday. Images stay selectable so they can be opened
+    for (DiaryDisplayModel::Entry& entry : entries) {
+        if (entry.flags & DiaryDisplayModel::Image) {
+            entry.itemFlags = (entry.itemFlags | Qt::ItemIsSelectable) & ~Qt::ItemIsEditable;
+        } else {
+            entry.itemFlags &= ~Qt::ItemIsEnabled;
+        }
+    }
+
+    m_timelineUpdating = true;
+    m_mainWindow->ui->DiaryTextDisplay->prependEntries(entries);
+    m_timelineUpdating = false;
+
+    TimelineDay day;
+    day.filePath = diaryFilePath;
+    day.rowCount = entries.size();
+    m_timelineDays.prepend(day);
+    m_timelineRowCount += day.rowCount;
+    previousDiaryLineCounter += day.rowCount; // The rows of the previous and current diary moved down
+    qDebug() << "Operations_Diary: Timeline added" << diaryFilePath << "with" << day.rowCount << "rows";
+
+    // Stay one day ahead of the scrolling
+    const QDate olderDate = m_dateIndex->latestBefore(DiaryDateIndex::dateFromPath(diaryFilePath));
+    if (olderDate.isValid()) {
+        m_dayPrefetcher->prefetch(getDiaryFilePath(olderDate.toString("yyyy.MM.dd")));
+    }
+
+    // A short day may not fill the space above the viewport
+    onTimelineScrolled(m_mainWindow->ui->DiaryTextDisplay->verticalScrollBar()->value());
+}
+
+void Operations_Diary::evictDistantTimelineDays()
+{
+    qlist_DiaryTextDisplay* display = m_mainWindow->ui->DiaryTextDisplay;
+    const int evictDistance = TIMELINE_EVICT_SCREENS * qMax(1, display->viewport()->height());
+
+    m_timelineUpdating = true;
+    while (!m_timelineDays.isEmpty()) {
+        const TimelineDay day = m_timelineDays.first();
+        if (day.rowCount >= display->count()) {
+            break;
+        }
+        // The first row of the next day is a visible date header, if it is far above the viewport so is this day
+        const QRect nextDayRect = display->visualRect(displayModel()->index(day.rowCount));
+        if (!nextDayRect.isValid() || nextDayRect.top() > -evictDistance) {
+            break;
+        }
+
+        display->removeTopEntries(day.rowCount);
+        m_timelineDays.removeFirst();
+        m_timelineRowCount -= day.rowCount;
+        previousDiaryLineCounter -= day.rowCount;
+        qDebug() << "Operations_Diary: Timeline evicted" << day.filePath;
+    }
+    m_timelineUpdating = false;
+}
+
+void Operations_Diary::onTimelineScrolled(int value)
+{
+    if (!m_timelineActive || m_timelineUpdating) {
+        return;
+    }
+
+    // Load the next older day while there is still a screen to scroll, so it is there before the top is reached
+    if (value < m_mainWindow->ui->DiaryTextDisplay->viewport()->height()) {
+        extendTimeline();
+    } else if (!m_timelineDays.isEmpty()) {
+        evictDistantTimelineDays();
+    }
+}
+
 void Operations_Diary::DeleteDiary(QString DiaryFileName)
 {
     // Validate the diary file name
@@ -1580,6 +1399,9 @@ void Operations_Diary::DeleteDiary(QString DiaryFileName)
         return;
     }
 
+    // Unsaved changes of a day that is being deleted would recreate its file
+    m_saveQueue->discard(DiaryFileName);
+
     QDateTime date = QDateTime::currentDateTime(); // Get date and time
     QString formattedTime = date.toString("yyyy.MM.dd"); // Format appropriately
     QString todayDiaryPath = getDiaryFilePath(formattedTime);
@@ -1640,6 +1462,16 @@ void Operations_Diary::DeleteDiary(QString DiaryFileName)
         }
     }
 
+    // The day is gone from the date and search indexes as soon as its file is
+    if (!QFileInfo::exists(DiaryFileName)) {
+        if (m_dateIndex) {
+            m_dateIndex->remove(DiaryDateIndex::dateFromPath(DiaryFileName));
+        }
+        if (m_searchIndex) {
+            m_searchIndex->removeDay(DiaryFileName);
+        }
+    }
+
     // Remove the now-empty day directory
     bool dirRemoveSuccess = dayDir.rmdir(dayDirectoryPath);
     if (!dirRemoveSuccess) {
@@ -1680,8 +1512,7 @@ void Operations_Diary::DeleteDiary(QString DiaryFileName)
     if(DiaryFileName == current_DiaryFileName) // if we delete the currently loaded diary
     {
         // Check if this was the last diary for its year
-        QDir yearDir(DiariesFilePath + year);
-        bool isLastDiaryForYear = !yearDir.exists() || yearDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot).isEmpty();
+        bool isLastDiaryForYear = !m_dateIndex->hasYear(year.toInt());
 
         if (isLastDiaryForYear) {
             // If we deleted the last diary for this year, we need to update the year list
@@ -1711,8 +1542,7 @@ void Operations_Diary::DeleteDiary(QString DiaryFileName)
     else if(DiaryFileName == previous_DiaryFileName && current_DiaryFileName == todayDiaryPath) //if we delete the previous diary and the current one is loaded
     {
         // Check if this was the last diary for its year
-        QDir yearDir(DiariesFilePath + year);
-        bool isLastDiaryForYear = !yearDir.exists() || yearDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot).isEmpty();
+        bool isLastDiaryForYear = !m_dateIndex->hasYear(year.toInt());
 
         if (isLastDiaryForYear) {
             // If we deleted the last diary for this year, we need to update the year list
@@ -1723,8 +1553,7 @@ void Operations_Diary::DeleteDiary(QString DiaryFileName)
     else
     {
         // Check if this was the last diary for its year
-        QDir yearDir(DiariesFilePath + year);
-        bool isLastDiaryForYear = !yearDir.exists() || yearDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot).isEmpty();
+        bool isLastDiaryForYear = !m_dateIndex->hasYear(year.toInt());
 
         if (isLastDiaryForYear) {
             // If we deleted the last diary for this year, we need to update the year list
@@ -1795,6 +1624,13 @@ void Operations_Diary::CreateNewDiary()
         return;
     }
 
+    // Day rollover, the previous day won't get new entries anymore so its log can be compacted
+    if (!current_DiaryFileName.isEmpty() && current_DiaryFileName != diaryPath &&
+        QFileInfo::exists(current_DiaryFileName)) {
+        m_saveQueue->flush(current_DiaryFileName);
+        DiaryRecordLog::compact(current_DiaryFileName, m_mainWindow->user_Key);
+    }
+
     current_DiaryFileName = diaryPath; // Sets the current Diary to today's date
 
     // Prepare diary content
@@ -1802,9 +1638,9 @@ void Operations_Diary::CreateNewDiary()
     currentdiary_DateStamp = GetDiaryDateStamp(formattedTime);
     diaryContent.append(currentdiary_DateStamp);
 
-    // Use centralized file operations to write and encrypt the file
-    bool writeSuccess = OperationsFiles::writeEncryptedFileLines(
-        current_DiaryFileName, m_mainWindow->user_Key, diaryContent);
+    // Create the record log with the date header as its first snapshot
+    bool writeSuccess = writeDiaryLines(
+        current_DiaryFileName, diaryContent);
 
     if (!writeSuccess) {
         qDebug() << "Failed to create new diary file: " << current_DiaryFileName;
@@ -1818,13 +1654,7 @@ void Operations_Diary::CreateNewDiary()
     m_mainWindow->ui->DiaryTextInput->setFocus();
 
     //add a spacer that is used only for one reason, being able to deselect the last entry of the display
-    m_mainWindow->ui->DiaryTextDisplay->addItem(Constants::Diary_Spacer); //Add spacer
-    QList<QListWidgetItem *> items = getTextDisplayItems();
-    // THREAD SAFETY: Check if items list is valid before accessing
-    if (!items.isEmpty()) {
-        m_mainWindow->ui->DiaryTextDisplay->item(items.length() - 1)->setData(Qt::UserRole, true);// uses hidetext delegate to hide the spacer
-        m_mainWindow->ui->DiaryTextDisplay->item(items.length() - 1)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(items.length() - 1)->flags() & ~Qt::ItemIsEnabled); // disable the spacer
-    }
+    appendDeselectSpacer(false);
 
     m_mainWindow->ui->DiaryTextDisplay->scrollToBottom();
     DiaryLoader(); // Reload the diary to ensure everything is properly initialized
@@ -1843,64 +1673,48 @@ void Operations_Diary::DeleteEntry()
         return;
     }
 
-    QList<QListWidgetItem*> items = getTextDisplayItems();
+    DiaryDisplayModel* model = displayModel();
     int currentRow = m_mainWindow->ui->DiaryTextDisplay->currentRow();
     
-    if(items.length() > 0 && currentRow > 0) {
-        QListWidgetItem* currentItem = m_mainWindow->ui->DiaryTextDisplay->item(currentRow);
-        
-        // Null check for currentItem
-        if (!currentItem) {
-            qWarning() << "Operations_Diary: DeleteEntry - No item at row" << currentRow;
-            return;
-        }
+    if(model->count() > 0 && currentRow > 0 && currentRow < model->count() && !isTimelineRow(currentRow)) {
+        const DiaryDisplayModel::Entry& currentEntry = model->entry(currentRow);
 
         qDebug() << "Current row:" << currentRow;
-        qDebug() << "Current item text:" << currentItem->text();
+        qDebug() << "Current item text:" << currentEntry.text;
 
         // Check if this is an image item and delete associated files
-        if (currentItem && currentItem->data(Qt::UserRole+3).toBool()) {
+        if (currentEntry.flags & DiaryDisplayModel::Image) {
             qDebug() << "Deleting image item";
 
             // Determine which diary directory to use based on current row
-            QString diaryPath = current_DiaryFileName;
-            if (m_mainWindow->ui->DiaryTextDisplay->currentRow() < previousDiaryLineCounter && previous_DiaryFileName != "") {
-                diaryPath = previous_DiaryFileName;
-                qDebug() << "Using previous diary path:" << diaryPath;
-            } else {
-                qDebug() << "Using current diary path:" << diaryPath;
-            }
+            QString diaryPath = diaryFileForRow(currentRow);
+            qDebug() << "Using diary path:" << diaryPath;
 
             QFileInfo diaryFileInfo(diaryPath);
             QString diaryDir = diaryFileInfo.dir().absolutePath();
             qDebug() << "Using diary directory:" << diaryDir;
 
             // Get image data and delete file (single image only)
-            QString imagePath = currentItem->data(Qt::UserRole+4).toString();
-            QString imageFilename = QFileInfo(imagePath).fileName();
+            QString imageFilename = QFileInfo(currentEntry.imagePath).fileName();
             deleteImageFiles(imageFilename, diaryDir);
             qDebug() << "Deleted image file:" << imageFilename;
         }
 
-        // Rest of DeleteEntry function remains the same...
-        if(m_mainWindow->ui->DiaryTextDisplay->currentRow() < previousDiaryLineCounter && previous_DiaryFileName != "") {
+        // Text blocks are removed together with their start and end markers
+        int firstRow = currentRow;
+        int rowCount = 1;
+        if (currentEntry.text.contains("\n")) {
+            firstRow = currentRow - 1;
+            rowCount = 3;
+        }
+
+        if(currentRow < previousDiaryLineCounter && previous_DiaryFileName != "") {
             qDebug() << "Deleting from previous diary";
 
-            if (m_mainWindow->ui->DiaryTextDisplay->item(m_mainWindow->ui->DiaryTextDisplay->currentRow())->text().contains("\n")) {
-                m_mainWindow->ui->DiaryTextDisplay->takeItem(m_mainWindow->ui->DiaryTextDisplay->currentRow()-1);
-                m_mainWindow->ui->DiaryTextDisplay->takeItem(m_mainWindow->ui->DiaryTextDisplay->currentRow()+1);
-                previousDiaryLineCounter = previousDiaryLineCounter - 2;
-            }
-            m_mainWindow->ui->DiaryTextDisplay->takeItem(m_mainWindow->ui->DiaryTextDisplay->currentRow());
-            previousDiaryLineCounter--;
+            model->removeEntries(firstRow, rowCount);
+            previousDiaryLineCounter -= rowCount;
             remove_EmptyTimestamps(true);
-            items = getTextDisplayItems();
-            foreach(QListWidgetItem *item, items) {
-                if(items.indexOf(item) >= previousDiaryLineCounter) {
-                    items.removeAt(items.indexOf(item));
-                }
-            }
-            if(items.length() == 1) {
+            if(qMin(previousDiaryLineCounter, model->count()) - m_timelineRowCount == 1) {
                 DeleteDiary(previous_DiaryFileName);
             } else {
                 SaveDiary(previous_DiaryFileName, true);
@@ -1908,26 +1722,16 @@ void Operations_Diary::DeleteEntry()
         } else {
             qDebug() << "Deleting from current diary";
 
-            if (m_mainWindow->ui->DiaryTextDisplay->item(m_mainWindow->ui->DiaryTextDisplay->currentRow())->text().contains("\n")) {
-                m_mainWindow->ui->DiaryTextDisplay->takeItem(m_mainWindow->ui->DiaryTextDisplay->currentRow()-1);
-                m_mainWindow->ui->DiaryTextDisplay->takeItem(m_mainWindow->ui->DiaryTextDisplay->currentRow()+1);
-            }
-            m_mainWindow->ui->DiaryTextDisplay->takeItem(m_mainWindow->ui->DiaryTextDisplay->currentRow());
+            model->removeEntries(firstRow, rowCount);
             prevent_onDiaryTextDisplay_itemChanged = true;
-            QList<QListWidgetItem *> items = getTextDisplayItems();
-            m_mainWindow->ui->DiaryTextDisplay->takeItem(items.length() - 1);
+            removeDeselectSpacer();
             remove_EmptyTimestamps(false);
-            items = getTextDisplayItems();
-            items.remove(0, previousDiaryLineCounter);
-            if(items.length() == 2) {
+            if(model->count() - previousDiaryLineCounter == 2) {
                 DeleteDiary(current_DiaryFileName);
             } else {
                 SaveDiary(current_DiaryFileName, false);
             }
-            m_mainWindow->ui->DiaryTextDisplay->addItem(Constants::Diary_Spacer);
-            items = getTextDisplayItems();
-            m_mainWindow->ui->DiaryTextDisplay->item(items.length() - 1)->setData(Qt::UserRole, true);
-            m_mainWindow->ui->DiaryTextDisplay->item(items.length() - 1)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(items.length() - 1)->flags() & ~Qt::ItemIsEnabled);
+            appendDeselectSpacer(false);
             prevent_onDiaryTextDisplay_itemChanged = false;
         }
     }
@@ -1969,9 +1773,8 @@ void Operations_Diary::UpdateListYears()
     QString year = ("");
     int textFound = -1; // The variable that will let us know if text has been found or not. -1 means none, anyother number represents the index at which it has been found
 
-    // Get list of all year folders
-    QDir baseDir(DiariesFilePath);
-    QStringList yearFolders = baseDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    // Get list of all years that have diaries
+    QStringList yearFolders = m_dateIndex->years();
 
     // Clear the years list to rebuild it (except for the current selection)
     QString currentSelection = "";
@@ -2043,29 +1846,12 @@ void Operations_Diary::UpdateListMonths(QString current_Year)
     QString month = ("");
     currentyear_DiaryList.clear(); // resets the variable
 
-    // Check if year folder exists
-    QDir yearDir(DiariesFilePath + current_Year);
-    if (!yearDir.exists()) {
+    // All diaries of the selected year, in YYYY.MM.DD format
+    currentyear_DiaryList = m_dateIndex->datesInYear(current_Year.toInt());
+    if (currentyear_DiaryList.isEmpty()) {
         return;
     }
 
-    // Get list of all month folders for the selected year
-    QStringList monthFolders = yearDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-
-    // For each month folder, find all day folders and construct date strings
-    foreach(QString monthFolder, monthFolders)
-    {
-        QDir monthDir(DiariesFilePath + current_Year + "/" + monthFolder);
-        QStringList dayFolders = monthDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-
-        foreach(QString dayFolder, dayFolders)
-        {
-            // Construct the date string in format YYYY.MM.DD
-            QString dateString = current_Year + "." + monthFolder + "." + dayFolder;
-            currentyear_DiaryList.append(dateString); // Add to the list of diaries for this year
-        }
-    }
-
     m_mainWindow->ui->DiaryListMonths->clear(); // Clear the monthlist before repopulating
 
     // Set of months that have diary entries (to avoid duplicates)
@@ -2150,50 +1936,18 @@ void Operations_Diary::DiaryLoader()
     }
     else
     {
-        // In the hierarchical structure, we need to scan the year folders first
-        QDir baseDir(DiariesFilePath);
-        QStringList yearFolders = baseDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+        QDate latestDate = m_dateIndex->latest();
 
-        if(yearFolders.isEmpty()) // If no year folders exist, create a new diary
+        if(!latestDate.isValid()) // If no diary exists yet, create a new diary
         {
             CreateNewDiary();
         }
-        else // If year folders exist, find the most recent diary
+        else // Otherwise load the most recent diary
         {
-            // Sort year folders numerically
-            std::sort(yearFolders.begin(), yearFolders.end());
-
-            QString latestYear = yearFolders.last();
-            QDir yearDir(DiariesFilePath + latestYear);
-            QStringList monthFolders = yearDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-
-            if(monthFolders.isEmpty())
-            {
-                CreateNewDiary();
-                return;
-            }
-
-            // Sort month folders numerically
-            std::sort(monthFolders.begin(), monthFolders.end());
-
-            QString latestMonth = monthFolders.last();
-            QDir monthDir(DiariesFilePath + latestYear + "/" + latestMonth);
-            QStringList dayFolders = monthDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-
-            if(dayFolders.isEmpty())
-            {
-                CreateNewDiary();
-                return;
-            }
-
-            // Sort day folders numerically
-            std::sort(dayFolders.begin(), dayFolders.end());
-
-            QString latestDay = dayFolders.last();
-
-            // Construct the date string in the format YYYY.MM.DD
-            QString latestDateString = latestYear + "." + latestMonth + "." + latestDay;
-            QString latestDiaryPath = getDiaryFilePath(latestDateString);
+            QString latestYear = latestDate.toString("yyyy");
+            QString latestMonth = latestDate.toString("MM");
+            QString latestDay = latestDate.toString("dd");
+            QString latestDiaryPath = getDiaryFilePath(latestDate.toString("yyyy.MM.dd"));
 
             if(QFileInfo::exists(latestDiaryPath))
             {
@@ -2209,8 +1963,7 @@ void Operations_Diary::DiaryLoader()
     }
 
     // Scroll to the bottom of display when opening the software
-    QList<QListWidgetItem *> items = getTextDisplayItems();
-    m_mainWindow->ui->DiaryTextDisplay->setCurrentRow(items.length() - 1);
+    m_mainWindow->ui->DiaryTextDisplay->setCurrentRow(m_mainWindow->ui->DiaryTextDisplay->count() - 1);
     UpdateDelegate();
 }
 
@@ -2224,13 +1977,13 @@ void Operations_Diary::OpenEditor() // Open the entry editor
         return;
     }
     
-    QListWidgetItem* currentItem = m_mainWindow->ui->DiaryTextDisplay->currentItem();
-    if (!currentItem) {
+    QModelIndex currentIndex = m_mainWindow->ui->DiaryTextDisplay->currentIndex();
+    if (!currentIndex.isValid()) {
         qWarning() << "Operations_Diary: OpenEditor - No current item to edit";
         return;
     }
     
-    m_mainWindow->ui->DiaryTextDisplay->editItem(currentItem); // open text editor
+    m_mainWindow->ui->DiaryTextDisplay->edit(currentIndex); // open text editor
 }
 
 void Operations_Diary::DeleteDiaryFromListDays()
@@ -2265,6 +2018,150 @@ void Operations_Diary::DeleteDiaryFromListDays()
     }
 }
 
+void Operations_Diary::ExportDiaries()
+{
+    if (m_exporter && m_exporter->isRunning()) {
+        QMessageBox::information(m_mainWindow, "Export Diaries", "An export is already running.");
+        return;
+    }
+
+    // The range is picked relative to the diary that is currently selected
+    const QDate selectedDate = DiaryDateIndex::dateFromPath(current_DiaryFileName);
+    QStringList ranges;
+    if (selectedDate.isValid()) {
+        ranges << "Selected day (" + selectedDate.toString("yyyy.MM.dd") + ")"
+               << "Selected month (" + selectedDate.toString("MMMM yyyy") + ")"
+               << "Selected year (" + selectedDate.toString("yyyy") + ")";
+    }
+    ranges << "All diaries";
+
+    bool ok = false;
+    const QString range = QInputDialog::getItem(m_mainWindow, "Export Diaries", "Diaries to export:",
+                                                ranges, 0, false, &ok);
+    if (!ok) {
+        return;
+    }
+
+    QDate firstDate;
+    QDate lastDate;
+    const int rangeIndex = selectedDate.isValid() ? ranges.indexOf(range) : ranges.size() - 1;
+    if (rangeIndex == 0 && selectedDate.isValid()) {
+        firstDate = selectedDate;
+        lastDate = selectedDate;
+    } else if (rangeIndex == 1) {
+        firstDate = QDate(selectedDate.year(), selectedDate.month(), 1);
+        lastDate = firstDate.addMonths(1).addDays(-1);
+    } else if (rangeIndex == 2) {
+        firstDate = QDate(selectedDate.year(), 1, 1);
+        lastDate = QDate(selectedDate.year(), 12, 31);
+    }
+
+    const QStringList formats = {"HTML pages", "Plain text"};
+    const QString format = QInputDialog::getItem(m_mainWindow, "Export Diaries", "Export as:",
+                                                 formats, 0, false, &ok);
+    if (!ok) {
+        return;
+    }
+
+    QMessageBox::StandardButton reply = QMessageBox::question(
+        m_mainWindow,
+        "Export Diaries",
+        "The exported diaries and images are NOT encrypted, anyone with access to the export "
+        "folder can read them.\n\nDo you want to continue?",
+        QMessageBox::Yes | QMessageBox::No);
+    if (reply != QMessageBox::Yes) {
+        return;
+    }
+
+    const QString parentFolder = QFileDialog::getExistingDirectory(m_mainWindow, "Choose Export Folder");
+    if (parentFolder.isEmpty()) {
+        return;
+    }
+    InputValidation::ValidationResult pathResult =
+        InputValidation::validateInput(parentFolder, InputValidation::InputType::ExternalFilePath);
+    if (!pathResult.isValid) {
+        QMessageBox::warning(m_mainWindow, "Export Diaries", "Invalid export folder: " + pathResult.errorMessage);
+        return;
+    }
+    const QString outputPath = QDir(parentFolder).filePath(
+        "MMDiary Export " + QDateTime::currentDateTime().toString("yyyy-MM-dd hh.mm.ss"));
+
+    // The export reads the day files, queued changes have to be in them
+    flushPendingSaves();
+
+    QStringList diaryFiles;
+    const QStringList allDiaryFiles = m_dateIndex->filePaths();
+    for (const QString& diaryFile : allDiaryFiles) {
+        const QDate date = DiaryDateIndex::dateFromPath(diaryFile);
+        if (!firstDate.isValid() || (date >= firstDate && date <= lastDate)) {
+            diaryFiles.append(diaryFile);
+        }
+    }
+    if (diaryFiles.isEmpty()) {
+        QMessageBox::information(m_mainWindow, "Export Diaries", "There are no diaries to export in this range.");
+        return;
+    }
+
+    if (!m_exporter) {
+        m_exporter = new DiaryExporter(m_mainWindow->user_Key, this);
+        connect(m_exporter, &DiaryExporter::progress, this, &Operations_Diary::onExportProgress);
+        connect(m_exporter, &DiaryExporter::finished, this, &Operations_Diary::onExportFinished);
+    }
+    const DiaryExporter::Format exportFormat =
+        (format == formats.at(0)) ? DiaryExporter::Format::Html : DiaryExporter::Format::PlainText;
+    if (!m_exporter->start(diaryFiles, outputPath, exportFormat)) {
+        QMessageBox::warning(m_mainWindow, "Export Diaries", "Failed to create the export folder:\n" + outputPath);
+        return;
+    }
+
+    // Not exec(), the export reports back through signals and the window stays usable
+    m_exportProgress = new QProgressDialog("Exporting diaries...", "Cancel", 0, diaryFiles.size(), m_mainWindow);
+    m_exportProgress->setWindowTitle("Diary Export");
+    m_exportProgress->setWindowModality(Qt::WindowModal);
+    m_exportProgress->setMinimumDuration(0);
+    m_exportProgress->setAutoClose(false);
+    m_exportProgress->setAutoReset(false);
+    m_exportProgress->setValue(0);
+    connect(m_exportProgress, &QProgressDialog::canceled, m_exporter, &DiaryExporter::cancel);
+    m_exportProgress->show();
+}
+
+void Operations_Diary::onExportProgress(int daysDone, int dayCount, qint64 bytesWritten)
+{
+    if (!m_exportProgress) {
+        return;
+    }
+    m_exportProgress->setValue(daysDone);
+    m_exportProgress->setLabelText(QString("Exported %1 of %2 days (%3 MB)")
+                                       .arg(daysDone)
+                                       .arg(dayCount)
+                                       .arg(bytesWritten / (1024.0 * 1024.0), 0, 'f', 1));
+}
+
+void Operations_Diary::onExportFinished(const DiaryExporter::Summary& summary)
+{
+    if (m_exportProgress) {
+        m_exportProgress->disconnect(this);
+        m_exportProgress->disconnect(m_exporter);
+        m_exportProgress->close();
+        m_exportProgress->deleteLater();
+    }
+
+    QString message = summary.cancelled ? "The export was cancelled.\n\n" : "The export is complete.\n\n";
+    message += DiaryExporter::describeThroughput(summary) + "\n";
+    message += QString("%1 images exported").arg(summary.exportedImages);
+    if (summary.failedDays > 0 || summary.failedImages > 0) {
+        message += QString("\n%1 days and %2 images could not be exported").arg(summary.failedDays).arg(summary.failedImages);
+    }
+    message += "\n\nOpen index.html in:\n" + summary.outputPath;
+
+    if (summary.failedDays > 0) {
+        QMessageBox::warning(m_mainWindow, "Export Diaries", message);
+    } else {
+        QMessageBox::information(m_mainWindow, "Export Diaries", message);
+    }
+}
+
 void Operations_Diary::CopyToClipboard()
 {
     // Safety check for m_mainWindow
@@ -2273,15 +2170,15 @@ void Operations_Diary::CopyToClipboard()
         return;
     }
     
-    QListWidgetItem* currentItem = m_mainWindow->ui->DiaryTextDisplay->currentItem();
-    if (!currentItem) {
+    int currentRow = m_mainWindow->ui->DiaryTextDisplay->currentRow();
+    if (currentRow < 0) {
         qWarning() << "Operations_Diary: CopyToClipboard - No current item to copy";
         return;
     }
     
     QClipboard *clipboard = QGuiApplication::clipboard();
     if (clipboard) {
-        clipboard->setText(currentItem->text());
+        clipboard->setText(displayModel()->text(currentRow));
     }
 }
 
@@ -2293,24 +2190,17 @@ void Operations_Diary::showContextMenu_TextDisplay(const QPoint &pos)
         return;
     }
     
-    if(!m_mainWindow->ui->DiaryTextDisplay->selectedItems().isEmpty()) {
-        QListWidgetItem* selectedItem = m_mainWindow->ui->DiaryTextDisplay->selectedItems().first();
-        
-        // Null check for selectedItem
-        if (!selectedItem) {
-            qWarning() << "Operations_Diary: showContextMenu_TextDisplay - No selected item";
-            return;
-        }
-
+    int selectedRow = m_mainWindow->ui->DiaryTextDisplay->selectedRow();
+    if(selectedRow >= 0) {
         // Store the context menu position for click detection
         m_lastContextMenuPos = pos;
 
         // Check if this is an image item
-        bool isImageItem = selectedItem->data(Qt::UserRole+3).toBool();
+        bool isImageItem = displayModel()->isImage(selectedRow);
 
         if (isImageItem) {
             // Check if click was actually on the image
-            int clickedImageIndex = calculateClickedImageIndex(selectedItem, pos);
+            int clickedImageIndex = calculateClickedImageIndex(selectedRow, pos);
 
             if (clickedImageIndex == -1) {
                 // Click was not on the image, don't show image context menu
@@ -2327,11 +2217,11 @@ void Operations_Diary::showContextMenu_TextDisplay(const QPoint &pos)
             QAction *actionOpen = contextMenu.addAction("Open Image");
             QAction *actionExport = contextMenu.addAction("Decrypt and Export");
 
-            connect(actionOpen, &QAction::triggered, this, [this, selectedItem]() {
-                handleImageClick(selectedItem);
+            connect(actionOpen, &QAction::triggered, this, [this, selectedRow]() {
+                handleImageClick(selectedRow);
             });
-            connect(actionExport, &QAction::triggered, this, [this, selectedItem]() {
-                exportSingleImage(selectedItem);
+            connect(actionExport, &QAction::triggered, this, [this, selectedRow]() {
+                exportSingleImage(selectedRow);
             });
 
             // Only show delete option if not viewing old diary entry
@@ -2378,12 +2268,8 @@ void Operations_Diary::showContextMenu_TextDisplay(const QPoint &pos)
         QPoint newpos = pos;
         newpos.setX(pos.x() +175);
         newpos.setY(pos.y() +35);
-        // Get the selected item and its index
-        selectedItem = m_mainWindow->ui->DiaryTextDisplay->selectedItems().first();
-        int selectedIndex = m_mainWindow->ui->DiaryTextDisplay->row(selectedItem);
-
         // Use the index in FindLastTimeStampType
-        if (FindLastTimeStampType(selectedIndex) == Constants::Diary_TaskManagerStart) {
+        if (FindLastTimeStampType(selectedRow) == Constants::Diary_TaskManagerStart) {
             action2.setEnabled(false);
         }
         contextMenu.exec(m_mainWindow->mapToGlobal(newpos));
@@ -2406,10 +2292,14 @@ void Operations_Diary::showContextMenu_ListDays(const QPoint &pos)
         contextMenu.setAttribute(Qt::WA_DeleteOnClose);
         //create context menu actions
         QAction action1("Delete", m_mainWindow->ui->DiaryListDays);
+        QAction action2("Export Diaries...", m_mainWindow->ui->DiaryListDays);
         //connect context menu signals
         connect(&action1, SIGNAL(triggered()), this, SLOT(DeleteDiaryFromListDays()));
+        connect(&action2, SIGNAL(triggered()), this, SLOT(ExportDiaries()));
         //build context menu
         contextMenu.addAction(&action1);
+        contextMenu.addSeparator();
+        contextMenu.addAction(&action2);
         //Use the actual position where user clicked
         QPoint globalPos = m_mainWindow->ui->DiaryListDays->mapToGlobal(pos);
         contextMenu.exec(globalPos);
@@ -2435,6 +2325,7 @@ void Operations_Diary::UpdateDelegate()
     connect(delegate, &CombinedDelegate::TextModificationsMade, m_mainWindow->ui->DiaryTextDisplay, &qlist_DiaryTextDisplay::TextWasEdited);
     delegate->setColorLength(m_mainWindow->user_Displayname.length());  // Color first 5 characters
     delegate->setTextColor(QColor(m_mainWindow->user_nameColor));  // Use red color for the text
+    delegate->setImageCache(m_imageCache);
     
     // Set the new delegate
     m_mainWindow->ui->DiaryTextDisplay->setItemDelegate(delegate);
@@ -2472,24 +2363,18 @@ void Operations_Diary::UpdateDisplayName()
         return;
     }
     
-    QList<QListWidgetItem*>  templist = m_mainWindow->ui->DiaryTextDisplay->findItems(Constants::Diary_TimeStampStart, Qt::MatchStartsWith); // get a list of all timestamp locations
-    if(!templist.isEmpty()) //if templist is not empty, otherwise the software would crash by returning an invalid index
+    DiaryDisplayModel* model = displayModel();
+    const QVector<int> timestampRows = model->findRows(Constants::Diary_TimeStampStart); // get a list of all timestamp locations
+    for (int markerRow : timestampRows) // for each timestamp
     {
-        foreach(QListWidgetItem *item, templist) // for each timestamp
+        int nextRow = markerRow + 1;
+        if (nextRow >= model->count()) continue; // Bounds check
+
+        const QString nextText = model->text(nextRow);
+        if(nextText.section(" at ",0,0) != m_mainWindow->user_Displayname) // if the display name of current time stamp isnt the same as the current display name
         {
-            if (!item) continue; // Skip null items
-            
-            int nextRow = m_mainWindow->ui->DiaryTextDisplay->row(item) + 1;
-            if (nextRow >= m_mainWindow->ui->DiaryTextDisplay->count()) continue; // Bounds check
-            
-            QListWidgetItem* nextItem = m_mainWindow->ui->DiaryTextDisplay->item(nextRow);
-            if (!nextItem) continue; // Null check
-            
-            if(nextItem->text().section(" at ",0,0) != m_mainWindow->user_Displayname) // if the display name of current time stamp isnt the same as the current display name
-            {
-                QString timestamp_Time = nextItem->text().section(" at ",1,1); // save the timestamp minus the display name and " at "
-                nextItem->setText(m_mainWindow->user_Displayname + " at " + timestamp_Time); // set text to new display name + " at " + saved timestamp
-            }
+            QString timestamp_Time = nextText.section(" at ",1,1); // save the timestamp minus the display name and " at "
+            model->setText(nextRow, m_mainWindow->user_Displayname + " at " + timestamp_Time); // set text to new display name + " at " + saved timestamp
         }
     }
 }
@@ -2505,108 +2390,63 @@ void Operations_Diary::remove_EmptyTimestamps(bool previousDiary)
     QDateTime date = QDateTime::currentDateTime(); // Get date and time
     QString formattedTime = date.toString("yyyy.MM.dd"); // Format approprietly
     currentdiary_DateStamp = GetDiaryDateStamp(formattedTime);
-    QList<QListWidgetItem *> items = getTextDisplayItems(); // Update the list of all the text in the listview diary text display. // make a list of all our text display lines
+    DiaryDisplayModel* model = displayModel();
     qDebug() << "we are attempting to remove empty timestamps";
-    if(!items.isEmpty()) //if items is not empty, otherwise the software would crash by returning an invalid index
+
+    // Walks the rows once. When a timestamp group is removed (the spacer before it, its marker
+    // and the timestamp) the row after it moves up to row - 1, which is where the walk continues.
+    // Older days shown by the timeline are read only, the walk starts below them.
+    const int top = m_timelineRowCount;
+    int row = top;
+    while (row < model->count())
     {
-        foreach(QListWidgetItem *item, items)
+        const int count = model->count();
+        const QString& text = model->entry(row).text;
+        if (text != Constants::Diary_TimeStampStart && text != Constants::Diary_TaskManagerStart) {
+            ++row;
+            continue;
+        }
+
+        bool removeGroup = false;
+        if(!previousDiary) // if we are editing todays diary
         {
-            if(!previousDiary) // if we are editing todays diary
+            if(row+2 <= count-2 && row-1 >= top) //compare index of item to check with list length(prevents crashes)
             {
-                if(item->text() == Constants::Diary_TimeStampStart || item->text() == Constants::Diary_TaskManagerStart)
-                {
-                    qDebug() << "index of item: " << items.indexOf(item);
-                    qDebug() << "items length: " << items.length()-2;
-                    //qDebug() << "item at +2: " << items.at(items.indexOf(item)+2)->text();
-                }
-                // THREAD SAFETY: Enhanced bounds checking for array access
-                int itemIndex = items.indexOf(item);
-                if(itemIndex >= 0 && itemIndex+2 <= items.length()-2 && itemIndex-1 >= 0) //if we find a timestamp && compare index of item to check with list length(prevents crashes)
-                {
-                    QListWidgetItem* itemAt = items.at(itemIndex+2);
-                    if(itemAt && itemAt->text() == Constants::Diary_Spacer && itemIndex-1 > 0)
-                    {
-                        if(item->text() == Constants::Diary_TimeStampStart || item->text() == Constants::Diary_TaskManagerStart)
-                        {
-                            m_mainWindow->ui->DiaryTextDisplay->takeItem(items.indexOf(item)-1); // remove the spacer that comes before the timestamp
-                            items.removeAt(items.indexOf(item)-1); //update our itemlist
-                            m_mainWindow->ui->DiaryTextDisplay->takeItem(items.indexOf(item)+1); //remove the timestamp
-                            items.removeAt(items.indexOf(item)+1); //update our itemlist
-                            m_mainWindow->ui->DiaryTextDisplay->takeItem(items.indexOf(item)); //remove the timestamp marker
-                            items.removeAt(items.indexOf(item)); //update our itemlist
-                        }
-                    }
-                }
-                else if(items.indexOf(item) == items.length()-2) // if we find a timestamp that is at the very end of our diarydisplay
-                {
-                    if(item->text() == Constants::Diary_TimeStampStart || item->text() == Constants::Diary_TaskManagerStart)
-                    {
-                        m_mainWindow->ui->DiaryTextDisplay->takeItem(items.indexOf(item)-1); // remove the spacer that comes before the timestamp
-                        items.removeAt(items.indexOf(item)-1); //update our itemlist
-                        m_mainWindow->ui->DiaryTextDisplay->takeItem(items.indexOf(item)+1); //remove the timestamp
-                        items.removeAt(items.indexOf(item)+1); //update our itemlist
-                        m_mainWindow->ui->DiaryTextDisplay->takeItem(items.indexOf(item)); //remove the timestamp marker
-                        items.removeAt(items.indexOf(item)); //update our itemlist
-                        cur_entriesNoSpacer = 100000; //absurb value to guarantee that we will add a spacer. Since we remove the last time stamp, it is guaranteed that we need one. unless you'd travel back in time ;)
-                    }
-                }
+                // a timestamp that is directly followed by a spacer has no entries left
+                removeGroup = model->text(row+2) == Constants::Diary_Spacer && row-1 > top;
             }
-            else // if we are not editing todays diary but rather the previous one
+            else if(row == count-2 && row > top) // if we find a timestamp that is at the very end of our diarydisplay
             {
-                // THREAD SAFETY: Enhanced bounds checking for array access
-                int itemIndex = items.indexOf(item);
-                if(itemIndex >= 0 && itemIndex+2 <= items.length()-2 && itemIndex-1 >= 0) //if we find a timestamp && compare index of item to check with list length(prevents crashes)
-                {
-                    QListWidgetItem* itemAt = items.at(itemIndex+2);
-                    if(itemAt && itemAt->text() == Constants::Diary_Spacer && itemIndex-1 > 0)
-                    {
-                        if(item->text() == Constants::Diary_TimeStampStart || item->text() == Constants::Diary_TaskManagerStart)
-                        {
-                            m_mainWindow->ui->DiaryTextDisplay->takeItem(items.indexOf(item)-1); // remove the spacer that comes before the timestamp
-                            items.removeAt(items.indexOf(item)-1); //update our itemlist
-                            m_mainWindow->ui->DiaryTextDisplay->takeItem(items.indexOf(item)+1); //remove the timestamp
-                            items.removeAt(items.indexOf(item)+1); //update our itemlist
-                            m_mainWindow->ui->DiaryTextDisplay->takeItem(items.indexOf(item)); //remove the timestamp marker
-                            items.removeAt(items.indexOf(item)); //update our itemlist
-                            previousDiaryLineCounter = previousDiaryLineCounter -3; //update the previousDiaryLineCounter variable because we removed 3 lines from the previous diary
-                        }
-                    }
-                }
-                else if(items.indexOf(item)+2 <= items.length()-2 && items.at(items.indexOf(item)+2)->text() == currentdiary_DateStamp) // if we find a spacer that is at the end of the previous diary display. uses datestamp detection
-                {
-                    if(item->text() == Constants::Diary_TimeStampStart || item->text() == Constants::Diary_TaskManagerStart)
-                    {
-                        qDebug() << "DEBUGITEM: " << item->text();
-                        m_mainWindow->ui->DiaryTextDisplay->takeItem(items.indexOf(item)-1); // remove the spacer that comes before the timestamp
-                        items.removeAt(items.indexOf(item)-1); //update our itemlist
-                        m_mainWindow->ui->DiaryTextDisplay->takeItem(items.indexOf(item)+1); //remove the timestamp
-                        items.removeAt(items.indexOf(item)+1); //update our itemlist
-                        m_mainWindow->ui->DiaryTextDisplay->takeItem(items.indexOf(item)); //remove the timestamp marker
-                        items.removeAt(items.indexOf(item)); //update our itemlist
-                        previousDiaryLineCounter = previousDiaryLineCounter -3; //update the previousDiaryLineCounter variable because we removed 3 lines from the previous diary
-                        cur_entriesNoSpacer = 100000; //absurb value to guarantee that we will add a spacer. Since we remove the last time stamp, it is guaranteed that we need one. unless you'd travel back in time ;)
-                    }
-                }
-                else if(items.indexOf(item) == items.length()-3) // if we find a timestamp that is at the very end of our diarydisplay
-                {
-                    if(item->text() == Constants::Diary_TimeStampStart || item->text() == Constants::Diary_TaskManagerStart)
-                    {
-                        m_mainWindow->ui->DiaryTextDisplay->takeItem(items.indexOf(item)-1); // remove the spacer that comes before the timestamp
-                        items.removeAt(items.indexOf(item)-1); //update our itemlist
-                        m_mainWindow->ui->DiaryTextDisplay->takeItem(items.indexOf(item)+1); //remove the timestamp
-                        items.removeAt(items.indexOf(item)+1); //update our itemlist
-                        m_mainWindow->ui->DiaryTextDisplay->takeItem(items.indexOf(item)); //remove the timestamp marker
-                        items.removeAt(items.indexOf(item)); //update our itemlist
-                        previousDiaryLineCounter = previousDiaryLineCounter -3; //update the previousDiaryLineCounter variable because we removed 3 lines from the previous diary
-                        cur_entriesNoSpacer = 100000; //absurb value to guarantee that we will add a spacer. Since we remove the last time stamp, it is guaranteed that we need one. unless you'd travel back in time ;)
-                    }
-                }
-                else if(item->text() == Constants::Diary_TimeStampStart || item->text() == Constants::Diary_TaskManagerStart)
-                {
-                    //qDebug() << items.at(items.indexOf(item)+2)->text();
-                    //qDebug() << currentdiary_DateStamp;
-                }
+                removeGroup = true;
+                cur_entriesNoSpacer = 100000; //absurb value to guarantee that we will add a spacer. Since we remove the last time stamp, it is guaranteed that we need one. unless you'd travel back in time ;)
+            }
+        }
+        else // if we are not editing todays diary but rather the previous one
+        {
+            if(row+2 <= count-2 && row-1 >= top) //compare index of item to check with list length(prevents crashes)
+            {
+                removeGroup = model->text(row+2) == Constants::Diary_Spacer && row-1 > top;
+            }
+            else if(row+2 <= count-2 && row > top && model->text(row+2) == currentdiary_DateStamp) // if we find a spacer that is at the end of the previous diary display. uses datestamp detection
+            {
+                removeGroup = true;
+                cur_entriesNoSpacer = 100000;
+            }
+            else if(row == count-3 && row > top) // if we find a timestamp that is at the very end of our diarydisplay
+            {
+                removeGroup = true;
+                cur_entriesNoSpacer = 100000;
             }
+            if (removeGroup) {
+                previousDiaryLineCounter = previousDiaryLineCounter -3; //update the previousDiaryLineCounter variable because we removed 3 lines from the previous diary
+            }
+        }
+
+        if (removeGroup) {
+            model->removeEntries(row - 1, 3); // the spacer that comes before the timestamp, the marker and the timestamp
+            row = row - 1;
+        } else {
+            ++row;
         }
     }
 }
@@ -2639,19 +2479,202 @@ void Operations_Diary::DeleteEmptyCurrentDayDiary()
     LoadDiary(todayDiaryPath);
 
     // Now check if the diary is empty
-    QList<QListWidgetItem *> items = getTextDisplayItems();
-    int currentDayItemsLength = items.length() - previousDiaryLineCounter;
+    int currentDayItemsLength = m_mainWindow->ui->DiaryTextDisplay->count() - previousDiaryLineCounter;
     qDebug() << "Current day item length:" << currentDayItemsLength;
 
     // If current diary is empty (only has the date header), delete it
     if (currentDayItemsLength <= 2) {
         DeleteDiary(current_DiaryFileName);
+    } else {
+        // End of the session, fold today's appended records into a single snapshot
+        m_saveQueue->flush(current_DiaryFileName);
+        DiaryRecordLog::compact(current_DiaryFileName, m_mainWindow->user_Key);
     }
     
     // Restore shutdown flag state
     m_isShuttingDown = wasShuttingDown;
 }
 
+bool Operations_Diary::writeDiaryLines(const QString& diaryFilePath, const QStringList& diaryLines)
+{
+    // Callers build the lines from readDiaryLines(), which already contains the queued changes.
+    // A queued save of the day is superseded, it must not land on top of this write later.
+    m_saveQueue->discard(diaryFilePath);
+
+    bool isNewDiary = !QFileInfo::exists(diaryFilePath);
+    if (!DiaryRecordLog::writeLines(diaryFilePath, m_mainWindow->user_Key, diaryLines)) {
+        return false;
+    }
+    onDiaryDayWritten(diaryFilePath, diaryLines, isNewDiary);
+    return true;
+}
+
+bool Operations_Diary::readDiaryLines(const QString& diaryFilePath, QStringList& diaryLines, bool cacheResult)
+{
+    if (m_saveQueue->pendingLines(diaryFilePath, diaryLines)) {
+        return true;
+    }
+    return DiaryRecordLog::readLines(diaryFilePath, m_mainWindow->user_Key, diaryLines, cacheResult);
+}
+
+void Operations_Diary::onDiaryDayWritten(const QString& diaryFilePath, const QStringList& diaryLines, bool created)
+{
+    if (created && m_dateIndex) {
+        m_dateIndex->insert(DiaryDateIndex::dateFromPath(diaryFilePath));
+    }
+
+    if (m_searchIndex) {
+        m_searchIndex->updateDay(diaryFilePath, diaryLines);
+    }
+
+    // A day read ahead of time is stale now
+    if (m_dayPrefetcher) {
+        m_dayPrefetcher->drop(diaryFilePath);
+    }
+}
+
+void Operations_Diary::flushPendingSaves()
+{
+    if (m_saveQueue && !m_saveQueue->flush()) {
+        qWarning() << "Operations_Diary: Some diary changes could not be saved";
+    }
+}
+
+// ------  Search ---------- //
+
+void Operations_Diary::onDiarySearchRequested()
+{
+    if (!m_searchIndex) {
+        return;
+    }
+
+    QString searchText = m_mainWindow->ui->lineEdit_DiarySearch->text().trimmed();
+    if (searchText.isEmpty()) {
+        setDiarySearchMode(false);
+        return;
+    }
+
+    InputValidation::ValidationResult searchResult =
+        InputValidation::validateInput(searchText, InputValidation::InputType::PlainText, 500);
+    if (!searchResult.isValid) {
+        qWarning() << "Invalid diary search text:" << searchResult.errorMessage;
+        return;
+    }
+
+    QListWidget* resultsList = m_mainWindow->ui->listWidget_DiarySearchResults;
+    resultsList->clear();
+    setDiarySearchMode(true);
+
+    DiarySearchIndex::Query query = DiarySearchIndex::parseQuery(searchText);
+    if (query.isEmpty()) {
+        QListWidgetItem* item = new QListWidgetItem("Enter words to search for");
+        item->setFlags(Qt::NoItemFlags);
+        resultsList->addItem(item);
+        return;
+    }
+
+    const QList<DiarySearchIndex::Hit> hits = m_searchIndex->search(query);
+    if (hits.isEmpty()) {
+        QListWidgetItem* item = new QListWidgetItem(m_searchIndex->isIndexing() ? "No matches yet, still indexing"
+                                                                                : "No matches");
+        item->setFlags(Qt::NoItemFlags);
+        resultsList->addItem(item);
+        return;
+    }
+
+    QStringList terms;
+    for (const QStringList& phrase : query.phrases) {
+        terms.append(phrase);
+    }
+
+    // Hits come grouped by day, so each day with a hit is decrypted once for its snippets
+    QString loadedDiaryPath;
+    QStringList dayEntries;
+    for (const DiarySearchIndex::Hit& hit : hits) {
+        if (hit.filePath != loadedDiaryPath) {
+            loadedDiaryPath = hit.filePath;
+            dayEntries.clear();
+            QStringList diaryLines;
+            if (readDiaryLines(hit.filePath, diaryLines, false)) {
+                dayEntries = DiarySearchIndex::extractEntries(diaryLines);
+            }
+        }
+        if (hit.entry >= dayEntries.size()) {
+            continue; // The day changed since it was indexed
+        }
+
+        const QString& entryText = dayEntries[hit.entry];
+        QListWidgetItem* item = new QListWidgetItem(hit.date.toString("yyyy.MM.dd") + "\n" +
+                                                    buildSearchSnippet(entryText, terms));
+        item->setToolTip(entryText.left(1000));
+        item->setData(Qt::UserRole, hit.date);
+        item->setData(Qt::UserRole + 1, entryText);
+        resultsList->addItem(item);
+    }
+}
+
+void Operations_Diary::openDiarySearchResult(QListWidgetItem* item)
+{
+    if (!item) {
+        return;
+    }
+    QDate date = item->data(Qt::UserRole).toDate();
+    if (!date.isValid()) {
+        return;
+    }
+    QString entryText = item->data(Qt::UserRole + 1).toString();
+
+    // Selecting the day in the sorter loads it
+    UpdateDiarySorter(date.toString("yyyy"), date.toString("MM"), date.toString("dd"));
+
+    qlist_DiaryTextDisplay* display = m_mainWindow->ui->DiaryTextDisplay;
+    DiaryDisplayModel* model = display->diaryModel();
+    for (int i = 0; i < model->count(); ++i) {
+        if (!model->isHidden(i) && model->text(i) == entryText) {
+            display->setCurrentRow(i);
+            display->scrollTo(model->index(i), QAbstractItemView::PositionAtCenter);
+            break;
+        }
+    }
+}
+
+void Operations_Diary::setDiarySearchMode(bool active)
+{
+    // The results take the place of the year/month/day sorter while a search is shown
+    m_mainWindow->ui->listWidget_DiarySearchResults->setVisible(active);
+    m_mainWindow->ui->DiaryListYears->setVisible(!active);
+    m_mainWindow->ui->DiaryListMonths->setVisible(!active);
+    m_mainWindow->ui->DiaryListDays->setVisible(!active);
+    m_mainWindow->ui->line->setVisible(!active);
+    m_mainWindow->ui->line_2->setVisible(!active);
+    if (!active) {
+        m_mainWindow->ui->listWidget_DiarySearchResults->clear();
+    }
+}
+
+QString Operations_Diary::buildSearchSnippet(const QString& entryText, const QStringList& terms) const
+{
+    const int SNIPPET_LENGTH = 80;
+
+    int matchIndex = -1;
+    for (const QString& term : terms) {
+        matchIndex = entryText.indexOf(term, 0, Qt::CaseInsensitive);
+        if (matchIndex >= 0) {
+            break;
+        }
+    }
+
+    int start = qMax(0, matchIndex - SNIPPET_LENGTH / 4);
+    QString snippet = entryText.mid(start, SNIPPET_LENGTH).simplified();
+    if (start > 0) {
+        snippet.prepend("...");
+    }
+    if (start + SNIPPET_LENGTH < entryText.length()) {
+        snippet.append("...");
+    }
+    return snippet;
+}
+
 // ------  Image handling ---------- //
 
 QString Operations_Diary::generateImageFilename(const QString& originalExtension, const QString& diaryDir)
@@ -2676,13 +2699,18 @@ QString Operations_Diary::generateImageFilename(const QString& originalExtension
     }
 
     QString filename = baseFilename + "." + targetExtension;
-    QString fullPath = QDir::cleanPath(diaryDir + "/" + filename);
 
-    // Check for duplicates and add suffix if needed
+    // Check for duplicates and add suffix if needed. Names of images still being written count
+    // as taken, and so does the thumbnail name, which drops the extension.
+    auto isTaken = [this, &diaryDir](const QString& candidate) {
+        const QString candidatePath = QDir::cleanPath(diaryDir + "/" + candidate);
+        const QString thumbnailPath = QDir::cleanPath(diaryDir + "/" + QFileInfo(candidate).completeBaseName() + ".thumb");
+        return QFileInfo::exists(candidatePath) || QFileInfo::exists(thumbnailPath) ||
+               m_reservedImagePaths.contains(candidatePath) || m_reservedImagePaths.contains(thumbnailPath);
+    };
     int suffix = 1;
-    while (QFileInfo::exists(fullPath)) {
+    while (isTaken(filename)) {
         filename = QString("%1(%2).%3").arg(baseFilename).arg(suffix).arg(targetExtension);
-        fullPath = QDir::cleanPath(diaryDir + "/" + filename);
         suffix++;
     }
 
@@ -2712,18 +2740,7 @@ bool Operations_Diary::saveEncryptedImage(const QString& sourcePath, const QStri
     // SECURITY FIX: Check file size before reading to prevent memory exhaustion
     qint64 fileSize = sourceFileInfo.size();
     qint64 availableMemory = getAvailableSystemMemory();
-    
-    // Calculate memory limit: 50% of available RAM, min 1GB, max 10GB
-    const qint64 MIN_LIMIT = 1LL * 1024 * 1024 * 1024;  // 1GB minimum
-    const qint64 MAX_LIMIT = 10LL * 1024 * 1024 * 1024; // 10GB maximum
-    qint64 memoryLimit = availableMemory / 2; // Use 50% of available RAM
-    
-    // Apply min/max constraints
-    if (memoryLimit < MIN_LIMIT) {
-        memoryLimit = MIN_LIMIT;
-    } else if (memoryLimit > MAX_LIMIT) {
-        memoryLimit = MAX_LIMIT;
-    }
+    qint64 memoryLimit = imageFileSizeLimit();
     
     qDebug() << "Operations_Diary: Available memory:" << (availableMemory / (1024*1024)) << "MB"
              << "Memory limit:" << (memoryLimit / (1024*1024)) << "MB"
@@ -2866,7 +2883,7 @@ void Operations_Diary::handleClipboardImage(const QImage& image, const QString&
     // SECURITY: Validate that the file is actually an image before processing
     if (!InputValidation::isValidImageFile(tempFilePath)) {
         qWarning() << "Operations_Diary: Clipboard file is not a valid image:" << tempFilePath;
-        QFile::remove(tempFilePath); // Clean up temp file
+        OperationsFiles::secureDelete(tempFilePath); // Clean up temp file
         QMessageBox::warning(m_mainWindow, "Invalid Image", 
                            "The clipboard content is not a valid image file.");
         return;
@@ -2878,16 +2895,17 @@ void Operations_Diary::handleClipboardImage(const QImage& image, const QString&
     QStringList imagePaths;
     imagePaths.append(tempFilePath);
     processAndAddImages(imagePaths, false);
-    
-    // Schedule cleanup of temp file after 5 seconds
-    // This gives enough time for processAndAddImages to complete
-    QTimer::singleShot(5000, [tempFilePath]() {
-        if (QFile::exists(tempFilePath)) {
-            qDebug() << "Operations_Diary: Cleaning up temp file:" << tempFilePath;
-                QFile::remove(tempFilePath);
 
+    // The temp file is removed when its batch finishes. If no batch took it, remove it now.
+    for (const PendingImageBatch& batch : m_imageBatches) {
+        if (batch.sourcePaths.contains(tempFilePath)) {
+            return;
         }
-    });
+    }
+    if (QFile::exists(tempFilePath)) {
+        qDebug() << "Operations_Diary: Cleaning up temp file:" << tempFilePath;
+        OperationsFiles::secureDelete(tempFilePath);
+    }
 }
 
 void Operations_Diary::processAndAddImages(const QStringList& imagePaths, bool forceThumbnails)
@@ -2940,123 +2958,148 @@ void Operations_Diary::processAndAddImages(const QStringList& imagePaths, bool f
     // Ensure the diary directory exists
     ensureDiaryDirectoryExists(formattedDate);
 
-    QStringList processedImages;
     QStringList failedImages;
+    QVector<DiaryImageIngestor::Job> jobs;
+    PendingImageBatch batch;
 
-    // Process each image individually (no grouping) - use validated images only
+    // Only the target files are chosen here, reading, encrypting and thumbnailing the images
+    // runs on the ingestor's thread pool
     foreach(const QString& imagePath, validImagePaths) {
-        try {
-            // Validate image file
-            if (!QFileInfo::exists(imagePath)) {
-                failedImages.append(imagePath + " (file not found)");
-                continue;
-            }
+        // Generate filename for original
+        QString originalExtension = QFileInfo(imagePath).suffix();
 
-            // Get image dimensions
-            QSize imageSize = getImageDimensions(imagePath);
-            if (imageSize.isEmpty()) {
-                failedImages.append(imagePath + " (invalid image)");
-                continue;
-            }
+        // SECURITY FIX: Validate extension to prevent path injection
+        if (originalExtension.contains("/") || originalExtension.contains("..") ||
+            originalExtension.contains("\\") || originalExtension.length() > 10) {
+            failedImages.append(imagePath + " (invalid extension)");
+            continue;
+        }
 
-            qDebug() << "Operations_Diary: Processing image" << imagePath << "with size" << imageSize;
+        QString imageFilename = generateImageFilename(originalExtension, diaryDir);
+        QString encryptedImagePath = QDir::cleanPath(diaryDir + "/" + imageFilename);
 
-            // Always create thumbnails now
-            ImageDisplayInfo displayInfo = calculateImageDisplayInfo(imageSize, false);
+        // SECURITY FIX: Ensure the target path is within diary directory
+        QString canonicalDiaryDir = QDir::cleanPath(diaryDir);
+        if (!encryptedImagePath.startsWith(canonicalDiaryDir)) {
+            qWarning() << "Operations_Diary: Path traversal attempt in image processing";
+            failedImages.append(imagePath + " (security error)");
+            continue;
+        }
 
-            // Generate filename for original
-            QString originalExtension = QFileInfo(imagePath).suffix();
-            
-            // SECURITY FIX: Validate extension to prevent path injection
-            if (originalExtension.contains("/") || originalExtension.contains("..") || 
-                originalExtension.contains("\\") || originalExtension.length() > 10) {
-                failedImages.append(imagePath + " (invalid extension)");
-                continue;
-            }
-            
-            QString imageFilename = generateImageFilename(originalExtension, diaryDir);
-            QString encryptedImagePath = QDir::cleanPath(diaryDir + "/" + imageFilename);
-            
-            // SECURITY FIX: Ensure the target path is within diary directory
-            QString canonicalDiaryDir = QDir::cleanPath(diaryDir);
-            if (!encryptedImagePath.startsWith(canonicalDiaryDir)) {
-                qWarning() << "Operations_Diary: Path traversal attempt in image processing";
-                failedImages.append(imagePath + " (security error)");
-                continue;
-            }
+        QString thumbnailFilename = QFileInfo(imageFilename).completeBaseName() + ".thumb";
+        QString thumbnailPath = QDir::cleanPath(diaryDir + "/" + thumbnailFilename);
 
-            // Encrypt and save the original image
-            bool saveSuccess = saveEncryptedImage(imagePath, encryptedImagePath);
-            if (!saveSuccess) {
-                failedImages.append(imagePath + " (encryption failed)");
-                continue;
-            }
+        // The files are only written later, keep the names so the next image doesn't get them too
+        m_reservedImagePaths.insert(encryptedImagePath);
+        m_reservedImagePaths.insert(thumbnailPath);
+        batch.reservedPaths << encryptedImagePath << thumbnailPath;
 
-            QString displayFilename = imageFilename;
-
-            // Always generate thumbnail now
-            if (displayInfo.needsThumbnail) {
-                QPixmap thumbnail = generateDynamicThumbnail(imagePath, displayInfo.targetSize);
-                if (!thumbnail.isNull()) {
-                    QString thumbnailFilename = QFileInfo(imageFilename).completeBaseName() + ".thumb";
-                    QString thumbnailPath = QDir::cleanPath(diaryDir + "/" + thumbnailFilename);
-
-                    // Save thumbnail as temporary file, then encrypt it
-                    QString tempThumbnailPath = QDir::tempPath() + "/" + thumbnailFilename + ".png";
-                    if (thumbnail.save(tempThumbnailPath, "PNG")) {
-                        bool thumbnailSaveSuccess = saveEncryptedImage(tempThumbnailPath, thumbnailPath);
-                        QFile::remove(tempThumbnailPath); // Clean up temp file
-
-                        if (thumbnailSaveSuccess) {
-                            displayFilename = thumbnailFilename;
-                            qDebug() << "Operations_Diary: Created thumbnail:" << displayFilename
-                                     << "with size" << displayInfo.targetSize;
-                        }
-                    }
-                } else {
-                    qWarning() << "Operations_Diary: Failed to generate thumbnail for" << imagePath;
-                }
-            }
+        DiaryImageIngestor::Job job;
+        job.sourcePath = imagePath;
+        job.encryptedPath = encryptedImagePath;
+        job.thumbnailPath = thumbnailPath;
+        jobs.append(job);
+    }
+
+    if (jobs.isEmpty()) {
+        cleanupImageTempFiles(imagePaths);
+        if (!failedImages.isEmpty()) {
+            QString errorMessage = "Failed to process the following images:\n\n";
+            errorMessage += failedImages.join("\n");
+            QMessageBox::warning(m_mainWindow, "Image Processing Errors", errorMessage);
+        }
+        return;
+    }
+
+    batch.diaryPath = diaryPath;
+    batch.formattedDate = formattedDate;
+    batch.diaryExistedBefore = todayDiaryExistedBefore;
+    batch.failedImages = failedImages;
+    batch.sourcePaths = imagePaths;
+    batch.imageCount = jobs.size();
+
+    const int batchId = m_imageIngestor->ingest(jobs, imageFileSizeLimit());
+    m_imageBatches.insert(batchId, batch);
+
+    // Placeholders where the images will appear, above the spacer that ends the display
+    DiaryDisplayModel* model = displayModel();
+    if (current_DiaryFileName == diaryPath && model->count() > 0) {
+        model->insertEntries(model->count() - 1, pendingImagePlaceholders(batchId));
+        m_mainWindow->ui->DiaryTextDisplay->scrollToBottom();
+    }
+}
+
+QString Operations_Diary::pendingImageToken(int batchId, int index)
+{
+    return QString("pending-image/%1/%2").arg(batchId).arg(index);
+}
 
-            processedImages.append(displayFilename);
+QVector<DiaryDisplayModel::Entry> Operations_Diary::pendingImagePlaceholders(int batchId) const
+{
+    QVector<DiaryDisplayModel::Entry> placeholders;
+    auto it = m_imageBatches.constFind(batchId);
+    if (it == m_imageBatches.constEnd()) {
+        return placeholders;
+    }
+
+    const QSize placeholderSize = imageItemSize(QSize(MAX_IMAGE_WIDTH, MAX_IMAGE_HEIGHT));
+    placeholders.reserve(it->imageCount);
+    for (int index = 0; index < it->imageCount; ++index) {
+        DiaryDisplayModel::Entry entry = DiaryDisplayModel::pendingImageEntry(pendingImageToken(batchId, index),
+                                                                              placeholderSize);
+        entry.imagePath = it->ingestedPaths.value(index);
+        placeholders.append(entry);
+    }
+    return placeholders;
+}
+
+void Operations_Diary::onImageIngested(int batchId, int index, const QString& displayPath)
+{
+    auto batch = m_imageBatches.find(batchId);
+    if (batch != m_imageBatches.end()) {
+        batch->ingestedPaths.insert(index, displayPath); // Shown again if the diary is reloaded
+    }
+
+    // The placeholder shows the image as soon as it is written, it is still not saved
+    DiaryDisplayModel* model = displayModel();
+    const int row = model->findPendingImageRow(pendingImageToken(batchId, index));
+    if (row < 0) {
+        return; // Another diary was loaded meanwhile
+    }
+    model->setImagePath(row, displayPath);
+    m_imageCache->request(displayPath);
+}
+
+void Operations_Diary::onImageBatchFinished(int batchId, const QVector<DiaryImageIngestor::Result>& results)
+{
+    if (!m_imageBatches.contains(batchId)) {
+        return;
+    }
+    const PendingImageBatch batch = m_imageBatches.take(batchId);
+    for (const QString& path : batch.reservedPaths) {
+        m_reservedImagePaths.remove(path);
+    }
+    cleanupImageTempFiles(batch.sourcePaths);
 
-        } catch (const std::exception& e) {
-            failedImages.append(imagePath + QString(" (error: %1)").arg(e.what()));
-        } catch (...) {
-            failedImages.append(imagePath + " (unknown error)");
+    const QString formattedDate = batch.formattedDate;
+    const bool todayDiaryExistedBefore = batch.diaryExistedBefore;
+    QStringList processedImages;
+    QStringList failedImages = batch.failedImages;
+    for (const DiaryImageIngestor::Result& result : results) {
+        if (result.success) {
+            processedImages.append(QFileInfo(result.displayPath).fileName());
+        } else {
+            failedImages.append(result.sourcePath + " (" + result.errorMessage + ")");
         }
     }
 
-    // SECURITY FIX: Enhanced temp file cleanup with secure directory handling
-    foreach(const QString& imagePath, imagePaths) {
-        // Check if this is a clipboard temp file (old or new pattern)
-        if (imagePath.contains("clipboard_") || imagePath.contains("clipboard_image_") || imagePath.contains("MMDiary_temp_")) {
-            // Validate path before removal to prevent directory traversal
-            QString cleanPath = QDir::cleanPath(imagePath);
-            QFileInfo fileInfo(cleanPath);
-            
-            // Only remove files, not directories
-            if (fileInfo.isFile()) {
-                QString parentDir = fileInfo.dir().absolutePath();
-                
-                // Check if it's in user temp directory (new secure approach)
-                QString userTempDir = QDir::cleanPath("Data/" + m_mainWindow->user_Username + "/temp");
-                if (cleanPath.startsWith(userTempDir)) {
-                    // This is in secure user temp - just mark for deletion, handled by timer
-                    qDebug() << "Operations_Diary: Clipboard temp file in user directory will be cleaned by timer:" << cleanPath;
-                }
-                // Check if it's in system temp (old approach - clean immediately)
-                else if (parentDir.contains("MMDiary_temp_") || parentDir.contains(QDir::tempPath())) {
-                    qDebug() << "Operations_Diary: Removing old-style temp file:" << cleanPath;
-                    QFile::remove(cleanPath);
-                    
-                    // If it's in an MMDiary temp directory, try to remove the directory too
-                    if (parentDir.contains("MMDiary_temp_")) {
-                        QDir dir(parentDir);
-                        dir.removeRecursively();
-                    }
-                }
-            }
+    // The placeholders go away, the added images are shown by the reload below. The reload puts
+    // back the placeholders of the batches that are still running.
+    DiaryDisplayModel* model = displayModel();
+    for (int index = 0; index < results.size(); ++index) {
+        const int row = model->findPendingImageRow(pendingImageToken(batchId, index));
+        if (row >= 0) {
+            model->removeEntries(row);
         }
     }
 
@@ -3065,8 +3108,11 @@ void Operations_Diary::processAndAddImages(const QStringList& imagePaths, bool f
         QString todayDiaryPath = getDiaryFilePath(formattedDate);
 
         foreach(const QString& imageFilename, processedImages) {
-            // Add each image as separate entry
-            addSingleImageToDiary(imageFilename, todayDiaryPath);
+            // Add each image as separate entry, the display is reloaded once afterwards
+            addSingleImageToDiary(imageFilename, todayDiaryPath, false);
+        }
+        if (current_DiaryFileName == todayDiaryPath) {
+            LoadDiary(todayDiaryPath);
         }
 
         // Check if we need to switch to today's diary (similar to text input logic)
@@ -3107,6 +3153,43 @@ void Operations_Diary::processAndAddImages(const QStringList& imagePaths, bool f
     }
 }
 
+void Operations_Diary::cleanupImageTempFiles(const QStringList& imagePaths)
+{
+    // SECURITY FIX: Enhanced temp file cleanup with secure directory handling
+    foreach(const QString& imagePath, imagePaths) {
+        // Check if this is a clipboard temp file (old or new pattern)
+        if (imagePath.contains("clipboard_") || imagePath.contains("clipboard_image_") || imagePath.contains("MMDiary_temp_")) {
+            // Validate path before removal to prevent directory traversal
+            QString cleanPath = QDir::cleanPath(imagePath);
+            QFileInfo fileInfo(cleanPath);
+            
+            // Only remove files, not directories
+            if (fileInfo.isFile()) {
+                QString parentDir = fileInfo.dir().absolutePath();
+                
+                // Check if it's in user temp directory (new secure approach)
+                QString userTempDir = QDir::cleanPath("Data/" + m_mainWindow->user_Username + "/temp");
+                if (cleanPath.startsWith(userTempDir)) {
+                    // The batch that read it is done, the pasted image is plaintext
+                    qDebug() << "Operations_Diary: Removing clipboard temp file:" << cleanPath;
+                    OperationsFiles::secureDelete(cleanPath);
+                }
+                // Check if it's in system temp (old approach - clean immediately)
+                else if (parentDir.contains("MMDiary_temp_") || parentDir.contains(QDir::tempPath())) {
+                    qDebug() << "Operations_Diary: Removing old-style temp file:" << cleanPath;
+                    QFile::remove(cleanPath);
+                    
+                    // If it's in an MMDiary temp directory, try to remove the directory too
+                    if (parentDir.contains("MMDiary_temp_")) {
+                        QDir dir(parentDir);
+                        dir.removeRecursively();
+                    }
+                }
+            }
+        }
+    }
+}
+
 bool Operations_Diary::openImageWithViewer(const QString& imagePath)
 {
     // Validate the image path
@@ -3252,8 +3335,8 @@ void Operations_Diary::cleanupBrokenImageReferences(const QString& diaryFilePath
     try {
         // Read the diary file directly
         QStringList diaryContent;
-        bool readSuccess = OperationsFiles::readEncryptedFileLines(
-            diaryFilePath, m_mainWindow->user_Key, diaryContent);
+        bool readSuccess = readDiaryLines(
+            diaryFilePath, diaryContent);
 
         if (!readSuccess) {
             qWarning() << "Failed to read diary file for cleanup:" << diaryFilePath;
@@ -3325,8 +3408,8 @@ void Operations_Diary::cleanupBrokenImageReferences(const QString& diaryFilePath
 
         // Write back the cleaned content if changes were made
         if (contentChanged) {
-            bool writeSuccess = OperationsFiles::writeEncryptedFileLines(
-                diaryFilePath, m_mainWindow->user_Key, cleanedContent);
+            bool writeSuccess = writeDiaryLines(
+                diaryFilePath, cleanedContent);
 
             if (writeSuccess) {
                 qDebug() << "Successfully cleaned up diary file:" << diaryFilePath;
@@ -3367,26 +3450,19 @@ bool Operations_Diary::loadAndDisplayImage(const QString& imagePath, const QStri
             return false;
         }
 
-        // Get the current item and set it up to display the image
-        QList<QListWidgetItem*> items = getTextDisplayItems();
-        if (!items.isEmpty()) {
-            QListWidgetItem* item = items.last();
-
-            // Create display text (shorter since we're showing the image)
-            QString displayText = getImageDisplayText(imageFilename, imagePixmap.size());
-
-            // Set up as image item FIRST
-            setupImageItem(item, imagePath, displayText);
-
+        // Turn the last row into the image row
+        DiaryDisplayModel* model = displayModel();
+        if (model->count() > 0) {
             // Calculate the size needed for the image + text
             QSize imageSize = imagePixmap.size();
             int itemHeight = imageSize.height() + 30; // Image + 30px for text and padding
             int itemWidth = qMax(imageSize.width() + 20, 300); // Minimum 300px width
 
-            // Set the size hint AFTER setting up the image item
-            item->setSizeHint(QSize(itemWidth, itemHeight));
+            model->removeEntries(model->count() - 1);
+            model->appendEntry(DiaryDisplayModel::imageEntry(imagePath, QSize(itemWidth, itemHeight)));
 
-            qDebug() << "Set size hint for image item:" << QSize(itemWidth, itemHeight);
+            qDebug() << "Set size hint for image item:" << QSize(itemWidth, itemHeight)
+                     << "for" << getImageDisplayText(imageFilename, imageSize);
         }
 
         return true;
@@ -3475,6 +3551,7 @@ void Operations_Diary::deleteImageFiles(const QString& imageData, const QString&
 
     foreach(const QString& imageFilename, imageFilenames) {
         QString imagePath = QDir::cleanPath(diaryDir + "/" + imageFilename);
+        m_imageCache->remove(imagePath);
 
         if (isThumbnailPath(imageFilename)) {
             // This is a thumbnail - delete both thumbnail and original
@@ -3527,20 +3604,20 @@ void Operations_Diary::deleteImageFiles(const QString& imageData, const QString&
     }
 }
 
-void Operations_Diary::updateImageEntryInDiary(QListWidgetItem* item, const QString& originalImageData)
+void Operations_Diary::updateImageEntryInDiary(int row, const QString& originalImageData)
 {
     qDebug() << "=== updateImageEntryInDiary called ===";
     qDebug() << "originalImageData:" << originalImageData;
 
-    if (!item || !item->data(Qt::UserRole+3).toBool()) {
+    if (!displayModel()->isImage(row)) {
         qDebug() << "Not an image item, returning";
         return; // Not an image item
     }
 
     // Read current diary content
     QStringList diaryContent;
-    bool readSuccess = OperationsFiles::readEncryptedFileLines(
-        current_DiaryFileName, m_mainWindow->user_Key, diaryContent);
+    bool readSuccess = readDiaryLines(
+        current_DiaryFileName, diaryContent);
 
     if (!readSuccess) {
         qWarning() << "Failed to read diary file for image update";
@@ -3549,27 +3626,11 @@ void Operations_Diary::updateImageEntryInDiary(QListWidgetItem* item, const QStr
 
     qDebug() << "Read diary content, lines:" << diaryContent.size();
 
-    // Get the item row for debugging
-    int itemRow = m_mainWindow->ui->DiaryTextDisplay->row(item);
-    qDebug() << "Item row in display:" << itemRow;
-
-    // Get updated image data
-    bool isMultiImage = item->data(Qt::UserRole+5).toBool();
-    QString newImageData;
+    qDebug() << "Item row in display:" << row;
 
-    if (isMultiImage) {
-        QStringList imagePaths = item->data(Qt::UserRole+4).toStringList();
-        QStringList imageFilenames;
-        foreach(const QString& path, imagePaths) {
-            imageFilenames.append(QFileInfo(path).fileName());
-        }
-        newImageData = imageFilenames.join("|");
-        qDebug() << "Multi-image data to save:" << newImageData;
-    } else {
-        QString imagePath = item->data(Qt::UserRole+4).toString();
-        newImageData = QFileInfo(imagePath).fileName();
-        qDebug() << "Single-image data to save:" << newImageData;
-    }
+    // Get updated image data (single image only)
+    QString newImageData = QFileInfo(displayModel()->imagePath(row)).fileName();
+    qDebug() << "Single-image data to save:" << newImageData;
 
     // Find and update the SPECIFIC image entry that matches the original data
     bool foundAndUpdated = false;
@@ -3610,8 +3671,8 @@ void Operations_Diary::updateImageEntryInDiary(QListWidgetItem* item, const QStr
     }
 
     // Write back to file
-    bool writeSuccess = OperationsFiles::writeEncryptedFileLines(
-        current_DiaryFileName, m_mainWindow->user_Key, diaryContent);
+    bool writeSuccess = writeDiaryLines(
+        current_DiaryFileName, diaryContent);
 
     if (!writeSuccess) {
         qWarning() << "Failed to write updated diary file";
@@ -3775,27 +3836,21 @@ bool Operations_Diary::decryptAndExportImage(const QString& encryptedImagePath,
     }
 }
 
-void Operations_Diary::exportSingleImage(QListWidgetItem* item)
+void Operations_Diary::exportSingleImage(int row)
 {
-    if (!item || !item->data(Qt::UserRole+3).toBool()) {
+    if (!displayModel()->isImage(row)) {
         return; // Not an image item
     }
 
-    QString imagePath = item->data(Qt::UserRole+4).toString();
+    QString imagePath = displayModel()->imagePath(row);
     if (imagePath.isEmpty()) {
         QMessageBox::warning(m_mainWindow, "Error", "Image path not found.");
         return;
     }
 
     // FIXED: Determine which diary directory to use based on current row
-    QString diaryPath = current_DiaryFileName;
-    int currentRow = m_mainWindow->ui->DiaryTextDisplay->row(item);
-    if (currentRow < previousDiaryLineCounter && previous_DiaryFileName != "") {
-        diaryPath = previous_DiaryFileName;
-        qDebug() << "Export: Using previous diary path:" << diaryPath;
-    } else {
-        qDebug() << "Export: Using current diary path:" << diaryPath;
-    }
+    QString diaryPath = diaryFileForRow(row);
+    qDebug() << "Export: Using diary path:" << diaryPath;
 
     QFileInfo diaryFileInfo(diaryPath);
     QString diaryDir = diaryFileInfo.dir().absolutePath();
@@ -3936,6 +3991,9 @@ bool Operations_Diary::recreateThumbnail(const QString& thumbnailPath, const QSt
         // Clean up temporary file
         QFile::remove(tempThumbnailPath);
 
+        // The cache may still hold the broken thumbnail (or the fact that it failed)
+        m_imageCache->remove(QDir::cleanPath(thumbnailPath));
+
         if (success) {
             qDebug() << "Successfully recreated thumbnail:" << thumbnailPath;
             return true;
@@ -4023,7 +4081,7 @@ void Operations_Diary::cleanupOpenImageViewers()
     m_openImageViewers.clear();
 }
 
-QSize Operations_Diary::calculateOptimalDisplaySize(const QSize& originalSize, const QSize& maxSize, int minSize) const
+QSize Operations_Diary::calculateOptimalDisplaySize(const QSize& originalSize, const QSize& maxSize, int minSize)
 {
     if (originalSize.width() <= 0 || originalSize.height() <= 0) {
         return QSize(minSize > 0 ? minSize : 64, minSize > 0 ? minSize : 64);
@@ -4093,7 +4151,8 @@ QPixmap Operations_Diary::generateDynamicThumbnail(const QString& imagePath, con
     return scaledPixmap;
 }
 
-void Operations_Diary::addSingleImageToDiary(const QString& imageFilename, const QString& diaryFilePath)
+void Operations_Diary::addSingleImageToDiary(const QString& imageFilename, const QString& diaryFilePath,
+                                             bool reloadDisplay)
 {
     qDebug() << "=== addSingleImageToDiary called ===";
     qDebug() << "imageFilename:" << imageFilename;
@@ -4106,8 +4165,8 @@ void Operations_Diary::addSingleImageToDiary(const QString& imageFilename, const
         QStringList diaryContent;
         diaryContent.append(GetDiaryDateStamp(formattedDate));
 
-        bool writeSuccess = OperationsFiles::writeEncryptedFileLines(
-            diaryFilePath, m_mainWindow->user_Key, diaryContent);
+        bool writeSuccess = writeDiaryLines(
+            diaryFilePath, diaryContent);
 
         if (!writeSuccess) {
             qWarning() << "Failed to create diary file for image";
@@ -4118,8 +4177,8 @@ void Operations_Diary::addSingleImageToDiary(const QString& imageFilename, const
 
     // Read current diary content
     QStringList diaryContent;
-    bool readSuccess = OperationsFiles::readEncryptedFileLines(
-        diaryFilePath, m_mainWindow->user_Key, diaryContent);
+    bool readSuccess = readDiaryLines(
+        diaryFilePath, diaryContent);
 
     if (!readSuccess) {
         qWarning() << "Failed to read diary file for adding image";
@@ -4157,19 +4216,16 @@ void Operations_Diary::addSingleImageToDiary(const QString& imageFilename, const
     diaryContent.append(imageFilename);
     diaryContent.append(Constants::Diary_ImageEnd);
 
-    // Write the updated content back to the diary
-    bool writeSuccess = OperationsFiles::writeEncryptedFileLines(
-        diaryFilePath, m_mainWindow->user_Key, diaryContent);
-
-    if (!writeSuccess) {
-        qWarning() << "Failed to write image to diary file";
-        return;
+    // Queue the updated content, the images of one paste are written together
+    m_saveQueue->schedule(diaryFilePath, diaryContent);
+    if (m_dayPrefetcher) {
+        m_dayPrefetcher->drop(diaryFilePath);
     }
 
-    qDebug() << "Successfully wrote image entry to diary";
+    qDebug() << "Queued image entry for diary";
 
     // Reload the diary if it's currently displayed
-    if (current_DiaryFileName == diaryFilePath) {
+    if (reloadDisplay && current_DiaryFileName == diaryFilePath) {
         qDebug() << "Reloading diary to show new image";
         LoadDiary(diaryFilePath);
     }
@@ -4261,25 +4317,64 @@ ImageDisplayInfo Operations_Diary::calculateImageDisplayInfo(const QSize& origin
     return info;
 }
 
-void Operations_Diary::setupImageItem(QListWidgetItem* item, const QString& imagePath, const QString& displayText)
+QSize Operations_Diary::imageItemSize(const QSize& imageSize) const
+{
+    // CombinedDelegate paints the image with this margin on every side
+    const int MARGIN = 10;
+    return QSize(imageSize.width() + (2 * MARGIN), imageSize.height() + (2 * MARGIN));
+}
+
+void Operations_Diary::onDiaryImageReady(const QString& imagePath)
+{
+    // Rows that were added with a placeholder size get the size of the decoded image
+    const QSize itemSize = imageItemSize(m_imageCache->imageSize(imagePath));
+    DiaryDisplayModel* model = displayModel();
+    const QVector<int> rows = model->findImageRows(imagePath);
+    for (int row : rows) {
+        if (model->entry(row).sizeHint != itemSize) {
+            model->setSizeHint(row, itemSize);
+        }
+    }
+    if (!rows.isEmpty()) {
+        m_mainWindow->ui->DiaryTextDisplay->viewport()->update();
+    }
+}
+
+void Operations_Diary::onDiaryImageFailed(const QString& imagePath)
 {
-    // Set up the item as a clickable image (single image only now)
-    item->setText(""); // Remove caption completely
-    item->setData(Qt::UserRole+3, true); // Mark as image
-    item->setData(Qt::UserRole+4, imagePath); // Store single path as QString
-    // Note: UserRole+5 (isMultiImage) is no longer used
+    if (displayModel()->findImageRows(imagePath).isEmpty()) {
+        return; // Not shown anymore
+    }
 
-    item->setFlags(item->flags() & ~Qt::ItemIsEditable); // Make non-editable but still selectable
+    // The image belongs to whichever displayed diary lives in the same folder
+    const QString imageDir = QFileInfo(imagePath).absolutePath();
+    QString diaryFilePath;
+    if (!current_DiaryFileName.isEmpty() && QFileInfo(current_DiaryFileName).absolutePath() == imageDir) {
+        diaryFilePath = current_DiaryFileName;
+    } else if (!previous_DiaryFileName.isEmpty() && QFileInfo(previous_DiaryFileName).absolutePath() == imageDir) {
+        diaryFilePath = previous_DiaryFileName;
+    }
+    if (diaryFilePath.isEmpty() || m_pendingImageCleanups.contains(diaryFilePath)) {
+        return;
+    }
+
+    // Broken images are cleaned up once per diary, however many of them failed
+    qDebug() << "Scheduling cleanup of broken image references in diary:" << diaryFilePath;
+    m_pendingImageCleanups.insert(diaryFilePath);
+    SafeTimer::singleShot(100, this, [this, diaryFilePath]() {
+        m_pendingImageCleanups.remove(diaryFilePath);
+        cleanupBrokenImageReferences(diaryFilePath);
+    }, "Operations_Diary::cleanupBrokenImageReferences");
 }
 
-void Operations_Diary::handleImageClick(QListWidgetItem* item)
+void Operations_Diary::handleImageClick(int row)
 {
-    if (!item || !item->data(Qt::UserRole+3).toBool()) {
+    if (!displayModel()->isImage(row)) {
         return; // Not an image item
     }
 
     // Single image handling only
-    QString imagePath = item->data(Qt::UserRole+4).toString();
+    QString imagePath = displayModel()->imagePath(row);
 
     if (imagePath.isEmpty()) {
         QMessageBox::warning(m_mainWindow, "Error", "Image path not found.");
@@ -4287,14 +4382,8 @@ void Operations_Diary::handleImageClick(QListWidgetItem* item)
     }
 
     // Determine which diary directory to use based on current row
-    QString diaryPath = current_DiaryFileName;
-    int currentRow = m_mainWindow->ui->DiaryTextDisplay->row(item);
-    if (currentRow < previousDiaryLineCounter && previous_DiaryFileName != "") {
-        diaryPath = previous_DiaryFileName;
-        qDebug() << "Handle image click: Using previous diary path:" << diaryPath;
-    } else {
-        qDebug() << "Handle image click: Using current diary path:" << diaryPath;
-    }
+    QString diaryPath = diaryFileForRow(row);
+    qDebug() << "Handle image click: Using diary path:" << diaryPath;
 
     QFileInfo diaryFileInfo(diaryPath);
     QString diaryDir = diaryFileInfo.dir().absolutePath();
@@ -4314,6 +4403,12 @@ QSize Operations_Diary::calculateItemSizeForImage(const QString& imagePath, bool
     }
 
     try {
+        // Images the cache has decoded already know their size
+        QSize cachedSize = m_imageCache->imageSize(imagePath);
+        if (cachedSize.isValid()) {
+            return imageItemSize(cachedSize);
+        }
+
         // Load the image to get its actual display size
         QPixmap imagePixmap = loadEncryptedImage(imagePath);
         QSize imageSize;
@@ -4329,10 +4424,7 @@ QSize Operations_Diary::calculateItemSizeForImage(const QString& imagePath, bool
         }
 
         // Add margins to get total item size
-        int totalWidth = imageSize.width() + (2 * MARGIN);
-        int totalHeight = imageSize.height() + (2 * MARGIN);
-
-        return QSize(totalWidth, totalHeight);
+        return imageItemSize(imageSize);
 
     } catch (const std::exception& e) {
         qWarning() << "Operations_Diary: Exception calculating image size:" << e.what();
@@ -4343,14 +4435,14 @@ QSize Operations_Diary::calculateItemSizeForImage(const QString& imagePath, bool
     }
 }
 
-int Operations_Diary::calculateClickedImageIndex(QListWidgetItem* item, const QPoint& clickPos)
+int Operations_Diary::calculateClickedImageIndex(int row, const QPoint& clickPos)
 {
-    if (!item || !item->data(Qt::UserRole+3).toBool()) {
+    if (!displayModel()->isImage(row)) {
         return -1; // Not an image item
     }
 
     // Get the item's rect in widget coordinates
-    QRect itemRect = m_mainWindow->ui->DiaryTextDisplay->visualItemRect(item);
+    QRect itemRect = m_mainWindow->ui->DiaryTextDisplay->visualRect(displayModel()->index(row));
 
     // Convert click position to relative coordinates within the item
     QPoint relativePos = clickPos - itemRect.topLeft();
@@ -4359,26 +4451,23 @@ int Operations_Diary::calculateClickedImageIndex(QListWidgetItem* item, const QP
     const int MARGIN = 10;
 
     // Calculate where the actual image is drawn within the item
-    QString imagePath = item->data(Qt::UserRole+4).toString();
-    QPixmap imagePixmap = loadEncryptedImage(imagePath);
+    QString imagePath = displayModel()->imagePath(row);
+    QSize imageSize = m_imageCache->imageSize(imagePath);
 
-    if (!imagePixmap.isNull()) {
+    if (imageSize.isValid()) {
         // Calculate available space for the image (same as in paintSingleImage)
         int availableWidth = itemRect.width() - (2 * MARGIN);
         int availableHeight = itemRect.height() - (2 * MARGIN);
 
-        // Scale the image to fit the available space while preserving aspect ratio
-        QPixmap scaledPixmap = imagePixmap.scaled(
-            QSize(availableWidth, availableHeight),
-            Qt::KeepAspectRatio,
-            Qt::SmoothTransformation
-            );
+        // Scale the image to fit the available space while preserving aspect ratio.
+        // Only the size matters here, there is no need to decode the image again
+        QSize scaledSize = imageSize.scaled(QSize(availableWidth, availableHeight), Qt::KeepAspectRatio);
 
         // The image is left-aligned at (MARGIN, MARGIN)
         int imageX = MARGIN;
         int imageY = MARGIN;
-        int imageWidth = scaledPixmap.width();
-        int imageHeight = scaledPixmap.height();
+        int imageWidth = scaledSize.width();
+        int imageHeight = scaledSize.height();
 
         // Check if click is within the actual image bounds
         if (relativePos.x() >= imageX && relativePos.x() <= imageX + imageWidth &&
@@ -4504,35 +4593,10 @@ void Operations_Diary::on_DiaryListDays_currentTextChanged(const QString &curren
         QString latestDiaryPath = "";
         bool foundLatestDiary = false;
 
-        // Scan directories to find the most recent diary
-        QDir baseDir(DiariesFilePath);
-        QStringList yearFolders = baseDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-        std::sort(yearFolders.begin(), yearFolders.end());
-
-        if (!yearFolders.isEmpty()) {
-            QString latestYear = yearFolders.last();
-            QDir yearDir(DiariesFilePath + latestYear);
-            QStringList monthFolders = yearDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-            std::sort(monthFolders.begin(), monthFolders.end());
-
-            if (!monthFolders.isEmpty()) {
-                QString latestMonth = monthFolders.last();
-                QDir monthDir(DiariesFilePath + latestYear + "/" + latestMonth);
-                QStringList dayFolders = monthDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-                std::sort(dayFolders.begin(), dayFolders.end());
-
-                if (!dayFolders.isEmpty()) {
-                    QString latestDay = dayFolders.last();
-
-                    // Construct the date string in the format YYYY.MM.DD
-                    QString latestDateString = latestYear + "." + latestMonth + "." + latestDay;
-                    latestDiaryPath = getDiaryFilePath(latestDateString);
-
-                    if(QFileInfo::exists(latestDiaryPath)) {
-                        foundLatestDiary = true;
-                    }
-                }
-            }
+        QDate latestDate = m_dateIndex->latest();
+        if (latestDate.isValid()) {
+            latestDiaryPath = getDiaryFilePath(latestDate.toString("yyyy.MM.dd"));
+            foundLatestDiary = QFileInfo::exists(latestDiaryPath);
         }
 
         if(foundLatestDiary && current_DiaryFileName == latestDiaryPath) // if the currently selected diary is the last file in our directory
@@ -4552,60 +4616,32 @@ void Operations_Diary::on_DiaryTextDisplay_itemChanged()
 {
     if(!prevent_onDiaryTextDisplay_itemChanged && m_mainWindow->initFinished) // if we are not currently adding new text and init is complete
     {
-        QList<QListWidgetItem*> items = getTextDisplayItems(); // Update the list of all the text in the listview diary text display.
-        if(items.length() > 0 && m_mainWindow->ui->DiaryTextDisplay->currentRow() > 0) // if our display has at least 1 line and the current row is the first one. prevents SIGSEV crash
+        int currentRow = m_mainWindow->ui->DiaryTextDisplay->currentRow();
+        if(m_mainWindow->ui->DiaryTextDisplay->count() > 0 && currentRow > 0 && !isTimelineRow(currentRow)) // if our display has at least 1 line and the current row is not the first one. prevents SIGSEV crash
         {
-            // Get the current edited text
-            QString editedText = "";
-            if (m_mainWindow->ui->DiaryTextDisplay->currentItem()) {
-                editedText = m_mainWindow->ui->DiaryTextDisplay->currentItem()->text();
-
-                // Validate the edited text
-                InputValidation::ValidationResult result =
-                    InputValidation::validateInput(editedText, InputValidation::InputType::DiaryContent, 100000);
-
-                if (!result.isValid) {
-                    QMessageBox::warning(m_mainWindow, "Invalid Entry",
-                                         "The text you entered contains invalid content: " + result.errorMessage);
-
-                    // Reset to original text
-                    m_mainWindow->ui->DiaryTextDisplay->currentItem()->setText(uneditedText);
-                    return;
-                }
+            // Validate the edited text
+            QString editedText = displayModel()->text(currentRow);
+            InputValidation::ValidationResult result =
+                InputValidation::validateInput(editedText, InputValidation::InputType::DiaryContent, 100000);
+
+            if (!result.isValid) {
+                QMessageBox::warning(m_mainWindow, "Invalid Entry",
+                                     "The text you entered contains invalid content: " + result.errorMessage);
+                return; // don't save it
             }
 
-            if(m_mainWindow->ui->DiaryTextDisplay->currentRow() < previousDiaryLineCounter && previous_DiaryFileName != "") // if current row is within range of previous diary in the text display and a previous diary is loaded
+            if(currentRow < previousDiaryLineCounter && previous_DiaryFileName != "") // if current row is within range of previous diary in the text display and a previous diary is loaded
             {
-                if(editedText.isEmpty()) // if we erased all the text from the entry
-                {
-                    m_mainWindow->ui->DiaryTextDisplay->currentItem()->setText(uneditedText); // Restore the text to its original value.
-                }
                 SaveDiary(previous_DiaryFileName, true); // Save the previous diary with the newly modified text. true means we are saving the previous diary
             }
             else // if current row is in todays diary.
             {
-                if(editedText.isEmpty()) // if we erased all the text from the entry
-                {
-                    m_mainWindow->ui->DiaryTextDisplay->currentItem()->setText(uneditedText); // Restore the text to its original value. uneditedText is saved in on_doubleclicked
-                }
                 prevent_onDiaryTextDisplay_itemChanged = true; // prevents infinite loop
                 // REMOVES THE SPACER WIDGET USED IN DESELECTING THE LAST ENTRY. WE DONT WANT TO SAVE IT IN THE DIARY FILE
-                QList<QListWidgetItem *> items = getTextDisplayItems(); // Update the list of all the text in the listview diary text display.
-                // THREAD SAFETY: Check if items list is valid before accessing
-                if (!items.isEmpty()) {
-                    m_mainWindow->ui->DiaryTextDisplay->takeItem(items.length() - 1);
-                }
-                //----------------------//
+                removeDeselectSpacer();
                 SaveDiary(current_DiaryFileName, false); // Save the current diary with the newly modified text. false means we are saving todays diary
                 //Add a spacer that is used only for one reason, being able to deselect the last entry of the display. IT IS NOT SAVED INTO OUR DIARY FILE
-                m_mainWindow->ui->DiaryTextDisplay->addItem(Constants::Diary_Spacer); //Add spacer
-                items = getTextDisplayItems(); // Update the list of all the text in the listview diary text display.
-                // THREAD SAFETY: Check if items list is valid before accessing
-                if (!items.isEmpty()) {
-                    m_mainWindow->ui->DiaryTextDisplay->item(items.length() - 1)->setData(Qt::UserRole, true);// uses hidetext delegate to hide the spacer
-                    m_mainWindow->ui->DiaryTextDisplay->item(items.length() - 1)->setFlags(m_mainWindow->ui->DiaryTextDisplay->item(items.length() - 1)->flags() & ~Qt::ItemIsEnabled); // disable the spacer
-                }
-                //------------------------------//
+                appendDeselectSpacer(false);
                 prevent_onDiaryTextDisplay_itemChanged = false; // prevents infinite loop
             }
         }
@@ -4635,16 +4671,16 @@ void Operations_Diary::on_DiaryTextDisplay_clicked()
         return;
     }
     
-    QListWidgetItem* currentItem = m_mainWindow->ui->DiaryTextDisplay->currentItem();
+    int currentRow = m_mainWindow->ui->DiaryTextDisplay->currentRow();
 
-    if (currentItem) {
-        bool isImageItem = currentItem->data(Qt::UserRole+3).toBool();
+    if (currentRow >= 0) {
+        bool isImageItem = displayModel()->isImage(currentRow);
 
         if (isImageItem) {
             QPoint clickPos = m_mainWindow->ui->DiaryTextDisplay->getLastClickPos();
 
             // Check if click was actually on an image
-            int clickedImageIndex = calculateClickedImageIndex(currentItem, clickPos);
+            int clickedImageIndex = calculateClickedImageIndex(currentRow, clickPos);
 
             if (clickedImageIndex == -1) {
                 // Click was not on the image, treat as normal list item click
@@ -4653,7 +4689,7 @@ void Operations_Diary::on_DiaryTextDisplay_clicked()
             }
 
             // Click was on the image, open it
-            handleImageClick(currentItem);
+            handleImageClick(currentRow);
             return;
         }
     }
@@ -4692,9 +4728,8 @@ void Operations_Diary::on_DiaryTextInput_returnPressed()
         {
             InputNewEntry(current_DiaryFileName); // add text to todays diary
             // Select the newly added entry (the next-to-last item, since the last is the spacer)
-            QList<QListWidgetItem*> items = getTextDisplayItems();
-            if (items.length() > 1) {
-                m_mainWindow->ui->DiaryTextDisplay->setCurrentItem(items.at(items.length() - 2));
+            if (m_mainWindow->ui->DiaryTextDisplay->count() > 1) {
+                m_mainWindow->ui->DiaryTextDisplay->setCurrentRow(m_mainWindow->ui->DiaryTextDisplay->count() - 2);
             }
         }
         else if (!QFileInfo::exists(todayDiaryPath)) // else if todays diary isn't currently loaded and does not exist
@@ -4863,8 +4898,8 @@ void Operations_Diary::AddTaskLogEntry(QString taskType, QString taskName, QStri
 
     // Read existing content if diary exists
     if (QFileInfo::exists(todayDiaryPath)) {
-        bool readSuccess = OperationsFiles::readEncryptedFileLines(
-            todayDiaryPath, m_mainWindow->user_Key, diaryContent);
+        bool readSuccess = readDiaryLines(
+            todayDiaryPath, diaryContent);
 
         if (!readSuccess) {
             qWarning() << "Failed to read diary file for task log entry";
@@ -4906,8 +4941,8 @@ void Operations_Diary::AddTaskLogEntry(QString taskType, QString taskName, QStri
     }
 
     // Write the updated content to the diary file
-    bool writeSuccess = OperationsFiles::writeEncryptedFileLines(
-        todayDiaryPath, m_mainWindow->user_Key, diaryContent);
+    bool writeSuccess = writeDiaryLines(
+        todayDiaryPath, diaryContent);
 
     if (!writeSuccess) {
         qWarning() << "Failed to write task log entry to diary file";
@@ -5,14 +5,24 @@
 #include "mainwindow.h"
 #include "operations.h"
 #include "inputvalidation.h"
+#include "DiaryDisplayModel.h"
+#include "diary_imageingestor.h"
+#include "diary_exporter.h"
 #include "ThreadSafeContainers.h"
 #include <QMessageBox>
 #include <QMutex>
 #include <QPointer>
+#include <QSet>
 #include <QAbstractItemDelegate>
 
 class MainWindow;
 class ImageViewer;
+class DiarySearchIndex;
+class DiaryDateIndex;
+class DiaryImageCache;
+class DiaryDayPrefetcher;
+class DiarySaveQueue;
+class QProgressDialog;
 
 struct ImageDisplayInfo {
     QSize targetSize;           // The size we want to display the image at
@@ -47,8 +57,6 @@ private:
     QString current_DiaryFileName, previous_DiaryFileName, currentdiary_Year, currentdiary_Month, DiariesFilePath = "Diaries/", currentdiary_DateStamp;
     int lastTimeStamp_Hours, lastTimeStamp_Minutes, entrySpacer_Delay = 5, entriesNoSpacerLimit = 5, cur_entriesNoSpacer, previousDiaryLineCounter;
     QStringList DiariesList, currentyear_DiaryList, currentmonth_DiaryList;
-    QFont font_TimeStamp;
-    QString uneditedText;
     bool prevent_onDiaryTextDisplay_itemChanged;
 
     QMutex m_saveDiaryMutex;
@@ -74,21 +82,50 @@ private:
     bool loadAndDisplayImage(const QString& imagePath, const QString& imageFilename);
     QPixmap loadEncryptedImage(const QString& encryptedImagePath) const;
     QString getImageDisplayText(const QString& imageFilename, const QSize& imageSize);
-    void setupImageItem(QListWidgetItem* item, const QString& imagePath, const QString& displayText);
+    QSize imageItemSize(const QSize& imageSize) const;
     bool markDiaryForCleanup = false; // Flag to indicate diary needs cleanup
 
-    void handleImageClick(QListWidgetItem* item);
+    void handleImageClick(int row);
 
     // NEW: Simplified single image handling
-    void addSingleImageToDiary(const QString& imageFilename, const QString& diaryFilePath);
+    void addSingleImageToDiary(const QString& imageFilename, const QString& diaryFilePath, bool reloadDisplay = true);
     bool shouldAddTimestampForImage(const QStringList& diaryContent);
 
+    // Pasted and dropped images are encrypted and thumbnailed in the background. Placeholders are
+    // shown right away, each one shows its image once it is written, and the whole batch is
+    // added to the diary in the original order when the last image is done.
+    struct PendingImageBatch {
+        QString diaryPath;
+        QString formattedDate;
+        bool diaryExistedBefore = false;
+        QStringList failedImages;          // Rejected before the batch started
+        QStringList sourcePaths;           // As handed to processAndAddImages, for the temp file cleanup
+        QStringList reservedPaths;         // Target files reserved for the batch
+        int imageCount = 0;                // Images handed to the ingestor, one placeholder each
+        QHash<int, QString> ingestedPaths; // Index -> display path of the images already written
+    };
+    DiaryImageIngestor* m_imageIngestor = nullptr;
+    QHash<int, PendingImageBatch> m_imageBatches;
+    QSet<QString> m_reservedImagePaths;    // Names taken by images that aren't written yet
+    static QString pendingImageToken(int batchId, int index);
+    // Placeholder rows of a batch, also used to put them back when the diary is reloaded
+    QVector<DiaryDisplayModel::Entry> pendingImagePlaceholders(int batchId) const;
+    void onImageIngested(int batchId, int index, const QString& displayPath);
+    void onImageBatchFinished(int batchId, const QVector<DiaryImageIngestor::Result>& results);
+    void cleanupImageTempFiles(const QStringList& imagePaths);
+
+    // Decrypted export of a range of diaries, runs in the background with a progress dialog
+    DiaryExporter* m_exporter = nullptr;
+    QPointer<QProgressDialog> m_exportProgress;
+    void onExportProgress(int daysDone, int dayCount, qint64 bytesWritten);
+    void onExportFinished(const DiaryExporter::Summary& summary);
+
     // Image click detection (simplified for single images)
     QPoint m_lastContextMenuPos;   // Position where context menu was requested
 
     // Helper functions for image deletion and click detection
     void deleteImageFiles(const QString& imageData, const QString& diaryDir);
-    void updateImageEntryInDiary(QListWidgetItem* item, const QString& originalImageData);
+    void updateImageEntryInDiary(int row, const QString& originalImageData);
 
     // Helper functions for thumbnail/original image handling
     bool isThumbnailPath(const QString& imagePath) const;
@@ -99,7 +136,7 @@ private:
     // Helper methods for image export functionality
     bool decryptAndExportImage(const QString& encryptedImagePath, const QString& originalFilename);
     bool isOldDiaryEntry();
-    void exportSingleImage(QListWidgetItem* item);
+    void exportSingleImage(int row);
 
     // Image validation and repair methods
     ImageValidationResult validateImageFile(const QString& imageFilename, const QString& diaryDir);
@@ -115,13 +152,75 @@ private:
 
     ImageDisplayInfo calculateImageDisplayInfo(const QSize& originalSize, bool isGrouped = false) const;
     QPixmap generateDynamicThumbnail(const QString& imagePath, const QSize& targetSize);
-    QSize calculateOptimalDisplaySize(const QSize& originalSize, const QSize& maxSize, int minSize = MIN_THUMBNAIL_SIZE) const;
+    // Static so the image ingestion workers can size thumbnails with it
+    static QSize calculateOptimalDisplaySize(const QSize& originalSize, const QSize& maxSize, int minSize = MIN_THUMBNAIL_SIZE);
     QSize calculateItemSizeForImage(const QString& imagePath, bool isMultiImage, const QStringList& allImagePaths) const;
 
-    int calculateClickedImageIndex(QListWidgetItem* item, const QPoint& clickPos);
+    int calculateClickedImageIndex(int row, const QPoint& clickPos);
 
     bool isYesterdaysDiaryEntry();
 
+    // Diary display rows
+    DiaryDisplayModel* displayModel() const;
+    // Turns the lines of a day file into display rows. Text blocks become one row between
+    // their (hidden) markers, image blocks become an image row, see SaveDiary() for the reverse.
+    QVector<DiaryDisplayModel::Entry> buildDisplayEntries(const QStringList& diaryLines, const QString& diaryDir);
+    // Spacer at the end of the display so the last entry can be deselected, it is never saved
+    void appendDeselectSpacer(bool hidden);
+    void removeDeselectSpacer();
+
+    // Every diary write goes through here so the search index stays in step with the files.
+    // It writes right away and replaces whatever SaveDiary() left queued for the day.
+    bool writeDiaryLines(const QString& diaryFilePath, const QStringList& diaryLines);
+    // Reads a day including changes still queued by SaveDiary()
+    bool readDiaryLines(const QString& diaryFilePath, QStringList& diaryLines, bool cacheResult = true);
+
+    // SaveDiary() only queues the day, bursts of changes are written once after a short idle time
+    DiarySaveQueue* m_saveQueue = nullptr;
+    void onDiaryDayWritten(const QString& diaryFilePath, const QStringList& diaryLines, bool created);
+
+    // Sorted dates of all diaries, replaces walking the year/month/day folders
+    DiaryDateIndex* m_dateIndex = nullptr;
+
+    // Full-text search
+    DiarySearchIndex* m_searchIndex = nullptr;
+
+    // Decrypted and decoded diary images, shared with the delegate that paints them
+    DiaryImageCache* m_imageCache = nullptr;
+    void onDiaryImageReady(const QString& imagePath);
+    void onDiaryImageFailed(const QString& imagePath);
+    QSet<QString> m_pendingImageCleanups;   // Diaries with a cleanup of broken images scheduled
+
+    // Timeline: scrolling up past the top of the display loads the older days above it, one at a
+    // time. Their rows sit above the previous diary rows, are read only and are never saved.
+    // The next older day is read in the background before it is needed, and days that end up far
+    // above the viewport are evicted again.
+    struct TimelineDay {
+        QString filePath;
+        int rowCount = 0;
+    };
+    QVector<TimelineDay> m_timelineDays;     // Oldest first
+    int m_timelineRowCount = 0;              // Rows of m_timelineDays at the top of the display
+    bool m_timelineActive = false;           // Set once a loaded diary has been scrolled into place
+    bool m_timelineUpdating = false;         // Prevents reacting to our own scroll bar changes
+    QString m_timelineBaseFile;              // Diary loaded by LoadDiary
+    QString m_timelineWantedDay;             // Day to add as soon as it has been read
+    DiaryDayPrefetcher* m_dayPrefetcher = nullptr;
+    static const int TIMELINE_EVICT_SCREENS = 10;
+
+    bool isTimelineRow(int row) const { return row >= 0 && row < m_timelineRowCount; }
+    QString diaryFileForRow(int row) const;  // Day file a display row belongs to
+    QDate oldestDisplayedDate() const;
+    void resetTimeline(const QString& baseDiaryFile);
+    void prefetchAdjacentDays();
+    void extendTimeline();
+    void prependTimelineDay(const QString& diaryFilePath, const QStringList& diaryLines);
+    void evictDistantTimelineDays();
+    void onTimelineScrolled(int value);
+    void onDayPrefetched(const QString& diaryFilePath);
+    void setDiarySearchMode(bool active);
+    QString buildSearchSnippet(const QString& entryText, const QStringList& terms) const;
+
 public:
     ~Operations_Diary();
     explicit Operations_Diary(MainWindow* mainWindow);
@@ -133,7 +232,6 @@ public:
     // Moved functions
     void InputNewEntry(QString DiaryFileName);
     void AddNewEntryToDisplay();
-    QList<QListWidgetItem*> getTextDisplayItems();
     void DiaryLoader();
     void CreateNewDiary();
     void LoadDiary(QString DiaryFileName);
@@ -158,8 +256,11 @@ public:
 
 public slots:
     void DeleteEmptyCurrentDayDiary();
+    // Writes every queued diary save now (tab switch, logout, shutdown)
+    void flushPendingSaves();
     void OpenEditor();
     void DeleteDiaryFromListDays();
+    void ExportDiaries();
     void DeleteEntry();
     void CopyToClipboard();
     void on_DiaryTextInput_returnPressed();
@@ -173,6 +274,10 @@ public slots:
     // SECURITY FIX: New slot to handle clipboard images securely
     void handleClipboardImage(const QImage& image, const QString& format);
 
+    // Full-text search slots
+    void onDiarySearchRequested();
+    void openDiarySearchResult(QListWidgetItem* item);
+
 signals:
     void UpdateFontSize(int size, bool resize);
 
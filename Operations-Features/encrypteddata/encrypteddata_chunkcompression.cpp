@@ -0,0 +1,138 @@
+#include "encrypteddata_chunkcompression.h"
+#include "constants.h"
+#include <QDebug>
+#include <QStringList>
+#include <QtEndian>
+#include <cmath>
+
+namespace ChunkCompression {
+
+// zlib level 6 is the usual speed/ratio sweet spot for 1MB chunks
+static const int COMPRESSION_LEVEL = 6;
+// Same limit the decryption workers apply to encrypted chunks
+static const quint32 MAX_DECOMPRESSED_CHUNK_SIZE = 10 * 1024 * 1024;
+// Only probe the start of the first chunk, enough to be representative
+static const int ENTROPY_SAMPLE_SIZE = 64 * 1024;
+// Above this many bits per byte, data is effectively random and won't shrink
+static const double ENTROPY_THRESHOLD = 7.5;
+
+quint32 encodeChunkHeader(quint32 encryptedSize, bool compressed)
+{
+    quint32 header = encryptedSize & Constants::CHUNK_HEADER_SIZE_MASK;
+    if (compressed) {
+        header |= Constants::CHUNK_HEADER_COMPRESSED_FLAG;
+    }
+    return header;
+}
+
+void decodeChunkHeader(quint32 header, quint32& encryptedSize, bool& compressed)
+{
+    compressed = (header & Constants::CHUNK_HEADER_COMPRESSED_FLAG) != 0;
+    encryptedSize = header & Constants::CHUNK_HEADER_SIZE_MASK;
+}
+
+bool isPrecompressedExtension(const QString& extension)
+{
+    static const QStringList precompressed = {
+        // Images
+        "jpg", "jpeg", "png", "gif", "webp", "heic", "heif", "avif", "jxl",
+        // Video
+        "mp4", "avi", "mkv", "mov", "wmv", "flv", "webm", "m4v", "3gp", "mpg", "mpeg", "ts",
+        // Audio
+        "mp3", "aac", "m4a", "ogg", "opus", "flac", "wma",
+        // Archives
+        "zip", "7z", "rar", "gz", "tgz", "bz2", "xz", "zst", "cab", "jar", "apk",
+        // Office formats are zip containers
+        "docx", "xlsx", "pptx", "odt", "ods", "odp", "epub",
+        "pdf"
+    };
+    return precompressed.contains(extension.toLower());
+}
+
+bool isCompressibleExtension(const QString& extension)
+{
+    static const QStringList compressible = {
+        "txt", "log", "csv", "tsv", "json", "xml", "html", "htm", "md", "rtf", "ini", "cfg", "yaml", "yml",
+        "c", "cpp", "h", "hpp", "py", "js", "java", "cs", "sql",
+        "doc", "xls", "ppt", "tar", "bmp", "wav", "svg"
+    };
+    return compressible.contains(extension.toLower());
+}
+
+double estimateEntropy(const QByteArray& sample)
+{
+    if (sample.isEmpty()) {
+        return 0.0;
+    }
+
+    const int sampleSize = qMin(sample.size(), ENTROPY_SAMPLE_SIZE);
+    quint32 histogram[256] = {0};
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(sample.constData());
+    for (int i = 0; i < sampleSize; ++i) {
+        histogram[data[i]]++;
+    }
+
+    double entropy = 0.0;
+    for (int i = 0; i < 256; ++i) {
+        if (histogram[i] == 0) {
+            continue;
+        }
+        double probability = static_cast<double>(histogram[i]) / sampleSize;
+        entropy -= probability * std::log2(probability);
+    }
+    return entropy;
+}
+
+bool shouldCompressFile(const QString& extension, const QByteArray& firstChunk)
+{
+    if (isPrecompressedExtension(extension)) {
+        return false;
+    }
+    if (isCompressibleExtension(extension)) {
+        return true;
+    }
+
+    double entropy = estimateEntropy(firstChunk);
+    qDebug() << "ChunkCompression: Entropy probe for extension" << extension << ":" << entropy << "bits/byte";
+    return entropy < ENTROPY_THRESHOLD;
+}
+
+QByteArray compressChunk(const QByteArray& plainChunk)
+{
+    if (plainChunk.isEmpty()) {
+        return QByteArray();
+    }
+
+    QByteArray compressed = qCompress(plainChunk, COMPRESSION_LEVEL);
+
+    // Require at least ~6% savings, otherwise the decompression cost isn't worth it
+    if (compressed.isEmpty() || compressed.size() > plainChunk.size() - plainChunk.size() / 16) {
+        return QByteArray();
+    }
+    return compressed;
+}
+
+QByteArray decompressChunk(const QByteArray& compressedChunk)
+{
+    // qCompress output starts with the original size as a 4-byte big-endian integer
+    if (compressedChunk.size() <= 4) {
+        qWarning() << "ChunkCompression: Compressed chunk too small";
+        return QByteArray();
+    }
+
+    // SECURITY: Validate the declared size before inflating to avoid decompression bombs
+    quint32 declaredSize = qFromBigEndian<quint32>(compressedChunk.constData());
+    if (declaredSize == 0 || declaredSize > MAX_DECOMPRESSED_CHUNK_SIZE) {
+        qWarning() << "ChunkCompression: Invalid declared chunk size" << declaredSize;
+        return QByteArray();
+    }
+
+    QByteArray plainChunk = qUncompress(compressedChunk);
+    if (plainChunk.size() != static_cast<int>(declaredSize)) {
+        qWarning() << "ChunkCompression: Decompressed size mismatch, expected" << declaredSize << "got" << plainChunk.size();
+        return QByteArray();
+    }
+    return plainChunk;
+}
+
+} // namespace ChunkCompression
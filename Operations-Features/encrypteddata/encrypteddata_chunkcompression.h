@@ -0,0 +1,34 @@
+#ifndef ENCRYPTEDDATA_CHUNKCOMPRESSION_H
+#define ENCRYPTEDDATA_CHUNKCOMPRESSION_H
+
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+
+// Optional zlib compression of file chunks before encryption.
+// Encrypted files store each chunk as [quint32 header][encrypted chunk]. The low bits
+// of the header hold the encrypted chunk size, the top bit marks a chunk whose plaintext
+// was compressed with qCompress before encryption. Files written before this existed
+// never have the top bit set, so they keep decrypting as raw chunks.
+namespace ChunkCompression {
+
+// Header encoding helpers
+quint32 encodeChunkHeader(quint32 encryptedSize, bool compressed);
+void decodeChunkHeader(quint32 header, quint32& encryptedSize, bool& compressed);
+
+// Decide whether a file is worth compressing.
+// Known media/archive formats are always skipped, known text formats are always compressed,
+// anything else is decided by a byte entropy probe of the first chunk.
+bool isPrecompressedExtension(const QString& extension);
+bool isCompressibleExtension(const QString& extension);
+double estimateEntropy(const QByteArray& sample); // bits per byte, 0.0 - 8.0
+bool shouldCompressFile(const QString& extension, const QByteArray& firstChunk);
+
+// Returns the compressed chunk, or an empty array if compression did not save enough to be worth it
+QByteArray compressChunk(const QByteArray& plainChunk);
+// Returns the original chunk, or an empty array if the data is corrupt or exceeds the chunk limit
+QByteArray decompressChunk(const QByteArray& compressedChunk);
+
+} // namespace ChunkCompression
+
+#endif // ENCRYPTEDDATA_CHUNKCOMPRESSION_H
@@ -3,6 +3,8 @@
 #include "operations_files.h"
 #include "constants.h"
 #include "encrypteddata_fileiconprovider.h"
+#include "encrypteddata_chunkcompression.h"
+#include "encrypteddata_mappedfilereader.h"
 #include <QDir>
 #include <QFileInfo>
 #include <QRandomGenerator>
@@ -132,6 +134,45 @@ static bool canProcessFile(qint64 fileSize, QString& errorMessage)
     return true;
 }
 
+// Read and decrypt the chunk that starts at chunkOffset in an encrypted file.
+// Returns the plaintext chunk, or an empty array if the chunk is truncated or fails authentication.
+// chunkEnd receives the offset right after the chunk.
+// Works on a QFile or a MappedFileReader, both offer the same seek()/read() calls.
+template <typename Reader>
+static QByteArray readEncryptedChunkAt(Reader& file, qint64 chunkOffset, const QByteArray& encryptionKey, qint64& chunkEnd)
+{
+    chunkEnd = -1;
+    if (chunkOffset < Constants::METADATA_RESERVED_SIZE || !file.seek(chunkOffset)) {
+        return QByteArray();
+    }
+
+    quint32 chunkHeader = 0;
+    if (file.read(reinterpret_cast<char*>(&chunkHeader), sizeof(chunkHeader)) != sizeof(chunkHeader)) {
+        return QByteArray();
+    }
+
+    quint32 chunkSize = 0;
+    bool chunkCompressed = false;
+    ChunkCompression::decodeChunkHeader(chunkHeader, chunkSize, chunkCompressed);
+    if (chunkSize == 0 || chunkSize > 10 * 1024 * 1024) {
+        return QByteArray();
+    }
+
+    QByteArray encryptedChunk = file.read(chunkSize);
+    if (encryptedChunk.size() != static_cast<int>(chunkSize)) {
+        return QByteArray();
+    }
+
+    QByteArray chunk = CryptoUtils::Encryption_DecryptBArray(encryptionKey, encryptedChunk);
+    if (!chunk.isEmpty() && chunkCompressed) {
+        chunk = ChunkCompression::decompressChunk(chunk);
+    }
+    if (!chunk.isEmpty()) {
+        chunkEnd = chunkOffset + static_cast<qint64>(sizeof(chunkHeader)) + chunkSize;
+    }
+    return chunk;
+}
+
 // ============================================================================
 // EncryptionWorker Implementation
 // ============================================================================
@@ -143,6 +184,7 @@ EncryptionWorker::EncryptionWorker(const QStringList& sourceFiles, const QString
     , m_encryptionKey(encryptionKey)
     , m_username(username)
     , m_cancelled(0)  // 0 = false, 1 = true for atomic
+    , m_suspended(0)
     , m_metadataManager(std::make_unique<EncryptedFileMetadata>(encryptionKey, username))
 {
     // Thread-safe initialization of containers
@@ -167,6 +209,7 @@ EncryptionWorker::EncryptionWorker(const QString& sourceFile, const QString& tar
     , m_encryptionKey(encryptionKey)
     , m_username(username)
     , m_cancelled(0)  // Use consistent initialization: 0 = false, 1 = true for atomic
+    , m_suspended(0)
     , m_metadataManager(std::make_unique<EncryptedFileMetadata>(encryptionKey, username))
 {
     // Thread-safe initialization of containers
@@ -254,10 +297,19 @@ void EncryptionWorker::doEncryption()
         qint64 totalSize = 0;
         QList<qint64> fileSizes;
 
-        for (const QString& sourceFile : localSourceFiles) {
+        for (int i = 0; i < localSourceFiles.size(); ++i) {
+            const QString& sourceFile = localSourceFiles[i];
+            // Finished before the job was interrupted, the source may be gone by now
+            if (m_journal && m_journal->entry(i).state == JobJournal::EntryState::Completed) {
+                fileSizes.append(0);
+                continue;
+            }
             QFile file(sourceFile);
             if (!file.exists()) {
                 QString errorMsg = QString("Source file does not exist: %1").arg(sourceFile);
+                if (m_journal) {
+                    m_journal->remove();
+                }
                 if (isMultipleFiles) {
                     emit multiFileEncryptionFinished(false, errorMsg, QStringList(), QStringList());
                 } else {
@@ -287,6 +339,19 @@ void EncryptionWorker::doEncryption()
             // Check for cancellation
             // THREAD SAFETY: No mutex needed for atomic check
             if (m_cancelled.loadAcquire() != 0) {
+                if (m_suspended.loadAcquire() != 0) {
+                    // Keep finished targets, the journal picks up from the next file
+                    if (isMultipleFiles) {
+                        emit multiFileEncryptionFinished(false, "Operation was suspended",
+                                                         QStringList(), QStringList());
+                    } else {
+                        emit encryptionFinished(false, "Operation was suspended");
+                    }
+                    return;
+                }
+                if (m_journal) {
+                    m_journal->remove();
+                }
                 // Clean up any partial files created so far
                 for (int i = 0; i < fileIndex; ++i) {
                     if (QFile::exists(localTargetFiles[i])) {
@@ -305,6 +370,12 @@ void EncryptionWorker::doEncryption()
             const QString& sourceFile = localSourceFiles[fileIndex];
             const QString& targetFile = localTargetFiles[fileIndex];
             qint64 currentFileSize = fileSizes[fileIndex];
+
+            // Already encrypted before the job was interrupted
+            if (m_journal && m_journal->entry(fileIndex).state == JobJournal::EntryState::Completed) {
+                successfulFiles.append(QFileInfo(sourceFile).fileName());
+                continue;
+            }
             
             // SECURITY: Check if file can be processed with available memory
             QString memoryErrorMsg;
@@ -312,6 +383,9 @@ void EncryptionWorker::doEncryption()
                 QString fileName = QFileInfo(sourceFile).fileName();
                 failedFiles.append(QString("%1 (%2)").arg(fileName).arg(memoryErrorMsg));
                 processedTotalSize += currentFileSize; // Still count it for progress
+                if (m_journal) {
+                    m_journal->markFailed(fileIndex);
+                }
                 qWarning() << "EncryptionWorker: Skipping file due to memory limit:" << fileName;
                 continue;
             }
@@ -342,132 +416,174 @@ void EncryptionWorker::doEncryption()
                 }
             }
 
+            // Continue a partially written target if the journal has a verified checkpoint for it
             QFile target(targetFile);
-            if (!target.open(QIODevice::WriteOnly)) {
+            qint64 processedFileSize = 0;
+            bool resumed = false;
+            if (m_journal) {
+                if (m_journal->entry(fileIndex).state == JobJournal::EntryState::InProgress) {
+                    resumed = resumeFromJournal(fileIndex, source, target, processedFileSize);
+                }
+                if (!resumed) {
+                    m_journal->markInProgress(fileIndex);
+                }
+            }
+
+            if (!resumed && !target.open(QIODevice::WriteOnly)) {
                 QString fileName = QFileInfo(sourceFile).fileName();
                 failedFiles.append(QString("%1 (failed to create target file)").arg(fileName));
                 source.close();
                 processedTotalSize += currentFileSize;
+                if (m_journal) {
+                    m_journal->markFailed(fileIndex);
+                }
                 continue;
             }
 
-            // UPDATED: Generate thumbnail during encryption with square padding
-            QByteArray thumbnailData;
             QFileInfo sourceInfo(sourceFile);
             QString originalFilename = sourceInfo.fileName();
             QString extension = sourceInfo.suffix().toLower();
 
-            // Generate thumbnail based on file type
-            if (imageExtensions.contains(extension)) {
-                qDebug() << "EncryptionWorker: Generating square thumbnail for image:" << originalFilename;
-                // THREAD SAFETY: Load image directly as QImage (thread-safe)
-                QImage imageThumb;
-                if (imageThumb.load(sourceFile)) {
-                    // Scale to 64x64 with aspect ratio preserved
-                    imageThumb = imageThumb.scaled(64, 64, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+            if (!resumed) {
+                // UPDATED: Generate thumbnail during encryption with square padding
+                QByteArray thumbnailData;
+
+                // Generate thumbnail based on file type
+                if (imageExtensions.contains(extension)) {
+                    qDebug() << "EncryptionWorker: Generating square thumbnail for image:" << originalFilename;
+                    // THREAD SAFETY: Load image directly as QImage (thread-safe)
+                    QImage imageThumb;
+                    if (imageThumb.load(sourceFile)) {
+                        // Scale to 64x64 with aspect ratio preserved
+                        imageThumb = imageThumb.scaled(64, 64, Qt::KeepAspectRatio, Qt::SmoothTransformation);
                     
-                    // Create square thumbnail with padding if needed
-                    if (imageThumb.width() != 64 || imageThumb.height() != 64) {
-                        QImage squareImage(64, 64, QImage::Format_RGB32);
-                        squareImage.fill(Qt::black);
-                        QPainter painter(&squareImage);
-                        int x = (64 - imageThumb.width()) / 2;
-                        int y = (64 - imageThumb.height()) / 2;
-                        painter.drawImage(x, y, imageThumb);
-                        painter.end();
-                        imageThumb = squareImage;
-                    }
-                    
-                    // Convert to QPixmap for compression (safe in worker thread context)
-                    QPixmap pixmapForCompression = QPixmap::fromImage(imageThumb);
-                    thumbnailData = EncryptedFileMetadata::compressThumbnail(pixmapForCompression, 85);
-                    qDebug() << "EncryptionWorker: Generated square image thumbnail, compressed size:" << thumbnailData.size() << "bytes";
-                } else {
-                    qDebug() << "EncryptionWorker: Failed to load image for thumbnail:" << originalFilename;
-                }
-            } else if (videoExtensions.contains(extension)) {
-                qDebug() << "EncryptionWorker: Generating square thumbnail for video:" << originalFilename;
-                // Check if we have pre-extracted video thumbnail
-                if (m_videoThumbnailImages.contains(sourceFile)) {
-                    QImage videoThumbnail = m_videoThumbnailImages[sourceFile];
-                    if (!videoThumbnail.isNull()) {
-                        // THREAD SAFETY: Work with QImage instead of QPixmap
-                        // Create square thumbnail with black padding for video
-                        QImage scaledThumb = videoThumbnail.scaled(64, 64, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-                        
-                        // Add padding if needed
-                        if (scaledThumb.width() != 64 || scaledThumb.height() != 64) {
+                        // Create square thumbnail with padding if needed
+                        if (imageThumb.width() != 64 || imageThumb.height() != 64) {
                             QImage squareImage(64, 64, QImage::Format_RGB32);
                             squareImage.fill(Qt::black);
                             QPainter painter(&squareImage);
-                            int x = (64 - scaledThumb.width()) / 2;
-                            int y = (64 - scaledThumb.height()) / 2;
-                            painter.drawImage(x, y, scaledThumb);
+                            int x = (64 - imageThumb.width()) / 2;
+                            int y = (64 - imageThumb.height()) / 2;
+                            painter.drawImage(x, y, imageThumb);
                             painter.end();
-                            scaledThumb = squareImage;
+                            imageThumb = squareImage;
                         }
-                        
-                        // Convert to QPixmap for compression
-                        QPixmap pixmapForCompression = QPixmap::fromImage(scaledThumb);
+                    
+                        // Convert to QPixmap for compression (safe in worker thread context)
+                        QPixmap pixmapForCompression = QPixmap::fromImage(imageThumb);
                         thumbnailData = EncryptedFileMetadata::compressThumbnail(pixmapForCompression, 85);
-                        qDebug() << "EncryptionWorker: Using pre-extracted video thumbnail with square padding, compressed size:" << thumbnailData.size() << "bytes";
+                        qDebug() << "EncryptionWorker: Generated square image thumbnail, compressed size:" << thumbnailData.size() << "bytes";
+                    } else {
+                        qDebug() << "EncryptionWorker: Failed to load image for thumbnail:" << originalFilename;
+                    }
+                } else if (videoExtensions.contains(extension)) {
+                    qDebug() << "EncryptionWorker: Generating square thumbnail for video:" << originalFilename;
+                    // Check if we have pre-extracted video thumbnail
+                    if (m_videoThumbnailImages.contains(sourceFile)) {
+                        QImage videoThumbnail = m_videoThumbnailImages[sourceFile];
+                        if (!videoThumbnail.isNull()) {
+                            // THREAD SAFETY: Work with QImage instead of QPixmap
+                            // Create square thumbnail with black padding for video
+                            QImage scaledThumb = videoThumbnail.scaled(64, 64, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+                        
+                            // Add padding if needed
+                            if (scaledThumb.width() != 64 || scaledThumb.height() != 64) {
+                                QImage squareImage(64, 64, QImage::Format_RGB32);
+                                squareImage.fill(Qt::black);
+                                QPainter painter(&squareImage);
+                                int x = (64 - scaledThumb.width()) / 2;
+                                int y = (64 - scaledThumb.height()) / 2;
+                                painter.drawImage(x, y, scaledThumb);
+                                painter.end();
+                                scaledThumb = squareImage;
+                            }
+                        
+                            // Convert to QPixmap for compression
+                            QPixmap pixmapForCompression = QPixmap::fromImage(scaledThumb);
+                            thumbnailData = EncryptedFileMetadata::compressThumbnail(pixmapForCompression, 85);
+                            qDebug() << "EncryptionWorker: Using pre-extracted video thumbnail with square padding, compressed size:" << thumbnailData.size() << "bytes";
+                        }
+                    } else {
+                        qDebug() << "EncryptionWorker: No pre-extracted video thumbnail available for:" << originalFilename;
                     }
-                } else {
-                    qDebug() << "EncryptionWorker: No pre-extracted video thumbnail available for:" << originalFilename;
                 }
-            }
 
-            // Create metadata with filename and thumbnail and encryption datetime
-            EncryptedFileMetadata::FileMetadata metadata(originalFilename, "", QStringList(), thumbnailData, encryptionDateTime);
+                // Create metadata with filename and thumbnail and encryption datetime
+                EncryptedFileMetadata::FileMetadata metadata(originalFilename, "", QStringList(), thumbnailData, encryptionDateTime);
 
-            // Create fixed-size encrypted metadata block (40KB) - this includes the size header internally
-            QByteArray fixedSizeMetadata = m_metadataManager->createEncryptedMetadataChunk(metadata);
-            if (fixedSizeMetadata.isEmpty()) {
-                QString fileName = QFileInfo(sourceFile).fileName();
-                failedFiles.append(QString("%1 (failed to create metadata)").arg(fileName));
-                source.close();
-                target.close();
-                processedTotalSize += currentFileSize;
-                continue;
-            }
+                // Create fixed-size encrypted metadata block (40KB) - this includes the size header internally
+                QByteArray fixedSizeMetadata = m_metadataManager->createEncryptedMetadataChunk(metadata);
+                if (fixedSizeMetadata.isEmpty()) {
+                    QString fileName = QFileInfo(sourceFile).fileName();
+                    failedFiles.append(QString("%1 (failed to create metadata)").arg(fileName));
+                    source.close();
+                    target.close();
+                    processedTotalSize += currentFileSize;
+                    continue;
+                }
 
-            // Verify fixed-size metadata block
-            if (fixedSizeMetadata.size() != Constants::METADATA_RESERVED_SIZE) {
-                QString fileName = QFileInfo(sourceFile).fileName();
-                failedFiles.append(QString("%1 (invalid metadata size %2, expected %3)")
-                                       .arg(fileName).arg(fixedSizeMetadata.size()).arg(Constants::METADATA_RESERVED_SIZE));
-                source.close();
-                target.close();
-                processedTotalSize += currentFileSize;
-                continue;
-            }
+                // Verify fixed-size metadata block
+                if (fixedSizeMetadata.size() != Constants::METADATA_RESERVED_SIZE) {
+                    QString fileName = QFileInfo(sourceFile).fileName();
+                    failedFiles.append(QString("%1 (invalid metadata size %2, expected %3)")
+                                           .arg(fileName).arg(fixedSizeMetadata.size()).arg(Constants::METADATA_RESERVED_SIZE));
+                    source.close();
+                    target.close();
+                    processedTotalSize += currentFileSize;
+                    continue;
+                }
 
-            qDebug() << "EncryptionWorker: About to write" << fixedSizeMetadata.size() << "bytes of metadata with square thumbnail";
+                qDebug() << "EncryptionWorker: About to write" << fixedSizeMetadata.size() << "bytes of metadata with square thumbnail";
 
-            // Write the complete fixed-size metadata block (no additional headers needed)
-            qint64 bytesWritten = target.write(fixedSizeMetadata);
-            if (bytesWritten != fixedSizeMetadata.size()) {
-                QString fileName = QFileInfo(sourceFile).fileName();
-                failedFiles.append(QString("%1 (failed to write metadata, wrote %2 of %3 bytes)")
-                                       .arg(fileName).arg(bytesWritten).arg(fixedSizeMetadata.size()));
-                source.close();
-                target.close();
-                processedTotalSize += currentFileSize;
-                continue;
-            }
+                // Write the complete fixed-size metadata block (no additional headers needed)
+                qint64 bytesWritten = target.write(fixedSizeMetadata);
+                if (bytesWritten != fixedSizeMetadata.size()) {
+                    QString fileName = QFileInfo(sourceFile).fileName();
+                    failedFiles.append(QString("%1 (failed to write metadata, wrote %2 of %3 bytes)")
+                                           .arg(fileName).arg(bytesWritten).arg(fixedSizeMetadata.size()));
+                    source.close();
+                    target.close();
+                    processedTotalSize += currentFileSize;
+                    continue;
+                }
 
-            qDebug() << "EncryptionWorker: Successfully wrote" << bytesWritten << "bytes of metadata with square thumbnail";
+                qDebug() << "EncryptionWorker: Successfully wrote" << bytesWritten << "bytes of metadata with square thumbnail";
+            }
 
             // Encrypt and write file content in chunks (UPDATED with file progress)
             const qint64 chunkSize = 1024 * 1024; // 1MB chunks
             QByteArray buffer;
-            qint64 processedFileSize = 0;
             bool fileSuccess = true;
+            bool compressionDecided = false;
+            bool compressFile = false;
+            int compressedChunks = 0;
+            qint64 lastChunkOffset = resumed ? m_journal->entry(fileIndex).lastChunkOffset : -1;
+            processedTotalSize += processedFileSize;
 
-            while (!source.atEnd() && fileSuccess) {
+            // Chunks point straight into the mapped source when possible
+            MappedFileReader sourceReader(source);
+
+            while (!sourceReader.atEnd() && fileSuccess) {
                 // Check for cancellation
                 // THREAD SAFETY: No mutex needed for atomic check
                 if (m_cancelled.loadAcquire() != 0) {
+                    if (m_suspended.loadAcquire() != 0) {
+                        // Record the last complete chunk and keep the partial target for resuming
+                        target.flush();
+                        m_journal->checkpoint(fileIndex, sourceReader.pos(), target.pos(), lastChunkOffset, true);
+                        target.close();
+                        source.close();
+                        if (isMultipleFiles) {
+                            emit multiFileEncryptionFinished(false, "Operation was suspended",
+                                                             QStringList(), QStringList());
+                        } else {
+                            emit encryptionFinished(false, "Operation was suspended");
+                        }
+                        return;
+                    }
+                    if (m_journal) {
+                        m_journal->remove();
+                    }
                     target.close();
                     source.close();
                     QFile::remove(targetFile); // Clean up partial file
@@ -487,12 +603,32 @@ void EncryptionWorker::doEncryption()
                     return;
                 }
 
-                // Read chunk
-                buffer = source.read(chunkSize);
+                // Read chunk (only valid until the next read when mapped)
+                buffer = sourceReader.read(chunkSize);
                 if (buffer.isEmpty()) {
                     break;
                 }
 
+                // Decide once per file, based on file type or the first chunk's entropy
+                if (!compressionDecided) {
+                    compressFile = ChunkCompression::shouldCompressFile(extension, buffer);
+                    compressionDecided = true;
+                    qDebug() << "EncryptionWorker: Chunk compression" << (compressFile ? "enabled" : "disabled")
+                             << "for:" << originalFilename;
+                }
+
+                // Compress chunk if worthwhile, otherwise keep it raw
+                const qint64 plainChunkSize = buffer.size();
+                bool chunkCompressed = false;
+                if (compressFile) {
+                    QByteArray compressedBuffer = ChunkCompression::compressChunk(buffer);
+                    if (!compressedBuffer.isEmpty()) {
+                        buffer = compressedBuffer;
+                        chunkCompressed = true;
+                        compressedChunks++;
+                    }
+                }
+
                 // Encrypt chunk
                 QByteArray encryptedChunk = CryptoUtils::Encryption_EncryptBArray(
                     m_encryptionKey, buffer, m_username);
@@ -502,13 +638,25 @@ void EncryptionWorker::doEncryption()
                     break;
                 }
 
-                // Write encrypted chunk size and data
-                quint32 chunkDataSize = static_cast<quint32>(encryptedChunk.size());
-                target.write(reinterpret_cast<const char*>(&chunkDataSize), sizeof(chunkDataSize));
-                target.write(encryptedChunk);
+                // Write chunk header (size + compression flag) and data
+                const qint64 chunkOffset = target.pos();
+                quint32 chunkHeader = ChunkCompression::encodeChunkHeader(
+                    static_cast<quint32>(encryptedChunk.size()), chunkCompressed);
+                if (target.write(reinterpret_cast<const char*>(&chunkHeader), sizeof(chunkHeader)) != sizeof(chunkHeader) ||
+                    target.write(encryptedChunk) != encryptedChunk.size()) {
+                    fileSuccess = false;
+                    break;
+                }
+                lastChunkOffset = chunkOffset;
+
+                processedFileSize += plainChunkSize;
+                processedTotalSize += plainChunkSize;
 
-                processedFileSize += buffer.size();
-                processedTotalSize += buffer.size();
+                // Periodically record the last chunk that reached the disk
+                if (m_journal && m_journal->isCheckpointDue()) {
+                    target.flush();
+                    m_journal->checkpoint(fileIndex, sourceReader.pos(), target.pos(), lastChunkOffset);
+                }
 
                 // Update overall progress
                 int overallPercentage = static_cast<int>((processedTotalSize * 100) / totalSize);
@@ -527,11 +675,18 @@ void EncryptionWorker::doEncryption()
 
             if (fileSuccess) {
                 successfulFiles.append(QFileInfo(sourceFile).fileName());
-                qDebug() << "EncryptionWorker: Successfully encrypted file with embedded square thumbnail:" << originalFilename;
+                qDebug() << "EncryptionWorker: Successfully encrypted file with embedded square thumbnail:" << originalFilename
+                         << "compressed chunks:" << compressedChunks << (resumed ? "(resumed)" : "");
+                if (m_journal) {
+                    m_journal->markCompleted(fileIndex);
+                }
             } else {
                 QString fileName = QFileInfo(sourceFile).fileName();
                 failedFiles.append(QString("%1 (encryption failed)").arg(fileName));
                 QFile::remove(targetFile); // Clean up failed file
+                if (m_journal) {
+                    m_journal->markFailed(fileIndex);
+                }
             }
 
             // Ensure we account for any remaining bytes in the progress
@@ -540,6 +695,11 @@ void EncryptionWorker::doEncryption()
             }
         }
 
+        // Job is done, nothing left to resume
+        if (m_journal) {
+            m_journal->remove();
+        }
+
         // Emit appropriate completion signal based on operation type
         if (isMultipleFiles) {
             // Multiple files - use new signal
@@ -602,6 +762,51 @@ QStringList EncryptionWorker::getTargetFiles() const
     return m_targetFiles;
 }
 
+void EncryptionWorker::setJournal(std::shared_ptr<JobJournal> journal)
+{
+    m_journal = journal;
+}
+
+void EncryptionWorker::suspend()
+{
+    if (!m_journal) {
+        cancel();
+        return;
+    }
+    qDebug() << "EncryptionWorker: Suspend requested, progress will be kept in the job journal";
+    m_suspended.storeRelease(1);
+    m_cancelled.storeRelease(1);
+}
+
+bool EncryptionWorker::resumeFromJournal(int fileIndex, QFile& source, QFile& target, qint64& processedFileSize)
+{
+    const JobJournal::Entry entry = m_journal->entry(fileIndex);
+    if (entry.lastChunkOffset < 0 || !target.exists() || !target.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+
+    // Verify the tail: the last checkpointed chunk must decrypt, end exactly at the checkpoint,
+    // and match the source bytes it was made from
+    qint64 chunkEnd = -1;
+    QByteArray lastChunk = readEncryptedChunkAt(target, entry.lastChunkOffset, m_encryptionKey, chunkEnd);
+    bool tailValid = !lastChunk.isEmpty() && chunkEnd == entry.targetOffset &&
+                     entry.sourceOffset <= source.size() && entry.sourceOffset >= lastChunk.size() &&
+                     source.seek(entry.sourceOffset - lastChunk.size()) && source.read(lastChunk.size()) == lastChunk;
+
+    // Drop anything written after the checkpoint and continue from there
+    if (!tailValid || !target.resize(entry.targetOffset) ||
+        !target.seek(entry.targetOffset) || !source.seek(entry.sourceOffset)) {
+        qWarning() << "EncryptionWorker: Checkpoint verification failed, restarting file:" << QFileInfo(source.fileName()).fileName();
+        target.close();
+        source.seek(0);
+        return false;
+    }
+
+    processedFileSize = entry.sourceOffset;
+    qDebug() << "EncryptionWorker: Resuming" << QFileInfo(source.fileName()).fileName() << "at offset" << entry.sourceOffset;
+    return true;
+}
+
 void EncryptionWorker::cancel()
 {
     qDebug() << "EncryptionWorker: Cancellation requested from thread" << QThread::currentThreadId();
@@ -718,7 +923,10 @@ void DecryptionWorker::doDecryption()
         }
 
         // Decrypt file content chunk by chunk
-        while (!sourceFile.atEnd()) {
+        // Ciphertext chunks point straight into the mapped source when possible
+        MappedFileReader sourceReader(sourceFile);
+
+        while (!sourceReader.atEnd()) {
             // Check for cancellation
             // THREAD SAFETY: No mutex needed for atomic check
             if (m_cancelled.loadAcquire() != 0) {
@@ -730,7 +938,7 @@ void DecryptionWorker::doDecryption()
 
             // Read chunk size
             quint32 chunkSize = 0;
-            qint64 bytesRead = sourceFile.read(reinterpret_cast<char*>(&chunkSize), sizeof(chunkSize));
+            qint64 bytesRead = sourceReader.read(reinterpret_cast<char*>(&chunkSize), sizeof(chunkSize));
             if (bytesRead == 0) {
                 break; // End of file
             }
@@ -741,6 +949,10 @@ void DecryptionWorker::doDecryption()
                 return;
             }
 
+            // Split header into encrypted size and compression flag
+            bool chunkCompressed = false;
+            ChunkCompression::decodeChunkHeader(chunkSize, chunkSize, chunkCompressed);
+
             if (chunkSize == 0 || chunkSize > 10 * 1024 * 1024) { // Max 10MB per chunk
                 targetFile.close();
                 QFile::remove(m_targetFile);
@@ -749,7 +961,7 @@ void DecryptionWorker::doDecryption()
             }
 
             // Read encrypted chunk data
-            QByteArray encryptedChunk = sourceFile.read(chunkSize);
+            QByteArray encryptedChunk = sourceReader.read(chunkSize);
             if (encryptedChunk.size() != static_cast<int>(chunkSize)) {
                 targetFile.close();
                 QFile::remove(m_targetFile);
@@ -768,6 +980,17 @@ void DecryptionWorker::doDecryption()
                 return;
             }
 
+            // Decompress chunk if it was compressed before encryption
+            if (chunkCompressed) {
+                decryptedChunk = ChunkCompression::decompressChunk(decryptedChunk);
+                if (decryptedChunk.isEmpty()) {
+                    targetFile.close();
+                    QFile::remove(m_targetFile);
+                    emit decryptionFinished(false, "Decompression failed for file chunk");
+                    return;
+                }
+            }
+
             // Write decrypted chunk
             if (targetFile.write(decryptedChunk) != decryptedChunk.size()) {
                 targetFile.close();
@@ -943,7 +1166,10 @@ void TempDecryptionWorker::doDecryption()
         }
 
         // Decrypt file content chunk by chunk
-        while (!sourceFile.atEnd()) {
+        // Ciphertext chunks point straight into the mapped source when possible
+        MappedFileReader sourceReader(sourceFile);
+
+        while (!sourceReader.atEnd()) {
             // Check for cancellation
             // THREAD SAFETY: No mutex needed for atomic check
             if (m_cancelled.loadAcquire() != 0) {
@@ -955,7 +1181,7 @@ void TempDecryptionWorker::doDecryption()
 
             // Read chunk size
             quint32 chunkSize = 0;
-            qint64 bytesRead = sourceFile.read(reinterpret_cast<char*>(&chunkSize), sizeof(chunkSize));
+            qint64 bytesRead = sourceReader.read(reinterpret_cast<char*>(&chunkSize), sizeof(chunkSize));
             if (bytesRead == 0) {
                 break; // End of file
             }
@@ -966,6 +1192,10 @@ void TempDecryptionWorker::doDecryption()
                 return;
             }
 
+            // Split header into encrypted size and compression flag
+            bool chunkCompressed = false;
+            ChunkCompression::decodeChunkHeader(chunkSize, chunkSize, chunkCompressed);
+
             if (chunkSize == 0 || chunkSize > 10 * 1024 * 1024) { // Max 10MB per chunk
                 targetFile.close();
                 QFile::remove(m_targetFile);
@@ -974,7 +1204,7 @@ void TempDecryptionWorker::doDecryption()
             }
 
             // Read encrypted chunk data
-            QByteArray encryptedChunk = sourceFile.read(chunkSize);
+            QByteArray encryptedChunk = sourceReader.read(chunkSize);
             if (encryptedChunk.size() != static_cast<int>(chunkSize)) {
                 targetFile.close();
                 QFile::remove(m_targetFile);
@@ -993,6 +1223,17 @@ void TempDecryptionWorker::doDecryption()
                 return;
             }
 
+            // Decompress chunk if it was compressed before encryption
+            if (chunkCompressed) {
+                decryptedChunk = ChunkCompression::decompressChunk(decryptedChunk);
+                if (decryptedChunk.isEmpty()) {
+                    targetFile.close();
+                    QFile::remove(m_targetFile);
+                    emit decryptionFinished(false, "Decompression failed for file chunk");
+                    return;
+                }
+            }
+
             // Write decrypted chunk
             if (targetFile.write(decryptedChunk) != decryptedChunk.size()) {
                 targetFile.close();
@@ -1064,6 +1305,193 @@ void TempDecryptionWorker::cancel()
     }
 }
 
+// ============================================================================
+// MemoryDecryptionWorker Implementation
+// ============================================================================
+
+MemoryDecryptionWorker::MemoryDecryptionWorker(const QString& sourceFile, const QByteArray& encryptionKey,
+                                               qint64 maxPlainSize)
+    : QObject(nullptr)  // No parent - will be moved to thread
+    , m_sourceFile(sourceFile)
+    , m_maxPlainSize(maxPlainSize)
+    , m_limitExceeded(0)
+    , m_encryptionKey(encryptionKey)
+    , m_cancelled(0)  // 0 = false, 1 = true for atomic
+{
+    qDebug() << "MemoryDecryptionWorker: Constructor - creating worker for in-memory decryption";
+}
+
+MemoryDecryptionWorker::~MemoryDecryptionWorker()
+{
+    qDebug() << "MemoryDecryptionWorker: Destructor called in thread" << QThread::currentThreadId();
+
+    cancel();
+
+    // SECURITY: Clear sensitive data
+    if (!m_encryptionKey.isEmpty()) {
+        volatile char* keyData = const_cast<volatile char*>(m_encryptionKey.data());
+        std::memset(const_cast<char*>(keyData), 0, m_encryptionKey.size());
+        m_encryptionKey.clear();
+    }
+    clearDecryptedData();
+}
+
+void MemoryDecryptionWorker::clearDecryptedData()
+{
+    QMutexLocker locker(&m_memberMutex);
+    if (!m_decryptedData.isEmpty()) {
+        volatile char* plainData = const_cast<volatile char*>(m_decryptedData.data());
+        std::memset(const_cast<char*>(plainData), 0, m_decryptedData.size());
+        m_decryptedData.clear();
+    }
+}
+
+void MemoryDecryptionWorker::doDecryption()
+{
+    qDebug() << "MemoryDecryptionWorker: doDecryption() started in thread" << QThread::currentThreadId();
+
+    // Safety check - ensure we're not in the main thread
+    if (QThread::currentThread() == QApplication::instance()->thread()) {
+        qCritical() << "MemoryDecryptionWorker: CRITICAL ERROR - Running in main thread! Aborting operation.";
+        emit decryptionFinished(false, "Internal error: Worker running in main thread");
+        return;
+    }
+
+    try {
+        QString errorMessage;
+        bool limitExceeded = false;
+        QByteArray plainData = decryptFileToMemory(getSourceFile(), m_encryptionKey, m_cancelled, errorMessage,
+                                                   m_maxPlainSize, &limitExceeded,
+                                                   [this](int percentage) { emit progressUpdated(percentage); });
+        if (limitExceeded) {
+            m_limitExceeded.storeRelease(1);
+        }
+        if (plainData.isEmpty() && !errorMessage.isEmpty()) {
+            emit decryptionFinished(false, errorMessage);
+            return;
+        }
+
+        {
+            QMutexLocker locker(&m_memberMutex);
+            m_decryptedData = plainData;
+        }
+
+        qDebug() << "MemoryDecryptionWorker: Decrypted" << plainData.size() << "bytes into memory";
+        emit decryptionFinished(true);
+
+    } catch (const std::exception& e) {
+        emit decryptionFinished(false, QString("Decryption error: %1").arg(e.what()));
+    } catch (...) {
+        emit decryptionFinished(false, "Unknown decryption error occurred");
+    }
+}
+
+QByteArray MemoryDecryptionWorker::decryptFileToMemory(const QString& sourceFilePath, const QByteArray& encryptionKey,
+                                                       const QAtomicInt& cancelled, QString& errorMessage,
+                                                       qint64 maxPlainSize, bool* limitExceeded,
+                                                       const std::function<void(int)>& progressCallback)
+{
+    errorMessage.clear();
+    if (limitExceeded) {
+        *limitExceeded = false;
+    }
+    if (maxPlainSize <= 0 || maxPlainSize > MAX_IN_MEMORY_SIZE) {
+        maxPlainSize = MAX_IN_MEMORY_SIZE;
+    }
+
+    QFile sourceFile(sourceFilePath);
+    if (!sourceFile.open(QIODevice::ReadOnly)) {
+        errorMessage = "Failed to open encrypted file for reading";
+        return QByteArray();
+    }
+
+    qint64 totalSize = sourceFile.size();
+
+    // SECURITY: Check if file can be processed with available memory
+    if (!canProcessFile(totalSize, errorMessage)) {
+        qWarning() << "MemoryDecryptionWorker: File too large for available memory:" << sourceFilePath;
+        return QByteArray();
+    }
+
+    if (totalSize < Constants::METADATA_RESERVED_SIZE) {
+        errorMessage = "Encrypted file is too small";
+        return QByteArray();
+    }
+
+    // Uncompressed chunks are never larger than their encrypted form, so this covers most files in
+    // one allocation. Compressed ones grow past it, which is what the budget below is for.
+    QByteArray plainData;
+    plainData.reserve(static_cast<int>(qMin(totalSize - Constants::METADATA_RESERVED_SIZE, maxPlainSize)));
+
+    MappedFileReader sourceReader(sourceFile);
+    qint64 chunkOffset = Constants::METADATA_RESERVED_SIZE;
+    while (chunkOffset < totalSize) {
+        // THREAD SAFETY: No mutex needed for atomic check
+        if (cancelled.loadAcquire() != 0) {
+            plainData.fill('\0');
+            errorMessage = "Operation was cancelled";
+            return QByteArray();
+        }
+
+        qint64 chunkEnd = -1;
+        QByteArray decryptedChunk = readEncryptedChunkAt(sourceReader, chunkOffset, encryptionKey, chunkEnd);
+        if (decryptedChunk.isEmpty()) {
+            plainData.fill('\0');
+            errorMessage = "Decryption failed for file chunk";
+            return QByteArray();
+        }
+
+        if (plainData.size() + static_cast<qint64>(decryptedChunk.size()) > maxPlainSize) {
+            decryptedChunk.fill('\0');
+            plainData.fill('\0');
+            if (limitExceeded) {
+                *limitExceeded = true;
+            }
+            errorMessage = "Decrypted file is too large to hold in memory";
+            qDebug() << "MemoryDecryptionWorker: Plaintext exceeds" << maxPlainSize << "bytes:" << sourceFilePath;
+            return QByteArray();
+        }
+
+        plainData.append(decryptedChunk);
+        decryptedChunk.fill('\0');
+        chunkOffset = chunkEnd;
+
+        if (progressCallback) {
+            progressCallback(static_cast<int>((chunkOffset * 100) / totalSize));
+        }
+
+        QThread::yieldCurrentThread();
+    }
+
+    return plainData;
+}
+
+QString MemoryDecryptionWorker::getSourceFile() const
+{
+    QMutexLocker locker(&m_memberMutex);
+    return m_sourceFile;
+}
+
+bool MemoryDecryptionWorker::plainSizeLimitExceeded() const
+{
+    return m_limitExceeded.loadAcquire() != 0;
+}
+
+QByteArray MemoryDecryptionWorker::takeDecryptedData()
+{
+    QMutexLocker locker(&m_memberMutex);
+    QByteArray data;
+    data.swap(m_decryptedData);
+    return data;
+}
+
+void MemoryDecryptionWorker::cancel()
+{
+    qDebug() << "MemoryDecryptionWorker: Cancellation requested from thread" << QThread::currentThreadId();
+    // THREAD SAFETY: Use only atomic operation, no mutex needed
+    m_cancelled.fetchAndStoreOrdered(1);
+}
+
 // ============================================================================
 // BatchDecryptionWorker Implementation
 // ============================================================================
@@ -1073,6 +1501,7 @@ BatchDecryptionWorker::BatchDecryptionWorker(const QList<FileExportInfo>& fileIn
     : QObject(nullptr)  // No parent - will be moved to thread
     , m_encryptionKey(encryptionKey)
     , m_cancelled(0)  // 0 = false, 1 = true for atomic
+    , m_suspended(0)
     , m_metadataManager(std::make_unique<EncryptedFileMetadata>(encryptionKey, QString()))
 {
     // Thread-safe initialization
@@ -1144,6 +1573,14 @@ void BatchDecryptionWorker::doDecryption()
             // Check for cancellation
             // THREAD SAFETY: No mutex needed for atomic check
             if (m_cancelled.loadAcquire() != 0) {
+                if (m_suspended.loadAcquire() != 0) {
+                    emit batchDecryptionFinished(false, "Operation was suspended",
+                                                 successfulFiles, failedFiles);
+                    return;
+                }
+                if (m_journal) {
+                    m_journal->remove();
+                }
                 emit batchDecryptionFinished(false, "Operation was cancelled",
                                              successfulFiles, failedFiles);
                 return;
@@ -1151,18 +1588,38 @@ void BatchDecryptionWorker::doDecryption()
 
             const FileExportInfo& fileInfo = localFileInfos[i];
 
+            // Already exported before the job was interrupted
+            if (m_journal && m_journal->entry(i).state == JobJournal::EntryState::Completed) {
+                successfulFiles.append(fileInfo.originalFilename);
+                currentTotalProcessed += fileInfo.fileSize;
+                continue;
+            }
+
             // Update progress
             emit fileStarted(i + 1, localFileInfos.size(), fileInfo.originalFilename);
 
             // Decrypt single file
-            bool success = decryptSingleFile(fileInfo, currentTotalProcessed, totalSize);
+            bool success = decryptSingleFile(fileInfo, i, currentTotalProcessed, totalSize);
+
+            if (!success && m_suspended.loadAcquire() != 0) {
+                // Partial export stays on disk, the journal already holds its checkpoint
+                emit batchDecryptionFinished(false, "Operation was suspended",
+                                             successfulFiles, failedFiles);
+                return;
+            }
 
             if (success) {
                 successfulFiles.append(fileInfo.originalFilename);
                 qDebug() << "BatchDecryptionWorker: Successfully decrypted:" << fileInfo.originalFilename;
+                if (m_journal) {
+                    m_journal->markCompleted(i);
+                }
             } else {
                 failedFiles.append(fileInfo.originalFilename);
                 qDebug() << "BatchDecryptionWorker: Failed to decrypt:" << fileInfo.originalFilename;
+                if (m_journal) {
+                    m_journal->markFailed(i);
+                }
             }
 
             currentTotalProcessed += fileInfo.fileSize;
@@ -1172,6 +1629,11 @@ void BatchDecryptionWorker::doDecryption()
             emit overallProgressUpdated(overallPercentage);
         }
 
+        // Job is done, nothing left to resume
+        if (m_journal) {
+            m_journal->remove();
+        }
+
         // Emit completion
         bool overallSuccess = !successfulFiles.isEmpty();
         QString resultMessage;
@@ -1198,7 +1660,7 @@ void BatchDecryptionWorker::doDecryption()
     }
 }
 
-bool BatchDecryptionWorker::decryptSingleFile(const FileExportInfo& fileInfo,
+bool BatchDecryptionWorker::decryptSingleFile(const FileExportInfo& fileInfo, int fileIndex,
                                                qint64 currentTotalProcessed, qint64 totalSize)
 {
     try {
@@ -1235,19 +1697,42 @@ bool BatchDecryptionWorker::decryptSingleFile(const FileExportInfo& fileInfo,
             }
         }
 
+        // Continue a partially exported file if the journal has a verified checkpoint for it
         QFile targetFile(fileInfo.targetFile);
-        if (!targetFile.open(QIODevice::WriteOnly)) {
+        qint64 processedFileSize = 0;
+        bool resumed = false;
+        if (m_journal) {
+            if (m_journal->entry(fileIndex).state == JobJournal::EntryState::InProgress) {
+                resumed = resumeFromJournal(fileIndex, sourceFile, targetFile, processedFileSize);
+            }
+            if (!resumed) {
+                m_journal->markInProgress(fileIndex);
+            }
+        }
+
+        if (!resumed && !targetFile.open(QIODevice::WriteOnly)) {
             sourceFile.close();
             qDebug() << "BatchDecryptionWorker: Failed to create target file:" << fileInfo.targetFile;
             return false;
         }
 
         // Decrypt file content chunk by chunk
-        qint64 processedFileSize = 0;
-        while (!sourceFile.atEnd()) {
+        qint64 lastChunkOffset = resumed ? m_journal->entry(fileIndex).lastChunkOffset : -1;
+        // Ciphertext chunks point straight into the mapped source when possible
+        MappedFileReader sourceReader(sourceFile);
+
+        while (!sourceReader.atEnd()) {
             // Check for cancellation
             // THREAD SAFETY: No mutex needed for atomic check
             if (m_cancelled.loadAcquire() != 0) {
+                if (m_suspended.loadAcquire() != 0) {
+                    // Record the last complete chunk and keep the partial export for resuming
+                    targetFile.flush();
+                    m_journal->checkpoint(fileIndex, sourceReader.pos(), targetFile.pos(), lastChunkOffset, true);
+                    targetFile.close();
+                    sourceFile.close();
+                    return false;
+                }
                 targetFile.close();
                 QFile::remove(fileInfo.targetFile);
                 sourceFile.close();
@@ -1255,8 +1740,9 @@ bool BatchDecryptionWorker::decryptSingleFile(const FileExportInfo& fileInfo,
             }
 
             // Read chunk size
+            const qint64 chunkOffset = sourceReader.pos();
             quint32 chunkSize = 0;
-            qint64 bytesRead = sourceFile.read(reinterpret_cast<char*>(&chunkSize), sizeof(chunkSize));
+            qint64 bytesRead = sourceReader.read(reinterpret_cast<char*>(&chunkSize), sizeof(chunkSize));
             if (bytesRead == 0) {
                 break; // End of file
             }
@@ -1267,6 +1753,10 @@ bool BatchDecryptionWorker::decryptSingleFile(const FileExportInfo& fileInfo,
                 return false;
             }
 
+            // Split header into encrypted size and compression flag
+            bool chunkCompressed = false;
+            ChunkCompression::decodeChunkHeader(chunkSize, chunkSize, chunkCompressed);
+
             if (chunkSize == 0 || chunkSize > 10 * 1024 * 1024) { // Max 10MB per chunk
                 targetFile.close();
                 QFile::remove(fileInfo.targetFile);
@@ -1275,7 +1765,7 @@ bool BatchDecryptionWorker::decryptSingleFile(const FileExportInfo& fileInfo,
             }
 
             // Read encrypted chunk data
-            QByteArray encryptedChunk = sourceFile.read(chunkSize);
+            QByteArray encryptedChunk = sourceReader.read(chunkSize);
             if (encryptedChunk.size() != static_cast<int>(chunkSize)) {
                 targetFile.close();
                 QFile::remove(fileInfo.targetFile);
@@ -1294,6 +1784,17 @@ bool BatchDecryptionWorker::decryptSingleFile(const FileExportInfo& fileInfo,
                 return false;
             }
 
+            // Decompress chunk if it was compressed before encryption
+            if (chunkCompressed) {
+                decryptedChunk = ChunkCompression::decompressChunk(decryptedChunk);
+                if (decryptedChunk.isEmpty()) {
+                    targetFile.close();
+                    QFile::remove(fileInfo.targetFile);
+                    sourceFile.close();
+                    return false;
+                }
+            }
+
             // Write decrypted chunk
             if (targetFile.write(decryptedChunk) != decryptedChunk.size()) {
                 targetFile.close();
@@ -1302,7 +1803,17 @@ bool BatchDecryptionWorker::decryptSingleFile(const FileExportInfo& fileInfo,
                 return false;
             }
 
-            processedFileSize += decryptedChunk.size();
+            lastChunkOffset = chunkOffset;
+
+            // Periodically record the last chunk that reached the disk
+            if (m_journal && m_journal->isCheckpointDue()) {
+                targetFile.flush();
+                m_journal->checkpoint(fileIndex, sourceReader.pos(), targetFile.pos(), lastChunkOffset);
+            }
+
+            // Track progress in stored bytes, fileSize is the encrypted file size and
+            // compressed chunks decrypt to more data than they occupy on disk
+            processedFileSize += sizeof(chunkSize) + chunkSize;
 
             // Update file progress
             int filePercentage = static_cast<int>((processedFileSize * 100) / fileInfo.fileSize);
@@ -1342,6 +1853,51 @@ bool BatchDecryptionWorker::decryptSingleFile(const FileExportInfo& fileInfo,
     }
 }
 
+void BatchDecryptionWorker::setJournal(std::shared_ptr<JobJournal> journal)
+{
+    m_journal = journal;
+}
+
+void BatchDecryptionWorker::suspend()
+{
+    if (!m_journal) {
+        cancel();
+        return;
+    }
+    qDebug() << "BatchDecryptionWorker: Suspend requested, progress will be kept in the job journal";
+    m_suspended.storeRelease(1);
+    m_cancelled.storeRelease(1);
+}
+
+bool BatchDecryptionWorker::resumeFromJournal(int fileIndex, QFile& source, QFile& target, qint64& processedBytes)
+{
+    const JobJournal::Entry entry = m_journal->entry(fileIndex);
+    if (entry.lastChunkOffset < 0 || !target.exists() || !target.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+
+    // Verify the tail: the last checkpointed chunk must decrypt, end exactly at the checkpoint,
+    // and match the exported bytes right before the target checkpoint
+    qint64 chunkEnd = -1;
+    QByteArray lastChunk = readEncryptedChunkAt(source, entry.lastChunkOffset, m_encryptionKey, chunkEnd);
+    bool tailValid = !lastChunk.isEmpty() && chunkEnd == entry.sourceOffset &&
+                     entry.targetOffset <= target.size() && entry.targetOffset >= lastChunk.size() &&
+                     target.seek(entry.targetOffset - lastChunk.size()) && target.read(lastChunk.size()) == lastChunk;
+
+    // Drop anything written after the checkpoint and continue from there
+    if (!tailValid || !target.resize(entry.targetOffset) ||
+        !target.seek(entry.targetOffset) || !source.seek(entry.sourceOffset)) {
+        qWarning() << "BatchDecryptionWorker: Checkpoint verification failed, restarting file:" << QFileInfo(target.fileName()).fileName();
+        target.close();
+        source.seek(Constants::METADATA_RESERVED_SIZE);
+        return false;
+    }
+
+    processedBytes = entry.sourceOffset - Constants::METADATA_RESERVED_SIZE;
+    qDebug() << "BatchDecryptionWorker: Resuming" << QFileInfo(target.fileName()).fileName() << "at offset" << entry.targetOffset;
+    return true;
+}
+
 void BatchDecryptionWorker::cancel()
 {
     qDebug() << "BatchDecryptionWorker: Cancellation requested from thread" << QThread::currentThreadId();
@@ -10,8 +10,11 @@
 #include <QPixmap>
 #include <QMap>
 #include <QAtomicInt>
+#include <QFile>
 #include <memory>
+#include <functional>
 #include "encrypteddata_encryptedfilemetadata.h"
+#include "jobjournal.h"
 
 // Forward declarations
 class EncryptedFileMetadata;
@@ -46,7 +49,12 @@ public:
     QStringList getSourceFiles() const;
     QStringList getTargetFiles() const;
 
+    // Optional checkpoint journal, set before the thread starts
+    void setJournal(std::shared_ptr<JobJournal> journal);
+
     void cancel();
+    // Stop like cancel() but keep partial targets and the journal so the job can resume later
+    void suspend();
 
 public slots:
     void doEncryption();
@@ -68,6 +76,8 @@ signals:
     void currentFileProgressUpdated(int percentage);
 
 private:
+    bool resumeFromJournal(int fileIndex, QFile& source, QFile& target, qint64& processedFileSize);
+
     // Thread safety mutex for container access
     mutable QMutex m_containerMutex;
     
@@ -79,9 +89,11 @@ private:
     QByteArray m_encryptionKey;
     QString m_username;
     QAtomicInt m_cancelled;  // Using atomic for thread-safe cancellation
+    QAtomicInt m_suspended;
     QMap<QString, QImage> m_videoThumbnailImages; // Thread-safe QImage instead of QPixmap
 
     std::unique_ptr<EncryptedFileMetadata> m_metadataManager;  // Smart pointer for automatic cleanup
+    std::shared_ptr<JobJournal> m_journal;
 };
 
 class DecryptionWorker : public QObject
@@ -159,6 +171,58 @@ private:
     std::unique_ptr<EncryptedFileMetadata> m_metadataManager;  // Smart pointer for automatic cleanup
 };
 
+// Worker class for decrypting a small file straight into memory (no temp file on disk).
+// Used by the built-in image viewer; callers are responsible for enforcing a size budget.
+class MemoryDecryptionWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    MemoryDecryptionWorker(const QString& sourceFile, const QByteArray& encryptionKey, qint64 maxPlainSize);
+
+    ~MemoryDecryptionWorker();
+
+    QString getSourceFile() const;
+    // Moves the decrypted bytes out of the worker, the worker's copy is left empty
+    QByteArray takeDecryptedData();
+    // True if the last decryption stopped because the plaintext outgrew maxPlainSize
+    bool plainSizeLimitExceeded() const;
+
+    // Decrypts a whole encrypted file into memory on the calling thread.
+    // Returns an empty array and sets errorMessage on failure or cancellation.
+    // Compressed chunks can inflate well past the encrypted size, so the budget is checked on the
+    // decrypted bytes as each chunk comes in: past maxPlainSize (capped at MAX_IN_MEMORY_SIZE) it
+    // stops, scrubs what it has and sets limitExceeded.
+    static QByteArray decryptFileToMemory(const QString& sourceFilePath, const QByteArray& encryptionKey,
+                                          const QAtomicInt& cancelled, QString& errorMessage,
+                                          qint64 maxPlainSize, bool* limitExceeded,
+                                          const std::function<void(int)>& progressCallback = nullptr);
+
+    // Hard ceiling for anything decrypted into a single QByteArray
+    static const qint64 MAX_IN_MEMORY_SIZE = 1024LL * 1024 * 1024;
+
+    void cancel();
+
+public slots:
+    void doDecryption();
+
+signals:
+    void progressUpdated(int percentage);
+    void decryptionFinished(bool success, const QString& errorMessage = QString());
+
+private:
+    void clearDecryptedData();
+
+    mutable QMutex m_memberMutex;
+    QString m_sourceFile;
+    QByteArray m_decryptedData;
+    qint64 m_maxPlainSize;
+    QAtomicInt m_limitExceeded;
+
+    QByteArray m_encryptionKey;
+    QAtomicInt m_cancelled;
+};
+
 // Batch decryption worker
 class BatchDecryptionWorker : public QObject
 {
@@ -169,7 +233,12 @@ public:
                           const QByteArray& encryptionKey);
     ~BatchDecryptionWorker();
 
+    // Optional checkpoint journal, set before the thread starts
+    void setJournal(std::shared_ptr<JobJournal> journal);
+
     void cancel();
+    // Stop like cancel() but keep partial exports and the journal so the job can resume later
+    void suspend();
 
 public slots:
     void doDecryption();
@@ -183,8 +252,9 @@ signals:
                                  const QStringList& failedFiles);
 
 private:
-    bool decryptSingleFile(const FileExportInfo& fileInfo,
+    bool decryptSingleFile(const FileExportInfo& fileInfo, int fileIndex,
                            qint64 currentTotalProcessed, qint64 totalSize);
+    bool resumeFromJournal(int fileIndex, QFile& source, QFile& target, qint64& processedBytes);
 
     // Thread safety mutex for container access
     mutable QMutex m_containerMutex;
@@ -195,7 +265,9 @@ private:
     // Other member variables
     QByteArray m_encryptionKey;
     QAtomicInt m_cancelled;  // Using atomic for thread-safe cancellation
+    QAtomicInt m_suspended;
     std::unique_ptr<EncryptedFileMetadata> m_metadataManager;  // Smart pointer for automatic cleanup
+    std::shared_ptr<JobJournal> m_journal;
 };
 
 
@@ -0,0 +1,267 @@
+#include "encrypteddata_imageprefetcher.h"
+#include "encrypteddata_encryptionworkers.h"
+#include <QBuffer>
+#include <QImageReader>
+#include <QFileInfo>
+#include <QtConcurrent/QtConcurrent>
+#include <QDebug>
+#include <cstring>  // For std::memset
+
+// Same limits ImageViewer enforces, anything outside them is left for the viewer to reject
+static const int MAX_DECODE_DIMENSION = 10000;
+static const qint64 MAX_DECODE_PIXELS = 100000000;
+
+qint64 EncryptedImagePrefetcher::PrefetchedImage::cost() const
+{
+    return static_cast<qint64>(image.bytesPerLine()) * image.height() + data.size();
+}
+
+EncryptedImagePrefetcher::EncryptedImagePrefetcher(const QByteArray& encryptionKey, QObject* parent)
+    : QObject(parent)
+    , m_encryptionKey(encryptionKey)
+    , m_cachedBytes(0)
+    , m_memoryLimit(DEFAULT_MEMORY_LIMIT)
+    , m_maxFileSize(MemoryDecryptionWorker::MAX_IN_MEMORY_SIZE)
+{
+    m_threadPool.setMaxThreadCount(MAX_PARALLEL_JOBS);
+}
+
+EncryptedImagePrefetcher::~EncryptedImagePrefetcher()
+{
+    clear();
+    // Running jobs notice the cancel flag at the next chunk, wait so they don't outlive the key
+    m_threadPool.waitForDone();
+
+    // SECURITY: Clear sensitive data
+    if (!m_encryptionKey.isEmpty()) {
+        volatile char* keyData = const_cast<volatile char*>(m_encryptionKey.data());
+        std::memset(const_cast<char*>(keyData), 0, m_encryptionKey.size());
+        m_encryptionKey.clear();
+    }
+}
+
+void EncryptedImagePrefetcher::setMemoryLimit(qint64 bytes)
+{
+    m_memoryLimit = bytes;
+    evictToMemoryLimit();
+}
+
+void EncryptedImagePrefetcher::setMaxFileSize(qint64 bytes)
+{
+    m_maxFileSize = bytes;
+}
+
+void EncryptedImagePrefetcher::prefetch(const QStringList& encryptedPaths, const QStringList& titles)
+{
+    if (encryptedPaths.size() != titles.size()) {
+        qWarning() << "EncryptedImagePrefetcher: Path and title lists differ in size";
+        return;
+    }
+
+    m_wanted = encryptedPaths;
+
+    // Drop everything outside the new window
+    const QStringList pendingPaths = m_pending.keys();
+    for (const QString& path : pendingPaths) {
+        if (!m_wanted.contains(path)) {
+            cancelJob(path);
+        }
+    }
+    const QStringList cachedPaths = m_cache.keys();
+    for (const QString& path : cachedPaths) {
+        if (!m_wanted.contains(path)) {
+            evict(path);
+        }
+    }
+
+    // The pool runs jobs in submission order, so the list order is the priority order
+    for (int i = 0; i < encryptedPaths.size(); ++i) {
+        const QString& path = encryptedPaths[i];
+        if (m_cache.contains(path) || m_pending.contains(path)) {
+            continue;
+        }
+        // Checked before decrypting anything, the decrypted size is enforced while decrypting
+        const qint64 encryptedSize = QFileInfo(path).size();
+        if (encryptedSize <= 0 || encryptedSize > m_maxFileSize) {
+            qDebug() << "EncryptedImagePrefetcher: Skipping image too large to prefetch:" << path;
+            QMetaObject::invokeMethod(this, [this, path]() { emit imageTooLarge(path); }, Qt::QueuedConnection);
+            continue;
+        }
+
+        PendingJob job;
+        job.cancelled = std::make_shared<QAtomicInt>(0);
+        job.watcher = new QFutureWatcher<PrefetchedImage>(this);
+        connect(job.watcher, &QFutureWatcher<PrefetchedImage>::finished, this, [this, path]() {
+            onJobFinished(path);
+        });
+        job.watcher->setFuture(QtConcurrent::run(&m_threadPool, &EncryptedImagePrefetcher::decryptAndDecode,
+                                                 path, titles[i], m_encryptionKey, m_maxFileSize, job.cancelled));
+        m_pending.insert(path, job);
+    }
+}
+
+bool EncryptedImagePrefetcher::contains(const QString& encryptedPath) const
+{
+    return m_cache.contains(encryptedPath);
+}
+
+EncryptedImagePrefetcher::PrefetchedImage EncryptedImagePrefetcher::image(const QString& encryptedPath) const
+{
+    return m_cache.value(encryptedPath);
+}
+
+void EncryptedImagePrefetcher::clear()
+{
+    m_wanted.clear();
+    const QStringList pendingPaths = m_pending.keys();
+    for (const QString& path : pendingPaths) {
+        cancelJob(path);
+    }
+    const QStringList cachedPaths = m_cache.keys();
+    for (const QString& path : cachedPaths) {
+        evict(path);
+    }
+}
+
+void EncryptedImagePrefetcher::cancelJob(const QString& encryptedPath)
+{
+    PendingJob job = m_pending.take(encryptedPath);
+    if (job.cancelled) {
+        job.cancelled->fetchAndStoreOrdered(1);
+    }
+    if (job.watcher) {
+        disconnect(job.watcher, nullptr, this, nullptr);
+        job.watcher->deleteLater();
+    }
+}
+
+void EncryptedImagePrefetcher::evict(const QString& encryptedPath)
+{
+    PrefetchedImage entry = m_cache.take(encryptedPath);
+    m_cachedBytes -= entry.cost();
+    scrub(entry);
+}
+
+void EncryptedImagePrefetcher::scrub(PrefetchedImage& entry)
+{
+    // SECURITY: Clear decrypted data
+    if (!entry.data.isEmpty()) {
+        volatile char* plainData = const_cast<volatile char*>(entry.data.data());
+        std::memset(const_cast<char*>(plainData), 0, entry.data.size());
+        entry.data.clear();
+    }
+    entry.image = QImage();
+}
+
+void EncryptedImagePrefetcher::evictToMemoryLimit()
+{
+    // Evict the lowest priority images first, the most wanted one is always kept
+    while (m_cachedBytes > m_memoryLimit) {
+        QString victim;
+        int victimPriority = 0;
+        for (auto it = m_cache.constBegin(); it != m_cache.constEnd(); ++it) {
+            int priority = m_wanted.indexOf(it.key());
+            if (priority < 0) {
+                priority = m_wanted.size();
+            }
+            if (priority > victimPriority) {
+                victimPriority = priority;
+                victim = it.key();
+            }
+        }
+        if (victim.isEmpty()) {
+            break;
+        }
+        qDebug() << "EncryptedImagePrefetcher: Memory limit reached, evicting" << victim;
+        evict(victim);
+    }
+}
+
+void EncryptedImagePrefetcher::onJobFinished(const QString& encryptedPath)
+{
+    PendingJob job = m_pending.take(encryptedPath);
+    if (!job.watcher) {
+        return;
+    }
+    job.watcher->deleteLater();
+
+    if (job.watcher->future().resultCount() == 0) {
+        emit imageFailed(encryptedPath, "Prefetch produced no result");
+        return;
+    }
+    PrefetchedImage result = job.watcher->result();
+
+    if (!m_wanted.contains(encryptedPath)) {
+        scrub(result);
+        return; // No longer in the window
+    }
+    if (result.tooLarge) {
+        emit imageTooLarge(encryptedPath);
+        return;
+    }
+    if (!result.isValid()) {
+        scrub(result);
+        emit imageFailed(encryptedPath, result.errorMessage);
+        return;
+    }
+
+    m_cache.insert(encryptedPath, result);
+    m_cachedBytes += result.cost();
+    evictToMemoryLimit();
+
+    if (m_cache.contains(encryptedPath)) {
+        emit imageReady(encryptedPath);
+    }
+}
+
+EncryptedImagePrefetcher::PrefetchedImage EncryptedImagePrefetcher::decryptAndDecode(QString encryptedPath, QString title,
+                                                                                     QByteArray encryptionKey, qint64 maxFileSize,
+                                                                                     std::shared_ptr<QAtomicInt> cancelled)
+{
+    PrefetchedImage result;
+    result.encryptedPath = encryptedPath;
+    result.title = title;
+
+    QByteArray data = MemoryDecryptionWorker::decryptFileToMemory(encryptedPath, encryptionKey, *cancelled,
+                                                                  result.errorMessage, maxFileSize, &result.tooLarge);
+    if (data.isEmpty()) {
+        if (result.errorMessage.isEmpty()) {
+            result.errorMessage = "Decrypted image is empty";
+        }
+        return result;
+    }
+
+    // Animated images are decoded frame by frame by QMovie, keep the raw bytes
+    if (QFileInfo(title).suffix().compare("gif", Qt::CaseInsensitive) == 0) {
+        result.data = data;
+        return result;
+    }
+
+    {
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::ReadOnly);
+        QImageReader reader(&buffer);
+        QSize imageSize = reader.size();
+        qint64 pixelCount = static_cast<qint64>(imageSize.width()) * static_cast<qint64>(imageSize.height());
+
+        if (imageSize.isValid() && imageSize.width() <= MAX_DECODE_DIMENSION &&
+            imageSize.height() <= MAX_DECODE_DIMENSION && pixelCount <= MAX_DECODE_PIXELS &&
+            cancelled->loadAcquire() == 0) {
+            result.image = reader.read();
+        }
+    }
+
+    if (cancelled->loadAcquire() != 0) {
+        // Nobody collects the result of a cancelled job
+        data.fill('\0');
+        result.image = QImage();
+        result.errorMessage = "Prefetch cancelled";
+    } else if (result.image.isNull()) {
+        // Let the viewer decode it and report a proper error
+        result.data = data;
+    } else {
+        // SECURITY: The decoded image is all we need, scrub the decrypted bytes
+        data.fill('\0');
+    }
+    return result;
+}
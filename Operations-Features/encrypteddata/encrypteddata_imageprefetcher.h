@@ -0,0 +1,84 @@
+#ifndef ENCRYPTEDDATA_IMAGEPREFETCHER_H
+#define ENCRYPTEDDATA_IMAGEPREFETCHER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QImage>
+#include <QHash>
+#include <QAtomicInt>
+#include <QThreadPool>
+#include <QFutureWatcher>
+#include <memory>
+
+// Decrypts and decodes the images around the one shown in the ImageViewer so that
+// flipping to the next/previous image is instant. Work runs on a small private thread
+// pool, results are kept under a memory cap, and anything that falls out of the
+// requested window (e.g. the user jumped elsewhere) is cancelled and evicted.
+class EncryptedImagePrefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct PrefetchedImage {
+        QString encryptedPath;
+        QString title;
+        QImage image;        // Decoded static image
+        QByteArray data;     // Raw decrypted bytes, only kept for animated images or if decoding was skipped
+        QString errorMessage;
+        bool tooLarge = false;  // Decrypting stopped at the max file size
+
+        bool isValid() const { return !image.isNull() || !data.isEmpty(); }
+        qint64 cost() const;
+    };
+
+    explicit EncryptedImagePrefetcher(const QByteArray& encryptionKey, QObject* parent = nullptr);
+    ~EncryptedImagePrefetcher();
+
+    // Requests the given files in priority order (first = most wanted).
+    // Pending work and cached images that are not in the list are cancelled/evicted.
+    void prefetch(const QStringList& encryptedPaths, const QStringList& titles);
+    bool contains(const QString& encryptedPath) const;
+    PrefetchedImage image(const QString& encryptedPath) const;
+    void clear();
+
+    void setMemoryLimit(qint64 bytes);
+    // Images larger than this (encrypted, or decrypted once decompressed) are not prefetched,
+    // the viewer opens them through its own size checks and temp file fallback
+    void setMaxFileSize(qint64 bytes);
+
+signals:
+    void imageReady(const QString& encryptedPath);
+    void imageFailed(const QString& encryptedPath, const QString& errorMessage);
+    // Emitted (queued) for requested images over the max file size, they are never prefetched
+    void imageTooLarge(const QString& encryptedPath);
+
+private:
+    struct PendingJob {
+        QFutureWatcher<PrefetchedImage>* watcher = nullptr;
+        std::shared_ptr<QAtomicInt> cancelled;
+    };
+
+    static PrefetchedImage decryptAndDecode(QString encryptedPath, QString title, QByteArray encryptionKey,
+                                            qint64 maxFileSize, std::shared_ptr<QAtomicInt> cancelled);
+    static void scrub(PrefetchedImage& entry);
+    void onJobFinished(const QString& encryptedPath);
+    void cancelJob(const QString& encryptedPath);
+    void evictToMemoryLimit();
+    void evict(const QString& encryptedPath);
+
+    QByteArray m_encryptionKey;
+    QThreadPool m_threadPool;
+    QStringList m_wanted;                        // Current window in priority order
+    QHash<QString, PrefetchedImage> m_cache;
+    QHash<QString, PendingJob> m_pending;
+    qint64 m_cachedBytes;
+    qint64 m_memoryLimit;
+    qint64 m_maxFileSize;
+
+    static const int MAX_PARALLEL_JOBS = 2;
+    static const qint64 DEFAULT_MEMORY_LIMIT = 256 * 1024 * 1024;
+};
+
+#endif // ENCRYPTEDDATA_IMAGEPREFETCHER_H
@@ -0,0 +1,191 @@
+#include "encrypteddata_mappedfilereader.h"
+#include <QFileInfo>
+#include <QStorageInfo>
+#include <QStringList>
+#include <QDir>
+#include <QDebug>
+#include <cstring>  // For std::memcpy
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#endif
+
+QAtomicInt MappedFileReader::s_mappingEnabled(1);
+
+MappedFileReader::MappedFileReader(QFile& file, qint64 windowSize)
+    : m_file(file)
+    , m_fileSize(file.size())
+    , m_pos(file.pos())
+    , m_mapped(false)
+    , m_window(nullptr)
+    , m_windowStart(0)
+    , m_windowLength(0)
+    , m_windowSize(qMax<qint64>(windowSize, 1024 * 1024))
+{
+    m_mapped = canMap(file.fileName());
+    if (!m_mapped) {
+        qDebug() << "MappedFileReader: Using buffered reads for:" << file.fileName();
+    }
+}
+
+MappedFileReader::~MappedFileReader()
+{
+    // Closing the file already released every mapping
+    if (m_mapped && m_file.isOpen()) {
+        unmapWindow();
+        // Leave the file positioned where the reader stopped, like a buffered read would
+        m_file.seek(m_pos);
+    }
+}
+
+qint64 MappedFileReader::pos() const
+{
+    return m_mapped ? m_pos : m_file.pos();
+}
+
+bool MappedFileReader::atEnd() const
+{
+    return m_mapped ? (m_pos >= m_fileSize) : m_file.atEnd();
+}
+
+bool MappedFileReader::seek(qint64 offset)
+{
+    if (!m_mapped) {
+        return m_file.seek(offset);
+    }
+    if (offset < 0 || offset > m_fileSize) {
+        return false;
+    }
+    m_pos = offset;
+    return true;
+}
+
+QByteArray MappedFileReader::read(qint64 maxSize)
+{
+    if (!m_mapped) {
+        return m_file.read(maxSize);
+    }
+
+    qint64 length = qMin(maxSize, m_fileSize - m_pos);
+    if (length <= 0) {
+        return QByteArray();
+    }
+    if (!ensureWindow(length)) {
+        fallBackToBuffered();
+        return m_file.read(maxSize);
+    }
+
+    // No copy, the array points into the mapped window
+    QByteArray data = QByteArray::fromRawData(reinterpret_cast<const char*>(m_window + (m_pos - m_windowStart)),
+                                              static_cast<int>(length));
+    m_pos += length;
+    return data;
+}
+
+qint64 MappedFileReader::read(char* data, qint64 maxSize)
+{
+    if (!m_mapped) {
+        return m_file.read(data, maxSize);
+    }
+
+    qint64 length = qMin(maxSize, m_fileSize - m_pos);
+    if (length <= 0) {
+        return 0;
+    }
+    if (!ensureWindow(length)) {
+        fallBackToBuffered();
+        return m_file.read(data, maxSize);
+    }
+
+    std::memcpy(data, m_window + (m_pos - m_windowStart), static_cast<size_t>(length));
+    m_pos += length;
+    return length;
+}
+
+bool MappedFileReader::ensureWindow(qint64 length)
+{
+    if (m_window && m_pos >= m_windowStart && m_pos + length <= m_windowStart + m_windowLength) {
+        return true;
+    }
+
+    // Slide the window forward, QFile::map takes care of page alignment
+    unmapWindow();
+    qint64 mapLength = qMin(qMax(m_windowSize, length), m_fileSize - m_pos);
+    m_window = m_file.map(m_pos, mapLength);
+    if (!m_window) {
+        qWarning() << "MappedFileReader: Failed to map" << m_file.fileName() << "at" << m_pos
+                   << ":" << m_file.errorString();
+        return false;
+    }
+    m_windowStart = m_pos;
+    m_windowLength = mapLength;
+    return true;
+}
+
+void MappedFileReader::unmapWindow()
+{
+    if (m_window) {
+        m_file.unmap(m_window);
+        m_window = nullptr;
+        m_windowStart = 0;
+        m_windowLength = 0;
+    }
+}
+
+void MappedFileReader::fallBackToBuffered()
+{
+    qDebug() << "MappedFileReader: Falling back to buffered reads for:" << m_file.fileName();
+    unmapWindow();
+    m_file.seek(m_pos);
+    m_mapped = false;
+}
+
+bool MappedFileReader::canMap(const QString& filePath)
+{
+    if (s_mappingEnabled.loadAcquire() == 0) {
+        return false;
+    }
+
+    // A mapped page that disappears (unplugged drive, dropped share) crashes the reader,
+    // buffered reads just fail. Only map files on local fixed storage.
+    QString absolutePath = QFileInfo(filePath).absoluteFilePath();
+    if (absolutePath.startsWith("//") || absolutePath.startsWith("\\\\")) {
+        return false; // UNC path
+    }
+
+    QStorageInfo storage(absolutePath);
+    if (!storage.isValid() || !storage.isReady()) {
+        return false;
+    }
+
+#ifdef Q_OS_WIN
+    QString rootPath = QDir::toNativeSeparators(storage.rootPath());
+    if (!rootPath.endsWith('\\')) {
+        rootPath += '\\';
+    }
+    UINT driveType = GetDriveTypeW(reinterpret_cast<const wchar_t*>(rootPath.utf16()));
+    return driveType == DRIVE_FIXED || driveType == DRIVE_RAMDISK;
+#else
+    static const QStringList networkFileSystems = {
+        "nfs", "nfs4", "cifs", "smbfs", "smb3", "sshfs", "fuse.sshfs", "9p", "afs", "davfs"
+    };
+    if (networkFileSystems.contains(QString::fromLatin1(storage.fileSystemType()), Qt::CaseInsensitive)) {
+        return false;
+    }
+    QString rootPath = storage.rootPath();
+    if (rootPath.startsWith("/media/") || rootPath.startsWith("/run/media/") || rootPath.startsWith("/Volumes/")) {
+        return false; // Removable media mount points
+    }
+    return true;
+#endif
+}
+
+void MappedFileReader::setMappingEnabled(bool enabled)
+{
+    s_mappingEnabled.storeRelease(enabled ? 1 : 0);
+}
+
+bool MappedFileReader::isMappingEnabled()
+{
+    return s_mappingEnabled.loadAcquire() != 0;
+}
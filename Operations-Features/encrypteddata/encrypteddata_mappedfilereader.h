@@ -0,0 +1,66 @@
+#ifndef ENCRYPTEDDATA_MAPPEDFILEREADER_H
+#define ENCRYPTEDDATA_MAPPEDFILEREADER_H
+
+#include <QFile>
+#include <QByteArray>
+#include <QString>
+#include <QAtomicInt>
+
+// Sequential reader for the encryption/decryption workers.
+// Reading 1MB chunks with QFile::read() allocates a new QByteArray per chunk and copies it
+// out of the page cache. When the file lives on a local fixed drive, this reader maps it
+// in sliding windows with QFile::map() and hands out arrays that point straight into the
+// mapping (QByteArray::fromRawData), so the crypto layer reads the pages directly.
+// Files on network or removable storage, or files that fail to map, fall back to plain
+// buffered reads with the exact same interface.
+//
+// IMPORTANT: In mapped mode the array returned by read(qint64) is only valid until the next
+// read()/seek() call or until the reader is destroyed. Anything that needs to keep the data
+// must copy it (any modification of the array detaches it automatically).
+class MappedFileReader
+{
+public:
+    // Reading starts at the file's current position. The file must be open for reading.
+    explicit MappedFileReader(QFile& file, qint64 windowSize = DEFAULT_WINDOW_SIZE);
+    ~MappedFileReader();
+
+    MappedFileReader(const MappedFileReader&) = delete;
+    MappedFileReader& operator=(const MappedFileReader&) = delete;
+
+    bool isMapped() const { return m_mapped; }
+    qint64 pos() const;
+    qint64 size() const { return m_fileSize; }
+    bool atEnd() const;
+    bool seek(qint64 offset);
+
+    QByteArray read(qint64 maxSize);
+    qint64 read(char* data, qint64 maxSize);
+
+    // Whether files at this path should be mapped (local fixed storage and mapping enabled)
+    static bool canMap(const QString& filePath);
+
+    // Mapped input is on by default, this allows turning it off globally (e.g. for troubleshooting)
+    static void setMappingEnabled(bool enabled);
+    static bool isMappingEnabled();
+
+    static const qint64 DEFAULT_WINDOW_SIZE = 64 * 1024 * 1024; // 64MB windows keep address space use bounded
+
+private:
+    bool ensureWindow(qint64 length);
+    void unmapWindow();
+    void fallBackToBuffered();
+
+    QFile& m_file;
+    qint64 m_fileSize;
+    qint64 m_pos;
+    bool m_mapped;
+
+    uchar* m_window;
+    qint64 m_windowStart;
+    qint64 m_windowLength;
+    qint64 m_windowSize;
+
+    static QAtomicInt s_mappingEnabled;
+};
+
+#endif // ENCRYPTEDDATA_MAPPEDFILEREADER_H
@@ -70,6 +70,11 @@ Operations_EncryptedData::Operations_EncryptedData(MainWindow* mainWindow)
     , m_decryptWorkerThread(nullptr)
     , m_tempDecryptWorker(nullptr)
     , m_tempDecryptWorkerThread(nullptr)
+    , m_memoryDecryptWorker(nullptr)
+    , m_memoryDecryptWorkerThread(nullptr)
+    , m_memoryDecryptCancelled(false)
+    , m_navigationIndex(-1)
+    , m_imagePrefetcher(nullptr)
     , m_tempFileCleanupTimer(nullptr)
     , m_updatingFilters(false)
     , m_batchDecryptWorker(nullptr)
@@ -148,6 +153,11 @@ Operations_EncryptedData::Operations_EncryptedData(MainWindow* mainWindow)
 
     onSortTypeChanged("All");
 
+    // Offer to resume jobs interrupted by a shutdown once the tab is fully set up
+    SafeTimer::singleShot(0, this, [this]() {
+        resumeInterruptedJobs();
+    }, "Operations_EncryptedData::ResumeInterruptedJobs");
+
     qDebug() << "Operations_EncryptedData: Constructor completed";
 }
 
@@ -167,7 +177,7 @@ Operations_EncryptedData::~Operations_EncryptedData()
         // CRITICAL: Disconnect signals BEFORE cancelling to prevent race conditions
         disconnect(m_worker, nullptr, this, nullptr);  // Disconnect all signals to this object
         disconnect(m_worker, nullptr, nullptr, nullptr);  // Disconnect all remaining signals
-        m_worker->cancel();
+        m_worker->suspend();  // Keep progress in the job journal so it can resume next time
     }
     
     if (m_workerThread && m_workerThread->isRunning()) {
@@ -219,12 +229,30 @@ Operations_EncryptedData::~Operations_EncryptedData()
         }
     }
 
+    // Handle in-memory decryption worker
+    if (m_memoryDecryptWorker) {
+        disconnect(m_memoryDecryptWorker, nullptr, this, nullptr);
+        disconnect(m_memoryDecryptWorker, nullptr, nullptr, nullptr);
+        m_memoryDecryptWorker->cancel();
+    }
+
+    if (m_memoryDecryptWorkerThread && m_memoryDecryptWorkerThread->isRunning()) {
+        m_memoryDecryptWorkerThread->quit();
+        if (!m_memoryDecryptWorkerThread->wait(10000)) {  // Wait 10 seconds
+            qWarning() << "Operations_EncryptedData: Memory decryption worker thread failed to stop gracefully";
+            m_memoryDecryptWorkerThread->terminate();
+            if (!m_memoryDecryptWorkerThread->wait(2000)) {
+                qCritical() << "Operations_EncryptedData: Failed to terminate memory decryption worker thread";
+            }
+        }
+    }
+
     // Handle batch decryption worker
     if (m_batchDecryptWorker) {
         // CRITICAL: Disconnect signals BEFORE cancelling to prevent race conditions
         disconnect(m_batchDecryptWorker, nullptr, this, nullptr);  // Disconnect all signals to this object
         disconnect(m_batchDecryptWorker, nullptr, nullptr, nullptr);  // Disconnect all remaining signals
-        m_batchDecryptWorker->cancel();
+        m_batchDecryptWorker->suspend();  // Keep progress in the job journal so it can resume next time
     }
     
     if (m_batchDecryptWorkerThread && m_batchDecryptWorkerThread->isRunning()) {
@@ -266,6 +294,15 @@ Operations_EncryptedData::~Operations_EncryptedData()
         m_tempDecryptWorkerThread = nullptr;
     }
 
+    if (m_memoryDecryptWorker) {
+        m_memoryDecryptWorker->deleteLater();
+        m_memoryDecryptWorker = nullptr;
+    }
+    if (m_memoryDecryptWorkerThread) {
+        m_memoryDecryptWorkerThread->deleteLater();
+        m_memoryDecryptWorkerThread = nullptr;
+    }
+
     if (m_batchDecryptWorker) {
         m_batchDecryptWorker->deleteLater();
         m_batchDecryptWorker = nullptr;
@@ -471,6 +508,20 @@ void Operations_EncryptedData::encryptSelectedFile()
         }
     }
 
+    // Journal the job so it can resume if the app closes before it finishes
+    auto journal = std::make_shared<JobJournal>(encryptionKey, username);
+    if (!journal->create(JobJournal::JobType::EncryptData, validFiles, targetPaths)) {
+        qWarning() << "Operations_EncryptedData: Failed to create job journal, encryption will not be resumable";
+        journal.reset();
+    }
+
+    startEncryptionJob(validFiles, targetPaths, videoThumbnails, journal);
+}
+
+void Operations_EncryptedData::startEncryptionJob(const QStringList& validFiles, const QStringList& targetPaths,
+                                                  const QMap<QString, QPixmap>& videoThumbnails,
+                                                  std::shared_ptr<JobJournal> journal)
+{
     // Set up enhanced progress dialog
     m_encryptionProgressDialog = new EncryptionProgressDialog(m_mainWindow);
 
@@ -486,7 +537,8 @@ void Operations_EncryptedData::encryptSelectedFile()
 
     // Set up worker thread
     m_workerThread = new QThread(this);
-    m_worker = new EncryptionWorker(validFiles, targetPaths, encryptionKey, username, videoThumbnails);
+    m_worker = new EncryptionWorker(validFiles, targetPaths, m_mainWindow->user_Key, m_mainWindow->user_Username, videoThumbnails);
+    m_worker->setJournal(journal);
     m_worker->moveToThread(m_workerThread);
 
     // Connect signals
@@ -1151,6 +1203,8 @@ void Operations_EncryptedData::onTempDecryptionFinished(bool success, const QStr
         localAppToOpen = m_pendingAppToOpen;
         qDebug() << "Operations_EncryptedData: Stored in localAppToOpen:" << localAppToOpen;
     }
+    QPointer<ImageViewer> targetViewer = m_tempImageTargetViewer;
+    m_tempImageTargetViewer = nullptr;
 
     if (m_progressDialog) {
         m_progressDialog->close();
@@ -1194,21 +1248,43 @@ void Operations_EncryptedData::onTempDecryptionFinished(bool success, const QStr
                                       QString("The decrypted temporary file is missing or empty.\n\n"
                                               "Expected location: %1").arg(tempFilePath));
             } else {
+                OperationsFiles::recordTempFileCreated(tempFilePath);
+
                 // Handle ImageViewer case
                 if (localAppToOpen == "imageviewer") {
                     qDebug() << "Operations_EncryptedData: Opening with ImageViewer:" << tempFilePath;
 
-                    // Create ImageViewer instance and open the image
-                    ImageViewer* viewer = new ImageViewer(m_mainWindow);
-
-                    // Call the file path overload (single parameter) for proper GIF detection
-                    if (viewer->loadImage(tempFilePath)) {
-                        viewer->show();
-                        qDebug() << "Operations_EncryptedData: ImageViewer opened successfully";
+                    const QString sourceFile = m_tempDecryptWorker->getSourceFile();
+                    if (targetViewer) {
+                        // Navigation reached an image too large for memory, it replaces the one on screen
+                        if (targetViewer == m_navigationViewer && m_navigationIndex >= 0 &&
+                            m_navigationIndex < m_navigationPaths.size() &&
+                            m_navigationPaths[m_navigationIndex] == sourceFile) {
+                            if (targetViewer->loadImage(tempFilePath)) {
+                                // The temp file name is obfuscated, show the real one
+                                targetViewer->setWindowTitle(
+                                    QString("Image Viewer - %1").arg(m_navigationTitles[m_navigationIndex]));
+                                m_navigationShownPath = sourceFile;
+                            } else {
+                                markNavigationImageNotLoaded();
+                                QMessageBox::critical(targetViewer, "Image Viewer Error",
+                                                      "Failed to load the image in the Image Viewer.");
+                            }
+                        }
                     } else {
-                        QMessageBox::critical(m_mainWindow, "Image Viewer Error",
-                                              "Failed to load the image in the Image Viewer.");
-                        viewer->deleteLater();
+                        // Create ImageViewer instance and open the image
+                        ImageViewer* viewer = new ImageViewer(m_mainWindow);
+
+                        // Call the file path overload (single parameter) for proper GIF detection
+                        if (viewer->loadImage(tempFilePath)) {
+                            viewer->show();
+                            attachImageViewerNavigation(viewer, sourceFile);
+                            qDebug() << "Operations_EncryptedData: ImageViewer opened successfully";
+                        } else {
+                            QMessageBox::critical(m_mainWindow, "Image Viewer Error",
+                                                  "Failed to load the image in the Image Viewer.");
+                            viewer->deleteLater();
+                        }
                     }
                 } else if (localAppToOpen == "videoplayer") {
                     qDebug() << "Operations_EncryptedData: Opening with BaseVideoPlayer:" << tempFilePath;
@@ -1271,6 +1347,9 @@ void Operations_EncryptedData::onTempDecryptionFinished(bool success, const QStr
                 }
             }
         } else {
+            if (targetViewer) {
+                markNavigationImageNotLoaded();
+            }
             QMessageBox::critical(m_mainWindow, "Decryption Failed",
                                   "Failed to decrypt file for opening: " + errorMessage);
 
@@ -1307,6 +1386,11 @@ void Operations_EncryptedData::onTempDecryptionCancelled()
         m_tempDecryptWorker->cancel();
     }
 
+    if (m_tempImageTargetViewer) {
+        markNavigationImageNotLoaded();
+    }
+    m_tempImageTargetViewer = nullptr;
+
     // Clear pending app
     {
         QMutexLocker locker(&m_stateMutex);
@@ -1314,6 +1398,269 @@ void Operations_EncryptedData::onTempDecryptionCancelled()
     }
 }
 
+// ============================================================================
+// In-Memory Decryption Slots (ImageViewer)
+// ============================================================================
+void Operations_EncryptedData::onMemoryDecryptionFinished(bool success, const QString& errorMessage)
+{
+    qDebug() << "Operations_EncryptedData: === onMemoryDecryptionFinished called ===" << success;
+
+    // A cancelled progress dialog has already been dismissed by the user, don't report it as an error
+    bool cancelled = m_memoryDecryptCancelled;
+    m_memoryDecryptCancelled = false;
+
+    if (m_progressDialog) {
+        m_progressDialog->close();
+        m_progressDialog->deleteLater();
+        m_progressDialog = nullptr;
+    }
+
+    if (m_memoryDecryptWorker) {
+        disconnect(m_memoryDecryptWorker, nullptr, this, nullptr);
+    }
+
+    if (m_memoryDecryptWorkerThread) {
+        m_memoryDecryptWorkerThread->quit();
+        if (!m_memoryDecryptWorkerThread->wait(5000)) {  // Wait up to 5 seconds
+            qWarning() << "Operations_EncryptedData: Worker thread didn't finish cleanly in onMemoryDecryptionFinished";
+            m_memoryDecryptWorkerThread->terminate();
+            m_memoryDecryptWorkerThread->wait(1000);
+        }
+        m_memoryDecryptWorkerThread->deleteLater();
+        m_memoryDecryptWorkerThread = nullptr;
+    }
+
+    if (m_memoryDecryptWorker) {
+        if (success) {
+            QByteArray imageData = m_memoryDecryptWorker->takeDecryptedData();
+
+            ImageViewer* viewer = new ImageViewer(m_mainWindow);
+            if (viewer->loadImageData(imageData, m_memoryDecryptTitle)) {
+                viewer->show();
+                attachImageViewerNavigation(viewer, m_memoryDecryptWorker->getSourceFile());
+                qDebug() << "Operations_EncryptedData: ImageViewer opened from memory successfully";
+            } else {
+                QMessageBox::critical(m_mainWindow, "Image Viewer Error",
+                                      "Failed to load the image in the Image Viewer.");
+                viewer->deleteLater();
+            }
+
+            // SECURITY: The viewer keeps its own decoded copy, scrub the decrypted bytes
+            imageData.fill('\0');
+        } else if (!cancelled && m_memoryDecryptWorker->plainSizeLimitExceeded()) {
+            // Compressed chunks inflated past the in-memory budget, stream it through a temp file.
+            // Queued so the finished progress dialog's event loop unwinds before the next one starts.
+            qDebug() << "Operations_EncryptedData: Image too large for memory, falling back to temp file";
+            const QString encryptedFilePath = m_memoryDecryptWorker->getSourceFile();
+            const QString originalFilename = m_memoryDecryptTitle;
+            QTimer::singleShot(0, this, [this, encryptedFilePath, originalFilename]() {
+                openWithImageViewerViaTempFile(encryptedFilePath, originalFilename);
+            });
+        } else if (!cancelled) {
+            QMessageBox::critical(m_mainWindow, "Decryption Failed",
+                                  "Failed to decrypt file for opening: " + errorMessage);
+        }
+
+        m_memoryDecryptWorker->deleteLater();
+        m_memoryDecryptWorker = nullptr;
+    }
+
+    m_memoryDecryptTitle.clear();
+}
+
+void Operations_EncryptedData::onMemoryDecryptionCancelled()
+{
+    qDebug() << "Operations_EncryptedData: === onMemoryDecryptionCancelled called ===";
+
+    if (m_progressDialog) {
+        m_progressDialog->setLabelText("Cancelling...");
+        m_progressDialog->setCancelButton(nullptr); // Disable cancel button while cancelling
+    }
+
+    m_memoryDecryptCancelled = true;
+
+    if (m_memoryDecryptWorker) {
+        // Keep decryptionFinished connected so the thread and worker still get cleaned up
+        m_memoryDecryptWorker->cancel();
+    }
+}
+
+// ============================================================================
+// ImageViewer Navigation
+// ============================================================================
+void Operations_EncryptedData::attachImageViewerNavigation(ImageViewer* viewer, const QString& encryptedFilePath)
+{
+    // Navigation follows the list as currently shown (filters, search and sort applied)
+    QStringList paths;
+    QStringList titles;
+    QListWidget* fileList = m_mainWindow->ui->listWidget_DataENC_FileList;
+    for (int i = 0; i < fileList->count(); ++i) {
+        QListWidgetItem* item = fileList->item(i);
+        QString title = item->data(Qt::UserRole + 2).toString();
+        if (isImageFile(title)) {
+            paths.append(item->data(Qt::UserRole).toString());
+            titles.append(title);
+        }
+    }
+
+    int index = paths.indexOf(encryptedFilePath);
+    if (index < 0 || paths.size() < 2) {
+        return;
+    }
+
+    // Only the most recently opened viewer navigates, older ones keep their image
+    if (m_navigationViewer && m_navigationViewer != viewer) {
+        m_navigationViewer->setNavigationEnabled(false);
+        disconnect(m_navigationViewer, nullptr, this, nullptr);
+    }
+
+    if (!m_imagePrefetcher) {
+        m_imagePrefetcher = new EncryptedImagePrefetcher(m_mainWindow->user_Key, this);
+        m_imagePrefetcher->setMaxFileSize(IMAGEVIEWER_IN_MEMORY_LIMIT);
+        connect(m_imagePrefetcher, &EncryptedImagePrefetcher::imageTooLarge,
+                this, &Operations_EncryptedData::onPrefetchedImageTooLarge);
+        connect(m_imagePrefetcher, &EncryptedImagePrefetcher::imageReady,
+                this, &Operations_EncryptedData::onPrefetchedImageReady);
+        connect(m_imagePrefetcher, &EncryptedImagePrefetcher::imageFailed,
+                this, &Operations_EncryptedData::onPrefetchedImageFailed);
+    }
+
+    m_navigationViewer = viewer;
+    m_navigationPaths = paths;
+    m_navigationTitles = titles;
+    m_navigationIndex = index;
+    m_navigationShownPath = encryptedFilePath;
+
+    viewer->setNavigationEnabled(true);
+    connect(viewer, &ImageViewer::nextImageRequested, this, [this]() { navigateImageViewer(1); });
+    connect(viewer, &ImageViewer::previousImageRequested, this, [this]() { navigateImageViewer(-1); });
+    connect(viewer, &QObject::destroyed, this, [this]() {
+        // QPointer is already null here, drop the prefetched images with the viewer
+        if (!m_navigationViewer && m_imagePrefetcher) {
+            m_imagePrefetcher->clear();
+            m_navigationPaths.clear();
+            m_navigationTitles.clear();
+            m_navigationIndex = -1;
+            m_navigationShownPath.clear();
+        }
+    });
+
+    prefetchAroundNavigationIndex();
+}
+
+void Operations_EncryptedData::navigateImageViewer(int direction)
+{
+    if (!m_navigationViewer || m_navigationIndex < 0) {
+        return;
+    }
+
+    int newIndex = m_navigationIndex + direction;
+    if (newIndex < 0 || newIndex >= m_navigationPaths.size()) {
+        return;
+    }
+
+    m_navigationIndex = newIndex;
+    m_navigationShownPath.clear(); // The viewer still shows the previous image until the new one is ready
+    prefetchAroundNavigationIndex();
+    showNavigationImage();
+}
+
+void Operations_EncryptedData::showNavigationImage()
+{
+    if (!m_navigationViewer || m_navigationIndex < 0 || m_navigationIndex >= m_navigationPaths.size()) {
+        return;
+    }
+
+    const QString& path = m_navigationPaths[m_navigationIndex];
+    const QString& title = m_navigationTitles[m_navigationIndex];
+    if (!m_imagePrefetcher->contains(path)) {
+        // Still decrypting, onPrefetchedImageReady will show it
+        m_navigationViewer->setWindowTitle(QString("Image Viewer - %1 (Loading...)").arg(title));
+        return;
+    }
+
+    EncryptedImagePrefetcher::PrefetchedImage entry = m_imagePrefetcher->image(path);
+    if (!entry.image.isNull()) {
+        m_navigationViewer->loadDecodedImage(entry.image, title);
+    } else {
+        m_navigationViewer->loadImageData(entry.data, title);
+    }
+    m_navigationShownPath = path;
+}
+
+void Operations_EncryptedData::prefetchAroundNavigationIndex()
+{
+    if (!m_imagePrefetcher || m_navigationIndex < 0) {
+        return;
+    }
+
+    // Current image first (unless it is already on screen), then alternating next/previous neighbours
+    QStringList paths;
+    QStringList titles;
+    if (m_navigationPaths[m_navigationIndex] != m_navigationShownPath) {
+        paths.append(m_navigationPaths[m_navigationIndex]);
+        titles.append(m_navigationTitles[m_navigationIndex]);
+    }
+    for (int distance = 1; distance <= IMAGEVIEWER_PREFETCH_NEIGHBOURS; ++distance) {
+        for (int index : {m_navigationIndex + distance, m_navigationIndex - distance}) {
+            if (index >= 0 && index < m_navigationPaths.size()) {
+                paths.append(m_navigationPaths[index]);
+                titles.append(m_navigationTitles[index]);
+            }
+        }
+    }
+
+    m_imagePrefetcher->prefetch(paths, titles);
+}
+
+void Operations_EncryptedData::onPrefetchedImageReady(const QString& encryptedFilePath)
+{
+    if (m_navigationIndex < 0 || m_navigationIndex >= m_navigationPaths.size()) {
+        return;
+    }
+    if (m_navigationPaths[m_navigationIndex] == encryptedFilePath && m_navigationShownPath != encryptedFilePath) {
+        showNavigationImage();
+    }
+}
+
+void Operations_EncryptedData::onPrefetchedImageFailed(const QString& encryptedFilePath, const QString& errorMessage)
+{
+    qWarning() << "Operations_EncryptedData: Failed to prefetch image:" << encryptedFilePath << errorMessage;
+
+    if (!m_navigationViewer || m_navigationIndex < 0 || m_navigationIndex >= m_navigationPaths.size()) {
+        return;
+    }
+    if (m_navigationPaths[m_navigationIndex] == encryptedFilePath) {
+        m_navigationViewer->setWindowTitle(QString("Image Viewer - %1").arg(m_navigationTitles[m_navigationIndex]));
+        QMessageBox::warning(m_navigationViewer, "Image Viewer Error",
+                             "Failed to open image: " + errorMessage);
+    }
+}
+
+void Operations_EncryptedData::onPrefetchedImageTooLarge(const QString& encryptedFilePath)
+{
+    if (!m_navigationViewer || m_navigationIndex < 0 || m_navigationIndex >= m_navigationPaths.size()) {
+        return;
+    }
+    if (m_navigationPaths[m_navigationIndex] != encryptedFilePath) {
+        return; // A neighbour, it is dealt with if the user navigates to it
+    }
+
+    // Too large to hold in memory, decrypt it through a temp file into the same viewer
+    const QString title = m_navigationTitles[m_navigationIndex];
+    openWithImageViewerViaTempFile(encryptedFilePath, title, m_navigationViewer);
+}
+
+void Operations_EncryptedData::markNavigationImageNotLoaded()
+{
+    // The viewer keeps showing the previous image, its title must not claim the new one
+    if (!m_navigationViewer || m_navigationIndex < 0 || m_navigationIndex >= m_navigationPaths.size()) {
+        return;
+    }
+    m_navigationViewer->setWindowTitle(
+        QString("Image Viewer - %1 (Not loaded)").arg(m_navigationTitles[m_navigationIndex]));
+}
+
 // ============================================================================
 // File Opening Helper Functions
 // ============================================================================
@@ -1805,9 +2152,9 @@ void Operations_EncryptedData::cleanupTempFiles()
         // Check if file is in use
         if (!isFileInUse(filePath)) {
             // File is not in use, securely delete it
-            if (QFile::remove(filePath)) {
+            if (OperationsFiles::secureDelete(filePath)) {
                 filesDeleted++;
-                qDebug() << "Operations_EncryptedData: Cleaned up temp file:" << filePath;
+                qDebug() << "Operations_EncryptedData: Queued temp file for secure deletion:" << filePath;
             } else {
                 qWarning() << "Operations_EncryptedData: Failed to clean up temp file:" << filePath;
             }
@@ -2923,6 +3270,36 @@ void Operations_EncryptedData::decryptAndExportVisibleFiles()
         return;
     }
 
+    // Journal the export so it can resume if the app closes before it finishes
+    QStringList sourceFiles;
+    QStringList targetFiles;
+    QStringList originalFilenames;
+    QStringList fileTypes;
+    QVariantList fileSizes;
+    for (const FileExportInfo& info : visibleFiles) {
+        sourceFiles.append(info.sourceFile);
+        targetFiles.append(info.targetFile);
+        originalFilenames.append(info.originalFilename);
+        fileTypes.append(info.fileType);
+        fileSizes.append(info.fileSize);
+    }
+    QVariantMap parameters;
+    parameters["originalFilenames"] = originalFilenames;
+    parameters["fileTypes"] = fileTypes;
+    parameters["fileSizes"] = fileSizes;
+
+    auto journal = std::make_shared<JobJournal>(m_mainWindow->user_Key, m_mainWindow->user_Username);
+    if (!journal->create(JobJournal::JobType::ExportData, sourceFiles, targetFiles, parameters)) {
+        qWarning() << "Operations_EncryptedData: Failed to create job journal, export will not be resumable";
+        journal.reset();
+    }
+
+    startBatchDecryptionJob(visibleFiles, journal);
+}
+
+void Operations_EncryptedData::startBatchDecryptionJob(const QList<FileExportInfo>& visibleFiles,
+                                                       std::shared_ptr<JobJournal> journal)
+{
     // Step 7: Set up progress dialog
     BatchDecryptionProgressDialog* progressDialog = new BatchDecryptionProgressDialog(m_mainWindow);
     progressDialog->setStatusText("Preparing to decrypt files...");
@@ -2930,6 +3307,7 @@ void Operations_EncryptedData::decryptAndExportVisibleFiles()
     // Step 8: Set up worker thread
     m_batchDecryptWorkerThread = new QThread(this);
     m_batchDecryptWorker = new BatchDecryptionWorker(visibleFiles, m_mainWindow->user_Key);
+    m_batchDecryptWorker->setJournal(journal);
     m_batchDecryptWorker->moveToThread(m_batchDecryptWorkerThread);
 
     // Connect signals
@@ -2955,6 +3333,89 @@ void Operations_EncryptedData::decryptAndExportVisibleFiles()
     progressDialog->exec();
 }
 
+void Operations_EncryptedData::resumeInterruptedJobs()
+{
+    const QStringList journalPaths = JobJournal::findJournals(m_mainWindow->user_Username);
+
+    for (const QString& journalPath : journalPaths) {
+        // Only one worker of each kind can run at a time
+        if (m_worker || m_batchDecryptWorker) {
+            return;
+        }
+
+        auto journal = std::make_shared<JobJournal>(m_mainWindow->user_Key, m_mainWindow->user_Username);
+        if (!journal->load(journalPath)) {
+            qWarning() << "Operations_EncryptedData: Removing unreadable job journal:" << journalPath;
+            QFile::remove(journalPath);
+            continue;
+        }
+
+        // TV show imports are resumed by the Shows tab
+        JobJournal::JobType type = journal->type();
+        if (type != JobJournal::JobType::EncryptData && type != JobJournal::JobType::ExportData) {
+            continue;
+        }
+
+        bool isExport = (type == JobJournal::JobType::ExportData);
+        int ret = QMessageBox::question(m_mainWindow, "Resume Interrupted Job",
+                                        QString("An %1 job was interrupted before it finished (%2 of %3 files done).\n\n"
+                                                "Do you want to resume it?")
+                                            .arg(isExport ? "export" : "encryption")
+                                            .arg(journal->completedCount())
+                                            .arg(journal->entryCount()),
+                                        QMessageBox::Yes | QMessageBox::No, QMessageBox::Yes);
+
+        if (ret != QMessageBox::Yes) {
+            // Partially written files are useless without the journal
+            for (int i = 0; i < journal->entryCount(); ++i) {
+                JobJournal::Entry entry = journal->entry(i);
+                if (entry.state == JobJournal::EntryState::InProgress && QFile::exists(entry.targetFile)) {
+                    QFile::remove(entry.targetFile);
+                }
+            }
+            journal->remove();
+            if (!isExport) {
+                populateEncryptedFilesList();
+            }
+            continue;
+        }
+
+        qDebug() << "Operations_EncryptedData: Resuming interrupted job:" << journalPath;
+
+        if (isExport) {
+            QVariantMap parameters = journal->parameters();
+            QStringList sourceFiles = journal->sourceFiles();
+            QStringList targetFiles = journal->targetFiles();
+            QStringList originalFilenames = parameters.value("originalFilenames").toStringList();
+            QStringList fileTypes = parameters.value("fileTypes").toStringList();
+            QVariantList fileSizes = parameters.value("fileSizes").toList();
+
+            if (originalFilenames.size() != sourceFiles.size() || fileTypes.size() != sourceFiles.size() ||
+                fileSizes.size() != sourceFiles.size()) {
+                qWarning() << "Operations_EncryptedData: Export journal is missing file information";
+                journal->remove();
+                continue;
+            }
+
+            QList<FileExportInfo> fileInfos;
+            for (int i = 0; i < sourceFiles.size(); ++i) {
+                FileExportInfo info;
+                info.sourceFile = sourceFiles[i];
+                info.targetFile = targetFiles[i];
+                info.originalFilename = originalFilenames[i];
+                info.fileType = fileTypes[i];
+                info.fileSize = fileSizes[i].toLongLong();
+                fileInfos.append(info);
+            }
+            startBatchDecryptionJob(fileInfos, journal);
+        } else {
+            // Video thumbnails were pre-extracted in the UI thread and are not kept in the journal,
+            // videos that had not started yet are encrypted without a thumbnail
+            startEncryptionJob(journal->sourceFiles(), journal->targetFiles(), QMap<QString, QPixmap>(), journal);
+        }
+    }
+}
+
 QList<FileExportInfo> Operations_EncryptedData::enumerateVisibleEncryptedFiles()
 {
     QList<FileExportInfo> visibleFiles;
@@ -4471,6 +4932,42 @@ void Operations_EncryptedData::openWithImageViewer(const QString& encryptedFileP
     }
     qDebug() << "Encryption key validation successful for ImageViewer";
 
+    // Small images are decrypted straight into memory so no plaintext ever touches the disk
+    qint64 encryptedSize = QFileInfo(encryptedFilePath).size();
+    if (encryptedSize > 0 && encryptedSize <= IMAGEVIEWER_IN_MEMORY_LIMIT) {
+        qDebug() << "Starting in-memory decryption for ImageViewer, encrypted size:" << encryptedSize;
+
+        m_memoryDecryptTitle = originalFilename;
+
+        m_progressDialog = new QProgressDialog("Decrypting image for viewing...", "Cancel", 0, 100, m_mainWindow);
+        m_progressDialog->setWindowTitle("Opening Image");
+        m_progressDialog->setWindowModality(Qt::WindowModal);
+        m_progressDialog->setMinimumDuration(0);
+        m_progressDialog->setValue(0);
+
+        m_memoryDecryptWorkerThread = new QThread(this);
+        m_memoryDecryptWorker = new MemoryDecryptionWorker(encryptedFilePath, encryptionKey, IMAGEVIEWER_IN_MEMORY_LIMIT);
+        m_memoryDecryptWorker->moveToThread(m_memoryDecryptWorkerThread);
+
+        connect(m_memoryDecryptWorkerThread, &QThread::started, m_memoryDecryptWorker, &MemoryDecryptionWorker::doDecryption);
+        connect(m_memoryDecryptWorker, &MemoryDecryptionWorker::progressUpdated, this, &Operations_EncryptedData::onTempDecryptionProgress);
+        connect(m_memoryDecryptWorker, &MemoryDecryptionWorker::decryptionFinished, this, &Operations_EncryptedData::onMemoryDecryptionFinished);
+        connect(m_progressDialog, &QProgressDialog::canceled, this, &Operations_EncryptedData::onMemoryDecryptionCancelled);
+
+        m_memoryDecryptWorkerThread->start();
+        m_progressDialog->exec();
+        return;
+    }
+
+    openWithImageViewerViaTempFile(encryptedFilePath, originalFilename);
+}
+
+void Operations_EncryptedData::openWithImageViewerViaTempFile(const QString& encryptedFilePath, const QString& originalFilename,
+                                                              ImageViewer* targetViewer)
+{
+    QByteArray encryptionKey = m_mainWindow->user_Key;
+    m_tempImageTargetViewer = targetViewer;
+
     // Create temp file path with obfuscated name
     QString tempFilePath = createTempFilePath(originalFilename);
     if (tempFilePath.isEmpty()) {
@@ -38,11 +38,13 @@
 // Include the separated headers
 #include "encrypteddata_encryptionworkers.h"
 #include "encrypteddata_progressdialogs.h"
+#include "encrypteddata_imageprefetcher.h"
 
 // Forward declarations
 class MainWindow;
 class EncryptedFileMetadata;
 class FileIconProvider;
+class ImageViewer;
 
 
 
@@ -92,6 +94,15 @@ private slots:
     void onTempDecryptionFinished(bool success, const QString& errorMessage = QString());
     void onTempDecryptionCancelled();
 
+    // In-memory decryption slots (ImageViewer)
+    void onMemoryDecryptionFinished(bool success, const QString& errorMessage = QString());
+    void onMemoryDecryptionCancelled();
+
+    // ImageViewer navigation slots
+    void onPrefetchedImageReady(const QString& encryptedFilePath);
+    void onPrefetchedImageFailed(const QString& encryptedFilePath, const QString& errorMessage);
+    void onPrefetchedImageTooLarge(const QString& encryptedFilePath);
+
     // Batch decryption slots
     void onBatchDecryptionOverallProgress(int percentage);
     void onBatchDecryptionFileProgress(int percentage);
@@ -148,6 +159,25 @@ private:
     
     TempDecryptionWorker* m_tempDecryptWorker;
     QThread* m_tempDecryptWorkerThread;
+
+    MemoryDecryptionWorker* m_memoryDecryptWorker;
+    QThread* m_memoryDecryptWorkerThread;
+    QString m_memoryDecryptTitle;
+    bool m_memoryDecryptCancelled;
+    // Images up to this size are decrypted straight into memory for the ImageViewer, larger ones
+    // go through a temp file so we never hold several copies of a huge image in RAM. Checked on
+    // the encrypted size up front and on the decrypted size while decrypting (compressed chunks).
+    static const qint64 IMAGEVIEWER_IN_MEMORY_LIMIT = 64 * 1024 * 1024;
+
+    // ImageViewer next/previous navigation over the visible file list
+    QPointer<ImageViewer> m_navigationViewer;
+    QStringList m_navigationPaths;
+    QStringList m_navigationTitles;
+    int m_navigationIndex;
+    QString m_navigationShownPath;
+    QPointer<ImageViewer> m_tempImageTargetViewer;  // Viewer a temp file decryption loads into, null opens a new one
+    EncryptedImagePrefetcher* m_imagePrefetcher;
+    static const int IMAGEVIEWER_PREFETCH_NEIGHBOURS = 2;
     
     BatchDecryptionWorker* m_batchDecryptWorker;
     QThread* m_batchDecryptWorkerThread;
@@ -225,6 +255,13 @@ private:
     void showWindowsOpenWithDialog(const QString& tempFilePath);
     bool isImageFile(const QString& filename) const;
     void openWithImageViewer(const QString& encryptedFilePath, const QString& originalFilename);
+    void openWithImageViewerViaTempFile(const QString& encryptedFilePath, const QString& originalFilename,
+                                        ImageViewer* targetViewer = nullptr);
+    void attachImageViewerNavigation(ImageViewer* viewer, const QString& encryptedFilePath);
+    void navigateImageViewer(int direction);
+    void showNavigationImage();
+    void prefetchAroundNavigationIndex();
+    void markNavigationImageNotLoaded();
 
     // Helper functions - Temp file management
     void startTempFileMonitoring();
@@ -244,6 +281,12 @@ private:
 
     // Helper functions - Metadata repair
     void repairCorruptedMetadata();
+
+    // Resumable encryption/export jobs
+    void startEncryptionJob(const QStringList& sourceFiles, const QStringList& targetFiles,
+                            const QMap<QString, QPixmap>& videoThumbnails, std::shared_ptr<JobJournal> journal);
+    void startBatchDecryptionJob(const QList<FileExportInfo>& fileInfos, std::shared_ptr<JobJournal> journal);
+    void resumeInterruptedJobs();
     QStringList scanForCorruptedMetadata();
     bool showMetadataRepairDialog(int corruptedCount);
     bool repairMetadataFiles(const QStringList& corruptedFiles);
@@ -1,4 +1,5 @@
 #include "operations_passwordmanager.h"
+#include "passwordmanager_vault.h"
 #include "CombinedDelegate.h"
 #include "encryption/CryptoUtils.h"
 #include "operations_files.h"
@@ -63,6 +64,20 @@ static SecureByteArray qStringToSecure(const QString& str) {
     return result;
 }
 
+// Maps the sort by / field names used in the UI to vault fields
+static bool fieldForSortingMethod(const QString& sortingMethod, PasswordVault::Field& outField) {
+    if (sortingMethod == "Password") {
+        outField = PasswordVault::Field::Password;
+    } else if (sortingMethod == "Account") {
+        outField = PasswordVault::Field::Account;
+    } else if (sortingMethod == "Service") {
+        outField = PasswordVault::Field::Service;
+    } else {
+        return false;
+    }
+    return true;
+}
+
 Operations_PasswordManager::Operations_PasswordManager(MainWindow* mainWindow)
     : m_mainWindow(mainWindow), m_currentLoadedValue(QString()), m_clipboardTimer(nullptr), m_pasteDelayTimer(nullptr)
 {
@@ -102,6 +117,10 @@ Operations_PasswordManager::Operations_PasswordManager(MainWindow* mainWindow)
     connect(m_clipboardMonitor, &ClipboardSecurity::ClipboardMonitor::clipboardOverwritten,
             this, &Operations_PasswordManager::onClipboardOverwritten);
 
+    // Decrypted lazily, on first use of the password manager
+    m_vault = new PasswordVault(m_mainWindow->user_Key,
+                                "Data/" + m_mainWindow->user_Username + "/Passwords/passwords.txt");
+
     // Initialize search placeholder text
     updateSearchPlaceholder();
 }
@@ -167,6 +186,21 @@ Operations_PasswordManager::~Operations_PasswordManager()
     if (!m_currentLoadedValue.isEmpty()) {
         secureStringClear(m_currentLoadedValue);
     }
+
+    // SECURITY: The vault scrubs the decrypted entries
+    delete m_vault;
+    m_vault = nullptr;
+}
+
+bool Operations_PasswordManager::ensureVaultLoaded()
+{
+    if (!m_vault) {
+        return false;
+    }
+    if (m_vault->isLoaded()) {
+        return true;
+    }
+    return m_vault->load();
 }
 
 void Operations_PasswordManager::cleanupCachedPasswords()
@@ -439,117 +473,20 @@ void Operations_PasswordManager::SetupPWList(QString sortingMethod, bool applyMa
 
     m_mainWindow->ui->listWidget_PWList->clear();
 
-    // Construct the passwords directory path
-    QString passwordsDir = "Data/" + m_mainWindow->user_Username + "/Passwords/";
-    QString passwordsFilePath = passwordsDir + "passwords.txt";
-
-    // Validate the file path using our centralized function
-    if (!OperationsFiles::validateFilePath(passwordsFilePath, OperationsFiles::FileType::Password, m_mainWindow->user_Key)) {
-        qWarning() << "Password file failed validation check: " << passwordsFilePath;
+    // The passwords file is read once per session, the list is built from the vault's indexes
+    if (!ensureVaultLoaded()) {
         QMessageBox::warning(m_mainWindow, "Password File Error",
                              "The password file appears to be corrupted or tampered with.");
         return;
     }
 
-    // Check if the passwords file exists
-    if (!QFileInfo::exists(passwordsFilePath)) {
-        // If the file doesn't exist, return without an error - there are just no passwords yet
+    PasswordVault::Field field;
+    if (!fieldForSortingMethod(sortingMethod, field)) {
         return;
     }
 
-    // Read the encrypted file content
-    QString fileContent;
-    if (!OperationsFiles::readEncryptedFile(passwordsFilePath, m_mainWindow->user_Key, fileContent)) {
-        qDebug() << "Failed to read passwords file: " << passwordsFilePath;
-        return;
-    }
-
-    // Sets to store unique values
-    QSet<QString> uniqueValues;
-
-    // Parse the passwords file
-    QTextStream fileStream(&fileContent);
-    QString line;
-    QString account, password, service;
-    
-    // Track passwords for secure cleanup
-    QStringList passwordsToClean;
-
-    while (!fileStream.atEnd()) {
-        line = fileStream.readLine();
-
-        // Validate each line from the file
-        InputValidation::ValidationResult lineResult =
-            InputValidation::validateInput(line, InputValidation::InputType::PlainText);
-        if (!lineResult.isValid) {
-            qWarning() << "Invalid content in passwords file: " << lineResult.errorMessage;
-            continue; // Skip this line but continue processing
-        }
-
-        if (line == "<Password>") {
-            // Reset fields for a new password entry
-            account = password = service = "";
-
-            // Read the next lines until empty line or end of file
-            while (!fileStream.atEnd()) {
-                line = fileStream.readLine();
-
-                // Validate each line
-                InputValidation::ValidationResult entryResult =
-                    InputValidation::validateInput(line, InputValidation::InputType::PlainText);
-                if (!entryResult.isValid) {
-                    qWarning() << "Invalid entry in passwords file: " << entryResult.errorMessage;
-                    continue; // Skip this line but continue processing
-                }
-
-                if (line.isEmpty()) {
-                    break; // End of this password entry
-                }
-
-                if (line.startsWith("Account: ")) {
-                    account = line.mid(9); // Remove "Account: " prefix
-                } else if (line.startsWith("Password: ")) {
-                    password = line.mid(10); // Remove "Password: " prefix
-                    passwordsToClean.append(password); // Track for cleanup
-                } else if (line.startsWith("Service: ")) {
-                    service = line.mid(9); // Remove "Service: " prefix
-                }
-            }
-
-            // Validate extracted data
-            bool accountValid = !account.isEmpty() &&
-                                InputValidation::validateInput(account, InputValidation::InputType::Line).isValid;
-            bool passwordValid = !password.isEmpty() &&
-                                 InputValidation::validateInput(password, InputValidation::InputType::Line).isValid;
-            bool serviceValid = !service.isEmpty() &&
-                                InputValidation::validateInput(service, InputValidation::InputType::Line).isValid;
-
-            // Add the value to our set based on sorting method if all fields are valid
-            if (accountValid && passwordValid && serviceValid) {
-                if (sortingMethod == "Password") {
-                    uniqueValues.insert(password);
-                } else if (sortingMethod == "Account") {
-                    uniqueValues.insert(account);
-                } else if (sortingMethod == "Service") {
-                    uniqueValues.insert(service);
-                }
-            }
-            
-            // Clear password for this entry after processing
-            if (!password.isEmpty()) {
-                secureStringClear(password);
-            }
-        }
-    }
-    
-    // Final cleanup of any remaining passwords
-    for (QString& pwd : passwordsToClean) {
-        secureStringClear(pwd);
-    }
-    passwordsToClean.clear();
-
-    // Convert the set to a sorted list with case-insensitive sorting
-    QStringList sortedValues = uniqueValues.values();
+    // Sort the unique values case-insensitively
+    QStringList sortedValues = m_vault->uniqueValues(field);
     std::sort(sortedValues.begin(), sortedValues.end(), 
               [](const QString& a, const QString& b) {
                   return a.compare(b, Qt::CaseInsensitive) < 0;
@@ -699,151 +636,56 @@ void Operations_PasswordManager::UpdatePWDisplayForSelection(const QString &sele
     // Setup the display with the current sorting method
     SetupPWDisplay(sortingMethod);
 
-    // Construct the passwords directory path
-    QString passwordsDir = "Data/" + m_mainWindow->user_Username + "/Passwords/";
-    QString passwordsFilePath = passwordsDir + "passwords.txt";
-
-    // Validate the password file using our centralized function
-    if (!OperationsFiles::validateFilePath(passwordsFilePath, OperationsFiles::FileType::Password, m_mainWindow->user_Key)) {
-        qWarning() << "Password file failed validation check: " << passwordsFilePath;
+    if (!ensureVaultLoaded()) {
         QMessageBox::warning(m_mainWindow, "Password File Error",
                              "The password file appears to be corrupted or tampered with.");
         return;
     }
 
-    // Check if the passwords file exists
-    if (!QFileInfo::exists(passwordsFilePath)) {
-        return; // No passwords to display
-    }
-
-    // Read the encrypted file content
-    QString fileContent;
-    if (!OperationsFiles::readEncryptedFile(passwordsFilePath, m_mainWindow->user_Key, fileContent)) {
-        qDebug() << "Failed to read passwords file: " << passwordsFilePath;
+    PasswordVault::Field field;
+    if (!fieldForSortingMethod(sortingMethod, field)) {
         return;
     }
 
-    // Parse the passwords file and populate the table
-    QTextStream fileStream(&fileContent);
-    QString line;
-    QString account, password, service;
+    // Populate the table with the entries matching the selection
+    const QVector<int> entryIndexes = m_vault->find(field, selectedValue);
     int row = 0;
-    
-    // Track all passwords for secure cleanup
-    QStringList passwordsToClean;
-
-    while (!fileStream.atEnd()) {
-        line = fileStream.readLine();
-
-        // Validate each line from the file
-        InputValidation::ValidationResult lineResult =
-            InputValidation::validateInput(line, InputValidation::InputType::PlainText);
-        if (!lineResult.isValid) {
-            qWarning() << "Invalid content in passwords file: " << lineResult.errorMessage;
-            continue; // Skip this line but continue processing
+    for (int entryIndex : entryIndexes) {
+        QString account = m_vault->account(entryIndex);
+        QString password = m_vault->passwordText(entryIndex);
+        QString service = m_vault->service(entryIndex);
+
+        m_mainWindow->ui->tableWidget_PWDisplay->insertRow(row);
+
+        if (sortingMethod == "Password") {
+            // First column is Password (the sorting method)
+            m_mainWindow->ui->tableWidget_PWDisplay->setItem(row, 0, new QTableWidgetItem(password));
+            m_mainWindow->ui->tableWidget_PWDisplay->setItem(row, 1, new QTableWidgetItem(account));
+            m_mainWindow->ui->tableWidget_PWDisplay->setItem(row, 2, new QTableWidgetItem(service));
+        } else if (sortingMethod == "Account") {
+            // First column is Account (the sorting method)
+            m_mainWindow->ui->tableWidget_PWDisplay->setItem(row, 0, new QTableWidgetItem(account));
+            m_mainWindow->ui->tableWidget_PWDisplay->setItem(row, 1, new QTableWidgetItem(password));
+            m_mainWindow->ui->tableWidget_PWDisplay->setItem(row, 2, new QTableWidgetItem(service));
+        } else if (sortingMethod == "Service") {
+            // First column is Service (the sorting method)
+            m_mainWindow->ui->tableWidget_PWDisplay->setItem(row, 0, new QTableWidgetItem(service));
+            m_mainWindow->ui->tableWidget_PWDisplay->setItem(row, 1, new QTableWidgetItem(account));
+            m_mainWindow->ui->tableWidget_PWDisplay->setItem(row, 2, new QTableWidgetItem(password));
         }
 
-        if (line == "<Password>") {
-            // Reset fields for a new password entry
-            account = password = service = "";
-
-            // Read the next lines until empty line or end of file
-            while (!fileStream.atEnd()) {
-                line = fileStream.readLine();
+        // Store the complete entry data as item data for reference
+        // Use a role that won't conflict with display or edit roles (Qt::UserRole)
+        QTableWidgetItem* firstItem = m_mainWindow->ui->tableWidget_PWDisplay->item(row, 0);
+        firstItem->setData(Qt::UserRole, account); // Store account
+        firstItem->setData(Qt::UserRole + 1, password); // Store password
+        firstItem->setData(Qt::UserRole + 2, service); // Store service
 
-                // Validate each line
-                InputValidation::ValidationResult entryResult =
-                    InputValidation::validateInput(line, InputValidation::InputType::PlainText);
-                if (!entryResult.isValid) {
-                    qWarning() << "Invalid entry in passwords file: " << entryResult.errorMessage;
-                    continue; // Skip this line but continue processing
-                }
-
-                if (line.isEmpty()) {
-                    break; // End of this password entry
-                }
-
-                if (line.startsWith("Account: ")) {
-                    account = line.mid(9); // Remove "Account: " prefix
-                } else if (line.startsWith("Password: ")) {
-                    password = line.mid(10); // Remove "Password: " prefix
-                    passwordsToClean.append(password); // Track for cleanup
-                } else if (line.startsWith("Service: ")) {
-                    service = line.mid(9); // Remove "Service: " prefix
-                }
-            }
+        row++;
 
-            // Validate extracted data
-            bool accountValid = !account.isEmpty() &&
-                                InputValidation::validateInput(account, InputValidation::InputType::Line).isValid;
-            bool passwordValid = !password.isEmpty() &&
-                                 InputValidation::validateInput(password, InputValidation::InputType::Line).isValid;
-            bool serviceValid = !service.isEmpty() &&
-                                InputValidation::validateInput(service, InputValidation::InputType::Line).isValid;
-
-            // Check if this entry matches our selection
-            bool matchesSelection = false;
-
-            if (sortingMethod == "Password" && password == selectedValue) {
-                matchesSelection = true;
-            } else if (sortingMethod == "Account" && account == selectedValue) {
-                matchesSelection = true;
-            } else if (sortingMethod == "Service" && service == selectedValue) {
-                matchesSelection = true;
-            }
-            // Ensure consistent display of (None) values
-            if (account.isEmpty()) {
-                account = "(None)";
-            }
-            if (password.isEmpty()) {
-                password = "(None)";
-            }
-            if (service.isEmpty()) {
-                service = "(None)";
-            }
-            // If this entry matches and all fields are valid, add it to the table
-            if (matchesSelection && accountValid && passwordValid && serviceValid) {
-                m_mainWindow->ui->tableWidget_PWDisplay->insertRow(row);
-
-                if (sortingMethod == "Password") {
-                    // First column is Password (the sorting method)
-                    m_mainWindow->ui->tableWidget_PWDisplay->setItem(row, 0, new QTableWidgetItem(password));
-                    m_mainWindow->ui->tableWidget_PWDisplay->setItem(row, 1, new QTableWidgetItem(account));
-                    m_mainWindow->ui->tableWidget_PWDisplay->setItem(row, 2, new QTableWidgetItem(service));
-                } else if (sortingMethod == "Account") {
-                    // First column is Account (the sorting method)
-                    m_mainWindow->ui->tableWidget_PWDisplay->setItem(row, 0, new QTableWidgetItem(account));
-                    m_mainWindow->ui->tableWidget_PWDisplay->setItem(row, 1, new QTableWidgetItem(password));
-                    m_mainWindow->ui->tableWidget_PWDisplay->setItem(row, 2, new QTableWidgetItem(service));
-                } else if (sortingMethod == "Service") {
-                    // First column is Service (the sorting method)
-                    m_mainWindow->ui->tableWidget_PWDisplay->setItem(row, 0, new QTableWidgetItem(service));
-                    m_mainWindow->ui->tableWidget_PWDisplay->setItem(row, 1, new QTableWidgetItem(account));
-                    m_mainWindow->ui->tableWidget_PWDisplay->setItem(row, 2, new QTableWidgetItem(password));
-                }
-
-                // Store the complete entry data as item data for reference
-                // Use a role that won't conflict with display or edit roles (Qt::UserRole)
-                QTableWidgetItem* firstItem = m_mainWindow->ui->tableWidget_PWDisplay->item(row, 0);
-                firstItem->setData(Qt::UserRole, account); // Store account
-                firstItem->setData(Qt::UserRole + 1, password); // Store password
-                firstItem->setData(Qt::UserRole + 2, service); // Store service
-
-                row++;
-            }
-            
-            // Clear password for this entry
-            if (!password.isEmpty() && password != "(None)") {
-                secureStringClear(password);
-            }
-        }
-    }
-    
-    // Secure cleanup of all tracked passwords
-    for (QString& pwd : passwordsToClean) {
-        secureStringClear(pwd);
+        // Clear the local password copy
+        secureStringClear(password);
     }
-    passwordsToClean.clear();
 
     // Set default sort on the second column (index 1) in ascending order
     m_mainWindow->ui->tableWidget_PWDisplay->horizontalHeader()->setSortIndicator(1, Qt::AscendingOrder);
@@ -864,7 +706,6 @@ void Operations_PasswordManager::AddPassword(QString account, const SecureByteAr
 
     // Construct the passwords directory path
     QString passwordsDir = "Data/" + m_mainWindow->user_Username + "/Passwords/";
-    QString passwordsFilePath = passwordsDir + "passwords.txt";
 
     // Ensure the directory exists
     if (!OperationsFiles::ensureDirectoryExists(passwordsDir)) {
@@ -873,119 +714,20 @@ void Operations_PasswordManager::AddPassword(QString account, const SecureByteAr
         return;
     }
 
-    // String to hold all passwords content
-    QString passwordsContent;
-    // Flag to check for duplicates
-    bool duplicateFound = false;
-
-    // If file exists, read it and check for duplicate entries
-    if (QFileInfo::exists(passwordsFilePath)) {
-        // Validate the password file
-        if (!OperationsFiles::validateFilePath(passwordsFilePath, OperationsFiles::FileType::Password, m_mainWindow->user_Key)) {
-            qWarning() << "Password file failed validation check: " << passwordsFilePath;
-            QMessageBox::warning(m_mainWindow, "Password File Error",
-                                 "The existing password file appears to be corrupted or tampered with.");
-            return;
-        }
-
-        // Read the encrypted file content
-        if (!OperationsFiles::readEncryptedFile(passwordsFilePath, m_mainWindow->user_Key, passwordsContent)) {
-            qDebug() << "Failed to read passwords file: " << passwordsFilePath;
-            return;
-        }
-
-        // Parse file to check for duplicates
-        QTextStream fileStream(&passwordsContent);
-        QString line;
-        bool inPasswordBlock = false;
-        QString currentAccount, currentPassword, currentService;
-        QString processedContent;
-
-        while (!fileStream.atEnd()) {
-            line = fileStream.readLine();
-
-            // Validate each line
-            InputValidation::ValidationResult lineResult =
-                InputValidation::validateInput(line, InputValidation::InputType::PlainText);
-
-            if (!lineResult.isValid) {
-                qWarning() << "Invalid content in passwords file: " << lineResult.errorMessage;
-                continue;
-            }
-
-            // Start of a password entry
-            if (line == "<Password>") {
-                inPasswordBlock = true;
-                currentAccount = currentPassword = currentService = "";
-                processedContent += line + "\n";  // Add this line to content
-                continue;
-            }
-
-            // Process lines inside a password block
-            if (inPasswordBlock) {
-                processedContent += line + "\n";  // Add this line to content
-
-                if (line.isEmpty()) {
-                    // End of password block
-                    inPasswordBlock = false;
-
-                    // Check if this is a duplicate entry
-                    if (currentAccount == account &&
-                    currentPassword == password &&
-                    currentService == service) {
-                    duplicateFound = true;
-                    }
-            
-            // Clear the current password after checking
-            if (!currentPassword.isEmpty()) {
-                secureStringClear(currentPassword);
-            }
-                }
-                else if (line.startsWith("Account: ")) {
-                    currentAccount = line.mid(9);  // Remove "Account: " prefix
-                }
-                else if (line.startsWith("Password: ")) {
-                    // Clear any previous password before assigning new one
-                    if (!currentPassword.isEmpty()) {
-                        secureStringClear(currentPassword);
-                    }
-                    currentPassword = line.mid(10);  // Remove "Password: " prefix
-                }
-                else if (line.startsWith("Service: ")) {
-                    currentService = line.mid(9);  // Remove "Service: " prefix
-                }
-            }
-            else {
-                // Outside a password block, just add to processed content
-                processedContent += line + "\n";
-            }
-        }
-
-        // Update the passwords content with processed content
-        passwordsContent = processedContent;
+    if (!ensureVaultLoaded()) {
+        QMessageBox::warning(m_mainWindow, "Password File Error",
+                             "The existing password file appears to be corrupted or tampered with.");
+        return;
     }
 
     // If duplicate found, return without adding new entry
-    if (duplicateFound) {
+    if (m_vault->contains(account, password, service)) {
         // Return silently as requested
         return;
     }
 
-    // Format the new password entry
-    QString passwordStr = secureToQString(password);
-    QString newPasswordEntry = "<Password>\n"
-                               "Account: " + account + "\n"
-                                           "Password: " + passwordStr + "\n"
-                                            "Service: " + service + "\n\n";
-    // Clear the temporary password string
-    secureStringClear(passwordStr);
-
-    // Add the new password entry to the content
-    passwordsContent += newPasswordEntry;
-
-    // Write the updated content to the encrypted file
-    if (!OperationsFiles::writeEncryptedFile(passwordsFilePath, m_mainWindow->user_Key, passwordsContent)) {
-        qDebug() << "Failed to write passwords file: " << passwordsFilePath;
+    if (!m_vault->add(account, password, service)) {
+        qDebug() << "Failed to write passwords file";
         QMessageBox::warning(m_mainWindow, "Encryption Error",
                              "Failed to encrypt passwords file. Your passwords may not be secure.");
         return;
@@ -1047,128 +789,13 @@ bool Operations_PasswordManager::ModifyPassword(const QString &oldAccount, const
         return true;  // No changes needed
     }
 
-    // Construct the passwords directory path
-    QString passwordsDir = "Data/" + m_mainWindow->user_Username + "/Passwords/";
-    QString passwordsFilePath = passwordsDir + "passwords.txt";
-
-    // Validate the password file
-    if (!OperationsFiles::validateFilePath(passwordsFilePath, OperationsFiles::FileType::Password, m_mainWindow->user_Key)) {
-        qWarning() << "Password file failed validation check: " << passwordsFilePath;
+    if (!ensureVaultLoaded()) {
+        qWarning() << "Failed to load password vault";
         return false;
     }
 
-    // Check if the passwords file exists
-    if (!QFileInfo::exists(passwordsFilePath)) {
-        return false;  // No passwords file to modify
-    }
-
-    // Convert passwords to strings for comparison (will be cleared after)
-    QString oldPasswordStr = secureToQString(oldPassword);
-    QString newPasswordStr = secureToQString(newPassword);
-    
-    // Use the processEncryptedFile function to modify the password file
-    bool success = OperationsFiles::processEncryptedFile(passwordsFilePath, m_mainWindow->user_Key,
-                                                         [&](QString& content) -> bool {
-                                                             // Process the content to modify the password
-                                                             QTextStream fileStream(&content);
-                                                             QString line;
-                                                             bool oldPasswordFound = false;
-                                                             bool newPasswordExists = false;
-
-                                                             // Temporary storage for file content without the old password
-                                                             QString newFileContent;
-
-                                                             // Variables to track current password entry
-                                                             bool inPasswordBlock = false;
-                                                             QString currentAccount, currentPassword, currentService;
-                                                             QString currentBlock;
-
-                                                             while (!fileStream.atEnd()) {
-                                                                 line = fileStream.readLine();
-
-                                                                 // Start of a password entry
-                                                                 if (line == "<Password>") {
-                                                                     inPasswordBlock = true;
-                                                                     currentBlock = line + "\n";
-                                                                     currentAccount = currentPassword = currentService = "";
-                                                                     continue;
-                                                                 }
-
-                                                                 // End of a password entry (empty line)
-                                                                 if (inPasswordBlock && line.isEmpty()) {
-                                                                     inPasswordBlock = false;
-
-                                                                     // Check if this is the password to be removed
-                                                                     if (currentAccount == oldAccount && currentPassword == oldPasswordStr && currentService == oldService) {
-                                                                         oldPasswordFound = true;
-                                                                         // Don't add this block to the new content
-                                                                     }
-                                                                     // Check if this matches the new password we want to add
-                                                                     else if (currentAccount == modifiedNewAccount && currentPassword == newPasswordStr && currentService == modifiedNewService) {
-                                                                         newPasswordExists = true;
-                                                                         // Still add this block to the new content
-                                                                         newFileContent += currentBlock + "\n";
-                                                                     }
-                                                                     else {
-                                                                         // Add this block to the new content
-                                                                         newFileContent += currentBlock + "\n";
-                                                                     }
-                                                                     
-                                                                     // Clear the current password after processing
-                                                                     if (!currentPassword.isEmpty()) {
-                                                                         secureStringClear(currentPassword);
-                                                                     }
-                                                                     continue;
-                                                                 }
-
-                                                                 // Inside a password block
-                                                                 if (inPasswordBlock) {
-                                                                     currentBlock += line + "\n";
-
-                                                                     if (line.startsWith("Account: ")) {
-                                                                         currentAccount = line.mid(9);  // Remove "Account: " prefix
-                                                                     } else if (line.startsWith("Password: ")) {
-                                                                         // Clear any previous password before assigning new one
-                                                                         if (!currentPassword.isEmpty()) {
-                                                                             secureStringClear(currentPassword);
-                                                                         }
-                                                                         currentPassword = line.mid(10);  // Remove "Password: " prefix
-                                                                     } else if (line.startsWith("Service: ")) {
-                                                                         currentService = line.mid(9);  // Remove "Service: " prefix
-                                                                     }
-                                                                 }
-                                                                 else {
-                                                                     // Outside a password block, just add to new content
-                                                                     newFileContent += line + "\n";
-                                                                 }
-                                                             }
-
-                                                             // If we didn't find the old password, something's wrong
-                                                             if (!oldPasswordFound) {
-                                                                 return false;
-                                                             }
-
-                                                             // If the new password doesn't already exist, add it
-                                                             if (!newPasswordExists) {
-                                                                 QString newPasswordEntry = "<Password>\n"
-                                                                                            "Account: " + modifiedNewAccount + "\n"
-                                                                                                                   "Password: " + newPasswordStr + "\n"
-                                                                                                            "Service: " + modifiedNewService + "\n\n";
-                                                                 newFileContent += newPasswordEntry;
-                                                             }
-
-                                                             // Update the content
-                                                             content = newFileContent;
-                                                             return true;
-                                                         }
-                                                         );
-
-    // Clear the temporary password strings
-    secureStringClear(oldPasswordStr);
-    secureStringClear(newPasswordStr);
-    
-    if (!success) {
-        qDebug() << "Failed to modify password in file: " << passwordsFilePath;
+    if (!m_vault->modify(oldAccount, oldPassword, oldService, modifiedNewAccount, newPassword, modifiedNewService)) {
+        qDebug() << "Failed to modify password in vault";
         return false;
     }
 
@@ -1215,234 +842,30 @@ bool Operations_PasswordManager::ModifyPassword(const QString &oldAccount, const
 
 bool Operations_PasswordManager::DeletePassword(const QString &account, const SecureByteArray &password, const QString &service)
 {
-    // Convert password to string for comparison
-    QString passwordStr = secureToQString(password);
-    
-    // Construct the passwords directory path
-    QString passwordsDir = "Data/" + m_mainWindow->user_Username + "/Passwords/";
-    QString passwordsFilePath = passwordsDir + "passwords.txt";
-
-    // Validate the password file
-    if (!OperationsFiles::validateFilePath(passwordsFilePath, OperationsFiles::FileType::Password, m_mainWindow->user_Key)) {
-        qWarning() << "Password file failed validation check: " << passwordsFilePath;
-        secureStringClear(passwordStr);
-        return false;
-    }
-
-    // Check if the passwords file exists
-    if (!QFileInfo::exists(passwordsFilePath)) {
-        secureStringClear(passwordStr);
-        return false; // No passwords file to modify
-    }
-
-    // Read the file to check how many passwords it contains
-    QString fileContent;
-    if (!OperationsFiles::readEncryptedFile(passwordsFilePath, m_mainWindow->user_Key, fileContent)) {
-        qDebug() << "Failed to read passwords file: " << passwordsFilePath;
-        secureStringClear(passwordStr);
+    if (!ensureVaultLoaded()) {
+        qWarning() << "Failed to load password vault";
         return false;
     }
 
-    // Count password entries
-    int passwordCount = fileContent.count("<Password>");
-
-    // Check if this is the only entry
-    QRegularExpression pattern(
-        "<Password>\\s*"
-        "Account: " + QRegularExpression::escape(account) + "\\s*"
-                                                "Password: " + QRegularExpression::escape(passwordStr) + "\\s*"
-                                                 "Service: " + QRegularExpression::escape(service) + "\\s*\\n"
-        );
-
-    bool isLastEntry = (passwordCount == 1 && pattern.match(fileContent).hasMatch());
-
-    if (isLastEntry) {
-        // Delete the entire file if this is the last entry
-        QFile file(passwordsFilePath);
-        bool result = file.remove();
-        secureStringClear(passwordStr);
-        return result;
-    } else {
-        // Otherwise, use the processEncryptedFile function to modify the password file
-        bool result = OperationsFiles::processEncryptedFile(passwordsFilePath, m_mainWindow->user_Key,
-                                                     [&pattern](QString& content) -> bool {
-                                                         // Replace the password entry with an empty string
-                                                         content.replace(pattern, "");
-                                                         return true;
-                                                     });
-        secureStringClear(passwordStr);
-        return result;
-    }
+    // The vault removes the file itself once the last entry is gone
+    return m_vault->remove(account, password, service);
 }
 
 bool Operations_PasswordManager::DeleteAllAssociatedPasswords(const QString &value, const QString &field)
 {
-    // Construct the passwords directory path
-    QString passwordsDir = "Data/" + m_mainWindow->user_Username + "/Passwords/";
-    QString passwordsFilePath = passwordsDir + "passwords.txt";
-
-    // Validate the password file
-    if (!OperationsFiles::validateFilePath(passwordsFilePath, OperationsFiles::FileType::Password, m_mainWindow->user_Key)) {
-        qWarning() << "Password file failed validation check: " << passwordsFilePath;
+    PasswordVault::Field vaultField;
+    if (!fieldForSortingMethod(field, vaultField)) {
+        qWarning() << "Unknown password field: " << field;
         return false;
     }
 
-    // Check if the passwords file exists
-    if (!QFileInfo::exists(passwordsFilePath)) {
-        return false; // No passwords file to modify
-    }
-
-    // Read the file to check how many passwords it contains
-    QString fileContent;
-    if (!OperationsFiles::readEncryptedFile(passwordsFilePath, m_mainWindow->user_Key, fileContent)) {
-        qDebug() << "Failed to read passwords file: " << passwordsFilePath;
+    if (!ensureVaultLoaded()) {
+        qWarning() << "Failed to load password vault";
         return false;
     }
 
-    // Count total password entries
-    int passwordCount = fileContent.count("<Password>");
-
-    // Count passwords matching our criteria
-    int matchingCount = 0;
-    QTextStream fileStream(&fileContent);
-    QString line;
-    bool inPasswordBlock = false;
-    QString currentAccount, currentPassword, currentService;
-
-    while (!fileStream.atEnd()) {
-        line = fileStream.readLine();
-
-        if (line == "<Password>") {
-            inPasswordBlock = true;
-            currentAccount = currentPassword = currentService = "";
-            continue;
-        }
-
-        if (inPasswordBlock && line.isEmpty()) {
-            inPasswordBlock = false;
-
-            // Check if this block matches our criteria
-            bool shouldDelete = false;
-
-            if (field == "Password" && currentPassword == value) {
-                shouldDelete = true;
-            } else if (field == "Account" && currentAccount == value) {
-                shouldDelete = true;
-            } else if (field == "Service" && currentService == value) {
-                shouldDelete = true;
-            }
-
-            if (shouldDelete) {
-                matchingCount++;
-            }
-            
-            // Clear the current password after checking
-            if (!currentPassword.isEmpty()) {
-                secureStringClear(currentPassword);
-            }
-            continue;
-        }
-
-        if (inPasswordBlock) {
-            if (line.startsWith("Account: ")) {
-                currentAccount = line.mid(9);  // Remove "Account: " prefix
-            } else if (line.startsWith("Password: ")) {
-                // Clear any previous password before assigning new one
-                if (!currentPassword.isEmpty()) {
-                    secureStringClear(currentPassword);
-                }
-                currentPassword = line.mid(10);  // Remove "Password: " prefix
-            } else if (line.startsWith("Service: ")) {
-                currentService = line.mid(9);  // Remove "Service: " prefix
-            }
-        }
-    }
-
-    // Check if we're deleting all passwords
-    if (matchingCount == passwordCount) {
-        // Delete the entire file
-        QFile file(passwordsFilePath);
-        return file.remove();
-    } else {
-        // Otherwise, use the processEncryptedFile function to modify the password file
-        return OperationsFiles::processEncryptedFile(passwordsFilePath, m_mainWindow->user_Key,
-                                                     [&value, &field](QString& content) -> bool {
-                                                         // Process the content to remove all matching passwords
-                                                         QTextStream fileStream(&content);
-                                                         QString line;
-                                                         QString newFileContent;
-                                                         bool inPasswordBlock = false;
-                                                         bool skipCurrentBlock = false;
-                                                         QString currentAccount, currentPassword, currentService;
-                                                         QString currentBlock;
-
-                                                         while (!fileStream.atEnd()) {
-                                                             line = fileStream.readLine();
-
-                                                             // Start of a password entry
-                                                             if (line == "<Password>") {
-                                                                 inPasswordBlock = true;
-                                                                 skipCurrentBlock = false;
-                                                                 currentBlock = line + "\n";
-                                                                 currentAccount = currentPassword = currentService = "";
-                                                                 continue;
-                                                             }
-
-                                                             // End of a password entry (empty line)
-                                                             if (inPasswordBlock && line.isEmpty()) {
-                                                                 inPasswordBlock = false;
-
-                                                                 // Check if this block matches our criteria to delete
-                                                                 bool shouldDelete = false;
-
-                                                                 if (field == "Password" && currentPassword == value) {
-                                                                     shouldDelete = true;
-                                                                 } else if (field == "Account" && currentAccount == value) {
-                                                                     shouldDelete = true;
-                                                                 } else if (field == "Service" && currentService == value) {
-                                                                     shouldDelete = true;
-                                                                 }
-
-                                                                 // Only add to new content if we're not deleting this block
-                                                                 if (!shouldDelete) {
-                                                                     newFileContent += currentBlock + "\n";
-                                                                 }
-                                                                 
-                                                                 // Clear the current password after processing
-                                                                 if (!currentPassword.isEmpty()) {
-                                                                     secureStringClear(currentPassword);
-                                                                 }
-                                                                 continue;
-                                                             }
-
-                                                             // Inside a password block
-                                                             if (inPasswordBlock) {
-                                                                 currentBlock += line + "\n";
-
-                                                                 if (line.startsWith("Account: ")) {
-                                                                     currentAccount = line.mid(9);  // Remove "Account: " prefix
-                                                                 } else if (line.startsWith("Password: ")) {
-                                                                     // Clear any previous password before assigning new one
-                                                                     if (!currentPassword.isEmpty()) {
-                                                                         secureStringClear(currentPassword);
-                                                                     }
-                                                                     currentPassword = line.mid(10);  // Remove "Password: " prefix
-                                                                 } else if (line.startsWith("Service: ")) {
-                                                                     currentService = line.mid(9);  // Remove "Service: " prefix
-                                                                 }
-                                                             }
-                                                             else {
-                                                                 // Outside a password block, just add to new content
-                                                                 newFileContent += line + "\n";
-                                                             }
-                                                         }
-
-                                                         // Update the content
-                                                         content = newFileContent;
-                                                         return true;
-                                                     }
-                                                     );
-    }
+    // The vault removes the file itself once the last entry is gone
+    return m_vault->removeAll(vaultField, value);
 }
 
 //-------------Context Menu----------//
@@ -12,6 +12,7 @@
 #include <QMessageBox>
 
 class MainWindow;
+class PasswordVault;
 class Operations_PasswordManager : public QObject
 {
     Q_OBJECT
@@ -47,6 +48,10 @@ private:
     // Secure cleanup helper
     void cleanupCachedPasswords();
 
+    // Decrypted passwords file, read once per session
+    PasswordVault* m_vault = nullptr;
+    bool ensureVaultLoaded();
+
     SafeTimer* m_clipboardTimer = nullptr; // Timer for clearing clipboard
     SafeTimer* m_pasteDelayTimer = nullptr; // Timer for delay after paste detection
     ClipboardSecurity::ClipboardMonitor* m_clipboardMonitor = nullptr; // Monitor for paste/overwrite detection
@@ -0,0 +1,551 @@
+#include "passwordmanager_vault.h"
+#include "encryption/CryptoUtils.h"
+#include "operations_files.h"
+#include "inputvalidation.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+#include <QDebug>
+#include <algorithm>
+#include <functional>
+#include <cstring>  // For std::memset, std::memcpy, std::memcmp
+
+namespace {
+const char BLOCK_START[] = "<Password>";
+const char ACCOUNT_PREFIX[] = "Account: ";
+const char PASSWORD_PREFIX[] = "Password: ";
+const char SERVICE_PREFIX[] = "Service: ";
+
+// Encrypted data without any content is just the nonce (12 bytes) and the tag (16 bytes)
+const qint64 EMPTY_ENCRYPTED_SIZE = 28;
+
+void scrubString(QString& str)
+{
+    if (!str.isEmpty()) {
+        str.fill(QChar(0));
+        str.clear();
+    }
+}
+
+bool isValidField(const QString& value)
+{
+    return !value.isEmpty() &&
+           InputValidation::validateInput(value, InputValidation::InputType::Line).isValid;
+}
+}
+
+PasswordVault::PasswordVault(const QByteArray& encryptionKey, const QString& passwordsFilePath)
+    : m_encryptionKey(encryptionKey)
+    , m_passwordsFilePath(passwordsFilePath)
+    , m_loaded(false)
+{
+}
+
+PasswordVault::~PasswordVault()
+{
+    unload();
+
+    // SECURITY: Clear sensitive data
+    if (!m_encryptionKey.isEmpty()) {
+        volatile char* keyData = const_cast<volatile char*>(m_encryptionKey.data());
+        std::memset(const_cast<char*>(keyData), 0, m_encryptionKey.size());
+        m_encryptionKey.clear();
+    }
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+bool PasswordVault::load()
+{
+    unload();
+
+    if (OperationsFiles::isWeakEncryptionKey(m_encryptionKey)) {
+        qWarning() << "PasswordVault: Refusing to use weak encryption key";
+        return false;
+    }
+    if (!OperationsFiles::validateFilePath(m_passwordsFilePath, OperationsFiles::FileType::Password, m_encryptionKey)) {
+        qWarning() << "PasswordVault: Password file failed validation check:" << m_passwordsFilePath;
+        return false;
+    }
+
+    QFileInfo fileInfo(m_passwordsFilePath);
+    if (!fileInfo.exists()) {
+        // No passwords yet
+        m_loaded = true;
+        return true;
+    }
+    if (fileInfo.size() > OperationsFiles::MAX_ENCRYPTED_FILE_SIZE) {
+        qWarning() << "PasswordVault: Password file too large:" << fileInfo.size() << "bytes";
+        return false;
+    }
+
+    QFile file(m_passwordsFilePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "PasswordVault: Failed to open password file:" << m_passwordsFilePath;
+        return false;
+    }
+    // SECURITY: The decrypted file is never copied or shared, it is parsed in place and scrubbed
+    // before this returns. Only the passwords are kept, in locked memory.
+    QByteArray plaintext = CryptoUtils::Encryption_DecryptBArray(m_encryptionKey, file.readAll());
+    file.close();
+    if (plaintext.isEmpty() && fileInfo.size() > EMPTY_ENCRYPTED_SIZE) {
+        qWarning() << "PasswordVault: Failed to decrypt password file:" << m_passwordsFilePath;
+        return false;
+    }
+
+    // Entries point into the plaintext while parsing, the passwords are moved to m_secrets after
+    const QByteArray& text = plaintext;
+    const int accountPrefixLength = static_cast<int>(qstrlen(ACCOUNT_PREFIX));
+    const int passwordPrefixLength = static_cast<int>(qstrlen(PASSWORD_PREFIX));
+    const int servicePrefixLength = static_cast<int>(qstrlen(SERVICE_PREFIX));
+
+    bool inBlock = false;
+    bool passwordValid = false;
+    Entry current;
+    auto finishEntry = [&]() {
+        current.listed = isValidField(current.account) && current.passwordLength > 0 && passwordValid
+                         && isValidField(current.service);
+        m_entries.append(current);
+        current = Entry();
+        passwordValid = false;
+        inBlock = false;
+    };
+
+    int position = 0;
+    while (position < text.size()) {
+        int end = text.indexOf('\n', position);
+        if (end < 0) {
+            end = text.size();
+        }
+        const int lineStart = position;
+        int lineLength = end - position;
+        if (lineLength > 0 && text.at(end - 1) == '\r') {
+            --lineLength;
+        }
+        position = end + 1;
+
+        QString line = QString::fromUtf8(text.constData() + lineStart, lineLength);
+        InputValidation::ValidationResult lineResult =
+            InputValidation::validateInput(line, InputValidation::InputType::PlainText);
+        if (!lineResult.isValid) {
+            qWarning() << "PasswordVault: Invalid content in passwords file:" << lineResult.errorMessage;
+            scrubString(line);
+            continue;
+        }
+
+        if (!inBlock) {
+            if (line == BLOCK_START) {
+                inBlock = true;
+            }
+        } else if (line.isEmpty()) {
+            finishEntry();
+        } else if (line.startsWith(ACCOUNT_PREFIX)) {
+            current.account = line.mid(accountPrefixLength);
+        } else if (line.startsWith(PASSWORD_PREFIX)) {
+            QString password = line.mid(passwordPrefixLength);
+            passwordValid = isValidField(password);
+            scrubString(password);
+            // The prefix is ASCII, so its length in bytes is its length in characters
+            current.passwordOffset = lineStart + passwordPrefixLength;
+            current.passwordLength = lineLength - passwordPrefixLength;
+        } else if (line.startsWith(SERVICE_PREFIX)) {
+            current.service = line.mid(servicePrefixLength);
+        }
+        scrubString(line);
+    }
+    if (inBlock) {
+        finishEntry();
+    }
+
+    int secretsSize = 0;
+    for (const Entry& entry : m_entries) {
+        secretsSize += entry.passwordLength;
+    }
+    if (secretsSize > 0) {
+        SecureByteArray secrets(secretsSize);
+        char* out = secrets.data();
+        int offset = 0;
+        for (Entry& entry : m_entries) {
+            std::memcpy(out + offset, text.constData() + entry.passwordOffset, entry.passwordLength);
+            entry.passwordOffset = offset;
+            offset += entry.passwordLength;
+        }
+        m_secrets = std::move(secrets);
+    }
+    plaintext.fill('\0');
+
+    rebuildIndexes();
+    m_loaded = true;
+    qDebug() << "PasswordVault: Loaded" << m_entries.size() << "entries";
+    return true;
+}
+
+void PasswordVault::unload()
+{
+    scrubEntries();
+    m_secrets.unlockMemory();
+    m_secrets.clear();
+    m_byAccount.clear();
+    m_byService.clear();
+    m_loaded = false;
+}
+
+void PasswordVault::scrubEntries()
+{
+    for (Entry& entry : m_entries) {
+        scrubString(entry.account);
+        scrubString(entry.service);
+    }
+    m_entries.clear();
+}
+
+// ============================================================================
+// Lookups
+// ============================================================================
+
+void PasswordVault::rebuildIndexes()
+{
+    m_byAccount.clear();
+    m_byService.clear();
+    for (int i = 0; i < m_entries.size(); ++i) {
+        const Entry& entry = m_entries.at(i);
+        if (!entry.listed) {
+            continue;
+        }
+        m_byAccount[entry.account].append(i);
+        m_byService[entry.service].append(i);
+    }
+}
+
+bool PasswordVault::passwordEquals(const Entry& entry, const QByteArray& password) const
+{
+    if (entry.passwordLength != password.size()) {
+        return false;
+    }
+    if (entry.passwordLength == 0) {
+        return true;
+    }
+    return std::memcmp(m_secrets.constData() + entry.passwordOffset, password.constData(), entry.passwordLength) == 0;
+}
+
+QVector<int> PasswordVault::findExact(const QString& account, const QByteArray& password, const QString& service) const
+{
+    QVector<int> indexes;
+    const QVector<int> candidates = m_byAccount.value(account);
+    for (int index : candidates) {
+        const Entry& entry = m_entries.at(index);
+        if (entry.service == service && passwordEquals(entry, password)) {
+            indexes.append(index);
+        }
+    }
+    return indexes;
+}
+
+bool PasswordVault::contains(const QString& account, const SecureByteArray& password, const QString& service) const
+{
+    return !findExact(account, password.constDataRef(), service).isEmpty();
+}
+
+QStringList PasswordVault::uniqueValues(Field field) const
+{
+    switch (field) {
+    case Field::Account:
+        return m_byAccount.keys();
+    case Field::Service:
+        return m_byService.keys();
+    case Field::Password:
+        break;
+    }
+
+    // Passwords are not indexed, that would keep a second copy of each outside locked memory
+    QSet<QString> passwords;
+    for (int i = 0; i < m_entries.size(); ++i) {
+        if (m_entries.at(i).listed) {
+            passwords.insert(passwordText(i));
+        }
+    }
+    return passwords.values();
+}
+
+QVector<int> PasswordVault::find(Field field, const QString& value) const
+{
+    switch (field) {
+    case Field::Account:
+        return m_byAccount.value(value);
+    case Field::Service:
+        return m_byService.value(value);
+    case Field::Password:
+        break;
+    }
+
+    QVector<int> indexes;
+    QByteArray password = value.toUtf8();
+    for (int i = 0; i < m_entries.size(); ++i) {
+        const Entry& entry = m_entries.at(i);
+        if (entry.listed && passwordEquals(entry, password)) {
+            indexes.append(i);
+        }
+    }
+    // SECURITY: Clear the temporary copy
+    password.fill('\0');
+    return indexes;
+}
+
+QString PasswordVault::account(int index) const
+{
+    if (index < 0 || index >= m_entries.size()) {
+        qWarning() << "PasswordVault: Entry index out of range:" << index;
+        return QString();
+    }
+    return m_entries.at(index).account;
+}
+
+QString PasswordVault::service(int index) const
+{
+    if (index < 0 || index >= m_entries.size()) {
+        qWarning() << "PasswordVault: Entry index out of range:" << index;
+        return QString();
+    }
+    return m_entries.at(index).service;
+}
+
+QString PasswordVault::passwordText(int index) const
+{
+    if (index < 0 || index >= m_entries.size()) {
+        qWarning() << "PasswordVault: Entry index out of range:" << index;
+        return QString();
+    }
+    const Entry& entry = m_entries.at(index);
+    if (entry.passwordLength == 0) {
+        return QString();
+    }
+    return QString::fromUtf8(m_secrets.constData() + entry.passwordOffset, entry.passwordLength);
+}
+
+// ============================================================================
+// Changes
+// ============================================================================
+
+bool PasswordVault::add(const QString& account, const SecureByteArray& password, const QString& service)
+{
+    if (!m_loaded) {
+        qWarning() << "PasswordVault: Cannot add to a vault that is not loaded";
+        return false;
+    }
+    if (contains(account, password, service)) {
+        return true;
+    }
+
+    Entry entry;
+    entry.account = account;
+    entry.service = service;
+    QString passwordStr = QString::fromUtf8(password.constDataRef());
+    entry.listed = isValidField(account) && isValidField(passwordStr) && isValidField(service);
+    scrubString(passwordStr);
+    appendSecret(entry, password.constDataRef());
+    m_entries.append(entry);
+    rebuildIndexes();
+
+    return saveAndReloadOnFailure();
+}
+
+bool PasswordVault::modify(const QString& oldAccount, const SecureByteArray& oldPassword, const QString& oldService,
+                           const QString& newAccount, const SecureByteArray& newPassword, const QString& newService)
+{
+    if (!m_loaded) {
+        qWarning() << "PasswordVault: Cannot modify a vault that is not loaded";
+        return false;
+    }
+    if (oldAccount == newAccount && oldPassword == newPassword && oldService == newService) {
+        return true;
+    }
+
+    const QVector<int> oldIndexes = findExact(oldAccount, oldPassword.constDataRef(), oldService);
+    if (oldIndexes.isEmpty()) {
+        qWarning() << "PasswordVault: Entry to modify not found";
+        return false;
+    }
+    const bool newExists = contains(newAccount, newPassword, newService);
+
+    removeEntries(oldIndexes);
+    if (!newExists) {
+        Entry entry;
+        entry.account = newAccount;
+        entry.service = newService;
+        QString passwordStr = QString::fromUtf8(newPassword.constDataRef());
+        entry.listed = isValidField(newAccount) && isValidField(passwordStr) && isValidField(newService);
+        scrubString(passwordStr);
+        appendSecret(entry, newPassword.constDataRef());
+        m_entries.append(entry);
+        rebuildIndexes();
+    }
+
+    return saveAndReloadOnFailure();
+}
+
+bool PasswordVault::remove(const QString& account, const SecureByteArray& password, const QString& service)
+{
+    if (!m_loaded) {
+        qWarning() << "PasswordVault: Cannot remove from a vault that is not loaded";
+        return false;
+    }
+    const QVector<int> indexes = findExact(account, password.constDataRef(), service);
+    if (indexes.isEmpty()) {
+        qWarning() << "PasswordVault: Entry to remove not found";
+        return false;
+    }
+    removeEntries(indexes);
+    return saveAndReloadOnFailure();
+}
+
+bool PasswordVault::removeAll(Field field, const QString& value)
+{
+    if (!m_loaded) {
+        qWarning() << "PasswordVault: Cannot remove from a vault that is not loaded";
+        return false;
+    }
+    const QVector<int> indexes = find(field, value);
+    if (indexes.isEmpty()) {
+        return true;
+    }
+    removeEntries(indexes);
+    return saveAndReloadOnFailure();
+}
+
+void PasswordVault::removeEntries(const QVector<int>& indexes)
+{
+    QVector<int> sorted = indexes;
+    std::sort(sorted.begin(), sorted.end(), std::greater<int>());
+    for (int index : sorted) {
+        scrubString(m_entries[index].account);
+        scrubString(m_entries[index].service);
+        m_entries.remove(index);
+    }
+    compactSecrets();
+    rebuildIndexes();
+}
+
+void PasswordVault::appendSecret(Entry& entry, const QByteArray& password)
+{
+    entry.passwordOffset = m_secrets.size();
+    entry.passwordLength = password.size();
+    if (password.isEmpty()) {
+        return;
+    }
+
+    // A fresh buffer rather than append, growing in place would leave the old copy unscrubbed
+    SecureByteArray secrets(m_secrets.size() + password.size());
+    char* out = secrets.data();
+    if (!m_secrets.isEmpty()) {
+        std::memcpy(out, m_secrets.constData(), m_secrets.size());
+    }
+    std::memcpy(out + entry.passwordOffset, password.constData(), password.size());
+    // Unlocked first, the move assignment scrubs the old buffer before it gets to unlocking it
+    m_secrets.unlockMemory();
+    m_secrets = std::move(secrets);
+}
+
+void PasswordVault::compactSecrets()
+{
+    int secretsSize = 0;
+    for (const Entry& entry : m_entries) {
+        secretsSize += entry.passwordLength;
+    }
+    if (secretsSize == m_secrets.size()) {
+        return;
+    }
+
+    SecureByteArray secrets(secretsSize);
+    if (secretsSize > 0) {
+        char* out = secrets.data();
+        int offset = 0;
+        for (Entry& entry : m_entries) {
+            if (entry.passwordLength > 0) {
+                std::memcpy(out + offset, m_secrets.constData() + entry.passwordOffset, entry.passwordLength);
+            }
+            entry.passwordOffset = offset;
+            offset += entry.passwordLength;
+        }
+    }
+    m_secrets.unlockMemory();
+    m_secrets = std::move(secrets);
+}
+
+// ============================================================================
+// Saving
+// ============================================================================
+
+bool PasswordVault::saveAndReloadOnFailure()
+{
+    if (save()) {
+        return true;
+    }
+    qWarning() << "PasswordVault: Failed to save, reloading from the password file";
+    load();
+    return false;
+}
+
+bool PasswordVault::save()
+{
+    if (!OperationsFiles::validateFilePath(m_passwordsFilePath, OperationsFiles::FileType::Password, m_encryptionKey)) {
+        qWarning() << "PasswordVault: Password file failed validation check:" << m_passwordsFilePath;
+        return false;
+    }
+
+    // No file rather than an empty one once the last entry is gone
+    if (m_entries.isEmpty()) {
+        if (QFile::exists(m_passwordsFilePath) && !QFile::remove(m_passwordsFilePath)) {
+            qWarning() << "PasswordVault: Failed to remove empty password file:" << m_passwordsFilePath;
+            return false;
+        }
+        return true;
+    }
+
+    // Same text as before: a <Password> block per entry, each followed by an empty line
+    QVector<QByteArray> accounts;
+    QVector<QByteArray> services;
+    accounts.reserve(m_entries.size());
+    services.reserve(m_entries.size());
+    const int fixedLength = static_cast<int>(qstrlen(BLOCK_START) + qstrlen(ACCOUNT_PREFIX) + qstrlen(PASSWORD_PREFIX)
+                                             + qstrlen(SERVICE_PREFIX)) + 5; // Four line ends and the empty line
+    int plaintextSize = 0;
+    for (const Entry& entry : m_entries) {
+        accounts.append(entry.account.toUtf8());
+        services.append(entry.service.toUtf8());
+        plaintextSize += fixedLength + accounts.last().size() + entry.passwordLength + services.last().size();
+    }
+
+    SecureByteArray plaintext(plaintextSize);
+    char* out = plaintext.data();
+    int offset = 0;
+    auto write = [&](const char* data, int length) {
+        if (length > 0) {
+            std::memcpy(out + offset, data, length);
+            offset += length;
+        }
+    };
+    for (int i = 0; i < m_entries.size(); ++i) {
+        const Entry& entry = m_entries.at(i);
+        write(BLOCK_START, static_cast<int>(qstrlen(BLOCK_START)));
+        write("\n", 1);
+        write(ACCOUNT_PREFIX, static_cast<int>(qstrlen(ACCOUNT_PREFIX)));
+        write(accounts.at(i).constData(), accounts.at(i).size());
+        write("\n", 1);
+        write(PASSWORD_PREFIX, static_cast<int>(qstrlen(PASSWORD_PREFIX)));
+        if (entry.passwordLength > 0) {
+            write(m_secrets.constData() + entry.passwordOffset, entry.passwordLength);
+        }
+        write("\n", 1);
+        write(SERVICE_PREFIX, static_cast<int>(qstrlen(SERVICE_PREFIX)));
+        write(services.at(i).constData(), services.at(i).size());
+        write("\n\n", 2);
+    }
+
+    if (!OperationsFiles::writeEncryptedBlob(m_passwordsFilePath, m_encryptionKey, plaintext.constDataRef())) {
+        qWarning() << "PasswordVault: Failed to write password file:" << m_passwordsFilePath;
+        return false;
+    }
+    return true;
+}
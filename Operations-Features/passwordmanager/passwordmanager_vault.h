@@ -0,0 +1,92 @@
+#ifndef PASSWORDMANAGER_VAULT_H
+#define PASSWORDMANAGER_VAULT_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QHash>
+#include <QVector>
+#include "encryption/SecureByteArray.h"
+
+// Decrypted contents of passwords.txt, loaded once per session.
+// Every click in the password manager used to decrypt and parse the whole file again. The vault
+// parses it on first use and keeps the entries in memory: accounts and services as plain strings
+// with an index on each, the passwords in one SecureByteArray (locked, so they are not paged
+// out) that the entries point into. Changes are applied to the entries and the file is rewritten
+// from them, encrypted in memory and replaced atomically through QSaveFile.
+// The file format is unchanged, the vault reads and writes the same <Password> blocks.
+class PasswordVault
+{
+public:
+    enum class Field {
+        Account,
+        Password,
+        Service
+    };
+
+    PasswordVault(const QByteArray& encryptionKey, const QString& passwordsFilePath);
+    ~PasswordVault();
+
+    // Reads the passwords file, a missing file is an empty vault. Returns false (and stays
+    // unloaded) if the file fails validation or can't be decrypted.
+    bool load();
+    bool isLoaded() const { return m_loaded; }
+    // Scrubs everything, the next load() reads the file again
+    void unload();
+
+    int count() const { return m_entries.size(); }
+    bool contains(const QString& account, const SecureByteArray& password, const QString& service) const;
+
+    // Distinct values of a field over the entries, unsorted
+    QStringList uniqueValues(Field field) const;
+    // Indexes of the entries whose field equals value, in file order
+    QVector<int> find(Field field, const QString& value) const;
+
+    QString account(int index) const;
+    QString service(int index) const;
+    // Plain copy of the password, callers scrub it when done
+    QString passwordText(int index) const;
+
+    // The mutators write the file before returning. If that fails the vault is reloaded from
+    // the file so it never shows changes that were not saved.
+    // Adding an entry that already exists succeeds without writing.
+    bool add(const QString& account, const SecureByteArray& password, const QString& service);
+    // Replaces every copy of the old entry, fails if there is none. The new entry is not added
+    // twice if it already exists.
+    bool modify(const QString& oldAccount, const SecureByteArray& oldPassword, const QString& oldService,
+                const QString& newAccount, const SecureByteArray& newPassword, const QString& newService);
+    // Removes every copy of the entry, fails if there is none
+    bool remove(const QString& account, const SecureByteArray& password, const QString& service);
+    // Removes every entry whose field equals value
+    bool removeAll(Field field, const QString& value);
+
+private:
+    struct Entry {
+        QString account;
+        QString service;
+        int passwordOffset = 0;     // Into m_secrets
+        int passwordLength = 0;
+        bool listed = true;         // False for entries that failed validation, kept in the file only
+    };
+
+    bool save();
+    bool saveAndReloadOnFailure();
+    QVector<int> findExact(const QString& account, const QByteArray& password, const QString& service) const;
+    bool passwordEquals(const Entry& entry, const QByteArray& password) const;
+    void removeEntries(const QVector<int>& indexes);
+    void appendSecret(Entry& entry, const QByteArray& password);
+    void compactSecrets();
+    void rebuildIndexes();
+    void scrubEntries();
+
+    QByteArray m_encryptionKey;
+    QString m_passwordsFilePath;
+    bool m_loaded;
+
+    QVector<Entry> m_entries;                   // In file order
+    SecureByteArray m_secrets;                  // Passwords of all entries, back to back (UTF-8)
+    QHash<QString, QVector<int>> m_byAccount;   // Listed entries only
+    QHash<QString, QVector<int>> m_byService;
+};
+
+#endif // PASSWORDMANAGER_VAULT_H
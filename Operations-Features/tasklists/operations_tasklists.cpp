@@ -8,6 +8,8 @@
 #include "ui_tasklists_addtask.h"
 #include "ui_tasklists_createtasklist.h"
 #include "../../CustomWidgets/tasklists/qlist_TasklistDisplay.h"
+#include "tasklist_searchindex.h"
+#include "tasklist_orderkeys.h"
 #include <QApplication>
 #include <QDateTime>
 #include <QDir>
@@ -17,6 +19,7 @@
 #include <QGuiApplication>
 #include <QMessageBox>
 #include <QMap>
+#include <QSet>
 #include <QPlainTextEdit>
 #include <QRandomGenerator>
 #include <QHeaderView>
@@ -24,10 +27,13 @@
 #include <QUuid>
 #include <QInputDialog>
 #include <utility>  // For std::pair and std::make_pair
+#include <algorithm>
+#include <cstddef>  // For offsetof
 #ifdef Q_OS_WIN
 #include <windows.h>
 #endif
 #include "operations_files.h"
+#include "tasklistrecordlog.h"
 
 // Security: Centralized helper functions for task data
 namespace TaskDataSecurity {
@@ -144,171 +150,159 @@ bool Operations_TaskLists::parseJsonTask(const QJsonObject& taskObj, QString& na
 bool Operations_TaskLists::readTasklistJson(const QString& filePath, QJsonArray& tasks) {
     qDebug() << "Operations_TaskLists: Reading JSON tasks from:" << filePath;
     
-    // Create temporary directory
-    QString tempDir = "Data/" + m_mainWindow->user_Username + "/temp/";
-    if (!OperationsFiles::ensureDirectoryExists(tempDir)) {
-        qWarning() << "Operations_TaskLists: Failed to create temp directory";
-        return false;
-    }
-    
-    QString tempPath = TaskDataSecurity::generateSecureTempFileName("read_json", tempDir);
-    
-    // Decrypt the file
-    if (!CryptoUtils::Encryption_DecryptFile(m_mainWindow->user_Key, filePath, tempPath)) {
-        qWarning() << "Operations_TaskLists: Failed to decrypt tasklist file";
-        return false;
-    }
-    
-    // Open the decrypted file
-    QFile tempFile(tempPath);
-    if (!tempFile.open(QIODevice::ReadOnly)) {
-        QFile::remove(tempPath);
-        qWarning() << "Operations_TaskLists: Failed to open decrypted file";
-        return false;
-    }
-    
-    // Skip the metadata header (512 bytes)
-    tempFile.seek(METADATA_SIZE);
-    
-    // Read the JSON content
-    QByteArray jsonData = tempFile.readAll();
-    tempFile.close();
-    QFile::remove(tempPath);
-    
-    if (jsonData.trimmed().isEmpty()) {
-        // Empty task list
-        tasks = QJsonArray();
-        return true;
-    }
-    
-    // Parse JSON
-    QJsonDocument doc = QJsonDocument::fromJson(jsonData);
-    if (!doc.isObject()) {
-        qWarning() << "Operations_TaskLists: Invalid JSON format";
-        return false;
-    }
-    
-    QJsonObject root = doc.object();
-    if (!root.contains("tasks") || !root["tasks"].isArray()) {
-        qWarning() << "Operations_TaskLists: Missing or invalid tasks array";
+    QByteArray header;
+    if (!TasklistRecordLog::read(filePath, m_mainWindow->user_Key, header, tasks)) {
+        qWarning() << "Operations_TaskLists: Failed to read tasklist file";
         return false;
     }
     
-    tasks = root["tasks"].toArray();
+    updateTaskSummary(filePath, tasks);
     return true;
 }
 
+// Keep the summary of a tasklist in step with the tasks just read from or written to its file
+void Operations_TaskLists::updateTaskSummary(const QString& filePath, const QJsonArray& tasks)
+{
+    int taskCount = 0;
+    int completedCount = 0;
+    for (const QJsonValue& value : tasks) {
+        if (!value.isObject()) continue;
+        taskCount++;
+        if (value.toObject()["completed"].toBool()) {
+            completedCount++;
+        }
+    }
+    m_taskSummaries.update(filePath, taskCount, completedCount);
+}
+
 bool Operations_TaskLists::writeTasklistJson(const QString& filePath, const QJsonArray& tasks) {
     qDebug() << "Operations_TaskLists: Writing JSON tasks to:" << filePath;
     
-    // First read the existing metadata to preserve it
-    QString tasklistName;
-    QString lastSelectedTask;
-    
-    // Read existing metadata
-    QString tempDir = "Data/" + m_mainWindow->user_Username + "/temp/";
-    if (!OperationsFiles::ensureDirectoryExists(tempDir)) {
-        qWarning() << "Operations_TaskLists: Failed to create temp directory";
+    // The metadata header is kept as it is, only the task changes are appended to the log
+    QByteArray header;
+    QJsonArray existingTasks;
+    if (!TasklistRecordLog::read(filePath, m_mainWindow->user_Key, header, existingTasks)) {
+        qWarning() << "Operations_TaskLists: Failed to read existing metadata";
         return false;
     }
     
-    QString readTempPath = TaskDataSecurity::generateSecureTempFileName("read_metadata_json", tempDir);
-    
-    // Decrypt file to read metadata
-    if (CryptoUtils::Encryption_DecryptFile(m_mainWindow->user_Key, filePath, readTempPath)) {
-        QFile readFile(readTempPath);
-        if (readFile.open(QIODevice::ReadOnly)) {
-            QByteArray metadataBytes = readFile.read(METADATA_SIZE);
-            if (metadataBytes.size() == METADATA_SIZE) {
-                const TasklistMetadata* oldMetadata = reinterpret_cast<const TasklistMetadata*>(metadataBytes.constData());
-                
-                // Extract tasklist name
-                char nameBuffer[257];
-                memcpy(nameBuffer, oldMetadata->name, 256);
-                nameBuffer[256] = '\0';
-                tasklistName = QString::fromUtf8(nameBuffer);
-                
-                // Extract lastSelectedTask
-                char taskBuffer[129];
-                memcpy(taskBuffer, oldMetadata->lastSelectedTask, 128);
-                taskBuffer[128] = '\0';
-                lastSelectedTask = QString::fromUtf8(taskBuffer);
-            }
-            readFile.close();
-        }
-        QFile::remove(readTempPath);
-    }
-    
+    QString tasklistName = metadataField(header, offsetof(TasklistMetadata, name), sizeof(TasklistMetadata::name));
     if (tasklistName.isEmpty()) {
         qWarning() << "Operations_TaskLists: Failed to read existing metadata";
         return false;
     }
+    healNameIndex(filePath, tasklistName);
     
-    // Create temporary file for writing
-    QString tempPath = TaskDataSecurity::generateSecureTempFileName("write_json", tempDir);
-    QFile tempFile(tempPath);
+    bool success = TasklistRecordLog::write(filePath, m_mainWindow->user_Key, header, tasks);
     
-    if (!tempFile.open(QIODevice::WriteOnly)) {
-        qWarning() << "Operations_TaskLists: Failed to open temp file for writing";
-        return false;
+    if (success) {
+        updateTaskSummary(filePath, tasks);
+        if (m_searchIndex) {
+            m_searchIndex->updateFile(filePath, tasks);
+        }
+    } else {
+        qWarning() << "Operations_TaskLists: Failed to write tasklist file";
     }
     
-    // Write metadata header
+    return success;
+}
+
+// Order key that puts a new task after all the tasks of a list
+QString Operations_TaskLists::nextTaskOrderKey(const QJsonArray& tasks)
+{
+    QString lastKey;
+    for (const QJsonValue& value : tasks) {
+        const QString key = value.toObject()["order"].toString();
+        if (TasklistOrderKeys::isValid(key) && key > lastKey) {
+            lastKey = key;
+        }
+    }
+    // Too long to extend means the next reorder rebalances the list, end up after it anyway
+    QString key = TasklistOrderKeys::between(lastKey, QString());
+    return key.isEmpty() ? lastKey + "V" : key;
+}
+
+// The tasks in display order. Tasks without a key (lists from before order keys) keep their
+// array order after the keyed ones.
+QJsonArray Operations_TaskLists::sortedByOrderKey(const QJsonArray& tasks)
+{
+    QVector<QJsonValue> sortedTasks;
+    sortedTasks.reserve(tasks.size());
+    for (const QJsonValue& value : tasks) {
+        sortedTasks.append(value);
+    }
+    std::stable_sort(sortedTasks.begin(), sortedTasks.end(), [](const QJsonValue& a, const QJsonValue& b) {
+        const QString keyA = a.toObject()["order"].toString();
+        const QString keyB = b.toObject()["order"].toString();
+        const bool hasKeyA = TasklistOrderKeys::isValid(keyA);
+        const bool hasKeyB = TasklistOrderKeys::isValid(keyB);
+        if (hasKeyA != hasKeyB) {
+            return hasKeyA;
+        }
+        return hasKeyA && keyA < keyB;
+    });
+
+    QJsonArray result;
+    for (const QJsonValue& value : sortedTasks) {
+        result.append(value);
+    }
+    return result;
+}
+
+// Builds a metadata header for a new tasklist
+QByteArray Operations_TaskLists::createTasklistMetadata(const QString& tasklistName)
+{
     TasklistMetadata metadata;
-    memset(&metadata, 0, sizeof(metadata));
+    memset(&metadata, 0, sizeof(metadata));  // Clear all to zero
     
     // Set magic and version
     strncpy(metadata.magic, TASKLIST_MAGIC, 8);
     strncpy(metadata.version, TASKLIST_VERSION, 4);
     
-    // Set tasklist name
+    // Set tasklist name (truncate if necessary)
     QByteArray nameBytes = tasklistName.toUtf8();
-    int nameToCopy = qMin(nameBytes.size(), 255);
+    int nameToCopy = qMin(nameBytes.size(), 255);  // Leave room for null terminator
     memcpy(metadata.name, nameBytes.constData(), nameToCopy);
     
     // Set creation date
     QString creationDate = QDateTime::currentDateTime().toString(Qt::ISODate);
     QByteArray dateBytes = creationDate.toUtf8();
-    int dateToCopy = qMin(dateBytes.size(), 31);
+    int dateToCopy = qMin(dateBytes.size(), 31);  // Leave room for null terminator
     memcpy(metadata.creationDate, dateBytes.constData(), dateToCopy);
     
-    // Preserve lastSelectedTask
-    if (!lastSelectedTask.isEmpty()) {
-        QByteArray taskBytes = lastSelectedTask.toUtf8();
-        int taskToCopy = qMin(taskBytes.size(), 127);
-        memcpy(metadata.lastSelectedTask, taskBytes.constData(), taskToCopy);
-    }
-    
-    // Write metadata to temp file
-    tempFile.write(reinterpret_cast<const char*>(&metadata), METADATA_SIZE);
-    
-    // Create JSON document
-    QJsonObject root;
-    root["version"] = 2;
-    root["tasks"] = tasks;
-    
-    QJsonDocument doc(root);
-    tempFile.write(doc.toJson(QJsonDocument::Compact));
-    
-    tempFile.close();
-    
-    // Encrypt the temp file to the final location
-    bool success = CryptoUtils::Encryption_EncryptFile(m_mainWindow->user_Key, tempPath, filePath);
-    
-    // Clean up temp file
-    QFile::remove(tempPath);
+    // lastSelectedTask is left empty (all zeros) for new tasklists
     
-    if (!success) {
-        qWarning() << "Operations_TaskLists: Failed to encrypt tasklist file";
+    return QByteArray(reinterpret_cast<const char*>(&metadata), METADATA_SIZE);
+}
+
+// Reads a null-padded text field of a metadata header
+QString Operations_TaskLists::metadataField(const QByteArray& header, int offset, int size)
+{
+    if (header.size() < offset + size) {
+        return QString();
     }
-    
-    return success;
+    const QByteArray field = header.mid(offset, size);
+    const int end = field.indexOf('\0');
+    return QString::fromUtf8(end < 0 ? field : field.left(end));
+}
+
+// Replaces a null-padded text field of a metadata header, truncated to leave room for the terminator
+void Operations_TaskLists::setMetadataField(QByteArray& header, int offset, int size, const QString& value)
+{
+    if (header.size() < offset + size) {
+        return;
+    }
+    QByteArray field(size, '\0');
+    const QByteArray valueBytes = value.toUtf8();
+    memcpy(field.data(), valueBytes.constData(), qMin(valueBytes.size(), size - 1));
+    header.replace(offset, size, field);
 }
 
 
 Operations_TaskLists::Operations_TaskLists(MainWindow* mainWindow)
     : m_mainWindow(mainWindow)
-    , m_tasklistNameToFile(100, "TasklistNameToFile")  // Initialize thread-safe map
+    , m_tasklistNameToFile(mainWindow->user_Key, "Data/" + mainWindow->user_Username + "/Tasklists/")
+    , m_taskSummaries(mainWindow->user_Key, "Data/" + mainWindow->user_Username + "/Tasklists/")
     , m_taskOrderCache(100, "TaskOrderCache")  // Initialize with max size and debug name
     , m_lastClickedWidget(nullptr)
     , m_lastClickedItem(nullptr)
@@ -431,6 +425,28 @@ Operations_TaskLists::Operations_TaskLists(MainWindow* mainWindow)
         connect(treeWidget, &qtree_Tasklists_list::taskDroppedOnTasklist,
                 this, &Operations_TaskLists::TransferTaskToTasklist);
     }
+
+    // Task search, the index is only built once the user starts searching
+    m_searchIndex = new TasklistSearchIndex(m_mainWindow->user_Key, this);
+    m_mainWindow->ui->listWidget_TaskSearchResults->setVisible(false);
+    connect(m_mainWindow->ui->lineEdit_TaskSearch, &QLineEdit::returnPressed,
+            this, &Operations_TaskLists::onTaskSearchRequested);
+    connect(m_mainWindow->ui->lineEdit_TaskSearch, &QLineEdit::textChanged,
+            this, [this](const QString& text) {
+                if (text.trimmed().isEmpty()) {
+                    setTaskSearchMode(false);
+                } else {
+                    onTaskSearchRequested();
+                }
+            });
+    connect(m_mainWindow->ui->listWidget_TaskSearchResults, &QListWidget::itemClicked,
+            this, &Operations_TaskLists::openTaskSearchResult);
+    connect(m_searchIndex, &TasklistSearchIndex::indexingFinished, this, [this]() {
+        // Results shown while indexing were partial
+        if (m_mainWindow->ui->listWidget_TaskSearchResults->isVisible()) {
+            onTaskSearchRequested();
+        }
+    });
     
     LoadTasklists();
 }
@@ -450,54 +466,7 @@ bool Operations_TaskLists::writeTasklistMetadata(const QString& filePath, const
 {
     qDebug() << "Operations_TaskLists: Writing metadata for tasklist:" << tasklistName;
     
-    // Create metadata structure
-    TasklistMetadata metadata;
-    memset(&metadata, 0, sizeof(metadata));  // Clear all to zero
-    
-    // Set magic and version
-    strncpy(metadata.magic, TASKLIST_MAGIC, 8);
-    strncpy(metadata.version, TASKLIST_VERSION, 4);
-    
-    // Set tasklist name (truncate if necessary)
-    QByteArray nameBytes = tasklistName.toUtf8();
-    int nameToCopy = qMin(nameBytes.size(), 255);  // Leave room for null terminator
-    memcpy(metadata.name, nameBytes.constData(), nameToCopy);
-    
-    // Set creation date
-    QString creationDate = QDateTime::currentDateTime().toString(Qt::ISODate);
-    QByteArray dateBytes = creationDate.toUtf8();
-    int dateToCopy = qMin(dateBytes.size(), 31);  // Leave room for null terminator
-    memcpy(metadata.creationDate, dateBytes.constData(), dateToCopy);
-    
-    // lastSelectedTask is left empty (all zeros) for new tasklists
-    
-    // Convert metadata to byte array
-    QByteArray metadataBytes(reinterpret_cast<const char*>(&metadata), METADATA_SIZE);
-    
-    // Create temporary file for writing
-    QString tempDir = "Data/" + m_mainWindow->user_Username + "/temp/";
-    if (!OperationsFiles::ensureDirectoryExists(tempDir)) {
-        qWarning() << "Operations_TaskLists: Failed to create temp directory";
-        return false;
-    }
-    
-    QString tempPath = TaskDataSecurity::generateSecureTempFileName("metadata", tempDir);
-    QFile tempFile(tempPath);
-    
-    if (!tempFile.open(QIODevice::WriteOnly)) {
-        qWarning() << "Operations_TaskLists: Failed to open temp file for metadata";
-        return false;
-    }
-    
-    // Write metadata (will be encrypted as part of the file)
-    tempFile.write(metadataBytes);
-    tempFile.close();
-    
-    // Encrypt the temp file to the target location
-    bool success = CryptoUtils::Encryption_EncryptFile(key, tempPath, filePath);
-    
-    // Clean up temp file
-    QFile::remove(tempPath);
+    bool success = TasklistRecordLog::write(filePath, key, createTasklistMetadata(tasklistName), QJsonArray());
     
     if (success) {
         // Update the name-to-file mapping
@@ -512,34 +481,13 @@ bool Operations_TaskLists::readTasklistMetadata(const QString& filePath, QString
 {
     qDebug() << "Operations_TaskLists: Reading metadata from:" << filePath;
     
-    // Create temporary file for decryption
-    QString tempDir = "Data/" + m_mainWindow->user_Username + "/temp/";
-    if (!OperationsFiles::ensureDirectoryExists(tempDir)) {
-        qWarning() << "Operations_TaskLists: Failed to create temp directory";
-        return false;
-    }
-    
-    QString tempPath = TaskDataSecurity::generateSecureTempFileName("metadata_read", tempDir);
-    
-    // Decrypt the file to temp location
-    if (!CryptoUtils::Encryption_DecryptFile(key, filePath, tempPath)) {
+    QByteArray metadataBytes;
+    QJsonArray tasks;
+    if (!TasklistRecordLog::read(filePath, key, metadataBytes, tasks)) {
         qWarning() << "Operations_TaskLists: Failed to decrypt tasklist file for metadata";
         return false;
     }
     
-    // Read the metadata from decrypted file
-    QFile tempFile(tempPath);
-    if (!tempFile.open(QIODevice::ReadOnly)) {
-        QFile::remove(tempPath);
-        qWarning() << "Operations_TaskLists: Failed to open decrypted file for metadata";
-        return false;
-    }
-    
-    // Read metadata bytes
-    QByteArray metadataBytes = tempFile.read(METADATA_SIZE);
-    tempFile.close();
-    QFile::remove(tempPath);
-    
     if (metadataBytes.size() != METADATA_SIZE) {
         qWarning() << "Operations_TaskLists: Invalid metadata size:" << metadataBytes.size();
         return false;
@@ -560,14 +508,8 @@ bool Operations_TaskLists::readTasklistMetadata(const QString& filePath, QString
         return false;
     }
     
-    // Extract name (ensure null-terminated)
-    char nameBuffer[257];
-    memcpy(nameBuffer, metadata->name, 256);
-    nameBuffer[256] = '\0';
-    tasklistName = QString::fromUtf8(nameBuffer);
-    
-    // Update the name-to-file mapping
-    m_tasklistNameToFile.insert(tasklistName, filePath);
+    // Extract name
+    tasklistName = metadataField(metadataBytes, offsetof(TasklistMetadata, name), sizeof(TasklistMetadata::name));
     
     return true;
 }
@@ -575,32 +517,56 @@ bool Operations_TaskLists::readTasklistMetadata(const QString& filePath, QString
 // Find tasklist file by name
 QString Operations_TaskLists::findTasklistFileByName(const QString& tasklistName)
 {
-    // Check cache first
-    if (m_tasklistNameToFile.contains(tasklistName)) {
-        auto cachedPath = m_tasklistNameToFile.value(tasklistName);
-        if (cachedPath.has_value()) {
-            return cachedPath.value();
+    QString filePath = m_tasklistNameToFile.filePath(tasklistName);
+    if (!filePath.isEmpty()) {
+        if (QFileInfo::exists(filePath)) {
+            return filePath;
         }
+        // The file went away behind our back, forget it and look at what is actually on disk
+        qWarning() << "Operations_TaskLists: Indexed tasklist file is missing:" << filePath;
     }
-    
-    // If not in cache, scan all tasklist files
+
+    // Only files the index doesn't know yet have their header decrypted
+    indexUnknownTasklistFiles();
+    return m_tasklistNameToFile.filePath(tasklistName);  // Empty if not found
+}
+
+// Bring the name index in line with the tasklist files on disk
+void Operations_TaskLists::indexUnknownTasklistFiles()
+{
     QString tasksListsPath = "Data/" + m_mainWindow->user_Username + "/Tasklists/";
     QDir dir(tasksListsPath);
     QStringList filters;
     filters << "tasklist_*.txt";
     QStringList tasklistFiles = dir.entryList(filters, QDir::Files);
-    
-    for (const QString& filename : tasklistFiles) {
+
+    const QStringList unindexedFiles = m_tasklistNameToFile.reconcile(tasklistFiles);
+    if (unindexedFiles.isEmpty()) {
+        return;
+    }
+
+    qDebug() << "Operations_TaskLists: Reading headers of" << unindexedFiles.size() << "unindexed tasklists";
+    QHash<QString, QString> discovered;
+    for (const QString& filename : unindexedFiles) {
         QString filePath = tasksListsPath + filename;
         QString name;
         if (readTasklistMetadata(filePath, name, m_mainWindow->user_Key)) {
-            if (name == tasklistName) {
-                return filePath;
-            }
+            discovered.insert(name, filePath);
+        } else {
+            qWarning() << "Operations_TaskLists: Failed to read metadata from" << filename;
         }
     }
-    
-    return QString();  // Not found
+    m_tasklistNameToFile.insert(discovered);
+}
+
+// The header is the source of truth, fix the index whenever a read shows they disagree
+void Operations_TaskLists::healNameIndex(const QString& filePath, const QString& headerName)
+{
+    if (headerName.isEmpty() || m_tasklistNameToFile.nameForFile(filePath) == headerName) {
+        return;
+    }
+    qWarning() << "Operations_TaskLists: Name index out of date for" << filePath << "- updating it";
+    m_tasklistNameToFile.insert(headerName, filePath);
 }
 
 Operations_TaskLists::~Operations_TaskLists()
@@ -647,6 +613,9 @@ Operations_TaskLists::~Operations_TaskLists()
     TaskDataSecurity::secureStringClear(m_currentTaskName);
     TaskDataSecurity::secureStringClear(m_lastSavedDescription);
     TaskDataSecurity::secureStringClear(currentTaskListBeingRenamed);
+
+    // SECURITY: Drop the cached plaintext of the tasklist files
+    TasklistRecordLog::clearCache();
 }
 
 //--------Safe Container Operations Helpers--------//
@@ -710,52 +679,6 @@ int Operations_TaskLists::safeGetItemCount(QListWidget* widget) const
     return widget->count();
 }
 
-// Custom file I/O that properly handles the 512-byte metadata header
-bool Operations_TaskLists::readTasklistFileWithMetadata(const QString& filePath, QStringList& taskLines)
-{
-    qDebug() << "Operations_TaskLists: Reading tasklist file with metadata:" << filePath;
-    taskLines.clear();
-    
-    // Decrypt the file to a temporary location
-    QString tempDir = "Data/" + m_mainWindow->user_Username + "/temp/";
-    if (!OperationsFiles::ensureDirectoryExists(tempDir)) {
-        qWarning() << "Operations_TaskLists: Failed to create temp directory";
-        return false;
-    }
-    
-    QString tempPath = TaskDataSecurity::generateSecureTempFileName("read_tasks", tempDir);
-    
-    if (!CryptoUtils::Encryption_DecryptFile(m_mainWindow->user_Key, filePath, tempPath)) {
-        qWarning() << "Operations_TaskLists: Failed to decrypt tasklist file";
-        return false;
-    }
-    
-    // Read the decrypted file
-    QFile tempFile(tempPath);
-    if (!tempFile.open(QIODevice::ReadOnly)) {
-        QFile::remove(tempPath);
-        qWarning() << "Operations_TaskLists: Failed to open decrypted file";
-        return false;
-    }
-    
-    // Skip the metadata header (512 bytes)
-    tempFile.seek(METADATA_SIZE);
-    
-    // Read all task lines
-    QTextStream stream(&tempFile);
-    while (!stream.atEnd()) {
-        QString line = stream.readLine();
-        if (!line.isEmpty()) {
-            taskLines.append(line);
-        }
-    }
-    
-    tempFile.close();
-    QFile::remove(tempPath);
-    
-    return true;
-}
-
 // Update the last selected task in the metadata
 bool Operations_TaskLists::updateLastSelectedTask(const QString& tasklistName, const QString& taskName)
 {
@@ -768,180 +691,29 @@ bool Operations_TaskLists::updateLastSelectedTask(const QString& tasklistName, c
         return false;
     }
     
-    // Create temporary directory
-    QString tempDir = "Data/" + m_mainWindow->user_Username + "/temp/";
-    if (!OperationsFiles::ensureDirectoryExists(tempDir)) {
-        qWarning() << "Operations_TaskLists: Failed to create temp directory";
-        return false;
-    }
-    
-    QString tempPath = TaskDataSecurity::generateSecureTempFileName("update_selection", tempDir);
-    
-    // Decrypt the file
-    if (!CryptoUtils::Encryption_DecryptFile(m_mainWindow->user_Key, filePath, tempPath)) {
-        qWarning() << "Operations_TaskLists: Failed to decrypt tasklist file";
-        return false;
-    }
-    
-    // Open the decrypted file
-    QFile tempFile(tempPath);
-    if (!tempFile.open(QIODevice::ReadWrite)) {
-        QFile::remove(tempPath);
-        qWarning() << "Operations_TaskLists: Failed to open temp file";
-        return false;
-    }
-    
-    // Read the entire file
-    QByteArray allContent = tempFile.readAll();
-    
-    // Check if file has metadata
-    if (allContent.size() < METADATA_SIZE) {
-        tempFile.close();
-        QFile::remove(tempPath);
-        qWarning() << "Operations_TaskLists: File too small for metadata";
-        return false;
-    }
-    
-    // Parse metadata
-    TasklistMetadata metadata;
-    memcpy(&metadata, allContent.constData(), METADATA_SIZE);
-    
-    // Verify magic and version
-    if (strncmp(metadata.magic, TASKLIST_MAGIC, 8) != 0) {
-        tempFile.close();
-        QFile::remove(tempPath);
-        qWarning() << "Operations_TaskLists: Invalid magic number";
-        return false;
-    }
-    
-    // Update the lastSelectedTask field
-    memset(metadata.lastSelectedTask, 0, 128);  // Clear existing
-    QByteArray taskBytes = taskName.toUtf8();
-    int taskToCopy = qMin(taskBytes.size(), 127);  // Leave room for null terminator
-    memcpy(metadata.lastSelectedTask, taskBytes.constData(), taskToCopy);
-    
-    // Write back the updated metadata and the rest of the content
-    tempFile.seek(0);
-    tempFile.write(reinterpret_cast<const char*>(&metadata), METADATA_SIZE);
-    tempFile.write(allContent.mid(METADATA_SIZE));  // Write the rest unchanged
-    tempFile.close();
-    
-    // Re-encrypt the file
-    bool success = CryptoUtils::Encryption_EncryptFile(m_mainWindow->user_Key, tempPath, filePath);
-    
-    // Clean up temp file
-    QFile::remove(tempPath);
-    
-    if (!success) {
-        qWarning() << "Operations_TaskLists: Failed to re-encrypt tasklist file";
-    }
-    
-    return success;
-}
-
-bool Operations_TaskLists::writeTasklistFileWithMetadata(const QString& filePath, const QStringList& taskLines)
-{
-    qDebug() << "Operations_TaskLists: Writing tasklist file with metadata:" << filePath;
-    
-    // First read the existing metadata to preserve it
-    QString tasklistName;
-    QString lastSelectedTask;
-    
-    // Read existing metadata to preserve fields
-    QString tempDir = "Data/" + m_mainWindow->user_Username + "/temp/";
-    if (!OperationsFiles::ensureDirectoryExists(tempDir)) {
-        qWarning() << "Operations_TaskLists: Failed to create temp directory";
-        return false;
-    }
-    
-    QString readTempPath = TaskDataSecurity::generateSecureTempFileName("read_metadata_for_write", tempDir);
-    
-    // Decrypt file to read metadata
-    if (CryptoUtils::Encryption_DecryptFile(m_mainWindow->user_Key, filePath, readTempPath)) {
-        QFile readFile(readTempPath);
-        if (readFile.open(QIODevice::ReadOnly)) {
-            QByteArray metadataBytes = readFile.read(METADATA_SIZE);
-            if (metadataBytes.size() == METADATA_SIZE) {
-                const TasklistMetadata* oldMetadata = reinterpret_cast<const TasklistMetadata*>(metadataBytes.constData());
-                
-                // Extract tasklist name
-                char nameBuffer[257];
-                memcpy(nameBuffer, oldMetadata->name, 256);
-                nameBuffer[256] = '\0';
-                tasklistName = QString::fromUtf8(nameBuffer);
-                
-                // Extract lastSelectedTask
-                char taskBuffer[129];
-                memcpy(taskBuffer, oldMetadata->lastSelectedTask, 128);
-                taskBuffer[128] = '\0';
-                lastSelectedTask = QString::fromUtf8(taskBuffer);
-            }
-            readFile.close();
-        }
-        QFile::remove(readTempPath);
-    }
-    
-    if (tasklistName.isEmpty()) {
-        qWarning() << "Operations_TaskLists: Failed to read existing metadata";
-        return false;
-    }
-    
-    // Create temporary file for writing
-    QString tempPath = TaskDataSecurity::generateSecureTempFileName("write_tasks", tempDir);
-    QFile tempFile(tempPath);
-    
-    if (!tempFile.open(QIODevice::WriteOnly)) {
-        qWarning() << "Operations_TaskLists: Failed to open temp file for writing";
-        return false;
-    }
-    
-    // Write metadata header
-    TasklistMetadata metadata;
-    memset(&metadata, 0, sizeof(metadata));
-    
-    // Set magic and version
-    strncpy(metadata.magic, TASKLIST_MAGIC, 8);
-    strncpy(metadata.version, TASKLIST_VERSION, 4);
-    
-    // Set tasklist name
-    QByteArray nameBytes = tasklistName.toUtf8();
-    int nameToCopy = qMin(nameBytes.size(), 255);
-    memcpy(metadata.name, nameBytes.constData(), nameToCopy);
-    
-    // Set creation date (we could preserve the original, but for now use current)
-    QString creationDate = QDateTime::currentDateTime().toString(Qt::ISODate);
-    QByteArray dateBytes = creationDate.toUtf8();
-    int dateToCopy = qMin(dateBytes.size(), 31);
-    memcpy(metadata.creationDate, dateBytes.constData(), dateToCopy);
-    
-    // Preserve lastSelectedTask
-    if (!lastSelectedTask.isEmpty()) {
-        QByteArray taskBytes = lastSelectedTask.toUtf8();
-        int taskToCopy = qMin(taskBytes.size(), 127);
-        memcpy(metadata.lastSelectedTask, taskBytes.constData(), taskToCopy);
+    QByteArray header;
+    QJsonArray tasks;
+    if (!TasklistRecordLog::read(filePath, m_mainWindow->user_Key, header, tasks)) {
+        qWarning() << "Operations_TaskLists: Failed to read tasklist file";
+        return false;
     }
     
-    // Write metadata to temp file
-    tempFile.write(reinterpret_cast<const char*>(&metadata), METADATA_SIZE);
-    
-    // Write task lines
-    for (const QString& line : taskLines) {
-        if (!line.isEmpty()) {
-            tempFile.write(line.toUtf8());
-            tempFile.write("\n");
-        }
+    // Verify magic
+    if (!header.startsWith(QByteArray(TASKLIST_MAGIC, 8))) {
+        qWarning() << "Operations_TaskLists: Invalid magic number";
+        return false;
     }
     
-    tempFile.close();
-    
-    // Encrypt the temp file to the final location
-    bool success = CryptoUtils::Encryption_EncryptFile(m_mainWindow->user_Key, tempPath, filePath);
+    // Update the lastSelectedTask field, only the new header is appended to the log
+    setMetadataField(header, offsetof(TasklistMetadata, lastSelectedTask),
+                     sizeof(TasklistMetadata::lastSelectedTask), taskName);
     
-    // Clean up temp file
-    QFile::remove(tempPath);
+    bool success = TasklistRecordLog::write(filePath, m_mainWindow->user_Key, header, tasks);
     
-    if (!success) {
-        qWarning() << "Operations_TaskLists: Failed to encrypt tasklist file";
+    if (success) {
+        m_taskSummaries.touch(filePath);
+    } else {
+        qWarning() << "Operations_TaskLists: Failed to write tasklist file";
     }
     
     return success;
@@ -1170,7 +942,8 @@ void Operations_TaskLists::EditSelectedTask()
 }
 
 //--------Task List Display Functions--------//
-void Operations_TaskLists::LoadIndividualTasklist(const QString& tasklistName, const QString& taskToSelect)
+void Operations_TaskLists::LoadIndividualTasklist(const QString& tasklistName, const QString& taskToSelect,
+                                                  const QString& taskIdToSelect)
 {
     qDebug() << "Operations_TaskLists: Loading tasklist:" << tasklistName << "with task to select:" << taskToSelect;
     
@@ -1214,33 +987,14 @@ void Operations_TaskLists::LoadIndividualTasklist(const QString& tasklistName, c
     
     // If taskToSelect is empty or "NULL", try to read lastSelectedTask from metadata
     if (actualTaskToSelect.isEmpty() || actualTaskToSelect == "NULL") {
-        // Read metadata to get lastSelectedTask
-        QString tempDir = "Data/" + m_mainWindow->user_Username + "/temp/";
-        if (OperationsFiles::ensureDirectoryExists(tempDir)) {
-            QString tempPath = TaskDataSecurity::generateSecureTempFileName("read_last_selected", tempDir);
-            
-            if (CryptoUtils::Encryption_DecryptFile(m_mainWindow->user_Key, taskListFilePath, tempPath)) {
-                QFile tempFile(tempPath);
-                if (tempFile.open(QIODevice::ReadOnly)) {
-                    // Read metadata
-                    QByteArray metadataBytes = tempFile.read(METADATA_SIZE);
-                    if (metadataBytes.size() == METADATA_SIZE) {
-                        const TasklistMetadata* metadata = reinterpret_cast<const TasklistMetadata*>(metadataBytes.constData());
-                        
-                        // Extract lastSelectedTask (ensure null-terminated)
-                        char taskBuffer[129];
-                        memcpy(taskBuffer, metadata->lastSelectedTask, 128);
-                        taskBuffer[128] = '\0';
-                        QString lastSelectedTask = QString::fromUtf8(taskBuffer);
-                        
-                        if (!lastSelectedTask.isEmpty()) {
-                            actualTaskToSelect = lastSelectedTask;
-                            qDebug() << "Operations_TaskLists: Using lastSelectedTask from metadata:" << actualTaskToSelect;
-                        }
-                    }
-                    tempFile.close();
-                }
-                QFile::remove(tempPath);
+        QByteArray header;
+        QJsonArray headerTasks;
+        if (TasklistRecordLog::read(taskListFilePath, m_mainWindow->user_Key, header, headerTasks)) {
+            QString lastSelectedTask = metadataField(header, offsetof(TasklistMetadata, lastSelectedTask),
+                                                     sizeof(TasklistMetadata::lastSelectedTask));
+            if (!lastSelectedTask.isEmpty()) {
+                actualTaskToSelect = lastSelectedTask;
+                qDebug() << "Operations_TaskLists: Using lastSelectedTask from metadata:" << actualTaskToSelect;
             }
         }
     }
@@ -1260,47 +1014,6 @@ void Operations_TaskLists::LoadIndividualTasklist(const QString& tasklistName, c
         return;
     }
 
-    // Decrypt the file to read tasks
-    QString tempDir = "Data/" + m_mainWindow->user_Username + "/temp/";
-    if (!OperationsFiles::ensureDirectoryExists(tempDir)) {
-        QMessageBox::warning(m_mainWindow, "Directory Error",
-                            "Could not create temporary directory.");
-        return;
-    }
-    
-    QString tempPath = TaskDataSecurity::generateSecureTempFileName("load_tasklist", tempDir);
-    
-    if (!CryptoUtils::Encryption_DecryptFile(m_mainWindow->user_Key, taskListFilePath, tempPath)) {
-        QMessageBox::warning(m_mainWindow, "Read Error",
-                            "Could not decrypt the task list file.");
-        return;
-    }
-    
-    // Read the decrypted file
-    QFile tempFile(tempPath);
-    if (!tempFile.open(QIODevice::ReadOnly)) {
-        QFile::remove(tempPath);
-        QMessageBox::warning(m_mainWindow, "Read Error",
-                            "Could not open decrypted task list file.");
-        return;
-    }
-    
-    // Skip the metadata header (512 bytes)
-    tempFile.seek(METADATA_SIZE);
-    
-    // Read all task lines
-    QTextStream stream(&tempFile);
-    QStringList taskLines;
-    while (!stream.atEnd()) {
-        QString line = stream.readLine();
-        if (!line.isEmpty()) {
-            taskLines.append(line);
-        }
-    }
-    
-    tempFile.close();
-    QFile::remove(tempPath);
-
     // Set the task list label with the name
     m_mainWindow->ui->label_TaskListName->setText(tasklistName);
 
@@ -1311,8 +1024,8 @@ void Operations_TaskLists::LoadIndividualTasklist(const QString& tasklistName, c
         // Continue with empty task list
     }
 
-    // Process each task from JSON
-    for (const QJsonValue& value : tasks) {
+    // Process each task from JSON, in the order of their order keys
+    for (const QJsonValue& value : sortedByOrderKey(tasks)) {
         if (!value.isObject()) continue;
         
         QJsonObject taskObj = value.toObject();
@@ -1398,7 +1111,12 @@ void Operations_TaskLists::LoadIndividualTasklist(const QString& tasklistName, c
         realTaskCount++;
         lastRealTaskIndex = i;  // Track the last real task index
         
-        if (!actualTaskToSelect.isEmpty() && actualTaskToSelect != "NULL" && item->text() == actualTaskToSelect) {
+        // An ID names exactly one task, it wins over a name that may have changed or be shared
+        if (!taskIdToSelect.isEmpty()) {
+            if (item->data(Qt::UserRole).toString() == taskIdToSelect) {
+                taskToSelectIndex = i;
+            }
+        } else if (!actualTaskToSelect.isEmpty() && actualTaskToSelect != "NULL" && item->text() == actualTaskToSelect) {
             taskToSelectIndex = i;
         }
     }
@@ -1511,38 +1229,6 @@ void Operations_TaskLists::LoadTaskDetails(const QString& taskName)
         return;
     }
 
-    // Security: Use secure temporary file generation
-    QString tempDir = "Data/" + m_mainWindow->user_Username + "/temp/";
-    if (!OperationsFiles::ensureDirectoryExists(tempDir)) {
-        QMessageBox::warning(m_mainWindow, "Directory Error",
-                            "Could not create temporary directory.");
-        return;
-    }
-
-    QString tempPath = TaskDataSecurity::generateSecureTempFileName("load_task_details", tempDir);
-
-    // Create a scope guard for temp file cleanup
-    class TempFileGuard {
-    public:
-        TempFileGuard(const QString& path) : m_path(path) {}
-        ~TempFileGuard() { QFile::remove(m_path); }
-    private:
-        QString m_path;
-    };
-
-    // Decrypt the file to a temporary location
-    bool decrypted = CryptoUtils::Encryption_DecryptFile(
-        m_mainWindow->user_Key, taskListFilePath, tempPath);
-
-    if (!decrypted) {
-        QFile::remove(tempPath); // Immediate cleanup on failure
-        QMessageBox::warning(m_mainWindow, "Decryption Failed",
-                            "Could not decrypt task list file.");
-        return;
-    }
-
-    TempFileGuard tempGuard(tempPath); // Ensures cleanup on scope exit
-
     // Set up the table widget
     QTableWidget* taskDetailsTable = m_mainWindow->ui->tableWidget_TaskDetails;
     taskDetailsTable->clear();
@@ -1571,21 +1257,12 @@ void Operations_TaskLists::LoadTaskDetails(const QString& taskName)
     taskDetailsTable->setMinimumHeight(totalHeight);
     taskDetailsTable->setMaximumHeight(totalHeight);
 
-    // Open the decrypted file
-    QFile file(tempPath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QFile::remove(tempPath);
-        QMessageBox::warning(m_mainWindow, "File Error",
-                            "Could not open task list file for reading.");
-        return;
-    }
-
-    file.close();
-    
     // Read JSON tasks
     QJsonArray tasks;
     if (!readTasklistJson(taskListFilePath, tasks)) {
         qWarning() << "Operations_TaskLists: Failed to read JSON tasks for details";
+        QMessageBox::warning(m_mainWindow, "Decryption Failed",
+                            "Could not decrypt task list file.");
         return;
     }
 
@@ -1720,6 +1397,11 @@ QString Operations_TaskLists::FormatDateTime(const QDateTime& dateTime)
 }
 
 //--------Task List Management Functions--------//
+void Operations_TaskLists::flushPendingSaves()
+{
+    m_taskSummaries.flush();
+}
+
 void Operations_TaskLists::LoadTasklists()
 {
     qDebug() << "Operations_TaskLists: Loading tasklists";
@@ -1732,9 +1414,6 @@ void Operations_TaskLists::LoadTasklists()
     }
     
     treeWidget->clear();
-    
-    // Clear the cache
-    m_tasklistNameToFile.clear();
 
     QString tasksListsPath = "Data/" + m_mainWindow->user_Username + "/Tasklists/";
 
@@ -1761,28 +1440,20 @@ void Operations_TaskLists::LoadTasklists()
     filters << "tasklist_*.txt";
     QStringList tasklistFiles = tasksListsDir.entryList(filters, QDir::Files);
 
-    // Map to store tasklist names and their file paths
-    QMap<QString, QString> tasklistNameToPath;
-    QStringList allTasklistNames;
+    // Names come from the persisted index, only tasklists it doesn't know are decrypted
+    m_tasklistNameToFile.load();
+    indexUnknownTasklistFiles();
 
-    // Read metadata from each file to get tasklist names
+    // Summaries of lists changed since they were counted are dropped and recounted on demand
+    m_taskSummaries.load();
+    m_taskSummaries.reconcile(tasklistFiles);
+
+    QStringList allTasklistNames;
     for (const QString& filename : tasklistFiles) {
-        QString filePath = tasksListsPath + filename;
-        QString tasklistName;
-        
-        // Skip TasklistOrder.txt if it exists
-        if (filename.toLower() == "tasklistorder.txt") {
-            continue;
-        }
-        
-        // Read metadata to get the actual tasklist name
-        if (!readTasklistMetadata(filePath, tasklistName, m_mainWindow->user_Key)) {
-            qWarning() << "Operations_TaskLists: Failed to read metadata from" << filename;
-            continue;
+        const QString tasklistName = m_tasklistNameToFile.nameForFile(filename);
+        if (!tasklistName.isEmpty()) {
+            allTasklistNames.append(tasklistName);
         }
-        
-        tasklistNameToPath[tasklistName] = filePath;
-        allTasklistNames.append(tasklistName);
     }
 
     // If settings weren't loaded or incomplete, handle orphaned tasklists
@@ -2034,68 +1705,17 @@ void Operations_TaskLists::CreateTaskListFile(const QString& listName)
         return;
     }
 
-    // Create temporary file for writing metadata and initial content
-    QString tempDir = "Data/" + m_mainWindow->user_Username + "/temp/";
-    if (!OperationsFiles::ensureDirectoryExists(tempDir)) {
-        QMessageBox::warning(m_mainWindow, "Directory Error",
-                            "Could not create temporary directory.");
-        return;
-    }
-    
-    QString tempPath = TaskDataSecurity::generateSecureTempFileName("new_tasklist", tempDir);
-    QFile tempFile(tempPath);
-    
-    if (!tempFile.open(QIODevice::WriteOnly)) {
-        QMessageBox::warning(m_mainWindow, "File Error",
-                            "Could not create temporary file.");
-        return;
-    }
-    
-    // Create and write metadata
-    TasklistMetadata metadata;
-    memset(&metadata, 0, sizeof(metadata));
-    
-    // Set magic and version
-    strncpy(metadata.magic, TASKLIST_MAGIC, 8);
-    strncpy(metadata.version, TASKLIST_VERSION, 4);
-    
-    // Set tasklist name
-    QByteArray nameBytes = listName.toUtf8();
-    int nameToCopy = qMin(nameBytes.size(), 255);
-    memcpy(metadata.name, nameBytes.constData(), nameToCopy);
-    
-    // Set creation date
-    QString creationDate = QDateTime::currentDateTime().toString(Qt::ISODate);
-    QByteArray dateBytes = creationDate.toUtf8();
-    int dateToCopy = qMin(dateBytes.size(), 31);
-    memcpy(metadata.creationDate, dateBytes.constData(), dateToCopy);
-    
-    // Write metadata to temp file
-    tempFile.write(reinterpret_cast<const char*>(&metadata), METADATA_SIZE);
-    
-    // Write initial JSON structure with empty tasks array
-    QJsonObject root;
-    root["version"] = 2;
-    root["tasks"] = QJsonArray();  // Empty task array
-    
-    QJsonDocument doc(root);
-    tempFile.write(doc.toJson(QJsonDocument::Compact));
-    
-    tempFile.close();
-    
-    // Encrypt the temp file to the final location
-    if (!CryptoUtils::Encryption_EncryptFile(m_mainWindow->user_Key, tempPath, taskListFilePath)) {
-        QFile::remove(tempPath);
+    // Metadata header and an empty task array
+    if (!TasklistRecordLog::write(taskListFilePath, m_mainWindow->user_Key,
+                                  createTasklistMetadata(listName), QJsonArray())) {
         QMessageBox::warning(m_mainWindow, "File Creation Failed",
                             "Failed to create encrypted task list file.");
         return;
     }
     
-    // Clean up temp file
-    QFile::remove(tempPath);
-    
-    // Update the cache
+    // Update the index
     m_tasklistNameToFile.insert(listName, taskListFilePath);
+    m_taskSummaries.update(taskListFilePath, 0, 0);
     
     // Load the newly created tasklist
     LoadIndividualTasklist(listName, "NULL");
@@ -2155,6 +1775,7 @@ void Operations_TaskLists::CreateNewTask()
     QString taskId = QUuid::createUuid().toString();
     QString creationDate = QDateTime::currentDateTime().toString(Qt::ISODate);
     QJsonObject newTask = taskToJson(uniqueName, false, "", creationDate, "", taskId);
+    newTask["order"] = nextTaskOrderKey(tasks);
     
     // Add the new task to the array
     tasks.append(newTask);
@@ -2325,8 +1946,12 @@ void Operations_TaskLists::DeleteTaskList()
         return;
     }
     
-    // Remove from cache
+    // Remove from index
     m_tasklistNameToFile.remove(taskListName);
+    m_taskSummaries.remove(taskListFilePath);
+    if (m_searchIndex) {
+        m_searchIndex->removeFile(taskListFilePath);
+    }
 
     // Get parent category before deletion
     QTreeWidgetItem* parentCategory = currentItem->parent();
@@ -2451,71 +2076,28 @@ void Operations_TaskLists::RenameTasklist(QListWidgetItem* item)
         return;
     }
 
-    // Decrypt the file to update metadata
-    QString tempDir = "Data/" + m_mainWindow->user_Username + "/temp/";
-    if (!OperationsFiles::ensureDirectoryExists(tempDir)) {
-        QMessageBox::warning(m_mainWindow, "Directory Error",
-                            "Could not create temporary directory.");
-        item->setText(originalName);
-        return;
-    }
-
-    QString tempPath = TaskDataSecurity::generateSecureTempFileName("rename", tempDir);
-
-    // Decrypt the file
-    if (!CryptoUtils::Encryption_DecryptFile(m_mainWindow->user_Key, taskListFilePath, tempPath)) {
+    // Read the file to update metadata
+    QByteArray header;
+    QJsonArray tasks;
+    if (!TasklistRecordLog::read(taskListFilePath, m_mainWindow->user_Key, header, tasks)) {
         QMessageBox::warning(m_mainWindow, "Decryption Failed",
                             "Could not decrypt task list file.");
         item->setText(originalName);
         return;
     }
 
-    // Read the file
-    QFile tempFile(tempPath);
-    if (!tempFile.open(QIODevice::ReadWrite)) {
-        QFile::remove(tempPath);
-        QMessageBox::warning(m_mainWindow, "File Error",
-                            "Could not open task list file.");
-        item->setText(originalName);
-        return;
-    }
-
-    // Read all content
-    QByteArray allContent = tempFile.readAll();
-    
-    // Update metadata header with new name
-    TasklistMetadata metadata;
-    if (allContent.size() >= METADATA_SIZE) {
-        memcpy(&metadata, allContent.constData(), METADATA_SIZE);
-        
-        // Update the name field
-        memset(metadata.name, 0, 256);
-        QByteArray nameBytes = newName.toUtf8();
-        int nameToCopy = qMin(nameBytes.size(), 255);
-        memcpy(metadata.name, nameBytes.constData(), nameToCopy);
-        
-        // Write back the updated metadata
-        tempFile.seek(0);
-        tempFile.write(reinterpret_cast<const char*>(&metadata), METADATA_SIZE);
-        tempFile.write(allContent.mid(METADATA_SIZE));  // Write the rest of the content
-    }
-    
-    tempFile.close();
-
-    // Re-encrypt the file
-    if (!CryptoUtils::Encryption_EncryptFile(m_mainWindow->user_Key, tempPath, taskListFilePath)) {
-        QFile::remove(tempPath);
+    // Update metadata header with new name, only the new header is appended to the log
+    setMetadataField(header, offsetof(TasklistMetadata, name), sizeof(TasklistMetadata::name), newName);
+    if (!TasklistRecordLog::write(taskListFilePath, m_mainWindow->user_Key, header, tasks)) {
         QMessageBox::warning(m_mainWindow, "Encryption Failed",
                             "Could not save the renamed task list.");
         item->setText(originalName);
         return;
     }
-
-    QFile::remove(tempPath);
     
-    // Update cache
-    m_tasklistNameToFile.remove(originalName);
-    m_tasklistNameToFile.insert(newName, taskListFilePath);
+    // Update index
+    m_tasklistNameToFile.rename(originalName, newName);
+    m_taskSummaries.touch(taskListFilePath);
 
     // Find and update the tree item
     QTreeWidgetItem* treeItem = treeWidget->findTasklist(originalName);
@@ -2693,6 +2275,7 @@ void Operations_TaskLists::AddTaskSimple(QString taskName, QString description)
     QString taskId = QUuid::createUuid().toString();
     QString creationDate = QDateTime::currentDateTime().toString(Qt::ISODate);
     QJsonObject newTask = taskToJson(taskName, false, "", creationDate, description, taskId);
+    newTask["order"] = nextTaskOrderKey(tasks);
     
     // Add the new task to the array
     tasks.append(newTask);
@@ -3299,19 +2882,19 @@ void Operations_TaskLists::SaveTaskOrder()
         return;
     }
 
-    // Create a map of task names to their JSON objects
-    QMap<QString, QJsonObject> taskMap;
-    for (const QJsonValue& value : existingTasks) {
-        if (!value.isObject()) continue;
-        QJsonObject taskObj = value.toObject();
-        QString taskName = taskObj["name"].toString();
+    // Array positions of the tasks by name
+    QMap<QString, int> taskIndexes;
+    for (int i = 0; i < existingTasks.size(); ++i) {
+        if (!existingTasks[i].isObject()) continue;
+        QString taskName = existingTasks[i].toObject()["name"].toString();
         if (!taskName.isEmpty()) {
-            taskMap[taskName] = taskObj;
+            taskIndexes[taskName] = i;
         }
     }
 
-    // Build new ordered task array based on display order
-    QJsonArray reorderedTasks;
+    // The tasks in display order, with their checkbox state
+    QVector<int> displayOrder;
+    QVector<bool> displayChecked;
     
     int itemCount = safeGetItemCount(taskDisplayWidget);
     for (int i = 0; i < itemCount; ++i) {
@@ -3325,23 +2908,53 @@ void Operations_TaskLists::SaveTaskOrder()
         if ((item->flags() & Qt::ItemIsEnabled) == 0) continue;
 
         QString taskName = item->text();
-        if (taskMap.contains(taskName)) {
-            // Update the completion status based on the checkbox state
-            QJsonObject taskObj = taskMap[taskName];
-            taskObj["completed"] = (item->checkState() == Qt::Checked);
-            
-            reorderedTasks.append(taskObj);
-            taskMap.remove(taskName);  // Remove to track any missing tasks
+        if (taskIndexes.contains(taskName)) {
+            displayOrder.append(taskIndexes.take(taskName));  // Take to track any missing tasks
+            displayChecked.append(item->checkState() == Qt::Checked);
         }
     }
 
     // Add any remaining tasks that weren't in the display (shouldn't happen, but safety check)
-    for (const QJsonObject& taskObj : taskMap.values()) {
-        reorderedTasks.append(taskObj);
+    for (int index : taskIndexes.values()) {
+        displayOrder.append(index);
+        displayChecked.append(existingTasks[index].toObject()["completed"].toBool());
+    }
+
+    // The array keeps its order, only the tasks that moved get a new order key. A drag and drop
+    // is then a single changed field in the tasklist log instead of the whole list.
+    QStringList orderKeys;
+    for (int index : displayOrder) {
+        orderKeys.append(existingTasks[index].toObject()["order"].toString());
+    }
+    const QVector<int> reassigned = TasklistOrderKeys::reassign(orderKeys);
+    const QSet<int> movedTasks(reassigned.begin(), reassigned.end());
+
+    QJsonArray updatedTasks = existingTasks;
+    bool changed = false;
+    for (int i = 0; i < displayOrder.size(); ++i) {
+        QJsonObject taskObj = updatedTasks[displayOrder[i]].toObject();
+        bool taskChanged = false;
+        if (movedTasks.contains(i)) {
+            taskObj["order"] = orderKeys[i];
+            taskChanged = true;
+        }
+        // Update the completion status based on the checkbox state
+        if (taskObj["completed"].toBool() != displayChecked[i]) {
+            taskObj["completed"] = displayChecked[i];
+            taskChanged = true;
+        }
+        if (taskChanged) {
+            updatedTasks[displayOrder[i]] = taskObj;
+            changed = true;
+        }
+    }
+
+    if (!changed) {
+        return;
     }
 
-    // Write back the reordered tasks
-    if (!writeTasklistJson(taskListFilePath, reorderedTasks)) {
+    // Write back the new order keys
+    if (!writeTasklistJson(taskListFilePath, updatedTasks)) {
         qWarning() << "Operations_TaskLists: Could not write reordered task list";
         return;
     }
@@ -3454,35 +3067,22 @@ bool Operations_TaskLists::AreAllTasksCompleted(const QString& tasklistName)
         return false;
     }
 
-    // Read JSON tasks
-    QJsonArray tasks;
-    if (!readTasklistJson(taskListFilePath, tasks)) {
-        qDebug() << "Operations_TaskLists: Failed to read JSON tasks for completion check";
-        return false;
-    }
-    
-    // If there are no tasks, it's not considered "completed"
-    if (tasks.isEmpty()) {
-        return false;
-    }
-    
-    int taskCount = 0;
-    int completedCount = 0;
-    
-    // Check each task's completion status
-    for (const QJsonValue& value : tasks) {
-        if (!value.isObject()) continue;
-        
-        QJsonObject taskObj = value.toObject();
-        taskCount++;
-        
-        if (taskObj["completed"].toBool()) {
-            completedCount++;
+    // Every read and write of the tasklist keeps its summary current, the file is only
+    // decrypted here if it was never counted or changed outside the app
+    TasklistSummaryCache::Summary summary;
+    if (!m_taskSummaries.summary(taskListFilePath, summary)) {
+        QJsonArray tasks;
+        if (!readTasklistJson(taskListFilePath, tasks)) {
+            qDebug() << "Operations_TaskLists: Failed to read JSON tasks for completion check";
+            return false;
+        }
+        if (!m_taskSummaries.summary(taskListFilePath, summary)) {
+            return false;
         }
     }
     
     // Return true only if there's at least one task and all are completed
-    return (taskCount > 0 && taskCount == completedCount);
+    return summary.allCompleted();
 }
 
 void Operations_TaskLists::UpdateTasklistAppearance(const QString& tasklistName)
@@ -4291,7 +3891,8 @@ void Operations_TaskLists::TransferTaskToTasklist(const QString& taskName, const
         transferredTask["id"] = QUuid::createUuid().toString();
     }
     
-    // Add transferred task to target
+    // Add transferred task to target, after the tasks already there
+    transferredTask["order"] = nextTaskOrderKey(targetTasks);
     targetTasks.append(transferredTask);
     
     // Save updated target tasklist
@@ -4355,6 +3956,156 @@ void Operations_TaskLists::UpdateAddTaskButtonState()
     }
 }
 
+//--------Task Search--------//
+void Operations_TaskLists::onTaskSearchRequested()
+{
+    if (!m_searchIndex) {
+        return;
+    }
+
+    QString searchText = m_mainWindow->ui->lineEdit_TaskSearch->text().trimmed();
+    if (searchText.isEmpty()) {
+        setTaskSearchMode(false);
+        return;
+    }
+
+    InputValidation::ValidationResult searchResult =
+        InputValidation::validateInput(searchText, InputValidation::InputType::PlainText, 500);
+    if (!searchResult.isValid) {
+        qWarning() << "Operations_TaskLists: Invalid task search text:" << searchResult.errorMessage;
+        return;
+    }
+
+    // First search of the session, index every tasklist in the background
+    if (!m_searchIndex->isBuilt()) {
+        QString tasksListsPath = "Data/" + m_mainWindow->user_Username + "/Tasklists/";
+        QDir dir(tasksListsPath);
+        QStringList filters;
+        filters << "tasklist_*.txt";
+        QStringList tasklistFilePaths;
+        for (const QString& filename : dir.entryList(filters, QDir::Files)) {
+            tasklistFilePaths.append(tasksListsPath + filename);
+        }
+        m_searchIndex->build(tasklistFilePaths);
+    }
+
+    QListWidget* resultsList = m_mainWindow->ui->listWidget_TaskSearchResults;
+    resultsList->clear();
+    setTaskSearchMode(true);
+
+    TasklistSearchIndex::Query query = TasklistSearchIndex::parseQuery(searchText);
+    if (query.isEmpty()) {
+        QListWidgetItem* item = new QListWidgetItem("Enter words to search for");
+        item->setFlags(Qt::NoItemFlags);
+        resultsList->addItem(item);
+        return;
+    }
+
+    const QList<TasklistSearchIndex::Hit> hits = m_searchIndex->search(query);
+    if (hits.isEmpty()) {
+        QListWidgetItem* item = new QListWidgetItem(m_searchIndex->isIndexing() ? "No matches yet, still indexing"
+                                                                                : "No matches");
+        item->setFlags(Qt::NoItemFlags);
+        resultsList->addItem(item);
+        return;
+    }
+
+    const QStringList terms = query.words();
+    for (const TasklistSearchIndex::Hit& hit : hits) {
+        QString tasklistName = m_tasklistNameToFile.nameForFile(hit.filePath);
+        if (tasklistName.isEmpty()) {
+            continue; // The tasklist was deleted since it was indexed
+        }
+
+        QString itemText = hit.taskName + "\n" + tasklistName;
+        if (hit.completed) {
+            itemText += " (completed)";
+        }
+        for (const QString& term : terms) {
+            if (hit.description.contains(term, Qt::CaseInsensitive)) {
+                itemText += "\n" + buildTaskSearchSnippet(hit.description, terms);
+                break;
+            }
+        }
+
+        QListWidgetItem* item = new QListWidgetItem(itemText);
+        if (!hit.description.isEmpty()) {
+            item->setToolTip(hit.description.left(1000));
+        }
+        item->setData(Qt::UserRole, hit.filePath);
+        item->setData(Qt::UserRole + 1, hit.taskId);
+        item->setData(Qt::UserRole + 2, hit.taskName);  // Only used for tasks without an ID
+        resultsList->addItem(item);
+    }
+}
+
+void Operations_TaskLists::openTaskSearchResult(QListWidgetItem* item)
+{
+    if (!item) {
+        return;
+    }
+    QString filePath = item->data(Qt::UserRole).toString();
+    QString taskId = item->data(Qt::UserRole + 1).toString();
+    QString taskName = item->data(Qt::UserRole + 2).toString();
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    // Looked up now rather than when the results were listed, the tasklist may have been renamed since
+    QString tasklistName = m_tasklistNameToFile.nameForFile(filePath);
+    if (tasklistName.isEmpty()) {
+        QMessageBox::warning(m_mainWindow, "Task List Not Found",
+                            "The task list of this task no longer exists.");
+        return;
+    }
+
+    // Select the tasklist without the selection signal, it would load the list a second time
+    // without the task selected
+    QTreeWidgetItem* tasklistItem = findTasklistItemInTree(tasklistName);
+    if (tasklistItem) {
+        QTreeWidget* treeWidget = m_mainWindow->ui->treeWidget_TaskList_List;
+        treeWidget->blockSignals(true);
+        treeWidget->setCurrentItem(tasklistItem);
+        treeWidget->blockSignals(false);
+    }
+
+    LoadIndividualTasklist(tasklistName, taskName, taskId);
+    UpdateAddTaskButtonState();
+}
+
+void Operations_TaskLists::setTaskSearchMode(bool active)
+{
+    // The results take the place of the tasklist tree while a search is shown
+    m_mainWindow->ui->listWidget_TaskSearchResults->setVisible(active);
+    m_mainWindow->ui->treeWidget_TaskList_List->setVisible(!active);
+    if (!active) {
+        m_mainWindow->ui->listWidget_TaskSearchResults->clear();
+    }
+}
+
+QString Operations_TaskLists::buildTaskSearchSnippet(const QString& text, const QStringList& terms) const
+{
+    const int SNIPPET_LENGTH = 80;
+
+    int matchIndex = -1;
+    for (const QString& term : terms) {
+        matchIndex = text.indexOf(term, 0, Qt::CaseInsensitive);
+        if (matchIndex >= 0) {
+            break;
+        }
+    }
+
+    int start = qMax(0, matchIndex - SNIPPET_LENGTH / 4);
+    QString snippet = text.mid(start, SNIPPET_LENGTH).simplified();
+    if (start > 0) {
+        snippet.prepend("...");
+    }
+    if (start + SNIPPET_LENGTH < text.length()) {
+        snippet.append("...");
+    }
+    return snippet;
+}
+
 //--------Context Menu Functions--------//
 void Operations_TaskLists::showContextMenu_TaskListDisplay(const QPoint &pos)
 {
@@ -4607,6 +4358,10 @@ void Operations_TaskLists::showContextMenu_TaskListList(const QPoint &pos)
                 if (!taskListFilePath.isEmpty()) {
                     QFile::remove(taskListFilePath);
                     m_tasklistNameToFile.remove(tasklistName);
+                    m_taskSummaries.remove(taskListFilePath);
+                    if (m_searchIndex) {
+                        m_searchIndex->removeFile(taskListFilePath);
+                    }
                 }
             }
             
@@ -18,8 +18,11 @@
 #include <QTreeWidget>
 #include <QTreeWidgetItem>
 #include "../../CustomWidgets/tasklists/qtree_Tasklists_list.h"
+#include "tasklist_nameindex.h"
+#include "tasklist_summarycache.h"
 
 class MainWindow;
+class TasklistSearchIndex;
 class Operations_TaskLists : public QObject
 {
     Q_OBJECT
@@ -46,10 +49,24 @@ private:
     // Helper functions for metadata
     bool writeTasklistMetadata(const QString& filePath, const QString& tasklistName, const QByteArray& key);
     bool readTasklistMetadata(const QString& filePath, QString& tasklistName, const QByteArray& key);
+    QByteArray createTasklistMetadata(const QString& tasklistName);
+    static QString metadataField(const QByteArray& header, int offset, int size);
+    static void setMetadataField(QByteArray& header, int offset, int size, const QString& value);
     bool updateLastSelectedTask(const QString& tasklistName, const QString& taskName);
     QString generateTasklistFilename();
     QString findTasklistFileByName(const QString& tasklistName);
-    ThreadSafeMap<QString, QString> m_tasklistNameToFile;  // Maps tasklist names to file paths
+    void indexUnknownTasklistFiles();
+    void healNameIndex(const QString& filePath, const QString& headerName);
+    TasklistNameIndex m_tasklistNameToFile;  // Maps tasklist names to file paths, persisted
+    TasklistSummaryCache m_taskSummaries;    // Task counts per tasklist file, for completion styling
+    void updateTaskSummary(const QString& filePath, const QJsonArray& tasks);
+    
+    // Search over the tasks of all tasklists, built on first use
+    TasklistSearchIndex* m_searchIndex = nullptr;
+    void onTaskSearchRequested();
+    void openTaskSearchResult(QListWidgetItem* item);
+    void setTaskSearchMode(bool active);
+    QString buildTaskSearchSnippet(const QString& text, const QStringList& terms) const;
     
     // Thread-safe container for managing task order during reordering
     ThreadSafeList<std::pair<QListWidgetItem*, int>> m_taskOrderCache;
@@ -67,6 +84,8 @@ private:
                       QString& completionDate, QString& creationDate, QString& description, QString& id);
     bool readTasklistJson(const QString& filePath, QJsonArray& tasks);
     bool writeTasklistJson(const QString& filePath, const QJsonArray& tasks);
+    static QString nextTaskOrderKey(const QJsonArray& tasks);
+    static QJsonArray sortedByOrderKey(const QJsonArray& tasks);
     
     SafeTimer* m_descriptionSaveTimer;
     QString m_currentTaskName;
@@ -115,10 +134,6 @@ private:
     bool validateListWidget(QListWidget* widget) const;
     int safeGetItemCount(QListWidget* widget) const;
     
-    // Custom file I/O that handles metadata properly
-    bool readTasklistFileWithMetadata(const QString& filePath, QStringList& taskLines);
-    bool writeTasklistFileWithMetadata(const QString& filePath, const QStringList& taskLines);
-    
     // ========== TUNABLE PARAMETERS FOR TABLE HEIGHT ==========
     // These should match the values in UpdateTasklistsTextSize
     const int ROW_PADDING = 4;        // Padding around row text
@@ -137,7 +152,9 @@ public:
     void CreateNewTaskList();
     void CreateTaskListFile(const QString& listName);
     void LoadTasklists();
-    void LoadIndividualTasklist(const QString& tasklistName, const QString& taskToSelect);
+    // taskIdToSelect, if given, selects the task by ID instead of by name
+    void LoadIndividualTasklist(const QString& tasklistName, const QString& taskToSelect,
+                                const QString& taskIdToSelect = QString());
     void LoadTaskDetails(const QString& taskName);
     void DeleteTaskList();
     void RenameTasklist(QListWidgetItem* item);
@@ -158,6 +175,9 @@ public:
     
     // Task description management
     void SaveTaskDescription();
+
+    // Writes the summary cache now instead of waiting for its save timer (logout, shutdown)
+    void flushPendingSaves();
     
     // Check if all tasks in a tasklist are completed
     bool AreAllTasksCompleted(const QString& tasklistName);
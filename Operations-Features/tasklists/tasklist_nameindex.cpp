@@ -0,0 +1,221 @@
+#include "tasklist_nameindex.h"
+#include "operations_files.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QDataStream>
+#include <QSet>
+#include <QDebug>
+#include <cstring>  // For std::memset
+
+const quint32 TasklistNameIndex::MANIFEST_MAGIC = 0x4D4D544C; // "MMTL"
+const quint32 TasklistNameIndex::MANIFEST_VERSION = 1;
+
+TasklistNameIndex::TasklistNameIndex(const QByteArray& encryptionKey, const QString& tasklistsPath)
+    : m_encryptionKey(encryptionKey)
+    , m_tasklistsPath(tasklistsPath)
+{
+}
+
+TasklistNameIndex::~TasklistNameIndex()
+{
+    // SECURITY: Clear sensitive data
+    m_fileByName.clear();
+    m_nameByFile.clear();
+    if (!m_encryptionKey.isEmpty()) {
+        volatile char* keyData = const_cast<volatile char*>(m_encryptionKey.data());
+        std::memset(const_cast<char*>(keyData), 0, m_encryptionKey.size());
+        m_encryptionKey.clear();
+    }
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+bool TasklistNameIndex::load()
+{
+    m_fileByName.clear();
+    m_nameByFile.clear();
+
+    if (!QFileInfo::exists(manifestPath())) {
+        return false;
+    }
+    QByteArray data;
+    if (!OperationsFiles::readEncryptedBlob(manifestPath(), m_encryptionKey, data)) {
+        qWarning() << "TasklistNameIndex: Failed to read manifest, tasklist headers will be rescanned";
+        return false;
+    }
+
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_15);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QHash<QString, QString> fileByName;
+    stream >> magic >> version >> fileByName;
+    if (stream.status() != QDataStream::Ok || magic != MANIFEST_MAGIC || version != MANIFEST_VERSION) {
+        qWarning() << "TasklistNameIndex: Invalid manifest, tasklist headers will be rescanned";
+        return false;
+    }
+
+    for (auto it = fileByName.constBegin(); it != fileByName.constEnd(); ++it) {
+        insertEntry(it.key(), it.value());
+    }
+    qDebug() << "TasklistNameIndex: Loaded" << m_fileByName.size() << "tasklist names from manifest";
+    return true;
+}
+
+QStringList TasklistNameIndex::reconcile(const QStringList& fileNames)
+{
+    const QSet<QString> onDisk(fileNames.begin(), fileNames.end());
+
+    bool changed = false;
+    for (auto it = m_nameByFile.begin(); it != m_nameByFile.end();) {
+        if (!onDisk.contains(it.key())) {
+            qDebug() << "TasklistNameIndex: Dropping entry of missing file:" << it.key();
+            m_fileByName.remove(it.value());
+            it = m_nameByFile.erase(it);
+            changed = true;
+        } else {
+            ++it;
+        }
+    }
+    if (changed) {
+        saveManifest();
+    }
+
+    QStringList unindexed;
+    for (const QString& fileName : fileNames) {
+        if (!m_nameByFile.contains(fileName)) {
+            unindexed.append(fileName);
+        }
+    }
+    return unindexed;
+}
+
+// ============================================================================
+// Updates
+// ============================================================================
+
+void TasklistNameIndex::insert(const QString& tasklistName, const QString& filePath)
+{
+    if (insertEntry(tasklistName, QFileInfo(filePath).fileName())) {
+        saveManifest();
+    }
+}
+
+void TasklistNameIndex::insert(const QHash<QString, QString>& filePathsByName)
+{
+    bool changed = false;
+    for (auto it = filePathsByName.constBegin(); it != filePathsByName.constEnd(); ++it) {
+        if (insertEntry(it.key(), QFileInfo(it.value()).fileName())) {
+            changed = true;
+        }
+    }
+    if (changed) {
+        saveManifest();
+    }
+}
+
+void TasklistNameIndex::remove(const QString& tasklistName)
+{
+    auto it = m_fileByName.find(tasklistName);
+    if (it == m_fileByName.end()) {
+        return;
+    }
+    m_nameByFile.remove(it.value());
+    m_fileByName.erase(it);
+    saveManifest();
+}
+
+void TasklistNameIndex::rename(const QString& oldName, const QString& newName)
+{
+    const QString fileName = m_fileByName.value(oldName);
+    if (fileName.isEmpty() || oldName == newName) {
+        return;
+    }
+    m_fileByName.remove(oldName);
+    m_nameByFile.remove(fileName);
+    insertEntry(newName, fileName);
+    saveManifest();
+}
+
+void TasklistNameIndex::clear()
+{
+    m_fileByName.clear();
+    m_nameByFile.clear();
+}
+
+bool TasklistNameIndex::insertEntry(const QString& tasklistName, const QString& fileName)
+{
+    if (tasklistName.isEmpty() || fileName.isEmpty()) {
+        return false;
+    }
+    if (m_fileByName.value(tasklistName) == fileName && m_nameByFile.value(fileName) == tasklistName) {
+        return false;
+    }
+
+    // Both directions stay one to one, a stale entry on either side is replaced
+    const QString previousFile = m_fileByName.value(tasklistName);
+    if (!previousFile.isEmpty()) {
+        qWarning() << "TasklistNameIndex: Tasklist" << tasklistName << "moved from" << previousFile << "to" << fileName;
+        m_nameByFile.remove(previousFile);
+    }
+    const QString previousName = m_nameByFile.value(fileName);
+    if (!previousName.isEmpty()) {
+        m_fileByName.remove(previousName);
+    }
+
+    m_fileByName.insert(tasklistName, fileName);
+    m_nameByFile.insert(fileName, tasklistName);
+    return true;
+}
+
+// ============================================================================
+// Lookups
+// ============================================================================
+
+QString TasklistNameIndex::filePath(const QString& tasklistName) const
+{
+    const QString fileName = m_fileByName.value(tasklistName);
+    if (fileName.isEmpty()) {
+        return QString();
+    }
+    return QDir(m_tasklistsPath).filePath(fileName);
+}
+
+QString TasklistNameIndex::nameForFile(const QString& filePath) const
+{
+    return m_nameByFile.value(QFileInfo(filePath).fileName());
+}
+
+// ============================================================================
+// Manifest
+// ============================================================================
+
+QString TasklistNameIndex::manifestPath() const
+{
+    return QDir(m_tasklistsPath).absoluteFilePath("tasklist_names.mmidx");
+}
+
+bool TasklistNameIndex::saveManifest() const
+{
+    if (m_encryptionKey.isEmpty() || !QDir(m_tasklistsPath).exists()) {
+        return false;
+    }
+
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_5_15);
+        stream << MANIFEST_MAGIC << MANIFEST_VERSION << m_fileByName;
+    }
+
+    const bool written = OperationsFiles::writeEncryptedBlob(manifestPath(), m_encryptionKey, data);
+    // SECURITY: The plain manifest holds the tasklist names
+    data.fill('\0');
+    if (!written) {
+        qWarning() << "TasklistNameIndex: Failed to write manifest:" << manifestPath();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,52 @@
+#ifndef TASKLIST_NAMEINDEX_H
+#define TASKLIST_NAMEINDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QHash>
+
+// Persisted map from tasklist names to their tasklist_<uuid>.txt files.
+// Tasklist files are named by UUID, their display name only lives in the encrypted header, so
+// finding a tasklist by name meant decrypting every file until one matched, and the map built
+// along the way was lost at logout. The map is now kept in an encrypted manifest next to the
+// tasklists, loaded at login and updated on create, rename and delete. Only files the manifest
+// doesn't know about (created by an older version, or copied in) ever have their header decrypted.
+class TasklistNameIndex
+{
+public:
+    TasklistNameIndex(const QByteArray& encryptionKey, const QString& tasklistsPath);
+    ~TasklistNameIndex();
+
+    // Loads the manifest, returns false (and an empty index) if there is none or it is unreadable
+    bool load();
+    // Drops the entries whose file is not in fileNames (tasklist_*.txt names, no path) and
+    // returns the file names that have no entry yet
+    QStringList reconcile(const QStringList& fileNames);
+
+    void insert(const QString& tasklistName, const QString& filePath);
+    void insert(const QHash<QString, QString>& filePathsByName);
+    void remove(const QString& tasklistName);
+    void rename(const QString& oldName, const QString& newName);
+    void clear();
+
+    bool contains(const QString& tasklistName) const { return m_fileByName.contains(tasklistName); }
+    bool isEmpty() const { return m_fileByName.isEmpty(); }
+    QString filePath(const QString& tasklistName) const;   // Empty if unknown
+    QString nameForFile(const QString& filePath) const;    // Empty if unknown
+
+private:
+    bool insertEntry(const QString& tasklistName, const QString& fileName);
+    bool saveManifest() const;
+    QString manifestPath() const;
+
+    static const quint32 MANIFEST_MAGIC;
+    static const quint32 MANIFEST_VERSION;
+
+    QByteArray m_encryptionKey;
+    QString m_tasklistsPath;
+    QHash<QString, QString> m_fileByName;   // Name -> file name, the path is not stored
+    QHash<QString, QString> m_nameByFile;
+};
+
+#endif // TASKLIST_NAMEINDEX_H
@@ -0,0 +1,220 @@
+#include "tasklist_orderkeys.h"
+#include <QDebug>
+
+const QString TasklistOrderKeys::DIGITS("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz");
+
+// ============================================================================
+// Key generation
+// ============================================================================
+
+QString TasklistOrderKeys::between(const QString& before, const QString& after)
+{
+    if ((!before.isEmpty() && !isValid(before)) || (!after.isEmpty() && !isValid(after))) {
+        return QString();
+    }
+    if (!before.isEmpty() && !after.isEmpty() && before >= after) {
+        return QString();
+    }
+
+    // Appending at the end is by far the most common case, stepping the first digit keeps those
+    // keys short where bisecting towards 1 would add a digit every few tasks
+    if (after.isEmpty() && !before.isEmpty()) {
+        return increment(before);
+    }
+    return midpoint(before, after);
+}
+
+// Fraction halfway between before and after (open bound when empty), before < after
+QString TasklistOrderKeys::midpoint(const QString& before, const QString& after)
+{
+    // Shared leading digits are kept, missing digits of before count as zeros
+    if (!after.isEmpty()) {
+        int common = 0;
+        while (common < after.size() &&
+               (common < before.size() ? before.at(common) : DIGITS.at(0)) == after.at(common)) {
+            ++common;
+        }
+        if (common > 0) {
+            return after.left(common) + midpoint(before.mid(common), after.mid(common));
+        }
+    }
+
+    const int digitBefore = before.isEmpty() ? 0 : digitValue(before.at(0));
+    const int digitAfter = after.isEmpty() ? BASE : digitValue(after.at(0));
+    if (digitAfter - digitBefore > 1) {
+        return QString(digitChar((digitBefore + digitAfter) / 2));
+    }
+
+    // Adjacent first digits. A longer after is itself above its first digit (no trailing zeros).
+    if (after.size() > 1) {
+        return after.left(1);
+    }
+    return QString(digitChar(digitBefore)) + midpoint(before.mid(1), QString());
+}
+
+QString TasklistOrderKeys::increment(const QString& key)
+{
+    if (key.isEmpty()) {
+        return QString(digitChar(BASE / 2));
+    }
+    const int firstDigit = digitValue(key.at(0));
+    if (firstDigit < BASE - 1) {
+        return QString(digitChar(firstDigit + 1));
+    }
+    return key.left(1) + increment(key.mid(1));
+}
+
+QStringList TasklistOrderKeys::evenlySpaced(int count)
+{
+    QStringList keys;
+    if (count <= 0) {
+        return keys;
+    }
+
+    // Fixed width fractions i / (count + 1), wide enough to tell them apart
+    int width = 1;
+    qint64 space = BASE;
+    while (space <= count && width < 10) {
+        space *= BASE;
+        ++width;
+    }
+    const qint64 step = space / (count + 1);
+
+    keys.reserve(count);
+    for (int i = 1; i <= count; ++i) {
+        qint64 value = step * i;
+        QString key(width, DIGITS.at(0));
+        for (int position = width - 1; position >= 0; --position) {
+            key[position] = digitChar(static_cast<int>(value % BASE));
+            value /= BASE;
+        }
+        while (key.endsWith(DIGITS.at(0))) {
+            key.chop(1);
+        }
+        keys.append(key);
+    }
+    return keys;
+}
+
+bool TasklistOrderKeys::isValid(const QString& key)
+{
+    if (key.isEmpty() || key.size() > MAX_KEY_LENGTH || key.endsWith(DIGITS.at(0))) {
+        return false;
+    }
+    for (const QChar& c : key) {
+        if (digitValue(c) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// Reordering
+// ============================================================================
+
+QVector<int> TasklistOrderKeys::reassign(QStringList& keys)
+{
+    QVector<int> changed;
+    for (QString& key : keys) {
+        if (!key.isEmpty() && !isValid(key)) {
+            key.clear();
+        }
+    }
+
+    // The longest run of entries already in ascending order stays where it is
+    const QVector<int> run = longestAscendingRun(keys);
+    if (run.isEmpty()) {
+        // Nothing has a key yet (a list written before keys existed)
+        keys = evenlySpaced(keys.size());
+        for (int i = 0; i < keys.size(); ++i) {
+            changed.append(i);
+        }
+        return changed;
+    }
+    QVector<bool> keep(keys.size(), false);
+    for (int index : run) {
+        keep[index] = true;
+    }
+
+    QString previous;
+    int nextKept = 0;
+    for (int i = 0; i < keys.size(); ++i) {
+        if (keep[i]) {
+            previous = keys.at(i);
+            continue;
+        }
+        while (nextKept < run.size() && run.at(nextKept) < i) {
+            ++nextKept;
+        }
+        const QString next = nextKept < run.size() ? keys.at(run.at(nextKept)) : QString();
+        const QString key = between(previous, next);
+        if (key.isEmpty() || key.size() > MAX_KEY_LENGTH) {
+            qDebug() << "TasklistOrderKeys: Keys too dense, rebalancing" << keys.size() << "entries";
+            const QStringList fresh = evenlySpaced(keys.size());
+            changed.clear();
+            for (int j = 0; j < keys.size(); ++j) {
+                if (keys.at(j) != fresh.at(j)) {
+                    changed.append(j);
+                }
+            }
+            keys = fresh;
+            return changed;
+        }
+        keys[i] = key;
+        previous = key;
+        changed.append(i);
+    }
+    return changed;
+}
+
+// Indexes of the longest strictly ascending subsequence of the non-empty keys
+QVector<int> TasklistOrderKeys::longestAscendingRun(const QStringList& keys)
+{
+    QVector<int> tails;                       // tails[length - 1]: index ending the best run of that length
+    QVector<int> predecessor(keys.size(), -1);
+    for (int i = 0; i < keys.size(); ++i) {
+        if (keys.at(i).isEmpty()) {
+            continue;
+        }
+        // First run whose tail is not below this key
+        int low = 0;
+        int high = tails.size();
+        while (low < high) {
+            const int middle = (low + high) / 2;
+            if (keys.at(tails.at(middle)) < keys.at(i)) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        predecessor[i] = low > 0 ? tails.at(low - 1) : -1;
+        if (low == tails.size()) {
+            tails.append(i);
+        } else {
+            tails[low] = i;
+        }
+    }
+
+    QVector<int> run(tails.size());
+    int index = tails.isEmpty() ? -1 : tails.last();
+    for (int position = tails.size() - 1; position >= 0; --position) {
+        run[position] = index;
+        index = predecessor.at(index);
+    }
+    return run;
+}
+
+int TasklistOrderKeys::digitValue(QChar digit)
+{
+    const ushort c = digit.unicode();
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'Z') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'z') return c - 'a' + 36;
+    return -1;
+}
+
+QChar TasklistOrderKeys::digitChar(int value)
+{
+    return DIGITS.at(value);
+}
@@ -0,0 +1,47 @@
+#ifndef TASKLIST_ORDERKEYS_H
+#define TASKLIST_ORDERKEYS_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// Sortable fractional keys for the display order of tasks.
+// The order used to be the position in the task array, so a drag and drop rewrote the order of
+// the whole list. Each task now carries a key and the list is shown sorted by key, moving a task
+// only gives it a new key between the keys of its new neighbours.
+// A key is the fraction digits of a number in (0, 1) written in base 62 ('0'-'9', 'A'-'Z',
+// 'a'-'z', in ASCII order so keys compare as plain strings), without trailing zeros. There is
+// always room between two keys, but repeatedly inserting at the same spot makes them longer, past
+// MAX_KEY_LENGTH the whole list is given fresh evenly spaced keys.
+class TasklistOrderKeys
+{
+public:
+    // A key that sorts strictly between before and after, an empty bound is open.
+    // Empty if the bounds are invalid or not in order.
+    static QString between(const QString& before, const QString& after);
+
+    // count keys spread evenly over the key space, in ascending order
+    static QStringList evenlySpaced(int count);
+
+    static bool isValid(const QString& key);
+
+    // Gives new keys to as few entries as possible so that keys (in the desired display order)
+    // become strictly ascending. The entries that already ascend keep their keys, empty or
+    // invalid keys count as out of place. Falls back to evenly spaced keys for all entries once
+    // a key would get too long. Returns the indexes of the entries whose key changed.
+    static QVector<int> reassign(QStringList& keys);
+
+    static const int MAX_KEY_LENGTH = 32;
+
+private:
+    static QString midpoint(const QString& before, const QString& after);
+    static QString increment(const QString& key);
+    static QVector<int> longestAscendingRun(const QStringList& keys);
+    static int digitValue(QChar digit);
+    static QChar digitChar(int value);
+
+    static const QString DIGITS;
+    static const int BASE = 62;
+};
+
+#endif // TASKLIST_ORDERKEYS_H
@@ -0,0 +1,375 @@
+#include "tasklist_searchindex.h"
+#include "tasklistrecordlog.h"
+#include <QDateTime>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QtConcurrent/QtConcurrent>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>  // For std::memset
+
+TasklistSearchIndex::TasklistSearchIndex(const QByteArray& encryptionKey, QObject* parent)
+    : QObject(parent)
+    , m_encryptionKey(encryptionKey)
+    , m_nextEntryId(0)
+    , m_indexTotal(0)
+    , m_built(false)
+{
+    m_threadPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+
+    connect(&m_indexWatcher, &QFutureWatcher<FileTasks>::resultReadyAt, this, &TasklistSearchIndex::onFileIndexed);
+    connect(&m_indexWatcher, &QFutureWatcher<FileTasks>::finished, this, &TasklistSearchIndex::onIndexingFinished);
+}
+
+TasklistSearchIndex::~TasklistSearchIndex()
+{
+    cancelIndexing();
+
+    // SECURITY: Clear sensitive data
+    for (TaskEntry& entry : m_entries) {
+        entry.name.fill(QChar(0));
+        entry.description.fill(QChar(0));
+    }
+    m_entries.clear();
+    m_terms.clear();
+    if (!m_encryptionKey.isEmpty()) {
+        volatile char* keyData = const_cast<volatile char*>(m_encryptionKey.data());
+        std::memset(const_cast<char*>(keyData), 0, m_encryptionKey.size());
+        m_encryptionKey.clear();
+    }
+}
+
+// ============================================================================
+// Building
+// ============================================================================
+
+void TasklistSearchIndex::build(const QStringList& tasklistFilePaths)
+{
+    if (m_built) {
+        return;
+    }
+    m_built = true;
+    m_changedWhileIndexing.clear();
+    m_indexTotal = tasklistFilePaths.size();
+    qDebug() << "TasklistSearchIndex: Indexing" << m_indexTotal << "tasklists";
+
+    const QByteArray encryptionKey = m_encryptionKey;
+    m_indexWatcher.setFuture(QtConcurrent::mapped(&m_threadPool, tasklistFilePaths,
+                                                  [encryptionKey](const QString& filePath) {
+                                                      return indexTasklistFile(filePath, encryptionKey);
+                                                  }));
+}
+
+bool TasklistSearchIndex::isIndexing() const
+{
+    return m_indexWatcher.isRunning();
+}
+
+void TasklistSearchIndex::cancelIndexing()
+{
+    if (m_indexWatcher.isRunning()) {
+        m_indexWatcher.cancel();
+        m_indexWatcher.waitForFinished();
+    }
+}
+
+void TasklistSearchIndex::onFileIndexed(int resultIndex)
+{
+    const FileTasks fileTasks = m_indexWatcher.resultAt(resultIndex);
+    if (fileTasks.valid && !m_changedWhileIndexing.contains(fileTasks.filePath)) {
+        mergeFile(fileTasks.filePath, fileTasks.entries);
+    }
+    emit indexingProgress(m_indexWatcher.progressValue(), m_indexTotal);
+}
+
+void TasklistSearchIndex::onIndexingFinished()
+{
+    if (m_indexWatcher.isCanceled()) {
+        return;
+    }
+    m_changedWhileIndexing.clear();
+    qDebug() << "TasklistSearchIndex: Indexing finished," << m_entries.size() << "tasks," << m_terms.size() << "terms";
+    emit indexingFinished();
+}
+
+TasklistSearchIndex::FileTasks TasklistSearchIndex::indexTasklistFile(const QString& filePath,
+                                                                      const QByteArray& encryptionKey)
+{
+    FileTasks fileTasks;
+    fileTasks.filePath = filePath;
+
+    // Uncached, hundreds of lists going through the record log cache would just evict each other
+    QByteArray header;
+    QJsonArray tasks;
+    if (!TasklistRecordLog::readUncached(filePath, encryptionKey, header, tasks)) {
+        qWarning() << "TasklistSearchIndex: Failed to read tasklist file for indexing:" << filePath;
+        return fileTasks;
+    }
+    header.fill('\0');
+
+    fileTasks.entries = buildEntries(filePath, tasks);
+    fileTasks.valid = true;
+    return fileTasks;
+}
+
+// ============================================================================
+// Incremental updates
+// ============================================================================
+
+void TasklistSearchIndex::updateFile(const QString& filePath, const QJsonArray& tasks)
+{
+    if (!m_built) {
+        return;
+    }
+    if (isIndexing()) {
+        m_changedWhileIndexing.insert(filePath);
+    }
+    mergeFile(filePath, buildEntries(filePath, tasks));
+}
+
+void TasklistSearchIndex::removeFile(const QString& filePath)
+{
+    if (!m_built) {
+        return;
+    }
+    if (isIndexing()) {
+        m_changedWhileIndexing.insert(filePath);
+    }
+    removeFileEntries(filePath);
+}
+
+void TasklistSearchIndex::mergeFile(const QString& filePath, const QVector<TaskEntry>& entries)
+{
+    removeFileEntries(filePath);
+
+    QVector<quint32>& fileEntryIds = m_fileEntries[filePath];
+    for (const TaskEntry& entry : entries) {
+        const quint32 entryId = m_nextEntryId++;
+        m_entries.insert(entryId, entry);
+        fileEntryIds.append(entryId);
+        for (const QString& term : entry.terms) {
+            m_terms[term].append(entryId);
+        }
+    }
+    if (fileEntryIds.isEmpty()) {
+        m_fileEntries.remove(filePath);
+    }
+}
+
+void TasklistSearchIndex::removeFileEntries(const QString& filePath)
+{
+    const QVector<quint32> entryIds = m_fileEntries.take(filePath);
+    for (quint32 entryId : entryIds) {
+        const TaskEntry entry = m_entries.take(entryId);
+        for (const QString& term : entry.terms) {
+            auto it = m_terms.find(term);
+            if (it == m_terms.end()) {
+                continue;
+            }
+            it->removeAll(entryId);
+            if (it->isEmpty()) {
+                m_terms.erase(it);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Tokenizing
+// ============================================================================
+
+QVector<TasklistSearchIndex::TaskEntry> TasklistSearchIndex::buildEntries(const QString& filePath,
+                                                                          const QJsonArray& tasks)
+{
+    QVector<TaskEntry> entries;
+    entries.reserve(tasks.size());
+    for (const QJsonValue& value : tasks) {
+        if (!value.isObject()) {
+            continue;
+        }
+        const QJsonObject taskObj = value.toObject();
+
+        TaskEntry entry;
+        entry.filePath = filePath;
+        entry.taskId = taskObj["id"].toString();
+        entry.name = taskObj["name"].toString();
+        entry.description = taskObj["description"].toString();
+        entry.completed = taskObj["completed"].toBool();
+
+        QStringList terms = tokenize(entry.name);
+        terms.append(tokenize(entry.description));
+        const QString creationDate = dateTerm(taskObj["creationDate"].toString());
+        if (!creationDate.isEmpty()) {
+            terms.append(creationDate);
+        }
+        const QString completionDate = dateTerm(taskObj["completionDate"].toString());
+        if (!completionDate.isEmpty()) {
+            terms.append(completionDate);
+        }
+        terms.removeDuplicates();
+        entry.terms = terms;
+
+        entries.append(entry);
+    }
+    return entries;
+}
+
+QString TasklistSearchIndex::dateTerm(const QString& isoDateTime)
+{
+    const QDateTime dateTime = QDateTime::fromString(isoDateTime, Qt::ISODate);
+    return dateTime.isValid() ? dateTime.date().toString("yyyy-MM-dd") : QString();
+}
+
+QStringList TasklistSearchIndex::tokenize(const QString& text)
+{
+    QStringList tokens;
+    QString current;
+    for (const QChar& c : text) {
+        if (c.isLetterOrNumber()) {
+            if (current.size() < MAX_TERM_LENGTH) {
+                current.append(c.toLower());
+            }
+        } else if (!current.isEmpty()) {
+            tokens.append(current);
+            current.clear();
+        }
+    }
+    if (!current.isEmpty()) {
+        tokens.append(current);
+    }
+    return tokens;
+}
+
+// ============================================================================
+// Searching
+// ============================================================================
+
+QStringList TasklistSearchIndex::Query::words() const
+{
+    QStringList words;
+    for (const QueryTerm& term : terms) {
+        words.append(term.text);
+    }
+    return words;
+}
+
+TasklistSearchIndex::Query TasklistSearchIndex::parseQuery(const QString& text)
+{
+    Query query;
+    const QStringList words = text.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
+    for (QString word : words) {
+        bool prefixOnly = false;
+        if (word.endsWith('*')) {
+            prefixOnly = true;
+            word.chop(1);
+        }
+
+        // Dates and parts of dates stay whole so they line up with the yyyy-MM-dd terms
+        static const QRegularExpression datePattern("^\\d{4}(-\\d{1,2}){0,2}-?$");
+        if (datePattern.match(word).hasMatch()) {
+            QueryTerm term;
+            term.text = word;
+            term.prefixOnly = prefixOnly;
+            query.terms.append(term);
+            continue;
+        }
+
+        // Punctuation splits a word the same way it splits the indexed text, only the last
+        // part keeps the prefix marker
+        const QStringList parts = tokenize(word);
+        for (int i = 0; i < parts.size(); ++i) {
+            QueryTerm term;
+            term.text = parts.at(i);
+            term.prefixOnly = prefixOnly && i == parts.size() - 1;
+            query.terms.append(term);
+        }
+    }
+    return query;
+}
+
+QSet<quint32> TasklistSearchIndex::matchTerm(const QueryTerm& term) const
+{
+    QSet<quint32> matches;
+    if (term.prefixOnly) {
+        for (auto it = m_terms.lowerBound(term.text); it != m_terms.constEnd() && it.key().startsWith(term.text); ++it) {
+            for (quint32 entryId : it.value()) {
+                matches.insert(entryId);
+            }
+        }
+    } else {
+        // The dictionary holds each distinct term once, far less to scan than the task texts
+        for (auto it = m_terms.constBegin(); it != m_terms.constEnd(); ++it) {
+            if (it.key().contains(term.text)) {
+                for (quint32 entryId : it.value()) {
+                    matches.insert(entryId);
+                }
+            }
+        }
+    }
+    return matches;
+}
+
+QList<TasklistSearchIndex::Hit> TasklistSearchIndex::search(const Query& query, int maxResults) const
+{
+    QList<Hit> hits;
+    if (query.isEmpty()) {
+        return hits;
+    }
+
+    QSet<quint32> candidates = matchTerm(query.terms.first());
+    for (int i = 1; i < query.terms.size() && !candidates.isEmpty(); ++i) {
+        candidates.intersect(matchTerm(query.terms.at(i)));
+    }
+
+    struct RankedHit {
+        quint32 entryId;
+        int score;
+    };
+    QVector<RankedHit> ranked;
+    ranked.reserve(candidates.size());
+    for (quint32 entryId : candidates) {
+        const TaskEntry& entry = *m_entries.constFind(entryId);
+        const QStringList nameTerms = tokenize(entry.name);
+        int score = 0;
+        for (const QueryTerm& term : query.terms) {
+            bool namePrefix = false;
+            bool nameContains = false;
+            for (const QString& nameTerm : nameTerms) {
+                if (nameTerm.startsWith(term.text)) {
+                    namePrefix = true;
+                    break;
+                }
+                if (nameTerm.contains(term.text)) {
+                    nameContains = true;
+                }
+            }
+            score += namePrefix ? 3 : (nameContains ? 2 : 1);
+        }
+        ranked.append({entryId, score});
+    }
+
+    std::sort(ranked.begin(), ranked.end(), [this](const RankedHit& a, const RankedHit& b) {
+        if (a.score != b.score) {
+            return a.score > b.score;
+        }
+        const TaskEntry& entryA = *m_entries.constFind(a.entryId);
+        const TaskEntry& entryB = *m_entries.constFind(b.entryId);
+        if (entryA.completed != entryB.completed) {
+            return !entryA.completed;
+        }
+        return entryA.name.localeAwareCompare(entryB.name) < 0;
+    });
+
+    const int hitCount = qMin(ranked.size(), maxResults);
+    for (int i = 0; i < hitCount; ++i) {
+        const TaskEntry& entry = *m_entries.constFind(ranked.at(i).entryId);
+        Hit hit;
+        hit.filePath = entry.filePath;
+        hit.taskId = entry.taskId;
+        hit.taskName = entry.name;
+        hit.description = entry.description;
+        hit.completed = entry.completed;
+        hits.append(hit);
+    }
+    return hits;
+}
@@ -0,0 +1,120 @@
+#ifndef TASKLIST_SEARCHINDEX_H
+#define TASKLIST_SEARCHINDEX_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QJsonArray>
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QVector>
+#include <QList>
+#include <QThreadPool>
+#include <QFutureWatcher>
+
+// Search over the tasks of all tasklists.
+// Finding a task used to mean opening its tasklist and scanning it by eye. This keeps every
+// task's name, description and dates in memory with a sorted term dictionary over them, so a
+// word typed in the search box is looked up without decrypting anything. The index is built on
+// first use, decrypting the tasklist files in parallel on a worker pool, and Operations_TaskLists
+// replaces a file's tasks in it whenever it writes that file. Nothing is persisted.
+//
+// Query syntax: every word must match the same task. A word matches any term containing it,
+// word* only terms starting with it. Dates are single terms (yyyy-MM-dd), so 2024-05 finds the
+// tasks created or completed in May 2024.
+class TasklistSearchIndex : public QObject
+{
+    Q_OBJECT
+public:
+    struct QueryTerm {
+        QString text;
+        bool prefixOnly = false;
+    };
+
+    struct Query {
+        QList<QueryTerm> terms;
+        bool isEmpty() const { return terms.isEmpty(); }
+        QStringList words() const;
+    };
+
+    struct Hit {
+        QString filePath;
+        QString taskId;
+        QString taskName;
+        QString description;
+        bool completed = false;
+    };
+
+    TasklistSearchIndex(const QByteArray& encryptionKey, QObject* parent = nullptr);
+    ~TasklistSearchIndex();
+
+    // Indexes the tasklist files unless that was already done (or is running)
+    void build(const QStringList& tasklistFilePaths);
+    bool isBuilt() const { return m_built; }
+    bool isIndexing() const;
+
+    // Incremental updates, called after a tasklist file was written or deleted.
+    // Ignored until the index is built, the build reads the files as they are then.
+    void updateFile(const QString& filePath, const QJsonArray& tasks);
+    void removeFile(const QString& filePath);
+
+    static Query parseQuery(const QString& text);
+    // Best matches first: name matches before description matches, open tasks before completed ones
+    QList<Hit> search(const Query& query, int maxResults = DEFAULT_MAX_RESULTS) const;
+
+    static QStringList tokenize(const QString& text);
+
+    static const int DEFAULT_MAX_RESULTS = 200;
+
+signals:
+    void indexingProgress(int done, int total);
+    void indexingFinished();
+
+private slots:
+    void onFileIndexed(int resultIndex);
+    void onIndexingFinished();
+
+private:
+    struct TaskEntry {
+        QString filePath;
+        QString taskId;
+        QString name;
+        QString description;
+        bool completed = false;
+        QStringList terms;          // Distinct terms of the task, so it can be removed without scanning the dictionary
+    };
+
+    struct FileTasks {
+        bool valid = false;
+        QString filePath;
+        QVector<TaskEntry> entries;
+    };
+
+    static FileTasks indexTasklistFile(const QString& filePath, const QByteArray& encryptionKey);
+    static QVector<TaskEntry> buildEntries(const QString& filePath, const QJsonArray& tasks);
+    static QString dateTerm(const QString& isoDateTime);
+
+    void mergeFile(const QString& filePath, const QVector<TaskEntry>& entries);
+    void removeFileEntries(const QString& filePath);
+    QSet<quint32> matchTerm(const QueryTerm& term) const;
+    void cancelIndexing();
+
+    static const int MAX_TERM_LENGTH = 64;
+
+    QByteArray m_encryptionKey;
+
+    QHash<quint32, TaskEntry> m_entries;
+    QHash<QString, QVector<quint32>> m_fileEntries;
+    QMap<QString, QVector<quint32>> m_terms;   // Sorted, prefix lookups are a range
+    quint32 m_nextEntryId;
+
+    QThreadPool m_threadPool;
+    QFutureWatcher<FileTasks> m_indexWatcher;
+    QSet<QString> m_changedWhileIndexing;      // Results for these files are stale by the time they arrive
+    int m_indexTotal;
+    bool m_built;
+};
+
+#endif // TASKLIST_SEARCHINDEX_H
@@ -0,0 +1,198 @@
+#include "tasklist_summarycache.h"
+#include "operations_files.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDataStream>
+#include <QDebug>
+#include <cstring>  // For std::memset
+
+const quint32 TasklistSummaryCache::MANIFEST_MAGIC = 0x4D4D5453; // "MMTS"
+const quint32 TasklistSummaryCache::MANIFEST_VERSION = 1;
+
+TasklistSummaryCache::TasklistSummaryCache(const QByteArray& encryptionKey, const QString& tasklistsPath)
+    : m_encryptionKey(encryptionKey)
+    , m_tasklistsPath(tasklistsPath)
+    , m_dirty(false)
+{
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(SAVE_DELAY_MS);
+    QObject::connect(&m_saveTimer, &QTimer::timeout, &m_saveTimer, [this]() { flush(); });
+}
+
+TasklistSummaryCache::~TasklistSummaryCache()
+{
+    flush();
+
+    // SECURITY: Clear sensitive data
+    if (!m_encryptionKey.isEmpty()) {
+        volatile char* keyData = const_cast<volatile char*>(m_encryptionKey.data());
+        std::memset(const_cast<char*>(keyData), 0, m_encryptionKey.size());
+        m_encryptionKey.clear();
+    }
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+bool TasklistSummaryCache::load()
+{
+    m_summaries.clear();
+
+    if (!QFileInfo::exists(manifestPath())) {
+        return false;
+    }
+    QByteArray data;
+    if (!OperationsFiles::readEncryptedBlob(manifestPath(), m_encryptionKey, data)) {
+        qWarning() << "TasklistSummaryCache: Failed to read manifest, tasklists will be recounted";
+        return false;
+    }
+
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_15);
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 count = 0;
+    stream >> magic >> version >> count;
+    if (stream.status() != QDataStream::Ok || magic != MANIFEST_MAGIC || version != MANIFEST_VERSION) {
+        qWarning() << "TasklistSummaryCache: Invalid manifest, tasklists will be recounted";
+        return false;
+    }
+
+    QHash<QString, Summary> summaries;
+    for (quint32 i = 0; i < count; ++i) {
+        QString fileName;
+        qint32 taskCount = 0;
+        qint32 completedCount = 0;
+        qint64 lastModified = 0;
+        stream >> fileName >> taskCount >> completedCount >> lastModified;
+        if (stream.status() != QDataStream::Ok || taskCount < 0 || completedCount < 0
+            || completedCount > taskCount) {
+            qWarning() << "TasklistSummaryCache: Invalid record in manifest, tasklists will be recounted";
+            return false;
+        }
+        Summary summary;
+        summary.taskCount = taskCount;
+        summary.completedCount = completedCount;
+        summary.lastModified = lastModified;
+        summaries.insert(fileName, summary);
+    }
+    m_summaries = summaries;
+    qDebug() << "TasklistSummaryCache: Loaded" << m_summaries.size() << "tasklist summaries from manifest";
+    return true;
+}
+
+void TasklistSummaryCache::reconcile(const QStringList& fileNames)
+{
+    QHash<QString, Summary> current;
+    for (const QString& fileName : fileNames) {
+        auto it = m_summaries.constFind(fileName);
+        if (it == m_summaries.constEnd()) {
+            continue;
+        }
+        const QFileInfo fileInfo(QDir(m_tasklistsPath).filePath(fileName));
+        if (fileInfo.lastModified().toMSecsSinceEpoch() != it->lastModified) {
+            qDebug() << "TasklistSummaryCache: Tasklist changed since it was counted:" << fileName;
+            continue;
+        }
+        current.insert(fileName, it.value());
+    }
+
+    if (current.size() != m_summaries.size()) {
+        m_summaries = current;
+        scheduleSave();
+    }
+}
+
+// ============================================================================
+// Updates
+// ============================================================================
+
+void TasklistSummaryCache::update(const QString& filePath, int taskCount, int completedCount)
+{
+    const QFileInfo fileInfo(filePath);
+    Summary summary;
+    summary.taskCount = taskCount;
+    summary.completedCount = completedCount;
+    summary.lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+    auto it = m_summaries.find(fileInfo.fileName());
+    if (it != m_summaries.end() && it->taskCount == summary.taskCount
+        && it->completedCount == summary.completedCount && it->lastModified == summary.lastModified) {
+        return;
+    }
+    m_summaries.insert(fileInfo.fileName(), summary);
+    scheduleSave();
+}
+
+void TasklistSummaryCache::touch(const QString& filePath)
+{
+    Summary current;
+    if (summary(filePath, current)) {
+        update(filePath, current.taskCount, current.completedCount);
+    }
+}
+
+void TasklistSummaryCache::remove(const QString& filePath)
+{
+    if (m_summaries.remove(QFileInfo(filePath).fileName()) > 0) {
+        scheduleSave();
+    }
+}
+
+bool TasklistSummaryCache::summary(const QString& filePath, Summary& outSummary) const
+{
+    auto it = m_summaries.constFind(QFileInfo(filePath).fileName());
+    if (it == m_summaries.constEnd()) {
+        return false;
+    }
+    outSummary = it.value();
+    return true;
+}
+
+// ============================================================================
+// Manifest
+// ============================================================================
+
+void TasklistSummaryCache::scheduleSave()
+{
+    m_dirty = true;
+    m_saveTimer.start();
+}
+
+void TasklistSummaryCache::flush()
+{
+    m_saveTimer.stop();
+    if (m_dirty && saveManifest()) {
+        m_dirty = false;
+    }
+}
+
+QString TasklistSummaryCache::manifestPath() const
+{
+    return QDir(m_tasklistsPath).absoluteFilePath("tasklist_summaries.mmidx");
+}
+
+bool TasklistSummaryCache::saveManifest() const
+{
+    if (m_encryptionKey.isEmpty() || !QDir(m_tasklistsPath).exists()) {
+        return false;
+    }
+
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_5_15);
+        stream << MANIFEST_MAGIC << MANIFEST_VERSION << quint32(m_summaries.size());
+        for (auto it = m_summaries.constBegin(); it != m_summaries.constEnd(); ++it) {
+            stream << it.key() << qint32(it->taskCount) << qint32(it->completedCount) << it->lastModified;
+        }
+    }
+
+    if (!OperationsFiles::writeEncryptedBlob(manifestPath(), m_encryptionKey, data)) {
+        qWarning() << "TasklistSummaryCache: Failed to write manifest:" << manifestPath();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,66 @@
+#ifndef TASKLIST_SUMMARYCACHE_H
+#define TASKLIST_SUMMARYCACHE_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QHash>
+#include <QTimer>
+
+// Task counts of every tasklist, kept so completion styling doesn't need the tasklist files.
+// Striking out completed tasklists and categories used to decrypt and parse every tasklist of the
+// tree, on every checkbox click. Each tasklist now has a small summary record that is refreshed
+// from the task array whenever its file is read or written, and persisted in an encrypted
+// manifest next to the tasklists. A record is only trusted while the file's modification time
+// still matches the one it was taken from, so lists changed outside the app are counted again.
+// Changes are written a few seconds after the last one, or right away by flush().
+class TasklistSummaryCache
+{
+public:
+    struct Summary {
+        int taskCount = 0;
+        int completedCount = 0;
+        qint64 lastModified = 0;    // Modification time of the file (ms since epoch) when counted
+
+        // Empty tasklists are not considered completed
+        bool allCompleted() const { return taskCount > 0 && completedCount == taskCount; }
+    };
+
+    TasklistSummaryCache(const QByteArray& encryptionKey, const QString& tasklistsPath);
+    ~TasklistSummaryCache();
+
+    // Loads the manifest, returns false (and an empty cache) if there is none or it is unreadable
+    bool load();
+    // Drops the records of files that are not in fileNames (tasklist_*.txt names, no path) or
+    // were modified since they were counted. Done once at login, lookups don't check the disk.
+    void reconcile(const QStringList& fileNames);
+
+    // Records the counts of a tasklist file that was just read or written
+    void update(const QString& filePath, int taskCount, int completedCount);
+    // Takes the new modification time of a file that was rewritten without its tasks changing
+    void touch(const QString& filePath);
+    void remove(const QString& filePath);
+
+    bool summary(const QString& filePath, Summary& outSummary) const;
+
+    // Writes pending changes now (logout, shutdown)
+    void flush();
+
+private:
+    void scheduleSave();
+    bool saveManifest() const;
+    QString manifestPath() const;
+
+    static const quint32 MANIFEST_MAGIC;
+    static const quint32 MANIFEST_VERSION;
+    static const int SAVE_DELAY_MS = 3000;
+
+    QByteArray m_encryptionKey;
+    QString m_tasklistsPath;
+    QHash<QString, Summary> m_summaries;   // By file name, the path is not stored
+
+    QTimer m_saveTimer;
+    bool m_dirty;
+};
+
+#endif // TASKLIST_SUMMARYCACHE_H
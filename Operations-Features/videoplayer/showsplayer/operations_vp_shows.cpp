@@ -29,6 +29,7 @@
 #include "vp_shows_favourites.h"  // Favourites management
 #include "../vp_metadata_lock_manager.h"  // Metadata lock manager for concurrent access protection
 #include "SafeTimer.h"
+#include "jobjournal.h"
 #include <QCheckBox>
 #include <QDataStream>
 #include <QDebug>
@@ -309,6 +310,11 @@ Operations_VP_Shows::Operations_VP_Shows(MainWindow* mainWindow)
     // Load the TV shows list on initialization
     // We use a small delay to ensure the UI is fully initialized
     QTimer::singleShot(100, this, &Operations_VP_Shows::loadTVShowsList);
+    
+    // Offer to resume interrupted imports once the shows list is loaded
+    SafeTimer::singleShot(500, this, [this]() {
+        resumeInterruptedImports();
+    }, "Operations_VP_Shows::ResumeInterruptedImports");
 }
 
 Operations_VP_Shows::~Operations_VP_Shows()
@@ -1015,7 +1021,9 @@ void Operations_VP_Shows::on_pushButton_VP_List_AddEpisode_clicked()
     
     // Start encryption with language and translation info
     m_encryptionDialog->startEncryption(filesToImport, targetFiles, showName, encryptionKey, username, 
-                                       language, translationMode, useTMDB, customPoster, customDescription, parseMode, m_dialogShowId);
+                                       language, translationMode, useTMDB, customPoster, customDescription, parseMode, m_dialogShowId,
+                                       createImportJournal(filesToImport, targetFiles, showName, language, translationMode,
+                                                           useTMDB, customDescription, parseMode));
 }
 
 void Operations_VP_Shows::importTVShow()
@@ -1342,7 +1350,9 @@ void Operations_VP_Shows::importTVShow()
     
     // Start encryption with language and translation info, including custom data if not using TMDB
     m_encryptionDialog->startEncryption(filesToImport, targetFiles, showName, encryptionKey, username, 
-                                       language, translationMode, useTMDB, customPoster, customDescription, parseMode, m_dialogShowId);
+                                       language, translationMode, useTMDB, customPoster, customDescription, parseMode, m_dialogShowId,
+                                       createImportJournal(filesToImport, targetFiles, showName, language, translationMode,
+                                                           useTMDB, customDescription, parseMode));
 }
 
 QStringList Operations_VP_Shows::findVideoFiles(const QString& folderPath, bool recursive)
@@ -2074,6 +2084,114 @@ void Operations_VP_Shows::cleanupEmptyShowFolder(const QString& folderPath)
     }
 }
 
+std::shared_ptr<JobJournal> Operations_VP_Shows::createImportJournal(const QStringList& sourceFiles, const QStringList& targetFiles,
+                                                                     const QString& showName, const QString& language,
+                                                                     const QString& translation, bool useTMDB,
+                                                                     const QString& customDescription, int parseMode)
+{
+    // Everything onEncryptionComplete needs, so a resumed import finishes the same way
+    QVariantMap parameters;
+    parameters["showName"] = showName;
+    parameters["language"] = language;
+    parameters["translation"] = translation;
+    parameters["useTMDB"] = useTMDB;
+    parameters["customDescription"] = customDescription;
+    parameters["parseMode"] = parseMode;
+    parameters["showId"] = m_dialogShowId;
+    parameters["dialogShowName"] = m_dialogShowName;
+    parameters["dialogUseTMDB"] = m_dialogUseTMDB;
+    parameters["outputPath"] = m_currentImportOutputPath;
+    parameters["isUpdatingExistingShow"] = m_isUpdatingExistingShow;
+    parameters["originalEpisodeCount"] = m_originalEpisodeCount;
+    parameters["newEpisodeCount"] = m_newEpisodeCount;
+
+    auto journal = std::make_shared<JobJournal>(m_mainWindow->user_Key, m_mainWindow->user_Username);
+    if (!journal->create(JobJournal::JobType::EncryptShow, sourceFiles, targetFiles, parameters)) {
+        qWarning() << "Operations_VP_Shows: Failed to create job journal, import will not be resumable";
+        return nullptr;
+    }
+    return journal;
+}
+
+void Operations_VP_Shows::resumeInterruptedImports()
+{
+    if (!m_mainWindow || (m_encryptionDialog && m_encryptionDialog->isVisible())) {
+        return;
+    }
+
+    const QStringList journalPaths = JobJournal::findJournals(m_mainWindow->user_Username);
+    for (const QString& journalPath : journalPaths) {
+        auto journal = std::make_shared<JobJournal>(m_mainWindow->user_Key, m_mainWindow->user_Username);
+        if (!journal->load(journalPath) || journal->type() != JobJournal::JobType::EncryptShow) {
+            // Unreadable journals are cleaned up by the Encrypted Data tab
+            continue;
+        }
+
+        QVariantMap parameters = journal->parameters();
+        QString outputPath = parameters.value("outputPath").toString();
+        QString showName = parameters.value("showName").toString();
+
+        // cleanupIncompleteShowFolders() removed the folder if no episode was written yet
+        if (outputPath.isEmpty() || !QDir(outputPath).exists()) {
+            qDebug() << "Operations_VP_Shows: Dropping import journal, show folder no longer exists:" << outputPath;
+            journal->remove();
+            continue;
+        }
+
+        int ret = QMessageBox::question(m_mainWindow, tr("Resume Interrupted Import"),
+                                        tr("The import of \"%1\" was interrupted before it finished (%2 of %3 episodes done).\n\n"
+                                           "Do you want to resume it?")
+                                            .arg(showName)
+                                            .arg(journal->completedCount())
+                                            .arg(journal->entryCount()),
+                                        QMessageBox::Yes | QMessageBox::No, QMessageBox::Yes);
+
+        if (ret != QMessageBox::Yes) {
+            // Partially written episodes are useless without the journal
+            for (int i = 0; i < journal->entryCount(); ++i) {
+                JobJournal::Entry entry = journal->entry(i);
+                if (entry.state == JobJournal::EntryState::InProgress && QFile::exists(entry.targetFile)) {
+                    QFile::remove(entry.targetFile);
+                }
+            }
+            journal->remove();
+            cleanupIncompleteShowFolders();
+            loadTVShowsList();
+            continue;
+        }
+
+        qDebug() << "Operations_VP_Shows: Resuming interrupted import:" << journalPath;
+
+        // Restore the state onEncryptionComplete relies on
+        m_dialogShowName = parameters.value("dialogShowName").toString();
+        m_dialogUseTMDB = parameters.value("dialogUseTMDB").toBool();
+        m_dialogShowId = parameters.value("showId").toInt();
+        m_currentImportOutputPath = outputPath;
+        m_isUpdatingExistingShow = parameters.value("isUpdatingExistingShow").toBool();
+        m_originalEpisodeCount = parameters.value("originalEpisodeCount").toInt();
+        m_newEpisodeCount = parameters.value("newEpisodeCount").toInt();
+
+        if (!m_encryptionDialog) {
+            m_encryptionDialog = new VP_ShowsEncryptionProgressDialog(m_mainWindow);
+            connect(m_encryptionDialog, &VP_ShowsEncryptionProgressDialog::encryptionComplete,
+                    this, &Operations_VP_Shows::onEncryptionComplete);
+        }
+
+        // The custom poster was already saved by the interrupted run, it is not kept in the journal
+        m_encryptionDialog->startEncryption(journal->sourceFiles(), journal->targetFiles(), showName,
+                                           m_mainWindow->user_Key, m_mainWindow->user_Username,
+                                           parameters.value("language").toString(),
+                                           parameters.value("translation").toString(),
+                                           parameters.value("useTMDB").toBool(), QPixmap(),
+                                           parameters.value("customDescription").toString(),
+                                           static_cast<VP_ShowsEncryptionWorker::ParseMode>(parameters.value("parseMode").toInt()),
+                                           m_dialogShowId, journal);
+
+        // One import at a time, any other interrupted import is offered on the next login
+        return;
+    }
+}
+
 void Operations_VP_Shows::cleanupIncompleteShowFolders()
 {
     qDebug() << "Operations_VP_Shows: Starting cleanup of incomplete show folders";
@@ -4940,11 +5058,11 @@ void Operations_VP_Shows::cleanupTempFile()
 
     // Check if file exists
     if (QFile::exists(m_currentTempFile)) {
-        // Delete temp file
-        if (QFile::remove(m_currentTempFile)) {
-            qDebug() << "Operations_VP_Shows: Successfully deleted temp file";
+        // Overwrite + delete runs in the background so closing the player doesn't block
+        if (OperationsFiles::secureDelete(m_currentTempFile)) {
+            qDebug() << "Operations_VP_Shows: Temp file queued for secure deletion";
         } else {
-            qDebug() << "Operations_VP_Shows: Failed to delete temp file";
+            qDebug() << "Operations_VP_Shows: Failed to queue temp file for deletion";
         }
     }
 
@@ -5697,7 +5815,9 @@ void Operations_VP_Shows::addEpisodesToShow()
     // Start encryption with the show name and metadata
     m_encryptionDialog->startEncryption(filesToImport, targetFiles, showName, 
                                        m_mainWindow->user_Key, m_mainWindow->user_Username, 
-                                       newLanguage, newTranslation, useTMDB, customPoster, customDescription, parseMode, m_dialogShowId);
+                                       newLanguage, newTranslation, useTMDB, customPoster, customDescription, parseMode, m_dialogShowId,
+                                       createImportJournal(filesToImport, targetFiles, showName, newLanguage, newTranslation,
+                                                           useTMDB, customDescription, parseMode));
 }
 
 void Operations_VP_Shows::decryptAndExportShow()
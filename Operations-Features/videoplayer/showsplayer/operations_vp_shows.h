@@ -30,6 +30,7 @@ class VP_ShowsWatchHistory;
 class VP_ShowsPlaybackTracker;
 class VP_ShowsFavourites;
 class VP_ShowsEditMultipleMetadataDialog;
+class JobJournal;
 
 class Operations_VP_Shows : public QObject
 {
@@ -348,6 +349,13 @@ public:
     void cleanupEmptyShowFolder(const QString& folderPath);  // Clean up a single empty show folder
     void cleanupIncompleteShowFolders();  // Clean up all incomplete show folders on startup
     
+    // Resumable imports
+    std::shared_ptr<JobJournal> createImportJournal(const QStringList& sourceFiles, const QStringList& targetFiles,
+                                                    const QString& showName, const QString& language,
+                                                    const QString& translation, bool useTMDB,
+                                                    const QString& customDescription, int parseMode);
+    void resumeInterruptedImports();  // Offer to resume imports interrupted by a shutdown
+    
     // New episode detection
     void checkAndDisplayNewEpisodes(const QString& showFolderPath, int tmdbShowId);
     void displayNewEpisodeIndicator(bool hasNewEpisodes, int newEpisodeCount);
@@ -31,6 +31,35 @@ private:
     QFile* m_file;
 };
 
+// Read and decrypt the chunk that starts at chunkOffset in an encrypted video file.
+// Returns the plaintext chunk, or an empty array if the chunk is truncated or fails authentication.
+// chunkEnd receives the offset right after the chunk.
+static QByteArray readVideoChunkAt(QFile& file, qint64 chunkOffset, const QByteArray& encryptionKey, qint64& chunkEnd)
+{
+    chunkEnd = -1;
+    if (chunkOffset <= 0 || !file.seek(chunkOffset)) {
+        return QByteArray();
+    }
+
+    QDataStream stream(&file);
+    qint32 chunkSize = 0;
+    stream >> chunkSize;
+    if (stream.status() != QDataStream::Ok || chunkSize <= 0 || chunkSize > 10 * 1024 * 1024) {
+        return QByteArray();
+    }
+
+    QByteArray encryptedChunk = file.read(chunkSize);
+    if (encryptedChunk.size() != chunkSize) {
+        return QByteArray();
+    }
+
+    QByteArray chunk = CryptoUtils::Encryption_DecryptBArray(encryptionKey, encryptedChunk);
+    if (!chunk.isEmpty()) {
+        chunkEnd = chunkOffset + static_cast<qint64>(sizeof(qint32)) + chunkSize;
+    }
+    return chunk;
+}
+
 //---------------- VP_ShowsEncryptionWorker ----------------//
 
 VP_ShowsEncryptionWorker::VP_ShowsEncryptionWorker(const QStringList& sourceFiles, 
@@ -48,6 +77,7 @@ VP_ShowsEncryptionWorker::VP_ShowsEncryptionWorker(const QStringList& sourceFile
     : m_encryptionKey(encryptionKey)
     , m_username(username)
     , m_cancelled(0)  // 0 = false, 1 = true for atomic
+    , m_suspended(0)
     , m_useTMDB(useTMDB)
     , m_customPoster(customPoster)
     , m_customDescription(customDescription)
@@ -156,6 +186,22 @@ QString VP_ShowsEncryptionWorker::getTranslation() const
     return m_translation;
 }
 
+void VP_ShowsEncryptionWorker::setJournal(std::shared_ptr<JobJournal> journal)
+{
+    m_journal = journal;
+}
+
+void VP_ShowsEncryptionWorker::suspend()
+{
+    if (!m_journal) {
+        cancel();
+        return;
+    }
+    qDebug() << "VP_ShowsEncryptionWorker: Suspend requested, progress will be kept in the job journal";
+    m_suspended.storeRelease(1);
+    m_cancelled.storeRelease(1);
+}
+
 void VP_ShowsEncryptionWorker::cancel()
 {
     qDebug() << "VP_ShowsEncryptionWorker: Cancellation requested from thread" << QThread::currentThreadId();
@@ -230,7 +276,10 @@ void VP_ShowsEncryptionWorker::doEncryption()
         qDebug() << "VP_ShowsEncryptionWorker: Custom poster null:" << m_customPoster.isNull();
         qDebug() << "VP_ShowsEncryptionWorker: Custom description empty:" << m_customDescription.isEmpty();
         
-        if (!targetFolder.isEmpty() && (!m_customPoster.isNull() || !m_customDescription.isEmpty())) {
+        // A resumed import already saved the show data before its first episode
+        bool resumingJob = m_journal && m_journal->entry(0).state != JobJournal::EntryState::Pending;
+        
+        if (!resumingJob && !targetFolder.isEmpty() && (!m_customPoster.isNull() || !m_customDescription.isEmpty())) {
             qDebug() << "VP_ShowsEncryptionWorker: Calling saveCustomShowData...";
             bool saved = saveCustomShowData(targetFolder);
             qDebug() << "VP_ShowsEncryptionWorker: saveCustomShowData returned:" << saved;
@@ -257,6 +306,14 @@ void VP_ShowsEncryptionWorker::doEncryption()
     for (int i = 0; i < localSourceFiles.size(); ++i) {
         // Check for cancellation using atomic operation
         if (m_cancelled.loadAcquire() != 0) {
+            if (m_suspended.loadAcquire() != 0) {
+                qDebug() << "VP_ShowsEncryptionWorker: Encryption suspended";
+                emit encryptionFinished(false, "Operation was suspended", successfulFiles, failedFiles);
+                return;
+            }
+            if (m_journal) {
+                m_journal->remove();
+            }
             qDebug() << "VP_ShowsEncryptionWorker: Encryption cancelled by user";
             emit encryptionFinished(false, "Encryption cancelled by user", 
                                    successfulFiles, failedFiles);
@@ -269,17 +326,36 @@ void VP_ShowsEncryptionWorker::doEncryption()
         QFileInfo fileInfo(sourceFile);
         QString originalFilename = fileInfo.fileName();
         
+        // Already encrypted before the import was interrupted
+        if (m_journal && m_journal->entry(i).state == JobJournal::EntryState::Completed) {
+            successfulFiles.append(sourceFile);
+            totalProcessed += fileInfo.size();
+            continue;
+        }
+        
         // Emit file progress update
         emit fileProgressUpdate(i + 1, localSourceFiles.size(), originalFilename);
         
         // Encrypt the file
-        bool success = encryptSingleFile(sourceFile, targetFile, totalProcessed, totalSize);
+        bool success = encryptSingleFile(sourceFile, targetFile, i, totalProcessed, totalSize);
+        
+        if (!success && m_suspended.loadAcquire() != 0) {
+            // Partial episode stays on disk, the journal already holds its checkpoint
+            emit encryptionFinished(false, "Operation was suspended", successfulFiles, failedFiles);
+            return;
+        }
         
         if (success) {
             successfulFiles.append(sourceFile);
             totalProcessed += fileInfo.size();
+            if (m_journal) {
+                m_journal->markCompleted(i);
+            }
         } else {
             failedFiles.append(sourceFile);
+            if (m_journal) {
+                m_journal->markFailed(i);
+            }
         }
         
         // Update overall progress
@@ -289,6 +365,11 @@ void VP_ShowsEncryptionWorker::doEncryption()
         }
     }
     
+    // Import is done, nothing left to resume
+    if (m_journal) {
+        m_journal->remove();
+    }
+    
     // Determine overall success
     bool overallSuccess = !successfulFiles.isEmpty();
     QString errorMessage;
@@ -309,6 +390,7 @@ void VP_ShowsEncryptionWorker::doEncryption()
 
 bool VP_ShowsEncryptionWorker::encryptSingleFile(const QString& sourceFile, 
                                                  const QString& targetFile,
+                                                 int fileIndex,
                                                  qint64 currentTotalProcessed, 
                                                  qint64 totalSize)
 {
@@ -321,20 +403,32 @@ bool VP_ShowsEncryptionWorker::encryptSingleFile(const QString& sourceFile,
     }
     FileGuard sourceGuard(&source);  // RAII - ensures file closes on any exit path
     
+    // Continue a partially written episode if the journal has a verified checkpoint for it
     QFile target(targetFile);
-    if (!target.open(QIODevice::WriteOnly)) {
+    qint64 fileProcessed = 0;
+    bool resumed = false;
+    if (m_journal) {
+        if (m_journal->entry(fileIndex).state == JobJournal::EntryState::InProgress) {
+            resumed = resumeFromJournal(fileIndex, source, target, fileProcessed);
+        }
+        if (!resumed) {
+            m_journal->markInProgress(fileIndex);
+        }
+    }
+    
+    if (!resumed && !target.open(QIODevice::WriteOnly)) {
         qDebug() << "VP_ShowsEncryptionWorker: Failed to open target file:" << target.errorString();
         return false;
     }
     FileGuard targetGuard(&target);  // RAII - ensures file closes on any exit path
     
-    // Create metadata for this file with TMDB data if available
-    QFileInfo fileInfo(sourceFile);
-    QString folderName = fileInfo.dir().dirName();  // Get immediate parent folder name
-    VP_ShowsMetadata::ShowMetadata metadata = createMetadataWithTMDB(fileInfo.fileName(), folderName);
-    
-    // Write metadata header (fixed size) - check pointer validity
-    {
+    if (!resumed) {
+        // Create metadata for this file with TMDB data if available
+        QFileInfo fileInfo(sourceFile);
+        QString folderName = fileInfo.dir().dirName();  // Get immediate parent folder name
+        VP_ShowsMetadata::ShowMetadata metadata = createMetadataWithTMDB(fileInfo.fileName(), folderName);
+        
+        // Write metadata header (fixed size) - check pointer validity
         QMutexLocker pointerLock(&m_pointerMutex);
         if (!m_metadataManager) {
             qDebug() << "VP_ShowsEncryptionWorker: Metadata manager is null";
@@ -351,12 +445,18 @@ bool VP_ShowsEncryptionWorker::encryptSingleFile(const QString& sourceFile,
     // Encrypt file content in chunks
     const int chunkSize = 1024 * 1024; // 1MB chunks
     QByteArray buffer;
-    qint64 fileProcessed = 0;
     qint64 fileSize = source.size();
+    qint64 lastChunkOffset = resumed ? m_journal->entry(fileIndex).lastChunkOffset : -1;
     
     while (!source.atEnd()) {
         // Check for cancellation using atomic operation
         if (m_cancelled.loadAcquire() != 0) {
+            if (m_suspended.loadAcquire() != 0) {
+                // Record the last complete chunk and keep the partial episode for resuming
+                target.flush();
+                m_journal->checkpoint(fileIndex, source.pos(), target.pos(), lastChunkOffset, true);
+                return false;
+            }
             source.close();
             target.close();
             target.remove();
@@ -380,6 +480,7 @@ bool VP_ShowsEncryptionWorker::encryptSingleFile(const QString& sourceFile,
         }
         
         // Write size of encrypted chunk followed by the chunk
+        const qint64 chunkOffset = target.pos();
         QDataStream stream(&target);
         stream << qint32(encryptedChunk.size());
         qint64 bytesWritten = target.write(encryptedChunk);
@@ -391,6 +492,13 @@ bool VP_ShowsEncryptionWorker::encryptSingleFile(const QString& sourceFile,
             target.remove();
             return false;
         }
+        lastChunkOffset = chunkOffset;
+        
+        // Periodically record the last chunk that reached the disk
+        if (m_journal && m_journal->isCheckpointDue()) {
+            target.flush();
+            m_journal->checkpoint(fileIndex, source.pos(), target.pos(), lastChunkOffset);
+        }
         
         // Update progress
         fileProcessed += buffer.size();
@@ -423,7 +531,36 @@ bool VP_ShowsEncryptionWorker::encryptSingleFile(const QString& sourceFile,
     QFile::setPermissions(targetFile, QFile::ReadOwner | QFile::WriteOwner | QFile::ReadUser | QFile::WriteUser);
 #endif
     
-    qDebug() << "VP_ShowsEncryptionWorker: Successfully encrypted file:" << sourceFile;
+    qDebug() << "VP_ShowsEncryptionWorker: Successfully encrypted file:" << sourceFile << (resumed ? "(resumed)" : "");
+    return true;
+}
+
+bool VP_ShowsEncryptionWorker::resumeFromJournal(int fileIndex, QFile& source, QFile& target, qint64& fileProcessed)
+{
+    const JobJournal::Entry entry = m_journal->entry(fileIndex);
+    if (entry.lastChunkOffset < 0 || !target.exists() || !target.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+    
+    // Verify the tail: the last checkpointed chunk must decrypt, end exactly at the checkpoint,
+    // and match the source bytes it was made from
+    qint64 chunkEnd = -1;
+    QByteArray lastChunk = readVideoChunkAt(target, entry.lastChunkOffset, m_encryptionKey, chunkEnd);
+    bool tailValid = !lastChunk.isEmpty() && chunkEnd == entry.targetOffset &&
+                     entry.sourceOffset <= source.size() && entry.sourceOffset >= lastChunk.size() &&
+                     source.seek(entry.sourceOffset - lastChunk.size()) && source.read(lastChunk.size()) == lastChunk;
+    
+    // Drop anything written after the checkpoint and continue from there
+    if (!tailValid || !target.resize(entry.targetOffset) ||
+        !target.seek(entry.targetOffset) || !source.seek(entry.sourceOffset)) {
+        qWarning() << "VP_ShowsEncryptionWorker: Checkpoint verification failed, restarting file:" << source.fileName();
+        target.close();
+        source.seek(0);
+        return false;
+    }
+    
+    fileProcessed = entry.sourceOffset;
+    qDebug() << "VP_ShowsEncryptionWorker: Resuming" << source.fileName() << "at offset" << entry.sourceOffset;
     return true;
 }
 
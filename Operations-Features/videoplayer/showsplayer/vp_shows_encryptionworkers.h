@@ -15,6 +15,7 @@
 #include <memory>
 #include "vp_shows_metadata.h"
 #include "vp_shows_tmdb.h"
+#include "jobjournal.h"
 
 // Forward declarations
 class VP_ShowsMetadata;
@@ -54,7 +55,12 @@ public:
     QString getLanguage() const;
     QString getTranslation() const;
     
+    // Optional checkpoint journal, set before the thread starts
+    void setJournal(std::shared_ptr<JobJournal> journal);
+    
     void cancel();
+    // Stop like cancel() but keep partial episodes and the journal so the import can resume later
+    void suspend();
 
 public slots:
     void doEncryption();
@@ -85,6 +91,8 @@ private:
     QByteArray m_encryptionKey;
     QString m_username;
     QAtomicInt m_cancelled;  // Using atomic for thread-safe cancellation (0=false, 1=true)
+    QAtomicInt m_suspended;
+    std::shared_ptr<JobJournal> m_journal;
     
     // Custom poster and description
     bool m_useTMDB;
@@ -118,8 +126,10 @@ private:
     
     bool encryptSingleFile(const QString& sourceFile, 
                           const QString& targetFile,
+                          int fileIndex,
                           qint64 currentTotalProcessed, 
                           qint64 totalSize);
+    bool resumeFromJournal(int fileIndex, QFile& source, QFile& target, qint64& fileProcessed);
     
     // New helper methods
     bool fetchTMDBShowData();
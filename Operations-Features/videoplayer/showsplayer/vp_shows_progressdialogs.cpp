@@ -24,6 +24,10 @@ VP_ShowsEncryptionProgressDialog::VP_ShowsEncryptionProgressDialog(QWidget* pare
 VP_ShowsEncryptionProgressDialog::~VP_ShowsEncryptionProgressDialog()
 {
     qDebug() << "VP_ShowsEncryptionProgressDialog: Destructor called";
+    // Closing mid-import keeps progress in the job journal so it can resume next time
+    if (m_worker) {
+        m_worker->suspend();
+    }
     cleanup();
 }
 
@@ -86,7 +90,8 @@ void VP_ShowsEncryptionProgressDialog::startEncryption(const QStringList& source
                                                        const QPixmap& customPoster,
                                                        const QString& customDescription,
                                                        VP_ShowsEncryptionWorker::ParseMode parseMode,
-                                                       int showId)
+                                                       int showId,
+                                                       std::shared_ptr<JobJournal> journal)
 {
     qDebug() << "VP_ShowsEncryptionProgressDialog: Starting encryption for" << sourceFiles.size() << "files";
     qDebug() << "VP_ShowsEncryptionProgressDialog: Using TMDB:" << useTMDB;
@@ -109,6 +114,7 @@ void VP_ShowsEncryptionProgressDialog::startEncryption(const QStringList& source
     m_workerThread = new QThread();
     m_worker = new VP_ShowsEncryptionWorker(sourceFiles, targetFiles, showName, encryptionKey, username, 
                                            language, translation, useTMDB, customPoster, customDescription, parseMode, showId);
+    m_worker->setJournal(journal);
     
     // Move worker to thread
     m_worker->moveToThread(m_workerThread);
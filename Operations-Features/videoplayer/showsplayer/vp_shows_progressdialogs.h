@@ -46,7 +46,8 @@ public:
                          const QPixmap& customPoster = QPixmap(),
                          const QString& customDescription = QString(),
                          VP_ShowsEncryptionWorker::ParseMode parseMode = VP_ShowsEncryptionWorker::ParseFromFile,
-                         int showId = 0);
+                         int showId = 0,
+                         std::shared_ptr<JobJournal> journal = nullptr);
 
 signals:
     void encryptionComplete(bool success, const QString& message,
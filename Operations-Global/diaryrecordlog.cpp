@@ -0,0 +1,288 @@
+#include "diaryrecordlog.h"
+#include "operations_files.h"
+#include "inputvalidation.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QDataStream>
+#include <QMutexLocker>
+#include <QDebug>
+
+const RecordLogFile DiaryRecordLog::s_logFile(QByteArray("MMDRLOG\x01", 8)); // Magic + format version 1
+
+QMutex DiaryRecordLog::s_mutex;
+RecordLogCache<DiaryRecordLog::CachedLog> DiaryRecordLog::s_cache;
+
+// ============================================================================
+// Public interface
+// ============================================================================
+
+bool DiaryRecordLog::readLines(const QString& filePath, const QByteArray& encryptionKey, QStringList& outLines,
+                               bool cacheResult)
+{
+    InputValidation::ValidationResult result =
+        InputValidation::validateInput(filePath, InputValidation::InputType::FilePath);
+    if (!result.isValid) {
+        qWarning() << "DiaryRecordLog: Invalid file path for reading:" << result.errorMessage;
+        return false;
+    }
+
+    {
+        QMutexLocker locker(&s_mutex);
+        const CachedLog* cached = s_cache.find(filePath, encryptionKey);
+        if (cached) {
+            outLines = cached->lines;
+            return true;
+        }
+    }
+
+    // Decrypting doesn't touch the cache, so parallel readers (e.g. the search index rebuild) don't serialize here
+    CachedLog log;
+    if (!loadFromDisk(filePath, encryptionKey, log)) {
+        return false;
+    }
+    outLines = log.lines;
+
+    if (cacheResult) {
+        QMutexLocker locker(&s_mutex);
+        if (RecordLogFile::fileStateMatches(filePath, log)) {
+            s_cache.store(filePath, log);
+        } else {
+            // A writer got in between the stat and the read, the lines may not belong to the
+            // size and time we recorded. Writers hold the lock, so a reload here is consistent.
+            CachedLog current;
+            if (loadFromDisk(filePath, encryptionKey, current)) {
+                outLines = current.lines;
+                s_cache.store(filePath, current);
+            }
+        }
+    }
+    return true;
+}
+
+bool DiaryRecordLog::writeLines(const QString& filePath, const QByteArray& encryptionKey, const QStringList& lines)
+{
+    InputValidation::ValidationResult result =
+        InputValidation::validateInput(filePath, InputValidation::InputType::FilePath);
+    if (!result.isValid) {
+        qWarning() << "DiaryRecordLog: Invalid file path for writing:" << result.errorMessage;
+        return false;
+    }
+
+    QMutexLocker locker(&s_mutex);
+
+    if (!QFileInfo::exists(filePath)) {
+        if (!OperationsFiles::ensureDirectoryExists(QFileInfo(filePath).dir().path())) {
+            qWarning() << "DiaryRecordLog: Failed to create directory for:" << filePath;
+            return false;
+        }
+        return writeSnapshotLocked(filePath, encryptionKey, lines);
+    }
+
+    CachedLog log;
+    const CachedLog* cached = s_cache.find(filePath, encryptionKey);
+    if (cached) {
+        log = *cached;
+    } else if (!loadFromDisk(filePath, encryptionKey, log)) {
+        qWarning() << "DiaryRecordLog: Refusing to write, existing file could not be read:" << filePath;
+        return false;
+    }
+
+    if (log.legacy) {
+        qDebug() << "DiaryRecordLog: Converting legacy diary file to record log:" << filePath;
+        return writeSnapshotLocked(filePath, encryptionKey, lines);
+    }
+    if (log.corrupted) {
+        // What follows the bad record can't be replayed, keep it aside rather than cutting it off
+        if (!s_logFile.preserveCorrupted(filePath)) {
+            qWarning() << "DiaryRecordLog: Refusing to write over corrupted file:" << filePath;
+            return false;
+        }
+        return writeSnapshotLocked(filePath, encryptionKey, lines);
+    }
+
+    // Only the range between the common prefix and the common suffix changed
+    const int oldSize = log.lines.size();
+    const int newSize = lines.size();
+    int prefix = 0;
+    while (prefix < oldSize && prefix < newSize && log.lines[prefix] == lines[prefix]) {
+        ++prefix;
+    }
+    int suffix = 0;
+    while (suffix < oldSize - prefix && suffix < newSize - prefix &&
+           log.lines[oldSize - 1 - suffix] == lines[newSize - 1 - suffix]) {
+        ++suffix;
+    }
+
+    if (prefix == oldSize && prefix == newSize) {
+        return true; // Nothing changed
+    }
+
+    const int removeCount = oldSize - prefix - suffix;
+    const QStringList insertLines = lines.mid(prefix, newSize - prefix - suffix);
+    if (!appendRecordLocked(filePath, encryptionKey, log, prefix, removeCount, insertLines)) {
+        return false;
+    }
+
+    if (s_logFile.needsCompaction(log, COMPACT_RECORD_THRESHOLD)) {
+        qDebug() << "DiaryRecordLog: Compacting" << filePath << "after" << log.recordCount << "records";
+        if (!writeSnapshotLocked(filePath, encryptionKey, log.lines)) {
+            // The appended record is already durable, the log just stays uncompacted for now
+            qWarning() << "DiaryRecordLog: Compaction failed for:" << filePath;
+        }
+    }
+    return true;
+}
+
+bool DiaryRecordLog::compact(const QString& filePath, const QByteArray& encryptionKey)
+{
+    if (!QFileInfo::exists(filePath)) {
+        return false;
+    }
+
+    QMutexLocker locker(&s_mutex);
+
+    CachedLog log;
+    const CachedLog* cached = s_cache.find(filePath, encryptionKey);
+    if (cached) {
+        log = *cached;
+    } else if (!loadFromDisk(filePath, encryptionKey, log)) {
+        qWarning() << "DiaryRecordLog: Cannot compact unreadable file:" << filePath;
+        return false;
+    }
+
+    if (log.corrupted) {
+        // Compaction would drop the records after the bad one, the next write keeps a copy first
+        qWarning() << "DiaryRecordLog: Not compacting file with a corrupted record:" << filePath;
+        return false;
+    }
+    if (!log.legacy && log.recordCount <= 1 && log.validEnd == log.fileSize) {
+        return true; // Already a single snapshot
+    }
+    return writeSnapshotLocked(filePath, encryptionKey, log.lines);
+}
+
+bool DiaryRecordLog::isRecordLog(const QString& filePath)
+{
+    return s_logFile.isRecordLog(filePath);
+}
+
+bool DiaryRecordLog::validateKey(const QString& filePath, const QByteArray& encryptionKey)
+{
+    return s_logFile.validateKey(filePath, encryptionKey);
+}
+
+void DiaryRecordLog::clearCache()
+{
+    QMutexLocker locker(&s_mutex);
+    s_cache.clear();
+}
+
+// ============================================================================
+// Loading and caching
+// ============================================================================
+
+bool DiaryRecordLog::loadFromDisk(const QString& filePath, const QByteArray& encryptionKey, CachedLog& outLog)
+{
+    outLog = CachedLog();
+    QStringList lines;
+    const RecordLogFile::ReadResult result = s_logFile.read(filePath, encryptionKey, outLog,
+        [&lines](const QByteArray& plainRecord) { return applyRecord(plainRecord, lines); });
+
+    if (result == RecordLogFile::ReadResult::Legacy) {
+        if (!OperationsFiles::readEncryptedFileLines(filePath, encryptionKey, lines)) {
+            return false;
+        }
+    } else if (result != RecordLogFile::ReadResult::Ok) {
+        qWarning() << "DiaryRecordLog: Failed to read diary file:" << filePath;
+        return false;
+    }
+    outLog.lines = lines;
+    return true;
+}
+
+// ============================================================================
+// Writing
+// ============================================================================
+
+bool DiaryRecordLog::writeSnapshotLocked(const QString& filePath, const QByteArray& encryptionKey, const QStringList& lines)
+{
+    const QByteArray record = encodeRecord(encryptionKey, RecordType::Snapshot, 0, 0, lines);
+    if (record.isEmpty()) {
+        return false;
+    }
+
+    CachedLog log;
+    if (!s_logFile.writeSnapshot(filePath, encryptionKey, record, log)) {
+        return false;
+    }
+    log.lines = lines;
+    s_cache.store(filePath, log);
+    return true;
+}
+
+bool DiaryRecordLog::appendRecordLocked(const QString& filePath, const QByteArray& encryptionKey, CachedLog& log,
+                                        int position, int removeCount, const QStringList& insertLines)
+{
+    const QByteArray record = encodeRecord(encryptionKey, RecordType::Splice, position, removeCount, insertLines);
+    if (record.isEmpty() || !s_logFile.appendRecord(filePath, record, log)) {
+        return false;
+    }
+
+    QStringList updatedLines = log.lines.mid(0, position);
+    updatedLines.append(insertLines);
+    updatedLines.append(log.lines.mid(position + removeCount));
+    log.lines = updatedLines;
+    s_cache.store(filePath, log);
+    return true;
+}
+
+// ============================================================================
+// Record encoding
+// ============================================================================
+
+QByteArray DiaryRecordLog::encodeRecord(const QByteArray& encryptionKey, RecordType type, int position,
+                                        int removeCount, const QStringList& lines)
+{
+    QByteArray plainRecord;
+    {
+        QDataStream stream(&plainRecord, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_5_15);
+        stream << static_cast<quint8>(type) << static_cast<qint32>(position)
+               << static_cast<qint32>(removeCount) << lines;
+    }
+    return s_logFile.encryptRecord(encryptionKey, plainRecord);
+}
+
+bool DiaryRecordLog::applyRecord(const QByteArray& plainRecord, QStringList& lines)
+{
+    QDataStream stream(plainRecord);
+    stream.setVersion(QDataStream::Qt_5_15);
+
+    quint8 type = 0;
+    qint32 position = 0;
+    qint32 removeCount = 0;
+    QStringList recordLines;
+    stream >> type >> position >> removeCount >> recordLines;
+    if (stream.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    switch (static_cast<RecordType>(type)) {
+    case RecordType::Snapshot:
+        lines = recordLines;
+        return true;
+    case RecordType::Splice:
+        if (position < 0 || position > lines.size() || removeCount < 0 || removeCount > lines.size() - position) {
+            return false;
+        }
+        // A splice without new lines is a tombstone for the removed range
+        for (int i = 0; i < removeCount; ++i) {
+            lines.removeAt(position);
+        }
+        for (int i = 0; i < recordLines.size(); ++i) {
+            lines.insert(position + i, recordLines[i]);
+        }
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,73 @@
+#ifndef DIARYRECORDLOG_H
+#define DIARYRECORDLOG_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QMutex>
+#include "recordlogfile.h"
+
+// Storage format for diary day files.
+// The old format encrypted the whole day as one blob, so every save re-serialized, re-encrypted
+// and rewrote the entire file. A record log starts with a small header and is followed by
+// independently encrypted, length-prefixed records (framed by RecordLogFile):
+//   [8 byte header "MMDRLOG" + version] [quint32 length][encrypted record] [quint32 length][encrypted record] ...
+// The diary has no entry IDs, its content is a list of lines, so a record is either a full
+// snapshot of the lines or a splice (replace removeCount lines at position with the new lines).
+// Adding an entry appends one small splice, edits append a splice of the changed range and
+// deletions append a tombstone (a splice that removes lines and inserts nothing).
+// Compaction folds the log back into a single snapshot record. It runs when a log grows past
+// COMPACT_RECORD_THRESHOLD records, at day rollover and on demand.
+// Legacy single-blob files are still read and are converted on their first write.
+class DiaryRecordLog
+{
+public:
+    // Reads the current lines of a diary file, record log or legacy format.
+    // Bulk readers pass cacheResult = false so they don't evict the days being edited.
+    static bool readLines(const QString& filePath, const QByteArray& encryptionKey, QStringList& outLines,
+                          bool cacheResult = true);
+
+    // Persists the lines, appending only the difference to what is already on disk
+    static bool writeLines(const QString& filePath, const QByteArray& encryptionKey, const QStringList& lines);
+
+    // Rewrites the file as a single snapshot record (also converts legacy files)
+    static bool compact(const QString& filePath, const QByteArray& encryptionKey);
+
+    // Whether the file starts with the record log header
+    static bool isRecordLog(const QString& filePath);
+
+    // Checks the key against the first record without replaying the whole log
+    static bool validateKey(const QString& filePath, const QByteArray& encryptionKey);
+
+    // Drops the cached plaintext of all files (e.g. on logout)
+    static void clearCache();
+
+    static const int COMPACT_RECORD_THRESHOLD = 200;
+
+private:
+    enum class RecordType : quint8 {
+        Snapshot = 0,
+        Splice = 1
+    };
+
+    // The lines as they are on disk, used to compute the next splice without re-reading the file
+    struct CachedLog : RecordLogFile::FileState {
+        QStringList lines;
+    };
+
+    static bool loadFromDisk(const QString& filePath, const QByteArray& encryptionKey, CachedLog& outLog);
+    static bool writeSnapshotLocked(const QString& filePath, const QByteArray& encryptionKey, const QStringList& lines);
+    static bool appendRecordLocked(const QString& filePath, const QByteArray& encryptionKey, CachedLog& log,
+                                   int position, int removeCount, const QStringList& insertLines);
+
+    static QByteArray encodeRecord(const QByteArray& encryptionKey, RecordType type, int position,
+                                   int removeCount, const QStringList& lines);
+    static bool applyRecord(const QByteArray& plainRecord, QStringList& lines);
+
+    static const RecordLogFile s_logFile;
+
+    static QMutex s_mutex;
+    static RecordLogCache<CachedLog> s_cache;
+};
+
+#endif // DIARYRECORDLOG_H
@@ -309,7 +309,9 @@ bool Encryption_EncryptFile(const QByteArray& encryptionKey, const QString& sour
     }
 }
 
-bool Encryption_DecryptFile(const QByteArray& encryptionKey, const QString& sourceFilePath, const QString& destFilePath) {
+bool Encryption_DecryptFileToString(const QByteArray& encryptionKey, const QString& sourceFilePath, QString& outText) {
+    outText.clear();
+
     // Check if key has correct size for AES-256
     if (encryptionKey.size() != 32) {
         qWarning() << "Invalid key size:" << encryptionKey.size() << "bytes (expected 32 bytes)";
@@ -327,7 +329,7 @@ bool Encryption_DecryptFile(const QByteArray& encryptionKey, const QString& sour
         // SECURITY: Check file size before reading into memory
         qint64 fileSize = sourceFile.size();
         if (fileSize < 0 || fileSize > MAX_FILE_SIZE) {
-            qWarning() << "CryptoUtils: File too large for Encryption_DecryptFile:"
+            qWarning() << "CryptoUtils: File too large for Encryption_DecryptFileToString:"
                        << fileSize << "bytes (max:" << MAX_FILE_SIZE << "bytes)";
             qWarning() << "CryptoUtils: Use dedicated encryption worker classes for large files";
             sourceFile.close();
@@ -337,7 +339,7 @@ bool Encryption_DecryptFile(const QByteArray& encryptionKey, const QString& sour
         // Read encrypted content
         QByteArray fileData = sourceFile.readAll();
         sourceFile.close();
-        
+
         // SECURITY: Validate read data size matches file size
         if (fileData.size() != static_cast<int>(fileSize)) {
             qWarning() << "File read size mismatch. Expected:" << fileSize << "Got:" << fileData.size();
@@ -349,25 +351,34 @@ bool Encryption_DecryptFile(const QByteArray& encryptionKey, const QString& sour
         AESGCM256Crypto crypto(key);
 
         // Decrypt the data
-        QString decryptedText = crypto.decrypt(fileData);
-        QByteArray decryptedData = decryptedText.toUtf8();
-
-        // Open destination file
-        QFile destFile(destFilePath);
-        if (!destFile.open(QIODevice::WriteOnly)) {
-            qWarning() << "Could not open destination file for writing:" << destFilePath;
-            return false;
-        }
-
-        // Write decrypted data
-        qint64 bytesWritten = destFile.write(decryptedData);
-        destFile.close();
-
-        return (bytesWritten == decryptedData.size());
+        outText = crypto.decrypt(fileData);
+        return true;
     } catch (const std::exception& e) {
         qCritical() << "Exception during file decryption:" << e.what();
+        outText.clear();
+        return false;
+    }
+}
+
+bool Encryption_DecryptFile(const QByteArray& encryptionKey, const QString& sourceFilePath, const QString& destFilePath) {
+    QString decryptedText;
+    if (!Encryption_DecryptFileToString(encryptionKey, sourceFilePath, decryptedText)) {
+        return false;
+    }
+    QByteArray decryptedData = decryptedText.toUtf8();
+
+    // Open destination file
+    QFile destFile(destFilePath);
+    if (!destFile.open(QIODevice::WriteOnly)) {
+        qWarning() << "Could not open destination file for writing:" << destFilePath;
         return false;
     }
+
+    // Write decrypted data
+    qint64 bytesWritten = destFile.write(decryptedData);
+    destFile.close();
+
+    return (bytesWritten == decryptedData.size());
 }
 
 void DebugKey(const QByteArray& encryptionKey, const QString& label) {
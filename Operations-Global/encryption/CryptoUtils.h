@@ -24,6 +24,8 @@ QString Encryption_Decrypt(const QByteArray& encryptionKey, const QString& textT
 // File encryption/decryption
 bool Encryption_EncryptFile(const QByteArray& encryptionKey, const QString& sourceFilePath, const QString& destFilePath, const QString& username = "");
 bool Encryption_DecryptFile(const QByteArray& encryptionKey, const QString& sourceFilePath, const QString& destFilePath);
+// Decrypts a file written by Encryption_EncryptFile straight into memory, no plaintext touches the disk
+bool Encryption_DecryptFileToString(const QByteArray& encryptionKey, const QString& sourceFilePath, QString& outText);
 // ByteArray encryption/decryption
 QByteArray Encryption_EncryptBArray(const QByteArray& encryptionKey, const QByteArray& byteArrayToEncrypt, const QString& username);
 QByteArray Encryption_DecryptBArray(const QByteArray& encryptionKey, const QByteArray& dataToDecrypt);
@@ -202,6 +202,7 @@ bool NonceCheckWorker::checkSingleFile(const QString& filePath)
                 quint32 chunkSize = 0;
                 qint64 bytesRead = scanFile.read(reinterpret_cast<char*>(&chunkSize), sizeof(chunkSize));
                 if (bytesRead != sizeof(chunkSize)) break;
+                chunkSize &= Constants::CHUNK_HEADER_SIZE_MASK; // Strip compression flag
                 if (chunkSize == 0 || chunkSize > 10 * 1024 * 1024) break; // Invalid chunk
                 
                 scanFile.seek(scanFile.pos() + chunkSize);
@@ -271,6 +272,9 @@ bool NonceCheckWorker::checkSingleFile(const QString& filePath)
         
         processedSize += sizeof(chunkSize);
         
+        // Strip compression flag, only the encrypted size matters for nonce extraction
+        chunkSize &= Constants::CHUNK_HEADER_SIZE_MASK;
+        
         // Validate chunk size
         if (chunkSize == 0 || chunkSize > 10 * 1024 * 1024) { // Max 10MB per chunk
             qWarning() << "NonceCheckWorker: Invalid chunk size" << chunkSize << "in file:" << filePath;
@@ -28,12 +28,15 @@ const int MAX_IMAGE_DIMENSION = 10000; // Max width or height in pixels
 const int MAX_GIF_FILE_SIZE = 50 * 1024 * 1024; // 50MB max for animated images
 const qint64 MAX_PIXEL_COUNT = 100000000; // 100 million pixels max (e.g., 10000x10000)
 const int MAX_GIF_FRAMES = 1000; // Maximum frames in animated images
+const qint64 TILED_RENDER_MIN_PIXELS = 16000000; // Above 16MP, zooming uses the tiled pyramid instead of full rescales
 
 ImageViewer::ImageViewer(QWidget *parent) :
     QDialog(parent),
     ui(new Ui::ImageViewer),
     m_movie(nullptr),
     m_isAnimated(false),
+    m_movieBuffer(nullptr),
+    m_tiledRendering(false),
     m_zoomFactor(1.0),
     m_minZoomFactor(MIN_ZOOM_FACTOR),
     m_maxZoomFactor(MAX_ZOOM_FACTOR),
@@ -41,7 +44,9 @@ ImageViewer::ImageViewer(QWidget *parent) :
     m_firstShow(true),
     m_imageLabel(nullptr),
     m_scrollArea(nullptr),
-    m_dragging(false)
+    m_dragging(false),
+    m_nextImageShortcut(nullptr),
+    m_previousImageShortcut(nullptr)
 {
     ui->setupUi(this);
 
@@ -104,6 +109,14 @@ ImageViewer::ImageViewer(QWidget *parent) :
     connect(actualSizeShortcut, &QShortcut::activated, this, &ImageViewer::actualSize);
     connect(fitToWindowShortcut, &QShortcut::activated, this, &ImageViewer::fitToWindow);
 
+    // Next/previous image navigation, only active when a caller provides an image list
+    m_nextImageShortcut = new QShortcut(QKeySequence(Qt::Key_Right), this);
+    m_previousImageShortcut = new QShortcut(QKeySequence(Qt::Key_Left), this);
+    m_nextImageShortcut->setEnabled(false);
+    m_previousImageShortcut->setEnabled(false);
+    connect(m_nextImageShortcut, &QShortcut::activated, this, &ImageViewer::nextImageRequested);
+    connect(m_previousImageShortcut, &QShortcut::activated, this, &ImageViewer::previousImageRequested);
+
     // Update UI state
     updateZoomInfo();
 }
@@ -149,6 +162,7 @@ bool ImageViewer::loadImage(const QString& imagePath)
 
     // Clean up any existing movie
     cleanupMovie();
+    clearTiledRendering();
 
     // Check if this is an animated image file
     bool isAnimated = isAnimatedImageFile(imagePath);
@@ -167,89 +181,18 @@ bool ImageViewer::loadImage(const QString& imagePath)
 
         // Load as animated image
         setupMovie(imagePath);
-        if (!m_movie || !m_movie->isValid()) {
-            qDebug() << "ImageViewer: Failed to create valid QMovie";
-            QMessageBox::warning(this, "Error", "Could not load animated image: " + imagePath);
+        if (!validateLoadedMovie(imagePath)) {
             return false;
         }
-
-        // Security: Check frame count
-        int frameCount = m_movie->frameCount();
-        if (frameCount > MAX_GIF_FRAMES) {
-            qWarning() << "ImageViewer: Too many frames in animated image:" << frameCount << "(max:" << MAX_GIF_FRAMES << ")";
-            cleanupMovie();
-            QMessageBox::warning(this, "Security Error", 
-                QString("Animated image has too many frames. Maximum is %1").arg(MAX_GIF_FRAMES));
-            return false;
-        }
-
-        qDebug() << "ImageViewer: QMovie created successfully. Frame count:" << frameCount;
-        qDebug() << "ImageViewer: Movie state:" << m_movie->state();
-        qDebug() << "ImageViewer: Original movie size:" << m_originalMovieSize;
-        
-        // Security: Validate movie dimensions
-        if (m_originalMovieSize.width() > MAX_IMAGE_DIMENSION || 
-            m_originalMovieSize.height() > MAX_IMAGE_DIMENSION) {
-            qWarning() << "ImageViewer: Animated image dimensions too large:" << m_originalMovieSize;
-            cleanupMovie();
-            QMessageBox::warning(this, "Security Error", 
-                QString("Image dimensions exceed maximum allowed (%1x%1 pixels)").arg(MAX_IMAGE_DIMENSION));
-            return false;
-        }
-
-        m_isAnimated = true;
-        m_originalPixmap = QPixmap(); // Clear static image
     } else {
         qDebug() << "ImageViewer: Loading as static image";
 
         // Security: Use QImageReader for better control and validation
         QImageReader reader(imagePath);
         
-        // Get image size without loading the full image
-        QSize imageSize = reader.size();
-        qDebug() << "ImageViewer: Image dimensions:" << imageSize;
-        
-        // Security: Validate image dimensions before loading
-        if (!imageSize.isValid()) {
-            qWarning() << "ImageViewer: Invalid image dimensions";
-            QMessageBox::warning(this, "Error", "Invalid image format or corrupted file");
-            return false;
-        }
-        
-        if (imageSize.width() > MAX_IMAGE_DIMENSION || imageSize.height() > MAX_IMAGE_DIMENSION) {
-            qWarning() << "ImageViewer: Image dimensions too large:" << imageSize;
-            QMessageBox::warning(this, "Security Error", 
-                QString("Image dimensions exceed maximum allowed (%1x%1 pixels)").arg(MAX_IMAGE_DIMENSION));
-            return false;
-        }
-        
-        // Security: Check total pixel count to prevent memory exhaustion
-        qint64 pixelCount = static_cast<qint64>(imageSize.width()) * static_cast<qint64>(imageSize.height());
-        if (pixelCount > MAX_PIXEL_COUNT) {
-            qWarning() << "ImageViewer: Total pixel count too large:" << pixelCount;
-            QMessageBox::warning(this, "Security Error", "Image resolution is too high");
-            return false;
-        }
-        
-        // Load the image with size constraints
-        QImage image = reader.read();
-        if (image.isNull()) {
-            qWarning() << "ImageViewer: Failed to load image:" << reader.errorString();
-            QMessageBox::warning(this, "Error", "Could not load image: " + reader.errorString());
-            return false;
-        }
-        
-        // Convert to pixmap
-        QPixmap pixmap = QPixmap::fromImage(image);
-        if (pixmap.isNull()) {
-            qWarning() << "ImageViewer: Failed to convert image to pixmap";
-            QMessageBox::warning(this, "Error", "Could not process image");
+        if (!readStaticImage(reader)) {
             return false;
         }
-        
-        qDebug() << "ImageViewer: Static image loaded successfully. Size:" << pixmap.size();
-        m_originalPixmap = pixmap;
-        m_isAnimated = false;
     }
 
     m_imagePath = imagePath;
@@ -257,15 +200,7 @@ bool ImageViewer::loadImage(const QString& imagePath)
     // Set window title (reuse existing fileInfo variable)
     setWindowTitle(QString("Image Viewer - %1").arg(fileInfo.fileName()));
 
-    // Reset zoom settings
-    m_zoomFactor = 1.0;
-    m_fitToWindowMode = false;
-    m_firstShow = true;
-    m_dragging = false; // Reset drag state
-
-    calculateMinZoomFactor();
-    updateImage();
-    updateZoomInfo();
+    resetViewForNewImage();
 
     qDebug() << "ImageViewer: Load completed. m_isAnimated:" << m_isAnimated;
     return true;
@@ -278,6 +213,7 @@ bool ImageViewer::loadImage(const QPixmap& pixmap, const QString& title)
 
     // Clean up any existing movie
     cleanupMovie();
+    clearTiledRendering();
 
     if (pixmap.isNull()) {
         qWarning() << "ImageViewer: Null pixmap provided";
@@ -315,17 +251,258 @@ bool ImageViewer::loadImage(const QPixmap& pixmap, const QString& title)
         setWindowTitle(QString("Image Viewer - %1").arg(title));
     }
 
+    resetViewForNewImage();
+
+    return true;
+}
+
+bool ImageViewer::loadImageData(const QByteArray& imageData, const QString& title)
+{
+    qDebug() << "ImageViewer: Loading image from memory:" << title << "size:" << imageData.size() << "bytes";
+
+    if (imageData.isEmpty()) {
+        qWarning() << "ImageViewer: Empty image data provided";
+        QMessageBox::warning(this, "Error", "Invalid image data");
+        return false;
+    }
+
+    // Security: Enforce the same size limits as file loading
+    if (imageData.size() > MAX_IMAGE_FILE_SIZE) {
+        qWarning() << "ImageViewer: Image data too large:" << imageData.size() << "bytes (max:" << MAX_IMAGE_FILE_SIZE << ")";
+        QMessageBox::warning(this, "Security Error",
+            QString("Image file is too large. Maximum size is %1 MB").arg(MAX_IMAGE_FILE_SIZE / (1024*1024)));
+        return false;
+    }
+
+    // Clean up any existing movie
+    cleanupMovie();
+    clearTiledRendering();
+
+    if (isAnimatedImageFile(title)) {
+        qDebug() << "ImageViewer: Detected as animated image (GIF)";
+
+        // Security: Additional size check for animated images
+        if (imageData.size() > MAX_GIF_FILE_SIZE) {
+            qWarning() << "ImageViewer: Animated image data too large:" << imageData.size() << "bytes (max:" << MAX_GIF_FILE_SIZE << ")";
+            QMessageBox::warning(this, "Security Error",
+                QString("Animated image file is too large. Maximum size is %1 MB").arg(MAX_GIF_FILE_SIZE / (1024*1024)));
+            return false;
+        }
+
+        setupMovieFromData(imageData);
+        if (!validateLoadedMovie(title)) {
+            return false;
+        }
+    } else {
+        qDebug() << "ImageViewer: Loading as static image from memory";
+
+        QBuffer buffer;
+        buffer.setData(imageData);
+        buffer.open(QIODevice::ReadOnly);
+        QImageReader reader(&buffer);
+        if (!readStaticImage(reader)) {
+            return false;
+        }
+    }
+
+    m_imagePath.clear();
+    setWindowTitle(QString("Image Viewer - %1").arg(title));
+
+    resetViewForNewImage();
+
+    qDebug() << "ImageViewer: Load from memory completed. m_isAnimated:" << m_isAnimated;
+    return true;
+}
+
+bool ImageViewer::loadDecodedImage(const QImage& image, const QString& title)
+{
+    qDebug() << "ImageViewer: Loading decoded image:" << title << "size:" << image.size();
+
+    cleanupMovie();
+    clearTiledRendering();
+
+    if (image.isNull()) {
+        qWarning() << "ImageViewer: Null image provided";
+        QMessageBox::warning(this, "Error", "Invalid image data");
+        return false;
+    }
+
+    // Security: Validate image dimensions
+    QSize imageSize = image.size();
+    if (imageSize.width() > MAX_IMAGE_DIMENSION || imageSize.height() > MAX_IMAGE_DIMENSION) {
+        qWarning() << "ImageViewer: Image dimensions too large:" << imageSize;
+        QMessageBox::warning(this, "Security Error",
+            QString("Image dimensions exceed maximum allowed (%1x%1 pixels)").arg(MAX_IMAGE_DIMENSION));
+        return false;
+    }
+
+    qint64 pixelCount = static_cast<qint64>(imageSize.width()) * static_cast<qint64>(imageSize.height());
+    if (pixelCount > MAX_PIXEL_COUNT) {
+        qWarning() << "ImageViewer: Image pixel count too large:" << pixelCount;
+        QMessageBox::warning(this, "Security Error", "Image resolution is too high");
+        return false;
+    }
+
+    if (!applyStaticImage(image)) {
+        return false;
+    }
+
+    m_imagePath.clear();
+    setWindowTitle(QString("Image Viewer - %1").arg(title));
+
+    resetViewForNewImage();
+    return true;
+}
+
+bool ImageViewer::readStaticImage(QImageReader& reader)
+{
+    // Get image size without loading the full image
+    QSize imageSize = reader.size();
+    qDebug() << "ImageViewer: Image dimensions:" << imageSize;
+    
+    // Security: Validate image dimensions before loading
+    if (!imageSize.isValid()) {
+        qWarning() << "ImageViewer: Invalid image dimensions";
+        QMessageBox::warning(this, "Error", "Invalid image format or corrupted file");
+        return false;
+    }
+    
+    if (imageSize.width() > MAX_IMAGE_DIMENSION || imageSize.height() > MAX_IMAGE_DIMENSION) {
+        qWarning() << "ImageViewer: Image dimensions too large:" << imageSize;
+        QMessageBox::warning(this, "Security Error", 
+            QString("Image dimensions exceed maximum allowed (%1x%1 pixels)").arg(MAX_IMAGE_DIMENSION));
+        return false;
+    }
+    
+    // Security: Check total pixel count to prevent memory exhaustion
+    qint64 pixelCount = static_cast<qint64>(imageSize.width()) * static_cast<qint64>(imageSize.height());
+    if (pixelCount > MAX_PIXEL_COUNT) {
+        qWarning() << "ImageViewer: Total pixel count too large:" << pixelCount;
+        QMessageBox::warning(this, "Security Error", "Image resolution is too high");
+        return false;
+    }
+    
+    // Load the image with size constraints
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "ImageViewer: Failed to load image:" << reader.errorString();
+        QMessageBox::warning(this, "Error", "Could not load image: " + reader.errorString());
+        return false;
+    }
+    
+    return applyStaticImage(image);
+}
+
+bool ImageViewer::applyStaticImage(const QImage& image)
+{
+    // Very large images skip the full-size pixmap, the label renders visible tiles from a pyramid instead
+    qint64 pixelCount = static_cast<qint64>(image.width()) * static_cast<qint64>(image.height());
+    if (pixelCount >= TILED_RENDER_MIN_PIXELS && m_imageLabel) {
+        qDebug() << "ImageViewer: Using tiled rendering for large image:" << image.size();
+        m_imageLabel->setTiledImage(image);
+        m_originalPixmap = QPixmap();
+        m_tiledRendering = true;
+        m_isAnimated = false;
+        return true;
+    }
+
+    // Convert to pixmap
+    QPixmap pixmap = QPixmap::fromImage(image);
+    if (pixmap.isNull()) {
+        qWarning() << "ImageViewer: Failed to convert image to pixmap";
+        QMessageBox::warning(this, "Error", "Could not process image");
+        return false;
+    }
+    
+    qDebug() << "ImageViewer: Static image loaded successfully. Size:" << pixmap.size();
+    m_originalPixmap = pixmap;
+    m_isAnimated = false;
+    return true;
+}
+
+bool ImageViewer::validateLoadedMovie(const QString& sourceName)
+{
+    if (!m_movie || !m_movie->isValid()) {
+        qDebug() << "ImageViewer: Failed to create valid QMovie";
+        QMessageBox::warning(this, "Error", "Could not load animated image: " + sourceName);
+        return false;
+    }
+
+    // Security: Check frame count
+    int frameCount = m_movie->frameCount();
+    if (frameCount > MAX_GIF_FRAMES) {
+        qWarning() << "ImageViewer: Too many frames in animated image:" << frameCount << "(max:" << MAX_GIF_FRAMES << ")";
+        cleanupMovie();
+        QMessageBox::warning(this, "Security Error", 
+            QString("Animated image has too many frames. Maximum is %1").arg(MAX_GIF_FRAMES));
+        return false;
+    }
+
+    qDebug() << "ImageViewer: QMovie created successfully. Frame count:" << frameCount;
+    qDebug() << "ImageViewer: Movie state:" << m_movie->state();
+    qDebug() << "ImageViewer: Original movie size:" << m_originalMovieSize;
+    
+    // Security: Validate movie dimensions
+    if (m_originalMovieSize.width() > MAX_IMAGE_DIMENSION || 
+        m_originalMovieSize.height() > MAX_IMAGE_DIMENSION) {
+        qWarning() << "ImageViewer: Animated image dimensions too large:" << m_originalMovieSize;
+        cleanupMovie();
+        QMessageBox::warning(this, "Security Error", 
+            QString("Image dimensions exceed maximum allowed (%1x%1 pixels)").arg(MAX_IMAGE_DIMENSION));
+        return false;
+    }
+
+    m_isAnimated = true;
+    m_originalPixmap = QPixmap(); // Clear static image
+    return true;
+}
+
+void ImageViewer::resetViewForNewImage()
+{
     // Reset zoom settings
     m_zoomFactor = 1.0;
     m_fitToWindowMode = false;
-    m_firstShow = true;
     m_dragging = false; // Reset drag state
 
     calculateMinZoomFactor();
     updateImage();
     updateZoomInfo();
 
-    return true;
+    // showEvent() only fits the first image, next/previous in an open viewer fit here
+    if (isVisible() && hasImage()) {
+        m_firstShow = false;
+        applyInitialZoom();
+    } else {
+        m_firstShow = true;
+    }
+}
+
+void ImageViewer::applyInitialZoom()
+{
+    QSize imageSize = getOriginalImageSize();
+    QSize availableSize = m_scrollArea->viewport()->size();
+
+    // Check if image is larger than the available space
+    if (imageSize.width() > availableSize.width() ||
+        imageSize.height() > availableSize.height()) {
+        fitToWindow(); // This will start the timer
+    } else {
+        actualSize();
+    }
+}
+
+void ImageViewer::setNavigationEnabled(bool enabled)
+{
+    m_nextImageShortcut->setEnabled(enabled);
+    m_previousImageShortcut->setEnabled(enabled);
+}
+
+void ImageViewer::clearTiledRendering()
+{
+    if (m_imageLabel) {
+        m_imageLabel->clearTiledImage();
+    }
+    m_tiledRendering = false;
 }
 
 void ImageViewer::zoomIn()
@@ -386,6 +563,8 @@ QSize ImageViewer::getOriginalImageSize() const
 {
     if (m_isAnimated && m_movie) {
         return m_originalMovieSize;
+    } else if (m_tiledRendering) {
+        return m_imageLabel->tiledImageSize();
     } else {
         return m_originalPixmap.size();
     }
@@ -393,7 +572,7 @@ QSize ImageViewer::getOriginalImageSize() const
 
 bool ImageViewer::hasImage() const
 {
-    bool hasStatic = !m_originalPixmap.isNull();
+    bool hasStatic = !m_originalPixmap.isNull() || m_tiledRendering;
     bool hasAnimated = (m_isAnimated && m_movie && m_movie->isValid());
 
     qDebug() << "hasImage: hasStatic=" << hasStatic << ", hasAnimated=" << hasAnimated;
@@ -461,17 +640,7 @@ void ImageViewer::showEvent(QShowEvent *event)
     // Auto-fit to window on first show if image is larger than dialog
     if (m_firstShow && hasImage()) {
         m_firstShow = false;
-
-        QSize imageSize = getOriginalImageSize();
-        QSize availableSize = m_scrollArea->viewport()->size();
-
-        // Check if image is larger than the available space
-        if (imageSize.width() > availableSize.width() ||
-            imageSize.height() > availableSize.height()) {
-            fitToWindow(); // This will start the timer
-        } else {
-            actualSize();
-        }
+        applyInitialZoom();
     }
 }
 
@@ -525,6 +694,9 @@ void ImageViewer::updateImage()
             qDebug() << "ImageViewer: Movie not running, starting it. Current state:" << m_movie->state();
             m_movie->start();
         }
+    } else if (m_tiledRendering) {
+        // Only the visible tiles get rendered, no full-size rescale needed
+        m_imageLabel->setZoomFactor(m_zoomFactor);
     } else {
         qDebug() << "ImageViewer: Updating static image";
 
@@ -807,6 +979,18 @@ void ImageViewer::cleanupMovie()
         m_movie = nullptr;
         qDebug() << "ImageViewer: Movie cleaned up";
     }
+
+    // The buffer must outlive the movie reading from it
+    if (m_movieBuffer) {
+        delete m_movieBuffer;
+        m_movieBuffer = nullptr;
+    }
+    if (!m_movieData.isEmpty()) {
+        // SECURITY: Clear decrypted image bytes
+        m_movieData.fill('\0');
+        m_movieData.clear();
+    }
+
     m_isAnimated = false;
     m_originalMovieSize = QSize();
 }
@@ -835,6 +1019,37 @@ void ImageViewer::setupMovie(const QString& filePath)
         return;
     }
 
+    initializeMovie();
+}
+
+void ImageViewer::setupMovieFromData(const QByteArray& imageData)
+{
+    qDebug() << "ImageViewer: Setting up QMovie from memory, size:" << imageData.size();
+
+    cleanupMovie();
+
+    // QMovie reads frames lazily, so keep our own copy of the data alive for the buffer
+    m_movieData = imageData;
+    m_movieBuffer = new QBuffer(&m_movieData, this);
+    if (!m_movieBuffer->open(QIODevice::ReadOnly)) {
+        qWarning() << "ImageViewer: Failed to open movie buffer";
+        cleanupMovie();
+        return;
+    }
+
+    m_movie = new QMovie(m_movieBuffer, QByteArray(), this);
+
+    if (!m_movie->isValid()) {
+        qDebug() << "ImageViewer: QMovie is not valid for in-memory data";
+        cleanupMovie();
+        return;
+    }
+
+    initializeMovie();
+}
+
+void ImageViewer::initializeMovie()
+{
     qDebug() << "ImageViewer: QMovie is valid. Frame count:" << m_movie->frameCount();
     qDebug() << "ImageViewer: Movie format:" << m_movie->format();
 
@@ -851,8 +1066,7 @@ void ImageViewer::setupMovie(const QString& filePath)
             QSize frameSize = firstFrame.size();
             if (frameSize.width() > MAX_IMAGE_DIMENSION || frameSize.height() > MAX_IMAGE_DIMENSION) {
                 qWarning() << "ImageViewer: First frame dimensions too large:" << frameSize;
-                delete m_movie;
-                m_movie = nullptr;
+                cleanupMovie();
                 return;
             }
             m_originalMovieSize = frameSize;
@@ -882,6 +1096,8 @@ QSize ImageViewer::getCurrentImageSize() const
 {
     if (m_isAnimated && m_movie) {
         return m_movie->scaledSize().isEmpty() ? m_originalMovieSize : m_movie->scaledSize();
+    } else if (m_tiledRendering) {
+        return m_imageLabel->size();
     } else {
         return m_scaledPixmap.isNull() ? m_originalPixmap.size() : m_scaledPixmap.size();
     }
@@ -11,6 +11,10 @@
 #include <QMouseEvent>
 #include <QTimer>
 #include <QMovie>
+#include <QBuffer>
+#include <QImageReader>
+#include <QShortcut>
+#include "qlabel_TiledImage.h"
 
 namespace Ui {
 class ImageViewer;
@@ -27,6 +31,14 @@ public:
     // Main functionality
     bool loadImage(const QString& imagePath);
     bool loadImage(const QPixmap& pixmap, const QString& title = "");
+    // Decode an image held in memory (e.g. decrypted without a temp file).
+    // The title's extension decides whether it is treated as an animated image.
+    bool loadImageData(const QByteArray& imageData, const QString& title);
+    // Show an image that was already decoded off the GUI thread (e.g. prefetched)
+    bool loadDecodedImage(const QImage& image, const QString& title);
+
+    // Left/Right arrow keys emit next/previousImageRequested while enabled
+    void setNavigationEnabled(bool enabled);
 
     // Zoom controls
     void zoomIn();
@@ -42,6 +54,10 @@ public:
     QSize getOriginalImageSize() const;
     bool hasImage() const;
 
+signals:
+    void nextImageRequested();
+    void previousImageRequested();
+
 protected:
     void wheelEvent(QWheelEvent *event) override;
     void keyPressEvent(QKeyEvent *event) override;
@@ -67,6 +83,11 @@ private:
     QMovie* m_movie;
     QSize m_originalMovieSize;
     bool m_isAnimated;
+    QByteArray m_movieData;   // Backing data for animated images loaded from memory
+    QBuffer* m_movieBuffer;
+
+    // Very large static images are drawn by the label from a tiled pyramid instead of m_originalPixmap
+    bool m_tiledRendering;
 
     // Zoom functionality
     double m_zoomFactor;
@@ -77,7 +98,7 @@ private:
     QTimer* m_fitToWindowTimer;
 
     // UI components (will be set up via .ui file)
-    QLabel* m_imageLabel;
+    qlabel_TiledImage* m_imageLabel;
     QScrollArea* m_scrollArea;
 
     // Drag scrolling functionality
@@ -85,6 +106,10 @@ private:
     QPoint m_lastDragPos;
     QCursor m_originalCursor;
 
+    // Image navigation
+    QShortcut* m_nextImageShortcut;
+    QShortcut* m_previousImageShortcut;
+
     // Helper methods
     void updateImage();
     void updateZoomInfo();
@@ -98,6 +123,14 @@ private:
     bool isAnimatedImageFile(const QString& filePath) const;
     void cleanupMovie();
     void setupMovie(const QString& filePath);
+    void setupMovieFromData(const QByteArray& imageData);
+    void initializeMovie();
+    bool validateLoadedMovie(const QString& sourceName);
+    bool readStaticImage(QImageReader& reader);
+    bool applyStaticImage(const QImage& image);
+    void resetViewForNewImage();
+    void applyInitialZoom();
+    void clearTiledRendering();
     QSize getCurrentImageSize() const;
 
     // Constants
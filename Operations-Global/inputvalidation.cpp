@@ -1,5 +1,7 @@
 #include "inputvalidation.h"
 #include "encryption/CryptoUtils.h"
+#include "diaryrecordlog.h"
+#include "tasklistrecordlog.h"
 #include "../constants.h"
 #include <QRegularExpression>
 #include <QString>
@@ -777,6 +779,11 @@ bool validateTasklistFile(const QString& filePath, const QByteArray& expectedEnc
         return false;
     }
 
+    // Record log tasklists are validated against their first record, legacy ones as a single blob
+    if (TasklistRecordLog::isRecordLog(filePath)) {
+        return TasklistRecordLog::validateKey(filePath, expectedEncryptionKey);
+    }
+
     // Validate encryption key
     return validateEncryptionKey(filePath, expectedEncryptionKey);
 }
@@ -881,6 +888,11 @@ bool validateDiaryFile(const QString& filePath, const QByteArray& expectedEncryp
         return false;
     }
 
+    // Record log diaries are validated against their first record, legacy ones as a single blob
+    if (DiaryRecordLog::isRecordLog(filePath)) {
+        return DiaryRecordLog::validateKey(filePath, expectedEncryptionKey);
+    }
+
     // Validate encryption key
     return validateEncryptionKey(filePath, expectedEncryptionKey);
 }
@@ -0,0 +1,331 @@
+#include "jobjournal.h"
+#include "operations_files.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDataStream>
+#include <QUuid>
+#include <QDebug>
+#include <QMutexLocker>
+#include <cstring>  // For std::memset
+
+const quint32 JobJournal::JOURNAL_MAGIC = 0x4D4D4A4A; // "MMJJ"
+const quint32 JobJournal::JOURNAL_VERSION = 1;
+const int JobJournal::CHECKPOINT_INTERVAL_MS = 2000; // At most one chunk checkpoint write every 2 seconds
+
+JobJournal::JobJournal(const QByteArray& encryptionKey, const QString& username)
+    : m_encryptionKey(encryptionKey)
+    , m_username(username)
+    , m_type(JobType::EncryptData)
+{
+}
+
+JobJournal::~JobJournal()
+{
+    // SECURITY: Clear sensitive data
+    if (!m_encryptionKey.isEmpty()) {
+        volatile char* keyData = const_cast<volatile char*>(m_encryptionKey.data());
+        std::memset(const_cast<char*>(keyData), 0, m_encryptionKey.size());
+        m_encryptionKey.clear();
+    }
+}
+
+// ============================================================================
+// Journal discovery
+// ============================================================================
+
+QString JobJournal::journalDirectory(const QString& username)
+{
+    QString basePath = QDir::current().absoluteFilePath("Data");
+    QString userPath = QDir(basePath).absoluteFilePath(username);
+    return QDir(userPath).absoluteFilePath("Jobs");
+}
+
+QStringList JobJournal::findJournals(const QString& username)
+{
+    QStringList journals;
+    QDir jobsDir(journalDirectory(username));
+    if (!jobsDir.exists()) {
+        return journals;
+    }
+
+    const QStringList entries = jobsDir.entryList(QStringList() << "job_*.mmjob", QDir::Files, QDir::Time | QDir::Reversed);
+    for (const QString& entry : entries) {
+        journals.append(jobsDir.absoluteFilePath(entry));
+    }
+    return journals;
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+bool JobJournal::create(JobType type, const QStringList& sourceFiles, const QStringList& targetFiles,
+                        const QVariantMap& parameters)
+{
+    if (sourceFiles.size() != targetFiles.size() || sourceFiles.isEmpty()) {
+        qWarning() << "JobJournal: Invalid file lists for new journal";
+        return false;
+    }
+
+    QString jobsPath = journalDirectory(m_username);
+    if (!OperationsFiles::ensureDirectoryExists(jobsPath)) {
+        qWarning() << "JobJournal: Failed to create jobs directory:" << jobsPath;
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_type = type;
+    m_parameters = parameters;
+    m_entries.clear();
+    for (int i = 0; i < sourceFiles.size(); ++i) {
+        Entry entry;
+        entry.sourceFile = sourceFiles[i];
+        entry.targetFile = targetFiles[i];
+        m_entries.append(entry);
+    }
+
+    QString jobId = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    m_journalPath = QDir(jobsPath).absoluteFilePath(QString("job_%1.mmjob").arg(jobId));
+    m_lastCheckpoint.start();
+
+    qDebug() << "JobJournal: Created journal for" << m_entries.size() << "files:" << m_journalPath;
+    return saveLocked();
+}
+
+bool JobJournal::load(const QString& journalPath)
+{
+    QByteArray data;
+    if (!OperationsFiles::readEncryptedBlob(journalPath, m_encryptionKey, data)) {
+        qWarning() << "JobJournal: Failed to read journal:" << journalPath;
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    if (!deserialize(data)) {
+        qWarning() << "JobJournal: Corrupted journal:" << journalPath;
+        return false;
+    }
+    m_journalPath = journalPath;
+    m_lastCheckpoint.start();
+    return true;
+}
+
+bool JobJournal::save()
+{
+    QMutexLocker locker(&m_mutex);
+    return saveLocked();
+}
+
+bool JobJournal::saveLocked()
+{
+    if (m_journalPath.isEmpty()) {
+        return false;
+    }
+
+    if (!OperationsFiles::writeEncryptedBlob(m_journalPath, m_encryptionKey, serialize(), m_username)) {
+        qWarning() << "JobJournal: Failed to write journal:" << m_journalPath;
+        return false;
+    }
+
+    m_lastCheckpoint.restart();
+    return true;
+}
+
+void JobJournal::remove()
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_journalPath.isEmpty() && QFile::exists(m_journalPath)) {
+        if (!QFile::remove(m_journalPath)) {
+            qWarning() << "JobJournal: Failed to remove journal:" << m_journalPath;
+        } else {
+            qDebug() << "JobJournal: Removed journal:" << m_journalPath;
+        }
+    }
+    m_journalPath.clear();
+}
+
+// ============================================================================
+// Serialization
+// ============================================================================
+
+QByteArray JobJournal::serialize() const
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_15);
+
+    stream << JOURNAL_MAGIC << JOURNAL_VERSION << static_cast<qint32>(m_type) << m_parameters;
+    stream << static_cast<qint32>(m_entries.size());
+    for (const Entry& entry : m_entries) {
+        stream << entry.sourceFile << entry.targetFile << static_cast<qint32>(entry.state)
+               << entry.sourceOffset << entry.targetOffset << entry.lastChunkOffset;
+    }
+    return data;
+}
+
+bool JobJournal::deserialize(const QByteArray& data)
+{
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_15);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 type = 0;
+    QVariantMap parameters;
+    qint32 entryCount = 0;
+    stream >> magic >> version >> type >> parameters >> entryCount;
+
+    if (stream.status() != QDataStream::Ok || magic != JOURNAL_MAGIC || version != JOURNAL_VERSION) {
+        return false;
+    }
+    if (type < static_cast<qint32>(JobType::EncryptData) || type > static_cast<qint32>(JobType::ExportData)) {
+        return false;
+    }
+    if (entryCount <= 0 || entryCount > 100000) {
+        return false;
+    }
+
+    QList<Entry> entries;
+    for (int i = 0; i < entryCount; ++i) {
+        Entry entry;
+        qint32 state = 0;
+        stream >> entry.sourceFile >> entry.targetFile >> state
+               >> entry.sourceOffset >> entry.targetOffset >> entry.lastChunkOffset;
+        if (stream.status() != QDataStream::Ok ||
+            state < static_cast<qint32>(EntryState::Pending) || state > static_cast<qint32>(EntryState::Failed)) {
+            return false;
+        }
+        entry.state = static_cast<EntryState>(state);
+        entries.append(entry);
+    }
+
+    m_type = static_cast<JobType>(type);
+    m_parameters = parameters;
+    m_entries = entries;
+    return true;
+}
+
+// ============================================================================
+// Accessors
+// ============================================================================
+
+JobJournal::JobType JobJournal::type() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_type;
+}
+
+QVariantMap JobJournal::parameters() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_parameters;
+}
+
+QString JobJournal::journalPath() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_journalPath;
+}
+
+int JobJournal::entryCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_entries.size();
+}
+
+JobJournal::Entry JobJournal::entry(int index) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (index < 0 || index >= m_entries.size()) {
+        return Entry();
+    }
+    return m_entries[index];
+}
+
+QStringList JobJournal::sourceFiles() const
+{
+    QMutexLocker locker(&m_mutex);
+    QStringList files;
+    for (const Entry& entry : m_entries) {
+        files.append(entry.sourceFile);
+    }
+    return files;
+}
+
+QStringList JobJournal::targetFiles() const
+{
+    QMutexLocker locker(&m_mutex);
+    QStringList files;
+    for (const Entry& entry : m_entries) {
+        files.append(entry.targetFile);
+    }
+    return files;
+}
+
+int JobJournal::completedCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    int count = 0;
+    for (const Entry& entry : m_entries) {
+        if (entry.state == EntryState::Completed) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// ============================================================================
+// Progress tracking
+// ============================================================================
+
+void JobJournal::setStateLocked(int index, EntryState state)
+{
+    if (index < 0 || index >= m_entries.size()) {
+        return;
+    }
+    m_entries[index].state = state;
+    saveLocked();
+}
+
+void JobJournal::markInProgress(int index)
+{
+    QMutexLocker locker(&m_mutex);
+    setStateLocked(index, EntryState::InProgress);
+}
+
+void JobJournal::markCompleted(int index)
+{
+    QMutexLocker locker(&m_mutex);
+    setStateLocked(index, EntryState::Completed);
+}
+
+void JobJournal::markFailed(int index)
+{
+    QMutexLocker locker(&m_mutex);
+    setStateLocked(index, EntryState::Failed);
+}
+
+bool JobJournal::isCheckpointDue() const
+{
+    QMutexLocker locker(&m_mutex);
+    return !m_lastCheckpoint.isValid() || m_lastCheckpoint.elapsed() >= CHECKPOINT_INTERVAL_MS;
+}
+
+void JobJournal::checkpoint(int index, qint64 sourceOffset, qint64 targetOffset, qint64 lastChunkOffset, bool force)
+{
+    QMutexLocker locker(&m_mutex);
+    if (index < 0 || index >= m_entries.size()) {
+        return;
+    }
+
+    Entry& entry = m_entries[index];
+    entry.state = EntryState::InProgress;
+    entry.sourceOffset = sourceOffset;
+    entry.targetOffset = targetOffset;
+    entry.lastChunkOffset = lastChunkOffset;
+
+    if (force || !m_lastCheckpoint.isValid() || m_lastCheckpoint.elapsed() >= CHECKPOINT_INTERVAL_MS) {
+        saveLocked();
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef JOBJOURNAL_H
+#define JOBJOURNAL_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QVariantMap>
+#include <QList>
+#include <QMutex>
+#include <QElapsedTimer>
+
+// Encrypted checkpoint journal for long running encryption/export jobs.
+// Workers record which files are done and, for the file in progress, the source/target
+// offsets of the last chunk that was fully written and flushed. If the app is closed or
+// killed mid-job, the journal survives in Data/<username>/Jobs/ and the job can be resumed
+// from that chunk on the next login instead of starting over.
+class JobJournal
+{
+public:
+    enum class JobType {
+        EncryptData = 0,    // EncryptionWorker - Encrypted Data tab import
+        EncryptShow = 1,    // VP_ShowsEncryptionWorker - TV show import
+        ExportData = 2      // BatchDecryptionWorker - Encrypted Data tab export
+    };
+
+    enum class EntryState {
+        Pending = 0,
+        InProgress = 1,
+        Completed = 2,
+        Failed = 3
+    };
+
+    struct Entry {
+        QString sourceFile;
+        QString targetFile;
+        EntryState state = EntryState::Pending;
+        qint64 sourceOffset = 0;       // Source bytes consumed up to the last durable chunk
+        qint64 targetOffset = 0;       // Target bytes written up to the last durable chunk
+        qint64 lastChunkOffset = -1;   // Where the last durable chunk starts in the encrypted file (-1 = none yet)
+    };
+
+    JobJournal(const QByteArray& encryptionKey, const QString& username);
+    ~JobJournal();
+
+    // Journal discovery
+    static QString journalDirectory(const QString& username);
+    static QStringList findJournals(const QString& username);
+
+    // Lifecycle
+    bool create(JobType type, const QStringList& sourceFiles, const QStringList& targetFiles,
+                const QVariantMap& parameters = QVariantMap());
+    bool load(const QString& journalPath);
+    bool save();
+    void remove();
+
+    // Accessors
+    JobType type() const;
+    QVariantMap parameters() const;
+    QString journalPath() const;
+    int entryCount() const;
+    Entry entry(int index) const;
+    QStringList sourceFiles() const;
+    QStringList targetFiles() const;
+    int completedCount() const;
+
+    // Progress tracking (state changes are saved immediately)
+    void markInProgress(int index);
+    void markCompleted(int index);
+    void markFailed(int index);
+
+    // Chunk checkpoints are throttled, callers must flush the target before checkpointing
+    bool isCheckpointDue() const;
+    void checkpoint(int index, qint64 sourceOffset, qint64 targetOffset, qint64 lastChunkOffset, bool force = false);
+
+private:
+    QByteArray serialize() const;
+    bool deserialize(const QByteArray& data);
+    bool saveLocked();
+    void setStateLocked(int index, EntryState state);
+
+    static const quint32 JOURNAL_MAGIC;
+    static const quint32 JOURNAL_VERSION;
+    static const int CHECKPOINT_INTERVAL_MS;
+
+    mutable QMutex m_mutex;
+    QByteArray m_encryptionKey;
+    QString m_username;
+    QString m_journalPath;
+    JobType m_type;
+    QVariantMap m_parameters;
+    QList<Entry> m_entries;
+    QElapsedTimer m_lastCheckpoint;
+};
+
+#endif // JOBJOURNAL_H
@@ -15,6 +15,7 @@
 #include "operations_files.h"
 #include "inputvalidation.h"
 #include "encryption/CryptoUtils.h"
+#include "securedeletionqueue.h"
 
 #include <QDateTime>
 #include <QFileInfo>
@@ -28,11 +29,13 @@
 #include <QMutex>
 #include <QFuture>
 #include <QtConcurrent/QtConcurrent>
+#include <QThreadPool>
 #include <QHash>
 #include <functional>
 #include <memory>
 #include <QAtomicInt>
 #include <QDirIterator>
+#include <QElapsedTimer>
 #include <algorithm>
 
 // For Windows-specific APIs
@@ -208,14 +211,7 @@ static const QStringList WINDOWS_RESERVED_NAMES = {
     "LPT3", "LPT4", "LPT5", "LPT6", "LPT7", "LPT8", "LPT9"
 };
 
-// Static data for cleanup management
-static QList<QString> s_pendingDeletions;
-static QMutex s_pendingMutex;  // For thread safety
-static QAtomicInt s_cleanupScheduled(0);  // Atomic flag: 0 = not scheduled, 1 = scheduled
-static QAtomicInt s_cleanupCounter(0);     // Atomic counter for periodic cleanup triggers
-
 // Forward declarations of internal functions
-void performAsyncCleanup();
 bool quickDelete(const QString& filePath);
 QString enableWindowsLongPath(const QString& path);
 bool validatePathLength(const QString& path);
@@ -247,19 +243,13 @@ void TempFileCleaner::cleanup() {
         bool deleted = quickDelete(m_filePath);
 
         // Only clear the path if deletion was successful or scheduled
-        if (deleted || s_pendingDeletions.contains(m_filePath)) {
+        if (deleted || SecureDeletionQueue::instance().isQueued(m_filePath)) {
             m_filePath.clear();
             m_cleanup = false;
         } else {
-            // If deletion failed and not in pending list, keep the path for possible retry
+            // If deletion failed and no retry is queued, make sure it gets cleaned up later
             qWarning() << "operations_files: Cleanup failed for:" << m_filePath;
-            // Add to pending deletions to ensure it gets cleaned up later
-            s_pendingMutex.lock();
-            if (!s_pendingDeletions.contains(m_filePath)) {
-                s_pendingDeletions.append(m_filePath);
-                qDebug() << "operations_files: Added to pending deletion list:" << m_filePath;
-            }
-            s_pendingMutex.unlock();
+            SecureDeletionQueue::instance().scheduleRetry(m_filePath);
         }
     } else if (m_cleanup && m_filePath.isEmpty()) {
         qDebug() << "operations_files: Cleanup called with empty path";
@@ -281,6 +271,7 @@ bool quickDelete(const QString& filePath) {
     qDebug() << "operations_files: Trying QFile::remove()...";
     if (QFile::remove(filePath)) {
         qDebug() << "operations_files: Standard deletion successful for:" << filePath;
+        recordTempFileRemoved(filePath);
         return true;
     }
     qDebug() << "operations_files: QFile::remove() failed";
@@ -301,151 +292,18 @@ bool quickDelete(const QString& filePath) {
     if (fileHandle != INVALID_HANDLE_VALUE) {
         CloseHandle(fileHandle);
         qDebug() << "operations_files: Windows API deletion scheduled for:" << filePath;
+        recordTempFileRemoved(filePath);
         return true;
     }
     qDebug() << "operations_files: Windows API deletion also failed";
 #endif
 
-    // If we couldn't delete, add to pending list (safely)
-    qDebug() << "operations_files: Adding to pending deletion list";
-    
-    bool needsScheduling = false;
-    
-    s_pendingMutex.lock();
-    if (!s_pendingDeletions.contains(filePath)) {
-        s_pendingDeletions.append(filePath);
-        qDebug() << "operations_files: Added to pending deletion list:" << filePath;
-        
-        // Check if we need to schedule cleanup (if not already scheduled)
-        // Use load() for atomic read
-        if (s_cleanupScheduled.loadAcquire() == 0) {
-            needsScheduling = true;
-        }
-    }
-    s_pendingMutex.unlock();
-    
-    // Schedule cleanup outside of mutex to avoid holding lock during async operation
-    if (needsScheduling) {
-        // Try to atomically set the flag from 0 to 1
-        // This ensures only one thread schedules the cleanup
-        if (s_cleanupScheduled.testAndSetOrdered(0, 1)) {
-            qDebug() << "operations_files: Scheduling async cleanup";
-            
-            // Schedule asynchronous cleanup to avoid blocking the current operation
-            QFuture<void> future = QtConcurrent::run([]() {
-                // Give the current operation time to complete and release locks
-                QThread::msleep(100);
-                performAsyncCleanup();
-            });
-        } else {
-            qDebug() << "operations_files: Async cleanup already scheduled by another thread";
-        }
-    }
-
+    // If we couldn't delete, let the deletion queue retry it in the background
+    qDebug() << "operations_files: Scheduling retry for:" << filePath;
+    SecureDeletionQueue::instance().scheduleRetry(filePath);
     return false;
 }
 
-// Non-blocking cleanup function that runs in a separate thread
-void performAsyncCleanup() {
-    qDebug() << "operations_files: performAsyncCleanup started";
-    
-    // Create a local copy of pending deletions to minimize lock time
-    QList<QString> localPendingList;
-    
-    // Quick lock to copy the list
-    {
-        QMutexLocker locker(&s_pendingMutex);
-        
-        if (s_pendingDeletions.isEmpty()) {
-            qDebug() << "operations_files: No pending deletions, resetting cleanup flag";
-            // Reset the cleanup flag atomically
-            s_cleanupScheduled.storeRelease(0);
-            return;
-        }
-        
-        // Make a copy of the pending list
-        localPendingList = s_pendingDeletions;
-        // Clear the original list since we're processing these now
-        s_pendingDeletions.clear();
-    }
-    
-    qDebug() << "operations_files: Performing async cleanup of" << localPendingList.size() << "files";
-    
-    QList<QString> stillPending;
-    
-    // Process files without holding the mutex
-    for (const QString& filePath : localPendingList) {
-        if (!QFile::exists(filePath)) {
-            qDebug() << "operations_files: Pending file no longer exists:" << filePath;
-            continue; // Already gone
-        }
-        
-        // Try standard delete first
-        if (QFile::remove(filePath)) {
-            qDebug() << "operations_files: Async cleanup: Successfully deleted file:" << filePath;
-            continue;
-        }
-        
-// Try Windows API for stubborn files
-#ifdef Q_OS_WIN
-        HANDLE fileHandle = CreateFileW(
-            reinterpret_cast<const wchar_t*>(filePath.utf16()),
-            DELETE,
-            FILE_SHARE_DELETE | FILE_SHARE_READ | FILE_SHARE_WRITE,
-            NULL,
-            OPEN_EXISTING,
-            FILE_FLAG_DELETE_ON_CLOSE,
-            NULL
-            );
-        
-        if (fileHandle != INVALID_HANDLE_VALUE) {
-            CloseHandle(fileHandle);
-            qDebug() << "operations_files: Async cleanup: File marked for deletion on close:" << filePath;
-            continue;
-        }
-#endif
-        
-        // Still locked, keep in pending list
-        qDebug() << "operations_files: Async cleanup: File still locked:" << filePath;
-        stillPending.append(filePath);
-    }
-    
-    // Update the pending list with files that couldn't be deleted
-    bool needsReschedule = false;
-    
-    if (!stillPending.isEmpty()) {
-        QMutexLocker locker(&s_pendingMutex);
-        
-        // Merge stillPending with any new items that were added while we were processing
-        for (const QString& filePath : stillPending) {
-            if (!s_pendingDeletions.contains(filePath)) {
-                s_pendingDeletions.append(filePath);
-            }
-        }
-        
-        if (!s_pendingDeletions.isEmpty()) {
-            needsReschedule = true;
-            qDebug() << "operations_files: Still have" << s_pendingDeletions.size() << "pending files";
-        }
-    }
-    
-    // Reset the cleanup flag or reschedule
-    if (needsReschedule) {
-        qDebug() << "operations_files: Scheduling another cleanup pass for remaining files";
-        
-        // Schedule another cleanup pass later
-        QFuture<void> future = QtConcurrent::run([]() {
-            QThread::msleep(1000); // Wait longer between batches
-            performAsyncCleanup();
-        });
-        // Note: We keep s_cleanupScheduled as 1 since we're scheduling another pass
-    } else {
-        qDebug() << "operations_files: Async cleanup complete - no files remaining";
-        // Reset the cleanup flag atomically
-        s_cleanupScheduled.storeRelease(0);
-    }
-}
-
 // Windows long path support function
 QString enableWindowsLongPath(const QString& path) {
     QString absolutePath = QDir::toNativeSeparators(QFileInfo(path).absoluteFilePath());
@@ -638,48 +496,164 @@ void setUsername(const QString& username) {
     }
 }
 
-// Resource management for temp directory
-qint64 getTempDirectorySize(const QString& username) {
-    qDebug() << "operations_files: Getting temp directory size for user:" << (username.isEmpty() ? g_username : username);
-    
-    QString user = username.isEmpty() ? g_username : username;
-    
-    // Build path to temp directory
+// ============================================================================
+// Temp directory accounting
+// ============================================================================
+// Limit checks used to walk the whole temp directory every time. Instead each user's
+// temp size is built by one walk on first use, kept up to date as temp files are
+// recorded/removed, and reconciled with the filesystem in the background every few
+// minutes to pick up files that were written or deleted behind our back.
+
+struct TempStoreAccounting {
+    qint64 usedBytes = 0;
+    QHash<QString, qint64> trackedFiles; // Absolute path -> size
+    QElapsedTimer sinceReconcile;
+    bool reconciled = false;
+    bool reconcileRunning = false;
+};
+
+static QMutex s_tempAccountingMutex;
+static QHash<QString, TempStoreAccounting> s_tempAccounting;
+static const qint64 TEMP_RECONCILE_INTERVAL_MS = 5 * 60 * 1000; // 5 minutes
+
+static QString tempDirectoryForUser(const QString& user) {
     QString dataPath = securePathJoin(QDir::current().absolutePath(), "Data");
     if (dataPath.isEmpty()) {
         qWarning() << "operations_files: Failed to create secure data path";
-        return -1;
+        return QString();
     }
-    
+
     QString userPath = securePathJoin(dataPath, user);
     if (userPath.isEmpty()) {
         qWarning() << "operations_files: Failed to create secure user path";
-        return -1;
+        return QString();
     }
-    
+
     QString tempPath = securePathJoin(userPath, "Temp");
     if (tempPath.isEmpty()) {
         qWarning() << "operations_files: Failed to create secure temp path";
-        return -1;
+        return QString();
     }
-    
-    QDir tempDir(tempPath);
-    if (!tempDir.exists()) {
-        qDebug() << "operations_files: Temp directory doesn't exist yet";
-        return 0; // Directory doesn't exist, size is 0
+    return tempPath;
+}
+
+// Returns the user whose Data/<user>/Temp directory contains filePath, or an empty string
+static QString tempOwnerOfPath(const QString& filePath) {
+    QString dataPath = QDir::cleanPath(QDir::current().absolutePath() + "/Data") + "/";
+    QString cleanedPath = QDir::cleanPath(QFileInfo(filePath).absoluteFilePath());
+    if (!cleanedPath.startsWith(dataPath, Qt::CaseInsensitive)) {
+        return QString();
     }
-    
-    // Calculate total size of all files in temp directory
+
+    QStringList parts = cleanedPath.mid(dataPath.length()).split('/', Qt::SkipEmptyParts);
+    if (parts.size() < 3 || parts[1].compare("Temp", Qt::CaseInsensitive) != 0) {
+        return QString();
+    }
+    return parts[0];
+}
+
+static void reconcileTempStore(const QString& user) {
+    {
+        QMutexLocker locker(&s_tempAccountingMutex);
+        TempStoreAccounting& store = s_tempAccounting[user];
+        if (store.reconcileRunning) {
+            return;
+        }
+        store.reconcileRunning = true;
+    }
+
+    // Walk without holding the lock, limit checks keep using the tracked value meanwhile
     qint64 totalSize = 0;
-    QDirIterator it(tempPath, QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
-    while (it.hasNext()) {
-        it.next();
-        QFileInfo fileInfo(it.filePath());
-        totalSize += fileInfo.size();
+    QHash<QString, qint64> files;
+    QString tempPath = tempDirectoryForUser(user);
+    if (!tempPath.isEmpty() && QDir(tempPath).exists()) {
+        QDirIterator it(tempPath, QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            it.next();
+            qint64 size = it.fileInfo().size();
+            files.insert(QDir::cleanPath(it.fileInfo().absoluteFilePath()), size);
+            totalSize += size;
+        }
+    }
+
+    QMutexLocker locker(&s_tempAccountingMutex);
+    TempStoreAccounting& store = s_tempAccounting[user];
+    if (store.reconciled && store.usedBytes != totalSize) {
+        qDebug() << "operations_files: Temp accounting drift corrected for user:" << user
+                 << "Tracked:" << store.usedBytes << "Actual:" << totalSize;
+    }
+    store.usedBytes = totalSize;
+    store.trackedFiles = files;
+    store.sinceReconcile.start();
+    store.reconciled = true;
+    store.reconcileRunning = false;
+}
+
+void reconcileTempDirectorySize(const QString& username) {
+    reconcileTempStore(username.isEmpty() ? g_username : username);
+}
+
+void recordTempFileCreated(const QString& filePath) {
+    QString user = tempOwnerOfPath(filePath);
+    if (user.isEmpty()) {
+        return;
+    }
+
+    QFileInfo fileInfo(filePath);
+    qint64 size = fileInfo.exists() ? fileInfo.size() : 0;
+    QString key = QDir::cleanPath(fileInfo.absoluteFilePath());
+
+    QMutexLocker locker(&s_tempAccountingMutex);
+    TempStoreAccounting& store = s_tempAccounting[user];
+    store.usedBytes += size - store.trackedFiles.value(key, 0);
+    store.trackedFiles.insert(key, size);
+}
+
+void recordTempFileRemoved(const QString& filePath) {
+    QString user = tempOwnerOfPath(filePath);
+    if (user.isEmpty()) {
+        return;
+    }
+
+    QString key = QDir::cleanPath(QFileInfo(filePath).absoluteFilePath());
+
+    QMutexLocker locker(&s_tempAccountingMutex);
+    TempStoreAccounting& store = s_tempAccounting[user];
+    // Files that were never recorded or walked were never counted either
+    auto it = store.trackedFiles.find(key);
+    if (it != store.trackedFiles.end()) {
+        store.usedBytes = qMax<qint64>(0, store.usedBytes - it.value());
+        store.trackedFiles.erase(it);
     }
-    
-    qDebug() << "operations_files: Temp directory size:" << totalSize << "bytes";
-    return totalSize;
+}
+
+// Resource management for temp directory
+qint64 getTempDirectorySize(const QString& username) {
+    QString user = username.isEmpty() ? g_username : username;
+
+    bool needsInitialWalk = false;
+    bool needsBackgroundReconcile = false;
+    {
+        QMutexLocker locker(&s_tempAccountingMutex);
+        TempStoreAccounting& store = s_tempAccounting[user];
+        if (!store.reconciled) {
+            needsInitialWalk = !store.reconcileRunning;
+        } else if (!store.reconcileRunning && store.sinceReconcile.elapsed() > TEMP_RECONCILE_INTERVAL_MS) {
+            needsBackgroundReconcile = true;
+        }
+    }
+
+    if (needsInitialWalk) {
+        qDebug() << "operations_files: Building temp directory accounting for user:" << user;
+        reconcileTempStore(user);
+    } else if (needsBackgroundReconcile) {
+        QThreadPool::globalInstance()->start([user]() {
+            reconcileTempStore(user);
+        });
+    }
+
+    QMutexLocker locker(&s_tempAccountingMutex);
+    return s_tempAccounting.value(user).usedBytes;
 }
 
 qint64 getAvailableDiskSpace(const QString& path) {
@@ -808,6 +782,10 @@ bool cleanupOldTempFiles(const QString& username, qint64 targetSize) {
 
     QList<TempFileInfo> tempFiles;
     for (const QFileInfo& info : fileList) {
+        // Files waiting for their overwrite belong to the secure deletion queue
+        if (SecureDeletionQueue::isPendingVictim(info.fileName())) {
+            continue;
+        }
         tempFiles.append({info.absoluteFilePath(), info.size(), info.lastModified()});
     }
 
@@ -822,6 +800,7 @@ bool cleanupOldTempFiles(const QString& username, qint64 targetSize) {
 
         // Use QFile::remove() for temp files
         if (QFile::remove(info.path)) {
+            recordTempFileRemoved(info.path);
             freedSpace += info.size;
             filesDeleted++;
             qDebug() << "operations_files: Successfully deleted temp file, freed:" << info.size << "bytes";
@@ -1337,32 +1316,11 @@ std::unique_ptr<QTemporaryFile> createTempFile(const QString& baseFileTemplate,
     return tempFile;
 }
 
-// Streamlined secure delete that prioritizes performance
+// Secure delete without blocking the caller: the file is renamed out of the way immediately,
+// the overwrite and delete run on the SecureDeletionQueue workers
 bool secureDelete(const QString& filePath, int passes, bool allowExternalFiles) {
     qDebug() << "operations_files: === secureDelete called for:" << filePath << "with" << passes << "passes, allowExternalFiles:" << allowExternalFiles << " ===";
 
-    // Process pending deletions occasionally to clean up old files
-    // Use atomic increment and check
-    int counterValue = s_cleanupCounter.fetchAndAddOrdered(1);
-    if ((counterValue % 10) == 0) {
-        // Try pending cleanups every 10 calls, but don't wait
-        bool needsScheduling = false;
-        
-        s_pendingMutex.lock();
-        if (!s_pendingDeletions.isEmpty() && s_cleanupScheduled.loadAcquire() == 0) {
-            needsScheduling = true;
-        }
-        s_pendingMutex.unlock();
-        
-        if (needsScheduling) {
-            // Try to atomically set the flag from 0 to 1
-            if (s_cleanupScheduled.testAndSetOrdered(0, 1)) {
-                qDebug() << "operations_files: Triggering periodic cleanup";
-                QFuture<void> future = QtConcurrent::run(performAsyncCleanup);
-            }
-        }
-    }
-
     // Validate the file path - use different validation based on allowExternalFiles
     InputValidation::ValidationResult result;
     if (allowExternalFiles) {
@@ -1376,100 +1334,12 @@ bool secureDelete(const QString& filePath, int passes, bool allowExternalFiles)
         return false;
     }
 
-    QFile file(filePath);
-    if (!file.exists()) {
+    if (!QFile::exists(filePath)) {
         qDebug() << "operations_files: File doesn't exist, returning true";
         return true; // Already gone
     }
 
-    // Get file size
-    qint64 fileSize = file.size();
-    qDebug() << "operations_files: File size:" << fileSize;
-    if (fileSize <= 0) {
-        qDebug() << "operations_files: File size <= 0, calling quickDelete";
-        // Empty file, just quick delete
-        return quickDelete(filePath);
-    }
-
-    // For smaller files or when the system is under heavy file operations,
-    // reduce passes to improve performance
-    int effectivePasses = (fileSize < 4096) ? 1 : (passes > 2 ? 2 : passes);
-    qDebug() << "operations_files: Effective passes:" << effectivePasses;
-
-    // Make sure file is closed
-    file.close();
-
-    // Try to open with proper sharing flags to reduce locking issues
-    qDebug() << "operations_files: Attempting to open file for writing...";
-    if (!file.open(QIODevice::WriteOnly)) {
-        qDebug() << "operations_files: Failed to open file for writing, calling quickDelete";
-        qDebug() << "operations_files: File error:" << file.error();
-        qDebug() << "operations_files: Error string:" << file.errorString();
-        // If we can't open it, just try quick deletion
-        return quickDelete(filePath);
-    }
-    qDebug() << "operations_files: File opened successfully for writing";
-
-    // Buffer for overwriting
-    const int BUFFER_SIZE = 4096;
-    QByteArray buffer(BUFFER_SIZE, 0);
-    QRandomGenerator* rng = QRandomGenerator::system();
-
-    bool overwriteSuccess = true;
-
-    try {
-        // Perform minimal overwrite passes
-        for (int pass = 0; pass < effectivePasses; ++pass) {
-            qDebug() << "operations_files: Secure delete pass" << (pass + 1) << "of" << effectivePasses << "for" << filePath;
-
-            // Use a pattern based on pass number
-            char pattern = (pass == 0) ? 0x00 : 0xFF;
-
-            // Fill the file with the pattern
-            if (!file.seek(0)) {
-                qDebug() << "operations_files: Failed to seek to beginning of file";
-                overwriteSuccess = false;
-                break;
-            }
-
-            buffer.fill(pattern);
-            qint64 bytesRemaining = fileSize;
-
-            while (bytesRemaining > 0 && overwriteSuccess) {
-                int bytesToWrite = qMin(bytesRemaining, (qint64)BUFFER_SIZE);
-                qint64 bytesWritten = file.write(buffer.constData(), bytesToWrite);
-
-                if (bytesWritten != bytesToWrite) {
-                    qDebug() << "operations_files: Write failed: expected" << bytesToWrite << "got" << bytesWritten;
-                    overwriteSuccess = false;
-                    break;
-                }
-
-                bytesRemaining -= bytesWritten;
-            }
-
-            if (!overwriteSuccess) break;
-            file.flush();
-            qDebug() << "operations_files: Pass" << (pass + 1) << "completed successfully";
-        }
-    } catch (const std::exception& e) {
-        qWarning() << "operations_files: Exception during secure file deletion:" << e.what();
-        overwriteSuccess = false;
-    } catch (...) {
-        qWarning() << "operations_files: Unknown exception during secure file deletion";
-        overwriteSuccess = false;
-    }
-
-    qDebug() << "operations_files: Overwrite success:" << overwriteSuccess;
-
-    // Close file
-    file.close();
-    qDebug() << "operations_files: File closed, calling quickDelete";
-
-    // Quick delete regardless of overwrite success
-    bool deleteResult = quickDelete(filePath);
-    qDebug() << "operations_files: quickDelete result:" << deleteResult;
-    return deleteResult;
+    return SecureDeletionQueue::instance().enqueue(filePath, passes);
 }
 
 bool encryptToTargetAndCleanup(QTemporaryFile* tempFile, const QString& targetPath, const QByteArray& encryptionKey) {
@@ -1601,6 +1471,7 @@ bool decryptToTempAndProcess(const QString& encryptedFilePath, const QByteArray&
                 // Cleaner will handle deletion when it goes out of scope
                 return false;
             }
+            recordTempFileCreated(tempFilePath);
 
             qDebug() << "Decryption successful to temp file:" << tempFilePath;
         } catch (const std::exception& e) {
@@ -1641,6 +1512,45 @@ bool decryptToTempAndProcess(const QString& encryptedFilePath, const QByteArray&
     }
 }
 
+// Decrypts a small encrypted text file (diary, tasklist, settings) straight into memory.
+// These files used to go through a temp file + secure delete on every read.
+static bool decryptFileToString(const QString& filePath, const QByteArray& encryptionKey, QString& outText) {
+    try {
+        if (!CryptoUtils::Encryption_DecryptFileToString(encryptionKey, filePath, outText)) {
+            qWarning() << "Decryption failed for file:" << filePath;
+            return false;
+        }
+    } catch (const std::exception& e) {
+        qWarning() << "Exception during file decryption:" << e.what();
+        outText.clear();
+        return false;
+    } catch (...) {
+        qWarning() << "Unknown exception during file decryption";
+        outText.clear();
+        return false;
+    }
+    return true;
+}
+
+// Splits decrypted text into lines the same way QTextStream::readLine() did on the temp file
+static QStringList splitDecryptedLines(const QString& text) {
+    QStringList lines;
+    if (text.isEmpty()) {
+        return lines;
+    }
+
+    lines = text.split('\n');
+    if (lines.last().isEmpty()) {
+        lines.removeLast(); // A trailing newline doesn't start another line
+    }
+    for (QString& line : lines) {
+        if (line.endsWith('\r')) {
+            line.chop(1);
+        }
+    }
+    return lines;
+}
+
 // New functions to abstract common file operations
 
 // Optimized encrypted file reading with improved error handling
@@ -1671,67 +1581,17 @@ bool readEncryptedFileLines(const QString& filePath, const QByteArray& encryptio
         return false;
     }
     
-    // Check if we have enough resources to decrypt this file
-    if (!canDecryptToTemp(filePath, g_username)) {
-        qWarning() << "operations_files: Cannot decrypt file due to resource constraints";
-        return false;
-    }
-
-    // Create a temporary file
-    auto tempFile = createTempFile();
-    if (!tempFile) {
-        qWarning() << "Failed to create temporary file for decryption";
+    // Decrypt in memory and split into lines, no temp file round trip
+    QString decryptedText;
+    if (!decryptFileToString(filePath, encryptionKey, decryptedText)) {
         return false;
     }
 
-    // Close the temp file but keep it on disk
-    QString tempFilePath = tempFile->fileName();
-    tempFile->close();
-
-    qDebug() << "Created temp file for reading encrypted lines:" << tempFilePath;
-
-    // Use a separate scope for the TempFileCleaner to ensure proper cleanup
-    {
-        // Create a temp file cleaner for secure deletion
-        TempFileCleaner cleaner(tempFilePath);
-
-        // Decrypt to the temp file
-        bool decryptionSuccess = false;
-        try {
-            decryptionSuccess = CryptoUtils::Encryption_DecryptFile(encryptionKey, filePath, tempFilePath);
-            if (!decryptionSuccess) {
-                qWarning() << "Decryption failed for file:" << filePath;
-                return false;
-            }
-
-            qDebug() << "Successfully decrypted file to temp location";
-        } catch (const std::exception& e) {
-            qWarning() << "Exception during file decryption:" << e.what();
-            return false;
-        } catch (...) {
-            qWarning() << "Unknown exception during file decryption";
-            return false;
-        }
-
-        // Read the decrypted content line by line
-        QFile file(tempFilePath);
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            qWarning() << "Failed to open decrypted file for reading: " << tempFilePath;
-            return false;
-        }
-
-        QTextStream in(&file);
-        while (!in.atEnd()) {
-            outLines.append(in.readLine());
-        }
-        file.close();
+    outLines = splitDecryptedLines(decryptedText);
+    decryptedText.fill(QChar(0));
 
-        qDebug() << "Successfully read" << outLines.size() << "lines from decrypted file";
-
-        // Cleaner will handle deletion when it goes out of scope
-
-        return true;
-    }
+    qDebug() << "Successfully read" << outLines.size() << "lines from encrypted file";
+    return true;
 }
 
 // Optimized encrypted file writing
@@ -1981,74 +1841,24 @@ bool readEncryptedFile(const QString& filePath, const QByteArray& encryptionKey,
         return false;
     }
     
-    // Check if we have enough resources to decrypt this file
-    if (!canDecryptToTemp(filePath, g_username)) {
-        qWarning() << "operations_files: Cannot decrypt file due to resource constraints";
+    // Decrypt in memory, no temp file round trip
+    if (!decryptFileToString(filePath, encryptionKey, outContent)) {
         return false;
     }
+    // Match the line endings the old text-mode read produced
+    outContent.replace("\r\n", "\n");
 
-    // Create a temporary file
-    auto tempFile = createTempFile();
-    if (!tempFile) {
-        qWarning() << "Failed to create temporary file for decryption";
+    // SECURITY: TOCTOU mitigation - validate decrypted content size
+    qint64 decryptedSize = outContent.toUtf8().size();
+    if (decryptedSize > MAX_CONTENT_SIZE) {
+        qWarning() << "operations_files: Decrypted content exceeds size limit:"
+                   << decryptedSize << "bytes (max:" << MAX_CONTENT_SIZE << "bytes)";
+        outContent.clear(); // Clear potentially malicious content
         return false;
     }
 
-    // Close the temp file but keep it on disk
-    QString tempFilePath = tempFile->fileName();
-    tempFile->close();
-
-    qDebug() << "Created temp file for reading encrypted content:" << tempFilePath;
-
-    // Use a separate scope for the TempFileCleaner to ensure proper cleanup
-    {
-        // Create a temp file cleaner for secure deletion
-        TempFileCleaner cleaner(tempFilePath);
-
-        // Decrypt to the temp file
-        bool decryptionSuccess = false;
-        try {
-            decryptionSuccess = CryptoUtils::Encryption_DecryptFile(encryptionKey, filePath, tempFilePath);
-            if (!decryptionSuccess) {
-                qWarning() << "Decryption failed for file:" << filePath;
-                return false;
-            }
-
-            qDebug() << "Successfully decrypted file to temp location";
-        } catch (const std::exception& e) {
-            qWarning() << "Exception during file decryption:" << e.what();
-            return false;
-        } catch (...) {
-            qWarning() << "Unknown exception during file decryption";
-            return false;
-        }
-
-        // Read the decrypted content
-        QFile file(tempFilePath);
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            qWarning() << "Failed to open decrypted file for reading: " << tempFilePath;
-            return false;
-        }
-
-        QTextStream in(&file);
-        outContent = in.readAll();
-        file.close();
-
-        // SECURITY: TOCTOU mitigation - validate decrypted content size
-        qint64 decryptedSize = outContent.toUtf8().size();
-        if (decryptedSize > MAX_CONTENT_SIZE) {
-            qWarning() << "operations_files: Decrypted content exceeds size limit:"
-                       << decryptedSize << "bytes (max:" << MAX_CONTENT_SIZE << "bytes)";
-            outContent.clear(); // Clear potentially malicious content
-            return false;
-        }
-
-        qDebug() << "Successfully read" << outContent.length() << "characters from decrypted file";
-
-        // Cleaner will handle deletion when it goes out of scope
-
-        return true;
-    }
+    qDebug() << "Successfully read" << outContent.length() << "characters from encrypted file";
+    return true;
 }
 
 // Optimized writing to encrypted files
@@ -2152,6 +1962,50 @@ bool writeEncryptedFile(const QString& filePath, const QByteArray& encryptionKey
     }
 }
 
+// Small encrypted files (indexes, manifests, journals) that are always read and written whole
+bool readEncryptedBlob(const QString& filePath, const QByteArray& encryptionKey, QByteArray& outData) {
+    outData.clear();
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "operations_files: Failed to open encrypted blob:" << filePath;
+        return false;
+    }
+    const QByteArray encryptedData = file.readAll();
+    file.close();
+
+    outData = CryptoUtils::Encryption_DecryptBArray(encryptionKey, encryptedData);
+    if (outData.isEmpty()) {
+        qWarning() << "operations_files: Failed to decrypt encrypted blob:" << filePath;
+        return false;
+    }
+    return true;
+}
+
+bool writeEncryptedBlob(const QString& filePath, const QByteArray& encryptionKey, const QByteArray& plainData,
+                        const QString& username) {
+    const QByteArray encryptedData = CryptoUtils::Encryption_EncryptBArray(encryptionKey, plainData, username);
+    if (encryptedData.isEmpty()) {
+        qWarning() << "operations_files: Failed to encrypt blob for:" << filePath;
+        return false;
+    }
+
+    // QSaveFile keeps the previous file intact if we are killed mid-write, and the plaintext never touches the disk
+    QSaveFile saveFile(filePath);
+    if (!saveFile.open(QIODevice::WriteOnly)) {
+        qWarning() << "operations_files: Failed to open encrypted blob for writing:" << filePath;
+        return false;
+    }
+    if (saveFile.write(encryptedData) != encryptedData.size() || !saveFile.commit()) {
+        qWarning() << "operations_files: Failed to write encrypted blob:" << filePath;
+        return false;
+    }
+    if (!QFile::setPermissions(filePath, DEFAULT_FILE_PERMISSIONS)) {
+        qWarning() << "operations_files: Failed to set permissions on encrypted blob:" << filePath;
+    }
+    return true;
+}
+
 // Process (modify) the content of an encrypted file
 bool processEncryptedFile(const QString& filePath, const QByteArray& encryptionKey,
                           std::function<bool(QString&)> processFunction) {
@@ -2614,70 +2468,17 @@ bool readTasklistFile(const QString& filePath, const QByteArray& encryptionKey,
         return false;
     }
     
-    // Check if we have enough resources to decrypt this file
-    if (!canDecryptToTemp(filePath, g_username)) {
-        qWarning() << "operations_files: Cannot decrypt tasklist file due to resource constraints";
+    // Decrypt in memory and split into task lines, no temp file round trip
+    QString decryptedText;
+    if (!decryptFileToString(filePath, encryptionKey, decryptedText)) {
         return false;
     }
 
-    // Create a temporary file
-    auto tempFile = createTempFile();
-    if (!tempFile) {
-        qWarning() << "Failed to create temporary file for decryption";
-        return false;
-    }
-
-    // Close the temp file but keep it on disk
-    QString tempFilePath = tempFile->fileName();
-    tempFile->close();
+    taskLines = splitDecryptedLines(decryptedText);
+    decryptedText.fill(QChar(0));
 
-    qDebug() << "Created temp file for reading tasklist:" << tempFilePath;
-
-    // Use a separate scope for the TempFileCleaner to ensure proper cleanup
-    {
-        // Create a temp file cleaner for secure deletion
-        TempFileCleaner cleaner(tempFilePath);
-
-        // Decrypt to the temp file
-        bool decryptionSuccess = false;
-        try {
-            decryptionSuccess = CryptoUtils::Encryption_DecryptFile(encryptionKey, filePath, tempFilePath);
-            if (!decryptionSuccess) {
-                qWarning() << "Decryption failed for tasklist file:" << filePath;
-                return false;
-            }
-
-            qDebug() << "Successfully decrypted tasklist to temp file";
-        } catch (const std::exception& e) {
-            qWarning() << "Exception during tasklist file decryption:" << e.what();
-            return false;
-        } catch (...) {
-            qWarning() << "Unknown exception during tasklist file decryption";
-            return false;
-        }
-
-        // Read the decrypted content
-        QFile file(tempFilePath);
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            qWarning() << "Failed to open decrypted tasklist file for reading:" << tempFilePath;
-            return false;
-        }
-
-        QTextStream in(&file);
-
-        // Read all lines (task entries)
-        while (!in.atEnd()) {
-            taskLines.append(in.readLine());
-        }
-
-        file.close();
-
-        qDebug() << "Successfully read" << taskLines.size() << "task lines";
-
-        // Cleaner will handle deletion when it goes out of scope
-
-        return true;
-    }
+    qDebug() << "Successfully read" << taskLines.size() << "task lines";
+    return true;
 }
 
 // Write a tasklist file with task entries
@@ -3124,6 +2925,13 @@ bool cleanupAllUserTempFolders() {
                 continue;
             }
 
+            // Left behind before its overwrite finished, the plaintext is still in its blocks
+            if (SecureDeletionQueue::isPendingVictim(fileName)) {
+                qDebug() << "Queueing unfinished secure deletion:" << filePath;
+                SecureDeletionQueue::instance().enqueue(filePath);
+                continue;
+            }
+
             qDebug() << "Deleting temp file:" << filePath;
 
             // Use existing secureDelete function with allowExternalFiles = false
@@ -3131,6 +2939,7 @@ bool cleanupAllUserTempFolders() {
             bool deleteResult = QFile::remove(filePath);
 
             if (deleteResult) {
+                recordTempFileRemoved(filePath);
                 totalFilesDeleted++;
                 qDebug() << "Successfully deleted temp file:" << fileName;
             } else {
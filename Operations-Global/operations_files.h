@@ -81,6 +81,10 @@ bool cleanupAllUserTempFolders(); // fallback function, triggered on app launch.
 
 // Resource management for temp directory
 qint64 getTempDirectorySize(const QString& username = QString()); // Get current size of temp directory
+// Temp size is tracked incrementally, report temp files we create/delete so limit checks stay accurate
+void recordTempFileCreated(const QString& filePath);
+void recordTempFileRemoved(const QString& filePath);
+void reconcileTempDirectorySize(const QString& username = QString()); // Re-walk the temp directory now
 qint64 getAvailableDiskSpace(const QString& path = QString()); // Get available disk space for path
 bool checkTempDirectoryLimits(qint64 requiredSize, const QString& username = QString()); // Check if we can create new temp file
 bool cleanupOldTempFiles(const QString& username = QString(), qint64 targetSize = 0); // Cleanup old temp files to free space
@@ -103,6 +107,9 @@ std::unique_ptr<QFile> openSecureFile(const QString& filePath, QIODevice::OpenMo
 // Temporary file operations
 std::unique_ptr<QTemporaryFile> createTempFile(const QString& baseFileTemplate = QString(), bool autoRemove = false);
 
+// Queues the file for background overwrite + delete (see SecureDeletionQueue), returns immediately
+bool secureDelete(const QString& filePath, int passes = 1, bool allowExternalFiles = false);
+
 // Encryption and file processing operations
 bool encryptToTargetAndCleanup(QTemporaryFile* tempFile, const QString& targetPath, const QByteArray& encryptionKey);
 bool decryptToTempAndProcess(const QString& encryptedFilePath, const QByteArray& encryptionKey,
@@ -114,6 +121,10 @@ bool writeEncryptedFileLines(const QString& filePath, const QByteArray& encrypti
 bool deleteFileAndCleanEmptyDirs(const QString& filePath, const QStringList& hierarchyLevels, const QString& basePath);
 bool readEncryptedFile(const QString& filePath, const QByteArray& encryptionKey, QString& outContent);
 bool writeEncryptedFile(const QString& filePath, const QByteArray& encryptionKey, const QString& content);
+// Whole-file encrypted blobs (Encryption_EncryptBArray format), replaced atomically through QSaveFile
+bool readEncryptedBlob(const QString& filePath, const QByteArray& encryptionKey, QByteArray& outData);
+bool writeEncryptedBlob(const QString& filePath, const QByteArray& encryptionKey, const QByteArray& plainData,
+                        const QString& username = QString());
 bool processEncryptedFile(const QString& filePath, const QByteArray& encryptionKey,
                           std::function<bool(QString&)> processFunction);
 bool searchEncryptedFile(const QString& filePath, const QByteArray& encryptionKey,
@@ -0,0 +1,273 @@
+#include "recordlogfile.h"
+#include "CryptoUtils.h"
+#include "operations_files.h"
+#include <QFile>
+#include <QSaveFile>
+#include <QCryptographicHash>
+#include <QtEndian>
+#include <QDebug>
+
+const qint64 RecordLogFile::MAX_LOG_SIZE = 50 * 1024 * 1024; // Same limit as other encrypted text files
+const quint32 RecordLogFile::MAX_RECORD_SIZE = 50 * 1024 * 1024;
+
+RecordLogFile::RecordLogFile(const QByteArray& logHeader)
+    : m_logHeader(logHeader)
+{
+}
+
+bool RecordLogFile::isRecordLog(const QString& filePath) const
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    return file.read(m_logHeader.size()) == m_logHeader;
+}
+
+bool RecordLogFile::validateKey(const QString& filePath, const QByteArray& encryptionKey) const
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "RecordLogFile: Failed to open file for key validation:" << filePath;
+        return false;
+    }
+    if (file.read(m_logHeader.size()) != m_logHeader) {
+        return false;
+    }
+
+    quint32 recordSize = 0;
+    if (file.read(reinterpret_cast<char*>(&recordSize), sizeof(recordSize)) != sizeof(recordSize)) {
+        qWarning() << "RecordLogFile: Record log has no records:" << filePath;
+        return false;
+    }
+    recordSize = qFromLittleEndian(recordSize);
+    if (recordSize == 0 || recordSize > MAX_RECORD_SIZE) {
+        qWarning() << "RecordLogFile: Invalid first record size in:" << filePath;
+        return false;
+    }
+
+    QByteArray encryptedRecord = file.read(recordSize);
+    if (encryptedRecord.size() != static_cast<int>(recordSize)) {
+        qWarning() << "RecordLogFile: Truncated first record in:" << filePath;
+        return false;
+    }
+    return !CryptoUtils::Encryption_DecryptBArray(encryptionKey, encryptedRecord).isEmpty();
+}
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+RecordLogFile::ReadResult RecordLogFile::read(const QString& filePath, const QByteArray& encryptionKey,
+                                              FileState& outState, const RecordHandler& applyRecord) const
+{
+    outState = FileState();
+    outState.keyFingerprint = keyFingerprint(encryptionKey);
+    refreshFileState(filePath, outState);
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "RecordLogFile: Failed to open file:" << filePath;
+        return ReadResult::Failed;
+    }
+
+    if (file.read(m_logHeader.size()) != m_logHeader) {
+        outState.legacy = true;
+        outState.validEnd = outState.fileSize;
+        return ReadResult::Legacy;
+    }
+
+    if (file.size() > MAX_LOG_SIZE) {
+        qWarning() << "RecordLogFile: File too large:" << file.size() << "bytes:" << filePath;
+        return ReadResult::Failed;
+    }
+
+    const QByteArray data = m_logHeader + file.readAll();
+    file.close();
+
+    qint64 pos = m_logHeader.size();
+    outState.validEnd = pos;
+    while (pos + static_cast<qint64>(sizeof(quint32)) <= data.size()) {
+        const quint32 recordSize = qFromLittleEndian<quint32>(data.constData() + pos);
+        const qint64 recordEnd = pos + static_cast<qint64>(sizeof(quint32)) + recordSize;
+        if (recordEnd > data.size()) {
+            break; // Torn write at the tail
+        }
+        if (recordSize == 0 || recordSize > MAX_RECORD_SIZE) {
+            qWarning() << "RecordLogFile: Invalid record size at offset" << pos << "in" << filePath
+                       << "- ignoring the rest of the log";
+            outState.corrupted = true;
+            break;
+        }
+
+        const QByteArray encryptedRecord = QByteArray::fromRawData(data.constData() + pos + sizeof(quint32),
+                                                                   static_cast<int>(recordSize));
+        QByteArray plainRecord = CryptoUtils::Encryption_DecryptBArray(encryptionKey, encryptedRecord);
+        if (plainRecord.isEmpty()) {
+            if (outState.recordCount == 0) {
+                qWarning() << "RecordLogFile: Failed to decrypt:" << filePath;
+                return ReadResult::Failed;
+            }
+            qWarning() << "RecordLogFile: Corrupted record at offset" << pos << "in" << filePath
+                       << "- ignoring the rest of the log";
+            outState.corrupted = true;
+            break;
+        }
+        const bool applied = applyRecord(plainRecord);
+        plainRecord.fill('\0'); // SECURITY: Don't leave the serialized plaintext around
+        if (!applied) {
+            qWarning() << "RecordLogFile: Invalid record at offset" << pos << "in" << filePath
+                       << "- ignoring the rest of the log";
+            outState.corrupted = true;
+            break;
+        }
+
+        ++outState.recordCount;
+        pos = recordEnd;
+        outState.validEnd = pos;
+    }
+
+    if (outState.recordCount == 0) {
+        qWarning() << "RecordLogFile: Record log has no intact records:" << filePath;
+        return ReadResult::Failed;
+    }
+    if (!outState.corrupted && outState.validEnd != data.size()) {
+        qWarning() << "RecordLogFile: Ignoring" << (data.size() - outState.validEnd)
+                   << "trailing bytes of an incomplete write in" << filePath;
+    }
+    return ReadResult::Ok;
+}
+
+// ============================================================================
+// Writing
+// ============================================================================
+
+QByteArray RecordLogFile::encryptRecord(const QByteArray& encryptionKey, QByteArray& plainRecord) const
+{
+    if (static_cast<quint32>(plainRecord.size()) > MAX_RECORD_SIZE) {
+        qWarning() << "RecordLogFile: Record too large:" << plainRecord.size() << "bytes";
+        plainRecord.fill('\0');
+        return QByteArray();
+    }
+
+    QByteArray encryptedRecord = CryptoUtils::Encryption_EncryptBArray(encryptionKey, plainRecord, QString());
+    plainRecord.fill('\0'); // SECURITY: Don't leave the serialized plaintext around
+    if (encryptedRecord.isEmpty()) {
+        qWarning() << "RecordLogFile: Failed to encrypt record";
+    }
+    return encryptedRecord;
+}
+
+bool RecordLogFile::writeSnapshot(const QString& filePath, const QByteArray& encryptionKey,
+                                  const QByteArray& encryptedRecord, FileState& outState) const
+{
+    QByteArray fileData = m_logHeader;
+    const quint32 recordSize = qToLittleEndian(static_cast<quint32>(encryptedRecord.size()));
+    fileData.append(reinterpret_cast<const char*>(&recordSize), sizeof(recordSize));
+    fileData.append(encryptedRecord);
+
+    // QSaveFile keeps the previous log intact if we are killed mid-write
+    QSaveFile saveFile(filePath);
+    if (!saveFile.open(QIODevice::WriteOnly)) {
+        qWarning() << "RecordLogFile: Failed to open file for writing:" << filePath;
+        return false;
+    }
+    if (saveFile.write(fileData) != fileData.size() || !saveFile.commit()) {
+        qWarning() << "RecordLogFile: Failed to write file:" << filePath;
+        return false;
+    }
+
+    if (!QFile::setPermissions(filePath, OperationsFiles::DEFAULT_FILE_PERMISSIONS)) {
+        qWarning() << "RecordLogFile: Failed to set permissions on:" << filePath;
+    }
+
+    outState = FileState();
+    outState.keyFingerprint = keyFingerprint(encryptionKey);
+    outState.validEnd = fileData.size();
+    outState.recordCount = 1;
+    refreshFileState(filePath, outState);
+    return true;
+}
+
+bool RecordLogFile::appendRecord(const QString& filePath, const QByteArray& encryptedRecord, FileState& state) const
+{
+    // The records after a corrupted one may still be intact, truncating would delete them for good
+    if (state.corrupted) {
+        qWarning() << "RecordLogFile: Refusing to append to a log with a corrupted record:" << filePath;
+        return false;
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadWrite)) {
+        qWarning() << "RecordLogFile: Failed to open file for appending:" << filePath;
+        return false;
+    }
+
+    // Drop the remains of an interrupted append so the new record follows the last intact one
+    if (file.size() != state.validEnd) {
+        qDebug() << "RecordLogFile: Truncating" << filePath << "to the last intact record at" << state.validEnd;
+        if (!file.resize(state.validEnd)) {
+            qWarning() << "RecordLogFile: Failed to truncate:" << filePath;
+            return false;
+        }
+    }
+
+    QByteArray recordData;
+    const quint32 recordSize = qToLittleEndian(static_cast<quint32>(encryptedRecord.size()));
+    recordData.append(reinterpret_cast<const char*>(&recordSize), sizeof(recordSize));
+    recordData.append(encryptedRecord);
+
+    if (!file.seek(state.validEnd) || file.write(recordData) != recordData.size() || !file.flush()) {
+        qWarning() << "RecordLogFile: Failed to append record to:" << filePath;
+        return false;
+    }
+    file.close();
+
+    state.validEnd += recordData.size();
+    ++state.recordCount;
+    refreshFileState(filePath, state);
+    return true;
+}
+
+bool RecordLogFile::preserveCorrupted(const QString& filePath) const
+{
+    // Still encrypted, kept next to the log under a name the readers don't pick up
+    const QString backupPath = filePath + ".corrupted-" +
+                               QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss");
+    if (!QFile::copy(filePath, backupPath)) {
+        qWarning() << "RecordLogFile: Failed to back up corrupted log:" << filePath;
+        return false;
+    }
+    if (!QFile::setPermissions(backupPath, OperationsFiles::DEFAULT_FILE_PERMISSIONS)) {
+        qWarning() << "RecordLogFile: Failed to set permissions on:" << backupPath;
+    }
+    qWarning() << "RecordLogFile: Kept a copy of the corrupted log as:" << backupPath;
+    return true;
+}
+
+bool RecordLogFile::needsCompaction(const FileState& state, int recordThreshold) const
+{
+    return state.recordCount >= recordThreshold || state.validEnd > MAX_LOG_SIZE / 2;
+}
+
+// ============================================================================
+// File state
+// ============================================================================
+
+void RecordLogFile::refreshFileState(const QString& filePath, FileState& state)
+{
+    QFileInfo info(filePath);
+    state.fileSize = info.size();
+    state.modified = info.lastModified();
+}
+
+bool RecordLogFile::fileStateMatches(const QString& filePath, const FileState& state)
+{
+    QFileInfo info(filePath);
+    return info.exists() && info.size() == state.fileSize && info.lastModified() == state.modified;
+}
+
+QByteArray RecordLogFile::keyFingerprint(const QByteArray& encryptionKey)
+{
+    return QCryptographicHash::hash(encryptionKey, QCryptographicHash::Sha256);
+}
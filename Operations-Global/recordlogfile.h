@@ -0,0 +1,126 @@
+#ifndef RECORDLOGFILE_H
+#define RECORDLOGFILE_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QHash>
+#include <functional>
+
+// File side of the record log formats (DiaryRecordLog, TasklistRecordLog).
+// A record log is a fixed header followed by independently encrypted, length-prefixed records:
+//   [8 byte header: magic + version] [quint32 length][encrypted record] [quint32 length][encrypted record] ...
+// This class frames, reads, appends and atomically rewrites such files and tracks where the last
+// intact record ends, so a torn append (a record running past the end of the file) is cut off
+// before the next one. A record that is complete but can't be decrypted or applied is corruption
+// rather than a torn append: the log is marked as such and is never truncated, since the records
+// after it may still be intact. What a record contains and how it is applied is up to the format.
+class RecordLogFile
+{
+public:
+    // Where a log stands on disk, the formats cache it along with their decoded content
+    struct FileState {
+        QByteArray keyFingerprint;  // Only valid for the key that produced it
+        bool legacy = false;        // Old single-blob file, converted on the next write
+        qint64 validEnd = 0;        // End of the last intact record
+        bool corrupted = false;     // A record before the end is unreadable, appending is refused
+        int recordCount = 0;
+        qint64 fileSize = 0;
+        QDateTime modified;
+    };
+
+    enum class ReadResult {
+        Ok,
+        Legacy,     // The file has no record log header, the caller reads it the old way
+        Failed
+    };
+
+    // Gets each decrypted record in file order, returns false for a record that can't be applied
+    using RecordHandler = std::function<bool(const QByteArray& plainRecord)>;
+
+    explicit RecordLogFile(const QByteArray& logHeader);
+
+    bool isRecordLog(const QString& filePath) const;
+    // Checks the key against the first record without replaying the whole log
+    bool validateKey(const QString& filePath, const QByteArray& encryptionKey) const;
+
+    // Replays the intact records. The state is taken before the file is read, so if a writer gets
+    // in between, the state is older than the content and fails the next fileStateMatches().
+    ReadResult read(const QString& filePath, const QByteArray& encryptionKey, FileState& outState,
+                    const RecordHandler& applyRecord) const;
+
+    // Size checks and encrypts a serialized record, the plaintext is scrubbed either way.
+    // Returns an empty array on failure.
+    QByteArray encryptRecord(const QByteArray& encryptionKey, QByteArray& plainRecord) const;
+
+    // Replaces the file with a log holding only this record
+    bool writeSnapshot(const QString& filePath, const QByteArray& encryptionKey, const QByteArray& encryptedRecord,
+                       FileState& outState) const;
+    // Appends a record after state.validEnd, cutting off the remains of an interrupted append first.
+    // Fails for a corrupted log.
+    bool appendRecord(const QString& filePath, const QByteArray& encryptedRecord, FileState& state) const;
+    // Copies a corrupted log aside before the caller replaces it with a snapshot
+    bool preserveCorrupted(const QString& filePath) const;
+
+    // Whether the log should be folded back into a snapshot after an append
+    bool needsCompaction(const FileState& state, int recordThreshold) const;
+
+    static void refreshFileState(const QString& filePath, FileState& state);
+    static bool fileStateMatches(const QString& filePath, const FileState& state);
+    static QByteArray keyFingerprint(const QByteArray& encryptionKey);
+
+    static const qint64 MAX_LOG_SIZE;
+    static const quint32 MAX_RECORD_SIZE;
+
+private:
+    QByteArray m_logHeader;
+};
+
+// Decoded logs of the most recently used files, Entry derives from RecordLogFile::FileState.
+// Not thread safe, the formats guard it with their own mutex.
+template<typename Entry>
+class RecordLogCache
+{
+public:
+    // Anything else that touched the file (sync tools, another instance) invalidates the entry
+    const Entry* find(const QString& filePath, const QByteArray& encryptionKey) const
+    {
+        auto it = m_entries.constFind(QFileInfo(filePath).absoluteFilePath());
+        if (it == m_entries.constEnd()) {
+            return nullptr;
+        }
+        if (it->keyFingerprint != RecordLogFile::keyFingerprint(encryptionKey) ||
+            !RecordLogFile::fileStateMatches(filePath, it.value())) {
+            return nullptr;
+        }
+        return &it.value();
+    }
+
+    void store(const QString& filePath, const Entry& entry)
+    {
+        const QString key = QFileInfo(filePath).absoluteFilePath();
+        m_entries.insert(key, entry);
+        m_order.removeAll(key);
+        m_order.append(key);
+
+        while (m_order.size() > MAX_CACHED_FILES) {
+            m_entries.remove(m_order.takeFirst());
+        }
+    }
+
+    void clear()
+    {
+        m_entries.clear();
+        m_order.clear();
+    }
+
+private:
+    static const int MAX_CACHED_FILES = 8;
+
+    QHash<QString, Entry> m_entries;
+    QStringList m_order;  // Least recently used first
+};
+
+#endif // RECORDLOGFILE_H
@@ -0,0 +1,438 @@
+#include "securedeletionqueue.h"
+#include "operations_files.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QRandomGenerator>
+#include <QElapsedTimer>
+#include <QDeadlineTimer>
+#include <QMutexLocker>
+#include <QtGlobal>
+#include <QDebug>
+#include <cstring>  // For std::memset
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// Renamed victims are hidden on POSIX and recognisable everywhere
+static const QString VICTIM_PREFIX = QStringLiteral(".mmdel_");
+
+static QString queueKey(const QString& filePath)
+{
+    return QDir::cleanPath(QFileInfo(filePath).absoluteFilePath());
+}
+
+SecureDeletionQueue& SecureDeletionQueue::instance()
+{
+    static SecureDeletionQueue instance;
+    return instance;
+}
+
+SecureDeletionQueue::SecureDeletionQueue()
+    : m_activeWorkers(0)
+    , m_inFlight(0)
+    , m_retryWaiting(false)
+    , m_pendingBytes(0)
+    , m_completedFiles(0)
+    , m_bytesOverwritten(0)
+    , m_overwriteNanoseconds(0)
+    , m_shuttingDown(0)
+{
+    m_workerPool.setMaxThreadCount(MAX_WORKERS);
+}
+
+SecureDeletionQueue::~SecureDeletionQueue()
+{
+    shutdown();
+}
+
+// ============================================================================
+// Public interface
+// ============================================================================
+
+bool SecureDeletionQueue::enqueue(const QString& filePath, int passes)
+{
+    QFileInfo fileInfo(filePath);
+    if (!fileInfo.exists()) {
+        return true; // Already gone
+    }
+
+    // Periodic temp cleanups may list files that are already ours
+    if (isQueued(filePath)) {
+        return true;
+    }
+
+    Job job;
+    job.originalPath = filePath;
+    job.path = filePath;
+    job.passes = passes;
+    job.overwrite = passes > 0;
+    job.size = fileInfo.size();
+
+    // Get the plaintext out of its known location immediately. If the file is still
+    // held open without delete sharing the rename fails, the worker retries on the original path.
+    // Victims left by a previous session are already out of the way.
+    QString renamedPath = isPendingVictim(fileInfo.fileName()) ? QString() : renameVictim(filePath);
+    if (!renamedPath.isEmpty()) {
+        job.path = renamedPath;
+        OperationsFiles::recordTempFileRemoved(filePath);
+        OperationsFiles::recordTempFileCreated(renamedPath);
+    } else {
+        qDebug() << "SecureDeletionQueue: Could not rename, queueing under original path:" << filePath;
+    }
+
+    qDebug() << "SecureDeletionQueue: Queued" << filePath << "(" << job.size << "bytes," << passes << "passes)";
+    addJob(job);
+    return true;
+}
+
+void SecureDeletionQueue::scheduleRetry(const QString& filePath)
+{
+    Job job;
+    job.originalPath = filePath;
+    job.path = filePath;
+    job.overwrite = false;
+
+    QMutexLocker locker(&m_mutex);
+    if (m_queuedPaths.contains(queueKey(filePath))) {
+        return;
+    }
+    m_queuedPaths.insert(queueKey(filePath));
+    m_retryJobs.append(job);
+    qDebug() << "SecureDeletionQueue: Added to retry list:" << filePath;
+    startWorkersLocked();
+}
+
+bool SecureDeletionQueue::isQueued(const QString& filePath) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_queuedPaths.contains(queueKey(filePath));
+}
+
+SecureDeletionQueue::Stats SecureDeletionQueue::stats() const
+{
+    QMutexLocker locker(&m_mutex);
+    return statsLocked();
+}
+
+bool SecureDeletionQueue::isPendingVictim(const QString& fileName)
+{
+    return fileName.startsWith(VICTIM_PREFIX);
+}
+
+bool SecureDeletionQueue::waitForIdle(int timeoutMs)
+{
+    QDeadlineTimer deadline = (timeoutMs < 0) ? QDeadlineTimer(QDeadlineTimer::Forever) : QDeadlineTimer(timeoutMs);
+    QMutexLocker locker(&m_mutex);
+    while (m_activeWorkers > 0) {
+        if (!m_idleCondition.wait(&m_mutex, deadline)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SecureDeletionQueue::shutdown(int timeoutMs)
+{
+    if (!m_shuttingDown.testAndSetOrdered(0, 1)) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        const Stats current = statsLocked();
+        qDebug() << "SecureDeletionQueue: Shutting down, files left:" << current.queueDepth
+                 << "retrying:" << current.retryDepth << "bytes still to overwrite:" << current.pendingBytes
+                 << "deleted:" << current.completedFiles << "overwrite rate:"
+                 << qRound64(current.bytesPerSecond) << "bytes/s";
+        m_retryCondition.wakeAll();
+    }
+    if (!m_workerPool.waitForDone(timeoutMs)) {
+        qWarning() << "SecureDeletionQueue: Workers still busy after shutdown timeout";
+    }
+
+    // Whatever was left is on disk under its victim name, later secure deletes queue as usual
+    m_shuttingDown.storeRelease(0);
+}
+
+// ============================================================================
+// Workers
+// ============================================================================
+
+SecureDeletionQueue::Stats SecureDeletionQueue::statsLocked() const
+{
+    Stats stats;
+    stats.queueDepth = m_jobs.size() + m_inFlight;
+    stats.retryDepth = m_retryJobs.size();
+    stats.pendingBytes = m_pendingBytes;
+    stats.completedFiles = m_completedFiles;
+    stats.bytesOverwritten = m_bytesOverwritten;
+    if (m_overwriteNanoseconds > 0) {
+        stats.bytesPerSecond = static_cast<double>(m_bytesOverwritten) * 1e9 / m_overwriteNanoseconds;
+    }
+    return stats;
+}
+
+void SecureDeletionQueue::addJob(const Job& job)
+{
+    QMutexLocker locker(&m_mutex);
+    m_queuedPaths.insert(queueKey(job.originalPath));
+    m_queuedPaths.insert(queueKey(job.path));
+    if (job.overwrite) {
+        m_pendingBytes += job.size;
+    }
+    m_jobs.enqueue(job);
+    startWorkersLocked();
+}
+
+void SecureDeletionQueue::startWorkersLocked()
+{
+    int wanted = qMin(MAX_WORKERS, m_jobs.size() + (m_retryJobs.isEmpty() ? 0 : 1));
+    while (m_activeWorkers < wanted) {
+        m_activeWorkers++;
+        m_workerPool.start([this]() { workerLoop(); });
+    }
+}
+
+void SecureDeletionQueue::workerLoop()
+{
+    QMutexLocker locker(&m_mutex);
+    forever {
+        if (m_jobs.isEmpty()) {
+            // Only one worker sits out the retry delay, the others exit
+            if (m_retryJobs.isEmpty() || m_retryWaiting) {
+                break;
+            }
+            m_retryWaiting = true;
+            if (m_shuttingDown.loadAcquire() == 0) {
+                m_retryCondition.wait(&m_mutex, RETRY_DELAY_MS);
+            }
+            m_retryWaiting = false;
+            while (!m_retryJobs.isEmpty()) {
+                m_jobs.enqueue(m_retryJobs.takeFirst());
+            }
+            continue;
+        }
+
+        Job job = m_jobs.dequeue();
+        QString queuedPath = job.path;
+        m_inFlight++;
+        locker.unlock();
+
+        bool deleted = processJob(job);
+
+        locker.relock();
+        m_inFlight--;
+        if (job.overwrite) {
+            m_pendingBytes -= job.size;
+        }
+
+        if (deleted) {
+            m_completedFiles++;
+            m_queuedPaths.remove(queueKey(job.originalPath));
+            m_queuedPaths.remove(queueKey(queuedPath));
+        } else if (m_shuttingDown.loadAcquire() != 0) {
+            qDebug() << "SecureDeletionQueue: Left" << job.path << "for the next launch";
+            m_queuedPaths.remove(queueKey(job.originalPath));
+            m_queuedPaths.remove(queueKey(queuedPath));
+        } else if (++job.attempts >= MAX_RETRY_ATTEMPTS) {
+            qWarning() << "SecureDeletionQueue: Giving up on" << job.path << "after" << job.attempts << "attempts";
+            if (job.overwrite) {
+                leaveForNextLaunch(job);
+            }
+            m_queuedPaths.remove(queueKey(job.originalPath));
+            m_queuedPaths.remove(queueKey(queuedPath));
+        } else {
+            // Locked or not overwritten yet, the overwrite (if any) is attempted again on the next pass
+            if (job.overwrite) {
+                m_pendingBytes += job.size;
+            }
+            m_retryJobs.append(job);
+        }
+    }
+
+    m_activeWorkers--;
+    m_idleCondition.wakeAll();
+}
+
+bool SecureDeletionQueue::processJob(Job& job)
+{
+    if (!QFile::exists(job.path)) {
+        qDebug() << "SecureDeletionQueue: File no longer exists:" << job.path;
+        return true;
+    }
+
+    if (job.overwrite) {
+        // Unlinking now would hand the plaintext blocks back to the filesystem, the file is
+        // overwritten on the next launch instead
+        if (m_shuttingDown.loadAcquire() != 0) {
+            leaveForNextLaunch(job);
+            return false;
+        }
+        if (!overwriteFile(job)) {
+            // Never unlink blocks that were not overwritten, the job goes back to the retry list
+            if (m_shuttingDown.loadAcquire() != 0) {
+                leaveForNextLaunch(job);
+            }
+            return false;
+        }
+    }
+
+    if (removeFile(job.path)) {
+        qDebug() << "SecureDeletionQueue: Deleted" << job.originalPath;
+        return true;
+    }
+
+    qDebug() << "SecureDeletionQueue: File still locked:" << job.path;
+    return false;
+}
+
+bool SecureDeletionQueue::overwriteFile(const Job& job)
+{
+    qint64 fileSize = QFileInfo(job.path).size();
+    if (fileSize <= 0) {
+        return true;
+    }
+
+    // Same pass policy as before, more than two passes buys nothing on modern drives
+    int effectivePasses = (fileSize < 4096) ? 1 : qMin(job.passes, 2);
+
+    // ReadWrite so the file is not truncated first, which could hand the old blocks back to the filesystem
+    QFile file(job.path);
+    if (!file.open(QIODevice::ReadWrite | QIODevice::Unbuffered)) {
+        qDebug() << "SecureDeletionQueue: Failed to open for overwrite:" << job.path << file.errorString();
+        return false;
+    }
+
+    char* buffer = static_cast<char*>(qMallocAligned(BUFFER_SIZE, BUFFER_ALIGNMENT));
+    if (!buffer) {
+        qWarning() << "SecureDeletionQueue: Failed to allocate overwrite buffer";
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    qint64 totalWritten = 0;
+    bool overwriteSuccess = true;
+
+    for (int pass = 0; pass < effectivePasses && overwriteSuccess; ++pass) {
+        std::memset(buffer, (pass == 0) ? 0x00 : 0xFF, BUFFER_SIZE);
+
+        if (!file.seek(0)) {
+            qDebug() << "SecureDeletionQueue: Failed to seek to beginning of file";
+            overwriteSuccess = false;
+            break;
+        }
+
+        qint64 bytesRemaining = fileSize;
+        while (bytesRemaining > 0) {
+            // Don't keep the app from closing on a multi-GB overwrite
+            if (m_shuttingDown.loadAcquire() != 0) {
+                qDebug() << "SecureDeletionQueue: Overwrite interrupted by shutdown:" << job.path;
+                overwriteSuccess = false;
+                break;
+            }
+
+            qint64 bytesToWrite = qMin(bytesRemaining, static_cast<qint64>(BUFFER_SIZE));
+            qint64 bytesWritten = file.write(buffer, bytesToWrite);
+            if (bytesWritten != bytesToWrite) {
+                qDebug() << "SecureDeletionQueue: Write failed: expected" << bytesToWrite << "got" << bytesWritten;
+                overwriteSuccess = false;
+                break;
+            }
+            bytesRemaining -= bytesWritten;
+            totalWritten += bytesWritten;
+        }
+
+        // Make sure the pattern actually reaches the disk before the file is unlinked
+        if (overwriteSuccess && !syncToDisk(file.handle())) {
+            qDebug() << "SecureDeletionQueue: Failed to flush overwrite pass to disk";
+        }
+    }
+
+    qFreeAligned(buffer);
+    file.close();
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_bytesOverwritten += totalWritten;
+        m_overwriteNanoseconds += timer.nsecsElapsed();
+    }
+    return overwriteSuccess;
+}
+
+void SecureDeletionQueue::leaveForNextLaunch(Job& job)
+{
+    // Files still under their original name would get a plain delete from the temp cleanup
+    if (isPendingVictim(QFileInfo(job.path).fileName())) {
+        return;
+    }
+    QString renamedPath = renameVictim(job.path);
+    if (!renamedPath.isEmpty()) {
+        OperationsFiles::recordTempFileRemoved(job.path);
+        OperationsFiles::recordTempFileCreated(renamedPath);
+        job.path = renamedPath;
+    }
+}
+
+// ============================================================================
+// Platform helpers
+// ============================================================================
+
+QString SecureDeletionQueue::renameVictim(const QString& filePath)
+{
+    QFileInfo fileInfo(filePath);
+    QString victimName = QString(VICTIM_PREFIX + "%1").arg(QRandomGenerator::system()->generate64(), 16, 16, QChar('0'));
+    QString victimPath = QDir(fileInfo.absolutePath()).absoluteFilePath(victimName);
+
+    if (!QFile::rename(filePath, victimPath)) {
+        return QString();
+    }
+    return victimPath;
+}
+
+bool SecureDeletionQueue::removeFile(const QString& filePath)
+{
+    if (QFile::remove(filePath)) {
+        OperationsFiles::recordTempFileRemoved(filePath);
+        return true;
+    }
+
+// Windows API is more effective for files that are still being released
+#ifdef Q_OS_WIN
+    HANDLE fileHandle = CreateFileW(
+        reinterpret_cast<const wchar_t*>(filePath.utf16()),
+        DELETE,
+        FILE_SHARE_DELETE | FILE_SHARE_READ | FILE_SHARE_WRITE,
+        NULL,
+        OPEN_EXISTING,
+        FILE_FLAG_DELETE_ON_CLOSE,
+        NULL
+        );
+
+    if (fileHandle != INVALID_HANDLE_VALUE) {
+        CloseHandle(fileHandle);
+        OperationsFiles::recordTempFileRemoved(filePath);
+        return true;
+    }
+#endif
+
+    return false;
+}
+
+bool SecureDeletionQueue::syncToDisk(int fileHandle)
+{
+    if (fileHandle < 0) {
+        return false;
+    }
+#ifdef Q_OS_WIN
+    HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(fileHandle));
+    return handle != INVALID_HANDLE_VALUE && FlushFileBuffers(handle);
+#else
+    return ::fsync(fileHandle) == 0;
+#endif
+}
@@ -0,0 +1,111 @@
+#ifndef SECUREDELETIONQUEUE_H
+#define SECUREDELETIONQUEUE_H
+
+#include <QString>
+#include <QQueue>
+#include <QList>
+#include <QSet>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThreadPool>
+#include <QAtomicInt>
+
+// Background service behind OperationsFiles::secureDelete().
+// Overwriting a multi-GB decrypted video used to run synchronously on the calling thread,
+// which froze the UI when the player closed. Files are now renamed to an unguessable name
+// right away (so the plaintext is no longer reachable under its original path) and queued.
+// A small, bounded set of workers then overwrites them with large aligned buffers and deletes
+// them. Files that are still locked (e.g. the player hasn't released them yet) are retried
+// later, which also replaces the old pending-deletions list used by quickDelete().
+class SecureDeletionQueue
+{
+public:
+    struct Stats {
+        int queueDepth = 0;          // Files waiting for or being processed by a worker
+        int retryDepth = 0;          // Locked or not yet overwritten files waiting for the next retry pass
+        qint64 pendingBytes = 0;     // Bytes still to be overwritten
+        qint64 completedFiles = 0;
+        qint64 bytesOverwritten = 0;
+        double bytesPerSecond = 0.0; // Average overwrite throughput of a worker
+    };
+
+    // Singleton access method
+    static SecureDeletionQueue& instance();
+
+    // Delete copy constructor and assignment operator
+    SecureDeletionQueue(const SecureDeletionQueue&) = delete;
+    SecureDeletionQueue& operator=(const SecureDeletionQueue&) = delete;
+
+    // Renames the file out of the way and queues it for overwrite + delete.
+    // Files that were already renamed by a previous session are queued under their current name.
+    // The path must already be validated by the caller.
+    bool enqueue(const QString& filePath, int passes = 1);
+
+    // Queues a plain (no overwrite) delete for a file that could not be removed yet
+    void scheduleRetry(const QString& filePath);
+
+    bool isQueued(const QString& filePath) const;
+    Stats stats() const;
+
+    // True for the names files get while they wait for their overwrite
+    static bool isPendingVictim(const QString& fileName);
+
+    // Blocks until all queued work is done or the timeout expires (-1 = no timeout)
+    bool waitForIdle(int timeoutMs = -1);
+
+    // Stops overwriting and waits for the workers. Files that were not fully overwritten are not
+    // removed, they stay renamed in the temp folders and the next launch's temp cleanup queues
+    // them again. Plain deletes still get their last attempt. The queue accepts work again
+    // afterwards, logging out keeps the process running.
+    void shutdown(int timeoutMs = 3000);
+
+private:
+    SecureDeletionQueue();
+    ~SecureDeletionQueue();
+
+    struct Job {
+        QString path;            // Current (renamed) path
+        QString originalPath;    // Path the caller asked to delete, for logging
+        int passes = 1;
+        bool overwrite = true;
+        qint64 size = 0;
+        int attempts = 0;
+    };
+
+    static QString renameVictim(const QString& filePath);
+    static bool removeFile(const QString& filePath);
+    static bool syncToDisk(int fileHandle);
+
+    Stats statsLocked() const;
+    void addJob(const Job& job);
+    void startWorkersLocked();
+    void workerLoop();
+    bool processJob(Job& job);
+    bool overwriteFile(const Job& job);
+    void leaveForNextLaunch(Job& job);
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_idleCondition;
+    QWaitCondition m_retryCondition;   // A worker waits on this between retry passes
+    QQueue<Job> m_jobs;
+    QList<Job> m_retryJobs;
+    QSet<QString> m_queuedPaths;       // Original and renamed paths of all queued/in-flight/retry jobs
+    int m_activeWorkers;
+    int m_inFlight;
+    bool m_retryWaiting;
+    qint64 m_pendingBytes;
+    qint64 m_completedFiles;
+    qint64 m_bytesOverwritten;
+    qint64 m_overwriteNanoseconds;
+    QAtomicInt m_shuttingDown;
+
+    QThreadPool m_workerPool;
+
+    static const int MAX_WORKERS = 2;
+    static const int BUFFER_SIZE = 4 * 1024 * 1024;   // 4MB per worker
+    static const int BUFFER_ALIGNMENT = 4096;
+    static const int RETRY_DELAY_MS = 1000;
+    static const int MAX_RETRY_ATTEMPTS = 120;          // ~2 minutes, leftovers are removed on next launch
+};
+
+#endif // SECUREDELETIONQUEUE_H
@@ -0,0 +1,528 @@
+#include "tasklistrecordlog.h"
+#include "CryptoUtils.h"
+#include "operations_files.h"
+#include "inputvalidation.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QDataStream>
+#include <QJsonDocument>
+#include <QMutexLocker>
+#include <QSet>
+#include <QDebug>
+
+const RecordLogFile TasklistRecordLog::s_logFile(QByteArray("MMTRLOG\x01", 8)); // Magic + format version 1
+
+QMutex TasklistRecordLog::s_mutex;
+RecordLogCache<TasklistRecordLog::CachedLog> TasklistRecordLog::s_cache;
+
+// ============================================================================
+// Public interface
+// ============================================================================
+
+bool TasklistRecordLog::read(const QString& filePath, const QByteArray& encryptionKey,
+                             QByteArray& outHeader, QJsonArray& outTasks)
+{
+    InputValidation::ValidationResult result =
+        InputValidation::validateInput(filePath, InputValidation::InputType::FilePath);
+    if (!result.isValid) {
+        qWarning() << "TasklistRecordLog: Invalid file path for reading:" << result.errorMessage;
+        return false;
+    }
+
+    QMutexLocker locker(&s_mutex);
+    const CachedLog* cached = s_cache.find(filePath, encryptionKey);
+    if (cached) {
+        outHeader = cached->header;
+        outTasks = cached->tasks;
+        return true;
+    }
+
+    CachedLog log;
+    if (!loadFromDisk(filePath, encryptionKey, log)) {
+        return false;
+    }
+    outHeader = log.header;
+    outTasks = log.tasks;
+    s_cache.store(filePath, log);
+    return true;
+}
+
+bool TasklistRecordLog::readUncached(const QString& filePath, const QByteArray& encryptionKey,
+                                     QByteArray& outHeader, QJsonArray& outTasks)
+{
+    InputValidation::ValidationResult result =
+        InputValidation::validateInput(filePath, InputValidation::InputType::FilePath);
+    if (!result.isValid) {
+        qWarning() << "TasklistRecordLog: Invalid file path for reading:" << result.errorMessage;
+        return false;
+    }
+
+    // loadFromDisk only touches its own CachedLog, no lock needed
+    CachedLog log;
+    if (!loadFromDisk(filePath, encryptionKey, log)) {
+        return false;
+    }
+    outHeader = log.header;
+    outTasks = log.tasks;
+    return true;
+}
+
+bool TasklistRecordLog::write(const QString& filePath, const QByteArray& encryptionKey,
+                              const QByteArray& header, const QJsonArray& tasks)
+{
+    InputValidation::ValidationResult result =
+        InputValidation::validateInput(filePath, InputValidation::InputType::FilePath);
+    if (!result.isValid) {
+        qWarning() << "TasklistRecordLog: Invalid file path for writing:" << result.errorMessage;
+        return false;
+    }
+    if (header.size() != HEADER_SIZE) {
+        qWarning() << "TasklistRecordLog: Invalid metadata header size:" << header.size();
+        return false;
+    }
+
+    QMutexLocker locker(&s_mutex);
+
+    if (!QFileInfo::exists(filePath)) {
+        if (!OperationsFiles::ensureDirectoryExists(QFileInfo(filePath).dir().path())) {
+            qWarning() << "TasklistRecordLog: Failed to create directory for:" << filePath;
+            return false;
+        }
+        return writeSnapshotLocked(filePath, encryptionKey, header, tasks);
+    }
+
+    CachedLog log;
+    const CachedLog* cached = s_cache.find(filePath, encryptionKey);
+    if (cached) {
+        log = *cached;
+    } else if (!loadFromDisk(filePath, encryptionKey, log)) {
+        qWarning() << "TasklistRecordLog: Refusing to write, existing file could not be read:" << filePath;
+        return false;
+    }
+
+    if (log.legacy) {
+        qDebug() << "TasklistRecordLog: Converting legacy tasklist file to record log:" << filePath;
+        return writeSnapshotLocked(filePath, encryptionKey, header, tasks);
+    }
+    if (log.corrupted) {
+        // What follows the bad record can't be replayed, keep it aside rather than cutting it off
+        if (!s_logFile.preserveCorrupted(filePath)) {
+            qWarning() << "TasklistRecordLog: Refusing to write over corrupted file:" << filePath;
+            return false;
+        }
+        return writeSnapshotLocked(filePath, encryptionKey, header, tasks);
+    }
+
+    QVector<Change> changes;
+    if (!diff(log, header, tasks, changes)) {
+        // Tasks without unique IDs can't be addressed by a change record
+        qDebug() << "TasklistRecordLog: Tasks can't be diffed, writing a snapshot of:" << filePath;
+        return writeSnapshotLocked(filePath, encryptionKey, header, tasks);
+    }
+    if (changes.isEmpty()) {
+        return true; // Nothing changed
+    }
+
+    if (!appendRecordLocked(filePath, encryptionKey, log, changes)) {
+        return false;
+    }
+
+    if (s_logFile.needsCompaction(log, COMPACT_RECORD_THRESHOLD)) {
+        qDebug() << "TasklistRecordLog: Compacting" << filePath << "after" << log.recordCount << "records";
+        if (!writeSnapshotLocked(filePath, encryptionKey, log.header, log.tasks)) {
+            // The appended record is already durable, the log just stays uncompacted for now
+            qWarning() << "TasklistRecordLog: Compaction failed for:" << filePath;
+        }
+    }
+    return true;
+}
+
+bool TasklistRecordLog::isRecordLog(const QString& filePath)
+{
+    return s_logFile.isRecordLog(filePath);
+}
+
+bool TasklistRecordLog::validateKey(const QString& filePath, const QByteArray& encryptionKey)
+{
+    return s_logFile.validateKey(filePath, encryptionKey);
+}
+
+void TasklistRecordLog::clearCache()
+{
+    QMutexLocker locker(&s_mutex);
+    s_cache.clear();
+}
+
+// ============================================================================
+// Loading
+// ============================================================================
+
+bool TasklistRecordLog::loadFromDisk(const QString& filePath, const QByteArray& encryptionKey, CachedLog& outLog)
+{
+    outLog = CachedLog();
+    QByteArray header;
+    QJsonArray tasks;
+    const RecordLogFile::ReadResult result = s_logFile.read(filePath, encryptionKey, outLog,
+        [&header, &tasks](const QByteArray& plainRecord) { return applyRecord(plainRecord, header, tasks); });
+
+    if (result == RecordLogFile::ReadResult::Legacy) {
+        return loadLegacy(filePath, encryptionKey, outLog);
+    }
+    if (result != RecordLogFile::ReadResult::Ok) {
+        qWarning() << "TasklistRecordLog: Failed to read tasklist file:" << filePath;
+        return false;
+    }
+    outLog.header = header;
+    outLog.tasks = tasks;
+    return true;
+}
+
+bool TasklistRecordLog::loadLegacy(const QString& filePath, const QByteArray& encryptionKey, CachedLog& outLog)
+{
+    QString decryptedText;
+    if (!CryptoUtils::Encryption_DecryptFileToString(encryptionKey, filePath, decryptedText)) {
+        qWarning() << "TasklistRecordLog: Failed to decrypt legacy tasklist file:" << filePath;
+        return false;
+    }
+    QByteArray content = decryptedText.toUtf8();
+    decryptedText.fill(QChar(0)); // SECURITY: Scrub the decrypted text
+
+    if (content.size() < HEADER_SIZE) {
+        qWarning() << "TasklistRecordLog: Legacy tasklist file has no metadata header:" << filePath;
+        content.fill('\0');
+        return false;
+    }
+    outLog.header = content.left(HEADER_SIZE);
+
+    const QByteArray jsonData = content.mid(HEADER_SIZE).trimmed();
+    content.fill('\0');
+    if (!jsonData.isEmpty()) {
+        const QJsonDocument doc = QJsonDocument::fromJson(jsonData);
+        if (!doc.isObject() || !doc.object().value("tasks").isArray()) {
+            qWarning() << "TasklistRecordLog: Invalid task data in legacy tasklist file:" << filePath;
+            return false;
+        }
+        outLog.tasks = doc.object().value("tasks").toArray();
+    }
+    return true;
+}
+
+// ============================================================================
+// Writing
+// ============================================================================
+
+bool TasklistRecordLog::writeSnapshotLocked(const QString& filePath, const QByteArray& encryptionKey,
+                                            const QByteArray& header, const QJsonArray& tasks)
+{
+    const QByteArray record = encodeSnapshot(encryptionKey, header, tasks);
+    if (record.isEmpty()) {
+        return false;
+    }
+
+    CachedLog log;
+    if (!s_logFile.writeSnapshot(filePath, encryptionKey, record, log)) {
+        return false;
+    }
+    log.header = header;
+    log.tasks = tasks;
+    s_cache.store(filePath, log);
+    return true;
+}
+
+bool TasklistRecordLog::appendRecordLocked(const QString& filePath, const QByteArray& encryptionKey,
+                                           CachedLog& log, const QVector<Change>& changes)
+{
+    const QByteArray record = encodeChanges(encryptionKey, changes);
+    if (record.isEmpty() || !s_logFile.appendRecord(filePath, record, log)) {
+        return false;
+    }
+
+    for (const Change& change : changes) {
+        applyChange(change, log.header, log.tasks);
+    }
+    s_cache.store(filePath, log);
+    return true;
+}
+
+// ============================================================================
+// Diffing
+// ============================================================================
+
+bool TasklistRecordLog::diff(const CachedLog& log, const QByteArray& header, const QJsonArray& tasks,
+                             QVector<Change>& outChanges)
+{
+    outChanges.clear();
+
+    QStringList oldIds;
+    QStringList newIds;
+    if (!taskIds(log.tasks, oldIds) || !taskIds(tasks, newIds)) {
+        return false;
+    }
+    const QSet<QString> oldIdSet(oldIds.begin(), oldIds.end());
+    const QSet<QString> newIdSet(newIds.begin(), newIds.end());
+
+    if (header != log.header) {
+        Change change;
+        change.type = ChangeType::SetHeader;
+        change.payload = header;
+        outChanges.append(change);
+    }
+
+    // Deleted tasks
+    for (const QString& id : oldIds) {
+        if (!newIdSet.contains(id)) {
+            Change change;
+            change.type = ChangeType::DeleteTask;
+            change.taskId = id;
+            outChanges.append(change);
+        }
+    }
+
+    // Changed fields of the tasks that stay
+    QHash<QString, QJsonObject> newTasksById;
+    for (int i = 0; i < tasks.size(); ++i) {
+        newTasksById.insert(newIds[i], tasks[i].toObject());
+    }
+    for (int i = 0; i < log.tasks.size(); ++i) {
+        auto newTask = newTasksById.constFind(oldIds[i]);
+        if (newTask == newTasksById.constEnd()) {
+            continue;
+        }
+        const QJsonObject oldTask = log.tasks[i].toObject();
+        if (oldTask == newTask.value()) {
+            continue;
+        }
+
+        QJsonObject setFields;
+        QJsonArray unsetFields;
+        for (auto it = newTask->constBegin(); it != newTask->constEnd(); ++it) {
+            if (oldTask.value(it.key()) != it.value()) {
+                setFields.insert(it.key(), it.value());
+            }
+        }
+        for (auto it = oldTask.constBegin(); it != oldTask.constEnd(); ++it) {
+            if (!newTask->contains(it.key())) {
+                unsetFields.append(it.key());
+            }
+        }
+
+        QJsonObject update;
+        update.insert("set", setFields);
+        update.insert("unset", unsetFields);
+
+        Change change;
+        change.type = ChangeType::UpdateTask;
+        change.taskId = oldIds[i];
+        change.payload = QJsonDocument(update).toJson(QJsonDocument::Compact);
+        outChanges.append(change);
+    }
+
+    // New tasks, inserted where they end up
+    for (int i = 0; i < tasks.size(); ++i) {
+        if (!oldIdSet.contains(newIds[i])) {
+            Change change;
+            change.type = ChangeType::AddTask;
+            change.position = i;
+            change.payload = QJsonDocument(tasks[i].toObject()).toJson(QJsonDocument::Compact);
+            outChanges.append(change);
+        }
+    }
+
+    // Replay the changes to see whether the order still differs
+    QByteArray replayedHeader = log.header;
+    QJsonArray replayedTasks = log.tasks;
+    for (const Change& change : outChanges) {
+        if (!applyChange(change, replayedHeader, replayedTasks)) {
+            return false;
+        }
+    }
+
+    QStringList replayedIds;
+    taskIds(replayedTasks, replayedIds);
+    if (replayedIds != newIds) {
+        Change change;
+        change.type = ChangeType::ReorderTasks;
+        change.payload = QJsonDocument(QJsonArray::fromStringList(newIds)).toJson(QJsonDocument::Compact);
+        if (!applyChange(change, replayedHeader, replayedTasks)) {
+            return false;
+        }
+        outChanges.append(change);
+    }
+
+    return replayedHeader == header && replayedTasks == tasks;
+}
+
+bool TasklistRecordLog::taskIds(const QJsonArray& tasks, QStringList& outIds)
+{
+    outIds.clear();
+    QSet<QString> seen;
+    for (const QJsonValue& value : tasks) {
+        const QString id = value.toObject().value("id").toString();
+        if (!value.isObject() || id.isEmpty() || seen.contains(id)) {
+            return false;
+        }
+        seen.insert(id);
+        outIds.append(id);
+    }
+    return true;
+}
+
+int TasklistRecordLog::indexOfTask(const QJsonArray& tasks, const QString& taskId)
+{
+    for (int i = 0; i < tasks.size(); ++i) {
+        if (tasks[i].toObject().value("id").toString() == taskId) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// ============================================================================
+// Record encoding
+// ============================================================================
+
+QByteArray TasklistRecordLog::encodeSnapshot(const QByteArray& encryptionKey, const QByteArray& header,
+                                             const QJsonArray& tasks)
+{
+    QByteArray plainRecord;
+    {
+        QDataStream stream(&plainRecord, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_5_15);
+        stream << static_cast<quint8>(RecordType::Snapshot) << header
+               << QJsonDocument(tasks).toJson(QJsonDocument::Compact);
+    }
+    return s_logFile.encryptRecord(encryptionKey, plainRecord);
+}
+
+QByteArray TasklistRecordLog::encodeChanges(const QByteArray& encryptionKey, const QVector<Change>& changes)
+{
+    QByteArray plainRecord;
+    {
+        QDataStream stream(&plainRecord, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_5_15);
+        stream << static_cast<quint8>(RecordType::Changes) << static_cast<qint32>(changes.size());
+        for (const Change& change : changes) {
+            stream << static_cast<quint8>(change.type) << change.position << change.taskId << change.payload;
+        }
+    }
+    return s_logFile.encryptRecord(encryptionKey, plainRecord);
+}
+
+bool TasklistRecordLog::applyRecord(const QByteArray& plainRecord, QByteArray& header, QJsonArray& tasks)
+{
+    QDataStream stream(plainRecord);
+    stream.setVersion(QDataStream::Qt_5_15);
+
+    quint8 type = 0;
+    stream >> type;
+
+    switch (static_cast<RecordType>(type)) {
+    case RecordType::Snapshot: {
+        QByteArray snapshotHeader;
+        QByteArray tasksJson;
+        stream >> snapshotHeader >> tasksJson;
+        if (stream.status() != QDataStream::Ok || snapshotHeader.size() != HEADER_SIZE) {
+            return false;
+        }
+        const QJsonDocument doc = QJsonDocument::fromJson(tasksJson);
+        if (!doc.isArray()) {
+            return false;
+        }
+        header = snapshotHeader;
+        tasks = doc.array();
+        return true;
+    }
+    case RecordType::Changes: {
+        qint32 count = 0;
+        stream >> count;
+        if (stream.status() != QDataStream::Ok || count <= 0) {
+            return false;
+        }
+
+        // All changes of a record apply or none do
+        QByteArray changedHeader = header;
+        QJsonArray changedTasks = tasks;
+        for (qint32 i = 0; i < count; ++i) {
+            quint8 changeType = 0;
+            Change change;
+            stream >> changeType >> change.position >> change.taskId >> change.payload;
+            if (stream.status() != QDataStream::Ok) {
+                return false;
+            }
+            change.type = static_cast<ChangeType>(changeType);
+            if (!applyChange(change, changedHeader, changedTasks)) {
+                return false;
+            }
+        }
+        header = changedHeader;
+        tasks = changedTasks;
+        return true;
+    }
+    }
+    return false;
+}
+
+bool TasklistRecordLog::applyChange(const Change& change, QByteArray& header, QJsonArray& tasks)
+{
+    switch (change.type) {
+    case ChangeType::SetHeader:
+        if (change.payload.size() != HEADER_SIZE) {
+            return false;
+        }
+        header = change.payload;
+        return true;
+    case ChangeType::AddTask: {
+        const QJsonDocument doc = QJsonDocument::fromJson(change.payload);
+        if (!doc.isObject() || change.position < 0 || change.position > tasks.size()) {
+            return false;
+        }
+        tasks.insert(change.position, doc.object());
+        return true;
+    }
+    case ChangeType::UpdateTask: {
+        const int index = indexOfTask(tasks, change.taskId);
+        const QJsonDocument doc = QJsonDocument::fromJson(change.payload);
+        if (index < 0 || !doc.isObject()) {
+            return false;
+        }
+        QJsonObject task = tasks[index].toObject();
+        const QJsonObject setFields = doc.object().value("set").toObject();
+        for (auto it = setFields.constBegin(); it != setFields.constEnd(); ++it) {
+            task.insert(it.key(), it.value());
+        }
+        const QJsonArray unsetFields = doc.object().value("unset").toArray();
+        for (const QJsonValue& field : unsetFields) {
+            task.remove(field.toString());
+        }
+        tasks.replace(index, task);
+        return true;
+    }
+    case ChangeType::ReorderTasks: {
+        const QJsonDocument doc = QJsonDocument::fromJson(change.payload);
+        if (!doc.isArray() || doc.array().size() != tasks.size()) {
+            return false;
+        }
+        QJsonArray reordered;
+        QSet<QString> placed;
+        for (const QJsonValue& id : doc.array()) {
+            const int index = indexOfTask(tasks, id.toString());
+            if (index < 0 || placed.contains(id.toString())) {
+                return false;
+            }
+            placed.insert(id.toString());
+            reordered.append(tasks[index]);
+        }
+        tasks = reordered;
+        return true;
+    }
+    case ChangeType::DeleteTask: {
+        const int index = indexOfTask(tasks, change.taskId);
+        if (index < 0) {
+            return false;
+        }
+        tasks.removeAt(index);
+        return true;
+    }
+    }
+    return false;
+}
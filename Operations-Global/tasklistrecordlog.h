@@ -0,0 +1,105 @@
+#ifndef TASKLISTRECORDLOG_H
+#define TASKLISTRECORDLOG_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QVector>
+#include <QMutex>
+#include "recordlogfile.h"
+
+// Storage format for tasklist files.
+// A tasklist used to be its 512 byte metadata header followed by the JSON task array, encrypted
+// as one blob, so ticking a checkbox or a description autosave re-encrypted and rewrote the whole
+// list. A record log has the same layout as the diary record log (framed by RecordLogFile):
+//   [8 byte header "MMTRLOG" + version] [quint32 length][encrypted record] [quint32 length][encrypted record] ...
+// A record is either a snapshot (metadata header + all tasks) or a batch of changes keyed by task
+// ID: set the metadata header, add a task, update some fields of a task, reorder the tasks,
+// delete a task. A write is diffed against what is on disk and appends one record holding only
+// the changes, so editing a description appends that task's new description and nothing else.
+// The changes of one write are a single record, a torn append never leaves half of them applied.
+// Compaction folds the log back into a single snapshot once it grows past
+// COMPACT_RECORD_THRESHOLD records. Legacy single-blob files are still read and are converted on
+// their first write.
+class TasklistRecordLog
+{
+public:
+    // Reads the metadata header and tasks of a tasklist file, record log or legacy format
+    static bool read(const QString& filePath, const QByteArray& encryptionKey,
+                     QByteArray& outHeader, QJsonArray& outTasks);
+
+    // Same as read() but bypasses the cache, so parallel bulk scans (e.g. search indexing) neither
+    // serialize on it nor evict the files being edited
+    static bool readUncached(const QString& filePath, const QByteArray& encryptionKey,
+                             QByteArray& outHeader, QJsonArray& outTasks);
+
+    // Persists the header and tasks, appending only the difference to what is already on disk
+    static bool write(const QString& filePath, const QByteArray& encryptionKey,
+                      const QByteArray& header, const QJsonArray& tasks);
+
+    // Whether the file starts with the record log header
+    static bool isRecordLog(const QString& filePath);
+
+    // Checks the key against the first record without replaying the whole log
+    static bool validateKey(const QString& filePath, const QByteArray& encryptionKey);
+
+    // Drops the cached plaintext of all files (e.g. on logout)
+    static void clearCache();
+
+    static const int HEADER_SIZE = 512;                 // Operations_TaskLists::TasklistMetadata
+    static const int COMPACT_RECORD_THRESHOLD = 100;
+
+private:
+    enum class RecordType : quint8 {
+        Snapshot = 0,
+        Changes = 1
+    };
+
+    enum class ChangeType : quint8 {
+        SetHeader = 0,      // payload: the metadata header
+        AddTask = 1,        // position: index of the new task, payload: the task object
+        UpdateTask = 2,     // taskId, payload: {"set": {changed fields}, "unset": [removed fields]}
+        ReorderTasks = 3,   // payload: the task IDs in their new order
+        DeleteTask = 4      // taskId
+    };
+
+    struct Change {
+        ChangeType type = ChangeType::SetHeader;
+        qint32 position = 0;
+        QString taskId;
+        QByteArray payload;
+    };
+
+    // The tasklist as it is on disk, used to compute the next changes without re-reading the file
+    struct CachedLog : RecordLogFile::FileState {
+        QByteArray header;
+        QJsonArray tasks;
+    };
+
+    static bool loadFromDisk(const QString& filePath, const QByteArray& encryptionKey, CachedLog& outLog);
+    static bool loadLegacy(const QString& filePath, const QByteArray& encryptionKey, CachedLog& outLog);
+    static bool writeSnapshotLocked(const QString& filePath, const QByteArray& encryptionKey,
+                                    const QByteArray& header, const QJsonArray& tasks);
+    static bool appendRecordLocked(const QString& filePath, const QByteArray& encryptionKey, CachedLog& log,
+                                   const QVector<Change>& changes);
+
+    static bool diff(const CachedLog& log, const QByteArray& header, const QJsonArray& tasks,
+                     QVector<Change>& outChanges);
+    static bool taskIds(const QJsonArray& tasks, QStringList& outIds);
+    static int indexOfTask(const QJsonArray& tasks, const QString& taskId);
+
+    static QByteArray encodeSnapshot(const QByteArray& encryptionKey, const QByteArray& header,
+                                     const QJsonArray& tasks);
+    static QByteArray encodeChanges(const QByteArray& encryptionKey, const QVector<Change>& changes);
+    static bool applyRecord(const QByteArray& plainRecord, QByteArray& header, QJsonArray& tasks);
+    static bool applyChange(const Change& change, QByteArray& header, QJsonArray& tasks);
+
+    static const RecordLogFile s_logFile;
+
+    static QMutex s_mutex;
+    static RecordLogCache<CachedLog> s_cache;
+};
+
+#endif // TASKLISTRECORDLOG_H
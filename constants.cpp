@@ -167,6 +167,9 @@ const QString TASK_MANAGER_TEXT = "Task Manager";
 // Encrypted File Metadata
 const int METADATA_RESERVED_SIZE = 51200; // 50KB reserved for metadata (fixed size)
 const int MAX_RAW_METADATA_SIZE = 40960; // 40KB limit for raw metadata before encryption
+// Encrypted File Chunk Headers
+const quint32 CHUNK_HEADER_COMPRESSED_FLAG = 0x80000000u; // Top bit set = chunk plaintext was compressed
+const quint32 CHUNK_HEADER_SIZE_MASK = 0x7FFFFFFFu; // Remaining bits = encrypted chunk size
 
 
 }
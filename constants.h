@@ -142,6 +142,9 @@ extern const QString TASK_MANAGER_TEXT;
 // Encrypted File Metadata
 extern const int METADATA_RESERVED_SIZE;
 extern const int MAX_RAW_METADATA_SIZE;
+// Encrypted File Chunk Headers
+extern const quint32 CHUNK_HEADER_COMPRESSED_FLAG;
+extern const quint32 CHUNK_HEADER_SIZE_MASK;
 // Enum classes
 enum class CPUNType {
     Congrat,
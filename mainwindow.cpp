@@ -14,6 +14,7 @@
 #include "operations_vp_shows.h"
 #include "passwordvalidation.h"
 #include "operations_files.h"
+#include "securedeletionqueue.h"
 #include "sqlite-database-auth.h"
 #include "sqlite-database-settings.h"
 #include "settings_default_usersettings.h"
@@ -114,10 +115,16 @@ MainWindow::MainWindow(QWidget *parent)
         // Clean up and quit
         PasswordValidation::clearGracePeriod(user_Username);
         OperationsFiles::cleanupAllUserTempFolders();
+        SecureDeletionQueue::instance().shutdown();
         
         if (Operations_Diary_ptr) {
+            Operations_Diary_ptr->flushPendingSaves();
             Operations_Diary_ptr->DeleteEmptyCurrentDayDiary();
         }
+
+        if (Operations_TaskLists_ptr) {
+            Operations_TaskLists_ptr->flushPendingSaves();
+        }
         
         // Clear sensitive data - SecureByteArray handles this securely
         user_Key.clear();
@@ -1417,8 +1424,13 @@ void MainWindow::closeEvent(QCloseEvent *event)
         // This must happen while we still have a valid key for validation
         if (Operations_Diary_ptr && !user_Key.isEmpty()) {
             qDebug() << "MainWindow: Cleaning up empty diary before shutdown";
+            Operations_Diary_ptr->flushPendingSaves();
             Operations_Diary_ptr->DeleteEmptyCurrentDayDiary();
         }
+
+        if (Operations_TaskLists_ptr) {
+            Operations_TaskLists_ptr->flushPendingSaves();
+        }
         
         // SECURITY: Set flag to prevent any operations during shutdown
         initFinished = false;
@@ -1436,8 +1448,9 @@ void MainWindow::closeEvent(QCloseEvent *event)
         // SECURITY: Clear grace period for all users
         PasswordValidation::clearGracePeriod(user_Username);
         
-        // Clean up temp folders
+        // Clean up temp folders, unfinished secure deletions stay renamed for the next launch
         OperationsFiles::cleanupAllUserTempFolders();
+        SecureDeletionQueue::instance().shutdown();
         
         // Save persistent settings before closing
         if (m_persistentSettingsManager && m_persistentSettingsManager->isConnected()) {
@@ -1458,14 +1471,20 @@ void MainWindow::closeEvent(QCloseEvent *event)
         // CRITICAL: Clean up empty diary BEFORE clearing encryption key
         if (Operations_Diary_ptr && !user_Key.isEmpty()) {
             qDebug() << "MainWindow: Cleaning up empty diary before logout";
+            Operations_Diary_ptr->flushPendingSaves();
             Operations_Diary_ptr->DeleteEmptyCurrentDayDiary();
         }
+
+        if (Operations_TaskLists_ptr) {
+            Operations_TaskLists_ptr->flushPendingSaves();
+        }
         
         // Clear grace period
         PasswordValidation::clearGracePeriod(user_Username);
         
-        // Clean up temp folders
+        // Clean up temp folders, unfinished secure deletions stay renamed for the next launch
         OperationsFiles::cleanupAllUserTempFolders();
+        SecureDeletionQueue::instance().shutdown();
         
         // Save persistent settings before closing
         if (m_persistentSettingsManager && m_persistentSettingsManager->isConnected()) {
@@ -1630,7 +1649,7 @@ void MainWindow::on_DiaryListDays_currentTextChanged(const QString &currentText)
     }
 }
 
-void MainWindow::on_DiaryTextDisplay_itemChanged(QListWidgetItem *item)
+void MainWindow::on_DiaryTextDisplay_itemChanged(int row)
 {
     if (Operations_Diary_ptr) {
         Operations_Diary_ptr->on_DiaryTextDisplay_itemChanged();
@@ -2155,12 +2174,18 @@ void MainWindow::on_pushButton_CloseApp_clicked()
         // CRITICAL: Clean up empty diary BEFORE clearing encryption key
         if (Operations_Diary_ptr && !user_Key.isEmpty()) {
             qDebug() << "MainWindow: Cleaning up empty diary from Close App button";
+            Operations_Diary_ptr->flushPendingSaves();
             Operations_Diary_ptr->DeleteEmptyCurrentDayDiary();
         }
+
+        if (Operations_TaskLists_ptr) {
+            Operations_TaskLists_ptr->flushPendingSaves();
+        }
         
         // Clean up
         PasswordValidation::clearGracePeriod(user_Username);
         OperationsFiles::cleanupAllUserTempFolders();
+        SecureDeletionQueue::instance().shutdown();
         
         // Clear sensitive data - SecureByteArray handles this securely
         user_Key.clear();
@@ -2191,6 +2216,11 @@ void MainWindow::onTabChanged(int index)
         statusBar()->clearMessage();
         qDebug() << "MainWindow: Status bar cleared on tab change to index:" << index;
     }
+
+    // Diary saves are written behind, don't leave them pending while the user is elsewhere
+    if (Operations_Diary_ptr) {
+        Operations_Diary_ptr->flushPendingSaves();
+    }
     
     // Find the Password Manager tab dynamically instead of using hardcoded index
     int passwordTabIndex = Operations::GetTabIndexByObjectName("tab_Passwords", ui->tabWidget_Main);
@@ -91,7 +91,7 @@ private slots:
 
     void on_DiaryListDays_currentTextChanged(const QString &currentText);
 
-    void on_DiaryTextDisplay_itemChanged(QListWidgetItem *item);
+    void on_DiaryTextDisplay_itemChanged(int row);
 
     void on_DiaryTextDisplay_entered(const QModelIndex &index);
 